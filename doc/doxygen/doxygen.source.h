@@ -289,6 +289,14 @@
  *  \ingroup externformats
  */
 
+/** \defgroup obj Wavefront OBJ
+ *  \ingroup externformats
+ */
+
+/** \defgroup stl STL
+ *  \ingroup externformats
+ */
+
 /** \defgroup imbuf Image Buffer (ImBuf)
  *  \ingroup blender
  */
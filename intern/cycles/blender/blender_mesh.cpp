@@ -33,11 +33,35 @@
 #include "util/util_hash.h"
 #include "util/util_logging.h"
 #include "util/util_math.h"
+#include "util/util_md5.h"
 
 #include "mikktspace.h"
 
+#include "DNA_meshdata_types.h"
+
 CCL_NAMESPACE_BEGIN
 
+/* Vertex Data
+ *
+ * Read the vertex array of the Blender mesh directly instead of going through the RNA accessors
+ * for every vertex, which dominates the export time of large meshes. */
+
+static const MVert *mesh_vertices(BL::Mesh &b_mesh)
+{
+  return (b_mesh.vertices.length()) ? static_cast<const MVert *>(b_mesh.vertices[0].ptr.data) :
+                                      NULL;
+}
+
+static inline float3 mesh_vertex_co(const MVert &b_vert)
+{
+  return make_float3(b_vert.co[0], b_vert.co[1], b_vert.co[2]);
+}
+
+static inline float3 mesh_vertex_normal(const MVert &b_vert)
+{
+  return make_float3(b_vert.no[0], b_vert.no[1], b_vert.no[2]) * (1.0f / 32767.0f);
+}
+
 /* Tangent Space */
 
 struct MikkUserData {
@@ -757,17 +781,18 @@ static void create_mesh(Scene *scene,
   mesh->reserve_mesh(numverts, numtris);
 
   /* create vertex coordinates and normals */
-  BL::Mesh::vertices_iterator v;
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v)
-    mesh->add_vertex(get_float3(v->co()));
+  const MVert *b_verts = mesh_vertices(b_mesh);
+  for (int i = 0; i < numverts; i++) {
+    mesh->add_vertex(mesh_vertex_co(b_verts[i]));
+  }
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
   float3 *N = attr_N->data_float3();
 
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v, ++N)
-    *N = get_float3(v->normal());
-  N = attr_N->data_float3();
+  for (int i = 0; i < numverts; i++) {
+    N[i] = mesh_vertex_normal(b_verts[i]);
+  }
 
   /* create generated coordinates from undeformed coordinates */
   const bool need_default_tangent = (subdivision == false) && (b_mesh.uv_layers.length() == 0) &&
@@ -782,6 +807,7 @@ static void create_mesh(Scene *scene,
     float3 *generated = attr->data_float3();
     size_t i = 0;
 
+    BL::Mesh::vertices_iterator v;
     for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v) {
       generated[i++] = get_float3(v->undeformed_co()) * size - loc;
     }
@@ -1000,6 +1026,84 @@ static void sync_mesh_fluid_motion(BL::Object &b_ob, Scene *scene, Mesh *mesh)
   }
 }
 
+/* Hash of everything adaptive subdivision dices and displaces a mesh from, except for the dicing
+ * camera transform which is compared with a tolerance. */
+static string subd_dicing_hash(Scene *scene, Mesh *mesh)
+{
+  MD5Hash md5;
+  mesh->hash(md5);
+
+  foreach (Node *node, mesh->get_used_shaders()) {
+    md5.append(node->name.string());
+  }
+
+  AttributeSet *attribute_sets[] = {&mesh->attributes, &mesh->subd_attributes};
+  for (AttributeSet *attributes : attribute_sets) {
+    foreach (const Attribute &attr, attributes->attributes) {
+      md5.append(attr.name.string());
+      md5.append((const uint8_t *)&attr.std, sizeof(attr.std));
+      if (!attr.buffer.empty()) {
+        md5.append((const uint8_t *)attr.buffer.data(), attr.buffer.size());
+      }
+    }
+  }
+
+  Camera *dicing_camera = scene->dicing_camera;
+  const int camera_type = dicing_camera->get_camera_type();
+  const int panorama_type = dicing_camera->get_panorama_type();
+  const int full_width = dicing_camera->get_full_width();
+  const int full_height = dicing_camera->get_full_height();
+  const float fov = dicing_camera->get_fov();
+  md5.append((const uint8_t *)&camera_type, sizeof(camera_type));
+  md5.append((const uint8_t *)&panorama_type, sizeof(panorama_type));
+  md5.append((const uint8_t *)&full_width, sizeof(full_width));
+  md5.append((const uint8_t *)&full_height, sizeof(full_height));
+  md5.append((const uint8_t *)&fov, sizeof(fov));
+
+  return md5.get_hex();
+}
+
+/* Small camera moves barely change the dicing rate, so the tessellation is kept for those. */
+static bool subd_dicing_camera_equal(const Transform &a, const Transform &b)
+{
+  const float threshold = 1e-3f;
+
+  for (int i = 0; i < 3; i++) {
+    const float3 axis_a = transform_get_column(&a, i);
+    const float3 axis_b = transform_get_column(&b, i);
+    if (len(axis_a - axis_b) > threshold) {
+      return false;
+    }
+  }
+
+  const float3 location_a = transform_get_column(&a, 3);
+  const float3 location_b = transform_get_column(&b, 3);
+  return len(location_a - location_b) <= threshold * max(1.0f, len(location_a));
+}
+
+static bool subd_dicing_can_reuse(Scene *scene, Mesh *mesh, const string &hash)
+{
+  /* Motion attributes are written into the synchronized mesh, before tessellation. */
+  if (scene->need_motion() != Scene::MOTION_NONE) {
+    return false;
+  }
+  if (mesh->subd_dicing_hash.empty() || mesh->subd_dicing_hash != hash) {
+    return false;
+  }
+  if (!subd_dicing_camera_equal(mesh->subd_dicing_camera, scene->dicing_camera->get_matrix())) {
+    return false;
+  }
+
+  foreach (Node *node, mesh->get_used_shaders()) {
+    Shader *shader = static_cast<Shader *>(node);
+    if (shader->need_update_displacement) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void BlenderSync::sync_mesh(BL::Depsgraph b_depsgraph, BL::Object b_ob, Mesh *mesh)
 {
   /* make a copy of the shaders as the caller in the main thread still need them for syncing the
@@ -1044,6 +1148,15 @@ void BlenderSync::sync_mesh(BL::Depsgraph b_depsgraph, BL::Object b_ob, Mesh *me
   /* mesh fluid motion mantaflow */
   sync_mesh_fluid_motion(b_ob, scene, &new_mesh);
 
+  /* Keep the diced and displaced mesh from a previous synchronization of the same input. */
+  string subd_hash;
+  if (new_mesh.get_subdivision_type() != Mesh::SUBDIVISION_NONE) {
+    subd_hash = subd_dicing_hash(scene, &new_mesh);
+    if (subd_dicing_can_reuse(scene, mesh, subd_hash)) {
+      return;
+    }
+  }
+
   /* update original sockets */
 
   mesh->clear_non_sockets();
@@ -1062,6 +1175,9 @@ void BlenderSync::sync_mesh(BL::Depsgraph b_depsgraph, BL::Object b_ob, Mesh *me
 
   mesh->set_num_subd_faces(new_mesh.get_num_subd_faces());
 
+  mesh->subd_dicing_hash = subd_hash;
+  mesh->subd_dicing_camera = scene->dicing_camera->get_matrix();
+
   /* tag update */
   bool rebuild = (mesh->triangles_is_modified()) || (mesh->subd_num_corners_is_modified()) ||
                  (mesh->subd_shader_is_modified()) || (mesh->subd_smooth_is_modified()) ||
@@ -1125,12 +1241,12 @@ void BlenderSync::sync_mesh_motion(BL::Depsgraph b_depsgraph,
     /* NOTE: We don't copy more that existing amount of vertices to prevent
      * possible memory corruption.
      */
-    BL::Mesh::vertices_iterator v;
-    int i = 0;
-    for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end() && i < numverts; ++v, ++i) {
-      mP[i] = get_float3(v->co());
+    const MVert *b_verts = mesh_vertices(b_mesh);
+    const size_t num_copy = min((size_t)b_mesh.vertices.length(), numverts);
+    for (size_t i = 0; i < num_copy; i++) {
+      mP[i] = mesh_vertex_co(b_verts[i]);
       if (mN)
-        mN[i] = get_float3(v->normal());
+        mN[i] = mesh_vertex_normal(b_verts[i]);
     }
     if (new_attribute) {
       /* In case of new attribute, we verify if there really was any motion. */
@@ -465,6 +465,12 @@ void BlenderSession::stamp_view_layer_metadata(Scene *scene, const string &view_
                             time_human_readable_from_seconds(render_time).c_str());
   b_rr.stamp_data_add_field((prefix + "synchronization_time").c_str(),
                             time_human_readable_from_seconds(total_time - render_time).c_str());
+
+  /* Store per manager scene update times, when they are collected. */
+  if (scene->update_stats) {
+    b_rr.stamp_data_add_field((prefix + "update_stats").c_str(),
+                              scene->update_stats->json_report().c_str());
+  }
 }
 
 void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
@@ -578,6 +584,9 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       RenderStats stats;
       session->collect_statistics(&stats);
       printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      if (scene->update_stats) {
+        printf("Update statistics JSON:\n%s\n", scene->update_stats->json_report().c_str());
+      }
     }
 
     if (session->progress.get_cancel())
@@ -161,6 +161,51 @@ void BVH2::pack_aligned_inner(const BVHStackEntry &e,
                     e1.node->visibility);
 }
 
+/* Smallest power of two step for which 255 steps from the lower bound reach the upper bound. */
+static int bvh_quantize_exponent(const float lower, const float upper)
+{
+  int exponent = -126;
+  if (upper > lower) {
+    const float extent = upper - lower;
+    exponent = isfinite(extent) ? clamp((int)ceilf(log2f(extent / 255.0f)), -126, 127) : 127;
+  }
+  while (exponent < 127 && lower + 255.0f * ldexpf(1.0f, exponent) < upper) {
+    exponent++;
+  }
+  return exponent;
+}
+
+/* Quantize planes rounding outwards, using the same arithmetic as the kernel to decode them. */
+static uint bvh_quantize_lower(const float origin, const float scale, const float value)
+{
+  int q = clamp((int)floorf((value - origin) / scale), 0, 255);
+  while (q > 0 && origin + (float)q * scale > value) {
+    q--;
+  }
+  return (uint)q;
+}
+
+static uint bvh_quantize_upper(const float origin, const float scale, const float value)
+{
+  int q = clamp((int)ceilf((value - origin) / scale), 0, 255);
+  while (q < 255 && origin + (float)q * scale < value) {
+    q++;
+  }
+  return (uint)q;
+}
+
+static uint bvh_quantize_planes(const float origin,
+                                const float scale,
+                                const float min0,
+                                const float min1,
+                                const float max0,
+                                const float max1)
+{
+  return bvh_quantize_lower(origin, scale, min0) | (bvh_quantize_lower(origin, scale, min1) << 8) |
+         (bvh_quantize_upper(origin, scale, max0) << 16) |
+         (bvh_quantize_upper(origin, scale, max1) << 24);
+}
+
 void BVH2::pack_aligned_node(int idx,
                              const BoundBox &b0,
                              const BoundBox &b1,
@@ -173,21 +218,47 @@ void BVH2::pack_aligned_node(int idx,
   assert(c0 < 0 || c0 < pack.nodes.size());
   assert(c1 < 0 || c1 < pack.nodes.size());
 
+  /* Empty children can not be represented by quantized bounds, never traverse them instead. */
+  if (!b0.valid()) {
+    visibility0 = 0;
+  }
+  if (!b1.valid()) {
+    visibility1 = 0;
+  }
+
+  /* Child planes are stored as 8 bit steps from the lower corner of the node bounds, with a
+   * power of two step size per axis. */
+  BoundBox bounds = BoundBox::empty;
+  if (b0.valid()) {
+    bounds.grow(b0);
+  }
+  if (b1.valid()) {
+    bounds.grow(b1);
+  }
+  if (!bounds.valid()) {
+    bounds = BoundBox(make_float3(0.0f, 0.0f, 0.0f));
+  }
+
+  const float3 origin = bounds.min;
+  const int ex = bvh_quantize_exponent(bounds.min.x, bounds.max.x);
+  const int ey = bvh_quantize_exponent(bounds.min.y, bounds.max.y);
+  const int ez = bvh_quantize_exponent(bounds.min.z, bounds.max.z);
+  const float3 scale = make_float3(ldexpf(1.0f, ex), ldexpf(1.0f, ey), ldexpf(1.0f, ez));
+
+  const BoundBox q0 = b0.valid() ? b0 : BoundBox(origin);
+  const BoundBox q1 = b1.valid() ? b1 : BoundBox(origin);
+
   int4 data[BVH_NODE_SIZE] = {
       make_int4(
           visibility0 & ~PATH_RAY_NODE_UNALIGNED, visibility1 & ~PATH_RAY_NODE_UNALIGNED, c0, c1),
-      make_int4(__float_as_int(b0.min.x),
-                __float_as_int(b1.min.x),
-                __float_as_int(b0.max.x),
-                __float_as_int(b1.max.x)),
-      make_int4(__float_as_int(b0.min.y),
-                __float_as_int(b1.min.y),
-                __float_as_int(b0.max.y),
-                __float_as_int(b1.max.y)),
-      make_int4(__float_as_int(b0.min.z),
-                __float_as_int(b1.min.z),
-                __float_as_int(b0.max.z),
-                __float_as_int(b1.max.z)),
+      make_int4(__float_as_int(origin.x),
+                __float_as_int(origin.y),
+                __float_as_int(origin.z),
+                (ex + 127) | ((ey + 127) << 8) | ((ez + 127) << 16)),
+      make_int4(bvh_quantize_planes(origin.x, scale.x, q0.min.x, q1.min.x, q0.max.x, q1.max.x),
+                bvh_quantize_planes(origin.y, scale.y, q0.min.y, q1.min.y, q0.max.y, q1.max.y),
+                bvh_quantize_planes(origin.z, scale.z, q0.min.z, q1.min.z, q0.max.z, q1.max.z),
+                0),
   };
 
   memcpy(&pack.nodes[idx], data, sizeof(int4) * BVH_NODE_SIZE);
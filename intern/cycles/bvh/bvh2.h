@@ -26,7 +26,9 @@
 
 CCL_NAMESPACE_BEGIN
 
-#define BVH_NODE_SIZE 4
+/* Aligned inner nodes store the child bounds quantized to 8 bits per plane, relative to the
+ * bounds of the node, see #BVH2::pack_aligned_node. */
+#define BVH_NODE_SIZE 3
 #define BVH_NODE_LEAF_SIZE 1
 #define BVH_UNALIGNED_NODE_SIZE 7
 
@@ -23,7 +23,9 @@
 
 #include "util/util_algorithm.h"
 #include "util/util_boundbox.h"
+#include "util/util_tbb.h"
 #include "util/util_types.h"
+#include "util/util_vector.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -97,71 +99,34 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   scale = rcp(cent_bounds_.size()) * make_float3((float)num_bins);
 
   /* initialize binning counter and bounds */
-  BoundBox bin_bounds[MAX_BINS][4]; /* bounds for every bin in every dimension */
-  int4 bin_count[MAX_BINS];         /* number of primitives mapped to bin */
+  Bins bins;
 
   for (size_t i = 0; i < num_bins; i++) {
-    bin_count[i] = make_int4(0);
-    bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
+    bins.count[i] = make_int4(0);
+    bins.bounds[i][0] = bins.bounds[i][1] = bins.bounds[i][2] = BoundBox::empty;
   }
 
-  /* map geometry to bins, unrolled once */
-  {
-    ssize_t i;
-
-    for (i = 0; i < ssize_t(size()) - 1; i += 2) {
-      prefetch_L2(&prims[start() + i + 8]);
-
-      /* map even and odd primitive to bin */
-      const BVHReference &prim0 = prims[start() + i + 0];
-      const BVHReference &prim1 = prims[start() + i + 1];
-
-      BoundBox bounds0 = get_prim_bounds(prim0);
-      BoundBox bounds1 = get_prim_bounds(prim1);
-
-      int4 bin0 = get_bin(bounds0);
-      int4 bin1 = get_bin(bounds1);
-
-      /* increase bounds for bins for even primitive */
-      int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
-
-      /* increase bounds of bins for odd primitive */
-      int b10 = (int)extract<0>(bin1);
-      bin_count[b10][0]++;
-      bin_bounds[b10][0].grow(bounds1);
-      int b11 = (int)extract<1>(bin1);
-      bin_count[b11][1]++;
-      bin_bounds[b11][1].grow(bounds1);
-      int b12 = (int)extract<2>(bin1);
-      bin_count[b12][2]++;
-      bin_bounds[b12][2].grow(bounds1);
-    }
-
-    /* for uneven number of primitives */
-    if (i < ssize_t(size())) {
-      /* map primitive to bin */
-      const BVHReference &prim0 = prims[start() + i];
-      BoundBox bounds0 = get_prim_bounds(prim0);
-      int4 bin0 = get_bin(bounds0);
-
-      /* increase bounds of bins */
-      int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
+  /* map geometry to bins */
+  if (size() < PARALLEL_THRESHOLD) {
+    bin_prims(prims, start(), end(), bins);
+  }
+  else {
+    /* Bin blocks of primitives on all threads and merge the bins afterwards, the result does not
+     * depend on the order since only counts and bounds are accumulated. */
+    enumerable_thread_specific<Bins> thread_bins(bins);
+
+    parallel_for(blocked_range<size_t>(start(), end(), PARALLEL_BLOCK_SIZE),
+                 [&](const blocked_range<size_t> &r) {
+                   bin_prims(prims, r.begin(), r.end(), thread_bins.local());
+                 });
+
+    for (const Bins &local_bins : thread_bins) {
+      for (size_t i = 0; i < num_bins; i++) {
+        bins.count[i] = bins.count[i] + local_bins.count[i];
+        bins.bounds[i][0].grow(local_bins.bounds[i][0]);
+        bins.bounds[i][1].grow(local_bins.bounds[i][1]);
+        bins.bounds[i][2].grow(local_bins.bounds[i][2]);
+      }
     }
   }
 
@@ -175,14 +140,14 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   BoundBox bz = BoundBox::empty;
 
   for (size_t i = num_bins - 1; i > 0; i--) {
-    count = count + bin_count[i];
+    count = count + bins.count[i];
     r_count[i] = blocks(count);
 
-    bx = merge(bx, bin_bounds[i][0]);
+    bx = merge(bx, bins.bounds[i][0]);
     r_area[i][0] = bx.half_area();
-    by = merge(by, bin_bounds[i][1]);
+    by = merge(by, bins.bounds[i][1]);
     r_area[i][1] = by.half_area();
-    bz = merge(bz, bin_bounds[i][2]);
+    bz = merge(bz, bins.bounds[i][2]);
     r_area[i][2] = bz.half_area();
     r_area[i][3] = r_area[i][2];
   }
@@ -199,13 +164,13 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   bz = BoundBox::empty;
 
   for (size_t i = 1; i < num_bins; i++, ii += make_int4(1)) {
-    count = count + bin_count[i - 1];
+    count = count + bins.count[i - 1];
 
-    bx = merge(bx, bin_bounds[i - 1][0]);
+    bx = merge(bx, bins.bounds[i - 1][0]);
     float Ax = bx.half_area();
-    by = merge(by, bin_bounds[i - 1][1]);
+    by = merge(by, bins.bounds[i - 1][1]);
     float Ay = by.half_area();
-    bz = merge(bz, bin_bounds[i - 1][2]);
+    bz = merge(bz, bins.bounds[i - 1][2]);
     float Az = bz.half_area();
 
     float4 lCount = blocks(count);
@@ -226,6 +191,160 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   leafSAH = bounds_.half_area() * blocks(size());
 }
 
+void BVHObjectBinning::bin_prims(const BVHReference *prims,
+                                 size_t begin,
+                                 size_t end,
+                                 Bins &bins) const
+{
+  /* map geometry to bins, unrolled once */
+  size_t i;
+
+  for (i = begin; i + 1 < end; i += 2) {
+    prefetch_L2(&prims[i + 8]);
+
+    /* map even and odd primitive to bin */
+    const BVHReference &prim0 = prims[i + 0];
+    const BVHReference &prim1 = prims[i + 1];
+
+    BoundBox bounds0 = get_prim_bounds(prim0);
+    BoundBox bounds1 = get_prim_bounds(prim1);
+
+    int4 bin0 = get_bin(bounds0);
+    int4 bin1 = get_bin(bounds1);
+
+    /* increase bounds for bins for even primitive */
+    int b00 = (int)extract<0>(bin0);
+    bins.count[b00][0]++;
+    bins.bounds[b00][0].grow(bounds0);
+    int b01 = (int)extract<1>(bin0);
+    bins.count[b01][1]++;
+    bins.bounds[b01][1].grow(bounds0);
+    int b02 = (int)extract<2>(bin0);
+    bins.count[b02][2]++;
+    bins.bounds[b02][2].grow(bounds0);
+
+    /* increase bounds of bins for odd primitive */
+    int b10 = (int)extract<0>(bin1);
+    bins.count[b10][0]++;
+    bins.bounds[b10][0].grow(bounds1);
+    int b11 = (int)extract<1>(bin1);
+    bins.count[b11][1]++;
+    bins.bounds[b11][1].grow(bounds1);
+    int b12 = (int)extract<2>(bin1);
+    bins.count[b12][2]++;
+    bins.bounds[b12][2].grow(bounds1);
+  }
+
+  /* for uneven number of primitives */
+  if (i < end) {
+    /* map primitive to bin */
+    const BVHReference &prim0 = prims[i];
+    BoundBox bounds0 = get_prim_bounds(prim0);
+    int4 bin0 = get_bin(bounds0);
+
+    /* increase bounds of bins */
+    int b00 = (int)extract<0>(bin0);
+    bins.count[b00][0]++;
+    bins.bounds[b00][0].grow(bounds0);
+    int b01 = (int)extract<1>(bin0);
+    bins.count[b01][1]++;
+    bins.bounds[b01][1].grow(bounds0);
+    int b02 = (int)extract<2>(bin0);
+    bins.count[b02][2]++;
+    bins.bounds[b02][2].grow(bounds0);
+  }
+}
+
+size_t BVHObjectBinning::partition_parallel(BVHReference *prims,
+                                            BoundBox &lgeom_bounds,
+                                            BoundBox &rgeom_bounds,
+                                            BoundBox &lcent_bounds,
+                                            BoundBox &rcent_bounds) const
+{
+  struct PartitionBlock {
+    size_t num_left;
+    size_t left_offset;
+    BoundBox lgeom_bounds, rgeom_bounds;
+    BoundBox lcent_bounds, rcent_bounds;
+  };
+
+  const size_t N = size();
+  const size_t num_blocks = divide_up(N, PARALLEL_BLOCK_SIZE);
+  vector<PartitionBlock> partition_blocks(num_blocks);
+
+  /* count primitives on the left and compute bounds of both sides for every block */
+  parallel_for(blocked_range<size_t>(0, num_blocks, 1), [&](const blocked_range<size_t> &range) {
+    for (size_t b = range.begin(); b != range.end(); b++) {
+      PartitionBlock &block = partition_blocks[b];
+      block.num_left = 0;
+      block.lgeom_bounds = block.rgeom_bounds = BoundBox::empty;
+      block.lcent_bounds = block.rcent_bounds = BoundBox::empty;
+
+      const size_t block_end = min(N, (b + 1) * PARALLEL_BLOCK_SIZE);
+      for (size_t i = b * PARALLEL_BLOCK_SIZE; i < block_end; i++) {
+        const BVHReference &prim = prims[start() + i];
+        float3 unaligned_center = get_prim_bounds(prim).center2();
+        float3 center = prim.bounds().center2();
+
+        if (get_bin(unaligned_center)[dim] < pos) {
+          block.lgeom_bounds.grow(prim.bounds());
+          block.lcent_bounds.grow(center);
+          block.num_left++;
+        }
+        else {
+          block.rgeom_bounds.grow(prim.bounds());
+          block.rcent_bounds.grow(center);
+        }
+      }
+    }
+  });
+
+  /* prefix sum of the block counts gives the output offsets */
+  size_t num_left = 0;
+  for (PartitionBlock &block : partition_blocks) {
+    block.left_offset = num_left;
+    num_left += block.num_left;
+
+    lgeom_bounds.grow(block.lgeom_bounds);
+    rgeom_bounds.grow(block.rgeom_bounds);
+    lcent_bounds.grow(block.lcent_bounds);
+    rcent_bounds.grow(block.rcent_bounds);
+  }
+
+  /* scatter to both sides keeping the order of primitives, then copy back */
+  vector<BVHReference> partitioned(N);
+
+  parallel_for(blocked_range<size_t>(0, num_blocks, 1), [&](const blocked_range<size_t> &range) {
+    for (size_t b = range.begin(); b != range.end(); b++) {
+      const PartitionBlock &block = partition_blocks[b];
+      size_t l = block.left_offset;
+      size_t r = num_left + b * PARALLEL_BLOCK_SIZE - block.left_offset;
+
+      const size_t block_end = min(N, (b + 1) * PARALLEL_BLOCK_SIZE);
+      for (size_t i = b * PARALLEL_BLOCK_SIZE; i < block_end; i++) {
+        const BVHReference &prim = prims[start() + i];
+        float3 unaligned_center = get_prim_bounds(prim).center2();
+
+        if (get_bin(unaligned_center)[dim] < pos) {
+          partitioned[l++] = prim;
+        }
+        else {
+          partitioned[r++] = prim;
+        }
+      }
+    }
+  });
+
+  parallel_for(blocked_range<size_t>(0, N, PARALLEL_BLOCK_SIZE),
+               [&](const blocked_range<size_t> &r) {
+                 std::copy(partitioned.begin() + r.begin(),
+                           partitioned.begin() + r.end(),
+                           prims + start() + r.begin());
+               });
+
+  return num_left;
+}
+
 void BVHObjectBinning::split(BVHReference *prims,
                              BVHObjectBinning &left_o,
                              BVHObjectBinning &right_o) const
@@ -239,6 +358,11 @@ void BVHObjectBinning::split(BVHReference *prims,
 
   ssize_t l = 0, r = N - 1;
 
+  if (N >= size_t(PARALLEL_THRESHOLD)) {
+    l = partition_parallel(prims, lgeom_bounds, rgeom_bounds, lcent_bounds, rcent_bounds);
+    r = l - 1;
+  }
+
   while (l <= r) {
     prefetch_L2(&prims[start() + l + 8]);
     prefetch_L2(&prims[start() + r - 8]);
@@ -27,12 +27,13 @@ CCL_NAMESPACE_BEGIN
 
 class BVHBuild;
 
-/* Single threaded object binner. Finds the split with the best SAH heuristic
+/* Object binner. Finds the split with the best SAH heuristic
  * by testing for each dimension multiple partitionings for regular spaced
  * partition locations. A partitioning for a partition location is computed,
  * by putting primitives whose centroid is on the left and right of the split
  * location to different sets. The SAH is evaluated by computing the number of
- * blocks occupied by the primitives in the partitions. */
+ * blocks occupied by the primitives in the partitions. Large ranges are binned
+ * and partitioned on all threads. */
 
 class BVHObjectBinning : public BVHRange {
  public:
@@ -71,6 +72,24 @@ class BVHObjectBinning : public BVHRange {
   enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
 
+  /* Ranges of at least this many primitives are binned and partitioned on all threads, in blocks
+   * of the given size. */
+  enum { PARALLEL_THRESHOLD = 16384, PARALLEL_BLOCK_SIZE = 4096 };
+
+  /* number of primitives and their bounds for every bin in every dimension */
+  struct Bins {
+    BoundBox bounds[MAX_BINS][4];
+    int4 count[MAX_BINS];
+  };
+
+  void bin_prims(const BVHReference *prims, size_t begin, size_t end, Bins &bins) const;
+
+  size_t partition_parallel(BVHReference *prims,
+                            BoundBox &lgeom_bounds,
+                            BoundBox &rgeom_bounds,
+                            BoundBox &lcent_bounds,
+                            BoundBox &rcent_bounds) const;
+
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
   {
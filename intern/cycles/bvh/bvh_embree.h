@@ -54,6 +54,7 @@ class BVHEmbree : public BVH {
   void add_triangles(const Object *ob, const Mesh *mesh, int i);
 
  private:
+  void set_instance_transform(RTCGeometry geom_id, const Object *ob);
   void set_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh, const bool update);
   void set_curve_vertex_buffer(RTCGeometry geom_id, const Hair *hair, const bool update);
 
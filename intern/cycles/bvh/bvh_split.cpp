@@ -25,6 +25,7 @@
 #include "render/object.h"
 
 #include "util/util_algorithm.h"
+#include "util/util_tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -159,44 +160,46 @@ BVHSpatialSplit::BVHSpatialSplit(const BVHBuild &builder,
   float3 binSize = (range_bounds.max - origin) * (1.0f / (float)BVHParams::NUM_SPATIAL_BINS);
   float3 invBinSize = 1.0f / binSize;
 
-  for (int dim = 0; dim < 3; dim++) {
-    for (int i = 0; i < BVHParams::NUM_SPATIAL_BINS; i++) {
-      BVHSpatialBin &bin = storage_->bins[dim][i];
-
-      bin.bounds = BoundBox::empty;
-      bin.enter = 0;
-      bin.exit = 0;
-    }
-  }
-
   /* chop references into bins. */
-  for (unsigned int refIdx = range.start(); refIdx < range.end(); refIdx++) {
-    const BVHReference &ref = references_->at(refIdx);
-    BoundBox prim_bounds = get_prim_bounds(ref);
-    float3 firstBinf = (prim_bounds.min - origin) * invBinSize;
-    float3 lastBinf = (prim_bounds.max - origin) * invBinSize;
-    int3 firstBin = make_int3((int)firstBinf.x, (int)firstBinf.y, (int)firstBinf.z);
-    int3 lastBin = make_int3((int)lastBinf.x, (int)lastBinf.y, (int)lastBinf.z);
-
-    firstBin = clamp(firstBin, 0, BVHParams::NUM_SPATIAL_BINS - 1);
-    lastBin = clamp(lastBin, firstBin, BVHParams::NUM_SPATIAL_BINS - 1);
-
-    for (int dim = 0; dim < 3; dim++) {
-      BVHReference currRef(
-          get_prim_bounds(ref), ref.prim_index(), ref.prim_object(), ref.prim_type());
-
-      for (int i = firstBin[dim]; i < lastBin[dim]; i++) {
-        BVHReference leftRef, rightRef;
-
-        split_reference(
-            builder, leftRef, rightRef, currRef, dim, origin[dim] + binSize[dim] * (float)(i + 1));
-        storage_->bins[dim][i].bounds.grow(leftRef.bounds());
-        currRef = rightRef;
+  if (range.size() < PARALLEL_THRESHOLD) {
+    clear_bins(storage_->bins);
+    bin_references(
+        builder, range.start(), range.end(), origin, binSize, invBinSize, storage_->bins);
+  }
+  else {
+    /* While waiting for the loop this thread may run other build tasks which share its spatial
+     * storage, so the bins of all threads are only merged into it afterwards. */
+    struct SpatialBins {
+      BVHSpatialBin bins[3][BVHParams::NUM_SPATIAL_BINS];
+    };
+
+    SpatialBins empty_bins;
+    clear_bins(empty_bins.bins);
+    enumerable_thread_specific<SpatialBins> thread_bins(empty_bins);
+
+    parallel_for(blocked_range<int>(range.start(), range.end(), PARALLEL_BLOCK_SIZE),
+                 [&](const blocked_range<int> &r) {
+                   bin_references(builder,
+                                  r.begin(),
+                                  r.end(),
+                                  origin,
+                                  binSize,
+                                  invBinSize,
+                                  thread_bins.local().bins);
+                 });
+
+    clear_bins(storage_->bins);
+    for (const SpatialBins &local_bins : thread_bins) {
+      for (int dim = 0; dim < 3; dim++) {
+        for (int i = 0; i < BVHParams::NUM_SPATIAL_BINS; i++) {
+          BVHSpatialBin &bin = storage_->bins[dim][i];
+          const BVHSpatialBin &local_bin = local_bins.bins[dim][i];
+
+          bin.bounds.grow(local_bin.bounds);
+          bin.enter += local_bin.enter;
+          bin.exit += local_bin.exit;
+        }
       }
-
-      storage_->bins[dim][lastBin[dim]].bounds.grow(currRef.bounds());
-      storage_->bins[dim][firstBin[dim]].enter++;
-      storage_->bins[dim][lastBin[dim]].exit++;
     }
   }
 
@@ -233,6 +236,58 @@ BVHSpatialSplit::BVHSpatialSplit(const BVHBuild &builder,
   }
 }
 
+void BVHSpatialSplit::clear_bins(BVHSpatialBin bins[3][BVHParams::NUM_SPATIAL_BINS])
+{
+  for (int dim = 0; dim < 3; dim++) {
+    for (int i = 0; i < BVHParams::NUM_SPATIAL_BINS; i++) {
+      BVHSpatialBin &bin = bins[dim][i];
+
+      bin.bounds = BoundBox::empty;
+      bin.enter = 0;
+      bin.exit = 0;
+    }
+  }
+}
+
+void BVHSpatialSplit::bin_references(const BVHBuild &builder,
+                                     int start,
+                                     int end,
+                                     const float3 &origin,
+                                     const float3 &binSize,
+                                     const float3 &invBinSize,
+                                     BVHSpatialBin bins[3][BVHParams::NUM_SPATIAL_BINS])
+{
+  for (int refIdx = start; refIdx < end; refIdx++) {
+    const BVHReference &ref = references_->at(refIdx);
+    BoundBox prim_bounds = get_prim_bounds(ref);
+    float3 firstBinf = (prim_bounds.min - origin) * invBinSize;
+    float3 lastBinf = (prim_bounds.max - origin) * invBinSize;
+    int3 firstBin = make_int3((int)firstBinf.x, (int)firstBinf.y, (int)firstBinf.z);
+    int3 lastBin = make_int3((int)lastBinf.x, (int)lastBinf.y, (int)lastBinf.z);
+
+    firstBin = clamp(firstBin, 0, BVHParams::NUM_SPATIAL_BINS - 1);
+    lastBin = clamp(lastBin, firstBin, BVHParams::NUM_SPATIAL_BINS - 1);
+
+    for (int dim = 0; dim < 3; dim++) {
+      BVHReference currRef(
+          get_prim_bounds(ref), ref.prim_index(), ref.prim_object(), ref.prim_type());
+
+      for (int i = firstBin[dim]; i < lastBin[dim]; i++) {
+        BVHReference leftRef, rightRef;
+
+        split_reference(
+            builder, leftRef, rightRef, currRef, dim, origin[dim] + binSize[dim] * (float)(i + 1));
+        bins[dim][i].bounds.grow(leftRef.bounds());
+        currRef = rightRef;
+      }
+
+      bins[dim][lastBin[dim]].bounds.grow(currRef.bounds());
+      bins[dim][firstBin[dim]].enter++;
+      bins[dim][lastBin[dim]].exit++;
+    }
+  }
+}
+
 void BVHSpatialSplit::split(BVHBuild *builder,
                             BVHRange &left,
                             BVHRange &right,
@@ -97,11 +97,24 @@ class BVHSpatialSplit {
                        float pos);
 
  protected:
+  /* Ranges of at least this many references are binned on all threads, in blocks of the given
+   * size. */
+  enum { PARALLEL_THRESHOLD = 16384, PARALLEL_BLOCK_SIZE = 4096 };
+
   BVHSpatialStorage *storage_;
   vector<BVHReference> *references_;
   const BVHUnaligned *unaligned_heuristic_;
   const Transform *aligned_space_;
 
+  void clear_bins(BVHSpatialBin bins[3][BVHParams::NUM_SPATIAL_BINS]);
+  void bin_references(const BVHBuild &builder,
+                      int start,
+                      int end,
+                      const float3 &origin,
+                      const float3 &binSize,
+                      const float3 &invBinSize,
+                      BVHSpatialBin bins[3][BVHParams::NUM_SPATIAL_BINS]);
+
   /* Lower-level functions which calculates boundaries of left and right nodes
    * needed for spatial split.
    *
@@ -725,6 +725,27 @@ void CUDADevice::load_texture_info()
   }
 }
 
+/* Order in which memory is moved to host when running out of device memory. Image textures
+ * go first, then geometry data only read at shading points. BVH nodes and the primitive
+ * arrays read for every traversal step go last, since mapped host memory is slowest there. */
+static int move_to_host_priority(const device_memory &mem)
+{
+  if (mem.data_height > 1) {
+    return 2;
+  }
+
+  if (mem.name) {
+    /* Vertex indices are still needed to intersect motion triangles. */
+    const string name = mem.name;
+    if (string_startswith(name, "attributes_") || name == "patches" ||
+        (string_startswith(name, "tri_") && name != "tri_vindex")) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
 void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
 {
   /* Break out of recursive call, which can happen when moving memory on a multi device. */
@@ -740,7 +761,7 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
     /* Find suitable memory allocation to move. */
     device_memory *max_mem = NULL;
     size_t max_size = 0;
-    bool max_is_image = false;
+    int max_priority = -1;
 
     thread_scoped_lock lock(cuda_mem_map_mutex);
     foreach (CUDAMemMap::value_type &pair, cuda_mem_map) {
@@ -767,9 +788,11 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
         continue;
       }
 
-      /* Try to move largest allocation, prefer moving images. */
-      if (is_image > max_is_image || (is_image == max_is_image && mem.device_size > max_size)) {
-        max_is_image = is_image;
+      /* Try to move largest allocation, prefer moving memory that is not accessed during
+       * BVH traversal. */
+      const int priority = move_to_host_priority(mem);
+      if (priority > max_priority || (priority == max_priority && mem.device_size > max_size)) {
+        max_priority = priority;
         max_size = mem.device_size;
         max_mem = &mem;
       }
@@ -199,6 +199,9 @@ class CPUDevice : public Device {
   DeviceRequestedFeatures requested_features;
 
   KernelFunctions<void (*)(KernelGlobals *, float *, int, int, int, int, int)> path_trace_kernel;
+  KernelFunctions<bool (*)(
+      KernelGlobals *, float *, int, int, int, int, int, int, Intersection *)>
+      path_trace_primary_intersect_kernel;
   KernelFunctions<void (*)(KernelGlobals *, uchar4 *, float *, float, int, int, int, int)>
       convert_to_half_float_kernel;
   KernelFunctions<void (*)(KernelGlobals *, uchar4 *, float *, float, int, int, int, int)>
@@ -285,6 +288,7 @@ class CPUDevice : public Device {
         texture_info(this, "__texture_info", MEM_GLOBAL),
 #define REGISTER_KERNEL(name) name##_kernel(KERNEL_FUNCTIONS(name))
         REGISTER_KERNEL(path_trace),
+        REGISTER_KERNEL(path_trace_primary_intersect),
         REGISTER_KERNEL(convert_to_half_float),
         REGISTER_KERNEL(convert_to_byte),
         REGISTER_KERNEL(shader),
@@ -947,6 +951,8 @@ class CPUDevice : public Device {
     int start_sample = tile.start_sample;
     int end_sample = tile.start_sample + tile.num_samples;
 
+    vector<Intersection> primary_isects(tile.w);
+
     /* Needed for Embree. */
     SIMD_SET_FLUSH_TO_ZERO;
 
@@ -963,11 +969,20 @@ class CPUDevice : public Device {
 
       if (tile.task == RenderTile::PATH_TRACE) {
         for (int y = tile.y; y < tile.y + tile.h; y++) {
+          /* Trace the camera rays of the row together when possible. */
+          Intersection *row_isects = primary_isects.data();
+          const bool use_primary_isects = path_trace_primary_intersect_kernel()(
+              kg, render_buffer, sample, tile.x, y, tile.w, tile.offset, tile.stride, row_isects);
+
           for (int x = tile.x; x < tile.x + tile.w; x++) {
             if (use_coverage) {
               coverage.init_pixel(x, y);
             }
+            if (use_primary_isects) {
+              kg->primary_isect = &primary_isects[x - tile.x];
+            }
             path_trace_kernel()(kg, render_buffer, sample, x, y, tile.offset, tile.stride);
+            kg->primary_isect = NULL;
           }
         }
       }
@@ -1484,6 +1499,7 @@ class CPUDevice : public Device {
     }
     kg.decoupled_volume_steps_index = 0;
     kg.coverage_asset = kg.coverage_object = kg.coverage_material = NULL;
+    kg.primary_isect = NULL;
 #ifdef WITH_OSL
     OSLShader::thread_init(&kg, &kernel_globals, &osl_globals);
 #endif
@@ -20,6 +20,7 @@
 
 #include "util/util_foreach.h"
 #include "util/util_logging.h"
+#include "util/util_md5.h"
 
 #if defined(WITH_NETWORK)
 
@@ -41,6 +42,23 @@ static TileList::iterator tile_list_find(TileList &tile_list, RenderTile &tile)
   return tile_list.end();
 }
 
+/* hash the host data of a buffer, to detect copies that would not change it */
+static string device_memory_hash(const device_memory &mem)
+{
+  MD5Hash md5;
+  const uint8_t *data = (const uint8_t *)mem.host_pointer;
+  size_t size = mem.memory_size();
+
+  while (size > 0) {
+    const int chunk_size = (int)min(size, (size_t)INT_MAX);
+    md5.append(data, chunk_size);
+    data += chunk_size;
+    size -= chunk_size;
+  }
+
+  return md5.get_hex();
+}
+
 class NetworkDevice : public Device {
  public:
   boost::asio::io_service io_service;
@@ -48,6 +66,9 @@ class NetworkDevice : public Device {
   device_ptr mem_counter;
   DeviceTask the_task; /* todo: handle multiple tasks */
 
+  /* hash of the data last copied to each buffer on the server */
+  map<device_ptr, string> mem_hashes;
+
   thread_mutex rpc_lock;
 
   virtual bool show_samples() const
@@ -109,8 +130,24 @@ class NetworkDevice : public Device {
 
   void mem_copy_to(device_memory &mem)
   {
+    /* Scene updates copy all buffers of a changed manager, skip the ones whose contents the
+     * server already has, so that only modified data goes over the network. Only done for
+     * scene data, kernels can write to the other buffers on the server. */
+    const bool use_hash = mem.device_pointer &&
+                          (mem.type == MEM_READ_ONLY || mem.type == MEM_GLOBAL ||
+                           mem.type == MEM_TEXTURE);
+    const string hash = (use_hash) ? device_memory_hash(mem) : string();
+
     thread_scoped_lock lock(rpc_lock);
 
+    if (use_hash) {
+      string &sent_hash = mem_hashes[mem.device_pointer];
+      if (sent_hash == hash) {
+        return;
+      }
+      sent_hash = hash;
+    }
+
     RPCSend snd(socket, &error_func, "mem_copy_to");
 
     snd.add(mem);
@@ -141,6 +178,8 @@ class NetworkDevice : public Device {
   {
     thread_scoped_lock lock(rpc_lock);
 
+    mem_hashes.erase(mem.device_pointer);
+
     RPCSend snd(socket, &error_func, "mem_zero");
 
     snd.add(mem);
@@ -157,6 +196,7 @@ class NetworkDevice : public Device {
       snd.add(mem);
       snd.write();
 
+      mem_hashes.erase(mem.device_pointer);
       mem.device_pointer = 0;
     }
   }
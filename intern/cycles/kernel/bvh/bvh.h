@@ -236,6 +236,62 @@ ccl_device_intersect bool scene_intersect(KernelGlobals *kg,
 #endif   /* __KERNEL_OPTIX__ */
 }
 
+#ifdef __EMBREE__
+/* Number of rays traced together by scene_intersect_stream(). */
+#  define SCENE_INTERSECT_STREAM_SIZE 64
+
+/* Streams are only supported for scenes without curves, the filter callbacks of thick curves
+ * only handle single rays. */
+ccl_device_inline bool scene_intersect_stream_supported(KernelGlobals *kg)
+{
+  return kernel_data.bvh.scene && !kernel_data.bvh.have_curves;
+}
+
+/* Intersect up to SCENE_INTERSECT_STREAM_SIZE rays at once. Embree traces coherent rays such as
+ * camera rays as packets, which is faster than tracing them one by one. Rays that are not valid
+ * get an intersection with PRIM_NONE as primitive. */
+ccl_device void scene_intersect_stream(KernelGlobals *kg,
+                                       const Ray *rays,
+                                       const uint visibility,
+                                       Intersection *isects,
+                                       const int num_rays)
+{
+  PROFILING_INIT(kg, PROFILING_INTERSECT);
+
+  kernel_assert(scene_intersect_stream_supported(kg));
+  kernel_assert(num_rays <= SCENE_INTERSECT_STREAM_SIZE);
+
+  CCLIntersectContext ctx(kg, CCLIntersectContext::RAY_REGULAR);
+  IntersectContext rtc_ctx(&ctx);
+  rtc_ctx.context.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
+
+  RTCRayHit ray_hits[SCENE_INTERSECT_STREAM_SIZE];
+  for (int i = 0; i < num_rays; i++) {
+    kernel_embree_setup_rayhit(rays[i], ray_hits[i], visibility);
+    if (rays[i].t == 0.0f || !scene_intersect_valid(&rays[i])) {
+      /* Rays with tnear greater than tfar are ignored by Embree. */
+      ray_hits[i].ray.tfar = -FLT_MAX;
+    }
+  }
+
+  rtcIntersect1M(kernel_data.bvh.scene, &rtc_ctx.context, ray_hits, num_rays, sizeof(RTCRayHit));
+
+  for (int i = 0; i < num_rays; i++) {
+    Intersection *isect = &isects[i];
+    isect->t = rays[i].t;
+    if (ray_hits[i].hit.geomID != RTC_INVALID_GEOMETRY_ID &&
+        ray_hits[i].hit.primID != RTC_INVALID_GEOMETRY_ID) {
+      kernel_embree_convert_hit(kg, &ray_hits[i].ray, &ray_hits[i].hit, isect);
+    }
+    else {
+      isect->prim = PRIM_NONE;
+      isect->object = OBJECT_NONE;
+      isect->type = PRIMITIVE_NONE;
+    }
+  }
+}
+#endif /* __EMBREE__ */
+
 #ifdef __BVH_LOCAL__
 ccl_device_intersect bool scene_intersect_local(KernelGlobals *kg,
                                                 const Ray *ray,
@@ -28,6 +28,20 @@ ccl_device_forceinline Transform bvh_unaligned_node_fetch_space(KernelGlobals *k
   return space;
 }
 
+/* Decode the quantized planes of both children along one axis, returned as
+ * (child0 min, child1 min, child0 max, child1 max). */
+ccl_device_forceinline float4 bvh_aligned_node_dequantize(const float planes,
+                                                          const float origin,
+                                                          const uint exponent)
+{
+  const uint q = __float_as_uint(planes);
+  const float scale = __uint_as_float(exponent << 23);
+  return make_float4(origin + (float)(q & 0xFF) * scale,
+                     origin + (float)((q >> 8) & 0xFF) * scale,
+                     origin + (float)((q >> 16) & 0xFF) * scale,
+                     origin + (float)(q >> 24) * scale);
+}
+
 ccl_device_forceinline int bvh_aligned_node_intersect(KernelGlobals *kg,
                                                       const float3 P,
                                                       const float3 idir,
@@ -41,9 +55,13 @@ ccl_device_forceinline int bvh_aligned_node_intersect(KernelGlobals *kg,
 #ifdef __VISIBILITY_FLAG__
   float4 cnodes = kernel_tex_fetch(__bvh_nodes, node_addr + 0);
 #endif
-  float4 node0 = kernel_tex_fetch(__bvh_nodes, node_addr + 1);
-  float4 node1 = kernel_tex_fetch(__bvh_nodes, node_addr + 2);
-  float4 node2 = kernel_tex_fetch(__bvh_nodes, node_addr + 3);
+  float4 origin = kernel_tex_fetch(__bvh_nodes, node_addr + 1);
+  float4 planes = kernel_tex_fetch(__bvh_nodes, node_addr + 2);
+
+  const uint exponents = __float_as_uint(origin.w);
+  float4 node0 = bvh_aligned_node_dequantize(planes.x, origin.x, exponents & 0xFF);
+  float4 node1 = bvh_aligned_node_dequantize(planes.y, origin.y, (exponents >> 8) & 0xFF);
+  float4 node2 = bvh_aligned_node_dequantize(planes.z, origin.z, (exponents >> 16) & 0xFF);
 
   /* intersect ray against child nodes */
   float c0lox = (node0.x - P.x) * idir.x;
@@ -73,6 +73,10 @@ typedef struct KernelGlobals {
   VolumeStep *decoupled_volume_steps[2];
   int decoupled_volume_steps_index;
 
+  /* Camera ray intersection of the current pixel when it was traced ahead of time, see
+   * kernel_path_trace_primary_intersect(). NULL otherwise. */
+  Intersection *primary_isect;
+
   /* A buffer for storing per-pixel coverage for Cryptomatte. */
   CoverageMap *coverage_object;
   CoverageMap *coverage_material;
@@ -153,7 +153,7 @@ ccl_device_inline bool lamp_light_sample(
     }
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= kernel_data.integrator.pdf_lights * klight->distribution_weight;
 
   return (ls->pdf > 0.0f);
 }
@@ -291,7 +291,7 @@ ccl_device bool lamp_light_eval(
     return false;
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= kernel_data.integrator.pdf_lights * klight->distribution_weight;
 
   return true;
 }
@@ -583,9 +583,8 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
 ccl_device int light_distribution_sample(KernelGlobals *kg, float *randu)
 {
   /* This is basically std::upper_bound as used by PBRT, to find a point light or
-   * triangle to emit from, proportional to area. a good improvement would be to
-   * also sample proportional to power, though it's not so well defined with
-   * arbitrary shaders. */
+   * triangle to emit from, proportional to area. Lamps are additionally weighted by
+   * their strength, emission of arbitrary shaders is not so well defined. */
   int first = 0;
   int len = kernel_data.integrator.num_distribution + 1;
   float r = *randu;
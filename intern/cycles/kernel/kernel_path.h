@@ -69,6 +69,18 @@ ccl_device_forceinline bool kernel_path_scene_intersect(KernelGlobals *kg,
     ray->t = kernel_data.background.ao_distance;
   }
 
+#ifdef __KERNEL_CPU__
+  if (kg->primary_isect != NULL) {
+    /* The camera ray was traced together with the other pixels of its row. */
+    const Intersection *primary_isect = kg->primary_isect;
+    kg->primary_isect = NULL;
+    if (visibility == PATH_RAY_CAMERA) {
+      *isect = *primary_isect;
+      return isect->prim != PRIM_NONE;
+    }
+  }
+#endif
+
   bool hit = scene_intersect(kg, ray, visibility, isect);
 
 #ifdef __KERNEL_DEBUG__
@@ -694,6 +706,50 @@ ccl_device void kernel_path_trace(
   kernel_write_result(kg, buffer, sample, &L);
 }
 
+#  ifdef __EMBREE__
+/* Trace the camera rays of a row of pixels as streams, before the pixels are path traced.
+ * kernel_path_scene_intersect() then uses the result through KernelGlobals.primary_isect.
+ * Returns false if the camera rays need to be traced one by one. */
+ccl_device bool kernel_path_trace_primary_intersect(KernelGlobals *kg,
+                                                    ccl_global float *buffer,
+                                                    int sample,
+                                                    int x,
+                                                    int y,
+                                                    int w,
+                                                    int offset,
+                                                    int stride,
+                                                    Intersection *isects)
+{
+  if (!scene_intersect_stream_supported(kg)) {
+    return false;
+  }
+
+  const int pass_stride = kernel_data.film.pass_stride;
+  Ray rays[SCENE_INTERSECT_STREAM_SIZE];
+
+  for (int i = 0; i < w; i += SCENE_INTERSECT_STREAM_SIZE) {
+    const int num_rays = min(w - i, SCENE_INTERSECT_STREAM_SIZE);
+    for (int j = 0; j < num_rays; j++) {
+      const int px = x + i + j;
+      uint rng_hash;
+      kernel_path_trace_setup(kg, sample, px, y, &rng_hash, &rays[j]);
+
+      /* Skip pixels that kernel_path_trace() will not render. */
+      if (kernel_data.film.pass_adaptive_aux_buffer) {
+        ccl_global float4 *aux = (ccl_global float4 *)(buffer +
+                                                       (offset + px + y * stride) * pass_stride +
+                                                       kernel_data.film.pass_adaptive_aux_buffer);
+        if ((*aux).w > 0.0f) {
+          rays[j].t = 0.0f;
+        }
+      }
+    }
+    scene_intersect_stream(kg, rays, PATH_RAY_CAMERA, isects + i, num_rays);
+  }
+  return true;
+}
+#  endif /* __EMBREE__ */
+
 #endif /* __SPLIT_KERNEL__ */
 
 CCL_NAMESPACE_END
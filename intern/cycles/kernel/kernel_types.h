@@ -1521,7 +1521,8 @@ typedef struct KernelLight {
   float max_bounces;
   float random;
   float strength[3];
-  float pad1;
+  /* Probability of picking the light relative to uniform light sampling. */
+  float distribution_weight;
   Transform tfm;
   Transform itfm;
   union {
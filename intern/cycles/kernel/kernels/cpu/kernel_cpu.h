@@ -19,6 +19,16 @@
 void KERNEL_FUNCTION_FULL_NAME(path_trace)(
     KernelGlobals *kg, float *buffer, int sample, int x, int y, int offset, int stride);
 
+bool KERNEL_FUNCTION_FULL_NAME(path_trace_primary_intersect)(KernelGlobals *kg,
+                                                            float *buffer,
+                                                            int sample,
+                                                            int x,
+                                                            int y,
+                                                            int w,
+                                                            int offset,
+                                                            int stride,
+                                                            Intersection *isects);
+
 void KERNEL_FUNCTION_FULL_NAME(convert_to_byte)(KernelGlobals *kg,
                                                 uchar4 *rgba,
                                                 float *buffer,
@@ -98,6 +98,27 @@ void KERNEL_FUNCTION_FULL_NAME(path_trace)(
 #  endif /* KERNEL_STUB */
 }
 
+bool KERNEL_FUNCTION_FULL_NAME(path_trace_primary_intersect)(KernelGlobals *kg,
+                                                            float *buffer,
+                                                            int sample,
+                                                            int x,
+                                                            int y,
+                                                            int w,
+                                                            int offset,
+                                                            int stride,
+                                                            Intersection *isects)
+{
+#  ifdef KERNEL_STUB
+  STUB_ASSERT(KERNEL_ARCH, path_trace_primary_intersect);
+  return false;
+#  elif defined(__EMBREE__)
+  return kernel_path_trace_primary_intersect(
+      kg, buffer, sample, x, y, w, offset, stride, isects);
+#  else
+  return false;
+#  endif /* KERNEL_STUB */
+}
+
 /* Film */
 
 void KERNEL_FUNCTION_FULL_NAME(convert_to_byte)(KernelGlobals *kg,
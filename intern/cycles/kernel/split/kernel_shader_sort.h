@@ -54,7 +54,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
   }
   ccl_barrier(CCL_LOCAL_MEM_FENCE);
 
-  /* skip sorting for cpu split kernel */
 #  ifdef __KERNEL_OPENCL__
 
   /* bitonic sort */
@@ -77,6 +76,34 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
       }
     }
   }
+#  else
+  /* On the CPU the local size is one, so each work item owns a whole block and sorts it
+   * sequentially. Use a stable bottom-up merge sort so that rays hitting the same shader are
+   * evaluated one after another, which keeps the shader code and data hot in the caches. */
+  ushort tmp_index[SHADER_SORT_BLOCK_SIZE];
+  ushort *src = local_index;
+  ushort *dst = tmp_index;
+  for (uint width = 1; width < SHADER_SORT_BLOCK_SIZE; width <<= 1) {
+    for (uint start = 0; start < SHADER_SORT_BLOCK_SIZE; start += 2 * width) {
+      const uint mid = start + width;
+      const uint end = start + 2 * width;
+      uint a = start, b = mid;
+      for (uint k = start; k < end; k++) {
+        if (a < mid && (b >= end || local_value[src[a]] <= local_value[src[b]])) {
+          dst[k] = src[a++];
+        }
+        else {
+          dst[k] = src[b++];
+        }
+      }
+    }
+    ushort *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+  if (src != local_index) {
+    memcpy(local_index, src, sizeof(tmp_index));
+  }
 #  endif /* __KERNEL_OPENCL__ */
 
   /* copy to destination */
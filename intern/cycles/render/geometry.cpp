@@ -1229,8 +1229,12 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG(1) << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
+  /* BVH2 packs the instance BVHs into the top level and has to be rebuilt, Embree only updates
+   * the modified geometry and instance transforms, and OptiX rebuilds just the instance list */
   const bool can_refit = scene->bvh != nullptr &&
-                         (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX);
+                         (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
+                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_EMBREE ||
+                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_MULTI_OPTIX_EMBREE);
   const bool pack_all = scene->bvh == nullptr;
 
   BVH *bvh = scene->bvh;
@@ -1546,10 +1550,25 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
     device_update_flags |= DEVICE_CURVE_DATA_NEEDS_REALLOC;
   }
 
+  /* the scene BVH can only be refit if it was built for the same objects */
+  bool need_scene_bvh_rebuild = false;
+  if (scene->bvh) {
+    need_scene_bvh_rebuild = (scene->bvh->objects != scene->objects ||
+                              scene->bvh->geometry != scene->geometry);
+
+    foreach (Object *object, scene->objects) {
+      if (object->geometry_is_modified()) {
+        need_scene_bvh_rebuild = true;
+        break;
+      }
+    }
+  }
+
   /* tag the device arrays for reallocation or modification */
   DeviceScene *dscene = &scene->dscene;
 
-  if (device_update_flags & (DEVICE_MESH_DATA_NEEDS_REALLOC | DEVICE_CURVE_DATA_NEEDS_REALLOC)) {
+  if (need_scene_bvh_rebuild ||
+      (device_update_flags & (DEVICE_MESH_DATA_NEEDS_REALLOC | DEVICE_CURVE_DATA_NEEDS_REALLOC))) {
     delete scene->bvh;
     scene->bvh = nullptr;
 
@@ -1900,7 +1919,7 @@ void GeometryManager::device_update(Device *device,
 
   /* update the bvh even when there is no geometry so the kernel bvh data is still valid,
    * especially when removing all of the objects during interactive renders */
-  bool need_update_scene_bvh = (scene->bvh == nullptr);
+  bool need_update_scene_bvh = (scene->bvh == nullptr || (update_flags & TRANSFORM_MODIFIED));
   {
     scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
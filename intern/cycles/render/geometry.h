@@ -185,6 +185,9 @@ class GeometryManager {
     SHADER_ATTRIBUTE_MODIFIED = (1 << 8),
     SHADER_DISPLACEMENT_MODIFIED = (1 << 9),
 
+    /* transform of an instance changed, only the top level BVH needs an update */
+    TRANSFORM_MODIFIED = (1 << 10),
+
     GEOMETRY_ADDED = MESH_ADDED | HAIR_ADDED,
     GEOMETRY_REMOVED = MESH_REMOVED | HAIR_REMOVED,
 
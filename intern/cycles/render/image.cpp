@@ -274,6 +274,11 @@ ImageLoader::ImageLoader()
 {
 }
 
+bool ImageLoader::load_metadata_mip_level(ImageMetaData &, const int)
+{
+  return false;
+}
+
 ustring ImageLoader::osl_filepath() const
 {
   return ustring();
@@ -498,11 +503,18 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
     return false;
   }
 
-  /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  /* Get metadata. Files with pre-filtered levels are read at the resolution closest to the
+   * texture limit. */
+  ImageMetaData metadata = img->metadata;
+  if (texture_limit > 0 && img->loader->load_metadata_mip_level(metadata, texture_limit)) {
+    VLOG(1) << "Loading image " << img->loader->name() << " at a resolution of "
+            << metadata.width << "x" << metadata.height << ".";
+  }
+
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
@@ -529,8 +541,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
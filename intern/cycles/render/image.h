@@ -107,6 +107,12 @@ class ImageLoader {
   /* Load metadata without actual image yet, should be fast. */
   virtual bool load_metadata(ImageMetaData &metadata) = 0;
 
+  /* Optional: lower the resolution in the metadata to the largest pre-filtered level stored in
+   * the file that fits in max_size. load_pixels() then reads that level instead of the full
+   * resolution image, which avoids reading and resizing large images when a texture limit is
+   * used. Returns false if the image was left unchanged. */
+  virtual bool load_metadata_mip_level(ImageMetaData &metadata, const int max_size);
+
   /* Load actual image contents. */
   virtual bool load_pixels(const ImageMetaData &metadata,
                            void *pixels,
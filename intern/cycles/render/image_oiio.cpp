@@ -103,6 +103,58 @@ bool OIIOImageLoader::load_metadata(ImageMetaData &metadata)
   return true;
 }
 
+static size_t oiio_spec_max_size(const ImageSpec &spec)
+{
+  return (size_t)max(max(spec.width, spec.height), spec.depth);
+}
+
+bool OIIOImageLoader::load_metadata_mip_level(ImageMetaData &metadata, const int max_size)
+{
+  unique_ptr<ImageInput> in(ImageInput::create(filepath.string()));
+
+  ImageSpec spec;
+  if (!in || !in->open(filepath.string(), spec)) {
+    return false;
+  }
+
+  /* Find the first level that fits, or the smallest one if none does. Files without MIP levels
+   * (anything but tiled TIFF, EXR and .tx files) only have level 0. */
+  int miplevel = 0;
+  ImageSpec level_spec;
+  while (oiio_spec_max_size(spec) > (size_t)max_size &&
+         in->seek_subimage(0, miplevel + 1, level_spec)) {
+    spec = level_spec;
+    miplevel++;
+  }
+  in->close();
+
+  if (miplevel == 0) {
+    return false;
+  }
+
+  metadata.width = spec.width;
+  metadata.height = spec.height;
+  metadata.depth = spec.depth;
+  return true;
+}
+
+/* Select the MIP level matching the resolution of the metadata, see
+ * #OIIOImageLoader::load_metadata_mip_level. */
+static bool oiio_seek_mip_level(const ImageMetaData &metadata,
+                                const unique_ptr<ImageInput> &in,
+                                ImageSpec &spec)
+{
+  for (int miplevel = 0;; miplevel++) {
+    if ((size_t)spec.width == metadata.width && (size_t)spec.height == metadata.height &&
+        (size_t)spec.depth == metadata.depth) {
+      return true;
+    }
+    if (!in->seek_subimage(0, miplevel + 1, spec)) {
+      return false;
+    }
+  }
+}
+
 template<TypeDesc::BASETYPE FileFormat, typename StorageType>
 static void oiio_load_pixels(const ImageMetaData &metadata,
                              const unique_ptr<ImageInput> &in,
@@ -192,6 +244,10 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     return false;
   }
 
+  if (!oiio_seek_mip_level(metadata, in, spec)) {
+    return false;
+  }
+
   switch (metadata.type) {
     case IMAGE_DATA_TYPE_BYTE:
     case IMAGE_DATA_TYPE_BYTE4:
@@ -28,6 +28,8 @@ class OIIOImageLoader : public ImageLoader {
 
   bool load_metadata(ImageMetaData &metadata) override;
 
+  bool load_metadata_mip_level(ImageMetaData &metadata, const int max_size) override;
+
   bool load_pixels(const ImageMetaData &metadata,
                    void *pixels,
                    const size_t pixels_size,
@@ -36,6 +36,44 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Fraction of the lamp sampling probability that is distributed uniformly, so that lamps with a
+ * textured or otherwise underestimated emission still get samples. */
+static const float LIGHT_UNIFORM_WEIGHT = 0.1f;
+
+/* Lamps with a finite position are picked proportionally to their strength. Distant and
+ * background lights keep the uniform probability, their strength is not comparable. */
+static bool light_use_power_weight(const Light *light)
+{
+  const LightType type = light->get_light_type();
+  return type == LIGHT_POINT || type == LIGHT_SPOT || type == LIGHT_AREA;
+}
+
+static float light_power_estimate(const Light *light)
+{
+  return average(fabs(light->get_strength()));
+}
+
+/* Light updates are triggered by many object and shader changes that leave the light data
+ * itself unchanged, for example between animation frames with persistent data. Only upload
+ * the new data when it differs from what the device already has. */
+template<typename T>
+static void light_device_vector_update(device_vector<T> &vector, const array<T> &data)
+{
+  if (data.size() == 0) {
+    vector.free();
+    return;
+  }
+
+  if (vector.device_pointer && vector.size() == data.size() &&
+      memcmp(vector.data(), data.data(), sizeof(T) * data.size()) == 0) {
+    return;
+  }
+
+  T *vector_data = vector.alloc(data.size());
+  memcpy(vector_data, data.data(), sizeof(T) * data.size());
+  vector.copy_to_device();
+}
+
 static void shade_background_pixels(Device *device,
                                     DeviceScene *dscene,
                                     int width,
@@ -329,7 +367,8 @@ void LightManager::device_update_distribution(Device *,
   VLOG(1) << "Total " << num_distribution << " of light distribution primitives.";
 
   /* emission area */
-  KernelLightDistribution *distribution = dscene->light_distribution.alloc(num_distribution + 1);
+  array<KernelLightDistribution> distribution_array(num_distribution + 1);
+  KernelLightDistribution *distribution = distribution_array.data();
   float totarea = 0.0f;
 
   /* triangles */
@@ -409,6 +448,8 @@ void LightManager::device_update_distribution(Device *,
   float lightarea = (totarea > 0.0f) ? totarea / num_lights : 1.0f;
   bool use_lamp_mis = false;
 
+  const KernelLight *klights = dscene->lights.data();
+
   int light_index = 0;
   foreach (Light *light, scene->lights) {
     if (!light->is_enabled)
@@ -418,7 +459,7 @@ void LightManager::device_update_distribution(Device *,
     distribution[offset].prim = ~light_index;
     distribution[offset].lamp.pad = 1.0f;
     distribution[offset].lamp.size = light->size;
-    totarea += lightarea;
+    totarea += lightarea * klights[light_index].distribution_weight;
 
     if (light->light_type == LIGHT_DISTANT) {
       use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
@@ -495,7 +536,7 @@ void LightManager::device_update_distribution(Device *,
       kfilm->pass_shadow_scale *= (float)(num_lights - num_background_lights) / (float)num_lights;
 
     /* CDF */
-    dscene->light_distribution.copy_to_device();
+    light_device_vector_update(dscene->light_distribution, distribution_array);
 
     /* Portals */
     if (num_portals > 0) {
@@ -736,13 +777,36 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
     }
   }
 
-  KernelLight *klights = dscene->lights.alloc(num_lights);
-
   if (num_lights == 0) {
     VLOG(1) << "No effective light, ignoring points update.";
+    dscene->lights.free();
     return;
   }
 
+  /* Cleared so that unused union members and padding compare equal between updates. */
+  array<KernelLight> klights_array(num_lights);
+  KernelLight *klights = klights_array.data();
+  memset(klights, 0, sizeof(KernelLight) * num_lights);
+
+  /* Sample all lights in branched path tracing relies on every lamp having the same
+   * probability, so only weight lamps when one of them is picked at random. */
+  Integrator *integrator = scene->integrator;
+  const bool use_power_weight = !(integrator->get_method() == Integrator::BRANCHED_PATH &&
+                                  (integrator->get_sample_all_lights_direct() ||
+                                   integrator->get_sample_all_lights_indirect()));
+
+  float total_power = 0.0f;
+  int num_weighted_lights = 0;
+
+  if (use_power_weight) {
+    foreach (Light *light, scene->lights) {
+      if (light->is_enabled && light_use_power_weight(light)) {
+        total_power += light_power_estimate(light);
+        num_weighted_lights++;
+      }
+    }
+  }
+
   int light_index = 0;
 
   foreach (Light *light, scene->lights) {
@@ -782,6 +846,15 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
     klights[light_index].strength[1] = light->strength.y;
     klights[light_index].strength[2] = light->strength.z;
 
+    /* Weights of all lamps average to one, keeping the uniform probability for other lights. */
+    float distribution_weight = 1.0f;
+    if (total_power > 0.0f && light_use_power_weight(light)) {
+      distribution_weight = LIGHT_UNIFORM_WEIGHT + (1.0f - LIGHT_UNIFORM_WEIGHT) *
+                                                       num_weighted_lights *
+                                                       light_power_estimate(light) / total_power;
+    }
+    klights[light_index].distribution_weight = distribution_weight;
+
     if (light->light_type == LIGHT_POINT) {
       shader_id &= ~SHADER_AREA_LIGHT;
 
@@ -956,7 +1029,7 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
 
   VLOG(1) << "Number of lights without contribution: " << num_scene_lights - light_index;
 
-  dscene->lights.copy_to_device();
+  light_device_vector_update(dscene->lights, klights_array);
 }
 
 void LightManager::device_update(Device *device,
@@ -978,7 +1051,11 @@ void LightManager::device_update(Device *device,
   /* Detect which lights are enabled, also determins if we need to update the background. */
   test_enabled_lights(scene);
 
-  device_free(device, dscene, need_update_background);
+  /* Light arrays stay on the device and are only uploaded again when their data changes. */
+  if (need_update_background) {
+    dscene->light_background_marginal_cdf.free();
+    dscene->light_background_conditional_cdf.free();
+  }
 
   use_light_visibility = false;
 
@@ -1128,7 +1205,8 @@ void LightManager::device_update_ies(DeviceScene *dscene)
     /* ies_lights starts with an offset table that contains the offset of every slot,
      * or -1 if the slot is invalid.
      * Following that table, the packed valid IES lights are stored. */
-    float *data = dscene->ies_lights.alloc(ies_slots.size() + packed_size);
+    array<float> ies_lights(ies_slots.size() + packed_size);
+    float *data = ies_lights.data();
 
     int offset = ies_slots.size();
     for (int i = 0; i < ies_slots.size(); i++) {
@@ -1143,7 +1221,10 @@ void LightManager::device_update_ies(DeviceScene *dscene)
       }
     }
 
-    dscene->ies_lights.copy_to_device();
+    light_device_vector_update(dscene->ies_lights, ies_lights);
+  }
+  else {
+    dscene->ies_lights.free();
   }
 }
 
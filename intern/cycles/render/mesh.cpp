@@ -198,6 +198,7 @@ Mesh::Mesh(const NodeType *node_type, Type geom_type_)
 
   subdivision_type = SUBDIVISION_NONE;
   subd_params = NULL;
+  subd_dicing_camera = transform_identity();
 
   patch_table = NULL;
 }
@@ -284,6 +285,8 @@ void Mesh::clear_non_sockets()
   num_subd_verts = 0;
   num_subd_faces = 0;
 
+  subd_dicing_hash = "";
+
   vert_to_stitching_key_map.clear();
   vert_stitching_map.clear();
 
@@ -167,6 +167,11 @@ class Mesh : public Geometry {
 
   AttributeSet subd_attributes;
 
+  /* Hash of the subdivision input and the dicing camera transform the current tessellation was
+   * created from, so synchronizing the same input again can keep the diced and displaced mesh. */
+  string subd_dicing_hash;
+  Transform subd_dicing_camera;
+
  private:
   PackedPatchTable *patch_table;
   /* BVH */
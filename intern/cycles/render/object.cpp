@@ -220,7 +220,7 @@ void Object::tag_update(Scene *scene)
   }
 
   if (geometry) {
-    if (tfm_is_modified()) {
+    if (tfm_is_modified() && geometry->transform_applied) {
       /* tag the geometry as modified so the BVH is updated, but do not tag everything as modified
        */
       if (geometry->is_mesh() || geometry->is_volume()) {
@@ -232,6 +232,11 @@ void Object::tag_update(Scene *scene)
         hair->tag_curve_keys_modified();
       }
     }
+    else if (tfm_is_modified() || motion_is_modified()) {
+      /* the geometry is instanced, so its own BVH is unaffected and only the instance in the top
+       * level BVH has to be updated */
+      scene->geometry_manager->tag_update(scene, GeometryManager::TRANSFORM_MODIFIED);
+    }
 
     foreach (Node *node, geometry->get_used_shaders()) {
       Shader *shader = static_cast<Shader *>(node);
@@ -496,6 +496,8 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
       rtile.stealing_state = RenderTile::CAN_BE_STOLEN;
     }
 
+    tile->start_time = time_dt();
+
     if (read_bake_tile_cb) {
       rtile.task = RenderTile::BAKE;
     }
@@ -618,6 +620,15 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
 
   progress.add_finished_tile(rtile.task == RenderTile::DENOISE);
 
+  /* Measure device speed, skipping tiles that were partially rendered by another device. */
+  if (rtile.task == RenderTile::PATH_TRACE && rtile.start_sample == tile_manager.state.sample) {
+    const Tile &tile = tile_manager.state.tiles[rtile.tile_index];
+    const int num_samples = rtile.sample - rtile.start_sample;
+    const uint64_t pixel_samples = (uint64_t)rtile.w * rtile.h * num_samples;
+    tile_manager.update_device_throughput(
+        tile.device, pixel_samples, time_dt() - tile.start_time);
+  }
+
   bool delete_tile;
 
   if (tile_manager.finish_tile(rtile.tile_index, need_denoise, delete_tile)) {
@@ -700,8 +711,8 @@ void Session::map_neighbor_tiles(RenderTileNeighbors &neighbors, Device *tile_de
           }
         }
         else {
-          int px = center_tile.x + dx * params.tile_size.x;
-          int py = center_tile.y + dy * params.tile_size.y;
+          int px = center_tile.x + dx * tile_manager.get_tile_size().x;
+          int py = center_tile.y + dy * tile_manager.get_tile_size().y;
 
           rtile.x = clamp(px, image_region.x, image_region.z);
           rtile.y = clamp(py, image_region.y, image_region.w);
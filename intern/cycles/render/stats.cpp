@@ -354,6 +354,20 @@ string UpdateTimeStats::full_report(int indent_level)
   return times.full_report(indent_level + 1);
 }
 
+string UpdateTimeStats::json_report()
+{
+  string result = string_printf("{\"total_time\": %f, \"entries\": {", times.total_time);
+  for (size_t i = 0; i < times.entries.size(); i++) {
+    string name = times.entries[i].name;
+    string_replace(name, "\\", "\\\\");
+    string_replace(name, "\"", "\\\"");
+    result += string_printf(
+        "%s\"%s\": %f", (i > 0) ? ", " : "", name.c_str(), times.entries[i].time);
+  }
+  result += "}}";
+  return result;
+}
+
 SceneUpdateStats::SceneUpdateStats()
 {
 }
@@ -379,6 +393,28 @@ string SceneUpdateStats::full_report()
   return result;
 }
 
+string SceneUpdateStats::json_report()
+{
+  string result = "{";
+  result += "\"scene\": " + scene.json_report();
+  result += ", \"geometry\": " + geometry.json_report();
+  result += ", \"light\": " + light.json_report();
+  result += ", \"object\": " + object.json_report();
+  result += ", \"image\": " + image.json_report();
+  result += ", \"background\": " + background.json_report();
+  result += ", \"bake\": " + bake.json_report();
+  result += ", \"camera\": " + camera.json_report();
+  result += ", \"film\": " + film.json_report();
+  result += ", \"integrator\": " + integrator.json_report();
+  result += ", \"osl\": " + osl.json_report();
+  result += ", \"particles\": " + particles.json_report();
+  result += ", \"svm\": " + svm.json_report();
+  result += ", \"tables\": " + tables.json_report();
+  result += ", \"procedurals\": " + procedurals.json_report();
+  result += "}";
+  return result;
+}
+
 void SceneUpdateStats::clear()
 {
   geometry.times.clear();
@@ -198,6 +198,9 @@ class UpdateTimeStats {
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
 
+  /* Generate report as JSON object, with times in seconds. */
+  string json_report();
+
   NamedTimeStats times;
 };
 
@@ -223,6 +226,9 @@ class SceneUpdateStats {
 
   string full_report();
 
+  /* Generate machine-readable report as a single JSON object. */
+  string json_report();
+
   void clear();
 };
 
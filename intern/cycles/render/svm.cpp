@@ -229,6 +229,17 @@ int SVMCompiler::stack_find_offset(int size)
       while (i >= offset)
         active_stack.users[i--] = 1;
 
+      /* Constants in the reused space will be overwritten. */
+      for (size_t j = 0; j < stack_constants.size();) {
+        const StackConstant &constant = stack_constants[j];
+        if (constant.offset < offset + size && offset < constant.offset + constant.size) {
+          stack_constants.erase(stack_constants.begin() + j);
+        }
+        else {
+          j++;
+        }
+      }
+
       return offset;
     }
   }
@@ -269,21 +280,19 @@ int SVMCompiler::stack_assign(ShaderInput *input)
       Node *node = input->parent;
 
       /* not linked to output -> add nodes to load default value */
-      input->stack_offset = stack_find_offset(input->type());
-
       if (input->type() == SocketType::FLOAT) {
-        add_node(NODE_VALUE_F,
-                 __float_as_int(node->get_float(input->socket_type)),
-                 input->stack_offset);
+        const float f = node->get_float(input->socket_type);
+        input->stack_offset = stack_assign_constant(1, make_int4(__float_as_int(f), 0, 0, 0));
       }
       else if (input->type() == SocketType::INT) {
-        add_node(NODE_VALUE_F, node->get_int(input->socket_type), input->stack_offset);
+        const int i = node->get_int(input->socket_type);
+        input->stack_offset = stack_assign_constant(1, make_int4(i, 0, 0, 0));
       }
       else if (input->type() == SocketType::VECTOR || input->type() == SocketType::NORMAL ||
                input->type() == SocketType::POINT || input->type() == SocketType::COLOR) {
-
-        add_node(NODE_VALUE_V, input->stack_offset);
-        add_node(NODE_VALUE_V, node->get_float3(input->socket_type));
+        const float3 f = node->get_float3(input->socket_type);
+        input->stack_offset = stack_assign_constant(
+            3, make_int4(__float_as_int(f.x), __float_as_int(f.y), __float_as_int(f.z), 0));
       }
       else /* should not get called for closure */
         assert(0);
@@ -293,6 +302,35 @@ int SVMCompiler::stack_assign(ShaderInput *input)
   return input->stack_offset;
 }
 
+int SVMCompiler::stack_assign_constant(int size, const int4 &value)
+{
+  /* Share the stack offset of an identical constant that is still loaded. */
+  foreach (const StackConstant &constant, stack_constants) {
+    if (constant.size == size && constant.value.x == value.x && constant.value.y == value.y &&
+        constant.value.z == value.z) {
+      for (int i = 0; i < size; i++) {
+        active_stack.users[constant.offset + i]++;
+      }
+      return constant.offset;
+    }
+  }
+
+  const int offset = stack_find_offset(size);
+
+  if (size == 1) {
+    add_node(NODE_VALUE_F, value.x, offset);
+  }
+  else {
+    add_node(NODE_VALUE_V, offset);
+    add_node(NODE_VALUE_V, value.x, value.y, value.z);
+  }
+
+  StackConstant constant = {size, value, offset};
+  stack_constants.push_back(constant);
+
+  return offset;
+}
+
 int SVMCompiler::stack_assign(ShaderOutput *output)
 {
   /* if no stack offset assigned yet, find one */
@@ -672,9 +710,16 @@ void SVMCompiler::generate_multi_closure(ShaderNode *root_node,
 
         generate_multi_closure(root_node, cl1in->link->parent, state);
 
-        /* Fill in jump instruction location to be after closure. */
-        current_svm_nodes[node_jump_skip_index].y = current_svm_nodes.size() -
-                                                    node_jump_skip_index - 1;
+        /* Fill in jump instruction location to be after closure, or remove it if there is
+         * nothing to skip. */
+        const int num_skip_nodes = current_svm_nodes.size() - node_jump_skip_index - 1;
+        if (num_skip_nodes == 0) {
+          current_svm_nodes.resize(node_jump_skip_index);
+        }
+        else {
+          current_svm_nodes[node_jump_skip_index].y = num_skip_nodes;
+          stack_constants.clear();
+        }
       }
 
       /* generate instructions for input closure 2 */
@@ -687,9 +732,16 @@ void SVMCompiler::generate_multi_closure(ShaderNode *root_node,
 
         generate_multi_closure(root_node, cl2in->link->parent, state);
 
-        /* Fill in jump instruction location to be after closure. */
-        current_svm_nodes[node_jump_skip_index].y = current_svm_nodes.size() -
-                                                    node_jump_skip_index - 1;
+        /* Fill in jump instruction location to be after closure, or remove it if there is
+         * nothing to skip. */
+        const int num_skip_nodes = current_svm_nodes.size() - node_jump_skip_index - 1;
+        if (num_skip_nodes == 0) {
+          current_svm_nodes.resize(node_jump_skip_index);
+        }
+        else {
+          current_svm_nodes[node_jump_skip_index].y = num_skip_nodes;
+          stack_constants.clear();
+        }
       }
 
       /* unassign */
@@ -758,6 +810,7 @@ void SVMCompiler::compile_type(Shader *shader, ShaderGraph *graph, ShaderType ty
 
   /* clear all compiler state */
   memset((void *)&active_stack, 0, sizeof(active_stack));
+  stack_constants.clear();
   current_svm_nodes.clear();
 
   foreach (ShaderNode *node, graph->nodes) {
@@ -191,8 +191,16 @@ class SVMCompiler {
     vector<bool> nodes_done_flag;
   };
 
+  /* Constant value loaded onto the stack for unlinked inputs. */
+  struct StackConstant {
+    int size;
+    int4 value;
+    int offset;
+  };
+
   void stack_clear_temporary(ShaderNode *node);
   int stack_size(SocketType::Type type);
+  int stack_assign_constant(int size, const int4 &value);
   void stack_clear_users(ShaderNode *node, ShaderNodeSet &done);
 
   /* single closure */
@@ -222,6 +230,9 @@ class SVMCompiler {
   ShaderType current_type;
   Shader *current_shader;
   Stack active_stack;
+  /* Constants loaded by the straight-line code generated so far, which can be shared by inputs
+   * with the same value. Cleared after branches, since those may be skipped at runtime. */
+  vector<StackConstant> stack_constants;
   int max_stack_use;
   uint mix_weight_offset;
   bool compile_failed;
@@ -97,6 +97,7 @@ TileManager::TileManager(bool progressive_,
                          int pixel_size_)
 {
   progressive = progressive_;
+  requested_tile_size = tile_size_;
   tile_size = tile_size_;
   tile_order = tile_order_;
   start_resolution = start_resolution_;
@@ -107,6 +108,7 @@ TileManager::TileManager(bool progressive_,
   preserve_tile_device = preserve_tile_device_;
   background = background_;
   schedule_denoising = false;
+  device_throughput.resize(num_devices, 0.0);
 
   range_start_sample = 0;
   range_num_samples = -1;
@@ -148,6 +150,7 @@ static int get_divider(int w, int h, int start_resolution)
 void TileManager::reset(BufferParams &params_, int num_samples_)
 {
   params = params_;
+  tile_size = get_device_tile_size(params.width, params.height);
 
   set_samples(num_samples_);
 
@@ -192,6 +195,76 @@ void TileManager::set_samples(int num_samples_)
   }
 }
 
+int2 TileManager::get_device_tile_size(int image_w, int image_h)
+{
+  /* Viewport slices and a single device are not affected by idle devices at the end. */
+  if (!background || num_devices <= 1 || image_w <= 0 || image_h <= 0) {
+    return requested_tile_size;
+  }
+
+  const int min_tile_size = 32;
+  const int min_num_tiles = 2 * num_devices;
+
+  int2 size = make_int2(min(requested_tile_size.x, image_w), min(requested_tile_size.y, image_h));
+  while (divide_up(image_w, size.x) * divide_up(image_h, size.y) < min_num_tiles) {
+    if (size.x >= size.y && size.x / 2 >= min_tile_size) {
+      size.x /= 2;
+    }
+    else if (size.y / 2 >= min_tile_size) {
+      size.y /= 2;
+    }
+    else if (size.x / 2 >= min_tile_size) {
+      size.x /= 2;
+    }
+    else {
+      break;
+    }
+  }
+
+  return size;
+}
+
+void TileManager::update_device_throughput(int device, uint64_t pixel_samples, double time)
+{
+  if (device < 0 || device >= (int)device_throughput.size() || pixel_samples == 0 || time <= 0.0) {
+    return;
+  }
+
+  const double throughput = pixel_samples / time;
+  double &average = device_throughput[device];
+  average = (average == 0.0) ? throughput : 0.5 * (average + throughput);
+}
+
+vector<int> TileManager::get_slice_bounds(int image_h, int slice_num)
+{
+  vector<int> bounds(slice_num + 1);
+
+  double total_throughput = 0.0;
+  bool use_throughput = (slice_num > 1 && slice_num == (int)device_throughput.size());
+  for (int i = 0; use_throughput && i < slice_num; i++) {
+    use_throughput = (device_throughput[i] > 0.0);
+    total_throughput += device_throughput[i];
+  }
+
+  double throughput = 0.0;
+  bounds[0] = 0;
+  for (int slice = 1; slice < slice_num; slice++) {
+    int y;
+    if (use_throughput) {
+      throughput += device_throughput[slice - 1];
+      y = (int)(image_h * (throughput / total_throughput) + 0.5);
+    }
+    else {
+      y = (image_h / slice_num) * slice;
+    }
+    /* Every slice needs at least one row. */
+    bounds[slice] = clamp(y, bounds[slice - 1] + 1, image_h - (slice_num - slice));
+  }
+  bounds[slice_num] = image_h;
+
+  return bounds;
+}
+
 /* If sliced is false, splits image into tiles and assigns equal amount of tiles to every render
  * device. If sliced is true, slice image into as much pieces as how many devices are rendering
  * this image. */
@@ -313,11 +386,13 @@ int TileManager::gen_tiles(bool sliced)
     return tile_w * tile_h;
   }
 
+  /* Slice heights follow the measured device throughput, so faster devices get more rows. */
+  const vector<int> slice_bounds = get_slice_bounds(image_h, slice_num);
+
   int idx = 0;
   for (int slice = 0; slice < slice_num; slice++) {
-    int slice_y = (image_h / slice_num) * slice;
-    int slice_h = (slice == slice_num - 1) ? image_h - slice * (image_h / slice_num) :
-                                             image_h / slice_num;
+    int slice_y = slice_bounds[slice];
+    int slice_h = slice_bounds[slice + 1] - slice_bounds[slice];
 
     if (slice_overlap != 0) {
       int slice_y_offset = max(slice_y - slice_overlap, 0);
@@ -39,13 +39,23 @@ class Tile {
   typedef enum { RENDER = 0, RENDERED, DENOISE, DENOISED, DONE } State;
   State state;
   RenderBuffers *buffers;
+  /* Time at which the device acquired the tile for path tracing. */
+  double start_time;
 
   Tile()
   {
   }
 
   Tile(int index_, int x_, int y_, int w_, int h_, int device_, State state_ = RENDER)
-      : index(index_), x(x_), y(y_), w(w_), h(h_), device(device_), state(state_), buffers(NULL)
+      : index(index_),
+        x(x_),
+        y(y_),
+        w(w_),
+        h(h_),
+        device(device_),
+        state(state_),
+        buffers(NULL),
+        start_time(0.0)
   {
   }
 };
@@ -116,9 +126,19 @@ class TileManager {
     tile_order = tile_order_;
   }
 
+  /* Tile size used for the current reset, which may be smaller than the requested one. */
+  int2 get_tile_size() const
+  {
+    return tile_size;
+  }
+
   int get_neighbor_index(int index, int neighbor);
   bool check_neighbor_state(int index, Tile::State state);
 
+  /* Record that a logical device rendered the given number of pixel samples in the given
+   * time, to balance the viewport slices of the next reset. */
+  void update_device_throughput(int device, uint64_t pixel_samples, double time);
+
   /* ** Sample range rendering. ** */
 
   /* Start sample in the range. */
@@ -137,6 +157,7 @@ class TileManager {
   void set_tiles();
 
   bool progressive;
+  int2 requested_tile_size;
   int2 tile_size;
   TileOrder tile_order;
   int start_resolution;
@@ -162,6 +183,17 @@ class TileManager {
    */
   bool background;
 
+  /* Rolling average of the pixel samples per second rendered by each logical device, zero
+   * until the device finished its first tile. */
+  vector<double> device_throughput;
+
+  /* Shrink the requested tile size for final renders on multiple devices, so there are enough
+   * tiles to keep every device busy until the end of the frame. */
+  int2 get_device_tile_size(int image_w, int image_h);
+
+  /* Split the image rows into slices sized by the device throughput. */
+  vector<int> get_slice_bounds(int image_h, int slice_num);
+
   /* Generate tile list, return number of tiles. */
   int gen_tiles(bool sliced);
   void gen_render_tiles();
@@ -112,6 +112,19 @@ void aligned_free(void *ptr);
 extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
+#ifdef WITH_MEM_THREAD_CACHE
+/* Largest block (including its header) that is served from the thread cache. */
+#  define MEM_THREAD_CACHE_MAX_SIZE 1024
+
+/* Thread cache for small blocks, the returned memory is aligned like `malloc`.
+ * Returns NULL when no memory could be allocated, then the system allocator should be used. */
+void *mem_thread_cache_alloc(size_t size) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+/* Give a block back to the cache, size has to be the same as when it was allocated. */
+void mem_thread_cache_free(void *ptr, size_t size);
+/* Memory that is reserved by the cache, including blocks that are in use. */
+size_t mem_thread_cache_get_reserved_memory(void);
+#endif
+
 /* Prototypes for counted allocator functions */
 size_t MEM_lockfree_allocN_len(const void *vmemh) ATTR_WARN_UNUSED_RESULT;
 void MEM_lockfree_freeN(void *vmemh);
@@ -51,12 +51,16 @@ static void (*error_callback)(const char *) = NULL;
 
 enum {
   MEMHEAD_ALIGN_FLAG = 1,
+  /* The block is owned by the thread cache. */
+  MEMHEAD_CACHED_FLAG = 2,
 };
 
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
+#define MEMHEAD_IS_CACHED(memhead) ((memhead)->len & (size_t)MEMHEAD_CACHED_FLAG)
+#define MEMHEAD_FLAG_MASK ((size_t)(MEMHEAD_ALIGN_FLAG | MEMHEAD_CACHED_FLAG))
 
 /* Uncomment this to have proper peak counter. */
 #define USE_ATOMIC_MAX
@@ -92,7 +96,7 @@ print_error(const char *str, ...)
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
-    return MEMHEAD_FROM_PTR(vmemh)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG));
+    return MEMHEAD_FROM_PTR(vmemh)->len & ~MEMHEAD_FLAG_MASK;
   }
 
   return 0;
@@ -125,6 +129,11 @@ void MEM_lockfree_freeN(void *vmemh)
     MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
     aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
   }
+#ifdef WITH_MEM_THREAD_CACHE
+  else if (MEMHEAD_IS_CACHED(memh)) {
+    mem_thread_cache_free(memh, len + sizeof(MemHead));
+  }
+#endif
   else {
     free(memh);
   }
@@ -226,16 +235,42 @@ void *MEM_lockfree_recallocN_id(void *vmemh, size_t len, const char *str)
   return newp;
 }
 
+#ifdef WITH_MEM_THREAD_CACHE
+/* Get a small block from the thread cache, the length stored in the head includes the flag. */
+MEM_INLINE MemHead *memhead_from_thread_cache(size_t len)
+{
+  if (len + sizeof(MemHead) <= MEM_THREAD_CACHE_MAX_SIZE) {
+    MemHead *memh = (MemHead *)mem_thread_cache_alloc(len + sizeof(MemHead));
+    if (LIKELY(memh)) {
+      memh->len = len | (size_t)MEMHEAD_CACHED_FLAG;
+      return memh;
+    }
+  }
+  return NULL;
+}
+#endif
+
 void *MEM_lockfree_callocN(size_t len, const char *str)
 {
   MemHead *memh;
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+#ifdef WITH_MEM_THREAD_CACHE
+  memh = memhead_from_thread_cache(len);
+  if (memh) {
+    memset(memh + 1, 0, len);
+  }
+  else
+#endif
+  {
+    memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+    if (LIKELY(memh)) {
+      memh->len = len;
+    }
+  }
 
   if (LIKELY(memh)) {
-    memh->len = len;
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
@@ -273,14 +308,22 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+#ifdef WITH_MEM_THREAD_CACHE
+  memh = memhead_from_thread_cache(len);
+  if (memh == NULL)
+#endif
+  {
+    memh = (MemHead *)malloc(len + sizeof(MemHead));
+    if (LIKELY(memh)) {
+      memh->len = len;
+    }
+  }
 
   if (LIKELY(memh)) {
     if (UNLIKELY(malloc_debug_memset && len)) {
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
@@ -383,6 +426,10 @@ void MEM_lockfree_printmemlist_stats(void)
 {
   printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
   printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+#ifdef WITH_MEM_THREAD_CACHE
+  printf("thread cache reserved: %.3f MB\n",
+         (double)mem_thread_cache_get_reserved_memory() / (double)(1024 * 1024));
+#endif
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -0,0 +1,285 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup MEM
+ *
+ * Size-class based cache for small allocations of the lock-free allocator.
+ *
+ * Every thread keeps a free-list per size class, so that most small allocations and frees don't
+ * have to go to the system allocator and don't have to synchronize with other threads. When a
+ * thread runs out of blocks of a size class, it takes blocks from a shared list protected by a
+ * mutex, or carves new blocks from a larger slab. When a thread has too many free blocks, half of
+ * them are moved to the shared list, so that other threads can reuse them.
+ *
+ * Slabs are never returned to the system. This only caches the memory itself: the accounting of
+ * memory in use is done by the caller.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/types.h>
+
+#include "MEM_guardedalloc.h"
+
+/* to ensure strict conversions */
+#include "../../source/blender/blenlib/BLI_strict_flags.h"
+
+#include "atomic_ops.h"
+#include "mallocn_intern.h"
+
+#ifdef _MSC_VER
+#  define MEM_THREAD_LOCAL __declspec(thread)
+#else
+#  define MEM_THREAD_LOCAL __thread
+#endif
+
+/* Sizes are grouped in classes of 16 bytes up to 128 bytes, above that every power of two range
+ * is split into four classes. */
+#define SIZE_CLASS_NUM 20
+#define SIZE_CLASS_LINEAR_NUM 8
+#define SIZE_CLASS_LINEAR_MAX 128
+
+/* Size of the slabs that new blocks are carved from, also limits the memory of free blocks a
+ * single thread keeps per size class. */
+#define SLAB_SIZE (64 * 1024)
+
+typedef struct MemFreeBlock {
+  struct MemFreeBlock *next;
+} MemFreeBlock;
+
+typedef struct MemCacheBin {
+  MemFreeBlock *first;
+  unsigned int len;
+} MemCacheBin;
+
+typedef struct MemThreadCache {
+  MemCacheBin bins[SIZE_CLASS_NUM];
+} MemThreadCache;
+
+typedef struct MemSharedBin {
+  pthread_mutex_t mutex;
+  MemFreeBlock *first;
+  unsigned int len;
+} MemSharedBin;
+
+static MemSharedBin shared_bins[SIZE_CLASS_NUM];
+static size_t class_size_table[SIZE_CLASS_NUM];
+static unsigned char class_from_size_table[(MEM_THREAD_CACHE_MAX_SIZE >> 4) + 1];
+static size_t slab_mem_in_use = 0;
+
+static pthread_once_t init_once = PTHREAD_ONCE_INIT;
+static pthread_key_t thread_cache_key;
+static MEM_THREAD_LOCAL MemThreadCache *thread_cache = NULL;
+
+static size_t class_size_compute(const unsigned int size_class)
+{
+  if (size_class < SIZE_CLASS_LINEAR_NUM) {
+    return (size_t)(size_class + 1) * 16;
+  }
+  const unsigned int group = (size_class - SIZE_CLASS_LINEAR_NUM) / 4;
+  const unsigned int step = (size_class - SIZE_CLASS_LINEAR_NUM) % 4;
+  const size_t group_start = (size_t)SIZE_CLASS_LINEAR_MAX << group;
+  return group_start + (step + 1) * (group_start / 4);
+}
+
+static unsigned int bin_len_max(const unsigned int size_class)
+{
+  return (unsigned int)(SLAB_SIZE / class_size_table[size_class]);
+}
+
+static void bin_push_list(MemFreeBlock **first,
+                          unsigned int *len,
+                          MemFreeBlock *list_first,
+                          MemFreeBlock *list_last,
+                          const unsigned int list_len)
+{
+  list_last->next = *first;
+  *first = list_first;
+  *len += list_len;
+}
+
+static void shared_bin_push_list(const unsigned int size_class,
+                                 MemFreeBlock *list_first,
+                                 MemFreeBlock *list_last,
+                                 const unsigned int list_len)
+{
+  MemSharedBin *shared_bin = &shared_bins[size_class];
+  pthread_mutex_lock(&shared_bin->mutex);
+  bin_push_list(&shared_bin->first, &shared_bin->len, list_first, list_last, list_len);
+  pthread_mutex_unlock(&shared_bin->mutex);
+}
+
+static void thread_cache_free(void *value)
+{
+  MemThreadCache *cache = (MemThreadCache *)value;
+  for (unsigned int size_class = 0; size_class < SIZE_CLASS_NUM; size_class++) {
+    MemCacheBin *bin = &cache->bins[size_class];
+    if (bin->first == NULL) {
+      continue;
+    }
+    MemFreeBlock *last = bin->first;
+    while (last->next != NULL) {
+      last = last->next;
+    }
+    shared_bin_push_list(size_class, bin->first, last, bin->len);
+  }
+  /* Allocations from other thread-specific destructors will create a new cache. */
+  thread_cache = NULL;
+  free(cache);
+}
+
+static void thread_cache_init(void)
+{
+  for (unsigned int size_class = 0; size_class < SIZE_CLASS_NUM; size_class++) {
+    class_size_table[size_class] = class_size_compute(size_class);
+    pthread_mutex_init(&shared_bins[size_class].mutex, NULL);
+  }
+  unsigned int size_class = 0;
+  for (unsigned int i = 0; i < sizeof(class_from_size_table); i++) {
+    while (class_size_table[size_class] < ((size_t)i << 4)) {
+      size_class++;
+    }
+    class_from_size_table[i] = (unsigned char)size_class;
+  }
+  pthread_key_create(&thread_cache_key, thread_cache_free);
+}
+
+static MemThreadCache *thread_cache_ensure(void)
+{
+  MemThreadCache *cache = thread_cache;
+  if (LIKELY(cache)) {
+    return cache;
+  }
+  pthread_once(&init_once, thread_cache_init);
+  cache = (MemThreadCache *)calloc(1, sizeof(MemThreadCache));
+  if (UNLIKELY(cache == NULL)) {
+    return NULL;
+  }
+  pthread_setspecific(thread_cache_key, cache);
+  thread_cache = cache;
+  return cache;
+}
+
+MEM_INLINE unsigned int class_from_size(const size_t size)
+{
+  return class_from_size_table[(size + 15) >> 4];
+}
+
+/* Fill an empty bin with blocks from the shared bin or from a new slab. */
+static bool bin_refill(MemCacheBin *bin, const unsigned int size_class)
+{
+  MemSharedBin *shared_bin = &shared_bins[size_class];
+  const unsigned int refill_len = bin_len_max(size_class) / 2;
+
+  pthread_mutex_lock(&shared_bin->mutex);
+  if (shared_bin->first != NULL) {
+    MemFreeBlock *last = shared_bin->first;
+    unsigned int len = 1;
+    while (len < refill_len && last->next != NULL) {
+      last = last->next;
+      len++;
+    }
+    bin->first = shared_bin->first;
+    bin->len = len;
+    shared_bin->first = last->next;
+    shared_bin->len -= len;
+    last->next = NULL;
+    pthread_mutex_unlock(&shared_bin->mutex);
+    return true;
+  }
+  pthread_mutex_unlock(&shared_bin->mutex);
+
+  const size_t block_size = class_size_table[size_class];
+  char *slab = (char *)malloc(SLAB_SIZE);
+  if (UNLIKELY(slab == NULL)) {
+    return false;
+  }
+  atomic_add_and_fetch_z(&slab_mem_in_use, SLAB_SIZE);
+
+  const unsigned int slab_len = (unsigned int)(SLAB_SIZE / block_size);
+  for (unsigned int i = 0; i < slab_len; i++) {
+    MemFreeBlock *block = (MemFreeBlock *)(slab + (size_t)i * block_size);
+    block->next = (i + 1 < slab_len) ? (MemFreeBlock *)(slab + (size_t)(i + 1) * block_size) :
+                                       NULL;
+  }
+  bin->first = (MemFreeBlock *)slab;
+  bin->len = slab_len;
+  return true;
+}
+
+void *mem_thread_cache_alloc(size_t size)
+{
+  assert(size <= MEM_THREAD_CACHE_MAX_SIZE);
+
+  MemThreadCache *cache = thread_cache_ensure();
+  if (UNLIKELY(cache == NULL)) {
+    return NULL;
+  }
+  const unsigned int size_class = class_from_size(size);
+  MemCacheBin *bin = &cache->bins[size_class];
+  if (UNLIKELY(bin->first == NULL)) {
+    if (!bin_refill(bin, size_class)) {
+      return NULL;
+    }
+  }
+  MemFreeBlock *block = bin->first;
+  bin->first = block->next;
+  bin->len--;
+  return block;
+}
+
+void mem_thread_cache_free(void *ptr, size_t size)
+{
+  assert(size <= MEM_THREAD_CACHE_MAX_SIZE);
+
+  const unsigned int size_class = class_from_size(size);
+  MemFreeBlock *block = (MemFreeBlock *)ptr;
+  MemThreadCache *cache = thread_cache_ensure();
+  if (UNLIKELY(cache == NULL)) {
+    block->next = NULL;
+    shared_bin_push_list(size_class, block, block, 1);
+    return;
+  }
+
+  MemCacheBin *bin = &cache->bins[size_class];
+  block->next = bin->first;
+  bin->first = block;
+  bin->len++;
+
+  /* Give half of the blocks to other threads. */
+  const unsigned int len_max = bin_len_max(size_class);
+  if (UNLIKELY(bin->len > len_max)) {
+    const unsigned int keep_len = len_max / 2;
+    MemFreeBlock *last_kept = bin->first;
+    for (unsigned int i = 1; i < keep_len; i++) {
+      last_kept = last_kept->next;
+    }
+    MemFreeBlock *list_first = last_kept->next;
+    MemFreeBlock *list_last = list_first;
+    while (list_last->next != NULL) {
+      list_last = list_last->next;
+    }
+    last_kept->next = NULL;
+    shared_bin_push_list(size_class, list_first, list_last, bin->len - keep_len);
+    bin->len = keep_len;
+  }
+}
+
+size_t mem_thread_cache_get_reserved_memory(void)
+{
+  return slab_mem_in_use;
+}
@@ -0,0 +1,96 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+#include <vector>
+
+#include "BLI_utildefines.h"
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+/* These tests pass with and without WITH_MEM_THREAD_CACHE, they check that the thread cache does
+ * not change the behavior of the allocator. */
+
+TEST_F(LockFreeAllocatorTest, small_allocation_len)
+{
+  const size_t mem_in_use = MEM_get_memory_in_use();
+  for (size_t len = 0; len < 2048; len += 4) {
+    void *ptr = MEM_mallocN(len, __func__);
+    EXPECT_EQ(MEM_allocN_len(ptr), len);
+    EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use + len);
+    MEM_freeN(ptr);
+    EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+  }
+}
+
+TEST_F(LockFreeAllocatorTest, small_callocN_is_zeroed)
+{
+  /* Make sure that the second allocation reuses memory that was not zero. */
+  for (int i = 0; i < 2; i++) {
+    char *ptr = (char *)MEM_callocN(100, __func__);
+    for (int j = 0; j < 100; j++) {
+      EXPECT_EQ(ptr[j], 0);
+    }
+    memset(ptr, 255, 100);
+    MEM_freeN(ptr);
+  }
+}
+
+TEST_F(LockFreeAllocatorTest, small_reallocN)
+{
+  int *ptr = (int *)MEM_mallocN(sizeof(int) * 4, __func__);
+  for (int i = 0; i < 4; i++) {
+    ptr[i] = i;
+  }
+  ptr = (int *)MEM_reallocN(ptr, sizeof(int) * 1000);
+  EXPECT_EQ(MEM_allocN_len(ptr), sizeof(int) * 1000);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(ptr[i], i);
+  }
+  ptr = (int *)MEM_reallocN(ptr, sizeof(int) * 2);
+  EXPECT_EQ(ptr[0], 0);
+  EXPECT_EQ(ptr[1], 1);
+  MEM_freeN(ptr);
+}
+
+TEST_F(LockFreeAllocatorTest, small_allocations_multithreaded)
+{
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+  const size_t mem_in_use = MEM_get_memory_in_use();
+
+  /* Blocks are allocated in one thread and freed in another one. */
+  std::vector<std::vector<void *>> blocks(8);
+  std::vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < 8; thread_index++) {
+    threads.emplace_back([&blocks, thread_index]() {
+      for (int i = 0; i < 10000; i++) {
+        const size_t len = (size_t)((i * 7 + thread_index) % 1000);
+        int *ptr = (int *)MEM_mallocN(len + sizeof(int), __func__);
+        *ptr = i;
+        blocks[thread_index].push_back(ptr);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  for (int thread_index = 0; thread_index < 8; thread_index++) {
+    threads.emplace_back([&blocks, thread_index]() {
+      std::vector<void *> &thread_blocks = blocks[(thread_index + 1) % 8];
+      for (int i = 0; i < 10000; i++) {
+        EXPECT_EQ(*(int *)thread_blocks[i], i);
+        MEM_freeN(thread_blocks[i]);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+}
@@ -21,12 +21,17 @@
  * \ingroup mantaflow
  */
 
+#include <fcntl.h>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <zlib.h>
 
+#ifndef WIN32
+#  include <unistd.h>
+#endif
+
 #include "MANTA_main.h"
 #include "Python.h"
 #include "fluid_script.h"
@@ -1096,6 +1101,21 @@ string MANTA::parseScript(const string &setup_string, FluidModifierData *fmd)
   return res.str();
 }
 
+/* Ask the OS to start reading a cache file in the background. Used for the frame after the one
+ * being loaded, so that playback from slow (network) storage does not wait for every read. */
+static void prefetchFile(string const &file)
+{
+#ifdef POSIX_FADV_WILLNEED
+  int fd = BLI_open(file.c_str(), O_RDONLY, 0);
+  if (fd != -1) {
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+  }
+#else
+  UNUSED_VARS(file);
+#endif
+}
+
 /* Dirty hack: Needed to format paths from python code that is run via PyRun_SimpleString */
 static string escapePath(string const &s)
 {
@@ -1269,6 +1289,8 @@ bool MANTA::readData(FluidModifierData *fmd, int framenr, bool resumable)
   if (!hasData(fmd, framenr))
     return false;
 
+  prefetchFile(getFile(fmd, FLUID_DOMAIN_DIR_DATA, FLUID_NAME_DATA, volume_format, framenr + 1));
+
   if (mUsingSmoke) {
     ss.str("");
     ss << "smoke_load_data_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
@@ -1312,6 +1334,8 @@ bool MANTA::readNoise(FluidModifierData *fmd, int framenr, bool resumable)
   if (!hasNoise(fmd, framenr))
     return false;
 
+  prefetchFile(getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_NOISE, volume_format, framenr + 1));
+
   ss.str("");
   ss << "smoke_load_noise_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
      << ", '" << volume_format << "', " << resumable_cache << ")";
@@ -67,12 +67,20 @@
 #include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
 #include "BulletCollision/Gimpact/btGImpactShape.h"
 
+#if BT_THREADSAFE
+#  include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#  include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#  include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+#endif
+
 struct rbDynamicsWorld {
   btDiscreteDynamicsWorld *dynamicsWorld;
   btDefaultCollisionConfiguration *collisionConfiguration;
   btDispatcher *dispatcher;
   btBroadphaseInterface *pairCache;
   btConstraintSolver *constraintSolver;
+  /* Solver for islands too large to be split over the solver pool, may be NULL. */
+  btConstraintSolver *constraintSolverMt;
   btOverlapFilterCallback *filterCallback;
 };
 struct rbRigidBody {
@@ -136,14 +144,43 @@ static inline void copy_quat_btquat(float quat[4], const btQuaternion &btquat)
 
 /* Setup ---------------------------- */
 
+#if BT_THREADSAFE
+static btITaskScheduler *rb_task_scheduler_create()
+{
+  /* Threads of the default scheduler are started once and shared by all worlds, fall back to
+   * stepping on the calling thread when they cannot be created. */
+  btITaskScheduler *task_scheduler = btCreateDefaultTaskScheduler();
+  if (task_scheduler == NULL) {
+    task_scheduler = btGetSequentialTaskScheduler();
+  }
+  btSetTaskScheduler(task_scheduler);
+  return task_scheduler;
+}
+
+static btITaskScheduler *rb_task_scheduler_ensure()
+{
+  static btITaskScheduler *task_scheduler = rb_task_scheduler_create();
+  return task_scheduler;
+}
+#endif
+
 rbDynamicsWorld *RB_dworld_new(const float gravity[3])
 {
   rbDynamicsWorld *world = new rbDynamicsWorld;
 
+#if BT_THREADSAFE
+  /* Narrow phase collision pairs and simulation islands are handled in parallel. */
+  const int num_threads = rb_task_scheduler_ensure()->getNumThreads();
+#endif
+
   /* collision detection/handling */
   world->collisionConfiguration = new btDefaultCollisionConfiguration();
 
+#if BT_THREADSAFE
+  world->dispatcher = new btCollisionDispatcherMt(world->collisionConfiguration);
+#else
   world->dispatcher = new btCollisionDispatcher(world->collisionConfiguration);
+#endif
   btGImpactCollisionAlgorithm::registerAlgorithm((btCollisionDispatcher *)world->dispatcher);
 
   world->pairCache = new btDbvtBroadphase();
@@ -152,11 +189,25 @@ rbDynamicsWorld *RB_dworld_new(const float gravity[3])
   world->pairCache->getOverlappingPairCache()->setOverlapFilterCallback(world->filterCallback);
 
   /* constraint solving */
+#if BT_THREADSAFE
+  btConstraintSolverPoolMt *solver_pool = new btConstraintSolverPoolMt(num_threads);
+  world->constraintSolver = solver_pool;
+  world->constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+
+  /* world */
+  world->dynamicsWorld = new btDiscreteDynamicsWorldMt(world->dispatcher,
+                                                       world->pairCache,
+                                                       solver_pool,
+                                                       world->constraintSolverMt,
+                                                       world->collisionConfiguration);
+#else
   world->constraintSolver = new btSequentialImpulseConstraintSolver();
+  world->constraintSolverMt = NULL;
 
   /* world */
   world->dynamicsWorld = new btDiscreteDynamicsWorld(
       world->dispatcher, world->pairCache, world->constraintSolver, world->collisionConfiguration);
+#endif
 
   RB_dworld_set_gravity(world, gravity);
 
@@ -167,6 +218,7 @@ void RB_dworld_delete(rbDynamicsWorld *world)
 {
   /* bullet doesn't like if we free these in a different order */
   delete world->dynamicsWorld;
+  delete world->constraintSolverMt;
   delete world->constraintSolver;
   delete world->pairCache;
   delete world->dispatcher;
@@ -187,10 +187,18 @@ static GPUTexture *blf_batch_cache_texture_load(void)
     int offset_x = bitmap_len_landed % tex_width;
     int offset_y = bitmap_len_landed / tex_width;
 
-    /* TODO(germano): Update more than one row in a single call. */
     while (remain) {
       int remain_row = tex_width - offset_x;
-      int width = remain > remain_row ? remain_row : remain;
+      int width, height;
+      if (offset_x == 0 && remain >= tex_width) {
+        /* Whole rows are contiguous in the bitmap, update them in a single call. */
+        width = tex_width;
+        height = remain / tex_width;
+      }
+      else {
+        width = remain > remain_row ? remain_row : remain;
+        height = 1;
+      }
       GPU_texture_update_sub(gc->texture,
                              GPU_DATA_UNSIGNED_BYTE,
                              &gc->bitmap_result[bitmap_len_landed],
@@ -198,13 +206,13 @@ static GPUTexture *blf_batch_cache_texture_load(void)
                              offset_y,
                              0,
                              width,
-                             1,
+                             height,
                              0);
 
-      bitmap_len_landed += width;
-      remain -= width;
+      bitmap_len_landed += width * height;
+      remain -= width * height;
       offset_x = 0;
-      offset_y += 1;
+      offset_y += height;
     }
 
     gc->bitmap_len_landed = bitmap_len_landed;
@@ -373,6 +373,9 @@ void makeDerivedMesh(struct Depsgraph *depsgraph,
                      struct BMEditMesh *em,
                      const struct CustomData_MeshMasks *dataMask);
 
+/* Free the mesh kept after the last constructive modifier of the stack. */
+void BKE_object_modifier_stack_cache_free(struct Object *ob);
+
 void DM_calc_loop_tangents(DerivedMesh *dm,
                            bool calc_active_tangent,
                            const char (*tangent_names)[MAX_NAME],
@@ -106,11 +106,33 @@ class ReadAttribute {
     return this->get_span().typed<T>();
   }
 
+  /**
+   * Get a span that contains the attribute values in the given range. When the values are stored
+   * in an array already, that array is referenced. Otherwise they are constructed in \a r_buffer,
+   * which must have space for `range.size()` values. This allows processing large attributes in
+   * chunks, without creating a temporary array that contains all values.
+   */
+  fn::GSpan get_span_for_range(const IndexRange range, void *r_buffer) const;
+
+  template<typename T> Span<T> get_span_for_range(const IndexRange range, T *r_buffer) const
+  {
+    return this->get_span_for_range(range, static_cast<void *>(r_buffer)).typed<T>();
+  }
+
  protected:
   /* r_value is expected to be uninitialized. */
   virtual void get_internal(const int64_t index, void *r_value) const = 0;
 
+  /* r_values is expected to be uninitialized. */
+  virtual void get_range_internal(const IndexRange range, void *r_values) const;
+
   virtual void initialize_span() const;
+
+  /* Returns true when #initialize_span only references existing data and does not allocate. */
+  virtual bool span_is_referenced() const
+  {
+    return false;
+  }
 };
 
 /**
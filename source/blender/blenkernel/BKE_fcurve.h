@@ -305,6 +305,8 @@ bool BKE_fcurve_is_empty(struct FCurve *fcu);
 float calculate_fcurve(struct PathResolvedRNA *anim_rna,
                        struct FCurve *fcu,
                        const struct AnimationEvalContext *anim_eval_context);
+/* evaluate all fcurves of the list (e.g. of an action) and store values in an array */
+void calculate_fcurves(struct ListBase *fcurves, float evaltime, float *r_values);
 
 /* ************* F-Curve Samples API ******************** */
 
@@ -146,6 +146,12 @@ class GeometryComponent {
   void user_remove() const;
   bool is_mutable() const;
 
+  /* False when the component references data that is owned by someone else and might be freed
+   * while the component still exists. */
+  virtual bool owns_direct_data() const;
+  /* Copy referenced data that is not owned by the component. The component has to be mutable. */
+  virtual void ensure_owns_direct_data();
+
   GeometryComponentType type() const;
 
   /* Return true when any attribute with this name exists, including built in attributes. */
@@ -306,6 +312,9 @@ struct GeometrySet {
 
   void add(const GeometryComponent &component);
 
+  /* Make sure that the geometry set can outlive the data its components have been created with. */
+  void ensure_owns_direct_data();
+
   void compute_boundbox_without_instances(blender::float3 *r_min, blender::float3 *r_max) const;
 
   friend std::ostream &operator<<(std::ostream &stream, const GeometrySet &geometry_set);
@@ -341,6 +350,10 @@ class MeshComponent : public GeometryComponent {
  private:
   Mesh *mesh_ = nullptr;
   GeometryOwnershipType ownership_ = GeometryOwnershipType::Owned;
+  /* A copied component can reference the data layers of the mesh in the original component,
+   * instead of duplicating them. The original component is kept alive and stays immutable, because
+   * it is shared, until all referenced layers have been duplicated. */
+  blender::UserCounter<const GeometryComponent> referenced_component_;
   /* Due to historical design choices, vertex group data is stored in the mesh, but the vertex
    * group names are stored on an object. Since we don't have an object here, we copy over the
    * names into this map. */
@@ -361,6 +374,9 @@ class MeshComponent : public GeometryComponent {
   const Mesh *get_for_read() const;
   Mesh *get_for_write();
 
+  bool owns_direct_data() const override;
+  void ensure_owns_direct_data() override;
+
   bool attribute_domain_supported(const AttributeDomain domain) const final;
   bool attribute_domain_with_type_supported(const AttributeDomain domain,
                                             const CustomDataType data_type) const final;
@@ -381,6 +397,10 @@ class MeshComponent : public GeometryComponent {
   bool is_empty() const final;
 
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::Mesh;
+
+ private:
+  Mesh *get_for_write_keep_referenced_layers();
+  void duplicate_referenced_layers();
 };
 
 /** A geometry component that stores a point cloud. */
@@ -388,6 +408,8 @@ class PointCloudComponent : public GeometryComponent {
  private:
   PointCloud *pointcloud_ = nullptr;
   GeometryOwnershipType ownership_ = GeometryOwnershipType::Owned;
+  /* See #MeshComponent::referenced_component_. */
+  blender::UserCounter<const GeometryComponent> referenced_component_;
 
  public:
   PointCloudComponent();
@@ -403,6 +425,9 @@ class PointCloudComponent : public GeometryComponent {
   const PointCloud *get_for_read() const;
   PointCloud *get_for_write();
 
+  bool owns_direct_data() const override;
+  void ensure_owns_direct_data() override;
+
   bool attribute_domain_supported(const AttributeDomain domain) const final;
   bool attribute_domain_with_type_supported(const AttributeDomain domain,
                                             const CustomDataType data_type) const final;
@@ -423,6 +448,10 @@ class PointCloudComponent : public GeometryComponent {
   bool is_empty() const final;
 
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::PointCloud;
+
+ private:
+  PointCloud *get_for_write_keep_referenced_layers();
+  void duplicate_referenced_layers();
 };
 
 /** A geometry component that stores instances. */
@@ -438,6 +467,7 @@ class InstancesComponent : public GeometryComponent {
   GeometryComponent *copy() const override;
 
   void clear();
+  void reserve(const int min_capacity);
   void add_instance(Object *object, blender::float4x4 transform, const int id = -1);
   void add_instance(Collection *collection, blender::float4x4 transform, const int id = -1);
   void add_instance(InstancedData data, blender::float4x4 transform, const int id = -1);
@@ -472,5 +502,8 @@ class VolumeComponent : public GeometryComponent {
   const Volume *get_for_read() const;
   Volume *get_for_write();
 
+  bool owns_direct_data() const override;
+  void ensure_owns_direct_data() override;
+
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::Volume;
 };
@@ -156,6 +156,7 @@ enum {
   G_DEBUG_XR_TIME = (1 << 22),               /* XR/OpenXR timing messages */
 
   G_DEBUG_GHOST = (1 << 23), /* Debug GHOST module. */
+  G_DEBUG_STARTUP_TIMING = (1 << 24), /* Time spent in the phases of startup. */
 };
 
 #define G_DEBUG_ALL \
@@ -83,6 +83,11 @@ typedef enum {
   eGpencilModifierTypeFlag_NoUserAdd = (1 << 5),
   /** Can't be applied. */
   eGpencilModifierTypeFlag_NoApply = (1 << 6),
+  /**
+   * #GpencilModifierTypeInfo.deformStroke only changes the given stroke, so the strokes of a
+   * frame can be deformed in parallel.
+   */
+  eGpencilModifierTypeFlag_ThreadSafeDeform = (1 << 7),
 } GpencilModifierTypeFlag;
 
 typedef void (*GreasePencilIDWalkFunc)(void *userData,
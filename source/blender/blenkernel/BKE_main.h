@@ -96,6 +96,11 @@ typedef enum MainIDRelationsEntryTags {
   MAINIDRELATIONS_ENTRY_TAGS_PROCESSED = 1 << 1,
 } MainIDRelationsEntryTags;
 
+/**
+ * The relations are kept up to date by the remapping functions of `BKE_lib_remap.h`, which then
+ * only process the users of the remapped ID instead of the whole Main. Any other change to the
+ * Main database requires them to be freed or re-generated.
+ */
 typedef struct MainIDRelations {
   /* Mapping from an ID pointer to all of its parents (IDs using it) and children (IDs it uses).
    * Values are `MainIDRelationsEntry` pointers. */
@@ -473,6 +473,12 @@ typedef struct SculptSession {
   struct MeshElemMap *pmap;
   int *pmap_mem;
 
+  /* Vertices connected to each vertex through a face, built along with #pmap. The neighbors of
+   * vertex `i` are `vert_neighbors[vert_neighbors_offset[i]]` up to (not including)
+   * `vert_neighbors[vert_neighbors_offset[i + 1]]`. */
+  int *vert_neighbors_offset;
+  int *vert_neighbors;
+
   /* Mesh Face Sets */
   /* Total number of polys of the base mesh. */
   int totfaces;
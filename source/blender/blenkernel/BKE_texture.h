@@ -96,6 +96,13 @@ void BKE_texture_get_value(const struct Scene *scene,
 
 void BKE_texture_fetch_images_for_pool(struct Tex *texture, struct ImagePool *pool);
 
+void BKE_texture_get_values(const struct Scene *scene,
+                            struct Tex *texture,
+                            const float (*tex_co)[3],
+                            const int tex_co_len,
+                            struct TexResult *r_texres,
+                            bool use_color_management);
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,6 +47,28 @@ bool BKE_volume_grid_dense_floats(const struct Volume *volume,
                                   DenseFloatVolumeGrid *r_dense_grid);
 void BKE_volume_dense_float_grid_clear(DenseFloatVolumeGrid *dense_grid);
 
+/**
+ * Blocks of voxels of the dense grid, with the offset and size of the block in voxels.
+ * The voxels are only valid during the callback.
+ */
+typedef void (*BKE_volume_voxel_block_cb)(void *userdata,
+                                          const float *voxels,
+                                          const int offset[3],
+                                          const int size[3]);
+
+/**
+ * Same as #BKE_volume_grid_dense_floats, without allocating the voxels of the whole bounding box.
+ * Only the leaf nodes and tiles that differ from the background value are passed to \a cb,
+ * all other voxels have the value \a r_background. The voxels of \a r_dense_grid are not set,
+ * the other members and \a r_background are set before \a cb is called.
+ */
+bool BKE_volume_grid_dense_float_blocks(const struct Volume *volume,
+                                        struct VolumeGrid *volume_grid,
+                                        DenseFloatVolumeGrid *r_dense_grid,
+                                        float r_background[3],
+                                        BKE_volume_voxel_block_cb cb,
+                                        void *cb_userdata);
+
 /* Wireframe */
 
 typedef void (*BKE_volume_wireframe_cb)(
@@ -932,6 +932,199 @@ static Mesh *modifier_modify_mesh_and_geometry_set(ModifierData *md,
   return mesh_output;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Modifier Stack Cache
+ *
+ * When the last constructive modifier of the stack is only followed by deform modifiers, its
+ * result is kept in the object runtime. Later evaluations where neither the modifiers up to it
+ * nor their inputs changed (an animated displace strength for example) start from a copy of
+ * that mesh and only evaluate the deform modifiers again.
+ *
+ * Changes are detected conservatively: the settings of the preceding modifiers and the data
+ * masks they are evaluated with are compared, and the cache isn't used when the input mesh or
+ * any data-block used by these modifiers is tagged for an update.
+ * \{ */
+
+struct ModifierStackCache {
+  /** State of the stack the meshes were evaluated with, see #modifier_stack_cache_key_build. */
+  blender::Vector<char> key;
+  Mesh *mesh = nullptr;
+  Mesh *mesh_orco = nullptr;
+};
+
+static void modifier_stack_cache_meshes_free(ModifierStackCache *cache)
+{
+  if (cache->mesh) {
+    BKE_id_free(nullptr, cache->mesh);
+    cache->mesh = nullptr;
+  }
+  if (cache->mesh_orco) {
+    BKE_id_free(nullptr, cache->mesh_orco);
+    cache->mesh_orco = nullptr;
+  }
+}
+
+void BKE_object_modifier_stack_cache_free(Object *ob)
+{
+  ModifierStackCache *cache = ob->runtime.modifier_stack_cache;
+  if (cache == nullptr) {
+    return;
+  }
+  modifier_stack_cache_meshes_free(cache);
+  delete cache;
+  ob->runtime.modifier_stack_cache = nullptr;
+}
+
+/**
+ * The modifier the mesh is cached after: the last enabled constructive modifier, when at least
+ * one enabled deform modifier follows it. Null when there is nothing to gain from caching.
+ */
+static ModifierData *modifier_stack_cache_point_find(const Scene *scene,
+                                                     ModifierData *firstmd,
+                                                     const int required_mode)
+{
+  ModifierData *md_cache = nullptr;
+  bool has_deform_after = false;
+  for (ModifierData *md = firstmd; md; md = md->next) {
+    if (!BKE_modifier_is_enabled(scene, md, required_mode)) {
+      continue;
+    }
+    const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
+    if (mti->type == eModifierTypeType_OnlyDeform) {
+      has_deform_after = (md_cache != nullptr);
+    }
+    else {
+      md_cache = md;
+      has_deform_after = false;
+    }
+  }
+  return has_deform_after ? md_cache : nullptr;
+}
+
+static void modifier_stack_cache_key_append(blender::Vector<char> &key,
+                                            const void *data,
+                                            const size_t size)
+{
+  key.extend(blender::Span<char>((const char *)data, (int64_t)size));
+}
+
+static void modifier_stack_cache_id_tagged_cb(void *userData,
+                                              Object *UNUSED(ob),
+                                              ID **idpoin,
+                                              int UNUSED(cb_flag))
+{
+  if (*idpoin != nullptr && (*idpoin)->recalc != 0) {
+    *(bool *)userData = true;
+  }
+}
+
+/**
+ * Build the key of the state the modifiers up to (and including) \a md_cache are evaluated in.
+ *
+ * \param r_is_tagged: Set when the input mesh or data-blocks used by the modifiers are tagged
+ * for an update in this evaluation, the cached meshes can't be used then.
+ * \return False when the stack can't be cached at all, because one of the modifiers depends
+ * on time or has other side effects.
+ */
+static bool modifier_stack_cache_key_build(const Scene *scene,
+                                           Object *ob,
+                                           const Mesh *mesh_input,
+                                           ModifierData *md_cache,
+                                           const CDMaskLink *datamasks,
+                                           const int required_mode,
+                                           const bool need_mapping,
+                                           blender::Vector<char> &r_key,
+                                           bool *r_is_tagged)
+{
+  *r_is_tagged = (mesh_input->id.recalc != 0);
+
+  modifier_stack_cache_key_append(r_key, &required_mode, sizeof(required_mode));
+  modifier_stack_cache_key_append(r_key, &need_mapping, sizeof(need_mapping));
+  modifier_stack_cache_key_append(r_key, ob->obmat, sizeof(ob->obmat));
+  modifier_stack_cache_key_append(r_key, &scene->r.mode, sizeof(scene->r.mode));
+  modifier_stack_cache_key_append(
+      r_key, &scene->r.simplify_subsurf, sizeof(scene->r.simplify_subsurf));
+  modifier_stack_cache_key_append(
+      r_key, &scene->r.simplify_subsurf_render, sizeof(scene->r.simplify_subsurf_render));
+  LISTBASE_FOREACH (const bDeformGroup *, dg, &ob->defbase) {
+    modifier_stack_cache_key_append(r_key, dg->name, sizeof(dg->name));
+  }
+
+  const CDMaskLink *md_datamask = datamasks;
+  for (ModifierData *md = (ModifierData *)ob->modifiers.first; md;
+       md = md->next, md_datamask = md_datamask->next) {
+    const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
+
+    /* The mode and the settings of disabled modifiers are part of the key as well,
+     * enabling one changes the result. */
+    modifier_stack_cache_key_append(r_key, &md->type, sizeof(md->type));
+    modifier_stack_cache_key_append(r_key, &md->mode, sizeof(md->mode));
+    modifier_stack_cache_key_append(r_key, &md->session_uuid, sizeof(md->session_uuid));
+    modifier_stack_cache_key_append(r_key, &md_datamask->mask, sizeof(md_datamask->mask));
+
+    if (BKE_modifier_is_enabled(scene, md, required_mode)) {
+      if ((mti->flags & eModifierTypeFlag_UsesPointCache) ||
+          (mti->dependsOnTime && mti->dependsOnTime(md)) || mti->modifyGeometrySet ||
+          md->type == eModifierType_ParticleSystem) {
+        return false;
+      }
+    }
+    modifier_stack_cache_key_append(
+        r_key, (const char *)md + sizeof(ModifierData), mti->structSize - sizeof(ModifierData));
+
+    if (mti->foreachIDLink) {
+      mti->foreachIDLink(md, ob, modifier_stack_cache_id_tagged_cb, r_is_tagged);
+    }
+
+    if (md == md_cache) {
+      /* The masks of the following modifier define which layers the result keeps. */
+      const CDMaskLink *next_datamask = md_datamask->next;
+      if (next_datamask) {
+        modifier_stack_cache_key_append(r_key, &next_datamask->mask, sizeof(next_datamask->mask));
+      }
+      return true;
+    }
+  }
+
+  BLI_assert(!"Cache point is not in the modifier stack");
+  return false;
+}
+
+/** Keep copies of the result of the modifiers up to the cache point. */
+static void modifier_stack_cache_store(Object *ob,
+                                       ModifierData *md_cache,
+                                       blender::Vector<char> &key,
+                                       Mesh *mesh,
+                                       Mesh *mesh_orco)
+{
+  /* Errors are only reported while the modifiers are evaluated, don't hide them. */
+  for (ModifierData *md = (ModifierData *)ob->modifiers.first; md; md = md->next) {
+    if (md->error != nullptr) {
+      BKE_object_modifier_stack_cache_free(ob);
+      return;
+    }
+    if (md == md_cache) {
+      break;
+    }
+  }
+
+  ModifierStackCache *cache = ob->runtime.modifier_stack_cache;
+  if (cache == nullptr) {
+    cache = new ModifierStackCache();
+    ob->runtime.modifier_stack_cache = cache;
+  }
+  else {
+    modifier_stack_cache_meshes_free(cache);
+  }
+  cache->key = std::move(key);
+  cache->mesh = BKE_mesh_copy_for_eval(mesh, false);
+  if (mesh_orco) {
+    cache->mesh_orco = BKE_mesh_copy_for_eval(mesh_orco, false);
+  }
+}
+
+/** \} */
+
 static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
                                 Scene *scene,
                                 Object *ob,
@@ -1022,6 +1215,38 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* Clear errors before evaluation. */
   BKE_modifiers_clear_errors(ob);
 
+  /* Start from the mesh cached after the last constructive modifier when its inputs didn't
+   * change, see #ModifierStackCache. Only for the evaluation of the object itself. */
+  ModifierData *md_cache = nullptr;
+  blender::Vector<char> cache_key;
+  bool use_stack_cache = false;
+  if (use_cache) {
+    bool is_tagged = false;
+    if (index == -1 && useDeform == 1 && !sculpt_mode && firstmd == ob->modifiers.first) {
+      md_cache = modifier_stack_cache_point_find(scene, firstmd, required_mode);
+    }
+    if (md_cache && !modifier_stack_cache_key_build(scene,
+                                                    ob,
+                                                    mesh_input,
+                                                    md_cache,
+                                                    datamasks,
+                                                    required_mode,
+                                                    need_mapping,
+                                                    cache_key,
+                                                    &is_tagged)) {
+      md_cache = nullptr;
+    }
+
+    const ModifierStackCache *cache = ob->runtime.modifier_stack_cache;
+    if (md_cache == nullptr) {
+      BKE_object_modifier_stack_cache_free(ob);
+    }
+    else if (cache && !is_tagged && cache->key.size() == cache_key.size() &&
+             memcmp(cache->key.data(), cache_key.data(), (size_t)cache_key.size()) == 0) {
+      use_stack_cache = true;
+    }
+  }
+
   /* Apply all leading deform modifiers. */
   if (useDeform) {
     for (; md; md = md->next, md_datamask = md_datamask->next) {
@@ -1076,6 +1301,31 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
 
   /* Apply all remaining constructive and deforming modifiers. */
   bool have_non_onlydeform_modifiers_appled = false;
+
+  if (use_stack_cache) {
+    /* The leading deform modifiers above still run for the deform mesh, the rest of the stack
+     * up to the cached modifier is skipped. */
+    while (md != md_cache) {
+      md = md->next;
+      md_datamask = md_datamask->next;
+    }
+    md = md->next;
+    md_datamask = md_datamask->next;
+
+    if (mesh_final) {
+      BKE_id_free(nullptr, mesh_final);
+    }
+    MEM_SAFE_FREE(deformed_verts);
+
+    ModifierStackCache *cache = ob->runtime.modifier_stack_cache;
+    mesh_final = BKE_mesh_copy_for_eval(cache->mesh, true);
+    if (cache->mesh_orco) {
+      mesh_orco = BKE_mesh_copy_for_eval(cache->mesh_orco, true);
+    }
+    have_non_onlydeform_modifiers_appled = true;
+    isPrevDeform = false;
+  }
+
   for (; md; md = md->next, md_datamask = md_datamask->next) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
 
@@ -1335,6 +1585,15 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       }
 
       mesh_final->runtime.deformed_only = false;
+
+      if (md == md_cache) {
+        if (deformed_verts == nullptr && mesh_orco_cloth == nullptr) {
+          modifier_stack_cache_store(ob, md_cache, cache_key, mesh_final, mesh_orco);
+        }
+        else {
+          BKE_object_modifier_stack_cache_free(ob);
+        }
+      }
     }
 
     isPrevDeform = (mti->type == eModifierTypeType_OnlyDeform);
@@ -1601,6 +1860,9 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* Clear errors before evaluation. */
   BKE_modifiers_clear_errors(ob);
 
+  /* The cache of the object mode evaluation is invalid once the mesh is edited. */
+  BKE_object_modifier_stack_cache_free(ob);
+
   for (int i = 0; md; i++, md = md->next, md_datamask = md_datamask->next) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
 
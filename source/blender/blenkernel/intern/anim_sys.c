@@ -606,8 +606,17 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
-  /* Calculate then execute each curve. */
-  LISTBASE_FOREACH (FCurve *, fcu, list) {
+  const int fcurves_len = BLI_listbase_count(list);
+  if (fcurves_len == 0) {
+    return;
+  }
+
+  /* Calculate all curves first, then execute each curve. */
+  float *values = MEM_malloc_arrayN(fcurves_len, sizeof(*values), __func__);
+  calculate_fcurves(list, anim_eval_context->eval_time, values);
+
+  int i;
+  LISTBASE_FOREACH_INDEX (FCurve *, fcu, list, i) {
 
     if (!is_fcurve_evaluatable(fcu)) {
       continue;
@@ -615,13 +624,14 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
 
     PathResolvedRNA anim_rna;
     if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
-      const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
-      BKE_animsys_write_rna_setting(&anim_rna, curval);
+      BKE_animsys_write_rna_setting(&anim_rna, values[i]);
       if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, values[i]);
       }
     }
   }
+
+  MEM_freeN(values);
 }
 
 /* ***************************************** */
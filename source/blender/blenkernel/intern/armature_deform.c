@@ -204,26 +204,50 @@ static float dist_bone_deform(
   return contrib;
 }
 
-static void pchan_bone_deform(bPoseChannel *pchan,
-                              float weight,
-                              float vec[3],
-                              DualQuat *dq,
-                              float mat[3][3],
-                              const float co[3],
-                              float *contrib)
+/**
+ * Everything that is needed to deform a vertex by a bone through its vertex group. This is
+ * gathered once per deformation into an array indexed by vertex group, so that the loop over the
+ * weights of every vertex reads compact data instead of chasing pointers into pose channels.
+ */
+typedef struct ArmatureDeformBone {
+  /** NULL when the vertex group doesn't belong to a deforming bone. */
+  const bPoseChannel *pchan;
+  /** Deform by the B-Bone segments instead of the matrix of the whole bone. */
+  bool use_bbone;
+  /** Multiply vertex group weights with the envelope factor. */
+  bool use_envelope_multiply;
+  float deform_mat[4][4];
+  DualQuat deform_dq;
+} ArmatureDeformBone;
+
+static void armature_deform_bone_init(ArmatureDeformBone *deform_bone, const bPoseChannel *pchan)
 {
-  Bone *bone = pchan->bone;
+  const Bone *bone = pchan->bone;
+  deform_bone->pchan = pchan;
+  deform_bone->use_bbone = bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments;
+  deform_bone->use_envelope_multiply = (bone->flag & BONE_MULT_VG_ENV) != 0;
+  copy_m4_m4(deform_bone->deform_mat, pchan->chan_mat);
+  deform_bone->deform_dq = pchan->runtime.deform_dual_quat;
+}
 
+static void armature_deform_bone_accumulate(const ArmatureDeformBone *deform_bone,
+                                            float weight,
+                                            float vec[3],
+                                            DualQuat *dq,
+                                            float mat[3][3],
+                                            const float co[3],
+                                            float *contrib)
+{
   if (!weight) {
     return;
   }
 
-  if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
-    b_bone_deform(pchan, co, weight, vec, dq, mat);
+  if (deform_bone->use_bbone) {
+    b_bone_deform(deform_bone->pchan, co, weight, vec, dq, mat);
   }
   else {
     pchan_deform_accumulate(
-        &pchan->runtime.deform_dual_quat, pchan->chan_mat, co, weight, vec, dq, mat);
+        &deform_bone->deform_dq, deform_bone->deform_mat, co, weight, vec, dq, mat);
   }
 
   (*contrib) += weight;
@@ -255,7 +279,7 @@ typedef struct ArmatureUserdata {
   const MDeformVert *dverts;
   int dverts_len;
 
-  bPoseChannel **pchan_from_defbase;
+  const ArmatureDeformBone *bone_from_defbase;
   int defbase_len;
 
   float premat[4][4];
@@ -333,18 +357,19 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     unsigned int j;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const uint index = dw->def_nr;
-      if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
+      if (index < data->defbase_len && data->bone_from_defbase[index].pchan) {
+        const ArmatureDeformBone *deform_bone = &data->bone_from_defbase[index];
         float weight = dw->weight;
-        Bone *bone = pchan->bone;
 
         deformed = 1;
 
-        if (bone && bone->flag & BONE_MULT_VG_ENV) {
+        if (deform_bone->use_envelope_multiply) {
+          const Bone *bone = deform_bone->pchan->bone;
           weight *= distfactor_to_bone(
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
         }
 
-        pchan_bone_deform(pchan, weight, vec, dq, smat, co, &contrib);
+        armature_deform_bone_accumulate(deform_bone, weight, vec, dq, smat, co, &contrib);
       }
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
@@ -472,7 +497,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         bGPDstroke *gps_target)
 {
   bArmature *arm = ob_arm->data;
-  bPoseChannel **pchan_from_defbase = NULL;
+  ArmatureDeformBone *bone_from_defbase = NULL;
   const MDeformVert *dverts = NULL;
   bDeformGroup *dg;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -542,18 +567,16 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       }
 
       if (use_dverts) {
-        pchan_from_defbase = MEM_callocN(sizeof(*pchan_from_defbase) * defbase_len, "defnrToBone");
+        bone_from_defbase = MEM_callocN(sizeof(*bone_from_defbase) * defbase_len, "defnrToBone");
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
          */
         for (i = 0, dg = ob_target->defbase.first; dg; i++, dg = dg->next) {
-          pchan_from_defbase[i] = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
+          const bPoseChannel *pchan = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
           /* exclude non-deforming bones */
-          if (pchan_from_defbase[i]) {
-            if (pchan_from_defbase[i]->bone->flag & BONE_NO_DEFORM) {
-              pchan_from_defbase[i] = NULL;
-            }
+          if (pchan && (pchan->bone->flag & BONE_NO_DEFORM) == 0) {
+            armature_deform_bone_init(&bone_from_defbase[i], pchan);
           }
         }
       }
@@ -574,7 +597,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       .armature_def_nr = armature_def_nr,
       .dverts = dverts,
       .dverts_len = dverts_len,
-      .pchan_from_defbase = pchan_from_defbase,
+      .bone_from_defbase = bone_from_defbase,
       .defbase_len = defbase_len,
       .bmesh =
           {
@@ -608,8 +631,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task, &settings);
   }
 
-  if (pchan_from_defbase) {
-    MEM_freeN(pchan_from_defbase);
+  if (bone_from_defbase) {
+    MEM_freeN(bone_from_defbase);
   }
 }
 
@@ -76,6 +76,28 @@ fn::GSpan ReadAttribute::get_span() const
   return fn::GSpan(cpp_type_, array_buffer_, size_);
 }
 
+fn::GSpan ReadAttribute::get_span_for_range(const IndexRange range, void *r_buffer) const
+{
+  BLI_assert(range.one_after_last() <= size_);
+  if (array_buffer_ == nullptr && this->span_is_referenced()) {
+    this->get_span();
+  }
+  if (array_buffer_ != nullptr) {
+    return fn::GSpan(
+        cpp_type_, POINTER_OFFSET(array_buffer_, range.start() * cpp_type_.size()), range.size());
+  }
+  this->get_range_internal(range, r_buffer);
+  return fn::GSpan(cpp_type_, r_buffer, range.size());
+}
+
+void ReadAttribute::get_range_internal(const IndexRange range, void *r_values) const
+{
+  const int element_size = cpp_type_.size();
+  for (const int64_t i : IndexRange(range.size())) {
+    this->get_internal(range[i], POINTER_OFFSET(r_values, i * element_size));
+  }
+}
+
 void ReadAttribute::initialize_span() const
 {
   const int element_size = cpp_type_.size();
@@ -321,6 +343,11 @@ template<typename T> class ArrayReadAttribute final : public ReadAttribute {
     array_buffer_ = const_cast<T *>(data_.data());
     array_is_temporary_ = false;
   }
+
+  bool span_is_referenced() const override
+  {
+    return true;
+  }
 };
 
 template<typename StructT, typename ElemT, typename GetFuncT, typename SetFuncT>
@@ -412,6 +439,11 @@ class ConstantReadAttribute final : public ReadAttribute {
     array_is_temporary_ = true;
     cpp_type_.fill_uninitialized(value_, array_buffer_, size_);
   }
+
+  void get_range_internal(const IndexRange range, void *r_values) const override
+  {
+    cpp_type_.fill_uninitialized(value_, r_values, range.size());
+  }
 };
 
 class ConvertedReadAttribute final : public ReadAttribute {
@@ -1002,7 +1034,7 @@ ReadAttributePtr PointCloudComponent::attribute_try_get_for_read(
 
 WriteAttributePtr PointCloudComponent::attribute_try_get_for_write(const StringRef attribute_name)
 {
-  PointCloud *pointcloud = this->get_for_write();
+  PointCloud *pointcloud = this->get_for_write_keep_referenced_layers();
   if (pointcloud == nullptr) {
     return {};
   }
@@ -1018,7 +1050,7 @@ bool PointCloudComponent::attribute_try_delete(const StringRef attribute_name)
   if (this->attribute_is_builtin(attribute_name)) {
     return false;
   }
-  PointCloud *pointcloud = this->get_for_write();
+  PointCloud *pointcloud = this->get_for_write_keep_referenced_layers();
   if (pointcloud == nullptr) {
     return false;
   }
@@ -1046,7 +1078,7 @@ bool PointCloudComponent::attribute_try_create(const StringRef attribute_name,
   if (!this->attribute_domain_with_type_supported(domain, data_type)) {
     return false;
   }
-  PointCloud *pointcloud = this->get_for_write();
+  PointCloud *pointcloud = this->get_for_write_keep_referenced_layers();
   if (pointcloud == nullptr) {
     return false;
   }
@@ -1174,7 +1206,7 @@ ReadAttributePtr MeshComponent::attribute_try_get_for_read(const StringRef attri
 
 WriteAttributePtr MeshComponent::attribute_try_get_for_write(const StringRef attribute_name)
 {
-  Mesh *mesh = this->get_for_write();
+  Mesh *mesh = this->get_for_write_keep_referenced_layers();
   if (mesh == nullptr) {
     return {};
   }
@@ -1246,7 +1278,7 @@ bool MeshComponent::attribute_try_delete(const StringRef attribute_name)
   if (this->attribute_is_builtin(attribute_name)) {
     return false;
   }
-  Mesh *mesh = this->get_for_write();
+  Mesh *mesh = this->get_for_write_keep_referenced_layers();
   if (mesh == nullptr) {
     return false;
   }
@@ -1258,6 +1290,9 @@ bool MeshComponent::attribute_try_delete(const StringRef attribute_name)
 
   const int vertex_group_index = vertex_group_names_.lookup_default_as(attribute_name, -1);
   if (vertex_group_index != -1) {
+    /* Copy the data layer if it is shared with some other mesh. */
+    mesh_->dvert = (MDeformVert *)CustomData_duplicate_referenced_layer(
+        &mesh_->vdata, CD_MDEFORMVERT, mesh_->totvert);
     for (MDeformVert &dvert : blender::MutableSpan(mesh_->dvert, mesh_->totvert)) {
       MDeformWeight *weight = BKE_defvert_find_index(&dvert, vertex_group_index);
       BKE_defvert_remove_group(&dvert, weight);
@@ -1278,7 +1313,7 @@ bool MeshComponent::attribute_try_create(const StringRef attribute_name,
   if (!this->attribute_domain_with_type_supported(domain, data_type)) {
     return false;
   }
-  Mesh *mesh = this->get_for_write();
+  Mesh *mesh = this->get_for_write_keep_referenced_layers();
   if (mesh == nullptr) {
     return false;
   }
@@ -67,6 +67,12 @@
 /* number of layers to add when growing a CustomData object */
 #define CUSTOMDATA_GROW 5
 
+/* Layer arrays of at least this size are aligned to cache lines, so loops over their elements
+ * don't straddle them and can use aligned vector loads. For smaller arrays the padding of the
+ * aligned allocation isn't worth it. */
+#define CUSTOMDATA_LAYER_ALIGN 64
+#define CUSTOMDATA_LAYER_ALIGN_MIN_SIZE 4096
+
 /* ensure typemap size is ok */
 BLI_STATIC_ASSERT(ARRAY_SIZE(((CustomData *)NULL)->typemap) == CD_NUMTYPES, "size mismatch");
 
@@ -2080,6 +2086,18 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 }
 #endif
 
+static int customdata_named_layer_index_find(const CustomData *data,
+                                             const int type,
+                                             const char *name)
+{
+  for (int i = 0; i < data->totlayer; i++) {
+    if (data->layers[i].type == type && STREQ(data->layers[i].name, name)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 bool CustomData_merge(const struct CustomData *source,
                       struct CustomData *dest,
                       CustomDataMask mask,
@@ -2121,7 +2139,8 @@ bool CustomData_merge(const struct CustomData *source,
     if ((maxnumber != -1) && (number >= maxnumber)) {
       continue;
     }
-    if (CustomData_get_named_layer_index(dest, type, layer->name) != -1) {
+    /* The type-map of `dest` isn't updated while layers are added, search all its layers. */
+    if (customdata_named_layer_index_find(dest, type, layer->name) != -1) {
       continue;
     }
 
@@ -2305,11 +2324,15 @@ int CustomData_get_layer_index_n(const struct CustomData *data, int type, int n)
 
 int CustomData_get_named_layer_index(const CustomData *data, int type, const char *name)
 {
-  for (int i = 0; i < data->totlayer; i++) {
-    if (data->layers[i].type == type) {
-      if (STREQ(data->layers[i].name, name)) {
-        return i;
-      }
+  /* Layers are ordered by type, so only the layers of this type have to be compared. */
+  BLI_assert(customdata_typemap_is_valid(data));
+  const int layer_index = data->typemap[type];
+  if (layer_index == -1) {
+    return -1;
+  }
+  for (int i = layer_index; i < data->totlayer && data->layers[i].type == type; i++) {
+    if (STREQ(data->layers[i].name, name)) {
+      return i;
     }
   }
 
@@ -2477,6 +2500,28 @@ void CustomData_clear_layer_flag(struct CustomData *data, int type, int flag)
   }
 }
 
+/**
+ * Allocate the array of a layer, freed with #MEM_freeN like any other layer data.
+ */
+static void *customdata_layer_data_alloc(const size_t totelem,
+                                         const size_t elem_size,
+                                         const bool clear,
+                                         const char *name)
+{
+  if (totelem > SIZE_MAX / elem_size) {
+    return NULL;
+  }
+  const size_t size = totelem * elem_size;
+  if (size < CUSTOMDATA_LAYER_ALIGN_MIN_SIZE) {
+    return clear ? MEM_callocN(size, name) : MEM_mallocN(size, name);
+  }
+  void *data = MEM_mallocN_aligned(size, CUSTOMDATA_LAYER_ALIGN, name);
+  if (data && clear) {
+    memset(data, 0, size);
+  }
+  return data;
+}
+
 static bool customData_resize(CustomData *data, int amount)
 {
   CustomDataLayer *tmp = MEM_calloc_arrayN(
@@ -2518,12 +2563,10 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
     newlayerdata = layerdata;
   }
   else if (totelem > 0 && typeInfo->size > 0) {
-    if (alloctype == CD_DUPLICATE && layerdata) {
-      newlayerdata = MEM_malloc_arrayN((size_t)totelem, typeInfo->size, layerType_getName(type));
-    }
-    else {
-      newlayerdata = MEM_calloc_arrayN((size_t)totelem, typeInfo->size, layerType_getName(type));
-    }
+    newlayerdata = customdata_layer_data_alloc((size_t)totelem,
+                                               (size_t)typeInfo->size,
+                                               !(alloctype == CD_DUPLICATE && layerdata),
+                                               layerType_getName(type));
 
     if (!newlayerdata) {
       return NULL;
@@ -2755,8 +2798,8 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
     const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
 
     if (typeInfo->copy) {
-      void *dst_data = MEM_malloc_arrayN(
-          (size_t)totelem, typeInfo->size, "CD duplicate ref layer");
+      void *dst_data = customdata_layer_data_alloc(
+          (size_t)totelem, (size_t)typeInfo->size, false, "CD duplicate ref layer");
       typeInfo->copy(layer->data, dst_data, totelem);
       layer->data = dst_data;
     }
@@ -2800,6 +2843,13 @@ void *CustomData_duplicate_referenced_layer_named(CustomData *data,
   return customData_duplicate_referenced_layer_index(data, layer_index, totelem);
 }
 
+void CustomData_duplicate_referenced_layers(CustomData *data, const int totelem)
+{
+  for (int i = 0; i < data->totlayer; i++) {
+    customData_duplicate_referenced_layer_index(data, i, totelem);
+  }
+}
+
 bool CustomData_is_referenced_layer(struct CustomData *data, int type)
 {
   /* get the layer index of the first layer of type */
@@ -3626,7 +3676,10 @@ void CustomData_bmesh_free_block_data(CustomData *data, void *block)
   }
 }
 
-static void CustomData_bmesh_alloc_block(CustomData *data, void **block)
+/**
+ * Allocate an uninitialized block, the layers must still be set or copied into it.
+ */
+void CustomData_bmesh_alloc_block(CustomData *data, void **block)
 {
   if (*block) {
     CustomData_bmesh_free_block(data, block);
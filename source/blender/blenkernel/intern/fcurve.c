@@ -1760,6 +1760,48 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/**
+ * Check whether the evaluation time lies strictly inside the segment that ends at the given
+ * keyframe, far enough from both keyframes that a binary search would return the same index.
+ */
+static bool fcurve_eval_segment_contains(const FCurve *fcu,
+                                         const BezTriple *bezts,
+                                         const int index,
+                                         const float evaltime,
+                                         const float threshold)
+{
+  if (index <= 0 || index >= (int)fcu->totvert) {
+    return false;
+  }
+  const float prev_frame = bezts[index - 1].vec[1][0];
+  const float frame = bezts[index].vec[1][0];
+  return (prev_frame < evaltime && evaltime < frame && !IS_EQT(evaltime, prev_frame, threshold) &&
+          !IS_EQT(evaltime, frame, threshold));
+}
+
+/**
+ * Same as #BKE_fcurve_bezt_binarysearch_index_ex, but first checks the segment that was found by
+ * the previous evaluation and the one after it. Curves are mostly evaluated at consecutive frames
+ * during playback, so this avoids the search in most cases.
+ */
+static int fcurve_eval_segment_index(
+    FCurve *fcu, BezTriple *bezts, float evaltime, float threshold, bool *r_exact)
+{
+  const int hint = fcu->eval_segment_index;
+  for (int index = hint; index <= hint + 1; index++) {
+    if (fcurve_eval_segment_contains(fcu, bezts, index, evaltime, threshold)) {
+      *r_exact = false;
+      fcu->eval_segment_index = index;
+      return index;
+    }
+  }
+
+  const int index = BKE_fcurve_bezt_binarysearch_index_ex(
+      bezts, evaltime, fcu->totvert, threshold, r_exact);
+  fcu->eval_segment_index = index;
+  return index;
+}
+
 static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, float evaltime)
 {
   const float eps = 1.e-8f;
@@ -1779,7 +1821,7 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
    *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  a = fcurve_eval_segment_index(fcu, bezts, evaltime, 0.0001, &exact);
   bezt = bezts + a;
 
   if (exact) {
@@ -2212,6 +2254,28 @@ float calculate_fcurve(PathResolvedRNA *anim_rna,
   return curval;
 }
 
+/**
+ * Evaluate all F-Curves of the list at the same time, writing the value of the n-th F-Curve to
+ * `r_values[n]`, so that the values can be written to their properties afterwards. This keeps
+ * the evaluation of the curves separate from the much more expensive RNA path resolving.
+ *
+ * Muted, disabled and empty F-Curves get a value of zero. The curves must not have drivers,
+ * which is the case for the F-Curves of actions.
+ */
+void calculate_fcurves(ListBase *fcurves, float evaltime, float *r_values)
+{
+  int i = 0;
+  LISTBASE_FOREACH_INDEX (FCurve *, fcu, fcurves, i) {
+    BLI_assert(fcu->driver == NULL);
+    if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) || BKE_fcurve_is_empty(fcu)) {
+      r_values[i] = 0.0f;
+      continue;
+    }
+    r_values[i] = evaluate_fcurve(fcu, evaltime);
+    fcu->curval = r_values[i]; /* Debug display only, not thread safe! */
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -14,6 +14,7 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include "BKE_customdata.h"
 #include "BKE_geometry_set.hh"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
@@ -21,7 +22,9 @@
 #include "BKE_pointcloud.h"
 #include "BKE_volume.h"
 
+#include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -80,6 +83,15 @@ bool GeometryComponent::is_mutable() const
   return users_ <= 1;
 }
 
+bool GeometryComponent::owns_direct_data() const
+{
+  return true;
+}
+
+void GeometryComponent::ensure_owns_direct_data()
+{
+}
+
 GeometryComponentType GeometryComponent::type() const
 {
   return type_;
@@ -151,6 +163,21 @@ void GeometrySet::add(const GeometryComponent &component)
   components_.add_new(component.type(), std::move(component_ptr));
 }
 
+void GeometrySet::ensure_owns_direct_data()
+{
+  Vector<GeometryComponentType> component_types;
+  for (GeometryComponentPtr &component : components_.values()) {
+    if (!component->owns_direct_data()) {
+      component_types.append(component->type());
+    }
+  }
+  for (const GeometryComponentType component_type : component_types) {
+    /* When the component is shared, this already makes a copy that owns its data. */
+    GeometryComponent &component = this->get_component_for_write(component_type);
+    component.ensure_owns_direct_data();
+  }
+}
+
 void GeometrySet::compute_boundbox_without_instances(float3 *r_min, float3 *r_max) const
 {
   const PointCloud *pointcloud = this->get_pointcloud_for_read();
@@ -306,7 +333,15 @@ GeometryComponent *MeshComponent::copy() const
 {
   MeshComponent *new_component = new MeshComponent();
   if (mesh_ != nullptr) {
-    new_component->mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    if (ownership_ == GeometryOwnershipType::Owned) {
+      /* Data layers are only duplicated when they are modified. */
+      new_component->mesh_ = BKE_mesh_copy_for_eval(mesh_, true);
+      this->user_add();
+      new_component->referenced_component_ = blender::UserCounter<const GeometryComponent>(this);
+    }
+    else {
+      new_component->mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    }
     new_component->ownership_ = GeometryOwnershipType::Owned;
     new_component->vertex_group_names_ = blender::Map(vertex_group_names_);
   }
@@ -322,6 +357,7 @@ void MeshComponent::clear()
     }
     mesh_ = nullptr;
   }
+  referenced_component_.reset();
   vertex_group_names_.clear();
 }
 
@@ -344,6 +380,7 @@ void MeshComponent::replace(Mesh *mesh, GeometryOwnershipType ownership)
 Mesh *MeshComponent::release()
 {
   BLI_assert(this->is_mutable());
+  this->duplicate_referenced_layers();
   Mesh *mesh = mesh_;
   mesh_ = nullptr;
   return mesh;
@@ -370,6 +407,16 @@ const Mesh *MeshComponent::get_for_read() const
 /* Get the mesh from this component. This method can only be used when the component is mutable,
  * i.e. it is not shared. The returned mesh can be modified. No ownership is transferred. */
 Mesh *MeshComponent::get_for_write()
+{
+  Mesh *mesh = this->get_for_write_keep_referenced_layers();
+  this->duplicate_referenced_layers();
+  return mesh;
+}
+
+/* Like #get_for_write, but data layers that are shared with another component are not
+ * duplicated. The caller has to duplicate layers before modifying them, e.g. with
+ * #CustomData_duplicate_referenced_layer_named. */
+Mesh *MeshComponent::get_for_write_keep_referenced_layers()
 {
   BLI_assert(this->is_mutable());
   if (ownership_ == GeometryOwnershipType::ReadOnly) {
@@ -379,6 +426,37 @@ Mesh *MeshComponent::get_for_write()
   return mesh_;
 }
 
+/* Make sure that the component does not depend on the data of another component anymore. */
+void MeshComponent::duplicate_referenced_layers()
+{
+  if (!referenced_component_) {
+    return;
+  }
+  if (mesh_ != nullptr) {
+    CustomData_duplicate_referenced_layers(&mesh_->vdata, mesh_->totvert);
+    CustomData_duplicate_referenced_layers(&mesh_->edata, mesh_->totedge);
+    CustomData_duplicate_referenced_layers(&mesh_->fdata, mesh_->totface);
+    CustomData_duplicate_referenced_layers(&mesh_->ldata, mesh_->totloop);
+    CustomData_duplicate_referenced_layers(&mesh_->pdata, mesh_->totpoly);
+    BKE_mesh_update_customdata_pointers(mesh_, false);
+  }
+  referenced_component_.reset();
+}
+
+bool MeshComponent::owns_direct_data() const
+{
+  return ownership_ == GeometryOwnershipType::Owned;
+}
+
+void MeshComponent::ensure_owns_direct_data()
+{
+  BLI_assert(this->is_mutable());
+  if (mesh_ != nullptr && ownership_ != GeometryOwnershipType::Owned) {
+    mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    ownership_ = GeometryOwnershipType::Owned;
+  }
+}
+
 bool MeshComponent::is_empty() const
 {
   return mesh_ == nullptr;
@@ -403,7 +481,15 @@ GeometryComponent *PointCloudComponent::copy() const
 {
   PointCloudComponent *new_component = new PointCloudComponent();
   if (pointcloud_ != nullptr) {
-    new_component->pointcloud_ = BKE_pointcloud_copy_for_eval(pointcloud_, false);
+    if (ownership_ == GeometryOwnershipType::Owned) {
+      /* Data layers are only duplicated when they are modified. */
+      new_component->pointcloud_ = BKE_pointcloud_copy_for_eval(pointcloud_, true);
+      this->user_add();
+      new_component->referenced_component_ = blender::UserCounter<const GeometryComponent>(this);
+    }
+    else {
+      new_component->pointcloud_ = BKE_pointcloud_copy_for_eval(pointcloud_, false);
+    }
     new_component->ownership_ = GeometryOwnershipType::Owned;
   }
   return new_component;
@@ -418,6 +504,7 @@ void PointCloudComponent::clear()
     }
     pointcloud_ = nullptr;
   }
+  referenced_component_.reset();
 }
 
 bool PointCloudComponent::has_pointcloud() const
@@ -439,6 +526,7 @@ void PointCloudComponent::replace(PointCloud *pointcloud, GeometryOwnershipType
 PointCloud *PointCloudComponent::release()
 {
   BLI_assert(this->is_mutable());
+  this->duplicate_referenced_layers();
   PointCloud *pointcloud = pointcloud_;
   pointcloud_ = nullptr;
   return pointcloud;
@@ -456,6 +544,16 @@ const PointCloud *PointCloudComponent::get_for_read() const
  * mutable, i.e. it is not shared. The returned point cloud can be modified. No ownership is
  * transferred. */
 PointCloud *PointCloudComponent::get_for_write()
+{
+  PointCloud *pointcloud = this->get_for_write_keep_referenced_layers();
+  this->duplicate_referenced_layers();
+  return pointcloud;
+}
+
+/* Like #get_for_write, but data layers that are shared with another component are not
+ * duplicated. The caller has to duplicate layers before modifying them, e.g. with
+ * #CustomData_duplicate_referenced_layer_named. */
+PointCloud *PointCloudComponent::get_for_write_keep_referenced_layers()
 {
   BLI_assert(this->is_mutable());
   if (ownership_ == GeometryOwnershipType::ReadOnly) {
@@ -465,6 +563,33 @@ PointCloud *PointCloudComponent::get_for_write()
   return pointcloud_;
 }
 
+/* Make sure that the component does not depend on the data of another component anymore. */
+void PointCloudComponent::duplicate_referenced_layers()
+{
+  if (!referenced_component_) {
+    return;
+  }
+  if (pointcloud_ != nullptr) {
+    CustomData_duplicate_referenced_layers(&pointcloud_->pdata, pointcloud_->totpoint);
+    BKE_pointcloud_update_customdata_pointers(pointcloud_);
+  }
+  referenced_component_.reset();
+}
+
+bool PointCloudComponent::owns_direct_data() const
+{
+  return ownership_ == GeometryOwnershipType::Owned;
+}
+
+void PointCloudComponent::ensure_owns_direct_data()
+{
+  BLI_assert(this->is_mutable());
+  if (pointcloud_ != nullptr && ownership_ != GeometryOwnershipType::Owned) {
+    pointcloud_ = BKE_pointcloud_copy_for_eval(pointcloud_, false);
+    ownership_ = GeometryOwnershipType::Owned;
+  }
+}
+
 bool PointCloudComponent::is_empty() const
 {
   return pointcloud_ == nullptr;
@@ -484,6 +609,7 @@ GeometryComponent *InstancesComponent::copy() const
 {
   InstancesComponent *new_component = new InstancesComponent();
   new_component->transforms_ = transforms_;
+  new_component->ids_ = ids_;
   new_component->instanced_data_ = instanced_data_;
   return new_component;
 }
@@ -492,6 +618,14 @@ void InstancesComponent::clear()
 {
   instanced_data_.clear();
   transforms_.clear();
+  ids_.clear();
+}
+
+void InstancesComponent::reserve(const int min_capacity)
+{
+  instanced_data_.reserve(min_capacity);
+  transforms_.reserve(min_capacity);
+  ids_.reserve(min_capacity);
 }
 
 void InstancesComponent::add_instance(Object *object, float4x4 transform, const int id)
@@ -628,6 +762,20 @@ Volume *VolumeComponent::get_for_write()
   return volume_;
 }
 
+bool VolumeComponent::owns_direct_data() const
+{
+  return ownership_ == GeometryOwnershipType::Owned;
+}
+
+void VolumeComponent::ensure_owns_direct_data()
+{
+  BLI_assert(this->is_mutable());
+  if (volume_ != nullptr && ownership_ != GeometryOwnershipType::Owned) {
+    volume_ = BKE_volume_copy_for_eval(volume_, false);
+    ownership_ = GeometryOwnershipType::Owned;
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -29,6 +29,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -749,6 +750,64 @@ void BKE_gpencil_prepare_eval_data(Depsgraph *depsgraph, Scene *scene, Object *o
  * \param scene: Current scene
  * \param ob: Grease pencil object
  */
+typedef struct GpencilDeformStrokesData {
+  GpencilModifierData *md;
+  const GpencilModifierTypeInfo *mti;
+  Depsgraph *depsgraph;
+  Object *ob;
+  bGPDlayer *gpl;
+  bGPDframe *gpf;
+  bGPDstroke **strokes;
+} GpencilDeformStrokesData;
+
+static void gpencil_deform_strokes_fn(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GpencilDeformStrokesData *data = userdata;
+  data->mti->deformStroke(
+      data->md, data->depsgraph, data->ob, data->gpl, data->gpf, data->strokes[i]);
+}
+
+/* Deform the strokes of a frame, in parallel when there are enough of them. */
+static void gpencil_deform_strokes_parallel(GpencilModifierData *md,
+                                            const GpencilModifierTypeInfo *mti,
+                                            Depsgraph *depsgraph,
+                                            Object *ob,
+                                            bGPDlayer *gpl,
+                                            bGPDframe *gpf)
+{
+  const int strokes_len = BLI_listbase_count(&gpf->strokes);
+  if (strokes_len < 64) {
+    LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+      mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
+    }
+    return;
+  }
+
+  bGPDstroke **strokes = MEM_malloc_arrayN(strokes_len, sizeof(*strokes), __func__);
+  int i = 0;
+  LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+    strokes[i++] = gps;
+  }
+
+  GpencilDeformStrokesData data = {
+      .md = md,
+      .mti = mti,
+      .depsgraph = depsgraph,
+      .ob = ob,
+      .gpl = gpl,
+      .gpf = gpf,
+      .strokes = strokes,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, strokes_len, &data, gpencil_deform_strokes_fn, &settings);
+
+  MEM_freeN(strokes);
+}
+
 void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
   bGPdata *gpd = (bGPdata *)ob->data;
@@ -790,7 +849,14 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
             continue;
           }
 
-          if (mti->deformStroke) {
+          if (mti->deformStroke == NULL) {
+            continue;
+          }
+
+          if (mti->flags & eGpencilModifierTypeFlag_ThreadSafeDeform) {
+            gpencil_deform_strokes_parallel(md, mti, depsgraph, ob, gpl, gpf);
+          }
+          else {
             LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
               mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
             }
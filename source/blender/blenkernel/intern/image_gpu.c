@@ -151,6 +151,53 @@ static int compare_packtile(const void *a, const void *b)
   return tile_a->pack_score < tile_b->pack_score;
 }
 
+/* Don't let the tiles be downscaled below this size to fit in memory. */
+#define TILE_ARRAY_MIN_DOWNSCALE_SIZE 256
+
+/**
+ * Number of times the tiles must be halved in size for the tile array to use at most half of the
+ * free video memory. Zero when the memory statistics are not available.
+ */
+static int gpu_texture_tile_array_downscale_shift(ListBase *boxes,
+                                                  const ImBuf *main_ibuf,
+                                                  const bool use_high_bitdepth,
+                                                  const int arraywidth,
+                                                  const int arrayheight)
+{
+  if (!GPU_mem_stats_supported()) {
+    return 0;
+  }
+
+  int totalmem_kb, freemem_kb;
+  GPU_mem_stats_get(&totalmem_kb, &freemem_kb);
+  if (freemem_kb <= 0) {
+    return 0;
+  }
+
+  /* Matches the texture formats used by #IMB_touch_gpu_texture. */
+  size_t pixel_size = 4;
+  if (main_ibuf->rect_float) {
+    pixel_size = (use_high_bitdepth && !(main_ibuf->flags & IB_halffloat)) ? 16 : 8;
+  }
+
+  size_t total_size = 0;
+  LISTBASE_FOREACH (PackTile *, packtile, boxes) {
+    total_size += (size_t)packtile->boxpack.w * (size_t)packtile->boxpack.h * pixel_size;
+  }
+  if (GPU_mipmap_enabled()) {
+    total_size += total_size / 3;
+  }
+
+  const size_t budget = (size_t)freemem_kb * 1024 / 2;
+  int shift = 0;
+  while (total_size > budget && (arraywidth >> shift) > TILE_ARRAY_MIN_DOWNSCALE_SIZE &&
+         (arrayheight >> shift) > TILE_ARRAY_MIN_DOWNSCALE_SIZE) {
+    total_size /= 4;
+    shift++;
+  }
+  return shift;
+}
+
 static GPUTexture *gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
 {
   int arraywidth = 0, arrayheight = 0;
@@ -187,6 +234,20 @@ static GPUTexture *gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
 
   BLI_assert(arraywidth > 0 && arrayheight > 0);
 
+  const bool use_high_bitdepth = (ima->flag & IMA_HIGH_BITDEPTH);
+
+  /* Downscale all tiles when the array would not fit in the free video memory. */
+  const int shift = gpu_texture_tile_array_downscale_shift(
+      &boxes, main_ibuf, use_high_bitdepth, arraywidth, arrayheight);
+  if (shift > 0) {
+    LISTBASE_FOREACH (PackTile *, packtile, &boxes) {
+      packtile->boxpack.w = max_ii(packtile->boxpack.w >> shift, 1);
+      packtile->boxpack.h = max_ii(packtile->boxpack.h >> shift, 1);
+    }
+    arraywidth = max_ii(arraywidth >> shift, 1);
+    arrayheight = max_ii(arrayheight >> shift, 1);
+  }
+
   BLI_listbase_sort(&boxes, compare_packtile);
   int arraylayers = 0;
   /* Keep adding layers until all tiles are packed. */
@@ -211,7 +272,6 @@ static GPUTexture *gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
     arraylayers++;
   }
 
-  const bool use_high_bitdepth = (ima->flag & IMA_HIGH_BITDEPTH);
   /* Create Texture without content. */
   GPUTexture *tex = IMB_touch_gpu_texture(
       ima->id.name + 2, main_ibuf, arraywidth, arrayheight, arraylayers, use_high_bitdepth);
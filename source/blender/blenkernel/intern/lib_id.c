@@ -2034,10 +2034,11 @@ void BKE_library_make_local(Main *bmain,
    * ID in a separated loop,
    * as lbarray ordering is not enough to ensure us we did catch all dependencies
    * (e.g. if making local a parent object before its child...). See T48907. */
-  /* TODO This is now the biggest step by far (in term of processing time).
-   * We may be able to gain here by using again main->relations mapping, but...
-   * this implies BKE_libblock_remap & co to be able to update main->relations on the fly.
-   * Have to think about it a bit more, and see whether new code is OK first, anyway. */
+  /* This used to be the biggest step by far (in term of processing time), the relations mapping
+   * (re-generated since copies have been added to Main) allows remapping to only process actual
+   * users of each ID. */
+  BKE_main_relations_create(bmain, 0);
+
   for (LinkNode *it = copied_ids; it; it = it->next) {
     ID *id = it->link;
 
@@ -2057,6 +2058,8 @@ void BKE_library_make_local(Main *bmain,
     }
   }
 
+  BKE_main_relations_free(bmain);
+
 #ifdef DEBUG_TIME
   printf("Step 4: Remap local usages of old (linked) ID to new (local) ID: Done.\n");
   TIMEIT_VALUE_PRINT(make_local);
@@ -229,16 +229,17 @@ static void library_foreach_ID_link(Main *bmain,
       data.cb_flag_clear = inherit_data->cb_flag_clear;
     }
 
+    MainIDRelationsEntry *entry = NULL;
     if (bmain != NULL && bmain->relations != NULL && (flag & IDWALK_READONLY) &&
         (((bmain->relations->flag & MAINIDRELATIONS_INCLUDE_UI) == 0) ==
-         ((data.flag & IDWALK_INCLUDE_UI) == 0))) {
+         ((data.flag & IDWALK_INCLUDE_UI) == 0)) &&
+        /* IDs created after the relations have no entry. */
+        (entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers, id)) != NULL) {
       /* Note that this is minor optimization, even in worst cases (like id being an object with
        * lots of drivers and constraints and modifiers, or material etc. with huge node tree),
        * but we might as well use it (Main->relations is always assumed valid,
        * it's responsibility of code creating it to free it,
        * especially if/when it starts modifying Main database). */
-      MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers,
-                                                     id);
       for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != NULL;
            to_id_entry = to_id_entry->next) {
         BKE_lib_query_foreachid_process(
@@ -22,6 +22,11 @@
 
 #include "CLG_log.h"
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
+#include "BLI_linklist.h"
+#include "BLI_mempool.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -346,6 +351,140 @@ static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new
   ntreeUpdateAllUsers(bmain, new_id);
 }
 
+/**
+ * Get the ID owning given \a id in \a relations, i.e. \a id itself unless it is an embedded one.
+ * Returns NULL if the owner is not known.
+ */
+static ID *libblock_remap_relations_owner_get(MainIDRelations *relations, ID *id)
+{
+  if ((id->flag & LIB_EMBEDDED_DATA) == 0) {
+    return id;
+  }
+
+  MainIDRelationsEntry *entry = BLI_ghash_lookup(relations->relations_from_pointers, id);
+  if (entry == NULL) {
+    return NULL;
+  }
+  for (MainIDRelationsEntryItem *from_id_entry = entry->from_ids; from_id_entry != NULL;
+       from_id_entry = from_id_entry->next) {
+    if (from_id_entry->usage_flag & IDWALK_CB_EMBEDDED) {
+      return from_id_entry->id_pointer.from;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Get all the IDs using \a old_id from \a relations, to only process those instead of the whole
+ * Main. Returns false if they cannot be all found that way.
+ */
+static bool libblock_remap_relations_users_get(MainIDRelations *relations,
+                                               ID *old_id,
+                                               LinkNode **r_users)
+{
+  MainIDRelationsEntry *entry = BLI_ghash_lookup(relations->relations_from_pointers, old_id);
+  if (entry == NULL) {
+    /* Not in the mapping, e.g. created after it. */
+    return false;
+  }
+
+  GSet *users = BLI_gset_ptr_new(__func__);
+  bool is_valid = true;
+  for (MainIDRelationsEntryItem *from_id_entry = entry->from_ids; from_id_entry != NULL;
+       from_id_entry = from_id_entry->next) {
+    ID *id_owner = libblock_remap_relations_owner_get(relations, from_id_entry->id_pointer.from);
+    if (id_owner == NULL) {
+      is_valid = false;
+      break;
+    }
+    if (BLI_gset_add(users, id_owner)) {
+      BLI_linklist_prepend(r_users, id_owner);
+    }
+  }
+  BLI_gset_free(users, NULL);
+
+  if (!is_valid) {
+    BLI_linklist_free(*r_users, NULL);
+    *r_users = NULL;
+  }
+  return is_valid;
+}
+
+/**
+ * Update \a relations after usages of \a old_id have been remapped to \a new_id, such that they
+ * remain valid and can be used by following remappings.
+ */
+static void libblock_remap_relations_update(MainIDRelations *relations, ID *old_id, ID *new_id)
+{
+  MainIDRelationsEntry *entry_old = BLI_ghash_lookup(relations->relations_from_pointers, old_id);
+  if (entry_old == NULL) {
+    return;
+  }
+  MainIDRelationsEntry **entry_new_p = NULL;
+  if (new_id != NULL &&
+      !BLI_ghash_ensure_p(relations->relations_from_pointers, new_id, (void ***)&entry_new_p)) {
+    *entry_new_p = MEM_callocN(sizeof(**entry_new_p), __func__);
+    (*entry_new_p)->session_uuid = new_id->session_uuid;
+  }
+
+  /* Number of usages of old_id left by each of its users. */
+  GHash *users_remaining = BLI_ghash_ptr_new(__func__);
+
+  for (MainIDRelationsEntryItem *from_id_entry = entry_old->from_ids; from_id_entry != NULL;
+       from_id_entry = from_id_entry->next) {
+    ID *id_from = from_id_entry->id_pointer.from;
+    void **remaining_p;
+    if (BLI_ghash_ensure_p(users_remaining, id_from, &remaining_p)) {
+      continue;
+    }
+
+    int remaining = 0;
+    MainIDRelationsEntry *entry_from = BLI_ghash_lookup(relations->relations_from_pointers,
+                                                        id_from);
+    for (MainIDRelationsEntryItem *to_id_entry = entry_from->to_ids; to_id_entry != NULL;
+         to_id_entry = to_id_entry->next) {
+      if (to_id_entry->session_uuid != old_id->session_uuid) {
+        continue;
+      }
+      ID *id_to = *to_id_entry->id_pointer.to;
+      if (id_to == old_id) {
+        remaining++;
+        continue;
+      }
+      to_id_entry->session_uuid = (id_to != NULL) ? id_to->session_uuid :
+                                                    MAIN_ID_SESSION_UUID_UNSET;
+      if (id_to != NULL) {
+        BLI_assert(id_to == new_id);
+        MainIDRelationsEntryItem *new_from_id_entry = BLI_mempool_alloc(
+            relations->entry_items_pool);
+        new_from_id_entry->next = (*entry_new_p)->from_ids;
+        new_from_id_entry->id_pointer.from = id_from;
+        new_from_id_entry->session_uuid = id_from->session_uuid;
+        new_from_id_entry->usage_flag = to_id_entry->usage_flag;
+        (*entry_new_p)->from_ids = new_from_id_entry;
+      }
+    }
+    *remaining_p = POINTER_FROM_INT(remaining);
+  }
+
+  /* Only keep as many users items of old_id as there are usages left. */
+  MainIDRelationsEntryItem **from_id_entry_p = &entry_old->from_ids;
+  while (*from_id_entry_p != NULL) {
+    MainIDRelationsEntryItem *from_id_entry = *from_id_entry_p;
+    void **remaining_p = BLI_ghash_lookup_p(users_remaining, from_id_entry->id_pointer.from);
+    if (POINTER_AS_INT(*remaining_p) > 0) {
+      *remaining_p = POINTER_FROM_INT(POINTER_AS_INT(*remaining_p) - 1);
+      from_id_entry_p = &from_id_entry->next;
+    }
+    else {
+      *from_id_entry_p = from_id_entry->next;
+      BLI_mempool_free(relations->entry_items_pool, from_id_entry);
+    }
+  }
+
+  BLI_ghash_free(users_remaining, NULL, NULL);
+}
+
 /**
  * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
  *
@@ -373,6 +512,7 @@ static void libblock_remap_data(
     Main *bmain, ID *id, ID *old_id, ID *new_id, const short remap_flags, IDRemap *r_id_remap_data)
 {
   IDRemap id_remap_data;
+  LinkNode *users = NULL;
   const int foreach_id_flags = (remap_flags & ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE) != 0 ?
                                    IDWALK_NO_INDIRECT_PROXY_DATA_USAGE :
                                    IDWALK_NOP;
@@ -399,10 +539,26 @@ static void libblock_remap_data(
     BKE_library_foreach_ID_link(
         NULL, id, foreach_libblock_remap_callback, (void *)r_id_remap_data, foreach_id_flags);
   }
+  else if (bmain->relations != NULL &&
+           libblock_remap_relations_users_get(bmain->relations, old_id, &users)) {
+    /* Only process the known users of old_id. */
+    for (LinkNode *user = users; user != NULL; user = user->next) {
+      ID *id_curr = user->link;
+      r_id_remap_data->id_owner = id_curr;
+      libblock_remap_data_preprocess(r_id_remap_data);
+      BKE_library_foreach_ID_link(NULL,
+                                  id_curr,
+                                  foreach_libblock_remap_callback,
+                                  (void *)r_id_remap_data,
+                                  foreach_id_flags);
+    }
+    BLI_linklist_free(users, NULL);
+  }
   else {
     /* Note that this is a very 'brute force' approach,
      * maybe we could use some depsgraph to only process objects actually using given old_id...
-     * sounds rather unlikely currently, though, so this will do for now. */
+     * sounds rather unlikely currently, though, so this will do for now.
+     * When the Main relations are available, the branch above is used instead. */
     ID *id_curr;
 
     FOREACH_MAIN_ID_BEGIN (bmain, id_curr) {
@@ -422,6 +578,16 @@ static void libblock_remap_data(
     FOREACH_MAIN_ID_END;
   }
 
+  if (bmain->relations != NULL) {
+    if (old_id != NULL) {
+      libblock_remap_relations_update(bmain->relations, old_id, new_id);
+    }
+    else {
+      /* All usages from id have been cleared, there is no simple way to update the relations. */
+      BKE_main_relations_create(bmain, bmain->relations->flag);
+    }
+  }
+
   /* XXX We may not want to always 'transfer' fake-user from old to new id...
    *     Think for now it's desired behavior though,
    *     we can always add an option (flag) to control this later if needed. */
@@ -542,6 +708,14 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
   libblock_remap_data_postprocess_nodetree_update(bmain, new_id);
   BKE_main_lock(bmain);
 
+  if (bmain->relations != NULL &&
+      (ELEM(GS(old_id->name), ID_OB, ID_GR, ID_NT) ||
+       (new_id != NULL && ELEM(GS(old_id->name), ID_ME, ID_CU, ID_MB, ID_HA, ID_PT, ID_VO)))) {
+    /* Post-processing above may have re-allocated some storage of ID pointers (bases, collection
+     * objects, material slots, node sockets...), which the relations refer to. */
+    BKE_main_relations_create(bmain, bmain->relations->flag);
+  }
+
   /* Full rebuild of DEG! */
   DEG_relations_tag_update(bmain);
 }
@@ -651,6 +825,11 @@ void BKE_libblock_relink_ex(
       break;
   }
 
+  if (bmain->relations != NULL && ELEM(GS(id->name), ID_SCE, ID_GR, ID_OB)) {
+    /* Same as in #BKE_libblock_remap_locked, post-processing may have invalidated relations. */
+    BKE_main_relations_create(bmain, bmain->relations->flag);
+  }
+
   DEG_relations_tag_update(bmain);
 }
 
@@ -3278,37 +3278,39 @@ int BKE_mesh_tessface_calc_ex(CustomData *fdata,
 #undef ML_TO_MF_QUAD
 }
 
+/* Meshes with fewer polygons are triangulated on a single thread. */
+#define MESH_FACE_TESSELLATE_THREADED_LIMIT 4096
+
 /**
- * Calculate tessellation into #MLoopTri which exist only for this purpose.
+ * Triangulate a single polygon into \a mlooptri, starting at \a mlooptri_index.
+ *
+ * \param pf_arena_p: Arena used by the poly-fill of n-gons,
+ * created when needed and cleared after every use.
  */
-void BKE_mesh_recalc_looptri(const MLoop *mloop,
-                             const MPoly *mpoly,
-                             const MVert *mvert,
-                             int totloop,
-                             int totpoly,
-                             MLoopTri *mlooptri)
+BLI_INLINE void mesh_calc_tessellation_for_face(const MLoop *mloop,
+                                                const MPoly *mpoly,
+                                                const MVert *mvert,
+                                                unsigned int poly_index,
+                                                MLoopTri *mlooptri,
+                                                unsigned int mlooptri_index,
+                                                MemArena **pf_arena_p)
 {
   /* use this to avoid locking pthread for _every_ polygon
    * and calling the fill function */
 
 #define USE_TESSFACE_SPEEDUP
 
-  const MPoly *mp;
+  const MPoly *mp = &mpoly[poly_index];
+  const unsigned int mp_loopstart = (unsigned int)mp->loopstart;
+  const unsigned int mp_totloop = (unsigned int)mp->totloop;
   const MLoop *ml;
   MLoopTri *mlt;
-  MemArena *arena = NULL;
-  int poly_index, mlooptri_index;
+  unsigned int l1, l2, l3;
   unsigned int j;
 
-  mlooptri_index = 0;
-  mp = mpoly;
-  for (poly_index = 0; poly_index < totpoly; poly_index++, mp++) {
-    const unsigned int mp_loopstart = (unsigned int)mp->loopstart;
-    const unsigned int mp_totloop = (unsigned int)mp->totloop;
-    unsigned int l1, l2, l3;
-    if (mp_totloop < 3) {
-      /* do nothing */
-    }
+  if (mp_totloop < 3) {
+    /* do nothing */
+  }
 
 #ifdef USE_TESSFACE_SPEEDUP
 
@@ -3319,105 +3321,208 @@ void BKE_mesh_recalc_looptri(const MLoop *mloop,
       l2 = mp_loopstart + i2; \
       l3 = mp_loopstart + i3; \
       ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3); \
-      mlt->poly = (unsigned int)poly_index; \
+      mlt->poly = poly_index; \
     } \
     ((void)0)
 
-    else if (mp_totloop == 3) {
-      ML_TO_MLT(0, 1, 2);
-      mlooptri_index++;
-    }
-    else if (mp_totloop == 4) {
-      ML_TO_MLT(0, 1, 2);
-      MLoopTri *mlt_a = mlt;
-      mlooptri_index++;
-      ML_TO_MLT(0, 2, 3);
-      MLoopTri *mlt_b = mlt;
-      mlooptri_index++;
-
-      if (UNLIKELY(is_quad_flip_v3_first_third_fast(mvert[mloop[mlt_a->tri[0]].v].co,
-                                                    mvert[mloop[mlt_a->tri[1]].v].co,
-                                                    mvert[mloop[mlt_a->tri[2]].v].co,
-                                                    mvert[mloop[mlt_b->tri[2]].v].co))) {
-        /* flip out of degenerate 0-2 state. */
-        mlt_a->tri[2] = mlt_b->tri[2];
-        mlt_b->tri[0] = mlt_a->tri[1];
-      }
+  else if (mp_totloop == 3) {
+    ML_TO_MLT(0, 1, 2);
+  }
+  else if (mp_totloop == 4) {
+    ML_TO_MLT(0, 1, 2);
+    MLoopTri *mlt_a = mlt;
+    mlooptri_index++;
+    ML_TO_MLT(0, 2, 3);
+    MLoopTri *mlt_b = mlt;
+
+    if (UNLIKELY(is_quad_flip_v3_first_third_fast(mvert[mloop[mlt_a->tri[0]].v].co,
+                                                  mvert[mloop[mlt_a->tri[1]].v].co,
+                                                  mvert[mloop[mlt_a->tri[2]].v].co,
+                                                  mvert[mloop[mlt_b->tri[2]].v].co))) {
+      /* flip out of degenerate 0-2 state. */
+      mlt_a->tri[2] = mlt_b->tri[2];
+      mlt_b->tri[0] = mlt_a->tri[1];
     }
+  }
 #endif /* USE_TESSFACE_SPEEDUP */
-    else {
-      const float *co_curr, *co_prev;
+  else {
+    const float *co_curr, *co_prev;
 
-      float normal[3];
+    float normal[3];
 
-      float axis_mat[3][3];
-      float(*projverts)[2];
-      unsigned int(*tris)[3];
+    float axis_mat[3][3];
+    float(*projverts)[2];
+    unsigned int(*tris)[3];
 
-      const unsigned int totfilltri = mp_totloop - 2;
+    const unsigned int totfilltri = mp_totloop - 2;
 
-      if (UNLIKELY(arena == NULL)) {
-        arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
-      }
+    MemArena *pf_arena = *pf_arena_p;
+    if (UNLIKELY(pf_arena == NULL)) {
+      pf_arena = *pf_arena_p = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+    }
 
-      tris = BLI_memarena_alloc(arena, sizeof(*tris) * (size_t)totfilltri);
-      projverts = BLI_memarena_alloc(arena, sizeof(*projverts) * (size_t)mp_totloop);
+    tris = BLI_memarena_alloc(pf_arena, sizeof(*tris) * (size_t)totfilltri);
+    projverts = BLI_memarena_alloc(pf_arena, sizeof(*projverts) * (size_t)mp_totloop);
 
-      zero_v3(normal);
+    zero_v3(normal);
 
-      /* calc normal, flipped: to get a positive 2d cross product */
-      ml = mloop + mp_loopstart;
-      co_prev = mvert[ml[mp_totloop - 1].v].co;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        co_curr = mvert[ml->v].co;
-        add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
-        co_prev = co_curr;
-      }
-      if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
-        normal[2] = 1.0f;
-      }
+    /* calc normal, flipped: to get a positive 2d cross product */
+    ml = mloop + mp_loopstart;
+    co_prev = mvert[ml[mp_totloop - 1].v].co;
+    for (j = 0; j < mp_totloop; j++, ml++) {
+      co_curr = mvert[ml->v].co;
+      add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
+      co_prev = co_curr;
+    }
+    if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
+      normal[2] = 1.0f;
+    }
 
-      /* project verts to 2d */
-      axis_dominant_v3_to_m3_negate(axis_mat, normal);
+    /* project verts to 2d */
+    axis_dominant_v3_to_m3_negate(axis_mat, normal);
 
-      ml = mloop + mp_loopstart;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
-      }
+    ml = mloop + mp_loopstart;
+    for (j = 0; j < mp_totloop; j++, ml++) {
+      mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
+    }
 
-      BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, arena);
+    BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, pf_arena);
 
-      /* apply fill */
-      for (j = 0; j < totfilltri; j++) {
-        unsigned int *tri = tris[j];
+    /* apply fill */
+    for (j = 0; j < totfilltri; j++) {
+      unsigned int *tri = tris[j];
 
-        mlt = &mlooptri[mlooptri_index];
+      mlt = &mlooptri[mlooptri_index];
 
-        /* set loop indices, transformed to vert indices later */
-        l1 = mp_loopstart + tri[0];
-        l2 = mp_loopstart + tri[1];
-        l3 = mp_loopstart + tri[2];
+      /* set loop indices, transformed to vert indices later */
+      l1 = mp_loopstart + tri[0];
+      l2 = mp_loopstart + tri[1];
+      l3 = mp_loopstart + tri[2];
 
-        ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3);
-        mlt->poly = (unsigned int)poly_index;
+      ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3);
+      mlt->poly = poly_index;
 
-        mlooptri_index++;
-      }
+      mlooptri_index++;
+    }
 
-      BLI_memarena_clear(arena);
+    BLI_memarena_clear(pf_arena);
+  }
+
+#undef USE_TESSFACE_SPEEDUP
+#undef ML_TO_MLT
+}
+
+static void mesh_recalc_looptri__single_threaded(const MLoop *mloop,
+                                                 const MPoly *mpoly,
+                                                 const MVert *mvert,
+                                                 int totloop,
+                                                 int totpoly,
+                                                 MLoopTri *mlooptri)
+{
+  MemArena *pf_arena = NULL;
+  const MPoly *mp = mpoly;
+  unsigned int tri_index = 0;
+  for (unsigned int poly_index = 0; poly_index < (unsigned int)totpoly; poly_index++, mp++) {
+    mesh_calc_tessellation_for_face(
+        mloop, mpoly, mvert, poly_index, mlooptri, tri_index, &pf_arena);
+    if (mp->totloop >= 3) {
+      tri_index += (unsigned int)(mp->totloop - 2);
     }
   }
 
-  if (arena) {
-    BLI_memarena_free(arena);
-    arena = NULL;
+  if (pf_arena) {
+    BLI_memarena_free(pf_arena);
+    pf_arena = NULL;
   }
 
-  BLI_assert(mlooptri_index == poly_to_tri_count(totpoly, totloop));
+  BLI_assert(tri_index == (unsigned int)poly_to_tri_count(totpoly, totloop));
   UNUSED_VARS_NDEBUG(totloop);
+}
 
-#undef USE_TESSFACE_SPEEDUP
-#undef ML_TO_MLT
+typedef struct TessellationUserData {
+  const MLoop *mloop;
+  const MPoly *mpoly;
+  const MVert *mvert;
+  MLoopTri *mlooptri;
+} TessellationUserData;
+
+typedef struct TessellationUserTLS {
+  MemArena *pf_arena;
+} TessellationUserTLS;
+
+static void mesh_calc_tessellation_for_face_fn(void *__restrict userdata,
+                                               const int index,
+                                               const TaskParallelTLS *__restrict tls)
+{
+  const TessellationUserData *data = userdata;
+  TessellationUserTLS *tls_data = tls->userdata_chunk;
+  /* The loops of the polygons are contiguous, so the loop offset is the sum of the sizes of the
+   * preceding polygons, each of them adding two loops more than the triangles it's filled with. */
+  const int tri_index = data->mpoly[index].loopstart - (index * 2);
+  mesh_calc_tessellation_for_face(data->mloop,
+                                  data->mpoly,
+                                  data->mvert,
+                                  (unsigned int)index,
+                                  data->mlooptri,
+                                  (unsigned int)tri_index,
+                                  &tls_data->pf_arena);
+}
+
+static void mesh_calc_tessellation_for_face_free_fn(const void *__restrict UNUSED(userdata),
+                                                    void *__restrict tls_v)
+{
+  TessellationUserTLS *tls_data = tls_v;
+  if (tls_data->pf_arena) {
+    BLI_memarena_free(tls_data->pf_arena);
+  }
+}
+
+static void mesh_recalc_looptri__multi_threaded(const MLoop *mloop,
+                                                const MPoly *mpoly,
+                                                const MVert *mvert,
+                                                int UNUSED(totloop),
+                                                int totpoly,
+                                                MLoopTri *mlooptri)
+{
+  TessellationUserTLS tls_data_dummy = {NULL};
+
+  TessellationUserData data = {
+      .mloop = mloop,
+      .mpoly = mpoly,
+      .mvert = mvert,
+      .mlooptri = mlooptri,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  settings.userdata_chunk = &tls_data_dummy;
+  settings.userdata_chunk_size = sizeof(tls_data_dummy);
+
+  settings.func_free = mesh_calc_tessellation_for_face_free_fn;
+
+  BLI_task_parallel_range(0, totpoly, &data, mesh_calc_tessellation_for_face_fn, &settings);
+}
+
+/**
+ * Calculate tessellation into #MLoopTri which exist only for this purpose.
+ *
+ * \note The loops of the polygons must be stored contiguously, in the order of the polygons,
+ * as the offset of the triangles of each polygon is derived from its start loop.
+ */
+void BKE_mesh_recalc_looptri(const MLoop *mloop,
+                             const MPoly *mpoly,
+                             const MVert *mvert,
+                             int totloop,
+                             int totpoly,
+                             MLoopTri *mlooptri)
+{
+  if (totpoly < MESH_FACE_TESSELLATE_THREADED_LIMIT) {
+    mesh_recalc_looptri__single_threaded(mloop, mpoly, mvert, totloop, totpoly, mlooptri);
+  }
+  else {
+    mesh_recalc_looptri__multi_threaded(mloop, mpoly, mvert, totloop, totpoly, mlooptri);
+  }
 }
 
 static void bm_corners_to_loops_ex(ID *id,
@@ -54,6 +54,7 @@
 #include "BLI_session_uuid.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -1052,7 +1053,10 @@ struct Mesh *BKE_modifier_modify_mesh(ModifierData *md,
   if (mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
-  return mti->modifyMesh(md, ctx, me);
+  BLI_TRACE_ZONE_BEGIN(mti->name);
+  Mesh *result = mti->modifyMesh(md, ctx, me);
+  BLI_TRACE_ZONE_END();
+  return result;
 }
 
 void BKE_modifier_deform_verts(ModifierData *md,
@@ -1067,7 +1071,9 @@ void BKE_modifier_deform_verts(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
+  BLI_TRACE_ZONE_BEGIN(mti->name);
   mti->deformVerts(md, ctx, me, vertexCos, numVerts);
+  BLI_TRACE_ZONE_END();
 }
 
 void BKE_modifier_deform_vertsEM(ModifierData *md,
@@ -1083,7 +1089,9 @@ void BKE_modifier_deform_vertsEM(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     BKE_mesh_calc_normals(me);
   }
+  BLI_TRACE_ZONE_BEGIN(mti->name);
   mti->deformVertsEM(md, ctx, em, me, vertexCos, numVerts);
+  BLI_TRACE_ZONE_END();
 }
 
 /* end modifier callback wrappers */
@@ -37,41 +37,54 @@
 #include "BKE_subdiv.h"
 #include "BKE_subsurf.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "DEG_depsgraph_query.h"
 
 #include "multires_reshape.h"
 
-static void multires_subdivide_create_object_space_linear_grids(Mesh *mesh)
+static void multires_subdivide_create_object_space_linear_grids_task(
+    void *__restrict userdata, const int p, const TaskParallelTLS *__restrict UNUSED(tls))
 {
+  Mesh *mesh = userdata;
   MDisps *mdisps = CustomData_get_layer(&mesh->ldata, CD_MDISPS);
-  const int totpoly = mesh->totpoly;
-  for (int p = 0; p < totpoly; p++) {
-    MPoly *poly = &mesh->mpoly[p];
-    float poly_center[3];
-    BKE_mesh_calc_poly_center(poly, &mesh->mloop[poly->loopstart], mesh->mvert, poly_center);
-    for (int l = 0; l < poly->totloop; l++) {
-      const int loop_index = poly->loopstart + l;
-
-      float(*disps)[3] = mdisps[loop_index].disps;
-      mdisps[loop_index].totdisp = 4;
-      mdisps[loop_index].level = 1;
-
-      int prev_loop_index = l - 1 >= 0 ? loop_index - 1 : loop_index + poly->totloop - 1;
-      int next_loop_index = l + 1 < poly->totloop ? loop_index + 1 : poly->loopstart;
-
-      MLoop *loop = &mesh->mloop[loop_index];
-      MLoop *loop_next = &mesh->mloop[next_loop_index];
-      MLoop *loop_prev = &mesh->mloop[prev_loop_index];
-
-      copy_v3_v3(disps[0], poly_center);
-      mid_v3_v3v3(disps[1], mesh->mvert[loop->v].co, mesh->mvert[loop_next->v].co);
-      mid_v3_v3v3(disps[2], mesh->mvert[loop->v].co, mesh->mvert[loop_prev->v].co);
-      copy_v3_v3(disps[3], mesh->mvert[loop->v].co);
-    }
+  MPoly *poly = &mesh->mpoly[p];
+  float poly_center[3];
+  BKE_mesh_calc_poly_center(poly, &mesh->mloop[poly->loopstart], mesh->mvert, poly_center);
+  for (int l = 0; l < poly->totloop; l++) {
+    const int loop_index = poly->loopstart + l;
+
+    float(*disps)[3] = mdisps[loop_index].disps;
+    mdisps[loop_index].totdisp = 4;
+    mdisps[loop_index].level = 1;
+
+    int prev_loop_index = l - 1 >= 0 ? loop_index - 1 : loop_index + poly->totloop - 1;
+    int next_loop_index = l + 1 < poly->totloop ? loop_index + 1 : poly->loopstart;
+
+    MLoop *loop = &mesh->mloop[loop_index];
+    MLoop *loop_next = &mesh->mloop[next_loop_index];
+    MLoop *loop_prev = &mesh->mloop[prev_loop_index];
+
+    copy_v3_v3(disps[0], poly_center);
+    mid_v3_v3v3(disps[1], mesh->mvert[loop->v].co, mesh->mvert[loop_next->v].co);
+    mid_v3_v3v3(disps[2], mesh->mvert[loop->v].co, mesh->mvert[loop_prev->v].co);
+    copy_v3_v3(disps[3], mesh->mvert[loop->v].co);
   }
 }
 
+static void multires_subdivide_create_object_space_linear_grids(Mesh *mesh)
+{
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  parallel_range_settings.min_iter_per_thread = 1024;
+
+  BLI_task_parallel_range(0,
+                          mesh->totpoly,
+                          mesh,
+                          multires_subdivide_create_object_space_linear_grids_task,
+                          &parallel_range_settings);
+}
+
 void multires_subdivide_create_tangent_displacement_linear_grids(Object *object,
                                                                  MultiresModifierData *mmd)
 {
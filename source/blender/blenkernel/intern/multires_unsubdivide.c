@@ -33,6 +33,7 @@
 
 #include "BLI_gsqueue.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -1181,6 +1182,35 @@ void multires_unsubdivide_context_free(MultiresUnsubdivideContext *context)
  * This function allocates new mdisps with the right size to fit the new extracted grids from the
  * base mesh and copies the data to them.
  */
+typedef struct CreateBaseMeshGridsData {
+  MultiresUnsubdivideContext *context;
+  MDisps *mdisps;
+  int totdisp;
+} CreateBaseMeshGridsData;
+
+static void multires_create_grids_in_unsubdivided_base_mesh_task(
+    void *__restrict userdata, const int i, const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CreateBaseMeshGridsData *data = userdata;
+  MDisps *mdisps = data->mdisps;
+  const int totdisp = data->totdisp;
+  const float(*grid_co)[3] = (const float(*)[3])data->context->base_mesh_grids[i].grid_co;
+
+  float(*disps)[3] = MEM_calloc_arrayN(totdisp, sizeof(float[3]), "multires disps");
+
+  if (mdisps[i].disps) {
+    MEM_freeN(mdisps[i].disps);
+  }
+
+  if (grid_co) {
+    memcpy(disps, grid_co, sizeof(float[3]) * totdisp);
+  }
+
+  mdisps[i].disps = disps;
+  mdisps[i].totdisp = totdisp;
+  mdisps[i].level = data->context->num_total_levels;
+}
+
 static void multires_create_grids_in_unsubdivided_base_mesh(MultiresUnsubdivideContext *context,
                                                             Mesh *base_mesh)
 {
@@ -1197,23 +1227,21 @@ static void multires_create_grids_in_unsubdivided_base_mesh(MultiresUnsubdivideC
   BLI_assert(base_mesh->totloop == context->num_grids);
 
   /* Allocate the MDISPS grids and copy the extracted data from context. */
-  for (int i = 0; i < totloop; i++) {
-    float(*disps)[3] = MEM_calloc_arrayN(totdisp, sizeof(float[3]), "multires disps");
+  CreateBaseMeshGridsData data = {
+      .context = context,
+      .mdisps = mdisps,
+      .totdisp = totdisp,
+  };
 
-    if (mdisps[i].disps) {
-      MEM_freeN(mdisps[i].disps);
-    }
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  parallel_range_settings.min_iter_per_thread = 64;
 
-    for (int j = 0; j < totdisp; j++) {
-      if (context->base_mesh_grids[i].grid_co) {
-        copy_v3_v3(disps[j], context->base_mesh_grids[i].grid_co[j]);
-      }
-    }
-
-    mdisps[i].disps = disps;
-    mdisps[i].totdisp = totdisp;
-    mdisps[i].level = context->num_total_levels;
-  }
+  BLI_task_parallel_range(0,
+                          totloop,
+                          &data,
+                          multires_create_grids_in_unsubdivided_base_mesh_task,
+                          &parallel_range_settings);
 }
 
 int multiresModifier_rebuild_subdiv(struct Depsgraph *depsgraph,
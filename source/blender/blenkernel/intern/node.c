@@ -4751,6 +4751,7 @@ static void registerGeometryNodes(void)
   register_node_type_geo_align_rotation_to_vector();
   register_node_type_geo_sample_texture();
   register_node_type_geo_points_to_volume();
+  register_node_type_geo_attribute_proximity();
 }
 
 static void registerFunctionNodes(void)
@@ -1216,6 +1216,7 @@ void BKE_object_free_modifiers(Object *ob, const int flag)
 
   /* modifiers may have stored data in the DM cache */
   BKE_object_free_derived_caches(ob);
+  BKE_object_modifier_stack_cache_free(ob);
 }
 
 void BKE_object_free_shaderfx(Object *ob, const int flag)
@@ -5057,6 +5058,7 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int UNUSED(flag))
   runtime->curve_cache = NULL;
   runtime->object_as_temp_mesh = NULL;
   runtime->geometry_set_eval = NULL;
+  runtime->modifier_stack_cache = NULL;
 }
 
 /**
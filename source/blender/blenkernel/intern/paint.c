@@ -41,6 +41,7 @@
 #include "BLI_hash.h"
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -1419,6 +1420,8 @@ static void sculptsession_free_pbvh(Object *object)
 
   MEM_SAFE_FREE(ss->pmap);
   MEM_SAFE_FREE(ss->pmap_mem);
+  MEM_SAFE_FREE(ss->vert_neighbors_offset);
+  MEM_SAFE_FREE(ss->vert_neighbors);
 
   MEM_SAFE_FREE(ss->persistent_base);
 
@@ -1469,6 +1472,8 @@ void BKE_sculptsession_free(Object *ob)
 
     MEM_SAFE_FREE(ss->pmap);
     MEM_SAFE_FREE(ss->pmap_mem);
+    MEM_SAFE_FREE(ss->vert_neighbors_offset);
+    MEM_SAFE_FREE(ss->vert_neighbors);
     if (ss->bm_log) {
       BM_log_free(ss->bm_log);
     }
@@ -1590,6 +1595,95 @@ static bool sculpt_modifiers_active(Scene *scene, Sculpt *sd, Object *ob)
 /**
  * \param need_mask: So that the evaluated mesh that is returned has mask data.
  */
+typedef struct SculptVertNeighborsData {
+  const Mesh *me;
+  const MeshElemMap *pmap;
+  const int *offset;
+  int *neighbors;
+  int *neighbors_len;
+} SculptVertNeighborsData;
+
+static void sculpt_vert_neighbors_fill_cb(void *__restrict userdata,
+                                          const int v,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SculptVertNeighborsData *data = userdata;
+  const Mesh *me = data->me;
+  const MeshElemMap *vert_map = &data->pmap[v];
+  int *neighbors = &data->neighbors[data->offset[v]];
+  int len = 0;
+
+  for (int i = 0; i < vert_map->count; i++) {
+    const MPoly *mp = &me->mpoly[vert_map->indices[i]];
+    uint f_adj_v[2];
+    if (poly_get_adj_loops_from_vert(mp, me->mloop, v, f_adj_v) == -1) {
+      continue;
+    }
+    for (int j = 0; j < ARRAY_SIZE(f_adj_v); j++) {
+      const int v_other = (int)f_adj_v[j];
+      if (v_other == v) {
+        continue;
+      }
+      bool is_new = true;
+      for (int k = 0; k < len; k++) {
+        if (neighbors[k] == v_other) {
+          is_new = false;
+          break;
+        }
+      }
+      if (is_new) {
+        neighbors[len++] = v_other;
+      }
+    }
+  }
+
+  data->neighbors_len[v] = len;
+}
+
+/* Store the neighbors of every vertex contiguously, in the same order as walking #pmap gives
+ * them, so neighbor iteration doesn't have to go through the faces of the vertex every time. */
+static void sculpt_vert_neighbors_create(SculptSession *ss, const Mesh *me)
+{
+  const int totvert = me->totvert;
+  int *offset = MEM_mallocN(sizeof(int) * (size_t)(totvert + 1), "vert_neighbors_offset");
+  int *neighbors_len = MEM_mallocN(sizeof(int) * (size_t)max_ii(totvert, 1), __func__);
+
+  /* Each face adds at most two neighbors, fill worst case ranges first and compact after. */
+  offset[0] = 0;
+  for (int v = 0; v < totvert; v++) {
+    offset[v + 1] = offset[v] + 2 * ss->pmap[v].count;
+  }
+  int *neighbors = MEM_mallocN(sizeof(int) * (size_t)max_ii(offset[totvert], 1),
+                               "vert_neighbors");
+
+  SculptVertNeighborsData data = {
+      .me = me,
+      .pmap = ss->pmap,
+      .offset = offset,
+      .neighbors = neighbors,
+      .neighbors_len = neighbors_len,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, totvert, &data, sculpt_vert_neighbors_fill_cb, &settings);
+
+  int len_total = 0;
+  for (int v = 0; v < totvert; v++) {
+    const int start = offset[v];
+    offset[v] = len_total;
+    memmove(&neighbors[len_total], &neighbors[start], sizeof(int) * (size_t)neighbors_len[v]);
+    len_total += neighbors_len[v];
+  }
+  offset[totvert] = len_total;
+
+  MEM_freeN(neighbors_len);
+
+  ss->vert_neighbors_offset = offset;
+  ss->vert_neighbors = MEM_reallocN(neighbors, sizeof(int) * (size_t)max_ii(len_total, 1));
+}
+
 static void sculpt_update_object(Depsgraph *depsgraph,
                                  Object *ob,
                                  Mesh *me_eval,
@@ -1678,6 +1772,11 @@ static void sculpt_update_object(Depsgraph *depsgraph,
   if (need_pmap && ob->type == OB_MESH && !ss->pmap) {
     BKE_mesh_vert_poly_map_create(
         &ss->pmap, &ss->pmap_mem, me->mpoly, me->mloop, me->totvert, me->totpoly, me->totloop);
+    MEM_SAFE_FREE(ss->vert_neighbors_offset);
+    MEM_SAFE_FREE(ss->vert_neighbors);
+    if (BKE_pbvh_type(ss->pbvh) == PBVH_FACES) {
+      sculpt_vert_neighbors_create(ss, me);
+    }
   }
 
   pbvh_show_mask_set(ss->pbvh, ss->show_mask);
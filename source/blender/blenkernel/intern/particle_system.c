@@ -3751,6 +3751,40 @@ static void dynamics_step_sph_ddr_task_cb_ex(void *__restrict userdata,
   }
 }
 
+/* Whether any of the effectors draws random numbers from its shared generator. */
+static bool psys_effectors_use_noise(ListBase *effectors)
+{
+  if (effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, effectors) {
+      if (eff->pd && eff->pd->f_noise > 0.0f) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static void dynamics_step_newton_task_cb_ex(void *__restrict userdata,
+                                           const int p,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DynamicStepSolverTaskData *data = userdata;
+  ParticleSimulationData *sim = data->sim;
+  ParticleSystem *psys = sim->psys;
+
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra);
+
+  /* rotations */
+  basic_rotate(psys->part, pa, pa->state.time, data->timestep);
+}
+
 static void dynamics_step_sph_classical_basic_integrate_task_cb_ex(
     void *__restrict userdata, const int p, const TaskParallelTLS *__restrict UNUSED(tls))
 {
@@ -3946,6 +3980,25 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
+      /* Brownian motion, collisions and effector noise draw from shared random generators,
+       * keep those serial so results don't depend on thread scheduling. */
+      if (part->brownfac == 0.0f && sim->colliders == NULL &&
+          !psys_effectors_use_noise(psys->effectors)) {
+        DynamicStepSolverTaskData task_data = {
+            .sim = sim,
+            .cfra = cfra,
+            .timestep = timestep,
+            .dtime = dtime,
+        };
+
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.use_threading = (psys->totpart > 100);
+        BLI_task_parallel_range(
+            0, psys->totpart, &task_data, dynamics_step_newton_task_cb_ex, &settings);
+        break;
+      }
+
       LOOP_DYNAMIC_PARTICLES
       {
         /* do global forces & effectors */
@@ -250,44 +250,21 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
   pbvh->totnode = totnode;
 }
 
-/* Add a vertex to the map, with a positive value for unique vertices and
- * a negative value for additional vertices */
-static int map_insert_vert(
-    PBVH *pbvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
-{
-  void *key, **value_p;
-
-  key = POINTER_FROM_INT(vertex);
-  if (!BLI_ghash_ensure_p(map, key, &value_p)) {
-    int value_i;
-    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
-      value_i = *uniq_verts;
-      (*uniq_verts)++;
-    }
-    else {
-      value_i = ~(*face_verts);
-      (*face_verts)++;
-    }
-    *value_p = POINTER_FROM_INT(value_i);
-    return value_i;
-  }
-
-  return POINTER_AS_INT(*value_p);
-}
-
-/* Find vertices used by the faces in this node and update the draw buffers */
+/* Find vertices used by the faces in this node. The vertices are stored in #vert_indices in
+ * the order they are first used, and #face_vert_indices refer to that local order until
+ * #build_mesh_leaf_node_finish remaps them. Only touches the node, so it can run in parallel. */
 static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
 {
   bool has_visible = false;
 
-  node->uniq_verts = node->face_verts = 0;
   const int totface = node->totprim;
 
   /* reserve size is rough guess */
   GHash *map = BLI_ghash_int_new_ex("build_mesh_leaf_node gh", 2 * totface);
 
   int(*face_vert_indices)[3] = MEM_mallocN(sizeof(int[3]) * totface, "bvh node face vert indices");
+  int *vert_indices = MEM_mallocN(sizeof(int) * 3 * totface, "bvh node vert indices");
+  int totvert = 0;
 
   node->face_vert_indices = (const int(*)[3])face_vert_indices;
 
@@ -298,8 +275,13 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+      const int vertex = (int)pbvh->mloop[lt->tri[j]].v;
+      void **value_p;
+      if (!BLI_ghash_ensure_p(map, POINTER_FROM_INT(vertex), &value_p)) {
+        *value_p = POINTER_FROM_INT(totvert);
+        vert_indices[totvert++] = vertex;
+      }
+      face_vert_indices[i][j] = POINTER_AS_INT(*value_p);
     }
 
     if (has_visible == false) {
@@ -309,38 +291,69 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
     }
   }
 
-  int *vert_indices = MEM_callocN(sizeof(int) * (node->uniq_verts + node->face_verts),
-                                  "bvh node vert indices");
-  node->vert_indices = vert_indices;
+  node->vert_indices = MEM_reallocN(vert_indices, sizeof(int) * max_ii(totvert, 1));
+  node->uniq_verts = totvert;
+  node->face_verts = 0;
 
-  /* Build the vertex list, unique verts first */
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, map) {
-    void *value = BLI_ghashIterator_getValue(&gh_iter);
-    int ndx = POINTER_AS_INT(value);
+  BKE_pbvh_node_mark_rebuild_draw(node);
 
-    if (ndx < 0) {
-      ndx = -ndx + node->uniq_verts - 1;
-    }
+  BKE_pbvh_node_fully_hidden_set(node, !has_visible);
 
-    vert_indices[ndx] = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
-  }
+  BLI_ghash_free(map, NULL, NULL);
+}
 
-  for (int i = 0; i < totface; i++) {
-    const int sides = 3;
+/* A vertex is unique to the first node using it, in depth-first order of the leaves. This is the
+ * only part of building mesh leaves which depends on other nodes, so it runs single threaded.
+ * Vertices owned by another node are tagged by storing their index bitwise negated. */
+static void build_mesh_leaf_node_ownership(PBVH *pbvh, PBVHNode *node)
+{
+  int *vert_indices = (int *)node->vert_indices;
+  const int totvert = (int)node->uniq_verts;
+  int uniq_verts = 0;
 
-    for (int j = 0; j < sides; j++) {
-      if (face_vert_indices[i][j] < 0) {
-        face_vert_indices[i][j] = -face_vert_indices[i][j] + node->uniq_verts - 1;
-      }
+  for (int i = 0; i < totvert; i++) {
+    const int vertex = vert_indices[i];
+    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
+      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
+      uniq_verts++;
+    }
+    else {
+      vert_indices[i] = ~vertex;
     }
   }
 
-  BKE_pbvh_node_mark_rebuild_draw(node);
+  node->uniq_verts = uniq_verts;
+  node->face_verts = totvert - uniq_verts;
+}
 
-  BKE_pbvh_node_fully_hidden_set(node, !has_visible);
+/* Build the vertex list, unique verts first. */
+static void build_mesh_leaf_node_finish(PBVHNode *node)
+{
+  const int totvert = (int)(node->uniq_verts + node->face_verts);
+  int *local_vert_indices = (int *)node->vert_indices;
+  int *local_to_node = MEM_mallocN(sizeof(int) * max_ii(totvert, 1), __func__);
+  int *vert_indices = MEM_mallocN(sizeof(int) * max_ii(totvert, 1), "bvh node vert indices");
+  int uniq_index = 0;
+  int face_index = (int)node->uniq_verts;
 
-  BLI_ghash_free(map, NULL, NULL);
+  for (int i = 0; i < totvert; i++) {
+    const int vertex = local_vert_indices[i];
+    const int ndx = (vertex >= 0) ? uniq_index++ : face_index++;
+    vert_indices[ndx] = (vertex >= 0) ? vertex : ~vertex;
+    local_to_node[i] = ndx;
+  }
+
+  int(*face_vert_indices)[3] = (int(*)[3])node->face_vert_indices;
+  for (int i = 0; i < node->totprim; i++) {
+    for (int j = 0; j < 3; j++) {
+      face_vert_indices[i][j] = local_to_node[face_vert_indices[i][j]];
+    }
+  }
+
+  node->vert_indices = vert_indices;
+
+  MEM_freeN(local_vert_indices);
+  MEM_freeN(local_to_node);
 }
 
 static void update_vb(PBVH *pbvh, PBVHNode *node, BBC *prim_bbc, int offset, int count)
@@ -423,12 +436,7 @@ static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, in
   /* Still need vb for searches */
   update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
 
-  if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
-  else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
+  /* The vertex data of the leaf is built in #pbvh_build_leaves, once all nodes exist. */
 }
 
 /* Return zero if all primitives in the node can be drawn with the
@@ -531,6 +539,74 @@ static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int off
             offset + count - end);
 }
 
+/* Gather the leaves below \a node_index in depth-first order. */
+static void pbvh_gather_leaves(PBVH *pbvh, int node_index, PBVHNode **leaves, int *r_totleaf)
+{
+  PBVHNode *node = &pbvh->nodes[node_index];
+  if (node->flag & PBVH_Leaf) {
+    leaves[(*r_totleaf)++] = node;
+    return;
+  }
+  pbvh_gather_leaves(pbvh, node->children_offset, leaves, r_totleaf);
+  pbvh_gather_leaves(pbvh, node->children_offset + 1, leaves, r_totleaf);
+}
+
+typedef struct PBVHBuildLeafData {
+  PBVH *pbvh;
+  PBVHNode **leaves;
+} PBVHBuildLeafData;
+
+static void pbvh_build_leaf_task_cb(void *__restrict userdata,
+                                    const int n,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeafData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  PBVHNode *node = data->leaves[n];
+
+  if (pbvh->looptri) {
+    build_mesh_leaf_node(pbvh, node);
+  }
+  else {
+    build_grid_leaf_node(pbvh, node);
+  }
+}
+
+static void pbvh_build_leaf_finish_task_cb(void *__restrict userdata,
+                                           const int n,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeafData *data = userdata;
+  build_mesh_leaf_node_finish(data->leaves[n]);
+}
+
+/* Build the per-leaf data once the tree is partitioned. Leaves are independent except for the
+ * ownership of the vertices they share, which is resolved in a cheap serial pass in between. */
+static void pbvh_build_leaves(PBVH *pbvh)
+{
+  PBVHNode **leaves = MEM_mallocN(sizeof(*leaves) * pbvh->totnode, __func__);
+  int totleaf = 0;
+  pbvh_gather_leaves(pbvh, 0, leaves, &totleaf);
+
+  PBVHBuildLeafData data = {
+      .pbvh = pbvh,
+      .leaves = leaves,
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totleaf);
+  BLI_task_parallel_range(0, totleaf, &data, pbvh_build_leaf_task_cb, &settings);
+
+  if (pbvh->looptri) {
+    for (int i = 0; i < totleaf; i++) {
+      build_mesh_leaf_node_ownership(pbvh, leaves[i]);
+    }
+    BLI_task_parallel_range(0, totleaf, &data, pbvh_build_leaf_finish_task_cb, &settings);
+  }
+
+  MEM_freeN(leaves);
+}
+
 static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 {
   if (totprim != pbvh->totprim) {
@@ -554,6 +630,7 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 
   pbvh->totnode = 1;
   build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+  pbvh_build_leaves(pbvh);
 }
 
 /**
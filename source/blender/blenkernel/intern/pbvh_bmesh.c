@@ -1458,8 +1458,11 @@ static bool pbvh_bmesh_collapse_short_edges(EdgeQueueContext *eq_ctx,
 {
   const float min_len_squared = pbvh->bm_min_edge_len * pbvh->bm_min_edge_len;
   bool any_collapsed = false;
-  /* deleted verts point to vertices they were merged into, or NULL when removed. */
-  GHash *deleted_verts = BLI_ghash_ptr_new("deleted_verts");
+  /* deleted verts point to vertices they were merged into, or NULL when removed.
+   * Every collapse removes at least one vertex, reserve for the queued edges up-front
+   * so large strokes don't keep growing the hash while collapsing. */
+  GHash *deleted_verts = BLI_ghash_ptr_new_ex("deleted_verts",
+                                              BLI_heapsimple_len(eq_ctx->q->heap));
 
   while (!BLI_heapsimple_is_empty(eq_ctx->q->heap)) {
     BMVert **pair = BLI_heapsimple_pop_min(eq_ctx->q->heap);
@@ -1641,32 +1641,6 @@ static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot,
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
-static int ptcache_file_data_read(PTCacheFile *pf)
-{
-  int i;
-
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_read(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
-    }
-  }
-
-  return 1;
-}
-static int ptcache_file_data_write(PTCacheFile *pf)
-{
-  int i;
-
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_write(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
-    }
-  }
-
-  return 1;
-}
 static int ptcache_file_header_begin_read(PTCacheFile *pf)
 {
   unsigned int typeflag = 0;
@@ -1845,6 +1819,55 @@ static void ptcache_data_copy(void *from[], void *to[])
   }
 }
 
+/* Size of a single point in uncompressed cache files, which store all data of a point together. */
+static unsigned int ptcache_file_point_size(unsigned int data_types)
+{
+  unsigned int point_size = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (data_types & (1 << i)) {
+      point_size += ptcache_data_size[i];
+    }
+  }
+  return point_size;
+}
+static void ptcache_file_points_deinterleave(PTCacheMem *pm,
+                                             unsigned int data_types,
+                                             const char *buffer)
+{
+  for (unsigned int p = 0; p < pm->totpoint; p++) {
+    for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+      if (data_types & (1 << i)) {
+        if (pm->data[i]) {
+          memcpy((char *)pm->data[i] + (size_t)p * ptcache_data_size[i],
+                 buffer,
+                 ptcache_data_size[i]);
+        }
+        buffer += ptcache_data_size[i];
+      }
+    }
+  }
+}
+static void ptcache_file_points_interleave(const PTCacheMem *pm,
+                                           unsigned int data_types,
+                                           char *buffer)
+{
+  for (unsigned int p = 0; p < pm->totpoint; p++) {
+    for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+      if (data_types & (1 << i)) {
+        if (pm->data[i]) {
+          memcpy(buffer,
+                 (const char *)pm->data[i] + (size_t)p * ptcache_data_size[i],
+                 ptcache_data_size[i]);
+        }
+        else {
+          memset(buffer, 0, ptcache_data_size[i]);
+        }
+        buffer += ptcache_data_size[i];
+      }
+    }
+  }
+}
+
 static void ptcache_extra_free(PTCacheMem *pm)
 {
   PTCacheExtra *extra = pm->extradata.first;
@@ -1974,19 +1997,20 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        if (!ptcache_file_data_read(pf)) {
-          error = 1;
-          break;
-        }
-        ptcache_data_copy(pf->cur, cur);
-        BKE_ptcache_mem_pointers_incr(cur);
+    else if (pm->totpoint) {
+      /* Points are stored interleaved, read the whole frame at once instead of
+       * doing a read for every element of every point. */
+      const unsigned int point_size = ptcache_file_point_size(pf->data_types);
+      char *buffer = MEM_mallocN((size_t)point_size * pm->totpoint, "ptcache read buffer");
+
+      if (ptcache_file_read(pf, buffer, pm->totpoint, point_size)) {
+        ptcache_file_points_deinterleave(pm, pf->data_types, buffer);
+      }
+      else {
+        error = 1;
       }
+
+      MEM_freeN(buffer);
     }
   }
 
@@ -2076,19 +2100,16 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        ptcache_data_copy(cur, pf->cur);
-        if (!ptcache_file_data_write(pf)) {
-          error = 1;
-          break;
-        }
-        BKE_ptcache_mem_pointers_incr(cur);
+    else if (pm->totpoint) {
+      const unsigned int point_size = ptcache_file_point_size(pf->data_types);
+      char *buffer = MEM_mallocN((size_t)point_size * pm->totpoint, "ptcache write buffer");
+
+      ptcache_file_points_interleave(pm, pf->data_types, buffer);
+      if (!ptcache_file_write(pf, buffer, pm->totpoint, point_size)) {
+        error = 1;
       }
+
+      MEM_freeN(buffer);
     }
   }
 
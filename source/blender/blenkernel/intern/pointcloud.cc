@@ -29,6 +29,7 @@
 #include "BLI_math.h"
 #include "BLI_rand.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_anim_data.h"
@@ -259,18 +260,44 @@ PointCloud *BKE_pointcloud_new_nomain(const int totpoint)
   return pointcloud;
 }
 
+struct MinMaxResult {
+  blender::float3 min;
+  blender::float3 max;
+};
+
+static MinMaxResult min_max_reduce(const MinMaxResult &a, const MinMaxResult &b)
+{
+  MinMaxResult result = a;
+  DO_MIN(b.min, result.min);
+  DO_MAX(b.max, result.max);
+  return result;
+}
+
 void BKE_pointcloud_minmax(const struct PointCloud *pointcloud, float r_min[3], float r_max[3])
 {
-  float(*pointcloud_co)[3] = pointcloud->co;
-  float *pointcloud_radius = pointcloud->radius;
-  for (int a = 0; a < pointcloud->totpoint; a++) {
-    float *co = pointcloud_co[a];
-    float radius = (pointcloud_radius) ? pointcloud_radius[a] : 0.0f;
-    const float co_min[3] = {co[0] - radius, co[1] - radius, co[2] - radius};
-    const float co_max[3] = {co[0] + radius, co[1] + radius, co[2] + radius};
-    DO_MIN(co_min, r_min);
-    DO_MAX(co_max, r_max);
-  }
+  using namespace blender;
+  const Span<float3> positions{(const float3 *)pointcloud->co, pointcloud->totpoint};
+  const float *radii = pointcloud->radius;
+
+  const MinMaxResult min_max = parallel_reduce(
+      positions.index_range(),
+      1024,
+      MinMaxResult{float3(r_min), float3(r_max)},
+      [&](IndexRange range, const MinMaxResult &init) {
+        MinMaxResult result = init;
+        for (const int i : range) {
+          const float3 radius = float3(radii ? radii[i] : 0.0f);
+          const float3 co_min = positions[i] - radius;
+          const float3 co_max = positions[i] + radius;
+          DO_MIN(co_min, result.min);
+          DO_MAX(co_max, result.max);
+        }
+        return result;
+      },
+      min_max_reduce);
+
+  copy_v3_v3(r_min, min_max.min);
+  copy_v3_v3(r_max, min_max.max);
 }
 
 BoundBox *BKE_pointcloud_boundbox_get(Object *ob)
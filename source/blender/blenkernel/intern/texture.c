@@ -32,6 +32,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_math_color.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -780,3 +781,56 @@ void BKE_texture_fetch_images_for_pool(Tex *texture, struct ImagePool *pool)
     }
   }
 }
+
+typedef struct TextureGetValuesData {
+  const Scene *scene;
+  Tex *texture;
+  const float (*tex_co)[3];
+  TexResult *r_texres;
+  struct ImagePool *pool;
+  bool use_color_management;
+} TextureGetValuesData;
+
+static void texture_get_values_fn(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const TextureGetValuesData *data = userdata;
+  TexResult *texres = &data->r_texres[i];
+  memset(texres, 0, sizeof(*texres));
+  BKE_texture_get_value_ex(
+      data->scene, data->texture, data->tex_co[i], texres, data->pool, data->use_color_management);
+}
+
+/**
+ * Evaluate the texture for an array of coordinates, in parallel when possible.
+ * Prefer this over calling #BKE_texture_get_value for every element.
+ */
+void BKE_texture_get_values(const Scene *scene,
+                            Tex *texture,
+                            const float (*tex_co)[3],
+                            const int tex_co_len,
+                            TexResult *r_texres,
+                            bool use_color_management)
+{
+  TextureGetValuesData data = {
+      .scene = scene,
+      .texture = texture,
+      .tex_co = tex_co,
+      .r_texres = r_texres,
+      .pool = BKE_image_pool_new(),
+      .use_color_management = use_color_management,
+  };
+  /* Load the images once, so they are not acquired from the threads. */
+  BKE_texture_fetch_images_for_pool(texture, data.pool);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 256;
+  /* The execution data of texture nodes is shared by all callers using the same thread index. */
+  settings.use_threading = (tex_co_len > 512) &&
+                           !(texture->use_nodes && (texture->nodetree != NULL));
+  BLI_task_parallel_range(0, tex_co_len, &data, texture_get_values_fn, &settings);
+
+  BKE_image_pool_free(data.pool);
+}
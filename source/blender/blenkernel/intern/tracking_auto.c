@@ -662,6 +662,15 @@ bool BKE_autotrack_context_step(AutoTrackContext *context)
     return false;
   }
 
+  /* Load the frames the markers are tracked to once, rather than every track going through the
+   * movie clip cache for them. */
+  const int frame_delta = context->is_backwards ? -1 : 1;
+  for (int i = 0; i < context->num_autotrack_markers; i++) {
+    const libmv_Marker *libmv_marker = &context->autotrack_markers[i].libmv_marker;
+    tracking_image_accessor_prefetch_frame(
+        context->image_accessor, libmv_marker->clip, libmv_marker->frame + frame_delta);
+  }
+
   AutoTrackTLS tls;
   BLI_listbase_clear(&tls.results);
 
@@ -615,6 +615,70 @@ MovieTrackingMarker *tracking_get_keyframed_marker(MovieTrackingTrack *track,
 
 /*********************** Frame accessr *************************/
 
+/* Get a new reference to the frame when it's kept by the accessor. */
+static ImBuf *accessor_frame_cache_lookup(TrackingImageAccessor *accessor,
+                                          int clip_index,
+                                          int frame)
+{
+  ImBuf *ibuf = NULL;
+
+  BLI_spin_lock(&accessor->cache_lock);
+  for (int i = 0; i < ACCESSOR_FRAME_CACHE_SIZE; i++) {
+    TrackingImageAccessorFrame *cached_frame = &accessor->frames[i];
+    if (cached_frame->ibuf != NULL && cached_frame->clip_index == clip_index &&
+        cached_frame->frame == frame) {
+      cached_frame->last_used = ++accessor->frames_access_counter;
+      ibuf = cached_frame->ibuf;
+      IMB_refImBuf(ibuf);
+      break;
+    }
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+
+  return ibuf;
+}
+
+/* Keep the frame in the accessor, replacing the least recently used one. */
+static void accessor_frame_cache_insert(TrackingImageAccessor *accessor,
+                                        int clip_index,
+                                        int frame,
+                                        ImBuf *ibuf)
+{
+  ImBuf *ibuf_free = NULL;
+
+  BLI_spin_lock(&accessor->cache_lock);
+  TrackingImageAccessorFrame *slot = &accessor->frames[0];
+  for (int i = 0; i < ACCESSOR_FRAME_CACHE_SIZE; i++) {
+    TrackingImageAccessorFrame *cached_frame = &accessor->frames[i];
+    if (cached_frame->ibuf != NULL && cached_frame->clip_index == clip_index &&
+        cached_frame->frame == frame) {
+      /* Another thread got the frame meanwhile. */
+      slot = NULL;
+      break;
+    }
+    if (cached_frame->ibuf == NULL || cached_frame->last_used < slot->last_used) {
+      slot = cached_frame;
+      if (cached_frame->ibuf == NULL) {
+        break;
+      }
+    }
+  }
+  if (slot != NULL) {
+    ibuf_free = slot->ibuf;
+    slot->clip_index = clip_index;
+    slot->frame = frame;
+    slot->ibuf = ibuf;
+    slot->last_used = ++accessor->frames_access_counter;
+    IMB_refImBuf(ibuf);
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+
+  /* Don't free the frame while holding the lock. */
+  if (ibuf_free != NULL) {
+    IMB_freeImBuf(ibuf_free);
+  }
+}
+
 static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
                                              int clip_index,
                                              int frame)
@@ -626,6 +690,11 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
 
   BLI_assert(clip_index < accessor->num_clips);
 
+  ibuf = accessor_frame_cache_lookup(accessor, clip_index, frame);
+  if (ibuf != NULL) {
+    return ibuf;
+  }
+
   clip = accessor->clips[clip_index];
   scene_frame = BKE_movieclip_remap_clip_to_scene_frame(clip, frame);
   BKE_movieclip_user_set_frame(&user, scene_frame);
@@ -633,6 +702,10 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
   user.render_flag = 0;
   ibuf = BKE_movieclip_get_ibuf(clip, &user);
 
+  if (ibuf != NULL) {
+    accessor_frame_cache_insert(accessor, clip_index, frame, ibuf);
+  }
+
   return ibuf;
 }
 
@@ -932,7 +1005,22 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor)
 {
   libmv_FrameAccessorDestroy(accessor->libmv_accessor);
+  for (int i = 0; i < ACCESSOR_FRAME_CACHE_SIZE; i++) {
+    if (accessor->frames[i].ibuf != NULL) {
+      IMB_freeImBuf(accessor->frames[i].ibuf);
+    }
+  }
   BLI_spin_end(&accessor->cache_lock);
   MEM_freeN(accessor->tracks);
   MEM_freeN(accessor);
 }
+
+void tracking_image_accessor_prefetch_frame(TrackingImageAccessor *accessor,
+                                            int clip_index,
+                                            int frame)
+{
+  ImBuf *ibuf = accessor_get_preprocessed_ibuf(accessor, clip_index, frame);
+  if (ibuf != NULL) {
+    IMB_freeImBuf(ibuf);
+  }
+}
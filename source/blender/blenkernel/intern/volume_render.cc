@@ -85,6 +85,107 @@ static void extract_dense_float_voxels(const VolumeGridType grid_type,
   }
 }
 
+template<typename GridType, typename VoxelType>
+static void extract_dense_voxel_blocks(const openvdb::GridBase &grid_base,
+                                       const openvdb::CoordBBox &bbox,
+                                       VoxelType *r_background,
+                                       BKE_volume_voxel_block_cb cb,
+                                       void *cb_userdata)
+{
+  BLI_assert(grid_base.isType<GridType>());
+  using TreeType = typename GridType::TreeType;
+  using DenseType = openvdb::tools::Dense<VoxelType, openvdb::tools::LayoutXYZ>;
+
+  const TreeType &tree = static_cast<const GridType &>(grid_base).tree();
+  const typename TreeType::ValueType background = tree.background();
+  *r_background = VoxelType(background);
+
+  blender::Vector<VoxelType> voxels;
+  auto block_call = [&](const openvdb::CoordBBox &block) {
+    const openvdb::Coord offset = block.min() - bbox.min();
+    const openvdb::Coord size = block.dim();
+    cb(cb_userdata,
+       reinterpret_cast<const float *>(voxels.data()),
+       offset.asPointer(),
+       size.asPointer());
+  };
+
+  /* Leaf nodes, copied including their inactive voxels like #copyToDense does. */
+  for (typename TreeType::LeafCIter iter = tree.cbeginLeaf(); iter; ++iter) {
+    openvdb::CoordBBox block = iter->getNodeBoundingBox();
+    block.intersect(bbox);
+    if (block.empty()) {
+      continue;
+    }
+    voxels.resize(static_cast<int64_t>(block.volume()));
+    DenseType dense(block, voxels.data());
+    iter->copyToDense(block, dense);
+    block_call(block);
+  }
+
+  /* Tiles of the internal nodes, only those that differ from the background. */
+  typename TreeType::ValueAllCIter iter = tree.cbeginValueAll();
+  iter.setMaxDepth(TreeType::ValueAllCIter::LEAF_DEPTH - 1);
+  for (; iter; ++iter) {
+    if (openvdb::math::isExactlyEqual(*iter, background)) {
+      continue;
+    }
+    openvdb::CoordBBox block;
+    iter.getBoundingBox(block);
+    block.intersect(bbox);
+    if (block.empty()) {
+      continue;
+    }
+    voxels.clear();
+    voxels.resize(static_cast<int64_t>(block.volume()), VoxelType(*iter));
+    block_call(block);
+  }
+}
+
+static void extract_dense_float_voxel_blocks(const VolumeGridType grid_type,
+                                             const openvdb::GridBase &grid,
+                                             const openvdb::CoordBBox &bbox,
+                                             float *r_background,
+                                             BKE_volume_voxel_block_cb cb,
+                                             void *cb_userdata)
+{
+  openvdb::Vec3f *r_vector_background = reinterpret_cast<openvdb::Vec3f *>(r_background);
+  switch (grid_type) {
+    case VOLUME_GRID_BOOLEAN:
+      return extract_dense_voxel_blocks<openvdb::BoolGrid, float>(
+          grid, bbox, r_background, cb, cb_userdata);
+    case VOLUME_GRID_FLOAT:
+      return extract_dense_voxel_blocks<openvdb::FloatGrid, float>(
+          grid, bbox, r_background, cb, cb_userdata);
+    case VOLUME_GRID_DOUBLE:
+      return extract_dense_voxel_blocks<openvdb::DoubleGrid, float>(
+          grid, bbox, r_background, cb, cb_userdata);
+    case VOLUME_GRID_INT:
+      return extract_dense_voxel_blocks<openvdb::Int32Grid, float>(
+          grid, bbox, r_background, cb, cb_userdata);
+    case VOLUME_GRID_INT64:
+      return extract_dense_voxel_blocks<openvdb::Int64Grid, float>(
+          grid, bbox, r_background, cb, cb_userdata);
+    case VOLUME_GRID_MASK:
+      return extract_dense_voxel_blocks<openvdb::MaskGrid, float>(
+          grid, bbox, r_background, cb, cb_userdata);
+    case VOLUME_GRID_VECTOR_FLOAT:
+      return extract_dense_voxel_blocks<openvdb::Vec3fGrid, openvdb::Vec3f>(
+          grid, bbox, r_vector_background, cb, cb_userdata);
+    case VOLUME_GRID_VECTOR_DOUBLE:
+      return extract_dense_voxel_blocks<openvdb::Vec3dGrid, openvdb::Vec3f>(
+          grid, bbox, r_vector_background, cb, cb_userdata);
+    case VOLUME_GRID_VECTOR_INT:
+      return extract_dense_voxel_blocks<openvdb::Vec3IGrid, openvdb::Vec3f>(
+          grid, bbox, r_vector_background, cb, cb_userdata);
+    case VOLUME_GRID_STRING:
+    case VOLUME_GRID_POINTS:
+    case VOLUME_GRID_UNKNOWN:
+      /* Zero channels to copy. */
+      break;
+  }
+}
+
 static void create_texture_to_object_matrix(const openvdb::Mat4d &grid_transform,
                                             const openvdb::CoordBBox &bbox,
                                             float r_texture_to_object[4][4])
@@ -141,6 +242,38 @@ bool BKE_volume_grid_dense_floats(const Volume *volume,
   return false;
 }
 
+bool BKE_volume_grid_dense_float_blocks(const Volume *volume,
+                                        VolumeGrid *volume_grid,
+                                        DenseFloatVolumeGrid *r_dense_grid,
+                                        float r_background[3],
+                                        BKE_volume_voxel_block_cb cb,
+                                        void *cb_userdata)
+{
+#ifdef WITH_OPENVDB
+  const VolumeGridType grid_type = BKE_volume_grid_type(volume_grid);
+  openvdb::GridBase::ConstPtr grid = BKE_volume_grid_openvdb_for_read(volume, volume_grid);
+
+  const openvdb::CoordBBox bbox = grid->evalActiveVoxelBoundingBox();
+  if (bbox.empty()) {
+    return false;
+  }
+
+  create_texture_to_object_matrix(grid->transform().baseMap()->getAffineMap()->getMat4(),
+                                  bbox,
+                                  r_dense_grid->texture_to_object);
+
+  r_dense_grid->voxels = nullptr;
+  r_dense_grid->channels = BKE_volume_grid_channels(volume_grid);
+  copy_v3_v3_int(r_dense_grid->resolution, bbox.dim().asVec3i().asV());
+
+  zero_v3(r_background);
+  extract_dense_float_voxel_blocks(grid_type, *grid, bbox, r_background, cb, cb_userdata);
+  return true;
+#endif
+  UNUSED_VARS(volume, volume_grid, r_dense_grid, r_background, cb, cb_userdata);
+  return false;
+}
+
 void BKE_volume_dense_float_grid_clear(DenseFloatVolumeGrid *dense_grid)
 {
   if (dense_grid->voxels != nullptr) {
@@ -127,9 +127,26 @@ float *tracking_track_get_mask_for_region(int frame_width,
 
 /*********************** Frame accessr *************************/
 
+struct ImBuf;
 struct libmv_FrameAccessor;
 
 #define MAX_ACCESSOR_CLIP 64
+
+/* Number of full frames kept by the accessor, enough for the frames tracked from and to by all
+ * tracks of a step, with some room for the keyframes of tracks matching against them. */
+#define ACCESSOR_FRAME_CACHE_SIZE 8
+
+/* Frame of a clip kept by the accessor, so that tracks don't all go through the movie clip cache
+ * to get the same frame. */
+typedef struct TrackingImageAccessorFrame {
+  int clip_index;
+  int frame;
+  /* Reference owned by the accessor, NULL for an unused slot. */
+  struct ImBuf *ibuf;
+  /* Value of the accessor's access counter at the last use of the frame. */
+  uint64_t last_used;
+} TrackingImageAccessorFrame;
+
 typedef struct TrackingImageAccessor {
   struct MovieClip *clips[MAX_ACCESSOR_CLIP];
   int num_clips;
@@ -141,6 +158,10 @@ typedef struct TrackingImageAccessor {
   int num_tracks;
 
   struct libmv_FrameAccessor *libmv_accessor;
+
+  /* Frames used by the latest requests, protected by the cache lock. */
+  TrackingImageAccessorFrame frames[ACCESSOR_FRAME_CACHE_SIZE];
+  uint64_t frames_access_counter;
   SpinLock cache_lock;
 } TrackingImageAccessor;
 
@@ -155,6 +176,12 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
                                                    int num_tracks);
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor);
 
+/* Load the given frame of a clip into the accessor ahead of the requests for it.
+ * Is meant to be called before multiple tracks are tracked to the frame in parallel. */
+void tracking_image_accessor_prefetch_frame(TrackingImageAccessor *accessor,
+                                            int clip_index,
+                                            int frame);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,149 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::CompressedIndexMask` contains the same kind of sorted and unique indices as an
+ * IndexMask, but stores them as a list of ranges of consecutive indices. Selections often consist
+ * of a few long ranges, in which case this needs much less memory than an index array.
+ *
+ * Contrary to IndexMask, this class owns its data. Union, intersection and difference of two
+ * masks are computed on the ranges directly, so their cost does not depend on the number of
+ * indices. Use `foreach_range` to process the indices with a dense loop per range, or
+ * `to_index_mask` to pass the indices to functions that expect an IndexMask.
+ */
+
+#include "BLI_index_mask.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+class CompressedIndexMask {
+ private:
+  /** Sorted ranges that are not empty and neither overlap nor touch each other. */
+  Vector<IndexRange> ranges_;
+  /**
+   * The number of indices in all ranges before the range at the same position. There is one more
+   * element than there are ranges, so the last element is the total number of indices.
+   */
+  Vector<int64_t> offsets_ = {0};
+
+ public:
+  /** Creates a mask that contains no indices. */
+  CompressedIndexMask() = default;
+
+  CompressedIndexMask(IndexRange range);
+
+  /** Compress the indices referenced by the given mask. */
+  explicit CompressedIndexMask(IndexMask mask);
+
+  /**
+   * Create a mask from ranges that are sorted by their start. Ranges may be empty, overlap or
+   * touch each other, they are merged as necessary.
+   */
+  static CompressedIndexMask from_ranges(Span<IndexRange> ranges);
+
+  /** Indices that are in at least one of the masks. */
+  static CompressedIndexMask from_union(const CompressedIndexMask &a,
+                                        const CompressedIndexMask &b);
+  /** Indices that are in both masks. */
+  static CompressedIndexMask from_intersection(const CompressedIndexMask &a,
+                                               const CompressedIndexMask &b);
+  /** Indices that are in \a a but not in \a b. */
+  static CompressedIndexMask from_difference(const CompressedIndexMask &a,
+                                             const CompressedIndexMask &b);
+
+  /** Returns the number of indices in the mask. */
+  int64_t size() const
+  {
+    return offsets_.last();
+  }
+
+  bool is_empty() const
+  {
+    return ranges_.is_empty();
+  }
+
+  /** Returns true when the mask consists of a single range. */
+  bool is_range() const
+  {
+    return ranges_.size() == 1;
+  }
+
+  Span<IndexRange> ranges() const
+  {
+    return ranges_;
+  }
+
+  /**
+   * Returns the minimum size an array has to have, if the indices in this mask are going to be
+   * used as indices in that array.
+   */
+  int64_t min_array_size() const
+  {
+    return ranges_.is_empty() ? 0 : ranges_.last().one_after_last();
+  }
+
+  /** Returns the n-th index in the mask. This requires O(log(ranges)) time. */
+  int64_t operator[](int64_t n) const;
+
+  /** Returns true when the index is in the mask. This requires O(log(ranges)) time. */
+  bool contains(int64_t index) const;
+
+  template<typename CallbackT> void foreach_range(const CallbackT &callback) const
+  {
+    for (const IndexRange range : ranges_) {
+      callback(range);
+    }
+  }
+
+  template<typename CallbackT> void foreach_index(const CallbackT &callback) const
+  {
+    for (const IndexRange range : ranges_) {
+      for (const int64_t i : range) {
+        callback(i);
+      }
+    }
+  }
+
+  /** Write all indices into the given array, which must have the size of this mask. */
+  void to_indices(MutableSpan<int64_t> r_indices) const;
+
+  /**
+   * Get an IndexMask with the same indices. When the mask is not a single range, the indices are
+   * written into \a r_indices, which has to stay alive as long as the returned mask is used.
+   */
+  IndexMask to_index_mask(Vector<int64_t> &r_indices) const;
+
+  friend bool operator==(const CompressedIndexMask &a, const CompressedIndexMask &b)
+  {
+    return a.ranges_.size() == b.ranges_.size() &&
+           std::equal(a.ranges_.begin(), a.ranges_.end(), b.ranges_.begin());
+  }
+
+  friend bool operator!=(const CompressedIndexMask &a, const CompressedIndexMask &b)
+  {
+    return !(a == b);
+  }
+
+ private:
+  void append_range(IndexRange range);
+};
+
+}  // namespace blender
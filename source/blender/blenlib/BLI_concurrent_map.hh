@@ -0,0 +1,365 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::ConcurrentMap<Key, Value>` is a hash map that can be accessed from multiple threads
+ * at the same time. It is meant for caches that are read much more often than they are written
+ * to, like caches of derived data that are shared between threads.
+ *
+ * Lookups are lock-free. Insertions lock a single segment of the map, so that threads that
+ * insert keys with different hashes rarely have to wait for each other. The segment is chosen
+ * based on the lower bits of the hash. Within a segment, open addressing with the probing
+ * strategies from BLI_probing_strategies.hh is used.
+ *
+ * To make lock-free lookups possible, there are a few restrictions compared to blender::Map:
+ * - Keys cannot be removed individually. `clear` removes all keys, but must not be called while
+ *   other threads access the map.
+ * - Values are never moved or overwritten once they are added. Therefore references returned by
+ *   lookup functions stay valid until the map is cleared or destructed. Values are accessed as
+ *   const, if they have to be modified, they have to do their own synchronization.
+ * - When a segment grows, the existing key-value-pairs are copied into a new table. The old table
+ *   is kept alive until the map is cleared, because other threads might still read from it. Since
+ *   the tables grow exponentially, this at most doubles the memory usage. Keys and values have to
+ *   be copy constructible.
+ */
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "BLI_array.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_memory_utils.hh"
+#include "BLI_probing_strategies.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+template<
+    /** Type of the keys stored in the map. Keys have to be copy constructible. */
+    typename Key,
+    /** Type of the values stored in the map. Values have to be copy constructible. */
+    typename Value,
+    /**
+     * The number of segments is `2 ^ SegmentsNumLog2`. More segments reduce contention when many
+     * threads insert at the same time, but make an empty map larger.
+     */
+    int SegmentsNumLog2 = 6,
+    /** The strategy used to deal with collisions within a segment. */
+    typename ProbingStrategy = DefaultProbingStrategy,
+    /** The hash function used to hash the keys. */
+    typename Hash = DefaultHash<Key>,
+    /** The equality operator used to compare keys. */
+    typename IsEqual = DefaultEquality>
+class ConcurrentMap : NonCopyable, NonMovable {
+ private:
+  static constexpr int64_t segments_num = int64_t(1) << SegmentsNumLog2;
+  static constexpr uint64_t segment_mask = static_cast<uint64_t>(segments_num) - 1;
+  static constexpr int64_t min_table_size = 8;
+
+  enum class SlotState : uint8_t {
+    Empty = 0,
+    Occupied = 1,
+  };
+
+  /**
+   * The state of a slot is only written while the segment is locked. Once it is occupied, the key
+   * and value are never changed anymore, which allows reading them without a lock.
+   */
+  struct Slot {
+    std::atomic<SlotState> state = SlotState::Empty;
+    uint64_t hash;
+    TypedBuffer<Key> key;
+    TypedBuffer<Value> value;
+
+    ~Slot()
+    {
+      if (state.load(std::memory_order_relaxed) == SlotState::Occupied) {
+        key.ref().~Key();
+        value.ref().~Value();
+      }
+    }
+  };
+
+  struct Table {
+    Array<Slot, 0> slots;
+    uint64_t slot_mask;
+    int64_t usable_slots;
+
+    Table(const int64_t size)
+        : slots(size), slot_mask(static_cast<uint64_t>(size) - 1), usable_slots(size / 2)
+    {
+    }
+  };
+
+  struct Segment {
+    /** Has to be locked when adding keys to this segment. */
+    std::mutex mutex;
+    /** The table that new keys are added to. Is null until the first key is added. */
+    std::atomic<Table *> table = nullptr;
+    /** All tables that were used by this segment, including the current one. */
+    Vector<std::unique_ptr<Table>> owned_tables;
+    /** Number of keys in the current table. */
+    std::atomic<int64_t> size = 0;
+  };
+
+  Segment segments_[segments_num];
+
+  Hash hash_;
+  IsEqual is_equal_;
+
+ public:
+  ConcurrentMap() = default;
+
+  /**
+   * Returns a pointer to the value that corresponds to the given key. If the key is not in the
+   * map, nullptr is returned. This does not lock.
+   */
+  const Value *lookup_ptr(const Key &key) const
+  {
+    return this->lookup_ptr_as(key);
+  }
+  template<typename ForwardKey> const Value *lookup_ptr_as(const ForwardKey &key) const
+  {
+    const uint64_t hash = hash_(key);
+    const Segment &segment = this->segment_for_hash(hash);
+    const Table *table = segment.table.load(std::memory_order_acquire);
+    if (table == nullptr) {
+      return nullptr;
+    }
+    const Slot *slot = this->find_slot(*table, key, hash);
+    return (slot == nullptr) ? nullptr : slot->value.ptr();
+  }
+
+  /**
+   * Returns true if the key is in the map. This does not lock.
+   */
+  bool contains(const Key &key) const
+  {
+    return this->contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    return this->lookup_ptr_as(key) != nullptr;
+  }
+
+  /**
+   * Returns a copy of the value that corresponds to the given key. If the key is not in the map,
+   * the provided default value is returned.
+   */
+  Value lookup_default(const Key &key, const Value &default_value) const
+  {
+    const Value *value = this->lookup_ptr(key);
+    return (value == nullptr) ? default_value : *value;
+  }
+
+  /**
+   * Add a key-value-pair to the map. If the map contains the key already, nothing is changed.
+   * Returns true when the key has been newly added.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    bool newly_added = false;
+    this->lookup_or_add_cb(key, [&]() {
+      newly_added = true;
+      return value;
+    });
+    return newly_added;
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not in the
+   * map, `create_value` is called to create the value. When multiple threads try to add the same
+   * key at the same time, `create_value` is only called once, while the other threads wait.
+   */
+  template<typename CreateValueF>
+  const Value &lookup_or_add_cb(const Key &key, const CreateValueF &create_value)
+  {
+    const uint64_t hash = hash_(key);
+    Segment &segment = this->segment_for_hash(hash);
+
+    /* Fast path without locking. */
+    const Table *table = segment.table.load(std::memory_order_acquire);
+    if (table != nullptr) {
+      const Slot *slot = this->find_slot(*table, key, hash);
+      if (slot != nullptr) {
+        return *slot->value;
+      }
+    }
+
+    std::lock_guard lock{segment.mutex};
+    /* The key might have been added while waiting for the lock. */
+    table = segment.table.load(std::memory_order_relaxed);
+    if (table != nullptr) {
+      const Slot *slot = this->find_slot(*table, key, hash);
+      if (slot != nullptr) {
+        return *slot->value;
+      }
+    }
+
+    this->ensure_can_add(segment);
+    Slot &slot = this->find_empty_slot(*segment.table.load(std::memory_order_relaxed), hash);
+    new (slot.key.ptr()) Key(key);
+    try {
+      new (slot.value.ptr()) Value(create_value());
+    }
+    catch (...) {
+      slot.key.ref().~Key();
+      throw;
+    }
+    slot.hash = hash;
+    /* Publish the key and value to other threads. */
+    slot.state.store(SlotState::Occupied, std::memory_order_release);
+    segment.size.fetch_add(1, std::memory_order_relaxed);
+    return *slot.value;
+  }
+
+  /**
+   * Returns the number of keys in the map. When other threads are adding keys at the same time,
+   * this is only an approximation.
+   */
+  int64_t size() const
+  {
+    int64_t size = 0;
+    for (const Segment &segment : segments_) {
+      size += segment.size.load(std::memory_order_relaxed);
+    }
+    return size;
+  }
+
+  bool is_empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /**
+   * Call the given function for every key-value-pair. This must not be called while other
+   * threads are adding keys.
+   */
+  template<typename FuncT> void foreach_item(const FuncT &func) const
+  {
+    for (const Segment &segment : segments_) {
+      const Table *table = segment.table.load(std::memory_order_acquire);
+      if (table == nullptr) {
+        continue;
+      }
+      for (const Slot &slot : table->slots) {
+        if (slot.state.load(std::memory_order_acquire) == SlotState::Occupied) {
+          func(*slot.key, *slot.value);
+        }
+      }
+    }
+  }
+
+  /**
+   * Remove all keys and free all memory. This must not be called while other threads access the
+   * map.
+   */
+  void clear()
+  {
+    for (Segment &segment : segments_) {
+      segment.table.store(nullptr, std::memory_order_relaxed);
+      segment.owned_tables.clear();
+      segment.size.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  Segment &segment_for_hash(const uint64_t hash)
+  {
+    return segments_[hash & segment_mask];
+  }
+
+  const Segment &segment_for_hash(const uint64_t hash) const
+  {
+    return segments_[hash & segment_mask];
+  }
+
+  /**
+   * The lower bits of the hash are used to find the segment already, so they are not used again
+   * to find the slot within the segment.
+   */
+  static uint64_t hash_in_segment(const uint64_t hash)
+  {
+    return hash >> SegmentsNumLog2;
+  }
+
+  template<typename ForwardKey>
+  const Slot *find_slot(const Table &table, const ForwardKey &key, const uint64_t hash) const
+  {
+    SLOT_PROBING_BEGIN (ProbingStrategy, hash_in_segment(hash), table.slot_mask, slot_index) {
+      const Slot &slot = table.slots[slot_index];
+      if (slot.state.load(std::memory_order_acquire) == SlotState::Empty) {
+        return nullptr;
+      }
+      if (slot.hash == hash && is_equal_(key, *slot.key)) {
+        return &slot;
+      }
+    }
+    SLOT_PROBING_END();
+  }
+
+  Slot &find_empty_slot(Table &table, const uint64_t hash)
+  {
+    SLOT_PROBING_BEGIN (ProbingStrategy, hash_in_segment(hash), table.slot_mask, slot_index) {
+      Slot &slot = table.slots[slot_index];
+      if (slot.state.load(std::memory_order_relaxed) == SlotState::Empty) {
+        return slot;
+      }
+    }
+    SLOT_PROBING_END();
+  }
+
+  /**
+   * Make sure that the current table of the segment has space for another key. Has to be called
+   * while the segment is locked.
+   */
+  void ensure_can_add(Segment &segment)
+  {
+    const Table *old_table = segment.table.load(std::memory_order_relaxed);
+    const int64_t size = segment.size.load(std::memory_order_relaxed);
+    if (old_table != nullptr && size < old_table->usable_slots) {
+      return;
+    }
+
+    const int64_t new_table_size = (old_table == nullptr) ? min_table_size :
+                                                            old_table->slots.size() * 2;
+    std::unique_ptr<Table> new_table = std::make_unique<Table>(new_table_size);
+    if (old_table != nullptr) {
+      /* Copy instead of move, because other threads might still read from the old table. */
+      for (const Slot &old_slot : old_table->slots) {
+        if (old_slot.state.load(std::memory_order_relaxed) == SlotState::Occupied) {
+          Slot &new_slot = this->find_empty_slot(*new_table, old_slot.hash);
+          new (new_slot.key.ptr()) Key(*old_slot.key);
+          new (new_slot.value.ptr()) Value(*old_slot.value);
+          new_slot.hash = old_slot.hash;
+          new_slot.state.store(SlotState::Occupied, std::memory_order_relaxed);
+        }
+      }
+    }
+    /* Publish the fully initialized table to other threads. */
+    segment.table.store(new_table.get(), std::memory_order_release);
+    segment.owned_tables.append(std::move(new_table));
+  }
+};
+
+}  // namespace blender
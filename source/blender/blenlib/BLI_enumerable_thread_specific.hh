@@ -0,0 +1,132 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * An `EnumerableThreadSpecific` gives every thread its own instance of a value. A thread accesses
+ * its instance with `local()`. Once all threads are done, the instances can be iterated over, to
+ * combine the per-thread results. This is typically used for accumulators in parallel loops.
+ */
+
+#ifdef WITH_TBB
+#  include <tbb/enumerable_thread_specific.h>
+#endif
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+
+#include "BLI_map.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+namespace enumerable_thread_specific_utils {
+inline std::atomic<int> next_id = 0;
+inline thread_local int thread_id = next_id.fetch_add(1, std::memory_order_relaxed);
+}  // namespace enumerable_thread_specific_utils
+
+/**
+ * This is mainly a wrapper for `tbb::enumerable_thread_specific`. The wrapper is needed because we
+ * want to be able to build without tbb.
+ *
+ * More features of the tbb version can be wrapped when they are used.
+ */
+template<typename T> class EnumerableThreadSpecific : NonCopyable, NonMovable {
+#ifdef WITH_TBB
+
+ private:
+  using TBBValues = tbb::enumerable_thread_specific<T>;
+  TBBValues values_;
+
+ public:
+  using iterator = typename TBBValues::iterator;
+
+  EnumerableThreadSpecific() = default;
+
+  /**
+   * \a initializer is called once for every thread that accesses its local value for the first
+   * time. It has to return the initial value.
+   */
+  template<typename F> EnumerableThreadSpecific(F initializer) : values_(std::move(initializer))
+  {
+  }
+
+  T &local()
+  {
+    return values_.local();
+  }
+
+  iterator begin()
+  {
+    return values_.begin();
+  }
+
+  iterator end()
+  {
+    return values_.end();
+  }
+
+#else /* WITH_TBB */
+
+ private:
+  std::mutex mutex_;
+  /* The values are not embedded in the map, so that their addresses do not change when the map
+   * grows. A list is used so that they can be iterated over directly. */
+  std::list<T> values_;
+  Map<int, T *> value_by_thread_;
+  std::function<T()> initializer_;
+
+ public:
+  using iterator = typename std::list<T>::iterator;
+
+  EnumerableThreadSpecific() : initializer_([]() { return T(); })
+  {
+  }
+
+  template<typename F>
+  EnumerableThreadSpecific(F initializer) : initializer_(std::move(initializer))
+  {
+  }
+
+  T &local()
+  {
+    const int thread_id = enumerable_thread_specific_utils::thread_id;
+    std::lock_guard lock{mutex_};
+    return *value_by_thread_.lookup_or_add_cb(thread_id, [&]() {
+      values_.push_back(initializer_());
+      return &values_.back();
+    });
+  }
+
+  iterator begin()
+  {
+    return values_.begin();
+  }
+
+  iterator end()
+  {
+    return values_.end();
+  }
+
+#endif /* WITH_TBB */
+};
+
+}  // namespace blender
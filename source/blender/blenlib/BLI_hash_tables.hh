@@ -24,6 +24,10 @@
 
 #include <cmath>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <xmmintrin.h>
+#endif
+
 #include "BLI_allocator.hh"
 #include "BLI_array.hh"
 #include "BLI_math_base.h"
@@ -342,6 +346,31 @@ class HashTableStats {
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batch Operations
+ *
+ * When many keys are looked up at once, most time is spent waiting for the slots to be loaded from
+ * memory. Hash tables can compute the hashes for a batch of keys first and prefetch their slots,
+ * so that the memory accesses of different keys overlap.
+ * \{ */
+
+/** Number of keys whose slots are prefetched before the first of them is probed. */
+inline constexpr int64_t hash_table_batch_size = 16;
+
+/** Hint the CPU that the memory at the given address will be accessed soon. */
+inline void hash_table_prefetch(const void *ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(ptr);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char *>(ptr), _MM_HINT_T0);
+#else
+  UNUSED_VARS(ptr);
+#endif
+}
+
+/** \} */
+
 /**
  * This struct provides an equality operator that returns true for all objects that compare equal
  * when one would use the `==` operator. This is different from std::equal_to<T>, because that
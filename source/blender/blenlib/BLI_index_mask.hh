@@ -34,7 +34,10 @@
  * instructions.
  *
  * The IndexMask.foreach_index method helps writing code that implements both code paths at the
- * same time.
+ * same time. IndexMask.foreach_range goes one step further and splits the mask into all its
+ * ranges of consecutive indices.
+ *
+ * For masks that should be stored in a compact way, see BLI_compressed_index_mask.hh.
  */
 
 #include "BLI_index_range.hh"
@@ -177,6 +180,50 @@ class IndexMask {
     }
   }
 
+  /**
+   * Calls the given callback for every maximal range of consecutive indices in this IndexMask. The
+   * callback has to take an IndexRange as parameter. This allows the caller to use a dense inner
+   * loop for masks that mostly consist of a few long ranges.
+   *
+   * Since the indices are sorted and unique, `indices[i] - i` stays the same exactly as long as no
+   * index is skipped. Therefore the end of every range can be found with an exponential search,
+   * which makes this logarithmic in the length of every range.
+   */
+  template<typename CallbackT> void foreach_range(const CallbackT &callback) const
+  {
+    if (this->is_range()) {
+      callback(this->as_range());
+      return;
+    }
+    const int64_t size = indices_.size();
+    int64_t range_begin = 0;
+    while (range_begin < size) {
+      const int64_t range_start = indices_[range_begin];
+      const int64_t offset = range_start - range_begin;
+      /* Find an upper bound for the end of the range. */
+      int64_t known_in_range = range_begin;
+      int64_t step = 1;
+      while (known_in_range + step < size &&
+             indices_[known_in_range + step] - offset == known_in_range + step) {
+        known_in_range += step;
+        step *= 2;
+      }
+      /* Binary search between the last index known to be in the range and the upper bound. */
+      int64_t not_in_range = std::min(known_in_range + step, size);
+      while (not_in_range - known_in_range > 1) {
+        const int64_t middle = known_in_range + (not_in_range - known_in_range) / 2;
+        if (indices_[middle] - offset == middle) {
+          known_in_range = middle;
+        }
+        else {
+          not_in_range = middle;
+        }
+      }
+      callback(IndexRange(range_start, not_in_range - range_begin));
+      range_begin = not_in_range;
+    }
+  }
+
   /**
    * Returns an IndexRange that can be used to index this IndexMask.
    *
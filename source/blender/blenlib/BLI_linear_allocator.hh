@@ -218,4 +218,34 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
   }
 };
 
+/**
+ * An allocator that can be passed to containers like blender::Vector and blender::Map, so that
+ * they get their memory from a #LinearAllocator that is owned by someone else. This allows
+ * freeing the memory of many short lived containers at once by destructing the linear allocator.
+ *
+ * Deallocation does nothing. Memory that a container frees when it grows is only reclaimed when
+ * the linear allocator is destructed, so it is good to reserve enough memory upfront when the
+ * final size is known. The referenced linear allocator has to outlive all containers using it.
+ */
+template<typename Allocator = GuardedAllocator> class LinearAllocatorRef {
+ private:
+  LinearAllocator<Allocator> *linear_allocator_;
+
+ public:
+  LinearAllocatorRef(LinearAllocator<Allocator> &linear_allocator)
+      : linear_allocator_(&linear_allocator)
+  {
+  }
+
+  void *allocate(size_t size, size_t alignment, const char *UNUSED(name))
+  {
+    return linear_allocator_->allocate(static_cast<int64_t>(size),
+                                       static_cast<int64_t>(alignment));
+  }
+
+  void deallocate(void *UNUSED(ptr))
+  {
+  }
+};
+
 }  // namespace blender
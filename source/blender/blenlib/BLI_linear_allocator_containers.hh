@@ -0,0 +1,79 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Variants of the standard containers that get their memory from a borrowed #LinearAllocator.
+ * They have to be constructed with a reference to the linear allocator:
+ *
+ *   LinearAllocator<> allocator;
+ *   LinearVector<int> vector{allocator};
+ *   LinearMap<int, float> map{allocator};
+ *
+ * This is useful in hot loops that create many short lived containers. Instead of going through
+ * MEM_* for every growth, all the memory is freed at once when the linear allocator is destructed.
+ * The containers still have to be destructed as usual, so that their elements are destructed.
+ */
+
+#include "BLI_linear_allocator.hh"
+#include "BLI_map.hh"
+#include "BLI_set.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+namespace blender {
+
+template<typename T, int64_t InlineBufferCapacity = default_inline_buffer_capacity(sizeof(T))>
+using LinearVector = Vector<T, InlineBufferCapacity, LinearAllocatorRef<>>;
+
+template<typename Key,
+         typename Value,
+         int64_t InlineBufferCapacity = default_inline_buffer_capacity(sizeof(Key) +
+                                                                       sizeof(Value)),
+         typename ProbingStrategy = DefaultProbingStrategy,
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality,
+         typename Slot = typename DefaultMapSlot<Key, Value>::type>
+using LinearMap = Map<Key,
+                      Value,
+                      InlineBufferCapacity,
+                      ProbingStrategy,
+                      Hash,
+                      IsEqual,
+                      Slot,
+                      LinearAllocatorRef<>>;
+
+template<typename Key,
+         int64_t InlineBufferCapacity = default_inline_buffer_capacity(sizeof(Key)),
+         typename ProbingStrategy = DefaultProbingStrategy,
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality,
+         typename Slot = typename DefaultSetSlot<Key>::type>
+using LinearSet =
+    Set<Key, InlineBufferCapacity, ProbingStrategy, Hash, IsEqual, Slot, LinearAllocatorRef<>>;
+
+template<typename Key,
+         typename ProbingStrategy = DefaultProbingStrategy,
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality,
+         typename Slot = typename DefaultVectorSetSlot<Key>::type>
+using LinearVectorSet =
+    VectorSet<Key, ProbingStrategy, Hash, IsEqual, Slot, LinearAllocatorRef<>>;
+
+}  // namespace blender
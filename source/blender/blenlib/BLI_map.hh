@@ -311,6 +311,34 @@ class Map {
         std::forward<ForwardKey>(key), std::forward<ForwardValue>(value), hash_(key));
   }
 
+  /**
+   * Add many key-value-pairs to the map at once. Keys that are in the map already, or that appear
+   * more than once, keep the first value that was added for them.
+   *
+   * This is faster than adding the keys one by one, because the hashes are computed and the slots
+   * are prefetched in batches.
+   */
+  void add_multiple(Span<Key> keys, Span<Value> values)
+  {
+    BLI_assert(keys.size() == values.size());
+    this->foreach_hash_prefetched(keys, [&](const int64_t i, const uint64_t hash) {
+      this->add__impl(keys[i], values[i], hash);
+    });
+  }
+
+  /**
+   * Add many key-value-pairs to the map at once. The keys must not be in the map before and there
+   * must not be duplicates in the array.
+   */
+  void add_multiple_new(Span<Key> keys, Span<Value> values)
+  {
+    BLI_assert(keys.size() == values.size());
+    this->reserve(this->size() + keys.size());
+    this->foreach_hash_prefetched(keys, [&](const int64_t i, const uint64_t hash) {
+      this->add_new__impl(keys[i], values[i], hash);
+    });
+  }
+
   /**
    * Returns true if there is a key in the map that compares equal to the given key.
    *
@@ -489,6 +517,19 @@ class Map {
     return const_cast<Value *>(const_cast<const Map *>(this)->lookup_ptr_as(key));
   }
 
+  /**
+   * Same as #lookup_ptr, but for many keys at once. This is faster than looking up the keys one by
+   * one, because the hashes are computed and the slots are prefetched in batches.
+   */
+  void lookup_multiple_ptr(Span<Key> keys, MutableSpan<const Value *> r_values) const
+  {
+    BLI_assert(keys.size() == r_values.size());
+    this->foreach_hash_prefetched(keys, [&](const int64_t i, const uint64_t hash) {
+      const Slot *slot = this->lookup_slot_ptr(keys[i], hash);
+      r_values[i] = (slot != nullptr) ? slot->value() : nullptr;
+    });
+  }
+
   /**
    * Returns a reference to the value that corresponds to the given key. This invokes undefined
    * behavior when the key is not in the map.
@@ -916,7 +957,7 @@ class Map {
       return;
     }
 
-    SlotArray new_slots(total_slots);
+    SlotArray new_slots(total_slots, slots_.allocator());
 
     try {
       for (Slot &slot : slots_) {
@@ -958,6 +999,27 @@ class Map {
     new (this) Map(NoExceptConstructor(), allocator);
   }
 
+  /**
+   * Call `fn(index, hash)` for every key. The hashes of a batch of keys are computed and their
+   * first slots are prefetched before the function is called for the first key of the batch.
+   * The function is allowed to grow the map, the prefetches are only hints.
+   */
+  template<typename F> void foreach_hash_prefetched(Span<Key> keys, const F &fn) const
+  {
+    uint64_t hashes[hash_table_batch_size];
+    for (int64_t batch_start = 0; batch_start < keys.size();
+         batch_start += hash_table_batch_size) {
+      const int64_t batch_size = std::min(hash_table_batch_size, keys.size() - batch_start);
+      for (int64_t i = 0; i < batch_size; i++) {
+        hashes[i] = hash_(keys[batch_start + i]);
+        hash_table_prefetch(&slots_[ProbingStrategy(hashes[i]).get() & slot_mask_]);
+      }
+      for (int64_t i = 0; i < batch_size; i++) {
+        fn(batch_start + i, hashes[i]);
+      }
+    }
+  }
+
   template<typename ForwardKey, typename ForwardValue>
   void add_new__impl(ForwardKey &&key, ForwardValue &&value, uint64_t hash)
   {
@@ -0,0 +1,59 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Math operations that process many vectors at once. They give the same results as calling the
+ * corresponding scalar function on every element, but process multiple elements per instruction
+ * when SIMD is available. The input and output spans may be the same, but must not overlap
+ * otherwise.
+ *
+ * These functions are single-threaded. Callers processing large arrays can split them up with
+ * #parallel_for.
+ */
+
+#include "BLI_float3.hh"
+#include "BLI_float4x4.hh"
+#include "BLI_span.hh"
+
+namespace blender {
+
+/**
+ * Same as `dst[i] = matrix * src[i]`, including the translation of the matrix.
+ */
+void transform_points(const float4x4 &matrix, Span<float3> src, MutableSpan<float3> dst);
+void transform_points(const float4x4 &matrix, MutableSpan<float3> positions);
+
+/**
+ * Same as `dst[i] = matrix.ref_3x3() * src[i]`, the translation of the matrix is ignored.
+ */
+void transform_directions(const float4x4 &matrix, Span<float3> src, MutableSpan<float3> dst);
+void transform_directions(const float4x4 &matrix, MutableSpan<float3> directions);
+
+/**
+ * Same as `vectors[i].normalize()`. Vectors that are too short to be normalized are set to zero.
+ */
+void normalize_vectors(MutableSpan<float3> vectors);
+
+/**
+ * Same as `r_dots[i] = float3::dot(a[i], b[i])`.
+ */
+void dot_products(Span<float3> a, Span<float3> b, MutableSpan<float> r_dots);
+
+}  // namespace blender
@@ -62,6 +62,24 @@ void *BLI_mempool_as_arrayN(BLI_mempool *pool,
 void BLI_mempool_set_memory_debug(void);
 #endif
 
+/** Allocation from multiple threads, every thread uses its own cache. */
+typedef struct BLI_mempool_thread_cache {
+  BLI_mempool *pool;
+  struct BLI_freenode *free;
+  struct BLI_freenode *free_tail;
+  /** Elements allocated minus elements freed through this cache since the last flush. */
+  int totused_delta;
+} BLI_mempool_thread_cache;
+
+void BLI_mempool_thread_cache_init(BLI_mempool *pool, BLI_mempool_thread_cache *cache)
+    ATTR_NONNULL(1, 2);
+void *BLI_mempool_thread_alloc(BLI_mempool_thread_cache *cache) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void *BLI_mempool_thread_calloc(BLI_mempool_thread_cache *cache) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void BLI_mempool_thread_free(BLI_mempool_thread_cache *cache, void *addr) ATTR_NONNULL(1, 2);
+void BLI_mempool_thread_cache_flush(BLI_mempool_thread_cache *cache) ATTR_NONNULL(1);
+
 /** iteration stuff.  note: this may easy to produce bugs with */
 /* private structure */
 typedef struct BLI_mempool_iter {
@@ -271,14 +271,13 @@ class Set {
    * Convenience function to add many keys to the set at once. Duplicates are removed
    * automatically.
    *
-   * We might be able to make this faster than sequentially adding all keys, but that is not
-   * implemented yet.
+   * This is faster than sequentially adding all keys, because the hashes are computed and the
+   * slots are prefetched in batches.
    */
   void add_multiple(Span<Key> keys)
   {
-    for (const Key &key : keys) {
-      this->add(key);
-    }
+    this->foreach_hash_prefetched(
+        keys, [&](const int64_t i, const uint64_t hash) { this->add__impl(keys[i], hash); });
   }
 
   /**
@@ -287,9 +286,9 @@ class Set {
    */
   void add_multiple_new(Span<Key> keys)
   {
-    for (const Key &key : keys) {
-      this->add_new(key);
-    }
+    this->reserve(this->size() + keys.size());
+    this->foreach_hash_prefetched(
+        keys, [&](const int64_t i, const uint64_t hash) { this->add_new__impl(keys[i], hash); });
   }
 
   /**
@@ -306,6 +305,18 @@ class Set {
     return this->contains__impl(key, hash_(key));
   }
 
+  /**
+   * Check for many keys at once whether they are in the set. This is faster than checking the
+   * keys one by one, because the hashes are computed and the slots are prefetched in batches.
+   */
+  void contains_multiple(Span<Key> keys, MutableSpan<bool> r_contained) const
+  {
+    BLI_assert(keys.size() == r_contained.size());
+    this->foreach_hash_prefetched(keys, [&](const int64_t i, const uint64_t hash) {
+      r_contained[i] = this->contains__impl(keys[i], hash);
+    });
+  }
+
   /**
    * Returns the key that is stored in the set that compares equal to the given key. This invokes
    * undefined behavior when the key is not in the set.
@@ -600,7 +611,7 @@ class Set {
     }
 
     /* The grown array that we insert the keys into. */
-    SlotArray new_slots(total_slots);
+    SlotArray new_slots(total_slots, slots_.allocator());
 
     try {
       for (Slot &slot : slots_) {
@@ -647,6 +658,27 @@ class Set {
     new (this) Set(NoExceptConstructor(), allocator);
   }
 
+  /**
+   * Call `fn(index, hash)` for every key. The hashes of a batch of keys are computed and their
+   * first slots are prefetched before the function is called for the first key of the batch.
+   * The function is allowed to grow the set, the prefetches are only hints.
+   */
+  template<typename F> void foreach_hash_prefetched(Span<Key> keys, const F &fn) const
+  {
+    uint64_t hashes[hash_table_batch_size];
+    for (int64_t batch_start = 0; batch_start < keys.size();
+         batch_start += hash_table_batch_size) {
+      const int64_t batch_size = std::min(hash_table_batch_size, keys.size() - batch_start);
+      for (int64_t i = 0; i < batch_size; i++) {
+        hashes[i] = hash_(keys[batch_start + i]);
+        hash_table_prefetch(&slots_[ProbingStrategy(hashes[i]).get() & slot_mask_]);
+      }
+      for (int64_t i = 0; i < batch_size; i++) {
+        fn(batch_start + i, hashes[i]);
+      }
+    }
+  }
+
   template<typename ForwardKey>
   bool contains__impl(const ForwardKey &key, const uint64_t hash) const
   {
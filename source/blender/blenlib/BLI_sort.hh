@@ -0,0 +1,75 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ */
+
+#ifdef WITH_TBB
+/* Quiet top level deprecation message, unrelated to API usage here. */
+#  define TBB_SUPPRESS_DEPRECATED_MESSAGES 1
+#  include <tbb/parallel_sort.h>
+#endif
+
+#include <algorithm>
+#include <functional>
+
+#include "BLI_span.hh"
+
+namespace blender {
+
+/**
+ * Sort the elements between the given iterators in parallel. Like `std::sort`, the sort is not
+ * stable. Ranges with fewer than \a grain_size elements are sorted on the calling thread, because
+ * spawning tasks is more expensive than sorting small arrays.
+ */
+template<typename RandomAccessIterator, typename Compare>
+void parallel_sort(RandomAccessIterator begin,
+                   RandomAccessIterator end,
+                   const Compare &comp,
+                   const int64_t grain_size = 4096)
+{
+#ifdef WITH_TBB
+  if (end - begin >= grain_size) {
+    tbb::parallel_sort(begin, end, comp);
+    return;
+  }
+#else
+  UNUSED_VARS(grain_size);
+#endif
+  std::sort(begin, end, comp);
+}
+
+template<typename RandomAccessIterator>
+void parallel_sort(RandomAccessIterator begin, RandomAccessIterator end)
+{
+  parallel_sort(begin, end, std::less<>());
+}
+
+template<typename T, typename Compare>
+void parallel_sort(MutableSpan<T> span, const Compare &comp, const int64_t grain_size = 4096)
+{
+  parallel_sort(span.begin(), span.end(), comp, grain_size);
+}
+
+template<typename T> void parallel_sort(MutableSpan<T> span)
+{
+  parallel_sort(span.begin(), span.end(), std::less<>());
+}
+
+}  // namespace blender
@@ -299,6 +299,26 @@ int BLI_task_parallel_thread_id(const TaskParallelTLS *tls);
  *    TaskNode *node_3 = BLI_task_graph_node_create(task_graph, node_exec, task_data, NULL);
  *    TaskNode *node_4 = BLI_task_graph_node_create(task_graph, node_exec, task_data, NULL);
  *
+ * ** Priorities **
+ *
+ * Nodes can be given a priority hint with `BLI_task_graph_node_create_ex`. When several nodes are
+ * ready to run, nodes with a higher priority are picked first by the scheduler. This is only a
+ * hint, it does not change the order imposed by the edges of the graph.
+ *
+ * ** Dynamic Nodes **
+ *
+ * Nodes and edges can be added while the graph is running, for example from inside the run
+ * function of another node. A node that is pushed with `BLI_task_graph_node_push_work` while the
+ * graph is running is waited for by `BLI_task_graph_work_and_wait` as well. Note that an edge only
+ * forwards the execution flow when its `from_node` finishes after the edge has been created.
+ *
+ * ** Cancellation **
+ *
+ * `BLI_task_graph_cancel` can be called from any thread, including from inside a running node.
+ * Nodes that did not start yet will not be executed anymore, nodes that are running are finished.
+ * Long running nodes can poll `BLI_task_graph_is_cancelled` to stop early.
+ * `BLI_task_graph_work_and_wait` returns false when the graph was cancelled and resets the
+ * cancelled state, so the graph can be reused afterwards.
  */
 struct TaskGraph;
 struct TaskNode;
@@ -306,13 +326,25 @@ struct TaskNode;
 typedef void (*TaskGraphNodeRunFunction)(void *__restrict task_data);
 typedef void (*TaskGraphNodeFreeFunction)(void *task_data);
 
+typedef enum eTaskGraphNodePriority {
+  TASK_GRAPH_NODE_PRIORITY_NORMAL = 0,
+  TASK_GRAPH_NODE_PRIORITY_HIGH = 1,
+} eTaskGraphNodePriority;
+
 struct TaskGraph *BLI_task_graph_create(void);
-void BLI_task_graph_work_and_wait(struct TaskGraph *task_graph);
+bool BLI_task_graph_work_and_wait(struct TaskGraph *task_graph);
 void BLI_task_graph_free(struct TaskGraph *task_graph);
+void BLI_task_graph_cancel(struct TaskGraph *task_graph);
+bool BLI_task_graph_is_cancelled(const struct TaskGraph *task_graph);
 struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
                                             TaskGraphNodeRunFunction run,
                                             void *user_data,
                                             TaskGraphNodeFreeFunction free_func);
+struct TaskNode *BLI_task_graph_node_create_ex(struct TaskGraph *task_graph,
+                                               TaskGraphNodeRunFunction run,
+                                               void *user_data,
+                                               TaskGraphNodeFreeFunction free_func,
+                                               eTaskGraphNodePriority priority);
 bool BLI_task_graph_node_push_work(struct TaskNode *task_node);
 void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_node);
 
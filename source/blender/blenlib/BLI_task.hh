@@ -41,7 +41,11 @@
 #  endif
 #endif
 
+#include <functional>
+#include <utility>
+
 #include "BLI_index_range.hh"
+#include "BLI_span.hh"
 #include "BLI_utildefines.h"
 
 namespace blender {
@@ -75,4 +79,91 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
 #endif
 }
 
+/**
+ * Split \a range into sub-ranges, compute a partial result for each of them with \a function
+ * and combine the partial results with \a reduction. \a function is called with a sub-range and
+ * the value it should start accumulating from, \a reduction has to be associative.
+ */
+template<typename Value, typename Function, typename Reduction>
+Value parallel_reduce(IndexRange range,
+                      int64_t grain_size,
+                      const Value &identity,
+                      const Function &function,
+                      const Reduction &reduction)
+{
+  if (range.size() == 0) {
+    return identity;
+  }
+#ifdef WITH_TBB
+  return tbb::parallel_reduce(
+      tbb::blocked_range<int64_t>(range.first(), range.one_after_last(), grain_size),
+      identity,
+      [&](const tbb::blocked_range<int64_t> &subrange, const Value &ident) {
+        return function(IndexRange(subrange.begin(), subrange.size()), ident);
+      },
+      reduction);
+#else
+  UNUSED_VARS(grain_size, reduction);
+  return function(range, identity);
+#endif
+}
+
+/**
+ * Compute the exclusive prefix sum of \a src and write it to \a dst, i.e.
+ * `dst[i] = src[0] + ... + src[i - 1]` and `dst[0] = identity`. \a src and \a dst may be the
+ * same span. Returns the sum of all elements, which is the value that would be written after the
+ * last element.
+ *
+ * A different associative operation than addition can be passed in as \a reduction. \a identity
+ * has to be its identity element, because it is used as start value for every sub-range.
+ */
+template<typename T, typename Reduction = std::plus<T>>
+T parallel_exclusive_scan(Span<T> src,
+                          MutableSpan<T> dst,
+                          const int64_t grain_size,
+                          const T &identity = T(0),
+                          const Reduction &reduction = {})
+{
+  BLI_assert(src.size() == dst.size());
+  if (src.is_empty()) {
+    return identity;
+  }
+  auto scan_range = [&](IndexRange range, T sum, const bool is_final_pass) {
+    for (const int64_t i : range) {
+      /* Read the value first, because the source and destination might be the same. */
+      const T value = src[i];
+      if (is_final_pass) {
+        dst[i] = sum;
+      }
+      sum = reduction(sum, value);
+    }
+    return sum;
+  };
+#ifdef WITH_TBB
+  return tbb::parallel_scan(
+      tbb::blocked_range<int64_t>(0, src.size(), grain_size),
+      identity,
+      [&](const tbb::blocked_range<int64_t> &subrange, const T &sum, const bool is_final_pass) {
+        return scan_range(IndexRange(subrange.begin(), subrange.size()), sum, is_final_pass);
+      },
+      reduction);
+#else
+  UNUSED_VARS(grain_size);
+  return scan_range(src.index_range(), identity, true);
+#endif
+}
+
+/**
+ * Execute all of the provided functions. The functions might be executed in parallel or in serial
+ * or some combination of both.
+ */
+template<typename... Functions> void parallel_invoke(Functions &&...functions)
+{
+#ifdef WITH_TBB
+  tbb::parallel_invoke(std::forward<Functions>(functions)...);
+#else
+  (functions(), ...);
+#endif
+}
+
 }  // namespace blender
@@ -0,0 +1,91 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Tracing of zones (time spans) and counters, shared by all modules.
+ *
+ * Events are recorded into a ring buffer per thread while tracing is started, so only the most
+ * recent events are kept. The trace is written in the Chrome trace event format, which can be
+ * opened in Perfetto or `chrome://tracing`.
+ *
+ * The `BLI_TRACE_*` macros only record anything when building with `WITH_TRACING`, otherwise
+ * they compile to nothing, so they can be used in hot code paths.
+ * Names must be string literals or otherwise live until the trace is written.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void BLI_trace_start(void);
+void BLI_trace_stop(void);
+bool BLI_trace_is_enabled(void);
+
+void BLI_trace_zone_begin(const char *name);
+void BLI_trace_zone_end(void);
+void BLI_trace_counter(const char *name, int64_t value);
+/** Name of the calling thread in the trace, can be called before the trace is started. */
+void BLI_trace_thread_name_set(const char *name);
+
+/** Write the events recorded so far, returns false when the file can't be written. */
+bool BLI_trace_write_chrome(const char *filepath);
+
+#ifdef WITH_TRACING
+#  define BLI_TRACE_ZONE_BEGIN(name) BLI_trace_zone_begin(name)
+#  define BLI_TRACE_ZONE_END() BLI_trace_zone_end()
+#  define BLI_TRACE_COUNTER(name, value) BLI_trace_counter(name, value)
+#else
+#  define BLI_TRACE_ZONE_BEGIN(name) ((void)0)
+#  define BLI_TRACE_ZONE_END() ((void)0)
+#  define BLI_TRACE_COUNTER(name, value) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+
+namespace blender {
+
+/** Trace a zone for the lifetime of the object, use #BLI_TRACE_SCOPE. */
+class ScopedTraceZone {
+ public:
+  ScopedTraceZone(const char *name)
+  {
+    BLI_trace_zone_begin(name);
+  }
+
+  ~ScopedTraceZone()
+  {
+    BLI_trace_zone_end();
+  }
+
+  ScopedTraceZone(const ScopedTraceZone &other) = delete;
+  ScopedTraceZone &operator=(const ScopedTraceZone &other) = delete;
+};
+
+}  // namespace blender
+
+#  ifdef WITH_TRACING
+#    define BLI_TRACE_SCOPE(name) blender::ScopedTraceZone _scoped_trace_zone(name)
+#  else
+#    define BLI_TRACE_SCOPE(name) ((void)0)
+#  endif
+#endif
@@ -223,7 +223,7 @@ class VectorSet {
     other.occupied_and_removed_slots_ = 0;
     other.usable_slots_ = 0;
     other.slot_mask_ = 0;
-    other.slots_ = SlotArray(1);
+    other.slots_ = SlotArray(1, slots_.allocator());
     other.keys_ = nullptr;
   }
 
@@ -508,7 +508,7 @@ class VectorSet {
       return;
     }
 
-    SlotArray new_slots(total_slots);
+    SlotArray new_slots(total_slots, slots_.allocator());
 
     try {
       for (Slot &slot : slots_) {
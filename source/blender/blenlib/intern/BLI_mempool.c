@@ -27,6 +27,7 @@
  * - Freeing chunks.
  * - Iterating over allocated chunks
  *   (optionally when using the #BLI_MEMPOOL_ALLOW_ITER flag).
+ * - Allocating from multiple threads at once using #BLI_mempool_thread_cache.
  */
 
 #include <stdlib.h>
@@ -131,6 +132,12 @@ struct BLI_mempool {
   uint maxchunks;
   /** Number of elements currently in use. */
   uint totused;
+  /**
+   * Protects the chunks and free list when #BLI_mempool_thread_cache is used.
+   * A plain atomic flag instead of a #SpinLock, because `makesdna` builds this file without the
+   * threading module.
+   */
+  uint32_t thread_lock;
 #ifdef USE_TOTALLOC
   /** Number of elements allocated in total. */
   uint totalloc;
@@ -315,6 +322,7 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
   pool->totalloc = 0;
 #endif
   pool->totused = 0;
+  pool->thread_lock = 0;
 
   if (totelem) {
     /* Allocate the actual chunks. */
@@ -451,6 +459,186 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Threaded Allocation
+ *
+ * Every thread allocates from its own #BLI_mempool_thread_cache, which takes batches of free
+ * elements from the pool. The pool is only locked when a cache runs out of elements, so threads
+ * don't have to wait for each other most of the time.
+ * \{ */
+
+/**
+ * Initialize \a cache for allocating from \a pool in one thread. Every thread needs its own cache.
+ *
+ * While any cache is in use, elements of the pool must only be allocated and freed through
+ * caches. #BLI_mempool_thread_cache_flush has to be called for every cache afterwards, before the
+ * pool is used directly again.
+ */
+static void mempool_thread_lock(BLI_mempool *pool)
+{
+  while (atomic_cas_uint32(&pool->thread_lock, 0, 1) != 0) {
+    /* Pass. */
+  }
+}
+
+static void mempool_thread_unlock(BLI_mempool *pool)
+{
+  atomic_cas_uint32(&pool->thread_lock, 1, 0);
+}
+
+void BLI_mempool_thread_cache_init(BLI_mempool *pool, BLI_mempool_thread_cache *cache)
+{
+  cache->pool = pool;
+  cache->free = NULL;
+  cache->free_tail = NULL;
+  cache->totused_delta = 0;
+}
+
+/**
+ * Fill the empty cache with up to a chunk of elements from the free list of the pool,
+ * or with a new chunk when the pool has no free elements.
+ */
+static void mempool_thread_cache_refill(BLI_mempool_thread_cache *cache)
+{
+  BLI_mempool *pool = cache->pool;
+  BLI_assert(cache->free == NULL);
+
+  mempool_thread_lock(pool);
+  if (pool->free) {
+    BLI_freenode *tail = pool->free;
+    for (uint i = 1; i < pool->pchunk && tail->next; i++) {
+      tail = tail->next;
+    }
+    cache->free = pool->free;
+    cache->free_tail = tail;
+    pool->free = tail->next;
+    tail->next = NULL;
+    mempool_thread_unlock(pool);
+    return;
+  }
+  mempool_thread_unlock(pool);
+
+  /* Initialize the new chunk without holding the lock. */
+  const uint esize = pool->esize;
+  BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
+  BLI_freenode *curnode = CHUNK_DATA(mpchunk);
+  cache->free = curnode;
+  for (uint j = pool->pchunk; j--;) {
+    curnode->next = NODE_STEP_NEXT(curnode);
+    if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+      curnode->freeword = FREEWORD;
+    }
+    curnode = curnode->next;
+  }
+  curnode = NODE_STEP_PREV(curnode);
+  curnode->next = NULL;
+  cache->free_tail = curnode;
+  mpchunk->next = NULL;
+
+  mempool_thread_lock(pool);
+  if (pool->chunk_tail) {
+    pool->chunk_tail->next = mpchunk;
+  }
+  else {
+    pool->chunks = mpchunk;
+  }
+  pool->chunk_tail = mpchunk;
+#ifdef USE_TOTALLOC
+  pool->totalloc += pool->pchunk;
+#endif
+  mempool_thread_unlock(pool);
+}
+
+/**
+ * Allocate an element in the thread that owns \a cache.
+ */
+void *BLI_mempool_thread_alloc(BLI_mempool_thread_cache *cache)
+{
+  if (UNLIKELY(cache->free == NULL)) {
+    mempool_thread_cache_refill(cache);
+  }
+
+  BLI_freenode *free_pop = cache->free;
+  if (cache->pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    free_pop->freeword = USEDWORD;
+  }
+  cache->free = free_pop->next;
+  if (cache->free == NULL) {
+    cache->free_tail = NULL;
+  }
+  cache->totused_delta++;
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(cache->pool, free_pop, cache->pool->esize);
+#endif
+
+  return (void *)free_pop;
+}
+
+void *BLI_mempool_thread_calloc(BLI_mempool_thread_cache *cache)
+{
+  void *retval = BLI_mempool_thread_alloc(cache);
+  memset(retval, 0, (size_t)cache->pool->esize);
+  return retval;
+}
+
+/**
+ * Free an element in the thread that owns \a cache. The element may have been allocated by
+ * another thread. Unlike #BLI_mempool_free, this never frees chunks.
+ */
+void BLI_mempool_thread_free(BLI_mempool_thread_cache *cache, void *addr)
+{
+  BLI_freenode *newhead = addr;
+
+#ifndef NDEBUG
+  if (UNLIKELY(mempool_debug_memset)) {
+    memset(addr, 255, cache->pool->esize);
+  }
+#endif
+
+  if (cache->pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+#ifndef NDEBUG
+    /* This will detect double free's. */
+    BLI_assert(newhead->freeword != FREEWORD);
+#endif
+    newhead->freeword = FREEWORD;
+  }
+
+  newhead->next = cache->free;
+  if (cache->free == NULL) {
+    cache->free_tail = newhead;
+  }
+  cache->free = newhead;
+  cache->totused_delta--;
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_FREE(cache->pool, addr);
+#endif
+}
+
+/**
+ * Give the unused elements of \a cache back to the pool and update the number of elements in use
+ * of the pool. The cache can be used again afterwards.
+ */
+void BLI_mempool_thread_cache_flush(BLI_mempool_thread_cache *cache)
+{
+  BLI_mempool *pool = cache->pool;
+
+  mempool_thread_lock(pool);
+  if (cache->free) {
+    cache->free_tail->next = pool->free;
+    pool->free = cache->free;
+  }
+  pool->totused = (uint)((int)pool->totused + cache->totused_delta);
+  mempool_thread_unlock(pool);
+
+  cache->free = NULL;
+  cache->free_tail = NULL;
+  cache->totused_delta = 0;
+}
+
+/** \} */
+
 int BLI_mempool_len(BLI_mempool *pool)
 {
   return (int)pool->totused;
@@ -0,0 +1,196 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_compressed_index_mask.hh"
+
+namespace blender {
+
+CompressedIndexMask::CompressedIndexMask(const IndexRange range)
+{
+  this->append_range(range);
+}
+
+CompressedIndexMask::CompressedIndexMask(const IndexMask mask)
+{
+  mask.foreach_range([&](const IndexRange range) { this->append_range(range); });
+}
+
+CompressedIndexMask CompressedIndexMask::from_ranges(Span<IndexRange> ranges)
+{
+  CompressedIndexMask mask;
+  for (const IndexRange range : ranges) {
+    BLI_assert(mask.is_empty() || range.size() == 0 ||
+               range.start() >= mask.ranges_.last().start());
+    mask.append_range(range);
+  }
+  return mask;
+}
+
+CompressedIndexMask CompressedIndexMask::from_union(const CompressedIndexMask &a,
+                                                    const CompressedIndexMask &b)
+{
+  CompressedIndexMask result;
+  const Span<IndexRange> ranges_a = a.ranges_;
+  const Span<IndexRange> ranges_b = b.ranges_;
+  int64_t index_a = 0;
+  int64_t index_b = 0;
+  /* Merge both lists by the start of the ranges, #append_range joins overlapping ranges. */
+  while (index_a < ranges_a.size() && index_b < ranges_b.size()) {
+    if (ranges_a[index_a].start() <= ranges_b[index_b].start()) {
+      result.append_range(ranges_a[index_a++]);
+    }
+    else {
+      result.append_range(ranges_b[index_b++]);
+    }
+  }
+  for (; index_a < ranges_a.size(); index_a++) {
+    result.append_range(ranges_a[index_a]);
+  }
+  for (; index_b < ranges_b.size(); index_b++) {
+    result.append_range(ranges_b[index_b]);
+  }
+  return result;
+}
+
+CompressedIndexMask CompressedIndexMask::from_intersection(const CompressedIndexMask &a,
+                                                           const CompressedIndexMask &b)
+{
+  CompressedIndexMask result;
+  const Span<IndexRange> ranges_a = a.ranges_;
+  const Span<IndexRange> ranges_b = b.ranges_;
+  int64_t index_a = 0;
+  int64_t index_b = 0;
+  while (index_a < ranges_a.size() && index_b < ranges_b.size()) {
+    const IndexRange range_a = ranges_a[index_a];
+    const IndexRange range_b = ranges_b[index_b];
+    const int64_t start = std::max(range_a.start(), range_b.start());
+    const int64_t end = std::min(range_a.one_after_last(), range_b.one_after_last());
+    if (start < end) {
+      result.append_range(IndexRange(start, end - start));
+    }
+    /* The range that ends first cannot overlap with any further range of the other mask. */
+    if (range_a.one_after_last() <= range_b.one_after_last()) {
+      index_a++;
+    }
+    else {
+      index_b++;
+    }
+  }
+  return result;
+}
+
+CompressedIndexMask CompressedIndexMask::from_difference(const CompressedIndexMask &a,
+                                                         const CompressedIndexMask &b)
+{
+  CompressedIndexMask result;
+  const Span<IndexRange> ranges_b = b.ranges_;
+  int64_t index_b = 0;
+  for (const IndexRange range_a : a.ranges_) {
+    int64_t start = range_a.start();
+    const int64_t end = range_a.one_after_last();
+    /* Skip ranges that end before the current range. */
+    while (index_b < ranges_b.size() && ranges_b[index_b].one_after_last() <= start) {
+      index_b++;
+    }
+    /* Cut out all ranges that overlap with the current range. The last one of them might still
+     * overlap with the next range, so it is not skipped. */
+    int64_t overlap_index_b = index_b;
+    while (overlap_index_b < ranges_b.size() && ranges_b[overlap_index_b].start() < end) {
+      const IndexRange range_b = ranges_b[overlap_index_b];
+      if (start < range_b.start()) {
+        result.append_range(IndexRange(start, range_b.start() - start));
+      }
+      start = std::max(start, range_b.one_after_last());
+      overlap_index_b++;
+    }
+    if (start < end) {
+      result.append_range(IndexRange(start, end - start));
+    }
+  }
+  return result;
+}
+
+int64_t CompressedIndexMask::operator[](const int64_t n) const
+{
+  BLI_assert(n >= 0 && n < this->size());
+  /* Find the last range that starts at or before the n-th index. */
+  const int64_t *offset = std::upper_bound(offsets_.begin(), offsets_.end(), n) - 1;
+  const int64_t range_index = offset - offsets_.begin();
+  return ranges_[range_index].start() + (n - *offset);
+}
+
+bool CompressedIndexMask::contains(const int64_t index) const
+{
+  const IndexRange *range = std::upper_bound(
+      ranges_.begin(), ranges_.end(), index, [](const int64_t index, const IndexRange range) {
+        return index < range.start();
+      });
+  if (range == ranges_.begin()) {
+    return false;
+  }
+  return (range - 1)->contains(index);
+}
+
+void CompressedIndexMask::to_indices(MutableSpan<int64_t> r_indices) const
+{
+  BLI_assert(r_indices.size() == this->size());
+  for (const int64_t range_index : ranges_.index_range()) {
+    const IndexRange range = ranges_[range_index];
+    int64_t *dst = r_indices.data() + offsets_[range_index];
+    for (const int64_t i : IndexRange(range.size())) {
+      dst[i] = range.start() + i;
+    }
+  }
+}
+
+IndexMask CompressedIndexMask::to_index_mask(Vector<int64_t> &r_indices) const
+{
+  if (ranges_.is_empty()) {
+    return {};
+  }
+  if (this->is_range()) {
+    return ranges_[0];
+  }
+  r_indices.resize(this->size());
+  this->to_indices(r_indices);
+  return r_indices.as_span();
+}
+
+void CompressedIndexMask::append_range(const IndexRange range)
+{
+  if (range.size() == 0) {
+    return;
+  }
+  if (!ranges_.is_empty()) {
+    IndexRange &last_range = ranges_.last();
+    BLI_assert(range.start() >= last_range.start());
+    if (range.start() <= last_range.one_after_last()) {
+      /* Extend the last range, because the new range overlaps or touches it. */
+      const int64_t end = std::max(last_range.one_after_last(), range.one_after_last());
+      last_range = IndexRange(last_range.start(), end - last_range.start());
+      offsets_.last() = offsets_[offsets_.size() - 2] + last_range.size();
+      return;
+    }
+  }
+  ranges_.append(range);
+  offsets_.append(offsets_.last() + range.size());
+}
+
+}  // namespace blender
@@ -0,0 +1,197 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * The SIMD code paths process four vectors at a time. Since #float3 is tightly packed, four
+ * vectors fit exactly into three SSE registers. They are shuffled into one register per
+ * component, so that every instruction works on four vectors. The remaining vectors are
+ * processed with the scalar code path.
+ */
+
+#include "BLI_math_batch.hh"
+#include "BLI_math_vector.h"
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+namespace blender {
+
+#ifdef __SSE2__
+
+/**
+ * Four #float3 in structure of arrays layout.
+ */
+struct float3x4_soa {
+  __m128 x, y, z;
+};
+
+static float3x4_soa load_float3x4(const float3 *src)
+{
+  const float *ptr = &src->x;
+  /* a = [x0 y0 z0 x1], b = [y1 z1 x2 y2], c = [z2 x3 y3 z3]. */
+  const __m128 a = _mm_loadu_ps(ptr);
+  const __m128 b = _mm_loadu_ps(ptr + 4);
+  const __m128 c = _mm_loadu_ps(ptr + 8);
+
+  float3x4_soa result;
+  const __m128 x23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+  result.x = _mm_shuffle_ps(a, x23, _MM_SHUFFLE(2, 0, 3, 0));
+  const __m128 y01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+  const __m128 y23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+  result.y = _mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2, 0, 2, 0));
+  const __m128 z01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+  result.z = _mm_shuffle_ps(z01, c, _MM_SHUFFLE(3, 0, 2, 0));
+  return result;
+}
+
+static void store_float3x4(const float3x4_soa &src, float3 *dst)
+{
+  float *ptr = &dst->x;
+  const __m128 xy0 = _mm_shuffle_ps(src.x, src.y, _MM_SHUFFLE(0, 0, 0, 0));
+  const __m128 zx01 = _mm_shuffle_ps(src.z, src.x, _MM_SHUFFLE(1, 1, 0, 0));
+  _mm_storeu_ps(ptr, _mm_shuffle_ps(xy0, zx01, _MM_SHUFFLE(2, 0, 2, 0)));
+  const __m128 yz1 = _mm_shuffle_ps(src.y, src.z, _MM_SHUFFLE(1, 1, 1, 1));
+  const __m128 xy2 = _mm_shuffle_ps(src.x, src.y, _MM_SHUFFLE(2, 2, 2, 2));
+  _mm_storeu_ps(ptr + 4, _mm_shuffle_ps(yz1, xy2, _MM_SHUFFLE(2, 0, 2, 0)));
+  const __m128 zx23 = _mm_shuffle_ps(src.z, src.x, _MM_SHUFFLE(3, 3, 2, 2));
+  const __m128 yz3 = _mm_shuffle_ps(src.y, src.z, _MM_SHUFFLE(3, 3, 3, 3));
+  _mm_storeu_ps(ptr + 8, _mm_shuffle_ps(zx23, yz3, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+static __m128 dot_float3x4(const float3x4_soa &a, const float3x4_soa &b)
+{
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)),
+                    _mm_mul_ps(a.z, b.z));
+}
+
+/**
+ * Process the vectors in `[0, size - size % 4)` with the given function and returns the index of
+ * the first vector that still has to be processed.
+ */
+template<typename Func> static int64_t foreach_float3x4(const int64_t size, const Func &func)
+{
+  const int64_t simd_size = size & ~int64_t(3);
+  for (int64_t i = 0; i < simd_size; i += 4) {
+    func(i);
+  }
+  return simd_size;
+}
+
+static void transform_float3x4(const float4x4 &matrix,
+                               const bool use_translation,
+                               const float3 *src,
+                               float3 *dst)
+{
+  const float(*m)[4] = matrix.values;
+  const float3x4_soa v = load_float3x4(src);
+  float3x4_soa result;
+  __m128 *result_components[3] = {&result.x, &result.y, &result.z};
+  for (int i = 0; i < 3; i++) {
+    __m128 component = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(v.x, _mm_set1_ps(m[0][i])), _mm_mul_ps(v.y, _mm_set1_ps(m[1][i]))),
+        _mm_mul_ps(v.z, _mm_set1_ps(m[2][i])));
+    if (use_translation) {
+      component = _mm_add_ps(component, _mm_set1_ps(m[3][i]));
+    }
+    *result_components[i] = component;
+  }
+  store_float3x4(result, dst);
+}
+
+#endif /* __SSE2__ */
+
+void transform_points(const float4x4 &matrix, Span<float3> src, MutableSpan<float3> dst)
+{
+  BLI_assert(src.size() == dst.size());
+  int64_t start = 0;
+#ifdef __SSE2__
+  start = foreach_float3x4(src.size(), [&](const int64_t i) {
+    transform_float3x4(matrix, true, &src[i], &dst[i]);
+  });
+#endif
+  for (int64_t i = start; i < src.size(); i++) {
+    dst[i] = matrix * src[i];
+  }
+}
+
+void transform_points(const float4x4 &matrix, MutableSpan<float3> positions)
+{
+  transform_points(matrix, positions.as_span(), positions);
+}
+
+void transform_directions(const float4x4 &matrix, Span<float3> src, MutableSpan<float3> dst)
+{
+  BLI_assert(src.size() == dst.size());
+  int64_t start = 0;
+#ifdef __SSE2__
+  start = foreach_float3x4(src.size(), [&](const int64_t i) {
+    transform_float3x4(matrix, false, &src[i], &dst[i]);
+  });
+#endif
+  for (int64_t i = start; i < src.size(); i++) {
+    dst[i] = matrix.ref_3x3() * src[i];
+  }
+}
+
+void transform_directions(const float4x4 &matrix, MutableSpan<float3> directions)
+{
+  transform_directions(matrix, directions.as_span(), directions);
+}
+
+void normalize_vectors(MutableSpan<float3> vectors)
+{
+  int64_t start = 0;
+#ifdef __SSE2__
+  const __m128 one = _mm_set1_ps(1.0f);
+  /* Same threshold as #normalize_v3. */
+  const __m128 min_length_squared = _mm_set1_ps(1.0e-35f);
+  start = foreach_float3x4(vectors.size(), [&](const int64_t i) {
+    float3x4_soa v = load_float3x4(&vectors[i]);
+    const __m128 length_squared = dot_float3x4(v, v);
+    const __m128 is_valid = _mm_cmpgt_ps(length_squared, min_length_squared);
+    const __m128 factor = _mm_and_ps(is_valid, _mm_div_ps(one, _mm_sqrt_ps(length_squared)));
+    v.x = _mm_mul_ps(v.x, factor);
+    v.y = _mm_mul_ps(v.y, factor);
+    v.z = _mm_mul_ps(v.z, factor);
+    store_float3x4(v, &vectors[i]);
+  });
+#endif
+  for (int64_t i = start; i < vectors.size(); i++) {
+    vectors[i].normalize();
+  }
+}
+
+void dot_products(Span<float3> a, Span<float3> b, MutableSpan<float> r_dots)
+{
+  BLI_assert(a.size() == b.size());
+  BLI_assert(a.size() == r_dots.size());
+  int64_t start = 0;
+#ifdef __SSE2__
+  start = foreach_float3x4(a.size(), [&](const int64_t i) {
+    const float3x4_soa va = load_float3x4(&a[i]);
+    const float3x4_soa vb = load_float3x4(&b[i]);
+    _mm_storeu_ps(&r_dots[i], dot_float3x4(va, vb));
+  });
+#endif
+  for (int64_t i = start; i < a.size(); i++) {
+    r_dots[i] = float3::dot(a[i], b[i]);
+  }
+}
+
+}  // namespace blender
@@ -37,6 +37,7 @@
 #  include "BLI_set.hh"
 #  include "BLI_span.hh"
 #  include "BLI_stack.hh"
+#  include "BLI_task.h"
 #  include "BLI_vector.hh"
 #  include "BLI_vector_set.hh"
 
@@ -867,15 +868,48 @@ static const Vert *find_flap_vert(const Face &tri, const Edge e, bool *r_rev)
  * that if a triangle is in class 1 then it is has the same flap vert
  * as tri0.
  */
+/**
+ * Return the same value as #orient3d for the exact coordinates of the vertices.
+ * The determinant is computed with the double coordinates first. The exact coordinates are only
+ * used when the result is too close to zero to be sure about its sign, taking into account that
+ * the double coordinates are rounded and the error of the double arithmetic.
+ */
+static int filtered_orient3d(const Vert *a, const Vert *b, const Vert *c, const Vert *d)
+{
+  const double3 &da = a->co;
+  const double3 &db = b->co;
+  const double3 &dc = c->co;
+  const double3 &dd = d->co;
+  const double3 ad = da - dd;
+  const double3 bd = db - dd;
+  const double3 cd = dc - dd;
+  const double det = ad.z * (bd.x * cd.y - cd.x * bd.y) + bd.z * (cd.x * ad.y - ad.x * cd.y) +
+                     cd.z * (ad.x * bd.y - bd.x * ad.y);
+
+  /* Upper bounds of the magnitudes of the exact differences. */
+  const double3 abs_d = double3::abs(dd);
+  const double3 ad_sup = double3::abs(da) + abs_d;
+  const double3 bd_sup = double3::abs(db) + abs_d;
+  const double3 cd_sup = double3::abs(dc) + abs_d;
+  const double permanent = ad_sup.z * (bd_sup.x * cd_sup.y + cd_sup.x * bd_sup.y) +
+                           bd_sup.z * (cd_sup.x * ad_sup.y + ad_sup.x * cd_sup.y) +
+                           cd_sup.z * (ad_sup.x * bd_sup.y + bd_sup.x * ad_sup.y);
+  const double err_bound = 16.0 * DBL_EPSILON * permanent;
+  if (det > err_bound) {
+    return 1;
+  }
+  if (det < -err_bound) {
+    return -1;
+  }
+  return orient3d(a->co_exact, b->co_exact, c->co_exact, d->co_exact);
+}
+
 static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
 {
   const int dbg_level = 0;
   if (dbg_level > 0) {
     std::cout << "classify  e = " << e << "\n";
   }
-  mpq3 a0 = tri0[0]->co_exact;
-  mpq3 a1 = tri0[1]->co_exact;
-  mpq3 a2 = tri0[2]->co_exact;
   bool rev;
   bool rev0;
   const Vert *flapv0 = find_flap_vert(tri0, e, &rev0);
@@ -887,9 +921,8 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
     std::cout << " rev = " << rev << " flapv = " << flapv << "\n";
   }
   BLI_assert(flapv != nullptr && flapv0 != nullptr);
-  const mpq3 flap = flapv->co_exact;
-  /* orient will be positive if flap is below oriented plane of a0,a1,a2. */
-  int orient = orient3d(a0, a1, a2, flap);
+  /* orient will be positive if flap is below oriented plane of tri0. */
+  int orient = filtered_orient3d(tri0[0], tri0[1], tri0[2], flapv);
   int ans;
   if (orient > 0) {
     ans = rev0 ? 4 : 3;
@@ -1687,9 +1720,12 @@ static int find_containing_cell(const Vert *v,
  * If the closest point is on an edge, return 0, 1, or 2
  * for edges ab, bc, or ca in *r_edge; else -1.
  * (Adapted from #closest_on_tri_to_point_v3()).
+ * This is used with exact (#T and #mpq3) and with approximate (double and #double3)
+ * arithmetic.
  */
-static mpq_class closest_on_tri_to_point(
-    const mpq3 &p, const mpq3 &a, const mpq3 &b, const mpq3 &c, int *r_edge, int *r_vert)
+template<typename T, typename VecT>
+static T closest_on_tri_to_point(
+    const VecT &p, const VecT &a, const VecT &b, const VecT &c, int *r_edge, int *r_vert)
 {
   constexpr int dbg_level = 0;
   if (dbg_level > 0) {
@@ -1697,11 +1733,11 @@ static mpq_class closest_on_tri_to_point(
     std::cout << " a = " << a << ", b = " << b << ", c = " << c << "\n";
   }
   /* Check if p in vertex region outside a. */
-  mpq3 ab = b - a;
-  mpq3 ac = c - a;
-  mpq3 ap = p - a;
-  mpq_class d1 = mpq3::dot(ab, ap);
-  mpq_class d2 = mpq3::dot(ac, ap);
+  VecT ab = b - a;
+  VecT ac = c - a;
+  VecT ap = p - a;
+  T d1 = VecT::dot(ab, ap);
+  T d2 = VecT::dot(ac, ap);
   if (d1 <= 0 && d2 <= 0) {
     /* Barycentric coordinates (1,0,0). */
     *r_edge = -1;
@@ -1709,12 +1745,12 @@ static mpq_class closest_on_tri_to_point(
     if (dbg_level > 0) {
       std::cout << "  answer = a\n";
     }
-    return mpq3::distance_squared(p, a);
+    return VecT::distance_squared(p, a);
   }
   /* Check if p in vertex region outside b. */
-  mpq3 bp = p - b;
-  mpq_class d3 = mpq3::dot(ab, bp);
-  mpq_class d4 = mpq3::dot(ac, bp);
+  VecT bp = p - b;
+  T d3 = VecT::dot(ab, bp);
+  T d4 = VecT::dot(ac, bp);
   if (d3 >= 0 && d4 <= d3) {
     /* Barycentric coordinates (0,1,0). */
     *r_edge = -1;
@@ -1722,25 +1758,25 @@ static mpq_class closest_on_tri_to_point(
     if (dbg_level > 0) {
       std::cout << "  answer = b\n";
     }
-    return mpq3::distance_squared(p, b);
+    return VecT::distance_squared(p, b);
   }
   /* Check if p in region of ab. */
-  mpq_class vc = d1 * d4 - d3 * d2;
+  T vc = d1 * d4 - d3 * d2;
   if (vc <= 0 && d1 >= 0 && d3 <= 0) {
-    mpq_class v = d1 / (d1 - d3);
+    T v = d1 / (d1 - d3);
     /* Barycentric coordinates (1-v,v,0). */
-    mpq3 r = a + v * ab;
+    VecT r = a + v * ab;
     *r_vert = -1;
     *r_edge = 0;
     if (dbg_level > 0) {
       std::cout << "  answer = on ab at " << r << "\n";
     }
-    return mpq3::distance_squared(p, r);
+    return VecT::distance_squared(p, r);
   }
   /* Check if p in vertex region outside c. */
-  mpq3 cp = p - c;
-  mpq_class d5 = mpq3::dot(ab, cp);
-  mpq_class d6 = mpq3::dot(ac, cp);
+  VecT cp = p - c;
+  T d5 = VecT::dot(ab, cp);
+  T d6 = VecT::dot(ac, cp);
   if (d6 >= 0 && d5 <= d6) {
     /* Barycentric coordinates (0,0,1). */
     *r_edge = -1;
@@ -1748,27 +1784,27 @@ static mpq_class closest_on_tri_to_point(
     if (dbg_level > 0) {
       std::cout << "  answer = c\n";
     }
-    return mpq3::distance_squared(p, c);
+    return VecT::distance_squared(p, c);
   }
   /* Check if p in edge region of ac. */
-  mpq_class vb = d5 * d2 - d1 * d6;
+  T vb = d5 * d2 - d1 * d6;
   if (vb <= 0 && d2 >= 0 && d6 <= 0) {
-    mpq_class w = d2 / (d2 - d6);
+    T w = d2 / (d2 - d6);
     /* Barycentric coordinates (1-w,0,w). */
-    mpq3 r = a + w * ac;
+    VecT r = a + w * ac;
     *r_vert = -1;
     *r_edge = 2;
     if (dbg_level > 0) {
       std::cout << "  answer = on ac at " << r << "\n";
     }
-    return mpq3::distance_squared(p, r);
+    return VecT::distance_squared(p, r);
   }
   /* Check if p in edge region of bc. */
-  mpq_class va = d3 * d6 - d5 * d4;
+  T va = d3 * d6 - d5 * d4;
   if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
-    mpq_class w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    T w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
     /* Barycentric coordinates (0,1-w,w). */
-    mpq3 r = c - b;
+    VecT r = c - b;
     r = w * r;
     r = r + b;
     *r_vert = -1;
@@ -1776,23 +1812,60 @@ static mpq_class closest_on_tri_to_point(
     if (dbg_level > 0) {
       std::cout << "  answer = on bc at " << r << "\n";
     }
-    return mpq3::distance_squared(p, r);
+    return VecT::distance_squared(p, r);
   }
   /* p inside face region. Compute barycentric coordinates (u,v,w). */
-  mpq_class denom = 1 / (va + vb + vc);
-  mpq_class v = vb * denom;
-  mpq_class w = vc * denom;
+  T denom = 1 / (va + vb + vc);
+  T v = vb * denom;
+  T w = vc * denom;
   ac = w * ac;
-  mpq3 r = a + v * ab;
+  VecT r = a + v * ab;
   r = r + ac;
   *r_vert = -1;
   *r_edge = -1;
   if (dbg_level > 0) {
     std::cout << "  answer = inside at " << r << "\n";
   }
-  return mpq3::distance_squared(p, r);
+  return VecT::distance_squared(p, r);
 }
 
+/**
+ * A lower bound of the squared distance from p to the exact triangle, computed from the bounding
+ * box of the double coordinates. The bounds are enlarged by the rounding error of the double
+ * coordinates, so that this never exceeds the exact distance.
+ */
+static double tri_dist_squared_lower_bound(const double3 &p, const Face &tri)
+{
+  double dist_squared = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    const double v0 = tri[0]->co[axis];
+    const double v1 = tri[1]->co[axis];
+    const double v2 = tri[2]->co[axis];
+    const double lo = std::min(v0, std::min(v1, v2));
+    const double hi = std::max(v0, std::max(v1, v2));
+    const double err = 4.0 * DBL_EPSILON * (fabs(p[axis]) + std::max(fabs(lo), fabs(hi)));
+    double gap = 0.0;
+    if (p[axis] < lo) {
+      gap = lo - p[axis];
+    }
+    else if (p[axis] > hi) {
+      gap = p[axis] - hi;
+    }
+    gap = std::max(0.0, gap - err);
+    dist_squared += gap * gap;
+  }
+  return dist_squared * (1.0 - 4.0 * DBL_EPSILON);
+}
+
+/** A triangle that might be the closest one to a test point. */
+struct NearestTriCandidate {
+  int tri;
+  /* Position in the order the triangles are visited in, used to break ties consistently. */
+  int order;
+  double approx_dist_squared;
+  double min_dist_squared;
+};
+
 struct ComponentContainer {
   int containing_component{NO_INDEX};
   int nearest_cell{NO_INDEX};
@@ -1836,35 +1909,76 @@ static Vector<ComponentContainer> find_component_containers(int comp,
     if (dbg_level > 0) {
       std::cout << "comp_other = " << comp_other << "\n";
     }
-    int nearest_tri = NO_INDEX;
-    int nearest_tri_close_vert = -1;
-    int nearest_tri_close_edge = -1;
-    mpq_class nearest_tri_dist_squared;
+    /* Computing the exact distance to every triangle is expensive. So the triangles are
+     * visited in the order of their approximate distance, and the exact distance is only
+     * computed for triangles whose bounds are not provably further away than the nearest
+     * triangle found so far. The result is the same as when computing all exact distances. */
+    Vector<NearestTriCandidate> candidates;
     for (int p : components[comp_other]) {
       const Patch &patch = pinfo.patch(p);
       for (int t : patch.tris()) {
         const Face &tri = *tm.face(t);
-        if (dbg_level > 1) {
-          std::cout << "tri " << t << " = " << &tri << "\n";
-        }
         int close_vert;
         int close_edge;
-        mpq_class d2 = closest_on_tri_to_point(test_v->co_exact,
-                                               tri[0]->co_exact,
-                                               tri[1]->co_exact,
-                                               tri[2]->co_exact,
-                                               &close_edge,
-                                               &close_vert);
-        if (dbg_level > 1) {
-          std::cout << "  close_edge=" << close_edge << " close_vert=" << close_vert
-                    << "  dsquared=" << d2.get_d() << "\n";
-        }
-        if (nearest_tri == NO_INDEX || d2 < nearest_tri_dist_squared) {
-          nearest_tri = t;
-          nearest_tri_close_edge = close_edge;
-          nearest_tri_close_vert = close_vert;
-          nearest_tri_dist_squared = d2;
+        NearestTriCandidate candidate;
+        candidate.tri = t;
+        candidate.order = candidates.size();
+        candidate.min_dist_squared = tri_dist_squared_lower_bound(test_v->co, tri);
+        candidate.approx_dist_squared = closest_on_tri_to_point<double>(
+            test_v->co, tri[0]->co, tri[1]->co, tri[2]->co, &close_edge, &close_vert);
+        if (!std::isfinite(candidate.approx_dist_squared)) {
+          /* Degenerate triangles can give an undefined approximation. */
+          candidate.approx_dist_squared = candidate.min_dist_squared;
         }
+        candidates.append(candidate);
+      }
+    }
+    std::sort(candidates.begin(),
+              candidates.end(),
+              [](const NearestTriCandidate &a, const NearestTriCandidate &b) {
+                if (a.approx_dist_squared != b.approx_dist_squared) {
+                  return a.approx_dist_squared < b.approx_dist_squared;
+                }
+                return a.order < b.order;
+              });
+    int nearest_tri = NO_INDEX;
+    int nearest_tri_order = -1;
+    int nearest_tri_close_vert = -1;
+    int nearest_tri_close_edge = -1;
+    mpq_class nearest_tri_dist_squared;
+    double nearest_tri_dist_squared_sup = 0.0;
+    for (const NearestTriCandidate &candidate : candidates) {
+      if (nearest_tri != NO_INDEX &&
+          candidate.min_dist_squared > nearest_tri_dist_squared_sup) {
+        continue;
+      }
+      const int t = candidate.tri;
+      const Face &tri = *tm.face(t);
+      if (dbg_level > 1) {
+        std::cout << "tri " << t << " = " << &tri << "\n";
+      }
+      int close_vert;
+      int close_edge;
+      mpq_class d2 = closest_on_tri_to_point<mpq_class>(test_v->co_exact,
+                                                        tri[0]->co_exact,
+                                                        tri[1]->co_exact,
+                                                        tri[2]->co_exact,
+                                                        &close_edge,
+                                                        &close_vert);
+      if (dbg_level > 1) {
+        std::cout << "  close_edge=" << close_edge << " close_vert=" << close_vert
+                  << "  dsquared=" << d2.get_d() << "\n";
+      }
+      /* Break ties by the original order, like visiting the triangles in that order does. */
+      if (nearest_tri == NO_INDEX || d2 < nearest_tri_dist_squared ||
+          (d2 == nearest_tri_dist_squared && candidate.order < nearest_tri_order)) {
+        nearest_tri = t;
+        nearest_tri_order = candidate.order;
+        nearest_tri_close_edge = close_edge;
+        nearest_tri_close_vert = close_vert;
+        nearest_tri_dist_squared = d2;
+        /* #mpq_class::get_d truncates, so round up a little to get an upper bound. */
+        nearest_tri_dist_squared_sup = d2.get_d() * (1.0 + 4.0 * DBL_EPSILON) + DBL_MIN;
       }
     }
     if (dbg_level > 0) {
@@ -1894,6 +2008,33 @@ static Vector<ComponentContainer> find_component_containers(int comp,
   return ans;
 }
 
+/**
+ * Data needed for parallelization of find_component_containers.
+ */
+struct ComponentContainersData {
+  MutableSpan<Vector<ComponentContainer>> r_comp_cont;
+  const Vector<Vector<int>> &components;
+  const Array<int> &ambient_cell;
+  const IMesh &tm;
+  const PatchesInfo &pinfo;
+  const TriMeshTopology &tmtopo;
+  IMeshArena *arena;
+};
+
+static void find_component_containers_range_func(void *__restrict userdata,
+                                                 const int iter,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ComponentContainersData *data = static_cast<ComponentContainersData *>(userdata);
+  data->r_comp_cont[iter] = find_component_containers(iter,
+                                                      data->components,
+                                                      data->ambient_cell,
+                                                      data->tm,
+                                                      data->pinfo,
+                                                      data->tmtopo,
+                                                      data->arena);
+}
+
 /**
  * The cells and patches are supposed to form a bipartite graph.
  * The graph may be disconnected (if parts of meshes are nested or side-by-side
@@ -1936,10 +2077,12 @@ static void finish_patch_cell_graph(const IMesh &tm,
   }
   int tot_components = components.size();
   Array<Vector<ComponentContainer>> comp_cont(tot_components);
-  for (int comp : components.index_range()) {
-    comp_cont[comp] = find_component_containers(
-        comp, components, ambient_cell, tm, pinfo, tmtopo, arena);
-  }
+  ComponentContainersData data{comp_cont, components, ambient_cell, tm, pinfo, tmtopo, arena};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, tot_components, &data, find_component_containers_range_func, &settings);
   if (dbg_level > 0) {
     std::cout << "component containers:\n";
     for (int comp : comp_cont.index_range()) {
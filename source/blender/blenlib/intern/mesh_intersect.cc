@@ -40,6 +40,7 @@
 #  include "BLI_mpq2.hh"
 #  include "BLI_mpq3.hh"
 #  include "BLI_set.hh"
+#  include "BLI_sort.hh"
 #  include "BLI_span.hh"
 #  include "BLI_task.h"
 #  include "BLI_threads.h"
@@ -2082,8 +2083,10 @@ class TriOverlaps {
       }
       overlap_tot_ += overlap_tot_;
     }
-    /* Sort the overlaps to bring all the intersects with a given indexA together.  */
-    std::sort(overlap_, overlap_ + overlap_tot_, bvhtreeverlap_cmp);
+    /* Sort the overlaps to bring all the intersects with a given indexA together.
+     * All pairs are distinct, so the result does not depend on the order in which the threads
+     * of the overlap search appended them. */
+    parallel_sort(overlap_, overlap_ + overlap_tot_, bvhtreeverlap_cmp);
     if (dbg_level > 0) {
       std::cout << overlap_tot_ << " overlaps found:\n";
       for (BVHTreeOverlap ov : overlap()) {
@@ -2384,6 +2387,47 @@ static CDT_data calc_cluster_subdivided(const CoplanarClusterInfo &clinfo,
   return cd_data;
 }
 
+/**
+ * Data needed for parallelization of calc_clusters_subdivided.
+ */
+struct ClusterSubdivideData {
+  MutableSpan<CDT_data> r_cluster_subdivided;
+  const CoplanarClusterInfo &clinfo;
+  const IMesh &tm;
+  const TriOverlaps &ov;
+  const Map<std::pair<int, int>, ITT_value> &itt_map;
+  IMeshArena *arena;
+};
+
+static void calc_cluster_subdivided_range_func(void *__restrict userdata,
+                                               const int iter,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ClusterSubdivideData *data = static_cast<ClusterSubdivideData *>(userdata);
+  data->r_cluster_subdivided[iter] = calc_cluster_subdivided(
+      data->clinfo, iter, data->tm, data->ov, data->itt_map, data->arena);
+}
+
+/**
+ * Subdivide all coplanar clusters. The clusters are independent of each other,
+ * so their CDTs are computed in parallel.
+ */
+static void calc_clusters_subdivided(MutableSpan<CDT_data> r_cluster_subdivided,
+                                     const CoplanarClusterInfo &clinfo,
+                                     const IMesh &tm,
+                                     const TriOverlaps &ov,
+                                     const Map<std::pair<int, int>, ITT_value> &itt_map,
+                                     IMeshArena *arena)
+{
+  ClusterSubdivideData data{r_cluster_subdivided, clinfo, tm, ov, itt_map, arena};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(
+      0, clinfo.tot_cluster(), &data, calc_cluster_subdivided_range_func, &settings);
+}
+
 static IMesh union_tri_subdivides(const blender::Array<IMesh> &tri_subdivided)
 {
   int tot_tri = 0;
@@ -2580,6 +2624,33 @@ static void degenerate_reduce(const void *__restrict UNUSED(userdata),
   degen_chunk_join->has_degenerate_tri |= degen_chunk->has_degenerate_tri;
 }
 
+/* Data and functions to populate the planes of overlapping triangles in parallel. */
+struct PopulatePlaneData {
+  const IMesh &tm;
+  const TriOverlaps &ov;
+};
+
+static void populate_plane_range_func(void *__restrict userdata,
+                                      const int iter,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PopulatePlaneData *data = static_cast<PopulatePlaneData *>(userdata);
+  if (data->ov.first_overlap_index(iter) != -1) {
+    data->tm.face(iter)->populate_plane(true);
+  }
+}
+
+/* Only the triangles that overlap some other triangle need their exact planes. */
+static void populate_overlapping_planes(const IMesh &tm, const TriOverlaps &ov)
+{
+  PopulatePlaneData data = {tm, ov};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1000;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(0, tm.face_size(), &data, populate_plane_range_func, &settings);
+}
+
 /* Does triangle #IMesh tm have any triangles with zero area? */
 static bool has_degenerate_tris(const IMesh &tm)
 {
@@ -2672,11 +2743,7 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   double overlap_time = PIL_check_seconds_timer();
   std::cout << "intersect overlaps calculated, time = " << overlap_time - bb_calc_time << "\n";
 #  endif
-  for (int t : tm_clean->face_index_range()) {
-    if (tri_ov.first_overlap_index(t) != -1) {
-      tm_clean->face(t)->populate_plane(true);
-    }
-  }
+  populate_overlapping_planes(*tm_clean, tri_ov);
 #  ifdef PERFDEBUG
   double plane_populate = PIL_check_seconds_timer();
   std::cout << "planes populated, time = " << plane_populate - overlap_time << "\n";
@@ -2708,9 +2775,7 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   std::cout << "subdivided tris found, time = " << subdivided_tris_time - itt_time << "\n";
 #  endif
   Array<CDT_data> cluster_subdivided(clinfo.tot_cluster());
-  for (int c : clinfo.index_range()) {
-    cluster_subdivided[c] = calc_cluster_subdivided(clinfo, c, *tm_clean, tri_ov, itt_map, arena);
-  }
+  calc_clusters_subdivided(cluster_subdivided, clinfo, *tm_clean, tri_ov, itt_map, arena);
 #  ifdef PERFDEBUG
   double cluster_subdivide_time = PIL_check_seconds_timer();
   std::cout << "subdivided clusters found, time = "
@@ -24,12 +24,17 @@
 
 #include "BLI_task.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #ifdef WITH_TBB
 /* Quiet top level deprecation message, unrelated to API usage here. */
 #  define TBB_SUPPRESS_DEPRECATED_MESSAGES 1
+/* Node priorities are a preview feature in older TBB versions. */
+#  define TBB_PREVIEW_FLOW_GRAPH_FEATURES 1
 #  include <tbb/flow_graph.h>
 #  include <tbb/tbb.h>
 #endif
@@ -40,6 +45,9 @@ struct TaskGraph {
   tbb::flow::graph tbb_graph;
 #endif
   std::vector<std::unique_ptr<TaskNode>> nodes;
+  /* Nodes can be created while the graph is running. */
+  std::mutex nodes_mutex;
+  std::atomic<bool> is_cancelled = false;
 
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("task_graph:TaskGraph")
@@ -52,9 +60,12 @@ struct TaskNode {
 #ifdef WITH_TBB
   tbb::flow::continue_node<tbb::flow::continue_msg> tbb_node;
 #endif
-  /* Successors to execute after this task, for serial execution fallback. */
+  /* Successors to execute after this task, for serial execution fallback. Sorted by priority. */
   std::vector<TaskNode *> successors;
 
+  TaskGraph *task_graph;
+  eTaskGraphNodePriority priority;
+
   /* User function to be executed with given task data. */
   TaskGraphNodeRunFunction run_func;
   void *task_data;
@@ -65,20 +76,21 @@ struct TaskNode {
   TaskNode(TaskGraph *task_graph,
            TaskGraphNodeRunFunction run_func,
            void *task_data,
-           TaskGraphNodeFreeFunction free_func)
+           TaskGraphNodeFreeFunction free_func,
+           eTaskGraphNodePriority priority)
       :
 #ifdef WITH_TBB
         tbb_node(task_graph->tbb_graph,
                  tbb::flow::unlimited,
-                 std::bind(&TaskNode::run, this, std::placeholders::_1)),
+                 std::bind(&TaskNode::run, this, std::placeholders::_1),
+                 tbb::flow::node_priority_t(priority)),
 #endif
+        task_graph(task_graph),
+        priority(priority),
         run_func(run_func),
         task_data(task_data),
         free_func(free_func)
   {
-#ifndef WITH_TBB
-    UNUSED_VARS(task_graph);
-#endif
   }
 
   TaskNode(const TaskNode &other) = delete;
@@ -94,13 +106,18 @@ struct TaskNode {
 #ifdef WITH_TBB
   tbb::flow::continue_msg run(const tbb::flow::continue_msg UNUSED(input))
   {
-    tbb::this_task_arena::isolate([this] { run_func(task_data); });
+    if (!task_graph->is_cancelled) {
+      tbb::this_task_arena::isolate([this] { run_func(task_data); });
+    }
     return tbb::flow::continue_msg();
   }
 #endif
 
   void run_serial()
   {
+    if (task_graph->is_cancelled) {
+      return;
+    }
     run_func(task_data);
     for (TaskNode *successor : successors) {
       successor->run_serial();
@@ -122,13 +139,34 @@ void BLI_task_graph_free(TaskGraph *task_graph)
   delete task_graph;
 }
 
-void BLI_task_graph_work_and_wait(TaskGraph *task_graph)
+bool BLI_task_graph_work_and_wait(TaskGraph *task_graph)
 {
 #ifdef WITH_TBB
   task_graph->tbb_graph.wait_for_all();
-#else
-  UNUSED_VARS(task_graph);
 #endif
+
+  if (!task_graph->is_cancelled) {
+    return true;
+  }
+#ifdef WITH_TBB
+  /* Nodes that were skipped can still hold messages from some of their predecessors. */
+  task_graph->tbb_graph.reset();
+#endif
+  task_graph->is_cancelled = false;
+  return false;
+}
+
+void BLI_task_graph_cancel(TaskGraph *task_graph)
+{
+  task_graph->is_cancelled = true;
+#ifdef WITH_TBB
+  task_graph->tbb_graph.cancel();
+#endif
+}
+
+bool BLI_task_graph_is_cancelled(const TaskGraph *task_graph)
+{
+  return task_graph->is_cancelled;
 }
 
 struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
@@ -136,13 +174,28 @@ struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
                                             void *user_data,
                                             TaskGraphNodeFreeFunction free_func)
 {
-  TaskNode *task_node = new TaskNode(task_graph, run, user_data, free_func);
+  return BLI_task_graph_node_create_ex(
+      task_graph, run, user_data, free_func, TASK_GRAPH_NODE_PRIORITY_NORMAL);
+}
+
+struct TaskNode *BLI_task_graph_node_create_ex(struct TaskGraph *task_graph,
+                                               TaskGraphNodeRunFunction run,
+                                               void *user_data,
+                                               TaskGraphNodeFreeFunction free_func,
+                                               eTaskGraphNodePriority priority)
+{
+  TaskNode *task_node = new TaskNode(task_graph, run, user_data, free_func, priority);
+  std::lock_guard lock{task_graph->nodes_mutex};
   task_graph->nodes.push_back(std::unique_ptr<TaskNode>(task_node));
   return task_node;
 }
 
 bool BLI_task_graph_node_push_work(struct TaskNode *task_node)
 {
+  if (task_node->task_graph->is_cancelled) {
+    return false;
+  }
+
 #ifdef WITH_TBB
   if (BLI_task_scheduler_num_threads() > 1) {
     return task_node->tbb_node.try_put(tbb::flow::continue_msg());
@@ -162,5 +215,13 @@ void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_
   }
 #endif
 
-  from_node->successors.push_back(to_node);
+  /* Keep the successors sorted by priority, nodes with equal priority keep their creation order. */
+  std::vector<TaskNode *> &successors = from_node->successors;
+  successors.insert(std::upper_bound(successors.begin(),
+                                     successors.end(),
+                                     to_node,
+                                     [](const TaskNode *a, const TaskNode *b) {
+                                       return a->priority > b->priority;
+                                     }),
+                    to_node);
 }
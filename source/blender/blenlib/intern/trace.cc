@@ -0,0 +1,225 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_trace.h"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+namespace blender::trace {
+
+/* Per thread, the oldest events are overwritten once it is full. */
+#define TRACE_THREAD_EVENTS_NUM (1 << 16)
+
+enum class EventType : uint8_t {
+  ZoneBegin,
+  ZoneEnd,
+  Counter,
+};
+
+struct Event {
+  const char *name;
+  /** Nanoseconds since the start of the trace. */
+  int64_t time;
+  int64_t value;
+  EventType type;
+};
+
+struct ThreadBuffer {
+  int index;
+  std::string name;
+  Array<Event> events{TRACE_THREAD_EVENTS_NUM, NoInitialization()};
+  /** Total number of events added, the ring buffer position is derived from it. */
+  int64_t events_added = 0;
+};
+
+using Clock = std::chrono::steady_clock;
+
+static std::atomic<bool> is_enabled{false};
+static Clock::time_point start_time;
+
+/* Buffers are never freed while running, since threads keep a pointer to theirs. */
+static std::mutex buffers_mutex;
+static Vector<std::unique_ptr<ThreadBuffer>> buffers;
+static thread_local ThreadBuffer *thread_buffer = nullptr;
+
+static ThreadBuffer &thread_buffer_ensure()
+{
+  if (thread_buffer == nullptr) {
+    std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+    std::lock_guard lock{buffers_mutex};
+    buffer->index = static_cast<int>(buffers.size());
+    thread_buffer = buffer.get();
+    buffers.append(std::move(buffer));
+  }
+  return *thread_buffer;
+}
+
+static void event_add(const EventType type, const char *name, const int64_t value)
+{
+  if (!is_enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  ThreadBuffer &buffer = thread_buffer_ensure();
+  Event &event = buffer.events[buffer.events_added % TRACE_THREAD_EVENTS_NUM];
+  event.name = name;
+  event.time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_time)
+                   .count();
+  event.value = value;
+  event.type = type;
+  buffer.events_added++;
+}
+
+static void write_json_string(FILE *file, const char *str)
+{
+  fputc('"', file);
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fputc('\\', file);
+      fputc(*c, file);
+    }
+    else if (static_cast<unsigned char>(*c) < 0x20) {
+      fprintf(file, "\\u%04x", static_cast<unsigned int>(*c));
+    }
+    else {
+      fputc(*c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+static void write_chrome(FILE *file)
+{
+  std::lock_guard lock{buffers_mutex};
+
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  for (const std::unique_ptr<ThreadBuffer> &buffer : buffers) {
+    const int64_t events_num = std::min<int64_t>(buffer->events_added, TRACE_THREAD_EVENTS_NUM);
+    /* Zones that began before the oldest kept event end without a begin event, which viewers
+     * ignore. */
+    for (int64_t i = buffer->events_added - events_num; i < buffer->events_added; i++) {
+      const Event &event = buffer->events[i % TRACE_THREAD_EVENTS_NUM];
+      /* Timestamps are in microseconds. */
+      const double time = event.time / 1000.0;
+      switch (event.type) {
+        case EventType::ZoneBegin:
+          fprintf(file, "{\"name\":");
+          write_json_string(file, event.name);
+          fprintf(file, ",\"ph\":\"B\",\"ts\":%.3f,\"pid\":0,\"tid\":%d},\n", time, buffer->index);
+          break;
+        case EventType::ZoneEnd:
+          fprintf(file, "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":0,\"tid\":%d},\n", time, buffer->index);
+          break;
+        case EventType::Counter:
+          fprintf(file, "{\"name\":");
+          write_json_string(file, event.name);
+          fprintf(file,
+                  ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":0,\"tid\":%d,\"args\":{\"value\":%lld}},\n",
+                  time,
+                  buffer->index,
+                  static_cast<long long>(event.value));
+          break;
+      }
+    }
+  }
+  /* Metadata, which also takes care of the trailing comma of the last event. */
+  fprintf(file,
+          "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+          "\"args\":{\"name\":\"Blender\"}}");
+  for (const std::unique_ptr<ThreadBuffer> &buffer : buffers) {
+    const std::string name = buffer->name.empty() ? "Thread " + std::to_string(buffer->index) :
+                                                    buffer->name;
+    fprintf(file,
+            ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":",
+            buffer->index);
+    write_json_string(file, name.c_str());
+    fprintf(file, "}}");
+  }
+  fprintf(file, "\n]}\n");
+}
+
+}  // namespace blender::trace
+
+namespace trace = blender::trace;
+
+void BLI_trace_start(void)
+{
+  {
+    std::lock_guard lock{trace::buffers_mutex};
+    for (std::unique_ptr<trace::ThreadBuffer> &buffer : trace::buffers) {
+      buffer->events_added = 0;
+    }
+  }
+  trace::start_time = trace::Clock::now();
+  trace::is_enabled.store(true);
+}
+
+void BLI_trace_stop(void)
+{
+  trace::is_enabled.store(false);
+}
+
+bool BLI_trace_is_enabled(void)
+{
+  return trace::is_enabled.load(std::memory_order_relaxed);
+}
+
+void BLI_trace_zone_begin(const char *name)
+{
+  trace::event_add(trace::EventType::ZoneBegin, name, 0);
+}
+
+void BLI_trace_zone_end(void)
+{
+  trace::event_add(trace::EventType::ZoneEnd, nullptr, 0);
+}
+
+void BLI_trace_counter(const char *name, int64_t value)
+{
+  trace::event_add(trace::EventType::Counter, name, value);
+}
+
+void BLI_trace_thread_name_set(const char *name)
+{
+  trace::thread_buffer_ensure().name = name;
+}
+
+/**
+ * Threads may still add events while writing, call #BLI_trace_stop first for a consistent trace.
+ */
+bool BLI_trace_write_chrome(const char *filepath)
+{
+  FILE *file = BLI_fopen(filepath, "w");
+  if (file == nullptr) {
+    return false;
+  }
+  trace::write_chrome(file);
+  fclose(file);
+  return true;
+}
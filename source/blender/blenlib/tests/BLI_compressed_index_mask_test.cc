@@ -0,0 +1,135 @@
+/* Apache License, Version 2.0 */
+
+#include "BLI_compressed_index_mask.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(compressed_index_mask, DefaultConstructor)
+{
+  CompressedIndexMask mask;
+  EXPECT_TRUE(mask.is_empty());
+  EXPECT_EQ(mask.size(), 0);
+  EXPECT_EQ(mask.min_array_size(), 0);
+  EXPECT_FALSE(mask.contains(0));
+}
+
+TEST(compressed_index_mask, FromIndexMask)
+{
+  CompressedIndexMask mask{IndexMask({1, 2, 3, 5, 8, 9})};
+  EXPECT_EQ(mask.size(), 6);
+  EXPECT_EQ(mask.ranges().size(), 3);
+  EXPECT_EQ(mask.ranges()[0], IndexRange(1, 3));
+  EXPECT_EQ(mask.ranges()[1], IndexRange(5, 1));
+  EXPECT_EQ(mask.ranges()[2], IndexRange(8, 2));
+  EXPECT_EQ(mask.min_array_size(), 10);
+  EXPECT_EQ(mask[0], 1);
+  EXPECT_EQ(mask[2], 3);
+  EXPECT_EQ(mask[3], 5);
+  EXPECT_EQ(mask[4], 8);
+  EXPECT_EQ(mask[5], 9);
+  EXPECT_TRUE(mask.contains(2));
+  EXPECT_FALSE(mask.contains(4));
+  EXPECT_TRUE(mask.contains(5));
+  EXPECT_FALSE(mask.contains(7));
+  EXPECT_FALSE(mask.contains(10));
+}
+
+TEST(compressed_index_mask, FromRanges)
+{
+  const CompressedIndexMask mask = CompressedIndexMask::from_ranges(
+      {IndexRange(0, 3), IndexRange(2, 4), IndexRange(6, 0), IndexRange(6, 2), IndexRange(10, 1)});
+  EXPECT_EQ(mask.ranges().size(), 2);
+  EXPECT_EQ(mask.ranges()[0], IndexRange(0, 8));
+  EXPECT_EQ(mask.ranges()[1], IndexRange(10, 1));
+  EXPECT_EQ(mask.size(), 9);
+}
+
+TEST(compressed_index_mask, ToIndexMask)
+{
+  Vector<int64_t> indices;
+  const CompressedIndexMask range_mask{IndexRange(4, 3)};
+  IndexMask mask = range_mask.to_index_mask(indices);
+  EXPECT_TRUE(mask.is_range());
+  EXPECT_EQ(mask.as_range(), IndexRange(4, 3));
+  EXPECT_TRUE(indices.is_empty());
+
+  const CompressedIndexMask compressed = CompressedIndexMask::from_ranges(
+      {IndexRange(1, 2), IndexRange(5, 2)});
+  mask = compressed.to_index_mask(indices);
+  EXPECT_EQ(mask.size(), 4);
+  EXPECT_EQ(mask[0], 1);
+  EXPECT_EQ(mask[1], 2);
+  EXPECT_EQ(mask[2], 5);
+  EXPECT_EQ(mask[3], 6);
+}
+
+TEST(compressed_index_mask, Union)
+{
+  const CompressedIndexMask a = CompressedIndexMask::from_ranges(
+      {IndexRange(0, 2), IndexRange(5, 5), IndexRange(20, 1)});
+  const CompressedIndexMask b = CompressedIndexMask::from_ranges(
+      {IndexRange(2, 2), IndexRange(7, 5), IndexRange(15, 1)});
+  const CompressedIndexMask result = CompressedIndexMask::from_union(a, b);
+  EXPECT_EQ(result,
+            CompressedIndexMask::from_ranges(
+                {IndexRange(0, 4), IndexRange(5, 7), IndexRange(15, 1), IndexRange(20, 1)}));
+  EXPECT_EQ(CompressedIndexMask::from_union(a, {}), a);
+}
+
+TEST(compressed_index_mask, Intersection)
+{
+  const CompressedIndexMask a = CompressedIndexMask::from_ranges(
+      {IndexRange(0, 10), IndexRange(20, 10)});
+  const CompressedIndexMask b = CompressedIndexMask::from_ranges(
+      {IndexRange(2, 2), IndexRange(8, 15), IndexRange(25, 1), IndexRange(40, 5)});
+  const CompressedIndexMask result = CompressedIndexMask::from_intersection(a, b);
+  EXPECT_EQ(result,
+            CompressedIndexMask::from_ranges(
+                {IndexRange(2, 2), IndexRange(8, 2), IndexRange(20, 3), IndexRange(25, 1)}));
+  EXPECT_TRUE(CompressedIndexMask::from_intersection(a, {}).is_empty());
+}
+
+TEST(compressed_index_mask, Difference)
+{
+  const CompressedIndexMask a = CompressedIndexMask::from_ranges(
+      {IndexRange(0, 10), IndexRange(20, 10)});
+  const CompressedIndexMask b = CompressedIndexMask::from_ranges(
+      {IndexRange(2, 2), IndexRange(8, 15), IndexRange(25, 1), IndexRange(40, 5)});
+  const CompressedIndexMask result = CompressedIndexMask::from_difference(a, b);
+  EXPECT_EQ(result,
+            CompressedIndexMask::from_ranges({IndexRange(0, 2),
+                                              IndexRange(4, 4),
+                                              IndexRange(23, 2),
+                                              IndexRange(26, 4)}));
+  EXPECT_EQ(CompressedIndexMask::from_difference(a, {}), a);
+  EXPECT_TRUE(CompressedIndexMask::from_difference(a, a).is_empty());
+}
+
+TEST(compressed_index_mask, SetOperationsMatchIndices)
+{
+  /* Compare against a simple implementation on a boolean array. */
+  const int64_t size = 200;
+  Vector<int64_t> indices_a;
+  Vector<int64_t> indices_b;
+  for (int64_t i = 0; i < size; i++) {
+    if ((i / 7) % 3 != 0) {
+      indices_a.append(i);
+    }
+    if ((i / 5) % 2 == 0 || i % 11 == 0) {
+      indices_b.append(i);
+    }
+  }
+  const CompressedIndexMask a{IndexMask(indices_a)};
+  const CompressedIndexMask b{IndexMask(indices_b)};
+  const CompressedIndexMask mask_union = CompressedIndexMask::from_union(a, b);
+  const CompressedIndexMask mask_intersection = CompressedIndexMask::from_intersection(a, b);
+  const CompressedIndexMask mask_difference = CompressedIndexMask::from_difference(a, b);
+  for (int64_t i = 0; i < size; i++) {
+    EXPECT_EQ(mask_union.contains(i), a.contains(i) || b.contains(i));
+    EXPECT_EQ(mask_intersection.contains(i), a.contains(i) && b.contains(i));
+    EXPECT_EQ(mask_difference.contains(i), a.contains(i) && !b.contains(i));
+  }
+}
+
+}  // namespace blender::tests
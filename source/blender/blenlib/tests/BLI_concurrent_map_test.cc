@@ -0,0 +1,128 @@
+/* Apache License, Version 2.0 */
+
+#include <atomic>
+#include <string>
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(concurrent_map, DefaultConstructor)
+{
+  ConcurrentMap<int, float> map;
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(5));
+  EXPECT_EQ(map.lookup_ptr(5), nullptr);
+}
+
+TEST(concurrent_map, AddAndLookup)
+{
+  ConcurrentMap<int, float> map;
+  EXPECT_TRUE(map.add(2, 5.0f));
+  EXPECT_TRUE(map.add(3, 6.0f));
+  EXPECT_FALSE(map.add(2, 7.0f));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(*map.lookup_ptr(2), 5.0f);
+  EXPECT_EQ(*map.lookup_ptr(3), 6.0f);
+  EXPECT_EQ(map.lookup_default(4, 1.0f), 1.0f);
+}
+
+TEST(concurrent_map, Grow)
+{
+  ConcurrentMap<int, int> map;
+  for (int i = 0; i < 10000; i++) {
+    map.add(i, i * 2);
+  }
+  EXPECT_EQ(map.size(), 10000);
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_EQ(*map.lookup_ptr(i), i * 2);
+  }
+  EXPECT_FALSE(map.contains(10000));
+}
+
+TEST(concurrent_map, ReferencesStayValid)
+{
+  ConcurrentMap<int, std::string> map;
+  const std::string &value = map.lookup_or_add_cb(0, []() { return std::string("hello"); });
+  for (int i = 1; i < 1000; i++) {
+    map.add(i, std::to_string(i));
+  }
+  EXPECT_EQ(value, "hello");
+  EXPECT_EQ(*map.lookup_ptr(500), "500");
+}
+
+TEST(concurrent_map, LookupOrAddCB)
+{
+  ConcurrentMap<int, int> map;
+  int calls = 0;
+  auto create = [&]() {
+    calls++;
+    return 10;
+  };
+  EXPECT_EQ(map.lookup_or_add_cb(3, create), 10);
+  EXPECT_EQ(map.lookup_or_add_cb(3, create), 10);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(concurrent_map, Clear)
+{
+  ConcurrentMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.add(i, i);
+  }
+  map.clear();
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_FALSE(map.contains(5));
+  map.add(5, 6);
+  EXPECT_EQ(*map.lookup_ptr(5), 6);
+}
+
+TEST(concurrent_map, ForeachItem)
+{
+  ConcurrentMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.add(i, i * 3);
+  }
+  int64_t key_sum = 0;
+  int64_t value_sum = 0;
+  map.foreach_item([&](const int key, const int value) {
+    key_sum += key;
+    value_sum += value;
+  });
+  EXPECT_EQ(key_sum, 4950);
+  EXPECT_EQ(value_sum, 4950 * 3);
+}
+
+TEST(concurrent_map, ParallelAddAndLookup)
+{
+  ConcurrentMap<int, int> map;
+  std::atomic<int> created_num = 0;
+  parallel_for(IndexRange(100000), 256, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      const int key = static_cast<int>(i % 5000);
+      const int value = map.lookup_or_add_cb(key, [&]() {
+        created_num++;
+        return key * 2;
+      });
+      EXPECT_EQ(value, key * 2);
+    }
+  });
+  EXPECT_EQ(created_num, 5000);
+  EXPECT_EQ(map.size(), 5000);
+}
+
+TEST(concurrent_map, StringKeys)
+{
+  ConcurrentMap<std::string, int> map;
+  map.add("a", 1);
+  map.add("bc", 2);
+  EXPECT_EQ(*map.lookup_ptr("a"), 1);
+  EXPECT_EQ(*map.lookup_ptr_as(StringRef("bc")), 2);
+  EXPECT_FALSE(map.contains("d"));
+}
+
+}  // namespace blender::tests
@@ -1,6 +1,7 @@
 /* Apache License, Version 2.0 */
 
 #include "BLI_index_mask.hh"
+#include "BLI_vector.hh"
 #include "testing/testing.h"
 
 namespace blender::tests {
@@ -40,4 +41,45 @@ TEST(index_mask, RangeConstructor)
   EXPECT_EQ(indices[2], 5);
 }
 
+TEST(index_mask, ForeachRange)
+{
+  Vector<IndexRange> ranges;
+  IndexMask({2, 3, 4, 6, 7, 10, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 30})
+      .foreach_range([&](IndexRange range) { ranges.append(range); });
+  EXPECT_EQ(ranges.size(), 5);
+  EXPECT_EQ(ranges[0], IndexRange(2, 3));
+  EXPECT_EQ(ranges[1], IndexRange(6, 2));
+  EXPECT_EQ(ranges[2], IndexRange(10, 1));
+  EXPECT_EQ(ranges[3], IndexRange(12, 11));
+  EXPECT_EQ(ranges[4], IndexRange(30, 1));
+}
+
+TEST(index_mask, ForeachRangeSingleRange)
+{
+  Vector<IndexRange> ranges;
+  IndexMask(IndexRange(5, 100)).foreach_range([&](IndexRange range) { ranges.append(range); });
+  EXPECT_EQ(ranges.size(), 1);
+  EXPECT_EQ(ranges[0], IndexRange(5, 100));
+
+  ranges.clear();
+  IndexMask().foreach_range([&](IndexRange range) { ranges.append(range); });
+  EXPECT_TRUE(ranges.is_empty());
+}
+
+TEST(index_mask, ForeachRangeLongRanges)
+{
+  Vector<int64_t> indices;
+  for (int64_t i = 0; i < 1000; i++) {
+    if (i % 100 != 0) {
+      indices.append(i);
+    }
+  }
+  Vector<IndexRange> ranges;
+  IndexMask(indices).foreach_range([&](IndexRange range) { ranges.append(range); });
+  EXPECT_EQ(ranges.size(), 10);
+  for (const int64_t i : ranges.index_range()) {
+    EXPECT_EQ(ranges[i], IndexRange(i * 100 + 1, 99));
+  }
+}
+
 }  // namespace blender::tests
@@ -1,6 +1,7 @@
 /* Apache License, Version 2.0 */
 
 #include "BLI_linear_allocator.hh"
+#include "BLI_linear_allocator_containers.hh"
 #include "BLI_strict_flags.h"
 #include "testing/testing.h"
 
@@ -115,4 +116,70 @@ TEST(linear_allocator, ConstructArrayCopy)
   EXPECT_EQ(span2[2], 3);
 }
 
+TEST(linear_allocator, LinearVector)
+{
+  LinearAllocator<> allocator;
+
+  LinearVector<int> vector{allocator};
+  for (int i = 0; i < 1000; i++) {
+    vector.append(i);
+  }
+  EXPECT_EQ(vector.size(), 1000);
+  EXPECT_EQ(vector[567], 567);
+
+  LinearVector<int> vector_copy = vector;
+  vector.clear_and_make_inline();
+  EXPECT_EQ(vector.size(), 0);
+  EXPECT_EQ(vector_copy.size(), 1000);
+  EXPECT_EQ(vector_copy.last(), 999);
+
+  LinearVector<int> vector_moved = std::move(vector_copy);
+  EXPECT_EQ(vector_moved.size(), 1000);
+  EXPECT_EQ(vector_moved[10], 10);
+}
+
+TEST(linear_allocator, LinearMap)
+{
+  LinearAllocator<> allocator;
+
+  LinearMap<int, std::string> map{allocator};
+  for (int i = 0; i < 500; i++) {
+    map.add_new(i, std::to_string(i));
+  }
+  EXPECT_EQ(map.size(), 500);
+  EXPECT_EQ(map.lookup(123), "123");
+  EXPECT_TRUE(map.remove(123));
+  EXPECT_FALSE(map.contains(123));
+
+  LinearMap<int, std::string> map_copy = map;
+  EXPECT_EQ(map_copy.size(), 499);
+  EXPECT_EQ(map_copy.lookup(321), "321");
+}
+
+TEST(linear_allocator, LinearSet)
+{
+  LinearAllocator<> allocator;
+
+  LinearSet<int> set{allocator};
+  for (int i = 0; i < 500; i++) {
+    set.add(i % 100);
+  }
+  EXPECT_EQ(set.size(), 100);
+  EXPECT_TRUE(set.contains(42));
+  EXPECT_FALSE(set.contains(100));
+}
+
+TEST(linear_allocator, LinearVectorSet)
+{
+  LinearAllocator<> allocator;
+
+  LinearVectorSet<int> set{allocator};
+  for (int i = 0; i < 500; i++) {
+    set.add(i % 100);
+  }
+  EXPECT_EQ(set.size(), 100);
+  EXPECT_EQ(set.index_of(42), 42);
+  EXPECT_EQ(set[99], 99);
+}
+
 }  // namespace blender::tests
@@ -568,6 +568,61 @@ TEST(map, AddOrModifyExceptions)
 /**
  * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
  */
+TEST(map, AddMultiple)
+{
+  Map<int, int> map;
+  map.add(3, 100);
+  Vector<int> keys;
+  Vector<int> values;
+  for (int i = 0; i < 100; i++) {
+    keys.append(i % 50);
+    values.append(i);
+  }
+  map.add_multiple(keys, values);
+  EXPECT_EQ(map.size(), 50);
+  EXPECT_EQ(map.lookup(3), 100);
+  EXPECT_EQ(map.lookup(10), 10);
+  EXPECT_EQ(map.lookup(49), 49);
+}
+
+TEST(map, AddMultipleNew)
+{
+  Map<int, int> map;
+  Vector<int> keys;
+  Vector<int> values;
+  for (int i = 0; i < 1000; i++) {
+    keys.append(i * 3);
+    values.append(i);
+  }
+  map.add_multiple_new(keys, values);
+  EXPECT_EQ(map.size(), 1000);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(map.lookup(i * 3), i);
+  }
+}
+
+TEST(map, LookupMultiplePtr)
+{
+  Map<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.add(i * 2, i);
+  }
+  Vector<int> keys;
+  for (int i = 0; i < 200; i++) {
+    keys.append(i);
+  }
+  Array<const int *> values(keys.size());
+  map.lookup_multiple_ptr(keys, values);
+  for (int i = 0; i < 200; i++) {
+    if (i % 2 == 0) {
+      EXPECT_EQ(*values[i], i / 2);
+    }
+    else {
+      EXPECT_EQ(values[i], nullptr);
+    }
+  }
+}
+
 #if 0
 template<typename MapT>
 BLI_NOINLINE void benchmark_random_ints(StringRef name, int amount, int factor)
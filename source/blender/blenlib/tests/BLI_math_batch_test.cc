@@ -0,0 +1,111 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_math_batch.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "BLI_rand.hh"
+
+namespace blender::tests {
+
+static Array<float3> random_vectors(const int64_t size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<float3> vectors(size);
+  for (float3 &vector : vectors) {
+    vector = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 20.0f - float3(10.0f);
+  }
+  return vectors;
+}
+
+static float4x4 test_matrix()
+{
+  float4x4 matrix;
+  const float loc[3] = {1.0f, -2.0f, 3.0f};
+  const float rot[3] = {0.3f, 1.2f, -0.7f};
+  const float size[3] = {2.0f, 0.5f, 1.5f};
+  loc_eul_size_to_mat4(matrix.values, loc, rot, size);
+  return matrix;
+}
+
+/* Use sizes that are not a multiple of four, to also test the scalar code path. */
+static const int64_t test_sizes[] = {0, 1, 3, 4, 7, 64, 1001};
+
+TEST(math_batch, TransformPoints)
+{
+  const float4x4 matrix = test_matrix();
+  for (const int64_t size : test_sizes) {
+    const Array<float3> src = random_vectors(size, 0);
+    Array<float3> dst(size);
+    transform_points(matrix, src, dst);
+    for (const int64_t i : src.index_range()) {
+      const float3 expected = matrix * src[i];
+      EXPECT_V3_NEAR(dst[i], expected, 1e-5f);
+    }
+  }
+}
+
+TEST(math_batch, TransformPointsInPlace)
+{
+  const float4x4 matrix = test_matrix();
+  const Array<float3> src = random_vectors(103, 1);
+  Array<float3> positions = src;
+  transform_points(matrix, positions);
+  for (const int64_t i : src.index_range()) {
+    const float3 expected = matrix * src[i];
+    EXPECT_V3_NEAR(positions[i], expected, 1e-5f);
+  }
+}
+
+TEST(math_batch, TransformDirections)
+{
+  const float4x4 matrix = test_matrix();
+  for (const int64_t size : test_sizes) {
+    const Array<float3> src = random_vectors(size, 2);
+    Array<float3> dst(size);
+    transform_directions(matrix, src, dst);
+    for (const int64_t i : src.index_range()) {
+      const float3 expected = matrix.ref_3x3() * src[i];
+      EXPECT_V3_NEAR(dst[i], expected, 1e-5f);
+    }
+  }
+}
+
+TEST(math_batch, NormalizeVectors)
+{
+  for (const int64_t size : test_sizes) {
+    const Array<float3> src = random_vectors(size, 3);
+    Array<float3> vectors = src;
+    if (size > 2) {
+      /* Vectors that are too short are set to zero. */
+      vectors[1] = float3(0.0f);
+      vectors[2] = float3(1e-20f);
+    }
+    normalize_vectors(vectors);
+    for (const int64_t i : src.index_range()) {
+      if (size > 2 && ELEM(i, 1, 2)) {
+        EXPECT_EQ(vectors[i], float3(0.0f));
+      }
+      else {
+        EXPECT_V3_NEAR(vectors[i], src[i].normalized(), 1e-6f);
+      }
+    }
+  }
+}
+
+TEST(math_batch, DotProducts)
+{
+  for (const int64_t size : test_sizes) {
+    const Array<float3> a = random_vectors(size, 4);
+    const Array<float3> b = random_vectors(size, 5);
+    Array<float> dots(size);
+    dot_products(a, b, dots);
+    for (const int64_t i : a.index_range()) {
+      EXPECT_NEAR(dots[i], float3::dot(a[i], b[i]), 1e-4f);
+    }
+  }
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,107 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+
+#include "BLI_mempool.h"
+#include "BLI_set.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+struct Elem {
+  int thread_index;
+  int index;
+};
+
+TEST(mempool, ThreadedAllocIter)
+{
+  BLI_mempool *pool = BLI_mempool_create(sizeof(Elem), 0, 64, BLI_MEMPOOL_ALLOW_ITER);
+  /* Some elements allocated without a thread cache. */
+  for (int i = 0; i < 10; i++) {
+    Elem *elem = (Elem *)BLI_mempool_alloc(pool);
+    elem->thread_index = -1;
+    elem->index = i;
+  }
+
+  const int threads_num = 4;
+  const int elems_per_thread = 1000;
+  Vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < threads_num; thread_index++) {
+    threads.append(std::thread([pool, thread_index]() {
+      BLI_mempool_thread_cache cache;
+      BLI_mempool_thread_cache_init(pool, &cache);
+      for (int i = 0; i < elems_per_thread; i++) {
+        Elem *elem = (Elem *)BLI_mempool_thread_alloc(&cache);
+        elem->thread_index = thread_index;
+        elem->index = i;
+        /* Free some of the elements again. */
+        if (i % 4 == 3) {
+          BLI_mempool_thread_free(&cache, elem);
+        }
+      }
+      BLI_mempool_thread_cache_flush(&cache);
+    }));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  const int expected_len = 10 + threads_num * elems_per_thread * 3 / 4;
+  EXPECT_EQ(BLI_mempool_len(pool), expected_len);
+
+  Set<std::pair<int, int>> found;
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(pool, &iter);
+  Elem *elem;
+  while ((elem = (Elem *)BLI_mempool_iterstep(&iter))) {
+    EXPECT_NE(elem->index % 4 == 3 && elem->thread_index >= 0, true);
+    EXPECT_TRUE(found.add({elem->thread_index, elem->index}));
+  }
+  EXPECT_EQ(found.size(), expected_len);
+
+  /* The pool can be used without thread caches again. */
+  elem = (Elem *)BLI_mempool_alloc(pool);
+  EXPECT_EQ(BLI_mempool_len(pool), expected_len + 1);
+  BLI_mempool_free(pool, elem);
+
+  BLI_mempool_destroy(pool);
+}
+
+TEST(mempool, ThreadedFree)
+{
+  BLI_mempool *pool = BLI_mempool_create(sizeof(int), 0, 32, BLI_MEMPOOL_ALLOW_ITER);
+  Vector<int *> elems;
+  for (int i = 0; i < 1000; i++) {
+    elems.append((int *)BLI_mempool_calloc(pool));
+  }
+
+  Vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < 4; thread_index++) {
+    threads.append(std::thread([pool, thread_index, &elems]() {
+      BLI_mempool_thread_cache cache;
+      BLI_mempool_thread_cache_init(pool, &cache);
+      for (int i = thread_index; i < elems.size(); i += 4) {
+        BLI_mempool_thread_free(&cache, elems[i]);
+      }
+      /* Reuse some of the freed elements. */
+      int *elem = (int *)BLI_mempool_thread_calloc(&cache);
+      EXPECT_EQ(*elem, 0);
+      BLI_mempool_thread_free(&cache, elem);
+      BLI_mempool_thread_cache_flush(&cache);
+    }));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(BLI_mempool_len(pool), 0);
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(pool, &iter);
+  EXPECT_EQ(BLI_mempool_iterstep(&iter), nullptr);
+
+  BLI_mempool_destroy(pool);
+}
+
+}  // namespace blender::tests
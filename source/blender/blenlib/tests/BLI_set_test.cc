@@ -192,6 +192,31 @@ TEST(set, AddMultipleNew)
   EXPECT_TRUE(a.contains(6));
 }
 
+TEST(set, AddMultipleLarge)
+{
+  Vector<int> keys;
+  for (int i = 0; i < 1000; i++) {
+    keys.append(i % 300);
+  }
+  Set<int> set;
+  set.add_multiple(keys);
+  EXPECT_EQ(set.size(), 300);
+  for (int i = 0; i < 300; i++) {
+    EXPECT_TRUE(set.contains(i));
+  }
+}
+
+TEST(set, ContainsMultiple)
+{
+  Set<int> set = {1, 5, 7, 100};
+  Array<bool> contained(4);
+  set.contains_multiple({5, 6, 100, 1000}, contained);
+  EXPECT_TRUE(contained[0]);
+  EXPECT_FALSE(contained[1]);
+  EXPECT_TRUE(contained[2]);
+  EXPECT_FALSE(contained[3]);
+}
+
 TEST(set, Iterator)
 {
   Set<int> set = {1, 3, 2, 5, 4};
@@ -0,0 +1,52 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_rand.hh"
+#include "BLI_sort.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+static Array<int> random_ints(const int64_t size)
+{
+  RandomNumberGenerator rng(42);
+  Array<int> values(size);
+  for (int &value : values) {
+    value = rng.get_int32(1000);
+  }
+  return values;
+}
+
+TEST(sort, ParallelSort)
+{
+  for (const int64_t size : {0, 1, 10, 4095, 4096, 100000}) {
+    Array<int> values = random_ints(size);
+    Array<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+    parallel_sort(values.as_mutable_span());
+    EXPECT_EQ_ARRAY(values.data(), expected.data(), size);
+  }
+}
+
+TEST(sort, ParallelSortComparator)
+{
+  Array<int> values = random_ints(50000);
+  parallel_sort(values.as_mutable_span(), std::greater<>(), 1024);
+  for (int64_t i = 0; i < values.size() - 1; i++) {
+    EXPECT_GE(values[i], values[i + 1]);
+  }
+}
+
+TEST(sort, ParallelSortIterators)
+{
+  Vector<std::string> values = {"d", "b", "c", "a"};
+  parallel_sort(values.begin(), values.end());
+  EXPECT_EQ(values[0], "a");
+  EXPECT_EQ(values[1], "b");
+  EXPECT_EQ(values[2], "c");
+  EXPECT_EQ(values[3], "d");
+}
+
+}  // namespace blender::tests
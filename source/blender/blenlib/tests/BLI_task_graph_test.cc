@@ -188,3 +188,108 @@ TEST(task, GraphTaskData)
   EXPECT_EQ(1, data.value);
   EXPECT_EQ(0, data.store);
 }
+
+struct GraphTaskData {
+  TaskGraph *graph;
+  int value;
+};
+
+static void GraphTaskData_increase_value(void *taskdata)
+{
+  GraphTaskData *data = (GraphTaskData *)taskdata;
+  data->value += 1;
+}
+
+static void GraphTaskData_increase_value_and_cancel(void *taskdata)
+{
+  GraphTaskData *data = (GraphTaskData *)taskdata;
+  data->value += 1;
+  BLI_task_graph_cancel(data->graph);
+}
+
+static void GraphTaskData_increase_value_and_push_node(void *taskdata)
+{
+  GraphTaskData *data = (GraphTaskData *)taskdata;
+  data->value += 1;
+  TaskNode *node = BLI_task_graph_node_create(
+      data->graph, GraphTaskData_increase_value, data, nullptr);
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node));
+}
+
+TEST(task, GraphCancel)
+{
+  TaskGraph *graph = BLI_task_graph_create();
+  GraphTaskData data = {graph, 0};
+
+  TaskNode *node_a = BLI_task_graph_node_create(
+      graph, GraphTaskData_increase_value, &data, nullptr);
+  TaskNode *node_b = BLI_task_graph_node_create(
+      graph, GraphTaskData_increase_value_and_cancel, &data, nullptr);
+  TaskNode *node_c = BLI_task_graph_node_create(
+      graph, GraphTaskData_increase_value, &data, nullptr);
+  BLI_task_graph_edge_create(node_a, node_b);
+  BLI_task_graph_edge_create(node_b, node_c);
+
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_a));
+  /* `node_c` is not executed because `node_b` cancels the graph. */
+  EXPECT_FALSE(BLI_task_graph_work_and_wait(graph));
+  EXPECT_EQ(2, data.value);
+
+  /* The graph can be reused after it has been cancelled. */
+  EXPECT_FALSE(BLI_task_graph_is_cancelled(graph));
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_c));
+  EXPECT_TRUE(BLI_task_graph_work_and_wait(graph));
+  EXPECT_EQ(3, data.value);
+
+  BLI_task_graph_free(graph);
+}
+
+TEST(task, GraphCancelBeforePush)
+{
+  TaskGraph *graph = BLI_task_graph_create();
+  GraphTaskData data = {graph, 0};
+
+  TaskNode *node_a = BLI_task_graph_node_create(
+      graph, GraphTaskData_increase_value, &data, nullptr);
+  BLI_task_graph_cancel(graph);
+  EXPECT_TRUE(BLI_task_graph_is_cancelled(graph));
+  EXPECT_FALSE(BLI_task_graph_node_push_work(node_a));
+  EXPECT_FALSE(BLI_task_graph_work_and_wait(graph));
+  EXPECT_EQ(0, data.value);
+
+  BLI_task_graph_free(graph);
+}
+
+TEST(task, GraphDynamicNodes)
+{
+  TaskGraph *graph = BLI_task_graph_create();
+  GraphTaskData data = {graph, 0};
+
+  TaskNode *node_a = BLI_task_graph_node_create(
+      graph, GraphTaskData_increase_value_and_push_node, &data, nullptr);
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_a));
+  EXPECT_TRUE(BLI_task_graph_work_and_wait(graph));
+  EXPECT_EQ(2, data.value);
+
+  BLI_task_graph_free(graph);
+}
+
+TEST(task, GraphPriority)
+{
+  TaskData data = {1};
+
+  TaskGraph *graph = BLI_task_graph_create();
+  TaskNode *node_a = BLI_task_graph_node_create(graph, TaskData_increase_value, &data, nullptr);
+  TaskNode *node_b = BLI_task_graph_node_create_ex(
+      graph, TaskData_store_value, &data, nullptr, TASK_GRAPH_NODE_PRIORITY_HIGH);
+  TaskNode *node_c = BLI_task_graph_node_create_ex(
+      graph, TaskData_multiply_by_two_store, &data, nullptr, TASK_GRAPH_NODE_PRIORITY_HIGH);
+  BLI_task_graph_edge_create(node_a, node_b);
+  BLI_task_graph_edge_create(node_b, node_c);
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_a));
+  EXPECT_TRUE(BLI_task_graph_work_and_wait(graph));
+
+  EXPECT_EQ(2, data.value);
+  EXPECT_EQ(4, data.store);
+  BLI_task_graph_free(graph);
+}
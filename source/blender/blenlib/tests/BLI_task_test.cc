@@ -1,6 +1,7 @@
 /* Apache License, Version 2.0 */
 
 #include "testing/testing.h"
+#include <atomic>
 #include <cstring>
 
 #include "atomic_ops.h"
@@ -9,9 +10,13 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_array.hh"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #define NUM_ITEMS 10000
 
@@ -181,3 +186,126 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** C++ parallel algorithms. *** */
+
+namespace blender::tests {
+
+TEST(task, ParallelReduce)
+{
+  Array<int> data(NUM_ITEMS);
+  for (const int i : data.index_range()) {
+    data[i] = i;
+  }
+  const int64_t sum = parallel_reduce(
+      data.index_range(),
+      100,
+      int64_t(0),
+      [&](IndexRange range, int64_t value) {
+        for (const int i : range) {
+          value += data[i];
+        }
+        return value;
+      },
+      [](const int64_t a, const int64_t b) { return a + b; });
+  EXPECT_EQ(sum, int64_t(NUM_ITEMS) * (NUM_ITEMS - 1) / 2);
+}
+
+TEST(task, ParallelReduceEmptyRange)
+{
+  const int result = parallel_reduce(
+      IndexRange(0),
+      1,
+      42,
+      [](IndexRange UNUSED(range), int value) { return value + 1; },
+      [](const int a, const int b) { return a + b; });
+  EXPECT_EQ(result, 42);
+}
+
+TEST(task, ParallelInvoke)
+{
+  std::atomic<int> counter = 0;
+  parallel_invoke([&]() { counter++; }, [&]() { counter += 10; }, [&]() { counter += 100; });
+  EXPECT_EQ(counter, 111);
+}
+
+TEST(task, EnumerableThreadSpecific)
+{
+  EnumerableThreadSpecific<int64_t> partial_sums;
+  parallel_for(IndexRange(NUM_ITEMS), 32, [&](IndexRange range) {
+    int64_t &local_sum = partial_sums.local();
+    for (const int i : range) {
+      local_sum += i;
+    }
+  });
+  int64_t sum = 0;
+  for (const int64_t partial_sum : partial_sums) {
+    sum += partial_sum;
+  }
+  EXPECT_EQ(sum, int64_t(NUM_ITEMS) * (NUM_ITEMS - 1) / 2);
+}
+
+TEST(task, EnumerableThreadSpecificInitializer)
+{
+  EnumerableThreadSpecific<Vector<int>> local_values([]() { return Vector<int>({1, 2}); });
+  parallel_for(IndexRange(NUM_ITEMS), 32, [&](IndexRange range) {
+    Vector<int> &values = local_values.local();
+    for (const int i : range) {
+      values.append(i);
+    }
+  });
+  int64_t total_size = 0;
+  for (const Vector<int> &values : local_values) {
+    EXPECT_EQ(values[0], 1);
+    EXPECT_EQ(values[1], 2);
+    total_size += values.size() - 2;
+  }
+  EXPECT_EQ(total_size, NUM_ITEMS);
+}
+
+TEST(task, ParallelExclusiveScan)
+{
+  Array<int> src(NUM_ITEMS);
+  for (const int i : src.index_range()) {
+    src[i] = i % 7;
+  }
+  Array<int> dst(NUM_ITEMS);
+  const int total = parallel_exclusive_scan<int>(src, dst, 64);
+
+  int expected = 0;
+  for (const int i : src.index_range()) {
+    EXPECT_EQ(dst[i], expected);
+    expected += src[i];
+  }
+  EXPECT_EQ(total, expected);
+}
+
+TEST(task, ParallelExclusiveScanInPlace)
+{
+  Array<int64_t> values(NUM_ITEMS, 3);
+  const int64_t total = parallel_exclusive_scan<int64_t>(values, values, 100);
+  for (const int i : values.index_range()) {
+    EXPECT_EQ(values[i], i * 3);
+  }
+  EXPECT_EQ(total, NUM_ITEMS * 3);
+}
+
+TEST(task, ParallelExclusiveScanCustomReduction)
+{
+  Array<int> src = {3, 1, 4, 1, 5, 9, 2, 6};
+  Array<int> dst(src.size());
+  const int max = parallel_exclusive_scan<int>(
+      src, dst, 1, 0, [](const int a, const int b) { return std::max(a, b); });
+  EXPECT_EQ(max, 9);
+  EXPECT_EQ(dst[0], 0);
+  EXPECT_EQ(dst[1], 3);
+  EXPECT_EQ(dst[3], 4);
+  EXPECT_EQ(dst[6], 9);
+}
+
+TEST(task, ParallelExclusiveScanEmpty)
+{
+  EXPECT_EQ(parallel_exclusive_scan<int>({}, {}, 1), 0);
+}
+
+}  // namespace blender::tests
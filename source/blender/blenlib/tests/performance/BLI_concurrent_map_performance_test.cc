@@ -0,0 +1,121 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <mutex>
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_ghash.h"
+#include "BLI_hash.h"
+#include "BLI_map.hh"
+#include "BLI_task.hh"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+#include "PIL_time_utildefines.h"
+
+/* Compares the contention of #blender::ConcurrentMap with a #GHash and a #blender::Map that are
+ * protected by a global mutex, which is what most code used so far. */
+
+#define KEYS_NUM 100000
+#define LOOKUPS_NUM 10000000
+/* Every n-th access adds a new key in the mixed tests. */
+#define MIXED_ADD_FREQUENCY 50
+
+namespace blender::tests {
+
+static uint key_for_index(const int64_t index)
+{
+  return BLI_hash_int(static_cast<uint>(index)) % KEYS_NUM;
+}
+
+TEST(concurrent_map, ParallelLookupConcurrentMap)
+{
+  ConcurrentMap<uint, uint> map;
+  for (uint i = 0; i < KEYS_NUM; i++) {
+    map.add(i, i);
+  }
+
+  TIMEIT_START(concurrent_map_lookup);
+  parallel_for(IndexRange(LOOKUPS_NUM), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      const uint key = key_for_index(i);
+      EXPECT_EQ(*map.lookup_ptr(key), key);
+    }
+  });
+  TIMEIT_END(concurrent_map_lookup);
+}
+
+TEST(concurrent_map, ParallelLookupMapWithMutex)
+{
+  Map<uint, uint> map;
+  std::mutex mutex;
+  for (uint i = 0; i < KEYS_NUM; i++) {
+    map.add(i, i);
+  }
+
+  TIMEIT_START(locked_map_lookup);
+  parallel_for(IndexRange(LOOKUPS_NUM), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      const uint key = key_for_index(i);
+      std::lock_guard lock{mutex};
+      EXPECT_EQ(map.lookup(key), key);
+    }
+  });
+  TIMEIT_END(locked_map_lookup);
+}
+
+TEST(concurrent_map, ParallelLookupGHashWithMutex)
+{
+  GHash *ghash = BLI_ghash_int_new(__func__);
+  ThreadMutex mutex = BLI_MUTEX_INITIALIZER;
+  for (uint i = 0; i < KEYS_NUM; i++) {
+    BLI_ghash_insert(ghash, POINTER_FROM_UINT(i), POINTER_FROM_UINT(i));
+  }
+
+  TIMEIT_START(locked_ghash_lookup);
+  parallel_for(IndexRange(LOOKUPS_NUM), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      const uint key = key_for_index(i);
+      BLI_mutex_lock(&mutex);
+      void *value = BLI_ghash_lookup(ghash, POINTER_FROM_UINT(key));
+      BLI_mutex_unlock(&mutex);
+      EXPECT_EQ(POINTER_AS_UINT(value), key);
+    }
+  });
+  TIMEIT_END(locked_ghash_lookup);
+
+  BLI_ghash_free(ghash, nullptr, nullptr);
+}
+
+TEST(concurrent_map, ParallelMixedConcurrentMap)
+{
+  ConcurrentMap<uint, uint> map;
+
+  TIMEIT_START(concurrent_map_mixed);
+  parallel_for(IndexRange(LOOKUPS_NUM), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      const uint key = key_for_index(i / MIXED_ADD_FREQUENCY);
+      EXPECT_EQ(map.lookup_or_add_cb(key, [&]() { return key; }), key);
+    }
+  });
+  TIMEIT_END(concurrent_map_mixed);
+}
+
+TEST(concurrent_map, ParallelMixedMapWithMutex)
+{
+  Map<uint, uint> map;
+  std::mutex mutex;
+
+  TIMEIT_START(locked_map_mixed);
+  parallel_for(IndexRange(LOOKUPS_NUM), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      const uint key = key_for_index(i / MIXED_ADD_FREQUENCY);
+      std::lock_guard lock{mutex};
+      EXPECT_EQ(map.lookup_or_add_cb(key, [&]() { return key; }), key);
+    }
+  });
+  TIMEIT_END(locked_map_mixed);
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,195 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_hash.h"
+#include "BLI_index_mask.hh"
+#include "BLI_map.hh"
+#include "BLI_set.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+#include "PIL_time_utildefines.h"
+
+/* Standard workloads for the core containers, to compare their performance before and after a
+ * change. The results are checked so the compiler can't optimize the work away. */
+
+#define ELEMENTS_NUM 1000000
+#define LOOKUPS_NUM 10000000
+
+namespace blender::tests {
+
+static int random_key(const int64_t index)
+{
+  return static_cast<int>(BLI_hash_int(static_cast<uint>(index)) % ELEMENTS_NUM);
+}
+
+static std::string string_key(const int64_t index)
+{
+  return "key_" + std::to_string(index);
+}
+
+TEST(containers_performance, VectorAppend)
+{
+  int64_t sum = 0;
+  TIMEIT_START(vector_append);
+  for (int repeat = 0; repeat < 10; repeat++) {
+    Vector<int> vector;
+    for (int i = 0; i < ELEMENTS_NUM; i++) {
+      vector.append(i);
+    }
+    sum += vector.size();
+  }
+  TIMEIT_END(vector_append);
+  EXPECT_EQ(sum, 10 * ELEMENTS_NUM);
+}
+
+TEST(containers_performance, VectorAppendReserved)
+{
+  int64_t sum = 0;
+  TIMEIT_START(vector_append_reserved);
+  for (int repeat = 0; repeat < 10; repeat++) {
+    Vector<int> vector;
+    vector.reserve(ELEMENTS_NUM);
+    for (int i = 0; i < ELEMENTS_NUM; i++) {
+      vector.append_unchecked(i);
+    }
+    sum += vector.size();
+  }
+  TIMEIT_END(vector_append_reserved);
+  EXPECT_EQ(sum, 10 * ELEMENTS_NUM);
+}
+
+TEST(containers_performance, VectorAppendString)
+{
+  Vector<std::string> vector;
+  TIMEIT_START(vector_append_string);
+  for (int i = 0; i < ELEMENTS_NUM; i++) {
+    vector.append(string_key(i));
+  }
+  TIMEIT_END(vector_append_string);
+  EXPECT_EQ(vector.size(), ELEMENTS_NUM);
+}
+
+TEST(containers_performance, MapAddLookupInt)
+{
+  Map<int, int> map;
+  TIMEIT_START(map_add_int);
+  for (int i = 0; i < ELEMENTS_NUM; i++) {
+    map.add_new(i, i);
+  }
+  TIMEIT_END(map_add_int);
+
+  int64_t sum = 0;
+  TIMEIT_START(map_lookup_int);
+  for (int64_t i = 0; i < LOOKUPS_NUM; i++) {
+    sum += map.lookup(random_key(i));
+  }
+  TIMEIT_END(map_lookup_int);
+  EXPECT_GT(sum, 0);
+}
+
+TEST(containers_performance, MapAddLookupString)
+{
+  Vector<std::string> keys;
+  for (int i = 0; i < ELEMENTS_NUM; i++) {
+    keys.append(string_key(i));
+  }
+
+  Map<std::string, int> map;
+  TIMEIT_START(map_add_string);
+  for (int i = 0; i < ELEMENTS_NUM; i++) {
+    map.add_new(keys[i], i);
+  }
+  TIMEIT_END(map_add_string);
+
+  int64_t sum = 0;
+  TIMEIT_START(map_lookup_string);
+  for (int64_t i = 0; i < LOOKUPS_NUM / 10; i++) {
+    /* Look up by #StringRef, to avoid constructing strings in the timed loop. */
+    sum += map.lookup_as(StringRef(keys[random_key(i)]));
+  }
+  TIMEIT_END(map_lookup_string);
+  EXPECT_GT(sum, 0);
+}
+
+TEST(containers_performance, MapRemove)
+{
+  Map<int, int> map;
+  for (int i = 0; i < ELEMENTS_NUM; i++) {
+    map.add_new(i, i);
+  }
+  TIMEIT_START(map_remove);
+  for (int i = 0; i < ELEMENTS_NUM; i++) {
+    map.remove(i);
+  }
+  TIMEIT_END(map_remove);
+  EXPECT_EQ(map.size(), 0);
+}
+
+TEST(containers_performance, SetAddContains)
+{
+  Set<int> set;
+  TIMEIT_START(set_add);
+  for (int i = 0; i < ELEMENTS_NUM; i++) {
+    set.add(random_key(i));
+  }
+  TIMEIT_END(set_add);
+
+  int64_t found = 0;
+  TIMEIT_START(set_contains);
+  for (int64_t i = 0; i < LOOKUPS_NUM; i++) {
+    found += set.contains(random_key(i + ELEMENTS_NUM));
+  }
+  TIMEIT_END(set_contains);
+  EXPECT_GT(found, 0);
+}
+
+TEST(containers_performance, VectorSetAddIndexOf)
+{
+  VectorSet<int> vector_set;
+  TIMEIT_START(vector_set_add);
+  for (int i = 0; i < ELEMENTS_NUM; i++) {
+    vector_set.add(random_key(i));
+  }
+  TIMEIT_END(vector_set_add);
+
+  int64_t sum = 0;
+  TIMEIT_START(vector_set_index_of);
+  for (int64_t i = 0; i < LOOKUPS_NUM; i++) {
+    sum += vector_set.index_of_try(random_key(i));
+  }
+  TIMEIT_END(vector_set_index_of);
+  EXPECT_GT(sum, 0);
+}
+
+TEST(containers_performance, IndexMaskForeach)
+{
+  Vector<int64_t> indices;
+  for (int64_t i = 0; i < ELEMENTS_NUM; i += 2) {
+    indices.append(i);
+  }
+  Array<float> values(ELEMENTS_NUM, 1.0f);
+
+  /* Masks that are a range are handled separately by #foreach_index. */
+  const IndexMask range_mask(ELEMENTS_NUM);
+  const IndexMask indices_mask(indices);
+
+  float sum = 0.0f;
+  TIMEIT_START(index_mask_foreach_range);
+  for (int repeat = 0; repeat < 100; repeat++) {
+    range_mask.foreach_index([&](const int64_t i) { sum += values[i]; });
+  }
+  TIMEIT_END(index_mask_foreach_range);
+
+  TIMEIT_START(index_mask_foreach_indices);
+  for (int repeat = 0; repeat < 100; repeat++) {
+    indices_mask.foreach_index([&](const int64_t i) { sum += values[i]; });
+  }
+  TIMEIT_END(index_mask_foreach_indices);
+  EXPECT_GT(sum, 0.0f);
+}
+
+}  // namespace blender::tests
@@ -11,9 +11,13 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
+#include "BLI_rand.hh"
+#include "BLI_sort.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "PIL_time.h"
 
@@ -208,3 +212,76 @@ TEST(task, ListBaseIter100k)
 {
   task_listbase_test("ListBase parallel iteration - Threaded - 100000 items", 100000, true);
 }
+
+/* *** Parallel sort and scan over spans. *** */
+
+namespace blender::tests {
+
+static void parallel_sort_test(const char *id, const int64_t size, const int64_t grain_size)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  RandomNumberGenerator rng(0);
+  Array<int> values(size);
+  double averaged_timing = 0.0;
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    for (int &value : values) {
+      value = rng.get_int32();
+    }
+    const double init_time = PIL_check_seconds_timer();
+    parallel_sort(values.as_mutable_span(), std::less<>(), grain_size);
+    averaged_timing += PIL_check_seconds_timer() - init_time;
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  }
+
+  printf("\t%s: done in %fs on average over %d runs\n",
+         id,
+         averaged_timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+}
+
+static void parallel_exclusive_scan_test(const char *id,
+                                         const int64_t size,
+                                         const int64_t grain_size)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  Array<int64_t> src(size, 1);
+  Array<int64_t> dst(size);
+  double averaged_timing = 0.0;
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    const double init_time = PIL_check_seconds_timer();
+    const int64_t total = parallel_exclusive_scan<int64_t>(src, dst, grain_size);
+    averaged_timing += PIL_check_seconds_timer() - init_time;
+    EXPECT_EQ(total, size);
+  }
+
+  printf("\t%s: done in %fs on average over %d runs\n",
+         id,
+         averaged_timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+}
+
+TEST(task, ParallelSortNoThread1M)
+{
+  parallel_sort_test("Parallel sort - Single thread - 1000000 items", 1000000, INT64_MAX);
+}
+
+TEST(task, ParallelSort1M)
+{
+  parallel_sort_test("Parallel sort - Threaded - 1000000 items", 1000000, 4096);
+}
+
+TEST(task, ParallelExclusiveScanNoThread10M)
+{
+  parallel_exclusive_scan_test(
+      "Parallel exclusive scan - Single thread - 10000000 items", 10000000, INT64_MAX);
+}
+
+TEST(task, ParallelExclusiveScan10M)
+{
+  parallel_exclusive_scan_test(
+      "Parallel exclusive scan - Threaded - 10000000 items", 10000000, 65536);
+}
+
+}  // namespace blender::tests
@@ -41,6 +41,9 @@ typedef struct {
   /** Session UUID of the ID being currently written (MAIN_ID_SESSION_UUID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uuid;
+  /** Hash of the content, seeded with #id_session_uuid. Used to find identical chunks of the same
+   * ID in the previous memundo step, when they are not at the same position. */
+  uint hash;
 } MemFileChunk;
 
 typedef struct MemFile {
@@ -57,6 +60,8 @@ typedef struct MemFileWriteData {
 
   /** Maps an ID session uuid to its first reference MemFileChunk, if existing. */
   struct GHash *id_session_uuid_mapping;
+  /** Maps #MemFileChunk.hash to a reference MemFileChunk, created when it's needed first. */
+  struct GHash *chunk_hash_mapping;
 } MemFileWriteData;
 
 typedef struct MemFileUndoData {
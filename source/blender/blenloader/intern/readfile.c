@@ -69,7 +69,9 @@
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
 #include "BLI_mmap.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BLT_translation.h"
 
@@ -174,6 +176,7 @@
  *
  * \note This is disabled when using compression,
  * while zlib supports seek it's unusably slow, see: T61880.
+ * Files that are compressed in parts can be read in any order, see #GzipChunkedReader.
  */
 #define USE_BHEAD_READ_ON_DEMAND
 
@@ -260,12 +263,21 @@ typedef struct OldNew {
   int nr;
 } OldNew;
 
+/**
+ * Slot of the hash-map. The hash is stored next to the index, so that probing only has to
+ * access the entries when the hashes match.
+ */
+typedef struct OldNewSlot {
+  uint32_t hash;
+  int32_t index;
+} OldNewSlot;
+
 typedef struct OldNewMap {
   /* Array that stores the actual entries. */
   OldNew *entries;
   int nentries;
   /* Hashmap that stores indices into the `entries` array. */
-  int32_t *map;
+  OldNewSlot *map;
 
   int capacity_exp;
 } OldNewMap;
@@ -282,16 +294,17 @@ typedef struct OldNewMap {
   uint32_t mask = SLOT_MASK(onm); \
   uint perturb = hash; \
   int SLOT_NAME = mask & hash; \
-  int INDEX_NAME = onm->map[SLOT_NAME]; \
+  int INDEX_NAME = onm->map[SLOT_NAME].index; \
   for (;; SLOT_NAME = mask & ((5 * SLOT_NAME) + 1 + perturb), \
           perturb >>= PERTURB_SHIFT, \
-          INDEX_NAME = onm->map[SLOT_NAME])
+          INDEX_NAME = onm->map[SLOT_NAME].index)
 
 static void oldnewmap_insert_index_in_map(OldNewMap *onm, const void *ptr, int index)
 {
   ITER_SLOTS (onm, ptr, slot, stored_index) {
     if (stored_index == -1) {
-      onm->map[slot] = index;
+      onm->map[slot].hash = hash;
+      onm->map[slot].index = index;
       break;
     }
   }
@@ -302,11 +315,12 @@ static void oldnewmap_insert_or_replace(OldNewMap *onm, OldNew entry)
   ITER_SLOTS (onm, entry.oldp, slot, index) {
     if (index == -1) {
       onm->entries[onm->nentries] = entry;
-      onm->map[slot] = onm->nentries;
+      onm->map[slot].hash = hash;
+      onm->map[slot].index = onm->nentries;
       onm->nentries++;
       break;
     }
-    if (onm->entries[index].oldp == entry.oldp) {
+    if (onm->map[slot].hash == hash && onm->entries[index].oldp == entry.oldp) {
       onm->entries[index] = entry;
       break;
     }
@@ -317,9 +331,11 @@ static OldNew *oldnewmap_lookup_entry(const OldNewMap *onm, const void *addr)
 {
   ITER_SLOTS (onm, addr, slot, index) {
     if (index >= 0) {
-      OldNew *entry = &onm->entries[index];
-      if (entry->oldp == addr) {
-        return entry;
+      if (onm->map[slot].hash == hash) {
+        OldNew *entry = &onm->entries[index];
+        if (entry->oldp == addr) {
+          return entry;
+        }
       }
     }
     else {
@@ -330,6 +346,7 @@ static OldNew *oldnewmap_lookup_entry(const OldNewMap *onm, const void *addr)
 
 static void oldnewmap_clear_map(OldNewMap *onm)
 {
+  /* Sets all indices to -1, which marks the slots as empty. */
   memset(onm->map, 0xFF, MAP_CAPACITY(onm) * sizeof(*onm->map));
 }
 
@@ -1164,6 +1181,203 @@ static ssize_t fd_read_gzip_from_file(FileData *filedata,
   return readsize;
 }
 
+/* Chunked GZip file reading.
+ * Compressed files are written as a sequence of gzip members that store their size in the header,
+ * see #BLEND_GZIP_HEADER_SIZE. Gathering these headers gives an index of the file, so that only
+ * the members that contain the requested data have to be decompressed, which makes seeking cheap.
+ */
+
+typedef struct GzipChunk {
+  /** Position of the gzip member in the file. */
+  off64_t file_offset;
+  size_t file_len;
+  /** Position of the decompressed data of the member. */
+  off64_t offset;
+  size_t len;
+} GzipChunk;
+
+typedef struct GzipChunkedReader {
+  GzipChunk *chunks;
+  int chunks_len;
+  /** The chunk that is decompressed in #buffer, -1 when none is. */
+  int chunk_active;
+  uchar *file_buffer;
+  uchar *buffer;
+} GzipChunkedReader;
+
+static uint gzip_chunk_header_read_uint(const uchar *data)
+{
+  return (uint)data[0] | ((uint)data[1] << 8) | ((uint)data[2] << 16) | ((uint)data[3] << 24);
+}
+
+static void gzip_chunked_reader_free(GzipChunkedReader *reader)
+{
+  MEM_SAFE_FREE(reader->chunks);
+  MEM_SAFE_FREE(reader->file_buffer);
+  MEM_SAFE_FREE(reader->buffer);
+  MEM_freeN(reader);
+}
+
+/**
+ * Read the headers of all gzip members of the file.
+ * \return NULL when the file isn't compressed in parts with known sizes.
+ */
+static GzipChunkedReader *gzip_chunked_reader_open(int file)
+{
+  GzipChunkedReader *reader = MEM_callocN(sizeof(*reader), __func__);
+  reader->chunk_active = -1;
+
+  int chunks_max = 0;
+  size_t file_len_max = 0;
+  size_t len_max = 0;
+  off64_t file_offset = 0;
+  off64_t offset = 0;
+  while (true) {
+    uchar header[BLEND_GZIP_HEADER_SIZE];
+    if (BLI_lseek(file, file_offset, SEEK_SET) == -1) {
+      gzip_chunked_reader_free(reader);
+      return NULL;
+    }
+    const ssize_t header_len = read(file, header, sizeof(header));
+    if (header_len == 0 && reader->chunks_len > 0) {
+      break;
+    }
+    /* Magic, deflate method, only the extra field flag, and a single sub-field of 8 bytes. */
+    if (header_len != sizeof(header) || header[0] != 0x1f || header[1] != 0x8b ||
+        header[2] != 8 || header[3] != 4 || header[10] != 12 || header[11] != 0 ||
+        header[12] != BLEND_GZIP_EXTRA_SI1 || header[13] != BLEND_GZIP_EXTRA_SI2 ||
+        header[14] != 8 || header[15] != 0) {
+      gzip_chunked_reader_free(reader);
+      return NULL;
+    }
+    const size_t len = gzip_chunk_header_read_uint(header + 16);
+    const size_t file_len = gzip_chunk_header_read_uint(header + 20);
+    if (len == 0 || file_len <= sizeof(header)) {
+      gzip_chunked_reader_free(reader);
+      return NULL;
+    }
+
+    if (reader->chunks_len == chunks_max) {
+      chunks_max = max_ii(chunks_max * 2, 64);
+      reader->chunks = MEM_reallocN(reader->chunks, sizeof(*reader->chunks) * chunks_max);
+    }
+    GzipChunk *chunk = &reader->chunks[reader->chunks_len++];
+    chunk->file_offset = file_offset;
+    chunk->file_len = file_len;
+    chunk->offset = offset;
+    chunk->len = len;
+
+    file_len_max = MAX2(file_len_max, file_len);
+    len_max = MAX2(len_max, len);
+    file_offset += (off64_t)file_len;
+    offset += (off64_t)len;
+  }
+
+  reader->file_buffer = MEM_mallocN(file_len_max, __func__);
+  reader->buffer = MEM_mallocN(len_max, __func__);
+  return reader;
+}
+
+static int gzip_chunked_reader_find(const GzipChunkedReader *reader, off64_t offset)
+{
+  if (reader->chunk_active != -1) {
+    const GzipChunk *chunk = &reader->chunks[reader->chunk_active];
+    if (chunk->offset <= offset && offset < chunk->offset + (off64_t)chunk->len) {
+      return reader->chunk_active;
+    }
+  }
+  /* Find the last chunk that starts at or before the offset. */
+  int first = 0;
+  int last = reader->chunks_len - 1;
+  while (first < last) {
+    const int middle = first + (last - first + 1) / 2;
+    if (reader->chunks[middle].offset <= offset) {
+      first = middle;
+    }
+    else {
+      last = middle - 1;
+    }
+  }
+  return first;
+}
+
+static bool gzip_chunked_reader_load(GzipChunkedReader *reader, int file, int index)
+{
+  const GzipChunk *chunk = &reader->chunks[index];
+  reader->chunk_active = -1;
+
+  if (BLI_lseek(file, chunk->file_offset, SEEK_SET) == -1 ||
+      read(file, reader->file_buffer, chunk->file_len) != (ssize_t)chunk->file_len) {
+    return false;
+  }
+
+  z_stream stream = {NULL};
+  if (inflateInit2(&stream, MAX_WBITS + 16) != Z_OK) {
+    return false;
+  }
+  stream.next_in = reader->file_buffer;
+  stream.avail_in = (uInt)chunk->file_len;
+  stream.next_out = reader->buffer;
+  stream.avail_out = (uInt)chunk->len;
+  const bool success = (inflate(&stream, Z_FINISH) == Z_STREAM_END) &&
+                       (stream.total_out == chunk->len);
+  inflateEnd(&stream);
+
+  if (success) {
+    reader->chunk_active = index;
+  }
+  return success;
+}
+
+static ssize_t fd_read_gzip_chunked_from_file(FileData *filedata,
+                                              void *buffer,
+                                              size_t size,
+                                              bool *UNUSED(r_is_memchunck_identical))
+{
+  GzipChunkedReader *reader = filedata->gzip_chunked;
+  size_t readsize = 0;
+
+  while (readsize < size && filedata->file_offset < (off64_t)filedata->buffersize) {
+    const int index = gzip_chunked_reader_find(reader, filedata->file_offset);
+    if (index != reader->chunk_active &&
+        !gzip_chunked_reader_load(reader, filedata->filedes, index)) {
+      return EOF;
+    }
+    const GzipChunk *chunk = &reader->chunks[index];
+    const size_t chunk_offset = (size_t)(filedata->file_offset - chunk->offset);
+    const size_t copy_len = MIN2(size - readsize, chunk->len - chunk_offset);
+    memcpy((char *)buffer + readsize, reader->buffer + chunk_offset, copy_len);
+    readsize += copy_len;
+    filedata->file_offset += (off64_t)copy_len;
+  }
+
+  return (ssize_t)readsize;
+}
+
+static off64_t fd_seek_gzip_chunked_from_file(FileData *filedata, off64_t offset, int whence)
+{
+  off64_t new_pos;
+  if (whence == SEEK_CUR) {
+    new_pos = filedata->file_offset + offset;
+  }
+  else if (whence == SEEK_SET) {
+    new_pos = offset;
+  }
+  else if (whence == SEEK_END) {
+    new_pos = filedata->buffersize + offset;
+  }
+  else {
+    return -1;
+  }
+
+  if (new_pos < 0 || new_pos > filedata->buffersize) {
+    return -1;
+  }
+
+  filedata->file_offset = new_pos;
+  return filedata->file_offset;
+}
+
 /* Memory reading. */
 
 static ssize_t fd_read_from_memory(FileData *filedata,
@@ -1358,6 +1572,7 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   BLI_mmap_file *mmap_file = NULL;
 
   gzFile gzfile = (gzFile)Z_NULL;
+  GzipChunkedReader *gzip_chunked = NULL;
 
   char header[7];
 
@@ -1392,6 +1607,17 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   if ((read_fn == NULL) &&
       /* Check header magic. */
       (header[0] == 0x1f && header[1] == 0x8b)) {
+    gzip_chunked = gzip_chunked_reader_open(file);
+  }
+  if (gzip_chunked != NULL) {
+    read_fn = fd_read_gzip_chunked_from_file;
+    seek_fn = fd_seek_gzip_chunked_from_file;
+    const GzipChunk *last_chunk = &gzip_chunked->chunks[gzip_chunked->chunks_len - 1];
+    buffersize = (size_t)last_chunk->offset + last_chunk->len;
+  }
+  else if ((read_fn == NULL) &&
+           /* Check header magic. */
+           (header[0] == 0x1f && header[1] == 0x8b)) {
     gzfile = BLI_gzopen(filepath, "rb");
     if (gzfile == (gzFile)Z_NULL) {
       BKE_reportf(reports,
@@ -1417,6 +1643,7 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   fd->filedes = file;
   fd->gzfiledes = gzfile;
+  fd->gzip_chunked = gzip_chunked;
 
   fd->read = read_fn;
   fd->seek = seek_fn;
@@ -1481,25 +1708,30 @@ static ssize_t fd_read_gzip_from_memory(FileData *filedata,
                                         size_t size,
                                         bool *UNUSED(r_is_memchunck_identical))
 {
-  int err;
-
   filedata->strm.next_out = (Bytef *)buffer;
   filedata->strm.avail_out = (uint)size;
 
-  /* Inflate another chunk. */
-  err = inflate(&filedata->strm, Z_SYNC_FLUSH);
+  while (filedata->strm.avail_out > 0) {
+    /* Inflate another chunk. */
+    const int err = inflate(&filedata->strm, Z_SYNC_FLUSH);
 
-  if (err == Z_STREAM_END) {
-    return 0;
-  }
-  if (err != Z_OK) {
-    printf("fd_read_gzip_from_memory: zlib error\n");
-    return 0;
+    if (err == Z_STREAM_END) {
+      /* Compressed files consist of multiple gzip members, continue with the next one. */
+      if (filedata->strm.avail_in == 0) {
+        break;
+      }
+      inflateReset(&filedata->strm);
+    }
+    else if (err != Z_OK) {
+      printf("fd_read_gzip_from_memory: zlib error\n");
+      return 0;
+    }
   }
 
-  filedata->file_offset += size;
+  const size_t readsize = size - filedata->strm.avail_out;
+  filedata->file_offset += readsize;
 
-  return (ssize_t)size;
+  return (ssize_t)readsize;
 }
 
 static int fd_read_gzip_from_memory_init(FileData *fd)
@@ -1579,6 +1811,10 @@ void blo_filedata_free(FileData *fd)
       gzclose(fd->gzfiledes);
     }
 
+    if (fd->gzip_chunked != NULL) {
+      gzip_chunked_reader_free(fd->gzip_chunked);
+    }
+
     if (fd->strm.next_in) {
       if (inflateEnd(&fd->strm) != Z_OK) {
         printf("close gzip stream error\n");
@@ -3313,11 +3549,108 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+typedef struct ReadDataReconstructData {
+  FileData *fd;
+  /** Blocks with their data, NULL for blocks that could not be read. */
+  BHead **bheads;
+  void **results;
+} ReadDataReconstructData;
+
+static bool read_data_needs_reconstruct(const FileData *fd, const BHead *bhead)
+{
+  return bhead->len && fd->compflags[bhead->SDNAnr] == SDNA_CMP_NOT_EQUAL;
+}
+
+static void read_data_reconstruct_func(void *__restrict userdata,
+                                       const int index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReadDataReconstructData *data = userdata;
+  BHead *bh = data->bheads[index];
+  if (bh != NULL && read_data_needs_reconstruct(data->fd, bh)) {
+    data->results[index] = DNA_struct_reconstruct(
+        data->fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+  }
+}
+
+/**
+ * Same as reading the blocks with #read_struct one after another, but blocks that need DNA
+ * reconstruction are converted in parallel. Reading from the file and inserting the results
+ * into the #OldNewMap stays on this thread, in the order of the file.
+ */
+static BHead *read_data_into_datamap_parallel(FileData *fd, BHead *bhead, const char *allocname)
+{
+  int bheads_len = 0;
+  for (BHead *bh = bhead; bh && bh->code == DATA; bh = blo_bhead_next(fd, bh)) {
+    bheads_len++;
+  }
+
+  BHead **bheads_orig = MEM_malloc_arrayN(bheads_len, sizeof(*bheads_orig), __func__);
+  BHead **bheads = MEM_malloc_arrayN(bheads_len, sizeof(*bheads), __func__);
+  void **results = MEM_calloc_arrayN(bheads_len, sizeof(*results), __func__);
+
+  for (int i = 0; i < bheads_len; i++, bhead = blo_bhead_next(fd, bhead)) {
+    bheads_orig[i] = bheads[i] = bhead;
+    if (!read_data_needs_reconstruct(fd, bhead)) {
+      results[i] = read_struct(fd, bhead, allocname);
+    }
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    else if (BHEADN_FROM_BHEAD(bhead)->has_data == false) {
+      bheads[i] = blo_bhead_read_full(fd, bhead);
+      if (UNLIKELY(bheads[i] == NULL)) {
+        fd->flags &= ~FD_FLAGS_FILE_OK;
+      }
+    }
+#endif
+  }
+
+  ReadDataReconstructData data = {
+      .fd = fd,
+      .bheads = bheads,
+      .results = results,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, bheads_len, &data, read_data_reconstruct_func, &settings);
+
+  for (int i = 0; i < bheads_len; i++) {
+    if (results[i]) {
+      oldnewmap_insert(fd->datamap, bheads_orig[i]->old, results[i], 0);
+    }
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    if (bheads[i] != NULL && bheads[i] != bheads_orig[i]) {
+      MEM_freeN(BHEADN_FROM_BHEAD(bheads[i]));
+    }
+#endif
+  }
+
+  MEM_freeN(bheads_orig);
+  MEM_freeN(bheads);
+  MEM_freeN(results);
+
+  return bhead;
+}
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *allocname)
 {
   bhead = blo_bhead_next(fd, bhead);
 
+  /* Converting blocks from older files can take most of the time, do it in parallel when an ID
+   * has several blocks that need it. Endian switching modifies the blocks in place, so it is
+   * always done one block at a time. */
+  if (fd->memfile == NULL && fd->reconstruct_info != NULL &&
+      (fd->flags & FD_FLAGS_SWITCH_ENDIAN) == 0) {
+    int reconstruct_len = 0;
+    for (BHead *bh = bhead; bh && bh->code == DATA && reconstruct_len < 2;
+         bh = blo_bhead_next(fd, bh)) {
+      reconstruct_len += read_data_needs_reconstruct(fd, bh);
+    }
+    if (reconstruct_len >= 2) {
+      return read_data_into_datamap_parallel(fd, bhead, allocname);
+    }
+  }
+
   while (bhead && bhead->code == DATA) {
     /* The code below is useful for debugging leaks in data read from the blend file.
      * Without this the messages only tell us what ID-type the memory came from,
@@ -4054,6 +4387,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     DEBUG_PRINTF("\nUNDO: read step\n");
   }
 
+  BLI_TRACE_ZONE_BEGIN("Read blend file");
   bfd = MEM_callocN(sizeof(BlendFileData), "blendfiledata");
 
   bfd->main = BKE_main_new();
@@ -4152,11 +4486,15 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
   }
 
   if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
+    BLI_TRACE_ZONE_BEGIN("Read libraries");
     read_libraries(fd, &mainlist);
+    BLI_TRACE_ZONE_END();
 
     blo_join_main(&mainlist);
 
+    BLI_TRACE_ZONE_BEGIN("Link data-blocks");
     lib_link_all(fd, bfd->main);
+    BLI_TRACE_ZONE_END();
 
     /* Skip in undo case. */
     if (fd->memfile == NULL) {
@@ -4207,6 +4545,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
   fd->mainlist = NULL; /* Safety, this is local variable, shall not be used afterward. */
 
+  BLI_TRACE_ZONE_END();
   return bfd;
 }
 
@@ -64,6 +64,17 @@ enum eFileDataFlag {
 typedef int64_t off64_t;
 #endif
 
+/**
+ * Compressed files consist of gzip members, each holding a part of the file. The header of every
+ * member has an extra field with the sub-field ID #BLEND_GZIP_EXTRA_SI1, #BLEND_GZIP_EXTRA_SI2,
+ * which stores the uncompressed and the compressed size of the member as little endian 32 bit
+ * integers at byte 16 and 20. This allows reading any part of the file without decompressing
+ * the parts before it.
+ */
+#define BLEND_GZIP_EXTRA_SI1 'B'
+#define BLEND_GZIP_EXTRA_SI2 'L'
+#define BLEND_GZIP_HEADER_SIZE 24
+
 typedef ssize_t(FileDataReadFn)(struct FileData *filedata,
                                 void *buffer,
                                 size_t size,
@@ -95,6 +106,8 @@ typedef struct FileData {
 
   /** Variables needed for reading from file. */
   gzFile gzfiledes;
+  /** Index of the gzip members of compressed files that can be read in any order. */
+  struct GzipChunkedReader *gzip_chunked;
   /** Gzip stream for memory decompression. */
   z_stream strm;
 
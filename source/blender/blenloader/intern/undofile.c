@@ -42,6 +42,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -80,7 +81,11 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
   /* First, detect all memchunks in second memfile that are not owned by it. */
   for (MemFileChunk *sc = second->chunks.first; sc != NULL; sc = sc->next) {
     if (sc->is_identical) {
-      BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
+      /* Several chunks can share the same buffer, only one of them gets the ownership. */
+      void **entry;
+      if (!BLI_ghash_ensure_p(buffer_to_second_memchunk, (void *)sc->buf, &entry)) {
+        *entry = sc;
+      }
     }
   }
 
@@ -120,6 +125,7 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
   mem_data->written_memfile = written_memfile;
   mem_data->reference_memfile = reference_memfile;
   mem_data->reference_current_chunk = reference_memfile ? reference_memfile->chunks.first : NULL;
+  mem_data->chunk_hash_mapping = NULL;
 
   /* If we have a reference memfile, we generate a mapping between the session_uuid's of the
    * IDs stored in that previous undo step, and its first matching memchunk. This will allow
@@ -152,6 +158,44 @@ void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
   if (mem_data->id_session_uuid_mapping != NULL) {
     BLI_ghash_free(mem_data->id_session_uuid_mapping, NULL, NULL);
   }
+  if (mem_data->chunk_hash_mapping != NULL) {
+    BLI_ghash_free(mem_data->chunk_hash_mapping, NULL, NULL);
+  }
+}
+
+/**
+ * Find a chunk of the reference memfile that belongs to the same ID and has the same content,
+ * anywhere in the memfile. This finds unchanged data that has moved, e.g. because data was
+ * inserted before it.
+ */
+static MemFileChunk *memfile_chunk_find_identical(MemFileWriteData *mem_data,
+                                                  const MemFileChunk *chunk,
+                                                  const char *buf)
+{
+  if (mem_data->reference_memfile == NULL) {
+    return NULL;
+  }
+
+  if (mem_data->chunk_hash_mapping == NULL) {
+    mem_data->chunk_hash_mapping = BLI_ghash_new(
+        BLI_ghashutil_inthash_p_simple, BLI_ghashutil_intcmp, __func__);
+    LISTBASE_FOREACH (MemFileChunk *, ref_chunk, &mem_data->reference_memfile->chunks) {
+      void **entry;
+      if (!BLI_ghash_ensure_p(
+              mem_data->chunk_hash_mapping, POINTER_FROM_UINT(ref_chunk->hash), &entry)) {
+        *entry = ref_chunk;
+      }
+    }
+  }
+
+  MemFileChunk *ref_chunk = BLI_ghash_lookup(mem_data->chunk_hash_mapping,
+                                             POINTER_FROM_UINT(chunk->hash));
+  if (ref_chunk != NULL && ref_chunk->size == chunk->size &&
+      ref_chunk->id_session_uuid == chunk->id_session_uuid &&
+      memcmp(ref_chunk->buf, buf, chunk->size) == 0) {
+    return ref_chunk;
+  }
+  return NULL;
 }
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
@@ -176,6 +220,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     if (compchunk->size == curchunk->size) {
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
+        curchunk->hash = compchunk->hash;
         curchunk->is_identical = true;
         compchunk->is_identical_future = true;
       }
@@ -183,6 +228,17 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     *compchunk_step = compchunk->next;
   }
 
+  /* Not at the same position, the data may still exist elsewhere in the previous step. */
+  if (curchunk->buf == NULL) {
+    curchunk->hash = BLI_hash_mm2((const uchar *)buf, size, curchunk->id_session_uuid);
+    MemFileChunk *ref_chunk = memfile_chunk_find_identical(mem_data, curchunk, buf);
+    if (ref_chunk != NULL) {
+      curchunk->buf = ref_chunk->buf;
+      curchunk->is_identical = true;
+      ref_chunk->is_identical_future = true;
+    }
+  }
+
   /* not equal... */
   if (curchunk->buf == NULL) {
     char *buf_new = MEM_mallocN(size, "Chunk buffer");
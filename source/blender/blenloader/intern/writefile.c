@@ -101,6 +101,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
 #include "BKE_blender_version.h"
@@ -149,6 +150,31 @@ typedef enum {
   WW_WRAP_ZLIB,
 } eWriteWrapType;
 
+/**
+ * Uncompressed size of the parts of the file that are compressed independently. Every part is
+ * written as its own gzip member, readers decompress the concatenated members as one stream.
+ * The sizes of every part are stored in the member header, see #BLEND_GZIP_HEADER_SIZE.
+ */
+#define ZLIB_CHUNK_SIZE (1 << 21)
+/** Number of parts that are compressed in parallel before they are written to the file. */
+#define ZLIB_CHUNKS_NUM 16
+
+typedef struct ZlibChunk {
+  uchar *in;
+  size_t in_len;
+  uchar *out;
+  size_t out_len;
+  bool failed;
+} ZlibChunk;
+
+typedef struct ZlibWriteState {
+  int file_handle;
+  ZlibChunk chunks[ZLIB_CHUNKS_NUM];
+  /** Index of the chunk that receives the written data. */
+  int chunk_active;
+  bool failed;
+} ZlibWriteState;
+
 typedef struct WriteWrap WriteWrap;
 struct WriteWrap {
   /* callbacks */
@@ -162,7 +188,7 @@ struct WriteWrap {
   /* internal */
   union {
     int file_handle;
-    gzFile gz_handle;
+    ZlibWriteState *zlib_state;
   } _user_data;
 };
 
@@ -193,16 +219,80 @@ static size_t ww_write_none(WriteWrap *ww, const char *buf, size_t buf_len)
 #undef FILE_HANDLE
 
 /* zlib */
-#define FILE_HANDLE(ww) (ww)->_user_data.gz_handle
+#define ZLIB_STATE(ww) (ww)->_user_data.zlib_state
+
+static void ww_zlib_compress_chunk_func(void *__restrict userdata,
+                                        const int index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZlibWriteState *state = userdata;
+  ZlibChunk *chunk = &state->chunks[index];
+
+  z_stream stream = {NULL};
+  /* Adding 16 to the window bits writes a gzip header and trailer. */
+  if (deflateInit2(&stream, 1, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    chunk->failed = true;
+    return;
+  }
+  /* Reserve the extra field for the sizes, they are filled in once they are known. */
+  uchar extra[BLEND_GZIP_HEADER_SIZE - 12] = {BLEND_GZIP_EXTRA_SI1, BLEND_GZIP_EXTRA_SI2, 8, 0};
+  gz_header header = {0};
+  header.os = 255;
+  header.extra = extra;
+  header.extra_len = sizeof(extra);
+  deflateSetHeader(&stream, &header);
+
+  /* Use the bound of a full chunk, so that the output buffer can be reused for every chunk. */
+  const size_t out_len_max = deflateBound(&stream, ZLIB_CHUNK_SIZE);
+  if (chunk->out == NULL) {
+    chunk->out = MEM_mallocN(out_len_max, __func__);
+  }
+  stream.next_in = chunk->in;
+  stream.avail_in = (uInt)chunk->in_len;
+  stream.next_out = chunk->out;
+  stream.avail_out = (uInt)out_len_max;
+  chunk->failed = (deflate(&stream, Z_FINISH) != Z_STREAM_END);
+  chunk->out_len = stream.total_out;
+  deflateEnd(&stream);
+
+  for (int i = 0; i < 4; i++) {
+    chunk->out[16 + i] = (uchar)(chunk->in_len >> (i * 8));
+    chunk->out[20 + i] = (uchar)(chunk->out_len >> (i * 8));
+  }
+}
+
+/** Compress all chunks that contain data in parallel and write them to the file in order. */
+static void ww_zlib_flush(ZlibWriteState *state)
+{
+  const int chunks_len = state->chunk_active + (state->chunks[state->chunk_active].in_len != 0);
+  if (chunks_len == 0) {
+    return;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (chunks_len > 1);
+  BLI_task_parallel_range(0, chunks_len, state, ww_zlib_compress_chunk_func, &settings);
+
+  for (int i = 0; i < chunks_len; i++) {
+    ZlibChunk *chunk = &state->chunks[i];
+    if (chunk->failed || write(state->file_handle, chunk->out, chunk->out_len) != chunk->out_len) {
+      state->failed = true;
+    }
+    chunk->in_len = 0;
+  }
+  state->chunk_active = 0;
+}
 
 static bool ww_open_zlib(WriteWrap *ww, const char *filepath)
 {
-  gzFile file;
+  int file;
 
-  file = BLI_gzopen(filepath, "wb1");
+  file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
 
-  if (file != Z_NULL) {
-    FILE_HANDLE(ww) = file;
+  if (file != -1) {
+    ZLIB_STATE(ww) = MEM_callocN(sizeof(ZlibWriteState), __func__);
+    ZLIB_STATE(ww)->file_handle = file;
     return true;
   }
 
@@ -210,13 +300,46 @@ static bool ww_open_zlib(WriteWrap *ww, const char *filepath)
 }
 static bool ww_close_zlib(WriteWrap *ww)
 {
-  return (gzclose(FILE_HANDLE(ww)) == Z_OK);
+  ZlibWriteState *state = ZLIB_STATE(ww);
+  ww_zlib_flush(state);
+
+  bool success = !state->failed;
+  if (close(state->file_handle) == -1) {
+    success = false;
+  }
+  for (int i = 0; i < ZLIB_CHUNKS_NUM; i++) {
+    MEM_SAFE_FREE(state->chunks[i].in);
+    MEM_SAFE_FREE(state->chunks[i].out);
+  }
+  MEM_freeN(state);
+  return success;
 }
 static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 {
-  return gzwrite(FILE_HANDLE(ww), buf, buf_len);
+  ZlibWriteState *state = ZLIB_STATE(ww);
+  size_t written_len = 0;
+  while (written_len < buf_len) {
+    ZlibChunk *chunk = &state->chunks[state->chunk_active];
+    if (chunk->in == NULL) {
+      chunk->in = MEM_mallocN(ZLIB_CHUNK_SIZE, __func__);
+    }
+    const size_t copy_len = MIN2(buf_len - written_len, ZLIB_CHUNK_SIZE - chunk->in_len);
+    memcpy(chunk->in + chunk->in_len, buf + written_len, copy_len);
+    chunk->in_len += copy_len;
+    written_len += copy_len;
+
+    if (chunk->in_len == ZLIB_CHUNK_SIZE) {
+      if (state->chunk_active == ZLIB_CHUNKS_NUM - 1) {
+        ww_zlib_flush(state);
+      }
+      else {
+        state->chunk_active++;
+      }
+    }
+  }
+  return state->failed ? 0 : buf_len;
 }
-#undef FILE_HANDLE
+#undef ZLIB_STATE
 
 /* --- end compression types --- */
 
@@ -35,6 +35,7 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
+#include "BLI_task.h"
 
 #include "bmesh.h"
 #include "bmesh_tools.h"
@@ -43,6 +44,9 @@
 
 #include "intern/bmesh_private.h"
 
+/* Number of faces above which #BM_mesh_calc_tessellation_beauty uses multiple threads. */
+#define BM_TESSELLATION_BEAUTY_THREAD_LIMIT 4096
+
 /**
  * \brief COMPUTE POLY NORMAL (BMFace)
  *
@@ -1672,137 +1676,221 @@ void BM_mesh_calc_tessellation(BMesh *bm, BMLoop *(*looptris)[3], int *r_looptri
 }
 
 /**
- * A version of #BM_mesh_calc_tessellation that avoids degenerate triangles.
+ * Tessellate a single face for #BM_mesh_calc_tessellation_beauty,
+ * the arena and heap are only created once an n-gon is found.
+ *
+ * \return The number of triangles written to \a looptris.
  */
-void BM_mesh_calc_tessellation_beauty(BMesh *bm, BMLoop *(*looptris)[3], int *r_looptris_tot)
+static int bm_face_calc_tessellation_beauty(BMFace *efa,
+                                            BMLoop *(*looptris)[3],
+                                            MemArena **pf_arena_p,
+                                            Heap **pf_heap_p)
 {
-  /* this assumes all faces can be scan-filled, which isn't always true,
-   * worst case we over alloc a little which is acceptable */
-#ifndef NDEBUG
-  const int looptris_tot = poly_to_tri_count(bm->totface, bm->totloop);
-#endif
-
-  BMIter iter;
-  BMFace *efa;
   int i = 0;
 
-  MemArena *pf_arena = NULL;
-
-  /* use_beauty */
-  Heap *pf_heap = NULL;
-
-  BM_ITER_MESH (efa, &iter, bm, BM_FACES_OF_MESH) {
-    /* don't consider two-edged faces */
-    if (UNLIKELY(efa->len < 3)) {
-      /* do nothing */
-    }
-    else if (efa->len == 3) {
-      BMLoop *l;
-      BMLoop **l_ptr = looptris[i++];
-      l_ptr[0] = l = BM_FACE_FIRST_LOOP(efa);
-      l_ptr[1] = l = l->next;
-      l_ptr[2] = l->next;
-    }
-    else if (efa->len == 4) {
-      BMLoop *l_v1 = BM_FACE_FIRST_LOOP(efa);
-      BMLoop *l_v2 = l_v1->next;
-      BMLoop *l_v3 = l_v2->next;
-      BMLoop *l_v4 = l_v1->prev;
-
-      /* #BM_verts_calc_rotate_beauty performs excessive checks we don't need!
-       * It's meant for rotating edges, it also calculates a new normal.
-       *
-       * Use #BLI_polyfill_beautify_quad_rotate_calc since we have the normal.
-       */
+  /* don't consider two-edged faces */
+  if (UNLIKELY(efa->len < 3)) {
+    /* do nothing */
+  }
+  else if (efa->len == 3) {
+    BMLoop *l;
+    BMLoop **l_ptr = looptris[i++];
+    l_ptr[0] = l = BM_FACE_FIRST_LOOP(efa);
+    l_ptr[1] = l = l->next;
+    l_ptr[2] = l->next;
+  }
+  else if (efa->len == 4) {
+    BMLoop *l_v1 = BM_FACE_FIRST_LOOP(efa);
+    BMLoop *l_v2 = l_v1->next;
+    BMLoop *l_v3 = l_v2->next;
+    BMLoop *l_v4 = l_v1->prev;
+
+    /* #BM_verts_calc_rotate_beauty performs excessive checks we don't need!
+     * It's meant for rotating edges, it also calculates a new normal.
+     *
+     * Use #BLI_polyfill_beautify_quad_rotate_calc since we have the normal.
+     */
 #if 0
-      const bool split_13 = (BM_verts_calc_rotate_beauty(
-                                 l_v1->v, l_v2->v, l_v3->v, l_v4->v, 0, 0) < 0.0f);
+    const bool split_13 = (BM_verts_calc_rotate_beauty(
+                               l_v1->v, l_v2->v, l_v3->v, l_v4->v, 0, 0) < 0.0f);
 #else
-      float axis_mat[3][3], v_quad[4][2];
-      axis_dominant_v3_to_m3(axis_mat, efa->no);
-      mul_v2_m3v3(v_quad[0], axis_mat, l_v1->v->co);
-      mul_v2_m3v3(v_quad[1], axis_mat, l_v2->v->co);
-      mul_v2_m3v3(v_quad[2], axis_mat, l_v3->v->co);
-      mul_v2_m3v3(v_quad[3], axis_mat, l_v4->v->co);
-
-      const bool split_13 = BLI_polyfill_beautify_quad_rotate_calc(
-                                v_quad[0], v_quad[1], v_quad[2], v_quad[3]) < 0.0f;
+    float axis_mat[3][3], v_quad[4][2];
+    axis_dominant_v3_to_m3(axis_mat, efa->no);
+    mul_v2_m3v3(v_quad[0], axis_mat, l_v1->v->co);
+    mul_v2_m3v3(v_quad[1], axis_mat, l_v2->v->co);
+    mul_v2_m3v3(v_quad[2], axis_mat, l_v3->v->co);
+    mul_v2_m3v3(v_quad[3], axis_mat, l_v4->v->co);
+
+    const bool split_13 = BLI_polyfill_beautify_quad_rotate_calc(
+                              v_quad[0], v_quad[1], v_quad[2], v_quad[3]) < 0.0f;
 #endif
 
-      BMLoop **l_ptr_a = looptris[i++];
-      BMLoop **l_ptr_b = looptris[i++];
-      if (split_13) {
-        l_ptr_a[0] = l_v1;
-        l_ptr_a[1] = l_v2;
-        l_ptr_a[2] = l_v3;
-
-        l_ptr_b[0] = l_v1;
-        l_ptr_b[1] = l_v3;
-        l_ptr_b[2] = l_v4;
-      }
-      else {
-        l_ptr_a[0] = l_v1;
-        l_ptr_a[1] = l_v2;
-        l_ptr_a[2] = l_v4;
-
-        l_ptr_b[0] = l_v2;
-        l_ptr_b[1] = l_v3;
-        l_ptr_b[2] = l_v4;
-      }
+    BMLoop **l_ptr_a = looptris[i++];
+    BMLoop **l_ptr_b = looptris[i++];
+    if (split_13) {
+      l_ptr_a[0] = l_v1;
+      l_ptr_a[1] = l_v2;
+      l_ptr_a[2] = l_v3;
+
+      l_ptr_b[0] = l_v1;
+      l_ptr_b[1] = l_v3;
+      l_ptr_b[2] = l_v4;
     }
     else {
-      int j;
+      l_ptr_a[0] = l_v1;
+      l_ptr_a[1] = l_v2;
+      l_ptr_a[2] = l_v4;
 
-      BMLoop *l_iter;
-      BMLoop *l_first;
-      BMLoop **l_arr;
+      l_ptr_b[0] = l_v2;
+      l_ptr_b[1] = l_v3;
+      l_ptr_b[2] = l_v4;
+    }
+  }
+  else {
+    int j;
 
-      float axis_mat[3][3];
-      float(*projverts)[2];
-      unsigned int(*tris)[3];
+    BMLoop *l_iter;
+    BMLoop *l_first;
+    BMLoop **l_arr;
 
-      const int totfilltri = efa->len - 2;
+    float axis_mat[3][3];
+    float(*projverts)[2];
+    unsigned int(*tris)[3];
 
-      if (UNLIKELY(pf_arena == NULL)) {
-        pf_arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
-        pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
-      }
+    const int totfilltri = efa->len - 2;
 
-      tris = BLI_memarena_alloc(pf_arena, sizeof(*tris) * totfilltri);
-      l_arr = BLI_memarena_alloc(pf_arena, sizeof(*l_arr) * efa->len);
-      projverts = BLI_memarena_alloc(pf_arena, sizeof(*projverts) * efa->len);
+    if (UNLIKELY(*pf_arena_p == NULL)) {
+      *pf_arena_p = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+      *pf_heap_p = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
+    }
+    MemArena *pf_arena = *pf_arena_p;
+    Heap *pf_heap = *pf_heap_p;
 
-      axis_dominant_v3_to_m3_negate(axis_mat, efa->no);
+    tris = BLI_memarena_alloc(pf_arena, sizeof(*tris) * totfilltri);
+    l_arr = BLI_memarena_alloc(pf_arena, sizeof(*l_arr) * efa->len);
+    projverts = BLI_memarena_alloc(pf_arena, sizeof(*projverts) * efa->len);
 
-      j = 0;
-      l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
-      do {
-        l_arr[j] = l_iter;
-        mul_v2_m3v3(projverts[j], axis_mat, l_iter->v->co);
-        j++;
-      } while ((l_iter = l_iter->next) != l_first);
+    axis_dominant_v3_to_m3_negate(axis_mat, efa->no);
 
-      BLI_polyfill_calc_arena(projverts, efa->len, 1, tris, pf_arena);
+    j = 0;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
+    do {
+      l_arr[j] = l_iter;
+      mul_v2_m3v3(projverts[j], axis_mat, l_iter->v->co);
+      j++;
+    } while ((l_iter = l_iter->next) != l_first);
 
-      BLI_polyfill_beautify(projverts, efa->len, tris, pf_arena, pf_heap);
+    BLI_polyfill_calc_arena(projverts, efa->len, 1, tris, pf_arena);
 
-      for (j = 0; j < totfilltri; j++) {
-        BMLoop **l_ptr = looptris[i++];
-        unsigned int *tri = tris[j];
+    BLI_polyfill_beautify(projverts, efa->len, tris, pf_arena, pf_heap);
 
-        l_ptr[0] = l_arr[tri[0]];
-        l_ptr[1] = l_arr[tri[1]];
-        l_ptr[2] = l_arr[tri[2]];
-      }
+    for (j = 0; j < totfilltri; j++) {
+      BMLoop **l_ptr = looptris[i++];
+      unsigned int *tri = tris[j];
 
-      BLI_memarena_clear(pf_arena);
+      l_ptr[0] = l_arr[tri[0]];
+      l_ptr[1] = l_arr[tri[1]];
+      l_ptr[2] = l_arr[tri[2]];
     }
+
+    BLI_memarena_clear(pf_arena);
   }
 
-  if (pf_arena) {
-    BLI_memarena_free(pf_arena);
+  return i;
+}
+
+typedef struct TessellationBeautyData {
+  BMFace **faces;
+  /** Index of the first triangle of each face in #looptris. */
+  int *faces_tri_offset;
+  BMLoop *(*looptris)[3];
+} TessellationBeautyData;
+
+typedef struct TessellationBeautyTLS {
+  MemArena *pf_arena;
+  Heap *pf_heap;
+} TessellationBeautyTLS;
+
+static void bm_mesh_calc_tessellation_beauty_fn(void *__restrict userdata,
+                                                const int index,
+                                                const TaskParallelTLS *__restrict tls)
+{
+  const TessellationBeautyData *data = userdata;
+  TessellationBeautyTLS *tls_data = tls->userdata_chunk;
+  bm_face_calc_tessellation_beauty(data->faces[index],
+                                   data->looptris + data->faces_tri_offset[index],
+                                   &tls_data->pf_arena,
+                                   &tls_data->pf_heap);
+}
+
+static void bm_mesh_calc_tessellation_beauty_free_fn(const void *__restrict UNUSED(userdata),
+                                                     void *__restrict chunk)
+{
+  TessellationBeautyTLS *tls_data = chunk;
+  if (tls_data->pf_arena) {
+    BLI_memarena_free(tls_data->pf_arena);
+    BLI_heap_free(tls_data->pf_heap, NULL);
+  }
+}
 
-    BLI_heap_free(pf_heap, NULL);
+/**
+ * A version of #BM_mesh_calc_tessellation that avoids degenerate triangles.
+ */
+void BM_mesh_calc_tessellation_beauty(BMesh *bm, BMLoop *(*looptris)[3], int *r_looptris_tot)
+{
+  /* this assumes all faces can be scan-filled, which isn't always true,
+   * worst case we over alloc a little which is acceptable */
+#ifndef NDEBUG
+  const int looptris_tot = poly_to_tri_count(bm->totface, bm->totloop);
+#endif
+
+  BMIter iter;
+  BMFace *efa;
+  int i = 0;
+
+  if (bm->totface >= BM_TESSELLATION_BEAUTY_THREAD_LIMIT) {
+    /* The triangles of each face are written at known offsets, so faces can be handled in
+     * parallel with the same result as the single threaded loop. */
+    TessellationBeautyData data;
+    data.faces = MEM_malloc_arrayN(bm->totface, sizeof(*data.faces), __func__);
+    data.faces_tri_offset = MEM_malloc_arrayN(bm->totface, sizeof(int), __func__);
+    data.looptris = looptris;
+
+    int face_index = 0;
+    BM_ITER_MESH (efa, &iter, bm, BM_FACES_OF_MESH) {
+      data.faces[face_index] = efa;
+      data.faces_tri_offset[face_index] = i;
+      i += max_ii(efa->len - 2, 0);
+      face_index++;
+    }
+
+    TessellationBeautyTLS tls_data = {NULL};
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.userdata_chunk = &tls_data;
+    settings.userdata_chunk_size = sizeof(tls_data);
+    settings.func_free = bm_mesh_calc_tessellation_beauty_free_fn;
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, face_index, &data, bm_mesh_calc_tessellation_beauty_fn, &settings);
+
+    MEM_freeN(data.faces);
+    MEM_freeN(data.faces_tri_offset);
+  }
+  else {
+    MemArena *pf_arena = NULL;
+
+    /* use_beauty */
+    Heap *pf_heap = NULL;
+
+    BM_ITER_MESH (efa, &iter, bm, BM_FACES_OF_MESH) {
+      i += bm_face_calc_tessellation_beauty(efa, looptris + i, &pf_arena, &pf_heap);
+    }
+
+    if (pf_arena) {
+      BLI_memarena_free(pf_arena);
+
+      BLI_heap_free(pf_heap, NULL);
+    }
   }
 
   *r_looptris_tot = i;
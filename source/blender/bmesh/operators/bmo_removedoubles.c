@@ -27,6 +27,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_stack.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.h"
@@ -625,6 +626,88 @@ void bmo_collapse_uvs_exec(BMesh *bm, BMOperator *op)
 #endif
 }
 
+typedef struct FindDoublesKeepFilterData {
+  BMesh *bm;
+  BMVert *const *verts;
+  /** Tree of the vertices which are not kept. */
+  const KDTree_3d *tree;
+  float dist_sq;
+  bool *r_use_vert;
+} FindDoublesKeepFilterData;
+
+static void bmesh_find_doubles_keep_filter_cb(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const FindDoublesKeepFilterData *data = userdata;
+  BMVert *v = data->verts[i];
+  if (!BMO_vert_flag_test(data->bm, v, VERT_KEEP)) {
+    data->r_use_vert[i] = true;
+    return;
+  }
+  KDTreeNearest_3d nearest;
+  data->r_use_vert[i] = (BLI_kdtree_3d_find_nearest(data->tree, v->co, &nearest) != -1) &&
+                        (len_squared_v3v3(v->co, nearest.co) <= data->dist_sq);
+}
+
+/**
+ * Kept vertices can only be merge targets, so those outside the range of every vertex that may be
+ * merged can't take part in any merge. When few vertices may be merged (auto-merge after
+ * transforming a selection for example), skipping the others keeps the duplicate search local.
+ *
+ * \return An array of the vertices to search or NULL when filtering isn't worthwhile.
+ */
+static BMVert **bmesh_find_doubles_keep_filter(BMesh *bm,
+                                               BMVert *const *verts,
+                                               const int verts_len,
+                                               const float dist,
+                                               int *r_verts_filter_len)
+{
+  int verts_merge_len = 0;
+  for (int i = 0; i < verts_len; i++) {
+    if (!BMO_vert_flag_test(bm, verts[i], VERT_KEEP)) {
+      verts_merge_len++;
+    }
+  }
+  if (verts_merge_len > verts_len / 2) {
+    return NULL;
+  }
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(verts_merge_len);
+  for (int i = 0; i < verts_len; i++) {
+    if (!BMO_vert_flag_test(bm, verts[i], VERT_KEEP)) {
+      BLI_kdtree_3d_insert(tree, i, verts[i]->co);
+    }
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  bool *use_vert = MEM_mallocN(sizeof(*use_vert) * verts_len, __func__);
+  FindDoublesKeepFilterData data = {
+      .bm = bm,
+      .verts = verts,
+      .tree = tree,
+      .dist_sq = square_f(dist),
+      .r_use_vert = use_vert,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = verts_len >= BM_OMP_LIMIT;
+  BLI_task_parallel_range(0, verts_len, &data, bmesh_find_doubles_keep_filter_cb, &settings);
+  BLI_kdtree_3d_free(tree);
+
+  BMVert **verts_filter = MEM_mallocN(sizeof(*verts_filter) * verts_len, __func__);
+  int verts_filter_len = 0;
+  for (int i = 0; i < verts_len; i++) {
+    if (use_vert[i]) {
+      verts_filter[verts_filter_len++] = verts[i];
+    }
+  }
+  MEM_freeN(use_vert);
+
+  *r_verts_filter_len = verts_filter_len;
+  return verts_filter;
+}
+
 static void bmesh_find_doubles_common(BMesh *bm,
                                       BMOperator *op,
                                       BMOperator *optarget,
@@ -632,7 +715,7 @@ static void bmesh_find_doubles_common(BMesh *bm,
 {
   const BMOpSlot *slot_verts = BMO_slot_get(op->slots_in, "verts");
   BMVert *const *verts = (BMVert **)slot_verts->data.buf;
-  const int verts_len = slot_verts->len;
+  int verts_len = slot_verts->len;
 
   bool has_keep_vert = false;
   bool found_duplicates = false;
@@ -646,8 +729,13 @@ static void bmesh_find_doubles_common(BMesh *bm,
   }
 
   /* Flag keep_verts */
+  BMVert **verts_filter = NULL;
   if (has_keep_vert) {
     BMO_slot_buffer_flag_enable(bm, op->slots_in, "keep_verts", BM_VERT, VERT_KEEP);
+    verts_filter = bmesh_find_doubles_keep_filter(bm, verts, verts_len, dist, &verts_len);
+    if (verts_filter != NULL) {
+      verts = verts_filter;
+    }
   }
 
   int *duplicates = MEM_mallocN(sizeof(int) * verts_len, __func__);
@@ -686,6 +774,9 @@ static void bmesh_find_doubles_common(BMesh *bm,
   }
 
   MEM_freeN(duplicates);
+  if (verts_filter != NULL) {
+    MEM_freeN(verts_filter);
+  }
 }
 
 void bmo_remove_doubles_exec(BMesh *bm, BMOperator *op)
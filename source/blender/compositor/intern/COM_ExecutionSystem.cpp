@@ -33,6 +33,9 @@
 #include "COM_ReadBufferOperation.h"
 #include "COM_WorkScheduler.h"
 
+#include <map>
+#include <set>
+
 #ifdef WITH_CXX_GUARDEDALLOC
 #  include "MEM_guardedalloc.h"
 #endif
@@ -179,11 +182,13 @@ void ExecutionSystem::execute()
 
   WorkScheduler::start(this->m_context);
 
-  executeGroups(COM_PRIORITY_HIGH);
+  vector<ExecutionGroup *> executionGroups;
+  this->findOutputExecutionGroup(&executionGroups, COM_PRIORITY_HIGH);
   if (!this->getContext().isFastCalculation()) {
-    executeGroups(COM_PRIORITY_MEDIUM);
-    executeGroups(COM_PRIORITY_LOW);
+    this->findOutputExecutionGroup(&executionGroups, COM_PRIORITY_MEDIUM);
+    this->findOutputExecutionGroup(&executionGroups, COM_PRIORITY_LOW);
   }
+  executeGroups(executionGroups);
 
   WorkScheduler::finish();
   WorkScheduler::stop();
@@ -199,15 +204,44 @@ void ExecutionSystem::execute()
   }
 }
 
-void ExecutionSystem::executeGroups(CompositorPriority priority)
+static void find_depending_memory_proxies(ExecutionGroup *group,
+                                          std::set<MemoryProxy *> &r_proxies)
+{
+  vector<MemoryProxy *> memoryProxies;
+  group->determineDependingMemoryProxies(&memoryProxies);
+
+  for (MemoryProxy *memoryProxy : memoryProxies) {
+    if (r_proxies.insert(memoryProxy).second && memoryProxy->getExecutor()) {
+      find_depending_memory_proxies(memoryProxy->getExecutor(), r_proxies);
+    }
+  }
+}
+
+void ExecutionSystem::executeGroups(const vector<ExecutionGroup *> &executionGroups)
 {
   unsigned int index;
-  vector<ExecutionGroup *> executionGroups;
-  this->findOutputExecutionGroup(&executionGroups, priority);
+
+  /* Index of the last output group reading from each buffer, directly or through other
+   * buffers. Buffers are freed once that group is done instead of at the end of the
+   * execution, which keeps the peak memory of trees with several outputs down. */
+  std::map<MemoryProxy *, unsigned int> lastUse;
+  for (index = 0; index < executionGroups.size(); index++) {
+    std::set<MemoryProxy *> memoryProxies;
+    find_depending_memory_proxies(executionGroups[index], memoryProxies);
+    for (MemoryProxy *memoryProxy : memoryProxies) {
+      lastUse[memoryProxy] = index;
+    }
+  }
 
   for (index = 0; index < executionGroups.size(); index++) {
     ExecutionGroup *group = executionGroups[index];
     group->execute(this);
+
+    for (const std::pair<MemoryProxy *const, unsigned int> &use : lastUse) {
+      if (use.second == index) {
+        use.first->free();
+      }
+    }
   }
 }
 
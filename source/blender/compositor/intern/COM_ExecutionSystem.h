@@ -186,7 +186,7 @@ class ExecutionSystem {
   }
 
  private:
-  void executeGroups(CompositorPriority priority);
+  void executeGroups(const vector<ExecutionGroup *> &executionGroups);
 
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
@@ -99,11 +99,35 @@ class SocketReader {
   {
   }
 
+  /**
+   * \brief calculate a row of pixels
+   * \note this method is called for non-complex, operations that can process a row in bulk
+   * override it to avoid a virtual call per pixel
+   * \param output: array to store the pixels of the row next to each other
+   * \param x1: the first x-coordinate of the row in image space
+   * \param x2: the x-coordinate after the last pixel of the row
+   * \param y: the y-coordinate of the row in image space
+   * \param num_channels: number of floats stored for each pixel in \a output
+   */
+  virtual void executeRowSampled(
+      float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler)
+  {
+    for (int x = x1; x < x2; x++) {
+      executePixelSampled(output, x, y, sampler);
+      output += num_channels;
+    }
+  }
+
  public:
   inline void readSampled(float result[4], float x, float y, PixelSampler sampler)
   {
     executePixelSampled(result, x, y, sampler);
   }
+  inline void readRowSampled(
+      float *result, int x1, int x2, int y, int num_channels, PixelSampler sampler)
+  {
+    executeRowSampled(result, x1, x2, y, num_channels, sampler);
+  }
   inline void read(float result[4], int x, int y, void *chunkData)
   {
     executePixel(result, x, y, chunkData);
@@ -30,6 +30,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 #include "PIL_time.h"
 
 #include "BKE_global.h"
@@ -75,8 +76,11 @@ void *WorkScheduler::thread_execute_cpu(void *data)
   CPUDevice *device = (CPUDevice *)data;
   WorkPackage *work;
   BLI_thread_local_set(g_thread_device, device);
+  BLI_trace_thread_name_set("Compositor CPU");
   while ((work = (WorkPackage *)BLI_thread_queue_pop(g_cpuqueue))) {
+    BLI_TRACE_ZONE_BEGIN("Compositor work package");
     device->execute(work);
+    BLI_TRACE_ZONE_END();
     delete work;
   }
 
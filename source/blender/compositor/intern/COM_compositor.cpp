@@ -17,12 +17,14 @@
  */
 
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BLT_translation.h"
 
 #include "BKE_node.h"
 #include "BKE_scene.h"
 
+#include "COM_DenoiseOperation.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_MovieDistortionOperation.h"
 #include "COM_WorkScheduler.h"
@@ -57,6 +59,8 @@ void COM_execute(RenderData *rd,
     return;
   }
 
+  BLI_TRACE_SCOPE("Compositor");
+
   /* Make sure node tree has previews.
    * Don't create previews in advance, this is done when adding preview operations.
    * Reserved preview size is determined by render output for now.
@@ -113,6 +117,7 @@ void COM_deinitialize()
   if (is_compositorMutex_init) {
     BLI_mutex_lock(&s_compositorMutex);
     WorkScheduler::deinitialize();
+    DenoiseOperation::freeCache();
     is_compositorMutex_init = false;
     BLI_mutex_unlock(&s_compositorMutex);
     BLI_mutex_end(&s_compositorMutex);
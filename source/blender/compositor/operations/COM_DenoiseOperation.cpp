@@ -17,14 +17,129 @@
  */
 
 #include "COM_DenoiseOperation.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_math.h"
 #include "BLI_system.h"
+#include "BLI_threads.h"
 #ifdef WITH_OPENIMAGEDENOISE
-#  include "BLI_threads.h"
 #  include <OpenImageDenoise/oidn.hpp>
 static pthread_mutex_t oidn_lock = BLI_MUTEX_INITIALIZER;
 #endif
 #include <iostream>
+#include <list>
+
+/**
+ * Results of the last few denoise executions. Editing a node after the denoise node
+ * re-executes the whole tree, with these the unchanged input is not denoised again.
+ */
+struct DenoiseCacheEntry {
+  const NodeDenoise *settings;
+  uint64_t input_hash;
+  MemoryBuffer *result;
+};
+
+#define DENOISE_CACHE_SIZE 4
+
+static std::list<DenoiseCacheEntry> denoise_cache;
+static pthread_mutex_t denoise_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static size_t denoise_buffer_size(MemoryBuffer *buffer)
+{
+  return sizeof(float) * buffer->get_num_channels() * buffer->getWidth() * buffer->getHeight();
+}
+
+static void denoise_hash_buffer(BLI_HashMurmur2A *mm2, MemoryBuffer *buffer)
+{
+  if (buffer == nullptr || buffer->getBuffer() == nullptr) {
+    BLI_hash_mm2a_add_int(mm2, 0);
+    return;
+  }
+
+  BLI_hash_mm2a_add_int(mm2, buffer->getWidth());
+  BLI_hash_mm2a_add_int(mm2, buffer->getHeight());
+  BLI_hash_mm2a_add_int(mm2, buffer->get_num_channels());
+  BLI_hash_mm2a_add(mm2, (const unsigned char *)buffer->getBuffer(), denoise_buffer_size(buffer));
+}
+
+static uint64_t denoise_input_hash(MemoryBuffer *color,
+                                   MemoryBuffer *normal,
+                                   MemoryBuffer *albedo,
+                                   const NodeDenoise *settings)
+{
+  /* Two seeds give a 64 bit hash, so a stale result is practically never used. */
+  uint64_t hash = 0;
+  for (int seed = 0; seed < 2; seed++) {
+    BLI_HashMurmur2A mm2;
+    BLI_hash_mm2a_init(&mm2, seed);
+    denoise_hash_buffer(&mm2, color);
+    denoise_hash_buffer(&mm2, normal);
+    denoise_hash_buffer(&mm2, albedo);
+    BLI_hash_mm2a_add_int(&mm2, (settings) ? settings->hdr : 0);
+    hash = (hash << 32) | BLI_hash_mm2a_end(&mm2);
+  }
+  return hash;
+}
+
+static bool denoise_cache_lookup(const NodeDenoise *settings,
+                                 uint64_t input_hash,
+                                 MemoryBuffer *result)
+{
+  bool found = false;
+
+  BLI_mutex_lock(&denoise_cache_lock);
+  for (std::list<DenoiseCacheEntry>::iterator it = denoise_cache.begin();
+       it != denoise_cache.end();
+       ++it) {
+    if (it->settings == settings && it->input_hash == input_hash &&
+        denoise_buffer_size(it->result) == denoise_buffer_size(result)) {
+      memcpy(result->getBuffer(), it->result->getBuffer(), denoise_buffer_size(result));
+      /* Keep the most recently used entries at the front. */
+      denoise_cache.splice(denoise_cache.begin(), denoise_cache, it);
+      found = true;
+      break;
+    }
+  }
+  BLI_mutex_unlock(&denoise_cache_lock);
+
+  return found;
+}
+
+static void denoise_cache_store(const NodeDenoise *settings,
+                                uint64_t input_hash,
+                                MemoryBuffer *result)
+{
+  MemoryBuffer *copy = new MemoryBuffer(COM_DT_COLOR, result->getRect());
+  memcpy(copy->getBuffer(), result->getBuffer(), denoise_buffer_size(result));
+
+  BLI_mutex_lock(&denoise_cache_lock);
+  /* A node only keeps its latest result. */
+  for (std::list<DenoiseCacheEntry>::iterator it = denoise_cache.begin();
+       it != denoise_cache.end();) {
+    if (it->settings == settings) {
+      delete it->result;
+      it = denoise_cache.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+  denoise_cache.push_front({settings, input_hash, copy});
+  while (denoise_cache.size() > DENOISE_CACHE_SIZE) {
+    delete denoise_cache.back().result;
+    denoise_cache.pop_back();
+  }
+  BLI_mutex_unlock(&denoise_cache_lock);
+}
+
+void DenoiseOperation::freeCache()
+{
+  BLI_mutex_lock(&denoise_cache_lock);
+  for (DenoiseCacheEntry &entry : denoise_cache) {
+    delete entry.result;
+  }
+  denoise_cache.clear();
+  BLI_mutex_unlock(&denoise_cache_lock);
+}
 
 DenoiseOperation::DenoiseOperation()
 {
@@ -61,8 +176,12 @@ MemoryBuffer *DenoiseOperation::createMemoryBuffer(rcti *rect2)
   rect.xmax = getWidth();
   rect.ymax = getHeight();
   MemoryBuffer *result = new MemoryBuffer(COM_DT_COLOR, &rect);
-  float *data = result->getBuffer();
-  this->generateDenoise(data, tileColor, tileNormal, tileAlbedo, this->m_settings);
+  const uint64_t input_hash = denoise_input_hash(tileColor, tileNormal, tileAlbedo, m_settings);
+  if (!denoise_cache_lookup(m_settings, input_hash, result)) {
+    float *data = result->getBuffer();
+    this->generateDenoise(data, tileColor, tileNormal, tileAlbedo, this->m_settings);
+    denoise_cache_store(m_settings, input_hash, result);
+  }
   return result;
 }
 
@@ -55,6 +55,11 @@ class DenoiseOperation : public SingleThreadedOperation {
                                         ReadBufferOperation *readOperation,
                                         rcti *output);
 
+  /**
+   * Free the results kept from previous executions.
+   */
+  static void freeCache();
+
  protected:
   void generateDenoise(float *data,
                        MemoryBuffer *inputTileColor,
@@ -18,6 +18,7 @@
 
 #include <climits>
 
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "COM_FastGaussianBlurOperation.h"
 #include "MEM_guardedalloc.h"
@@ -110,17 +111,129 @@ void *FastGaussianBlurOperation::initializeTileData(rcti *rect)
   return this->m_iirgaus;
 }
 
+/* Coefficients of the recursive filter and the channel of the buffer it filters. */
+struct IIRGaussData {
+  double cf[4];
+  double tsM[9];
+  float *buffer;
+  unsigned int width;
+  unsigned int height;
+  unsigned int num_channels;
+  unsigned int chan;
+};
+
+/* Intermediate buffers of one thread, allocated for the longest line on first use. */
+struct IIRGaussLines {
+  double *X;
+  double *Y;
+  double *W;
+};
+
+static void iir_gauss_yvv(const IIRGaussData *data,
+                          const double *X,
+                          double *W,
+                          double *Y,
+                          unsigned int L)
+{
+  const double *cf = data->cf;
+  const double *tsM = data->tsM;
+  double tsu[3], tsv[3];
+  unsigned int i;
+
+  W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0];
+  for (i = 3; i < L; i++) {
+    W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3];
+  }
+  tsu[0] = W[L - 1] - X[L - 1];
+  tsu[1] = W[L - 2] - X[L - 1];
+  tsu[2] = W[L - 3] - X[L - 1];
+  tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1];
+  tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1];
+  tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1];
+  Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2];
+  Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1];
+  Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0];
+  /* 'i != UINT_MAX' is really 'i >= 0', but necessary for unsigned int wrapping */
+  for (i = L - 4; i != UINT_MAX; i--) {
+    Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3];
+  }
+}
+
+static IIRGaussLines *iir_gauss_lines_ensure(const IIRGaussData *data,
+                                             const TaskParallelTLS *__restrict tls)
+{
+  IIRGaussLines *lines = (IIRGaussLines *)tls->userdata_chunk;
+  if (lines->X == nullptr) {
+    const unsigned int sz = max(data->width, data->height);
+    lines->X = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss X buf");
+    lines->Y = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss Y buf");
+    lines->W = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss W buf");
+  }
+  return lines;
+}
+
+static void iir_gauss_lines_free(const void *__restrict /*userdata*/, void *__restrict chunk)
+{
+  IIRGaussLines *lines = (IIRGaussLines *)chunk;
+  MEM_SAFE_FREE(lines->X);
+  MEM_SAFE_FREE(lines->Y);
+  MEM_SAFE_FREE(lines->W);
+}
+
+static void iir_gauss_row_task(void *__restrict userdata,
+                               const int y,
+                               const TaskParallelTLS *__restrict tls)
+{
+  const IIRGaussData *data = (const IIRGaussData *)userdata;
+  IIRGaussLines *lines = iir_gauss_lines_ensure(data, tls);
+  float *buffer = data->buffer;
+
+  const int yx = y * data->width;
+  int offset = yx * data->num_channels + data->chan;
+  for (unsigned int x = 0; x < data->width; x++) {
+    lines->X[x] = buffer[offset];
+    offset += data->num_channels;
+  }
+  iir_gauss_yvv(data, lines->X, lines->W, lines->Y, data->width);
+  offset = yx * data->num_channels + data->chan;
+  for (unsigned int x = 0; x < data->width; x++) {
+    buffer[offset] = lines->Y[x];
+    offset += data->num_channels;
+  }
+}
+
+static void iir_gauss_column_task(void *__restrict userdata,
+                                  const int x,
+                                  const TaskParallelTLS *__restrict tls)
+{
+  const IIRGaussData *data = (const IIRGaussData *)userdata;
+  IIRGaussLines *lines = iir_gauss_lines_ensure(data, tls);
+  float *buffer = data->buffer;
+  const int add = data->width * data->num_channels;
+
+  int offset = x * data->num_channels + data->chan;
+  for (unsigned int y = 0; y < data->height; y++) {
+    lines->X[y] = buffer[offset];
+    offset += add;
+  }
+  iir_gauss_yvv(data, lines->X, lines->W, lines->Y, data->height);
+  offset = x * data->num_channels + data->chan;
+  for (unsigned int y = 0; y < data->height; y++) {
+    buffer[offset] = lines->Y[y];
+    offset += add;
+  }
+}
+
 void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
                                           float sigma,
                                           unsigned int chan,
                                           unsigned int xy)
 {
-  double q, q2, sc, cf[4], tsM[9], tsu[3], tsv[3];
-  double *X, *Y, *W;
+  double q, q2, sc, cf[4], tsM[9];
   const unsigned int src_width = src->getWidth();
   const unsigned int src_height = src->getHeight();
-  unsigned int x, y, sz;
-  unsigned int i;
   float *buffer = src->getBuffer();
   const unsigned int num_channels = src->get_num_channels();
 
@@ -184,75 +297,30 @@ void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
                  cf[3] * cf[3] * cf[3] - cf[3] * cf[2] + cf[3]);
   tsM[8] = sc * (cf[3] * (cf[1] + cf[3] * cf[2]));
 
-#define YVV(L) \
-  { \
-    W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0]; \
-    for (i = 3; i < L; i++) { \
-      W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3]; \
-    } \
-    tsu[0] = W[L - 1] - X[L - 1]; \
-    tsu[1] = W[L - 2] - X[L - 1]; \
-    tsu[2] = W[L - 3] - X[L - 1]; \
-    tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1]; \
-    tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1]; \
-    tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1]; \
-    Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2]; \
-    Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1]; \
-    Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0]; \
-    /* 'i != UINT_MAX' is really 'i >= 0', but necessary for unsigned int wrapping */ \
-    for (i = L - 4; i != UINT_MAX; i--) { \
-      Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3]; \
-    } \
-  } \
-  (void)0
-
-  // intermediate buffers
-  sz = max(src_width, src_height);
-  X = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss X buf");
-  Y = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss Y buf");
-  W = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss W buf");
+  IIRGaussData data;
+  memcpy(data.cf, cf, sizeof(cf));
+  memcpy(data.tsM, tsM, sizeof(tsM));
+  data.buffer = buffer;
+  data.width = src_width;
+  data.height = src_height;
+  data.num_channels = num_channels;
+  data.chan = chan;
+
+  /* Every row and column is filtered on its own, with intermediate buffers per thread. */
+  IIRGaussLines lines = {nullptr, nullptr, nullptr};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &lines;
+  settings.userdata_chunk_size = sizeof(lines);
+  settings.func_free = iir_gauss_lines_free;
+  settings.min_iter_per_thread = 8;
+
   if (xy & 1) {  // H
-    int offset;
-    for (y = 0; y < src_height; y++) {
-      const int yx = y * src_width;
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        X[x] = buffer[offset];
-        offset += num_channels;
-      }
-      YVV(src_width);
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        buffer[offset] = Y[x];
-        offset += num_channels;
-      }
-    }
+    BLI_task_parallel_range(0, src_height, &data, iir_gauss_row_task, &settings);
   }
   if (xy & 2) {  // V
-    int offset;
-    const int add = src_width * num_channels;
-
-    for (x = 0; x < src_width; x++) {
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        X[y] = buffer[offset];
-        offset += add;
-      }
-      YVV(src_height);
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        buffer[offset] = Y[y];
-        offset += add;
-      }
-    }
+    BLI_task_parallel_range(0, src_width, &data, iir_gauss_column_task, &settings);
   }
-
-  MEM_freeN(X);
-  MEM_freeN(W);
-  MEM_freeN(Y);
-#undef YVV
 }
 
 ///
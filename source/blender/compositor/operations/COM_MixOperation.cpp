@@ -124,6 +124,29 @@ void MixAddOperation::executePixelSampled(float output[4], float x, float y, Pix
   clampIfNeeded(output);
 }
 
+void MixAddOperation::executeRowSampled(
+    float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler)
+{
+  executeMixRow(output,
+                x1,
+                x2,
+                y,
+                num_channels,
+                sampler,
+                [](float *result, const float *color1, const float *color2, float value) {
+#ifdef __SSE2__
+                  const __m128 rgb = _mm_add_ps(
+                      _mm_loadu_ps(color1), _mm_mul_ps(_mm_set1_ps(value), _mm_loadu_ps(color2)));
+                  _mm_storeu_ps(result, rgb);
+#else
+                  result[0] = color1[0] + value * color2[0];
+                  result[1] = color1[1] + value * color2[1];
+                  result[2] = color1[2] + value * color2[2];
+#endif
+                  result[3] = color1[3];
+                });
+}
+
 /* ******** Mix Blend Operation ******** */
 
 MixBlendOperation::MixBlendOperation()
@@ -158,6 +181,31 @@ void MixBlendOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixBlendOperation::executeRowSampled(
+    float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler)
+{
+  executeMixRow(output,
+                x1,
+                x2,
+                y,
+                num_channels,
+                sampler,
+                [](float *result, const float *color1, const float *color2, float value) {
+                  float valuem = 1.0f - value;
+#ifdef __SSE2__
+                  const __m128 rgb = _mm_add_ps(
+                      _mm_mul_ps(_mm_set1_ps(valuem), _mm_loadu_ps(color1)),
+                      _mm_mul_ps(_mm_set1_ps(value), _mm_loadu_ps(color2)));
+                  _mm_storeu_ps(result, rgb);
+#else
+                  result[0] = valuem * color1[0] + value * color2[0];
+                  result[1] = valuem * color1[1] + value * color2[1];
+                  result[2] = valuem * color1[2] + value * color2[2];
+#endif
+                  result[3] = color1[3];
+                });
+}
+
 /* ******** Mix Burn Operation ******** */
 
 MixColorBurnOperation::MixColorBurnOperation()
@@ -705,6 +753,32 @@ void MixMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixMultiplyOperation::executeRowSampled(
+    float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler)
+{
+  executeMixRow(output,
+                x1,
+                x2,
+                y,
+                num_channels,
+                sampler,
+                [](float *result, const float *color1, const float *color2, float value) {
+                  float valuem = 1.0f - value;
+#ifdef __SSE2__
+                  const __m128 rgb = _mm_mul_ps(
+                      _mm_loadu_ps(color1),
+                      _mm_add_ps(_mm_set1_ps(valuem),
+                                 _mm_mul_ps(_mm_set1_ps(value), _mm_loadu_ps(color2))));
+                  _mm_storeu_ps(result, rgb);
+#else
+                  result[0] = color1[0] * (valuem + value * color2[0]);
+                  result[1] = color1[1] * (valuem + value * color2[1]);
+                  result[2] = color1[2] * (valuem + value * color2[2]);
+#endif
+                  result[3] = color1[3];
+                });
+}
+
 /* ******** Mix Ovelray Operation ******** */
 
 MixOverlayOperation::MixOverlayOperation()
@@ -909,6 +983,29 @@ void MixSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixSubtractOperation::executeRowSampled(
+    float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler)
+{
+  executeMixRow(output,
+                x1,
+                x2,
+                y,
+                num_channels,
+                sampler,
+                [](float *result, const float *color1, const float *color2, float value) {
+#ifdef __SSE2__
+                  const __m128 rgb = _mm_sub_ps(
+                      _mm_loadu_ps(color1), _mm_mul_ps(_mm_set1_ps(value), _mm_loadu_ps(color2)));
+                  _mm_storeu_ps(result, rgb);
+#else
+                  result[0] = color1[0] - value * color2[0];
+                  result[1] = color1[1] - value * color2[1];
+                  result[2] = color1[2] - value * color2[2];
+#endif
+                  result[3] = color1[3];
+                });
+}
+
 /* ******** Mix Value Operation ******** */
 
 MixValueOperation::MixValueOperation()
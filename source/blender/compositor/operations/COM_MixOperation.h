@@ -20,6 +20,13 @@
 
 #include "COM_NodeOperation.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+/* Number of pixels whose inputs are read at once by row execution. */
+#define COM_MIX_ROW_SPAN 64
+
 /**
  * All this programs converts an input color to an output value.
  * it assumes we are in sRGB color space.
@@ -43,6 +50,44 @@ class MixBaseOperation : public NodeOperation {
     }
   }
 
+  /**
+   * Row execution shared by the mix modes, reads the inputs of a span of pixels at once and
+   * calls \a mix(output, color1, color2, value) for every pixel of the span.
+   */
+  template<typename MixFunc>
+  void executeMixRow(
+      float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler, MixFunc mix)
+  {
+    if (num_channels != 4) {
+      NodeOperation::executeRowSampled(output, x1, x2, y, num_channels, sampler);
+      return;
+    }
+
+    /* Padded so a reader writing a full color for a value stays inside the array. */
+    float inputValue[COM_MIX_ROW_SPAN + 3];
+    float inputColor1[COM_MIX_ROW_SPAN * 4];
+    float inputColor2[COM_MIX_ROW_SPAN * 4];
+
+    for (int x = x1; x < x2; x += COM_MIX_ROW_SPAN) {
+      const int span_end = MIN2(x + COM_MIX_ROW_SPAN, x2);
+      this->m_inputValueOperation->readRowSampled(inputValue, x, span_end, y, 1, sampler);
+      this->m_inputColor1Operation->readRowSampled(inputColor1, x, span_end, y, 4, sampler);
+      this->m_inputColor2Operation->readRowSampled(inputColor2, x, span_end, y, 4, sampler);
+
+      for (int i = 0; i < span_end - x; i++) {
+        const float *color1 = &inputColor1[i * 4];
+        const float *color2 = &inputColor2[i * 4];
+        float value = inputValue[i];
+        if (this->useValueAlphaMultiply()) {
+          value *= color2[3];
+        }
+        mix(output, color1, color2, value);
+        clampIfNeeded(output);
+        output += 4;
+      }
+    }
+  }
+
  public:
   /**
    * Default constructor
@@ -84,12 +129,16 @@ class MixAddOperation : public MixBaseOperation {
  public:
   MixAddOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRowSampled(
+      float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler);
 };
 
 class MixBlendOperation : public MixBaseOperation {
  public:
   MixBlendOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRowSampled(
+      float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler);
 };
 
 class MixColorBurnOperation : public MixBaseOperation {
@@ -156,6 +205,8 @@ class MixMultiplyOperation : public MixBaseOperation {
  public:
   MixMultiplyOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRowSampled(
+      float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler);
 };
 
 class MixOverlayOperation : public MixBaseOperation {
@@ -186,6 +237,8 @@ class MixSubtractOperation : public MixBaseOperation {
  public:
   MixSubtractOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRowSampled(
+      float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler);
 };
 
 class MixValueOperation : public MixBaseOperation {
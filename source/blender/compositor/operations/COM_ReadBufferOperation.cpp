@@ -74,6 +74,23 @@ void ReadBufferOperation::executePixelSampled(float output[4],
   }
 }
 
+void ReadBufferOperation::executeRowSampled(
+    float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler)
+{
+  const rcti *rect = m_buffer->getRect();
+  const bool inside = (y >= rect->ymin && y < rect->ymax && x1 >= rect->xmin && x2 <= rect->xmax);
+  const int buffer_channels = m_buffer->get_num_channels();
+
+  if (m_single_value || sampler != COM_PS_NEAREST || !inside || buffer_channels != num_channels) {
+    NodeOperation::executeRowSampled(output, x1, x2, y, num_channels, sampler);
+    return;
+  }
+
+  /* Nearest samples of pixel coordinates are a plain copy of the buffer row. */
+  const float *buffer = m_buffer->getBuffer() + (m_buffer->getWidth() * y + x1) * num_channels;
+  memcpy(output, buffer, sizeof(float) * num_channels * (x2 - x1));
+}
+
 void ReadBufferOperation::executePixelExtend(float output[4],
                                              float x,
                                              float y,
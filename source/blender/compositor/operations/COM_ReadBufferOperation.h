@@ -50,6 +50,8 @@ class ReadBufferOperation : public NodeOperation {
                           MemoryBufferExtend extend_x,
                           MemoryBufferExtend extend_y);
   void executePixelFiltered(float output[4], float x, float y, float dx[2], float dy[2]);
+  void executeRowSampled(
+      float *output, int x1, int x2, int y, int num_channels, PixelSampler sampler);
   bool isReadBufferOperation() const
   {
     return true;
@@ -62,6 +62,17 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Evaluation Tracing */
+
+/* Start recording the evaluation time and thread of every evaluated operation. Discards the
+ * events which were recorded by a previous trace. */
+void DEG_debug_trace_begin(struct Depsgraph *graph);
+void DEG_debug_trace_end(struct Depsgraph *graph);
+
+/* Write the recorded events in the Chrome trace event format (JSON). */
+void DEG_debug_trace_chrome(const struct Depsgraph *graph, FILE *fp);
+
 /* ************************************************ */
 
 /* Compare two dependency graphs. */
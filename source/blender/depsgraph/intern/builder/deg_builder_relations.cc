@@ -32,6 +32,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -2749,10 +2750,25 @@ void DepsgraphRelationBuilder::build_scene_speakers(Scene * /*scene*/, ViewLayer
   }
 }
 
+static void build_copy_on_write_relations_range_func(void *__restrict userdata,
+                                                     const int i,
+                                                     const TaskParallelTLS *__restrict /*tls*/)
+{
+  DepsgraphRelationBuilder *builder = static_cast<DepsgraphRelationBuilder *>(userdata);
+  builder->build_copy_on_write_relations(builder->getGraph()->id_nodes[i]);
+}
+
 void DepsgraphRelationBuilder::build_copy_on_write_relations()
 {
+  /* Relations inside of an ID only link nodes of that ID, so the IDs are handled in parallel.
+   * Relations between different IDs are added afterwards from a single thread. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(
+      0, graph_->id_nodes.size(), this, build_copy_on_write_relations_range_func, &settings);
   for (IDNode *id_node : graph_->id_nodes) {
-    build_copy_on_write_relations(id_node);
+    build_copy_on_write_relations_to_data(id_node);
   }
 }
 
@@ -2880,23 +2896,6 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * evaluation step needs geometry, it will have transitive dependency
      * to Mesh copy-on-write already. */
   }
-  /* TODO(sergey): This solves crash for now, but causes too many
-   * updates potentially. */
-  if (GS(id_orig->name) == ID_OB) {
-    Object *object = (Object *)id_orig;
-    ID *object_data_id = (ID *)object->data;
-    if (object_data_id != nullptr) {
-      if (deg_copy_on_write_is_needed(object_data_id)) {
-        OperationKey data_copy_on_write_key(
-            object_data_id, NodeType::COPY_ON_WRITE, OperationCode::COPY_ON_WRITE);
-        add_relation(
-            data_copy_on_write_key, copy_on_write_key, "Eval Order", RELATION_FLAG_GODMODE);
-      }
-    }
-    else {
-      BLI_assert(object->type == OB_EMPTY);
-    }
-  }
 
 #if 0
   /* NOTE: Relation is disabled since AnimationBackup() is disabled.
@@ -2919,6 +2918,34 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
 #endif
 }
 
+/* Copy-on-write of an object needs the copy-on-write of its data. This links nodes of different
+ * IDs, so unlike relations inside of an ID it can not be added in parallel. */
+void DepsgraphRelationBuilder::build_copy_on_write_relations_to_data(IDNode *id_node)
+{
+  ID *id_orig = id_node->id_orig;
+  if (!deg_copy_on_write_is_needed(GS(id_orig->name))) {
+    return;
+  }
+  /* TODO(sergey): This solves crash for now, but causes too many
+   * updates potentially. */
+  if (GS(id_orig->name) == ID_OB) {
+    OperationKey copy_on_write_key(id_orig, NodeType::COPY_ON_WRITE, OperationCode::COPY_ON_WRITE);
+    Object *object = (Object *)id_orig;
+    ID *object_data_id = (ID *)object->data;
+    if (object_data_id != nullptr) {
+      if (deg_copy_on_write_is_needed(object_data_id)) {
+        OperationKey data_copy_on_write_key(
+            object_data_id, NodeType::COPY_ON_WRITE, OperationCode::COPY_ON_WRITE);
+        add_relation(
+            data_copy_on_write_key, copy_on_write_key, "Eval Order", RELATION_FLAG_GODMODE);
+      }
+    }
+    else {
+      BLI_assert(object->type == OB_EMPTY);
+    }
+  }
+}
+
 /* **** ID traversal callbacks functions **** */
 
 void DepsgraphRelationBuilder::modifier_walk(void *user_data,
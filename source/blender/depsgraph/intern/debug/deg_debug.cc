@@ -32,10 +32,16 @@
 
 #include "BKE_global.h"
 
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_operation.h"
+
 namespace blender::deg {
 
 DepsgraphDebug::DepsgraphDebug()
-    : flags(G.debug), is_ever_evaluated(false), graph_evaluation_start_time_(0)
+    : flags(G.debug),
+      is_ever_evaluated(false),
+      graph_evaluation_start_time_(0),
+      is_tracing_(false)
 {
 }
 
@@ -72,6 +78,42 @@ void DepsgraphDebug::end_graph_evaluation()
   is_ever_evaluated = true;
 }
 
+bool DepsgraphDebug::is_tracing() const
+{
+  return is_tracing_;
+}
+
+void DepsgraphDebug::begin_trace()
+{
+  trace_events_.clear();
+  is_tracing_ = true;
+}
+
+void DepsgraphDebug::end_trace()
+{
+  is_tracing_ = false;
+}
+
+void DepsgraphDebug::add_trace_event(const OperationNode *operation_node,
+                                     const double start_time,
+                                     const double end_time)
+{
+  DepsgraphTraceEvent event;
+  event.name = operation_node->full_identifier();
+  event.category = nodeTypeAsString(operation_node->owner->type);
+  event.thread_id = std::this_thread::get_id();
+  event.start_time = start_time;
+  event.end_time = end_time;
+
+  std::lock_guard<std::mutex> lock(trace_mutex_);
+  trace_events_.append(std::move(event));
+}
+
+Span<DepsgraphTraceEvent> DepsgraphDebug::trace_events() const
+{
+  return trace_events_;
+}
+
 bool terminal_do_color()
 {
   return (G.debug & G_DEBUG_DEPSGRAPH_PRETTY) != 0;
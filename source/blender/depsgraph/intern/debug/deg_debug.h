@@ -23,6 +23,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <thread>
+
 #include "intern/debug/deg_time_average.h"
 #include "intern/depsgraph_type.h"
 
@@ -33,6 +36,20 @@
 namespace blender {
 namespace deg {
 
+struct OperationNode;
+
+/* Evaluation of a single operation, as recorded while tracing. */
+struct DepsgraphTraceEvent {
+  /* Full identifier of the operation, the operation node itself might be gone when the graph is
+   * rebuilt before the trace is written. */
+  string name;
+  /* Name of the component the operation belongs to. */
+  string category;
+  std::thread::id thread_id;
+  double start_time;
+  double end_time;
+};
+
 class DepsgraphDebug {
  public:
   DepsgraphDebug();
@@ -42,6 +59,17 @@ class DepsgraphDebug {
   void begin_graph_evaluation();
   void end_graph_evaluation();
 
+  /* Tracing of the evaluation. While it is enabled, every evaluated operation is recorded with
+   * the thread it was evaluated on. */
+  bool is_tracing() const;
+  void begin_trace();
+  void end_trace();
+  /* Is safe to be called from multiple threads. */
+  void add_trace_event(const OperationNode *operation_node,
+                       const double start_time,
+                       const double end_time);
+  Span<DepsgraphTraceEvent> trace_events() const;
+
   /* NOTE: Corresponds to G_DEBUG_DEPSGRAPH_* flags. */
   int flags;
 
@@ -63,6 +91,10 @@ class DepsgraphDebug {
   double graph_evaluation_start_time_;
 
   AveragedTimeSampler<MAX_FPS_COUNTERS> fps_samples_;
+
+  bool is_tracing_;
+  std::mutex trace_mutex_;
+  Vector<DepsgraphTraceEvent> trace_events_;
 };
 
 #define DEG_DEBUG_PRINTF(depsgraph, type, ...) \
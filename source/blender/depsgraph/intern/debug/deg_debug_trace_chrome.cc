@@ -0,0 +1,119 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Export of the recorded evaluation trace in the Chrome trace event format, which can be opened
+ * in `chrome://tracing` or in Perfetto.
+ */
+
+#include "DEG_depsgraph_debug.h"
+
+#include <algorithm>
+
+#include "intern/debug/deg_debug.h"
+#include "intern/depsgraph.h"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+namespace {
+
+void write_json_string(FILE *file, const string &str)
+{
+  fputc('"', file);
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        fputs("\\\"", file);
+        break;
+      case '\\':
+        fputs("\\\\", file);
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          fprintf(file, "\\u%04x", (unsigned int)c);
+        }
+        else {
+          fputc(c, file);
+        }
+        break;
+    }
+  }
+  fputc('"', file);
+}
+
+/* Threads are numbered in the order they appear in the trace, there are only a few of them. */
+int thread_index(Vector<std::thread::id> &threads, const std::thread::id thread_id)
+{
+  const int64_t index = threads.first_index_of_try(thread_id);
+  if (index != -1) {
+    return (int)index;
+  }
+  threads.append(thread_id);
+  return (int)threads.size() - 1;
+}
+
+void deg_debug_trace_chrome(const Depsgraph *graph, FILE *file)
+{
+  Span<DepsgraphTraceEvent> events = graph->debug.trace_events();
+  double trace_start_time = events.is_empty() ? 0.0 : events[0].start_time;
+  for (const DepsgraphTraceEvent &event : events) {
+    trace_start_time = std::min(trace_start_time, event.start_time);
+  }
+
+  Vector<std::thread::id> threads;
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  for (const DepsgraphTraceEvent &event : events) {
+    /* Timestamps are in microseconds. */
+    fprintf(file, "{\"name\":");
+    write_json_string(file, event.name);
+    fprintf(file, ",\"cat\":");
+    write_json_string(file, event.category);
+    fprintf(file,
+            ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d},\n",
+            (event.start_time - trace_start_time) * 1e6,
+            (event.end_time - event.start_time) * 1e6,
+            thread_index(threads, event.thread_id));
+  }
+  /* Metadata, which also takes care of the trailing comma of the last event. */
+  fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":");
+  write_json_string(file, graph->debug.name.empty() ? string("Depsgraph") : graph->debug.name);
+  fprintf(file, "}}");
+  for (const int i : threads.index_range()) {
+    fprintf(file,
+            ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+            "\"args\":{\"name\":\"Thread %d\"}}",
+            i,
+            i);
+  }
+  fprintf(file, "\n]}\n");
+}
+
+}  // namespace
+}  // namespace blender::deg
+
+void DEG_debug_trace_chrome(const Depsgraph *depsgraph, FILE *fp)
+{
+  if (depsgraph == nullptr) {
+    return;
+  }
+  deg::deg_debug_trace_chrome(reinterpret_cast<const deg::Depsgraph *>(depsgraph), fp);
+}
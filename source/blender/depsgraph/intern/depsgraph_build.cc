@@ -257,6 +257,13 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
 {
   DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
   deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
+  if (deg_graph->need_update) {
+    /* The graph is already going to be rebuilt before the next evaluation, and the scene has been
+     * tagged when the first relations update was requested. Operators tend to request relations
+     * updates many times in a row (once per added or linked object), avoid flushing the scene tag
+     * through the graph every time. */
+    return;
+  }
   deg_graph->need_update = true;
   /* NOTE: When relations are updated, it's quite possible that
    * we've got new bases in the scene. This means, we need to
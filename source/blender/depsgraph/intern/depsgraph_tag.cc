@@ -272,7 +272,8 @@ void depsgraph_tag_component(Depsgraph *graph,
                              IDNode *id_node,
                              NodeType component_type,
                              OperationCode operation_code,
-                             eUpdateSource update_source)
+                             eUpdateSource update_source,
+                             const bool allow_copy_on_write_tag = true)
 {
   ComponentNode *component_node = id_node->find_component(component_type);
   /* NOTE: Animation component might not be existing yet (which happens when adding new driver or
@@ -294,7 +295,7 @@ void depsgraph_tag_component(Depsgraph *graph,
     }
   }
   /* If component depends on copy-on-write, tag it as well. */
-  if (component_node->need_tag_cow_before_update()) {
+  if (allow_copy_on_write_tag && component_node->need_tag_cow_before_update()) {
     depsgraph_id_tag_copy_on_write(graph, id_node, update_source);
   }
 }
@@ -393,6 +394,12 @@ void graph_id_tag_update_single_flag(Main *bmain,
   if (component_type == NodeType::ID_REF) {
     id_node->tag_update(graph, update_source);
   }
+  else if (tag == ID_RECALC_AUDIO_SEEK) {
+    /* Seeking only depends on the current frame, which is set on the evaluated scene without
+     * copying it. This avoids copying the whole scene on every frame change done by the user,
+     * which happens continuously while scrubbing the timeline. */
+    depsgraph_tag_component(graph, id_node, component_type, operation_code, update_source, false);
+  }
   else {
     depsgraph_tag_component(graph, id_node, component_type, operation_code, update_source);
   }
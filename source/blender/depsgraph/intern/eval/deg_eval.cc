@@ -30,7 +30,9 @@
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.h"
 
@@ -73,6 +75,15 @@ void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), Tas
   BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
 }
 
+using ReadyOperations = Vector<OperationNode *, 16>;
+
+void schedule_node_to_vector(OperationNode *node,
+                             const int /*thread_id*/,
+                             ReadyOperations *ready_operations)
+{
+  ready_operations->append(node);
+}
+
 /* Denotes which part of dependency graph is being evaluated. */
 enum class EvaluationStage {
   /* Stage 1: Only  Copy-on-Write operations are to be evaluated, prior to anything else.
@@ -93,6 +104,7 @@ enum class EvaluationStage {
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  bool do_trace;
   EvaluationStage stage;
   bool need_single_thread_pass;
 };
@@ -103,28 +115,55 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Perform operation. The timing is always measured, it is used to prioritize the operation in
+   * the following evaluations. */
+  const double start_time = PIL_check_seconds_timer();
+  BLI_TRACE_ZONE_BEGIN(operationCodeAsString(operation_node->opcode));
+  operation_node->evaluate(depsgraph);
+  BLI_TRACE_ZONE_END();
+  const double end_time = PIL_check_seconds_timer();
+  const double eval_time = end_time - start_time;
+  operation_node->last_eval_time = eval_time;
   if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    operation_node->stats.current_time += eval_time;
   }
-  else {
-    operation_node->evaluate(depsgraph);
+  if (state->do_trace) {
+    state->graph->debug.add_trace_event(operation_node, start_time, end_time);
   }
 }
 
+bool operation_critical_path_time_greater(const OperationNode *a, const OperationNode *b)
+{
+  return a->critical_path_time > b->critical_path_time;
+}
+
 void deg_task_run_func(TaskPool *pool, void *taskdata)
 {
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  ReadyOperations ready_operations;
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    /* Schedule children. The one with the most expensive chain of dependent operations is
+     * evaluated right away by this thread, the others are made available to other threads. */
+    ready_operations.clear();
+    schedule_children(state, operation_node, schedule_node_to_vector, &ready_operations);
+    if (ready_operations.is_empty()) {
+      break;
+    }
+    OperationNode **most_expensive = std::min_element(
+        ready_operations.begin(), ready_operations.end(), operation_critical_path_time_greater);
+    operation_node = *most_expensive;
+    for (OperationNode *ready_operation : ready_operations) {
+      if (ready_operation != operation_node) {
+        schedule_node_to_pool(ready_operation, 0, pool);
+      }
+    }
+  }
 }
 
 bool check_operation_node_visible(OperationNode *op_node)
@@ -177,10 +216,67 @@ void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
+bool need_evaluate_operation(OperationNode *node)
+{
+  return check_operation_node_visible(node) && (node->flag & DEPSOP_FLAG_NEEDS_UPDATE);
+}
+
+/* Operations which were never evaluated still have some overhead, and this makes the critical
+ * path fall back to the length of the chain of dependent operations. */
+constexpr double operation_min_eval_time = 1e-6;
+
+/* Calculate the critical path time of every operation which is to be evaluated, which is its own
+ * cost plus the most expensive critical path of the operations depending on it. Operations are
+ * visited in depth-first post-order, without recursion since chains can be very long. */
+void calculate_critical_path_times(Depsgraph *graph)
+{
+  enum { NOT_VISITED = 0, IN_PROGRESS = 1, DONE = 2 };
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = NOT_VISITED;
+    node->critical_path_time = 0.0;
+  }
+  Vector<std::pair<OperationNode *, int64_t>> stack;
+  for (OperationNode *root : graph->operations) {
+    if (root->custom_flags != NOT_VISITED || !need_evaluate_operation(root)) {
+      continue;
+    }
+    root->custom_flags = IN_PROGRESS;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      OperationNode *node = stack.last().first;
+      int64_t &next_link = stack.last().second;
+      if (next_link < node->outlinks.size()) {
+        const Relation *rel = node->outlinks[next_link++];
+        OperationNode *child = (OperationNode *)rel->to;
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && child->custom_flags == NOT_VISITED &&
+            need_evaluate_operation(child)) {
+          child->custom_flags = IN_PROGRESS;
+          stack.append({child, 0});
+        }
+        continue;
+      }
+      double children_time = 0.0;
+      for (const Relation *rel : node->outlinks) {
+        const OperationNode *child = (const OperationNode *)rel->to;
+        if (child->custom_flags == DONE) {
+          children_time = std::max(children_time, child->critical_path_time);
+        }
+      }
+      const double own_time = node->is_noop() ?
+                                  0.0 :
+                                  std::max(node->last_eval_time, operation_min_eval_time);
+      node->critical_path_time = own_time + children_time;
+      node->custom_flags = DONE;
+      stack.remove_last();
+    }
+  }
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
+  calculate_critical_path_times(graph);
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
     if (do_stats) {
@@ -306,6 +402,20 @@ void schedule_children(DepsgraphEvalState *state,
   }
 }
 
+/* Schedule all operations which are ready to be evaluated, starting with the ones that have the
+ * most expensive chain of operations depending on them. Worker threads take tasks in the order
+ * they have been pushed, so long dependency chains get started first. */
+void schedule_graph_to_pool(DepsgraphEvalState *state, TaskPool *pool)
+{
+  ReadyOperations ready_operations;
+  schedule_graph(state, schedule_node_to_vector, &ready_operations);
+  std::stable_sort(
+      ready_operations.begin(), ready_operations.end(), operation_critical_path_time_greater);
+  for (OperationNode *node : ready_operations) {
+    schedule_node_to_pool(node, 0, pool);
+  }
+}
+
 void schedule_node_to_queue(OperationNode *node,
                             const int /*thread_id*/,
                             GSQueue *evaluation_queue)
@@ -370,6 +480,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
     return;
   }
 
+  BLI_TRACE_SCOPE("Depsgraph evaluation");
   graph->debug.begin_graph_evaluation();
 
   graph->is_evaluating = true;
@@ -378,6 +489,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.do_trace = graph->debug.is_tracing();
   state.need_single_thread_pass = false;
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -386,14 +498,14 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
   TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
   task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
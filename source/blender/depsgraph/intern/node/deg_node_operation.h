@@ -266,6 +266,13 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Time spent on evaluating this operation the last time it was evaluated. Used as an estimate
+   * of its cost when deciding which operations are to be started first. */
+  double last_eval_time;
+  /* Estimated time needed to evaluate this operation and the most expensive chain of tagged
+   * operations which depend on it. */
+  double critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -81,6 +81,9 @@ typedef bool (*DRW_ObjectFilterFn)(struct Object *ob, void *user_data);
 void DRW_draw_view(const struct bContext *C);
 void DRW_draw_region_engine_info(int xoffset, int *yoffset, int line_height);
 
+/* Profiling, only recorded when the debug value is between 21 and 29. */
+bool DRW_stats_trace_chrome_write(const char *filepath);
+
 void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
                              struct RenderEngineType *engine_type,
                              struct ARegion *region,
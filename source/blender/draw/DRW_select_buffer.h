@@ -77,6 +77,8 @@ typedef struct SELECTID_Context {
 
   /* To check for updates. */
   float persmat[4][4];
+  /** The view settings the drawing depends on, see #select_engine_view_flag_get. */
+  int view_flag;
   bool is_dirty;
 } SELECTID_Context;
 
@@ -294,6 +294,9 @@ static void eevee_object_data_init(DrawData *dd)
   eevee_data->shadow_caster_id = -1;
   eevee_data->need_update = false;
   eevee_data->geom_update = false;
+  /* Instances of objects that were never drawn before have to update the shadows. */
+  eevee_data->instance_update = true;
+  eevee_data->instance_update_id = 0;
 }
 
 EEVEE_ObjectEngineData *EEVEE_object_data_get(Object *ob)
@@ -27,15 +27,22 @@
 #include "BKE_global.h"
 
 #include "BLI_endian_switch.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_threads.h"
 
 #include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_query.h"
 
+#include "BKE_material.h"
 #include "BKE_object.h"
 
 #include "DNA_collection_types.h"
+#include "DNA_light_types.h"
 #include "DNA_lightprobe_types.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_world_types.h"
 
 #include "PIL_time.h"
 
@@ -151,6 +158,8 @@ typedef struct EEVEE_LightBake {
   int cube_offset;
   /** Pointer to the owner_id of the probe object. */
   LightProbe **cube_prb;
+  /** Hash of the scene content seen by each cube, see #LightCache.cube_hash. */
+  uint *cube_hash;
 
   /* Dummy Textures */
   struct GPUTexture *dummy_color, *dummy_depth;
@@ -509,6 +518,7 @@ void EEVEE_lightcache_free(LightCache *lcache)
 
   MEM_SAFE_FREE(lcache->cube_data);
   MEM_SAFE_FREE(lcache->grid_data);
+  MEM_SAFE_FREE(lcache->cube_hash);
   MEM_freeN(lcache);
 }
 
@@ -545,6 +555,9 @@ void EEVEE_lightcache_blend_write(BlendWriter *writer, LightCache *cache)
 
   BLO_write_struct_array(writer, LightGridCache, cache->grid_len, cache->grid_data);
   BLO_write_struct_array(writer, LightProbeCache, cache->cube_len, cache->cube_data);
+  if (cache->cube_hash) {
+    BLO_write_uint32_array(writer, cache->cube_len, cache->cube_hash);
+  }
 }
 
 static void direct_link_lightcache_texture(BlendDataReader *reader, LightCacheTexture *lctex)
@@ -586,6 +599,7 @@ void EEVEE_lightcache_blend_read_data(BlendDataReader *reader, LightCache *cache
 
   BLO_read_data_address(reader, &cache->cube_data);
   BLO_read_data_address(reader, &cache->grid_data);
+  BLO_read_uint32_array(reader, cache->cube_len, &cache->cube_hash);
 }
 
 /** \} */
@@ -695,6 +709,7 @@ static void eevee_lightbake_create_resources(EEVEE_LightBake *lbake)
   lbake->ref_cube_res = lbake->rt_res;
   lbake->cube_prb = MEM_callocN(sizeof(LightProbe *) * lbake->cube_len, "EEVEE Cube visgroup ptr");
   lbake->grid_prb = MEM_callocN(sizeof(LightProbe *) * lbake->grid_len, "EEVEE Grid visgroup ptr");
+  lbake->cube_hash = MEM_callocN(sizeof(uint) * lbake->cube_len, "EEVEE Cube hash");
 
   lbake->grid_prev = DRW_texture_create_2d_array(lbake->irr_size[0],
                                                  lbake->irr_size[1],
@@ -725,6 +740,10 @@ static void eevee_lightbake_create_resources(EEVEE_LightBake *lbake)
 
   EEVEE_lightcache_load(eevee->light_cache_data);
 
+  if (lbake->lcache->cube_hash == NULL) {
+    lbake->lcache->cube_hash = MEM_callocN(sizeof(uint) * lbake->cube_len, "EEVEE Cube hash");
+  }
+
   lbake->lcache->flag |= LIGHTCACHE_BAKING;
   lbake->lcache->cube_len = 1;
 }
@@ -838,6 +857,7 @@ void EEVEE_lightbake_job_data_free(void *custom_data)
 
   MEM_SAFE_FREE(lbake->cube_prb);
   MEM_SAFE_FREE(lbake->grid_prb);
+  MEM_SAFE_FREE(lbake->cube_hash);
 
   BLI_mutex_free(lbake->mutex);
 
@@ -1325,6 +1345,144 @@ static void eevee_lightbake_gather_probes(EEVEE_LightBake *lbake)
   lbake->done = 0;
 }
 
+static void eevee_lightbake_hash_light(BLI_HashMurmur2A *mm2, Object *ob)
+{
+  Light *la = (Light *)ob->data;
+  BLI_hash_mm2a_add(mm2, (const uchar *)ob->obmat, sizeof(ob->obmat));
+  BLI_hash_mm2a_add_int(mm2, la->type);
+  BLI_hash_mm2a_add_int(mm2, la->mode);
+  BLI_hash_mm2a_add_int(mm2, la->area_shape);
+  BLI_hash_mm2a_add(mm2, (const uchar *)&la->r, sizeof(float[3]));
+  BLI_hash_mm2a_add(mm2, (const uchar *)&la->energy, sizeof(la->energy));
+  BLI_hash_mm2a_add(mm2, (const uchar *)&la->spotsize, sizeof(la->spotsize));
+  BLI_hash_mm2a_add(mm2, (const uchar *)&la->spotblend, sizeof(la->spotblend));
+  BLI_hash_mm2a_add(mm2, (const uchar *)&la->area_size, sizeof(float[3]));
+  BLI_hash_mm2a_add(mm2, (const uchar *)&la->spec_fac, sizeof(la->spec_fac));
+}
+
+static uint eevee_lightbake_hash_object(Object *ob)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  BLI_hash_mm2a_add(&mm2, (const uchar *)ob->id.name, strlen(ob->id.name));
+  BLI_hash_mm2a_add(&mm2, (const uchar *)ob->obmat, sizeof(ob->obmat));
+
+  for (int i = 1; i <= ob->totcol; i++) {
+    Material *ma = BKE_object_material_get(ob, i);
+    if (ma != NULL) {
+      BLI_hash_mm2a_add(&mm2, (const uchar *)ma->id.name, strlen(ma->id.name));
+    }
+  }
+
+  Mesh *me = (ob->type == OB_MESH) ? BKE_object_get_evaluated_mesh(ob) : NULL;
+  if (me != NULL) {
+    BLI_hash_mm2a_add_int(&mm2, me->totvert);
+    BLI_hash_mm2a_add_int(&mm2, me->totpoly);
+    for (int i = 0; i < me->totvert; i++) {
+      BLI_hash_mm2a_add(&mm2, (const uchar *)me->mvert[i].co, sizeof(float[3]));
+    }
+  }
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+/**
+ * Compute a hash of everything a reflection cubemap can see: the probe itself, the bake settings,
+ * all lights and the objects overlapping its clipping sphere. Objects are combined in an order
+ * independent way so that the hash does not change with the depsgraph iteration order.
+ * Note that edits of material node-trees are not detected.
+ */
+static void eevee_lightbake_cube_hashes_compute(EEVEE_LightBake *lbake)
+{
+  Depsgraph *depsgraph = lbake->depsgraph;
+  Scene *scene_eval = DEG_get_evaluated_scene(depsgraph);
+  SceneEEVEE *eevee = &scene_eval->eevee;
+  LightCache *lcache = lbake->lcache;
+
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  BLI_hash_mm2a_add(&mm2, (const uchar *)&eevee->gi_glossy_clamp, sizeof(float));
+  BLI_hash_mm2a_add(&mm2, (const uchar *)&eevee->gi_filter_quality, sizeof(float));
+  BLI_hash_mm2a_add_int(&mm2, eevee->flag);
+  BLI_hash_mm2a_add_int(&mm2, eevee->shadow_cube_size);
+  BLI_hash_mm2a_add_int(&mm2, eevee->shadow_cascade_size);
+  if (scene_eval->world != NULL) {
+    const char *name = scene_eval->world->id.name;
+    BLI_hash_mm2a_add(&mm2, (const uchar *)name, strlen(name));
+  }
+
+  int objects_len = 0, objects_alloc_len = 64;
+  uint *objects_hash = MEM_mallocN(sizeof(*objects_hash) * objects_alloc_len, __func__);
+  float(*objects_bounds)[2][3] = MEM_mallocN(sizeof(*objects_bounds) * objects_alloc_len,
+                                             __func__);
+
+  DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
+    const int ob_visibility = BKE_object_visibility(ob, DAG_EVAL_RENDER);
+    if ((ob_visibility & OB_VISIBLE_SELF) == 0) {
+      continue;
+    }
+    if (ob->type == OB_LAMP) {
+      /* Lights can light any cubemap. */
+      eevee_lightbake_hash_light(&mm2, ob);
+      continue;
+    }
+    if (ob->type == OB_LIGHTPROBE) {
+      continue;
+    }
+    BoundBox *bb = BKE_object_boundbox_get(ob);
+    if (bb == NULL) {
+      continue;
+    }
+    if (objects_len == objects_alloc_len) {
+      objects_alloc_len *= 2;
+      objects_hash = MEM_reallocN(objects_hash, sizeof(*objects_hash) * objects_alloc_len);
+      objects_bounds = MEM_reallocN(objects_bounds, sizeof(*objects_bounds) * objects_alloc_len);
+    }
+    INIT_MINMAX(objects_bounds[objects_len][0], objects_bounds[objects_len][1]);
+    for (int i = 0; i < 8; i++) {
+      float vec[3];
+      mul_v3_m4v3(vec, ob->obmat, bb->vec[i]);
+      minmax_v3v3_v3(objects_bounds[objects_len][0], objects_bounds[objects_len][1], vec);
+    }
+    objects_hash[objects_len++] = eevee_lightbake_hash_object(ob);
+  }
+  DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
+
+  const uint global_hash = BLI_hash_mm2a_end(&mm2);
+
+  for (int i = 1; i < lbake->cube_len; i++) {
+    EEVEE_LightProbe *eprobe = &lcache->cube_data[i];
+    LightProbe *prb = lbake->cube_prb[i];
+
+    BLI_hash_mm2a_init(&mm2, global_hash);
+    BLI_hash_mm2a_add(&mm2, (const uchar *)eprobe, sizeof(*eprobe));
+    BLI_hash_mm2a_add(&mm2, (const uchar *)&prb->clipsta, sizeof(float[2]));
+    BLI_hash_mm2a_add(&mm2, (const uchar *)&prb->intensity, sizeof(float));
+    BLI_hash_mm2a_add_int(&mm2, prb->flag);
+    if (prb->visibility_grp != NULL) {
+      const char *name = prb->visibility_grp->id.name;
+      BLI_hash_mm2a_add(&mm2, (const uchar *)name, strlen(name));
+    }
+
+    uint objects_sum = 0;
+    for (int j = 0; j < objects_len; j++) {
+      float nearest[3];
+      copy_v3_v3(nearest, eprobe->position);
+      clamp_v3_v3v3(nearest, objects_bounds[j][0], objects_bounds[j][1]);
+      if (len_squared_v3v3(nearest, eprobe->position) <= square_f(prb->clipend)) {
+        objects_sum += objects_hash[j];
+      }
+    }
+    BLI_hash_mm2a_add_int(&mm2, (int)objects_sum);
+
+    /* Zero is reserved for cubemaps that have not been baked. */
+    const uint hash = BLI_hash_mm2a_end(&mm2);
+    lbake->cube_hash[i] = (hash != 0) ? hash : 1;
+  }
+
+  MEM_freeN(objects_hash);
+  MEM_freeN(objects_bounds);
+}
+
 void EEVEE_lightbake_update(void *custom_data)
 {
   EEVEE_LightBake *lbake = (EEVEE_LightBake *)custom_data;
@@ -1406,9 +1564,17 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
 
   /* Gather all probes data */
   eevee_lightbake_gather_probes(lbake);
+  eevee_lightbake_cube_hashes_compute(lbake);
 
   LightCache *lcache = lbake->lcache;
 
+  /* Cubemaps see the world and the irradiance grids. If those are rebaked, so are all the
+   * cubemaps. Otherwise only the cubemaps whose content changed since the last bake are. */
+  const bool cubes_only = (lcache->flag & (LIGHTCACHE_UPDATE_WORLD | LIGHTCACHE_UPDATE_GRID)) == 0;
+  if (!cubes_only) {
+    memset(lcache->cube_hash, 0, sizeof(uint) * lbake->cube_len);
+  }
+
   /* HACK: Sleep to delay the first rendering operation
    * that causes a small freeze (caused by VBO generation)
    * because this step is locking at this moment. */
@@ -1449,7 +1615,23 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      const int i = lbake->cube_offset;
+      if (G.is_break == true || *lbake->stop) {
+        break;
+      }
+      if (cubes_only && lcache->cube_hash[i] == lbake->cube_hash[i]) {
+        /* The cubemap texture already contains the right data. */
+        lcache->cube_len += 1;
+        if (i == lbake->cube_len - 1) {
+          lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
+        }
+        lbake->done += 1;
+        *lbake->progress = lbake->done / (float)lbake->total;
+        continue;
+      }
+      if (lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample)) {
+        lcache->cube_hash[i] = lbake->cube_hash[i];
+      }
     }
   }
 
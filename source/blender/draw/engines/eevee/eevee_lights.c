@@ -208,11 +208,95 @@ void EEVEE_lights_cache_add(EEVEE_ViewLayerData *sldata, Object *ob)
   linfo->num_light++;
 }
 
+static int light_tile_coord_get(float ndc)
+{
+  /* Clamp before the conversion to avoid overflows. Keep in sync with light_tile_mask_get. */
+  return (int)clamp_f(floorf((ndc * 0.5f + 0.5f) * LIGHT_TILE_GRID), 0.0f, LIGHT_TILE_GRID - 1);
+}
+
+/**
+ * Range of tiles covered by the influence sphere of a light. Tiles on the screen borders also
+ * contain everything that projects outside the screen, so the bounds are clamped and not culled.
+ */
+static void light_tile_bounds_get(const EEVEE_Light *evli,
+                                  const float persmat[4][4],
+                                  int r_tile_min[2],
+                                  int r_tile_max[2])
+{
+  r_tile_min[0] = r_tile_min[1] = 0;
+  r_tile_max[0] = r_tile_max[1] = LIGHT_TILE_GRID - 1;
+
+  if (evli->light_type == LA_SUN) {
+    return;
+  }
+
+  const float radius = 1.0f / sqrtf(evli->invsqrdist);
+  float ndc_min[2] = {FLT_MAX, FLT_MAX};
+  float ndc_max[2] = {-FLT_MAX, -FLT_MAX};
+  /* The projection of the bounding box contains the projection of the sphere, as long as the
+   * box is entirely in front of the view. */
+  for (int i = 0; i < 8; i++) {
+    float co[4] = {evli->position[0] + ((i & 1) ? radius : -radius),
+                   evli->position[1] + ((i & 2) ? radius : -radius),
+                   evli->position[2] + ((i & 4) ? radius : -radius),
+                   1.0f};
+    mul_m4_v4(persmat, co);
+    if (co[3] <= 1e-6f) {
+      return;
+    }
+    for (int j = 0; j < 2; j++) {
+      ndc_min[j] = min_ff(ndc_min[j], co[j] / co[3]);
+      ndc_max[j] = max_ff(ndc_max[j], co[j] / co[3]);
+    }
+  }
+  for (int j = 0; j < 2; j++) {
+    r_tile_min[j] = light_tile_coord_get(ndc_min[j]);
+    r_tile_max[j] = light_tile_coord_get(ndc_max[j]);
+  }
+}
+
+/**
+ * Bin the lights into screen tiles so that the surface shaders only evaluate the lights whose
+ * influence sphere covers the tile of the shaded point. The tiles are built from the default
+ * view, and the shaders compute the tile of a point with the same matrix. So the culling stays
+ * correct for other views (probes, planar reflections), it is only less effective there.
+ */
+static void eevee_light_tiles_setup(EEVEE_ViewLayerData *sldata)
+{
+  EEVEE_LightsInfo *linfo = sldata->lights;
+  EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
+
+  BLI_STATIC_ASSERT(MAX_LIGHT == 128, "Tile masks are stored as uvec4 in the shaders")
+
+  if (DRW_view_default_get() == NULL) {
+    /* No culling. */
+    unit_m4(common_data->la_tile_persmat);
+    memset(linfo->light_tile_mask, 0xFF, sizeof(linfo->light_tile_mask));
+    return;
+  }
+
+  DRW_view_persmat_get(NULL, common_data->la_tile_persmat, false);
+  memset(linfo->light_tile_mask, 0, sizeof(linfo->light_tile_mask));
+
+  for (int i = 0; i < linfo->num_light; i++) {
+    int tile_min[2], tile_max[2];
+    light_tile_bounds_get(&linfo->light_data[i], common_data->la_tile_persmat, tile_min, tile_max);
+
+    for (int y = tile_min[1]; y <= tile_max[1]; y++) {
+      for (int x = tile_min[0]; x <= tile_max[0]; x++) {
+        linfo->light_tile_mask[y * LIGHT_TILE_GRID + x][i / 32] |= 1u << (i % 32);
+      }
+    }
+  }
+}
+
 void EEVEE_lights_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *UNUSED(vedata))
 {
   EEVEE_LightsInfo *linfo = sldata->lights;
 
   sldata->common_data.la_num_light = linfo->num_light;
 
+  eevee_light_tiles_setup(sldata);
+
   GPU_uniformbuf_update(sldata->light_ubo, &linfo->light_data);
 }
@@ -48,6 +48,7 @@ extern struct DrawEngineType draw_engine_eevee_type;
 #define MAX_GRID 64   /* TODO : find size by dividing UBO max size by grid data size */
 #define MAX_PLANAR 16 /* TODO : find size by dividing UBO max size by grid data size */
 #define MAX_LIGHT 128 /* TODO : find size by dividing UBO max size by light data size */
+#define LIGHT_TILE_GRID 16 /* Number of light culling tiles along each screen axis. */
 #define MAX_CASCADE_NUM 4
 #define MAX_SHADOW 128 /* TODO : Make this depends on GL_MAX_ARRAY_TEXTURE_LAYERS */
 #define MAX_SHADOW_CASCADE 8
@@ -76,6 +77,7 @@ extern struct DrawEngineType draw_engine_eevee_type;
   "#define MAX_GRID " STRINGIFY(MAX_GRID) "\n" \
   "#define MAX_PLANAR " STRINGIFY(MAX_PLANAR) "\n" \
   "#define MAX_LIGHT " STRINGIFY(MAX_LIGHT) "\n" \
+  "#define LIGHT_TILE_GRID " STRINGIFY(LIGHT_TILE_GRID) "\n" \
   "#define MAX_SHADOW " STRINGIFY(MAX_SHADOW) "\n" \
   "#define MAX_SHADOW_CUBE " STRINGIFY(MAX_SHADOW_CUBE) "\n" \
   "#define MAX_SHADOW_CASCADE " STRINGIFY(MAX_SHADOW_CASCADE) "\n" \
@@ -515,6 +517,8 @@ typedef struct EEVEE_LightsInfo {
   bool shadow_high_bitdepth, soft_shadows;
   /* UBO Storage : data used by UBO */
   struct EEVEE_Light light_data[MAX_LIGHT];
+  /* Bitmask of the lights affecting each screen tile, uploaded right after light_data. */
+  uint light_tile_mask[LIGHT_TILE_GRID * LIGHT_TILE_GRID][MAX_LIGHT / 32];
   struct EEVEE_Shadow shadow_data[MAX_SHADOW];
   struct EEVEE_ShadowCube shadow_cube_data[MAX_SHADOW_CUBE];
   struct EEVEE_ShadowCascade shadow_cascade_data[MAX_SHADOW_CASCADE];
@@ -533,6 +537,8 @@ typedef struct EEVEE_LightsInfo {
   struct {
     float min[3], max[3];
   } shcaster_aabb;
+  /* Incremented on each shadow caster registration round. */
+  uint shcaster_redraw_id;
 } EEVEE_LightsInfo;
 
 /* ************ PROBE DATA ************* */
@@ -700,6 +706,7 @@ typedef struct EEVEE_EffectsInfo {
   bool prev_drw_support;
   bool prev_is_navigating;
   float prev_drw_persmat[4][4]; /* Used for checking view validity and reprojection. */
+  float prev_drw_persinv[4][4]; /* Used for disocclusion rejection when reprojecting. */
   struct DRWView *taa_view;
   /* Ambient Occlusion */
   int ao_depth_layer;
@@ -778,8 +785,9 @@ typedef struct EEVEE_EffectsInfo {
  * - Arrays of vec2/vec3 are padded as arrays of vec4.
  * - sizeof(bool) == sizeof(int) in GLSL so use int in C */
 typedef struct EEVEE_CommonUniformBuffer {
-  float prev_persmat[4][4]; /* mat4 */
-  float mip_ratio[10][4];   /* vec2[10] */
+  float prev_persmat[4][4];    /* mat4 */
+  float la_tile_persmat[4][4]; /* mat4 */
+  float mip_ratio[10][4];      /* vec2[10] */
   /* Ambient Occlusion */
   /* -- 16 byte aligned -- */
   float ao_dist, pad1, ao_factor, pad2;                    /* vec4 */
@@ -909,6 +917,10 @@ typedef struct EEVEE_ObjectEngineData {
   bool need_update;
   bool geom_update;
   uint shadow_caster_id;
+  /* The object was tagged for update and is maybe used by instances. */
+  bool instance_update;
+  /* Caster registration round in which instance_update was consumed. */
+  uint instance_update_id;
 } EEVEE_ObjectEngineData;
 
 typedef struct EEVEE_WorldEngineData {
@@ -23,6 +23,7 @@
 #include "BLI_string_utils.h"
 #include "BLI_sys_types.h" /* bool */
 
+#include "BKE_duplilist.h"
 #include "BKE_object.h"
 
 #include "DEG_depsgraph_query.h"
@@ -40,6 +41,8 @@ void eevee_contact_shadow_setup(const Light *la, EEVEE_Shadow *evsh)
 
 void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
 {
+  const uint light_ubo_size = sizeof(EEVEE_Light) * MAX_LIGHT +
+                              sizeof(((EEVEE_LightsInfo *)NULL)->light_tile_mask);
   const uint shadow_ubo_size = sizeof(EEVEE_Shadow) * MAX_SHADOW +
                                sizeof(EEVEE_ShadowCube) * MAX_SHADOW_CUBE +
                                sizeof(EEVEE_ShadowCascade) * MAX_SHADOW_CASCADE;
@@ -49,7 +52,7 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
 
   if (!sldata->lights) {
     sldata->lights = MEM_callocN(sizeof(EEVEE_LightsInfo), "EEVEE_LightsInfo");
-    sldata->light_ubo = GPU_uniformbuf_create_ex(sizeof(EEVEE_Light) * MAX_LIGHT, NULL, "evLight");
+    sldata->light_ubo = GPU_uniformbuf_create_ex(light_ubo_size, NULL, "evLight");
     sldata->shadow_ubo = GPU_uniformbuf_create_ex(shadow_ubo_size, NULL, "evShadow");
 
     for (int i = 0; i < 2; i++) {
@@ -114,6 +117,8 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 
   INIT_MINMAX(linfo->shcaster_aabb.min, linfo->shcaster_aabb.max);
 
+  linfo->shcaster_redraw_id++;
+
   {
     DRWState state = DRW_STATE_WRITE_DEPTH | DRW_STATE_DEPTH_LESS_EQUAL | DRW_STATE_SHADOW_OFFSET;
     DRW_PASS_CREATE(psl->shadow_pass, state);
@@ -123,6 +128,32 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   }
 }
 
+/**
+ * Return true if the object was tagged for update since the previous caster registration.
+ * Unlike need_update, this can be queried by any number of instances of the object.
+ */
+static bool eevee_shadows_instance_source_updated(EEVEE_LightsInfo *linfo, Object *ob)
+{
+  if (ob == NULL) {
+    return false;
+  }
+  if (ELEM(ob->type, OB_LIGHTPROBE, OB_LAMP)) {
+    /* Instancer without object engine data. */
+    return false;
+  }
+  EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob);
+  if (oedata->instance_update) {
+    oedata->instance_update = false;
+    oedata->instance_update_id = linfo->shcaster_redraw_id;
+  }
+  return oedata->instance_update_id == linfo->shcaster_redraw_id;
+}
+
+static bool eevee_bound_box_equals(const EEVEE_BoundBox *a, const EEVEE_BoundBox *b)
+{
+  return equals_v3v3(a->center, b->center) && equals_v3v3(a->halfdim, b->halfdim);
+}
+
 /* Make that object update shadow casting lights inside its influence bounding box. */
 void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
 {
@@ -140,10 +171,14 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
   }
 
-  if (ob->base_flag & BASE_FROM_DUPLI) {
-    /* Duplis will always refresh the shadowmaps as if they were deleted each frame. */
-    /* TODO(fclem): fix this. */
-    update = true;
+  const bool is_dupli = (ob->base_flag & BASE_FROM_DUPLI) != 0;
+  if (is_dupli) {
+    /* Duplis have no persistent engine data, so they can't keep track of their caster index.
+     * They are checked against the caster at the same index in the previous redraw below. */
+    DupliObject *dupli = DRW_object_get_dupli(ob);
+    update = (dupli == NULL);
+    update |= eevee_shadows_instance_source_updated(linfo, dupli ? dupli->ob : NULL);
+    update |= eevee_shadows_instance_source_updated(linfo, DRW_object_get_dupli_parent(ob));
   }
   else {
     EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob);
@@ -181,6 +216,20 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
   aabb->halfdim[1] = fabsf(aabb->halfdim[1]);
   aabb->halfdim[2] = fabsf(aabb->halfdim[2]);
 
+  if (is_dupli) {
+    /* The instances are generated in the same order on each redraw. An instance that didn't move
+     * takes the place of its previous self, otherwise both bounds need a shadow update. */
+    if (id < backbuffer->count && eevee_bound_box_equals(&backbuffer->bbox[id], aabb)) {
+      BLI_BITMAP_SET(backbuffer->update, id, update);
+    }
+    else {
+      update = true;
+    }
+    if (update) {
+      BLI_BITMAP_ENABLE(frontbuffer->update, id);
+    }
+  }
+
   minmax_v3v3_v3(linfo->shcaster_aabb.min, linfo->shcaster_aabb.max, min);
   minmax_v3v3_v3(linfo->shcaster_aabb.min, linfo->shcaster_aabb.max, max);
 
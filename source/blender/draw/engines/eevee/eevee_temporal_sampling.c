@@ -182,6 +182,23 @@ void EEVEE_temporal_sampling_reset(EEVEE_Data *vedata)
   vedata->stl->effects->taa_current_sample = 1;
 }
 
+/**
+ * The motion blur camera matrices are only set for final renders. When reprojecting in the
+ * viewport, fill them with the previous and current redraw so the velocity buffer contains the
+ * motion vectors used to find the history samples.
+ */
+static void eevee_temporal_sampling_reprojection_matrices_set(EEVEE_EffectsInfo *effects)
+{
+  EEVEE_MotionBlurData *mb_data = &effects->motion_blur;
+
+  copy_m4_m4(mb_data->camera[MB_PREV].persmat, effects->prev_drw_persmat);
+  DRW_view_persmat_get(NULL, mb_data->camera[MB_CURR].persmat, false);
+  DRW_view_persmat_get(NULL, mb_data->camera[MB_CURR].persinv, true);
+  copy_m4_m4(mb_data->camera[MB_NEXT].persmat, mb_data->camera[MB_CURR].persmat);
+
+  invert_m4_m4(effects->prev_drw_persinv, effects->prev_drw_persmat);
+}
+
 void EEVEE_temporal_sampling_create_view(EEVEE_Data *vedata)
 {
   EEVEE_EffectsInfo *effects = vedata->stl->effects;
@@ -280,6 +297,10 @@ int EEVEE_temporal_sampling_init(EEVEE_ViewLayerData *UNUSED(sldata), EEVEE_Data
       }
     }
 
+    if (repro_flag != 0) {
+      eevee_temporal_sampling_reprojection_matrices_set(effects);
+    }
+
     return repro_flag | EFFECT_TAA | EFFECT_DOUBLE_BUFFER | EFFECT_DEPTH_DOUBLE_BUFFER |
            EFFECT_POST_BUFFER;
   }
@@ -310,7 +331,10 @@ void EEVEE_temporal_sampling_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data
     if (effects->enabled_effects & EFFECT_TAA_REPROJECT) {
       DefaultTextureList *dtxl = DRW_viewport_texture_list_get();
       DRW_shgroup_uniform_texture_ref(grp, "depthBuffer", &dtxl->depth);
-      DRW_shgroup_uniform_mat4(grp, "prevViewProjectionMatrix", effects->prev_drw_persmat);
+      /* Still contains the depth of the previous redraw, see #EEVEE_temporal_sampling_draw. */
+      DRW_shgroup_uniform_texture_ref(grp, "prevDepthBuffer", &txl->depth_double_buffer);
+      DRW_shgroup_uniform_texture_ref(grp, "velocityBuffer", &effects->velocity_tx);
+      DRW_shgroup_uniform_mat4(grp, "prevViewProjectionMatrixInverse", effects->prev_drw_persinv);
     }
     else {
       DRW_shgroup_uniform_float(grp, "alpha", &effects->taa_alpha, 1);
@@ -346,11 +370,6 @@ void EEVEE_temporal_sampling_draw(EEVEE_Data *vedata)
       SWAP_BUFFERS_TAA();
     }
     else {
-      /* Save the depth buffer for the next frame.
-       * This saves us from doing anything special
-       * in the other mode engines. */
-      GPU_framebuffer_blit(fbl->main_fb, 0, fbl->double_buffer_depth_fb, 0, GPU_DEPTH_BIT);
-
       /* Do reprojection for noise reduction */
       /* TODO : do AA jitter if in only render view. */
       if (!DRW_state_is_image_render() && (effects->enabled_effects & EFFECT_TAA_REPROJECT) != 0 &&
@@ -365,6 +384,12 @@ void EEVEE_temporal_sampling_draw(EEVEE_Data *vedata)
                                                fbl->main_color_fb;
         GPU_framebuffer_blit(source_fb, 0, fbl->taa_history_color_fb, 0, GPU_COLOR_BIT);
       }
+
+      /* Save the depth buffer for the next frame.
+       * This saves us from doing anything special
+       * in the other mode engines. It is done after the reprojection that needs the depth of
+       * the previous frame to reject disoccluded history samples. */
+      GPU_framebuffer_blit(fbl->main_fb, 0, fbl->double_buffer_depth_fb, 0, GPU_DEPTH_BIT);
     }
 
     /* Make each loop count when doing a render. */
@@ -212,7 +212,13 @@ void CLOSURE_NAME(vec3 N
 
   vec3 true_normal = normalize(cross(dFdx(viewPosition), dFdy(viewPosition)));
 
+  uvec4 light_mask = light_tile_mask_get(worldPosition);
+
   for (int i = 0; i < MAX_LIGHT && i < laNumLight; i++) {
+    if (!light_tile_mask_test(light_mask, i)) {
+      continue;
+    }
+
     LightData ld = lights_data[i];
 
     vec4 l_vector; /* Non-Normalized Light Vector with length in last component. */
@@ -2,6 +2,7 @@
 layout(std140) uniform common_block
 {
   mat4 pastViewProjectionMatrix;
+  mat4 lightTileViewProjectionMatrix; /* Projection used to build the light tiles. */
   vec2 mipRatio[10]; /* To correct mip level texel misalignment */
   /* Ambient Occlusion */
   vec4 aoParameters[2];
@@ -6,8 +6,6 @@ uniform sampler2D colorBuffer;
 uniform sampler2D depthBuffer;
 uniform sampler2D colorHistoryBuffer;
 
-uniform mat4 prevViewProjectionMatrix;
-
 out vec4 FragColor;
 
 vec4 safe_color(vec4 c)
@@ -18,6 +16,26 @@ vec4 safe_color(vec4 c)
 
 #ifdef USE_REPROJECTION
 
+uniform sampler2D prevDepthBuffer;
+uniform sampler2D velocityBuffer;
+
+uniform mat4 prevViewProjectionMatrixInverse;
+
+/**
+ * Return true if the surface found at \a uv_history in the previous frame is not the one visible
+ * at \a pos. This happens in regions that were hidden by other surfaces or were outside of the
+ * view. Their history is not related to the current pixel and would show as ghosting.
+ */
+bool history_is_disoccluded(vec3 pos, vec2 uv_history, ivec2 texel_history)
+{
+  float prev_depth = texelFetch(prevDepthBuffer, texel_history, 0).r;
+  vec3 prev_ndc = vec3(uv_history, prev_depth) * 2.0 - 1.0;
+  vec3 prev_pos = project_point(prevViewProjectionMatrixInverse, prev_ndc);
+  /* Tolerance relative to the view distance to be independent of the scene scale. */
+  float view_dist = abs(point_world_to_view(pos).z);
+  return distance(prev_pos, pos) > 0.02 * max(view_dist, 1e-4);
+}
+
 /**
  * Adapted from https://casual-effects.com/g3d/G3D10/data-files/shader/Film/Film_temporalAA.pix
  * which is adapted from
@@ -48,10 +66,12 @@ void main()
   vec2 uv = gl_FragCoord.xy / screen_res;
   ivec2 texel = ivec2(gl_FragCoord.xy);
 
-  /* Compute pixel position in previous frame. */
+  /* Compute pixel position in previous frame using the motion vectors. */
   float depth = textureLod(depthBuffer, uv, 0.0).r;
   vec3 pos = get_world_space_from_depth(uv, depth);
-  vec2 uv_history = project_point(prevViewProjectionMatrix, pos).xy * 0.5 + 0.5;
+  /* Decode from unsigned normalized 16bit texture. The motion is stored in NDC space. */
+  vec2 motion = texelFetch(velocityBuffer, texel, 0).xy * 2.0 - 1.0;
+  vec2 uv_history = uv + motion * 0.5;
 
   /* HACK: Reject lookdev spheres from TAA reprojection. */
   if (depth == 0.0) {
@@ -101,7 +121,9 @@ void main()
   color_history = mix(color_history, color, alpha);
 
   bool out_of_view = any(greaterThanEqual(abs(uv_history - 0.5), vec2(0.5)));
-  color_history = (out_of_view) ? color : color_history;
+  bool disoccluded = !out_of_view && (depth != 0.0) &&
+                     history_is_disoccluded(pos, uv_history, texel_history);
+  color_history = (out_of_view || disoccluded) ? color : color_history;
 
   FragColor = safe_color(color_history);
   /* There is some ghost issue if we use the alpha
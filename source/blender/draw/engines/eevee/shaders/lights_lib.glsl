@@ -8,6 +8,10 @@
 #  define MAX_CASCADE_NUM 4
 #endif
 
+#ifndef LIGHT_TILE_GRID
+#  define LIGHT_TILE_GRID 16
+#endif
+
 /* ---------------------------------------------------------------------- */
 /** \name Structure
  * \{ */
@@ -82,6 +86,8 @@ layout(std140) uniform shadow_block
 layout(std140) uniform light_block
 {
   LightData lights_data[MAX_LIGHT];
+  /* Bitmask of the lights affecting each screen tile. */
+  uvec4 lights_tile_mask[LIGHT_TILE_GRID * LIGHT_TILE_GRID];
 };
 
 uniform sampler2DArrayShadow shadowCubeTexture;
@@ -89,6 +95,31 @@ uniform sampler2DArrayShadow shadowCascadeTexture;
 
 /** \} */
 
+/* ---------------------------------------------------------------------- */
+/** \name Light Culling
+ * \{ */
+
+/* Mask of the lights that can affect the world position P. Keep in sync with
+ * light_tile_coord_get. */
+uvec4 light_tile_mask_get(vec3 P)
+{
+  vec4 ndc = lightTileViewProjectionMatrix * vec4(P, 1.0);
+  if (ndc.w <= 1e-6) {
+    /* Behind the view used to build the tiles. */
+    return uvec4(0xFFFFFFFFu);
+  }
+  vec2 tile_co = floor((ndc.xy / ndc.w * 0.5 + 0.5) * float(LIGHT_TILE_GRID));
+  ivec2 tile = ivec2(clamp(tile_co, vec2(0.0), vec2(LIGHT_TILE_GRID - 1)));
+  return lights_tile_mask[tile.y * LIGHT_TILE_GRID + tile.x];
+}
+
+bool light_tile_mask_test(uvec4 mask, int light_index)
+{
+  return (mask[light_index >> 5] & (1u << uint(light_index & 31))) != 0u;
+}
+
+/** \} */
+
 /* ---------------------------------------------------------------------- */
 /** \name Shadow Functions
  * \{ */
@@ -11,8 +11,10 @@ void main()
   vec3 world_pos = point_object_to_world(pos);
   gl_Position = point_world_to_ndc(world_pos);
 
+  /* Weights are stored halved in a normalized short, see #vertex_weight_to_short. */
+  float w = weight * 2.0;
   /* Separate actual weight and alerts for independent interpolation */
-  weight_interp = max(vec2(weight, -weight), 0.0);
+  weight_interp = max(vec2(w, -w), 0.0);
 
 #ifdef USE_WORLD_CLIP_PLANES
   world_clip_planes_calc_clip_distance(world_pos);
@@ -24,6 +24,8 @@
 
 #include "DNA_screen_types.h"
 
+#include "ED_view3d.h"
+
 #include "UI_resources.h"
 
 #include "DRW_engine.h"
@@ -153,6 +155,17 @@ static void select_engine_init(void *vedata)
   }
 }
 
+/** The settings of the 3D view which change the drawn indices, besides the view matrix. */
+static int select_engine_view_flag_get(const DRWContextState *draw_ctx)
+{
+  const View3D *v3d = draw_ctx->v3d;
+  int flag = 0;
+  SET_FLAG_FROM_TEST(flag, XRAY_FLAG_ENABLED(v3d), (1 << 0));
+  SET_FLAG_FROM_TEST(flag, v3d->overlay.edit_flag & V3D_OVERLAY_EDIT_FACE_DOT, (1 << 1));
+  SET_FLAG_FROM_TEST(flag, RV3D_CLIPPING_ENABLED(v3d, draw_ctx->rv3d), (1 << 2));
+  return flag;
+}
+
 static void select_cache_init(void *vedata)
 {
   SELECTID_PassList *psl = ((SELECTID_Data *)vedata)->psl;
@@ -199,15 +212,19 @@ static void select_cache_init(void *vedata)
 
   /* Check if the viewport has changed. */
   float(*persmat)[4] = draw_ctx->rv3d->persmat;
-  e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON);
+  const int view_flag = select_engine_view_flag_get(draw_ctx);
+  e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON) ||
+                            (e_data.context.view_flag != view_flag);
 
   if (!e_data.context.is_dirty) {
-    /* Check if any of the drawn objects have been transformed. */
+    /* Check if any of the drawn objects have been transformed or their geometry changed,
+     * since the buffer is kept as long as the context objects are the same. */
+    const int recalc_flag = ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_COPY_ON_WRITE;
     Object **ob = &e_data.context.objects_drawn[0];
     for (uint i = e_data.context.objects_drawn_len; i--; ob++) {
       DrawData *data = DRW_drawdata_get(&(*ob)->id, &draw_engine_select_type);
-      if (data && (data->recalc & ID_RECALC_TRANSFORM) != 0) {
-        data->recalc &= ~ID_RECALC_TRANSFORM;
+      if (data && (data->recalc & recalc_flag) != 0) {
+        data->recalc &= ~recalc_flag;
         e_data.context.is_dirty = true;
       }
     }
@@ -216,6 +233,7 @@ static void select_cache_init(void *vedata)
   if (e_data.context.is_dirty) {
     /* Remove all tags from drawn or culled objects. */
     copy_m4_m4(e_data.context.persmat, persmat);
+    e_data.context.view_flag = view_flag;
     e_data.context.objects_drawn_len = 0;
     e_data.context.index_drawn_len = 1;
     select_engine_framebuffer_setup();
@@ -27,6 +27,7 @@
 #include "DRW_render.h"
 
 #include "BLI_alloca.h"
+#include "BLI_ghash.h"
 
 #include "BKE_modifier.h"
 #include "BKE_object.h"
@@ -40,6 +41,8 @@
 #include "DNA_modifier_types.h"
 #include "DNA_node_types.h"
 
+#include "DEG_depsgraph_query.h"
+
 #include "workbench_engine.h"
 #include "workbench_private.h"
 
@@ -82,6 +85,9 @@ void workbench_engine_init(void *ved)
 void workbench_cache_init(void *ved)
 {
   WORKBENCH_Data *vedata = ved;
+  WORKBENCH_PrivateData *wpd = vedata->stl->wpd;
+
+  wpd->geometry_hash = BLI_ghash_pair_new(__func__);
 
   workbench_opaque_cache_init(vedata);
   workbench_transparent_cache_init(vedata);
@@ -125,15 +131,42 @@ static void workbench_cache_sculpt_populate(WORKBENCH_PrivateData *wpd,
   }
 }
 
-BLI_INLINE void workbench_object_drawcall(DRWShadingGroup *grp, struct GPUBatch *geom, Object *ob)
+/* Return true if the geometry batch of the object is likely to be drawn by other objects. */
+BLI_INLINE bool workbench_object_geometry_is_shared(Object *ob)
+{
+  if (ob->base_flag & BASE_FROM_DUPLI) {
+    return true;
+  }
+  const Object *ob_orig = DEG_get_original_object(ob);
+  return (ob_orig->data != NULL) && (ID_REAL_USERS(ob_orig->data) > 1);
+}
+
+BLI_INLINE void workbench_object_drawcall(WORKBENCH_PrivateData *wpd,
+                                          DRWShadingGroup *grp,
+                                          struct GPUBatch *geom,
+                                          Object *ob)
 {
   if (ob->type == OB_POINTCLOUD) {
     /* Draw range to avoid drawcall batching messing up the instance attrib. */
     DRW_shgroup_call_instance_range(grp, ob, geom, 0, 0);
+    return;
   }
-  else {
-    DRW_shgroup_call(grp, geom, ob);
+
+  /* The draw manager merges consecutive calls of the same batch into a single multi-draw.
+   * Give shared geometry its own sub-group so that all of its instances are merged whatever
+   * the order they are populated in. */
+  if (workbench_object_geometry_is_shared(ob)) {
+    GHashPair *key = BLI_ghashutil_pairalloc(grp, geom);
+    DRWShadingGroup **grp_geom;
+    if (BLI_ghash_ensure_p(wpd->geometry_hash, key, (void ***)&grp_geom)) {
+      BLI_ghashutil_pairfree(key);
+    }
+    else {
+      *grp_geom = DRW_shgroup_create_sub(grp);
+    }
+    grp = *grp_geom;
   }
+  DRW_shgroup_call(grp, geom, ob);
 }
 
 static void workbench_cache_texpaint_populate(WORKBENCH_PrivateData *wpd, Object *ob)
@@ -151,7 +184,7 @@ static void workbench_cache_texpaint_populate(WORKBENCH_PrivateData *wpd, Object
       SET_FLAG_FROM_TEST(state, imapaint->interp == IMAGEPAINT_INTERP_LINEAR, GPU_SAMPLER_FILTER);
 
       DRWShadingGroup *grp = workbench_image_setup(wpd, ob, 0, ima, NULL, state);
-      workbench_object_drawcall(grp, geom, ob);
+      workbench_object_drawcall(wpd, grp, geom, ob);
     }
   }
   else {
@@ -163,7 +196,7 @@ static void workbench_cache_texpaint_populate(WORKBENCH_PrivateData *wpd, Object
           continue;
         }
         DRWShadingGroup *grp = workbench_image_setup(wpd, ob, i + 1, NULL, NULL, 0);
-        workbench_object_drawcall(grp, geoms[i], ob);
+        workbench_object_drawcall(wpd, grp, geoms[i], ob);
       }
     }
   }
@@ -200,7 +233,7 @@ static void workbench_cache_common_populate(WORKBENCH_PrivateData *wpd,
 
     if (geom) {
       DRWShadingGroup *grp = workbench_material_setup(wpd, ob, 0, color_type, r_transp);
-      workbench_object_drawcall(grp, geom, ob);
+      workbench_object_drawcall(wpd, grp, geom, ob);
     }
   }
   else {
@@ -213,7 +246,7 @@ static void workbench_cache_common_populate(WORKBENCH_PrivateData *wpd,
           continue;
         }
         DRWShadingGroup *grp = workbench_material_setup(wpd, ob, i + 1, color_type, r_transp);
-        workbench_object_drawcall(grp, geoms[i], ob);
+        workbench_object_drawcall(wpd, grp, geoms[i], ob);
       }
     }
   }
@@ -460,6 +493,9 @@ void workbench_cache_finish(void *ved)
 
   workbench_update_material_ubos(wpd);
 
+  BLI_ghash_free(wpd->geometry_hash, BLI_ghashutil_pairfree, NULL);
+  wpd->geometry_hash = NULL;
+
   /* TODO don't free reuse next redraw. */
   for (int i = 0; i < 2; i++) {
     for (int j = 0; j < 2; j++) {
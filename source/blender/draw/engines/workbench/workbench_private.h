@@ -327,6 +327,11 @@ typedef struct WORKBENCH_PrivateData {
   struct GPUUniformBuf *material_ubo_curr;
   /** Copy of txl->dummy_image_tx for faster access. */
   struct GPUTexture *dummy_image_tx;
+  /**
+   * Hash storing a sub shading group for each (shading group, batch) pair of shared geometry.
+   * Keeps the draw-calls of instances consecutive so they are merged into a single multi-draw.
+   */
+  struct GHash *geometry_hash;
   /** Total number of used material chunk. */
   int material_chunk_count;
   /** Index of current material chunk. */
@@ -2461,6 +2461,15 @@ static const MeshExtract extract_lnor = {
 /** \name Extract UV  layers
  * \{ */
 
+typedef struct MeshExtract_UV_Data {
+  float (*vbo_data)[2];
+  int layers_len;
+  /** Custom-data offsets of the layers when extracting from a #BMesh. */
+  int cd_ofs[MAX_MTFACE];
+  /** Layer arrays when extracting from a #Mesh. */
+  const MLoopUV *layers[MAX_MTFACE];
+} MeshExtract_UV_Data;
+
 static void *extract_uv_init(const MeshRenderData *mr, struct MeshBatchCache *cache, void *buf)
 {
   GPUVertFormat format = {0};
@@ -2516,39 +2525,69 @@ static void *extract_uv_init(const MeshRenderData *mr, struct MeshBatchCache *ca
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, v_len);
 
-  float(*uv_data)[2] = (float(*)[2])GPU_vertbuf_get_data(vbo);
+  MeshExtract_UV_Data *data = MEM_mallocN(sizeof(*data), __func__);
+  data->vbo_data = (float(*)[2])GPU_vertbuf_get_data(vbo);
+  data->layers_len = 0;
   for (int i = 0; i < MAX_MTFACE; i++) {
     if (uv_layers & (1 << i)) {
       if (mr->extract_type == MR_EXTRACT_BMESH) {
-        int cd_ofs = CustomData_get_n_offset(cd_ldata, CD_MLOOPUV, i);
-        BMIter f_iter;
-        BMFace *efa;
-        BM_ITER_MESH (efa, &f_iter, mr->bm, BM_FACES_OF_MESH) {
-          BMLoop *l_iter, *l_first;
-          l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
-          do {
-            MLoopUV *luv = BM_ELEM_CD_GET_VOID_P(l_iter, cd_ofs);
-            memcpy(uv_data, luv->uv, sizeof(*uv_data));
-            uv_data++;
-          } while ((l_iter = l_iter->next) != l_first);
-        }
+        data->cd_ofs[data->layers_len] = CustomData_get_n_offset(cd_ldata, CD_MLOOPUV, i);
       }
       else {
-        MLoopUV *layer_data = CustomData_get_layer_n(cd_ldata, CD_MLOOPUV, i);
-        for (int ml_index = 0; ml_index < mr->loop_len; ml_index++, uv_data++, layer_data++) {
-          memcpy(uv_data, layer_data->uv, sizeof(*uv_data));
-        }
+        data->layers[data->layers_len] = CustomData_get_layer_n(cd_ldata, CD_MLOOPUV, i);
       }
+      data->layers_len++;
     }
   }
 
-  return NULL;
+  return data;
+}
+
+/* Layers are stored one after the other, so each loop range can be filled independently. */
+static void extract_uv_iter_poly_bm(const MeshRenderData *mr,
+                                    const ExtractPolyBMesh_Params *params,
+                                    void *_data)
+{
+  MeshExtract_UV_Data *data = _data;
+  EXTRACT_POLY_AND_LOOP_FOREACH_BM_BEGIN(l, l_index, params, mr)
+  {
+    for (int i = 0; i < data->layers_len; i++) {
+      const MLoopUV *luv = BM_ELEM_CD_GET_VOID_P(l, data->cd_ofs[i]);
+      copy_v2_v2(data->vbo_data[i * mr->loop_len + l_index], luv->uv);
+    }
+  }
+  EXTRACT_POLY_AND_LOOP_FOREACH_BM_END(l);
+}
+
+static void extract_uv_iter_poly_mesh(const MeshRenderData *mr,
+                                      const ExtractPolyMesh_Params *params,
+                                      void *_data)
+{
+  MeshExtract_UV_Data *data = _data;
+  EXTRACT_POLY_AND_LOOP_FOREACH_MESH_BEGIN(mp, mp_index, ml, ml_index, params, mr)
+  {
+    for (int i = 0; i < data->layers_len; i++) {
+      copy_v2_v2(data->vbo_data[i * mr->loop_len + ml_index], data->layers[i][ml_index].uv);
+    }
+  }
+  EXTRACT_POLY_AND_LOOP_FOREACH_MESH_END;
+}
+
+static void extract_uv_finish(const MeshRenderData *UNUSED(mr),
+                              struct MeshBatchCache *UNUSED(cache),
+                              void *UNUSED(buf),
+                              void *data)
+{
+  MEM_freeN(data);
 }
 
 static const MeshExtract extract_uv = {
     .init = extract_uv_init,
+    .iter_poly_bm = extract_uv_iter_poly_bm,
+    .iter_poly_mesh = extract_uv_iter_poly_mesh,
+    .finish = extract_uv_finish,
     .data_flag = 0,
-    .use_threading = false,
+    .use_threading = true,
 };
 
 /** \} */
@@ -3298,7 +3337,7 @@ static const MeshExtract extract_edge_fac = {
  * \{ */
 
 typedef struct MeshExtract_Weight_Data {
-  float *vbo_data;
+  short *vbo_data;
   const DRW_MeshWeightState *wstate;
   const MDeformVert *dvert; /* For #Mesh. */
   int cd_ofs;               /* For #BMesh. */
@@ -3357,20 +3396,29 @@ static float evaluate_vertex_weight(const MDeformVert *dvert, const DRW_MeshWeig
   return input;
 }
 
+/**
+ * Weights are stored as normalized shorts. The values are halved so the error state (-2) fits,
+ * the weight paint shader scales them back.
+ */
+BLI_INLINE short vertex_weight_to_short(float weight)
+{
+  return (short)(weight * (0.5f * 32767.0f));
+}
+
 static void *extract_weights_init(const MeshRenderData *mr,
                                   struct MeshBatchCache *cache,
                                   void *buf)
 {
   static GPUVertFormat format = {0};
   if (format.attr_len == 0) {
-    GPU_vertformat_attr_add(&format, "weight", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&format, "weight", GPU_COMP_I16, 1, GPU_FETCH_INT_TO_FLOAT_UNIT);
   }
   GPUVertBuf *vbo = buf;
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, mr->loop_len + mr->loop_loose_len);
 
   MeshExtract_Weight_Data *data = MEM_callocN(sizeof(*data), __func__);
-  data->vbo_data = (float *)GPU_vertbuf_get_data(vbo);
+  data->vbo_data = (short *)GPU_vertbuf_get_data(vbo);
   data->wstate = &cache->weight_state;
 
   if (data->wstate->defgroup_active == -1) {
@@ -3398,14 +3446,16 @@ static void extract_weights_iter_poly_bm(const MeshRenderData *mr,
     EXTRACT_POLY_AND_LOOP_FOREACH_BM_BEGIN(l, l_index, params, mr)
     {
       const MDeformVert *dvert = BM_ELEM_CD_GET_VOID_P(l->v, data->cd_ofs);
-      data->vbo_data[l_index] = evaluate_vertex_weight(dvert, data->wstate);
+      const float weight = evaluate_vertex_weight(dvert, data->wstate);
+      data->vbo_data[l_index] = vertex_weight_to_short(weight);
     }
     EXTRACT_POLY_AND_LOOP_FOREACH_BM_END(l);
   }
   else {
     EXTRACT_POLY_AND_LOOP_FOREACH_BM_BEGIN(l, l_index, params, mr)
     {
-      data->vbo_data[l_index] = evaluate_vertex_weight(NULL, data->wstate);
+      const float weight = evaluate_vertex_weight(NULL, data->wstate);
+      data->vbo_data[l_index] = vertex_weight_to_short(weight);
     }
     EXTRACT_POLY_AND_LOOP_FOREACH_BM_END(l);
   }
@@ -3420,7 +3470,8 @@ static void extract_weights_iter_poly_mesh(const MeshRenderData *mr,
     EXTRACT_POLY_AND_LOOP_FOREACH_MESH_BEGIN(mp, mp_index, ml, ml_index, params, mr)
     {
       const MDeformVert *dvert = &data->dvert[ml->v];
-      data->vbo_data[ml_index] = evaluate_vertex_weight(dvert, data->wstate);
+      const float weight = evaluate_vertex_weight(dvert, data->wstate);
+      data->vbo_data[ml_index] = vertex_weight_to_short(weight);
     }
     EXTRACT_POLY_AND_LOOP_FOREACH_MESH_END;
   }
@@ -3428,7 +3479,8 @@ static void extract_weights_iter_poly_mesh(const MeshRenderData *mr,
     const MDeformVert *dvert = NULL;
     EXTRACT_POLY_AND_LOOP_FOREACH_MESH_BEGIN(mp, mp_index, ml, ml_index, params, mr)
     {
-      data->vbo_data[ml_index] = evaluate_vertex_weight(dvert, data->wstate);
+      const float weight = evaluate_vertex_weight(dvert, data->wstate);
+      data->vbo_data[ml_index] = vertex_weight_to_short(weight);
     }
     EXTRACT_POLY_AND_LOOP_FOREACH_MESH_END;
   }
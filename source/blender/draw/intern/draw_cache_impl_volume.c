@@ -284,6 +284,46 @@ GPUBatch *DRW_volume_batch_cache_get_selection_surface(Volume *volume)
   return cache->selection_surface;
 }
 
+typedef struct VolumeGridUpload {
+  const DenseFloatVolumeGrid *dense_grid;
+  const float *background;
+  eGPUTextureFormat format;
+  GPUTexture *texture;
+  bool is_failed;
+} VolumeGridUpload;
+
+static GPUTexture *drw_volume_grid_texture_ensure(VolumeGridUpload *upload)
+{
+  if (upload->texture == NULL && !upload->is_failed) {
+    upload->texture = GPU_texture_create_3d("volume_grid",
+                                            UNPACK3(upload->dense_grid->resolution),
+                                            1,
+                                            upload->format,
+                                            GPU_DATA_FLOAT,
+                                            NULL);
+    /* The texture can be null if the resolution along one axis is larger than
+     * GL_MAX_3D_TEXTURE_SIZE. */
+    if (upload->texture == NULL) {
+      upload->is_failed = true;
+      return NULL;
+    }
+    /* Voxels outside of the leaf nodes and tiles are never uploaded. */
+    GPU_texture_clear(upload->texture, GPU_DATA_FLOAT, upload->background);
+  }
+  return upload->texture;
+}
+
+static void drw_volume_grid_block_cb(void *userdata,
+                                     const float *voxels,
+                                     const int offset[3],
+                                     const int size[3])
+{
+  GPUTexture *texture = drw_volume_grid_texture_ensure(userdata);
+  if (texture != NULL) {
+    GPU_texture_update_sub(texture, GPU_DATA_FLOAT, voxels, UNPACK3(offset), UNPACK3(size));
+  }
+}
+
 static DRWVolumeGrid *volume_grid_cache_get(Volume *volume,
                                             VolumeGrid *grid,
                                             VolumeBatchCache *cache)
@@ -317,28 +357,27 @@ static DRWVolumeGrid *volume_grid_cache_get(Volume *volume,
    * created. */
   const bool was_loaded = BKE_volume_grid_is_loaded(grid);
 
+  /* Only upload the leaf nodes and tiles of the grid into the texture, instead of building a dense
+   * copy of the whole bounding box in memory first, which is mostly empty for sparse grids. */
   DenseFloatVolumeGrid dense_grid;
-  if (BKE_volume_grid_dense_floats(volume, grid, &dense_grid)) {
+  float background[3];
+  VolumeGridUpload upload = {
+      .dense_grid = &dense_grid,
+      .background = background,
+      .format = (channels == 3) ? GPU_RGB16F : GPU_R16F,
+  };
+  if (BKE_volume_grid_dense_float_blocks(
+          volume, grid, &dense_grid, background, drw_volume_grid_block_cb, &upload)) {
     copy_m4_m4(cache_grid->texture_to_object, dense_grid.texture_to_object);
     invert_m4_m4(cache_grid->object_to_texture, dense_grid.texture_to_object);
 
-    /* Create GPU texture. */
-    eGPUTextureFormat format = (channels == 3) ? GPU_RGB16F : GPU_R16F;
-    cache_grid->texture = GPU_texture_create_3d("volume_grid",
-                                                UNPACK3(dense_grid.resolution),
-                                                1,
-                                                format,
-                                                GPU_DATA_FLOAT,
-                                                dense_grid.voxels);
-    /* The texture can be null if the resolution along one axis is larger than
-     * GL_MAX_3D_TEXTURE_SIZE. */
+    /* In case all voxels have the background value. */
+    cache_grid->texture = drw_volume_grid_texture_ensure(&upload);
     if (cache_grid->texture != NULL) {
       GPU_texture_swizzle_set(cache_grid->texture, (channels == 3) ? "rgb1" : "rrr1");
       GPU_texture_wrap_mode(cache_grid->texture, false, false);
-      BKE_volume_dense_float_grid_clear(&dense_grid);
     }
     else {
-      MEM_freeN(dense_grid.voxels);
       printf("Error: Could not allocate 3D texture for volume.\n");
     }
   }
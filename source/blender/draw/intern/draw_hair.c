@@ -35,7 +35,11 @@
 #include "BKE_duplilist.h"
 
 #include "GPU_batch.h"
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
 #include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
 #include "GPU_vertex_buffer.h"
 
 #include "draw_hair_private.h"
@@ -63,6 +67,24 @@ static int g_tf_target_width;
 static int g_tf_target_height;
 #endif
 
+/**
+ * Refine update done by a compute shader, writing the points directly to the final buffer.
+ * Used instead of the transform feedback (or its workaround) when compute is supported.
+ */
+typedef struct ParticleRefineCompute {
+  struct ParticleRefineCompute *next;
+  ParticleHairCache *cache;
+  int subdiv;
+} ParticleRefineCompute;
+
+static ParticleRefineCompute *g_compute_calls = NULL;
+static GPUShader *g_refine_compute_shaders[PART_REFINE_MAX_SHADER] = {NULL};
+
+/* Number of invocations per work group, matches `local_size_x` of the compute shader. */
+#define HAIR_REFINE_GROUP_SIZE 64
+/* Minimum maximum work group count guaranteed by OpenGL. */
+#define HAIR_REFINE_GROUP_MAX 65535
+
 static GPUVertBuf *g_dummy_vbo = NULL;
 static GPUTexture *g_dummy_texture = NULL;
 static GPUShader *g_refine_shaders[PART_REFINE_MAX_SHADER] = {NULL};
@@ -70,6 +92,7 @@ static DRWPass *g_tf_pass; /* XXX can be a problem with multiple DRWManager in t
 
 extern char datatoc_common_hair_lib_glsl[];
 extern char datatoc_common_hair_refine_vert_glsl[];
+extern char datatoc_common_hair_refine_comp_glsl[];
 extern char datatoc_gpu_shader_3D_smooth_color_frag_glsl[];
 
 static GPUShader *hair_refine_shader_get(ParticleRefineShader sh)
@@ -99,6 +122,22 @@ static GPUShader *hair_refine_shader_get(ParticleRefineShader sh)
   return g_refine_shaders[sh];
 }
 
+static GPUShader *hair_refine_compute_shader_get(ParticleRefineShader sh)
+{
+  if (g_refine_compute_shaders[sh] == NULL) {
+    g_refine_compute_shaders[sh] = GPU_shader_create_compute(datatoc_common_hair_refine_comp_glsl,
+                                                             datatoc_common_hair_lib_glsl,
+                                                             "#define HAIR_PHASE_SUBDIV\n",
+                                                             __func__);
+  }
+  return g_refine_compute_shaders[sh];
+}
+
+static bool hair_refine_use_compute(void)
+{
+  return GPU_compute_shader_support() && GPU_shader_storage_buffer_objects_support();
+}
+
 void DRW_hair_init(void)
 {
 #ifdef USE_TRANSFORM_FEEDBACK
@@ -140,7 +179,14 @@ static ParticleHairCache *drw_hair_particle_cache_get(
 
   if (update) {
     int final_points_len = cache->final[subdiv].strands_res * cache->strands_len;
-    if (final_points_len > 0) {
+    if (final_points_len > 0 && hair_refine_use_compute()) {
+      ParticleRefineCompute *pr_call = MEM_mallocN(sizeof(*pr_call), __func__);
+      pr_call->next = g_compute_calls;
+      pr_call->cache = cache;
+      pr_call->subdiv = subdiv;
+      g_compute_calls = pr_call;
+    }
+    else if (final_points_len > 0) {
       GPUShader *tf_shader = hair_refine_shader_get(PART_REFINE_CATMULL_ROM);
 
 #ifdef USE_TRANSFORM_FEEDBACK
@@ -291,8 +337,60 @@ DRWShadingGroup *DRW_shgroup_hair_create_sub(Object *object,
   return shgrp;
 }
 
+static void drw_hair_update_compute(void)
+{
+  if (g_compute_calls == NULL) {
+    return;
+  }
+
+  GPUShader *shader = hair_refine_compute_shader_get(PART_REFINE_CATMULL_ROM);
+  GPU_shader_bind(shader);
+
+  const int point_tex_binding = GPU_shader_get_texture_binding(shader, "hairPointBuffer");
+  const int strand_tex_binding = GPU_shader_get_texture_binding(shader, "hairStrandBuffer");
+  const int strand_seg_tex_binding = GPU_shader_get_texture_binding(shader,
+                                                                    "hairStrandSegBuffer");
+  const int strands_res_loc = GPU_shader_get_uniform(shader, "hairStrandsRes");
+  const int refine_len_loc = GPU_shader_get_uniform(shader, "hairRefineLen");
+  const int refine_offset_loc = GPU_shader_get_uniform(shader, "hairRefineOffset");
+
+  while (g_compute_calls != NULL) {
+    ParticleRefineCompute *pr_call = g_compute_calls;
+    g_compute_calls = g_compute_calls->next;
+
+    ParticleHairCache *cache = pr_call->cache;
+    const int strands_res = cache->final[pr_call->subdiv].strands_res;
+    const int final_points_len = strands_res * cache->strands_len;
+
+    GPU_texture_bind(cache->point_tex, point_tex_binding);
+    GPU_texture_bind(cache->strand_tex, strand_tex_binding);
+    GPU_texture_bind(cache->strand_seg_tex, strand_seg_tex_binding);
+    GPU_vertbuf_bind_as_ssbo(cache->final[pr_call->subdiv].proc_buf, 0);
+
+    GPU_shader_uniform_int(shader, strands_res_loc, strands_res);
+    GPU_shader_uniform_int(shader, refine_len_loc, final_points_len);
+
+    /* Split in multiple dispatches to stay under the work group count limit. */
+    const int points_per_dispatch = HAIR_REFINE_GROUP_SIZE * HAIR_REFINE_GROUP_MAX;
+    for (int offset = 0; offset < final_points_len; offset += points_per_dispatch) {
+      const int points_len = min_ii(points_per_dispatch, final_points_len - offset);
+      const uint groups_len = (points_len + HAIR_REFINE_GROUP_SIZE - 1) / HAIR_REFINE_GROUP_SIZE;
+      GPU_shader_uniform_int(shader, refine_offset_loc, offset);
+      GPU_compute_dispatch(shader, groups_len, 1, 1);
+    }
+
+    MEM_freeN(pr_call);
+  }
+
+  /* The points are read as vertex attributes, or through the texture buffer of #proc_tex. */
+  GPU_memory_barrier(GPU_BARRIER_TEXTURE_FETCH | GPU_BARRIER_VERTEX_ATTRIB_ARRAY);
+  GPU_shader_unbind();
+}
+
 void DRW_hair_update(void)
 {
+  drw_hair_update_compute();
+
 #ifndef USE_TRANSFORM_FEEDBACK
   /**
    * Workaround to transform feedback not working on mac.
@@ -361,8 +459,7 @@ void DRW_hair_update(void)
   MEM_freeN(data);
   GPU_framebuffer_free(fb);
 #else
-  /* TODO(fclem): replace by compute shader. */
-  /* Just render using transform feedback. */
+  /* Just render using transform feedback, when compute shaders are not supported. */
   DRW_draw_pass(g_tf_pass);
 #endif
 }
@@ -371,6 +468,7 @@ void DRW_hair_free(void)
 {
   for (int i = 0; i < PART_REFINE_MAX_SHADER; i++) {
     DRW_SHADER_FREE_SAFE(g_refine_shaders[i]);
+    DRW_SHADER_FREE_SAFE(g_refine_compute_shaders[i]);
   }
 
   GPU_VERTBUF_DISCARD_SAFE(g_dummy_vbo);
@@ -29,6 +29,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BLF_api.h"
 
@@ -1585,6 +1586,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   /* Cache filling */
   {
     PROFILE_START(stime);
+    BLI_TRACE_ZONE_BEGIN("Draw cache populate");
     drw_engines_cache_init();
     drw_engines_world_update(scene);
 
@@ -1611,6 +1613,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
     drw_task_graph_deinit();
     DRW_render_instance_buffer_finish();
+    BLI_TRACE_ZONE_END();
 
 #ifdef USE_PROFILE
     double *cache_time = GPU_viewport_cache_time_get(DST.viewport);
@@ -1632,7 +1635,10 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
   DRW_draw_callbacks_pre_scene();
 
+  BLI_TRACE_ZONE_BEGIN("Draw scene");
   drw_engines_draw_scene();
+  BLI_TRACE_ZONE_END();
+  BLI_TRACE_COUNTER("Memory in use", (int64_t)MEM_get_memory_in_use());
 
   /* Fix 3D view being "laggy" on macos and win+nvidia. (See T56996, T61474) */
   GPU_flush();
@@ -2640,6 +2646,8 @@ void DRW_draw_select_id(Depsgraph *depsgraph, ARegion *region, View3D *v3d, cons
     sel_ctx->is_dirty = true;
     sel_ctx->objects_drawn_len = 0;
     sel_ctx->index_drawn_len = 1;
+    /* Don't draw into the previous buffer once a viewport is available again. */
+    memset(sel_ctx->persmat, 0, sizeof(sel_ctx->persmat));
     return;
   }
 
@@ -26,6 +26,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -485,47 +486,73 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float[6][4]));
 }
 
+static void draw_compute_culling_state(const DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+
+#ifdef DRW_DEBUG_CULLING
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
+      }
+      else {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
+#endif
+
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
+    }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+/* Each task culls one chunk of resources, see #DRW_RESOURCE_CHUNK_LEN. */
+static void draw_compute_culling_chunk_cb(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DRWView *view = userdata;
+  const int elem_len = min_ii((int)DST.resource_handle - chunk * DRW_RESOURCE_CHUNK_LEN,
+                              DRW_RESOURCE_CHUNK_LEN);
+  for (int elem = 0; elem < elem_len; elem++) {
+    DRWCullingState *cull = BLI_memblock_elem_get(DST.vmempool->cullstates, chunk, elem);
+    draw_compute_culling_state(view, cull);
+  }
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
 
-  /* TODO(fclem): multi-thread this. */
   /* TODO(fclem): compute all dirty views at once. */
   if (!view->is_dirty) {
     return;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
-    }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
-
+  /* The visibility callbacks write to engine data that can be shared between resources,
+   * and the debug display isn't thread safe. */
+  bool use_threading = (view->visibility_fn == NULL);
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
-      }
+  use_threading = use_threading && (G.debug_value == 0);
 #endif
 
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
+  const int resource_len = (int)DST.resource_handle;
+  const int chunk_len = (resource_len + DRW_RESOURCE_CHUNK_LEN - 1) / DRW_RESOURCE_CHUNK_LEN;
 
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
-    }
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = use_threading && (chunk_len > 1);
+  BLI_task_parallel_range(0, chunk_len, view, draw_compute_culling_chunk_cb, &settings);
 
   view->is_dirty = false;
 }
@@ -20,6 +20,9 @@
  * \ingroup draw
  */
 
+#include <stdio.h>
+
+#include "BLI_fileops.h"
 #include "BLI_listbase.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
@@ -33,10 +36,13 @@
 #include "draw_manager.h"
 
 #include "GPU_debug.h"
+#include "GPU_query.h"
 #include "GPU_texture.h"
 
 #include "UI_resources.h"
 
+#include "DRW_engine.h"
+
 #include "draw_manager_profiling.h"
 
 #define MAX_TIMER_NAME 32
@@ -45,7 +51,8 @@
 #define GPU_TIMER_FALLOFF 0.1
 
 typedef struct DRWTimer {
-  uint32_t query[2];
+  /* Index + 1 of the query inside the pool of the current and previous frame, 0 if none. */
+  int query[2];
   uint64_t time_average;
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
@@ -54,6 +61,10 @@ typedef struct DRWTimer {
 
 static struct DRWTimerPool {
   DRWTimer *timers;
+  /* Queries of the current frame and of the previous one, which are read at the end of the
+   * current frame to avoid waiting for the GPU. */
+  GPUQueryPool *query_pools[2];
+  int query_len[2];
   int chunk_count;     /* Number of chunk allocated. */
   int timer_count;     /* chunk_count * CHUNK_SIZE */
   int timer_increment; /* Keep track of where we are in the stack. */
@@ -65,13 +76,16 @@ static struct DRWTimerPool {
 void DRW_stats_free(void)
 {
   if (DTP.timers != NULL) {
-    // for (int i = 0; i < DTP.timer_count; i++) {
-    // DRWTimer *timer = &DTP.timers[i];
-    // glDeleteQueries(2, timer->query);
-    // }
     MEM_freeN(DTP.timers);
     DTP.timers = NULL;
   }
+  for (int i = 0; i < 2; i++) {
+    if (DTP.query_pools[i] != NULL) {
+      GPU_query_pool_free(DTP.query_pools[i]);
+      DTP.query_pools[i] = NULL;
+    }
+    DTP.query_len[i] = 0;
+  }
 }
 
 void DRW_stats_begin(void)
@@ -84,6 +98,8 @@ void DRW_stats_begin(void)
     DTP.chunk_count = 1;
     DTP.timer_count = DTP.chunk_count * CHUNK_SIZE;
     DTP.timers = MEM_callocN(sizeof(DRWTimer) * DTP.timer_count, "DRWTimer stack");
+    DTP.query_pools[0] = GPU_query_pool_timer_create();
+    DTP.query_pools[1] = GPU_query_pool_timer_create();
   }
   else if (!DTP.is_recording && DTP.timers != NULL) {
     DRW_stats_free();
@@ -113,17 +129,14 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
     BLI_strncpy(timer->name, name, MAX_TIMER_NAME);
     timer->lvl = DTP.timer_increment - DTP.end_increment - 1;
     timer->is_query = is_query;
+    timer->query[0] = 0;
 
     /* Queries cannot be nested or interleaved. */
     BLI_assert(!DTP.is_querying);
     if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        // glGenQueries(1, timer->query);
-      }
-
-      // glFinish();
-      /* Issue query for the next frame */
-      // glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
+      /* The result is read at the end of the next frame. */
+      GPU_query_begin(DTP.query_pools[0]);
+      timer->query[0] = ++DTP.query_len[0];
       DTP.is_querying = true;
     }
   }
@@ -161,7 +174,7 @@ void DRW_stats_query_end(void)
   if (DTP.is_recording) {
     DTP.end_increment++;
     BLI_assert(DTP.is_querying);
-    // glEndQuery(GL_TIME_ELAPSED);
+    GPU_query_end(DTP.query_pools[0]);
     DTP.is_querying = false;
   }
 }
@@ -176,17 +189,24 @@ void DRW_stats_reset(void)
   if (DTP.is_recording) {
     uint64_t lvl_time[MAX_NESTED_TIMER] = {0};
 
+    /* Results of the previous frame, it is very likely that the GPU is done with them. */
+    uint64_t *query_times = NULL;
+    if (DTP.query_len[1] > 0) {
+      query_times = MEM_mallocN(sizeof(*query_times) * DTP.query_len[1], __func__);
+      GPU_query_pool_time_result_get(DTP.query_pools[1], query_times, DTP.query_len[1]);
+    }
+
     /* Swap queries for the next frame and sum up each lvl time. */
     for (int i = DTP.timer_increment - 1; i >= 0; i--) {
       DRWTimer *timer = &DTP.timers[i];
-      SWAP(uint32_t, timer->query[0], timer->query[1]);
+      SWAP(int, timer->query[0], timer->query[1]);
 
       BLI_assert(timer->lvl < MAX_NESTED_TIMER);
 
       if (timer->is_query) {
         uint64_t time = 0;
-        if (timer->query[0] != 0) {
-          // glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
+        if (timer->query[0] != 0 && timer->query[0] <= DTP.query_len[1]) {
+          time = query_times[timer->query[0] - 1];
         }
         else {
           time = 1000000000; /* 1ms default */
@@ -204,6 +224,13 @@ void DRW_stats_reset(void)
       lvl_time[timer->lvl] += timer->time_average;
     }
 
+    MEM_SAFE_FREE(query_times);
+
+    SWAP(GPUQueryPool *, DTP.query_pools[0], DTP.query_pools[1]);
+    DTP.query_len[1] = DTP.query_len[0];
+    DTP.query_len[0] = 0;
+    GPU_query_pool_reset(DTP.query_pools[0]);
+
     DTP.is_recording = false;
   }
 }
@@ -369,3 +396,65 @@ void DRW_stats_draw(const rcti *rect)
   BLF_batch_draw_end();
   BLF_disable(fontid, BLF_SHADOW);
 }
+
+static void trace_write_json_string(FILE *fp, const char *str)
+{
+  fputc('"', fp);
+  for (const char *c = str; *c != '\0'; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fputc('\\', fp);
+      fputc(*c, fp);
+    }
+    else if ((unsigned char)*c < 0x20) {
+      fprintf(fp, "\\u%04x", (unsigned int)*c);
+    }
+    else {
+      fputc(*c, fp);
+    }
+  }
+  fputc('"', fp);
+}
+
+/**
+ * Write the averaged GPU timings of the last frame as Chrome trace events, like the dependency
+ * graph traces. Only durations are measured, so the passes of a group are laid out one after
+ * the other, starting at the start of their group.
+ */
+bool DRW_stats_trace_chrome_write(const char *filepath)
+{
+  if (DTP.timers == NULL) {
+    return false;
+  }
+  FILE *fp = BLI_fopen(filepath, "w");
+  if (fp == NULL) {
+    return false;
+  }
+
+  /* Start time of the next timer at each level, in nanoseconds. */
+  uint64_t lvl_start[MAX_NESTED_TIMER + 1] = {0};
+
+  fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  for (int i = 0; i < DTP.timer_increment; i++) {
+    DRWTimer *timer = &DTP.timers[i];
+    BLI_assert(timer->lvl < MAX_NESTED_TIMER);
+
+    const uint64_t start = lvl_start[timer->lvl];
+    lvl_start[timer->lvl] += timer->time_average;
+    lvl_start[timer->lvl + 1] = start;
+
+    /* Timestamps are in microseconds. */
+    fprintf(fp, "{\"name\":");
+    trace_write_json_string(fp, timer->name);
+    fprintf(fp,
+            ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":0},\n",
+            timer->is_query ? "pass" : "group",
+            (double)start / 1000.0,
+            (double)timer->time_average / 1000.0);
+  }
+  /* Metadata, which also takes care of the trailing comma of the last event. */
+  fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"GPU\"}}");
+  fprintf(fp, "\n]}\n");
+
+  fclose(fp);
+  return true;
+}
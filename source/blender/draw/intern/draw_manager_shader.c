@@ -67,19 +67,35 @@ typedef struct DRWDeferredShader {
   GPUMaterial *mat;
 } DRWDeferredShader;
 
-typedef struct DRWShaderCompiler {
-  ListBase queue;          /* DRWDeferredShader */
-  ListBase queue_conclude; /* DRWDeferredShader */
-  SpinLock list_lock;
+/* Maximum number of contexts compiling deferred shaders at the same time. */
+#define DRW_DEFERRED_SHADER_WORKERS_MAX 4
+
+typedef struct DRWShaderCompilerWorker {
+  struct DRWShaderCompiler *comp;
 
   DRWDeferredShader *mat_compiling;
   ThreadMutex compilation_lock;
 
   void *gl_context;
   GPUContext *gpu_context;
+} DRWShaderCompilerWorker;
+
+typedef struct DRWShaderCompiler {
+  ListBase queue;          /* DRWDeferredShader */
+  ListBase queue_conclude; /* DRWDeferredShader */
+  SpinLock list_lock;
+
+  /* Each worker compiles in its own context, on its own thread. */
+  DRWShaderCompilerWorker workers[DRW_DEFERRED_SHADER_WORKERS_MAX];
+  int workers_len;
   bool own_context;
 
   int shaders_done; /* To compute progress. */
+
+  /* Job state shared by the workers. */
+  short *stop;
+  short *do_update;
+  float *progress;
 } DRWShaderCompiler;
 
 static void drw_deferred_shader_free(DRWDeferredShader *dsh)
@@ -96,34 +112,24 @@ static void drw_deferred_shader_queue_free(ListBase *queue)
   }
 }
 
-static void drw_deferred_shader_compilation_exec(
-    void *custom_data,
-    /* Cannot be const, this function implements wm_jobs_start_callback.
-     * NOLINTNEXTLINE: readability-non-const-parameter. */
-    short *stop,
-    short *do_update,
-    float *progress)
+static int drw_deferred_shader_workers_len(void)
 {
-  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
-  void *gl_context = comp->gl_context;
-  GPUContext *gpu_context = comp->gpu_context;
-
-  BLI_assert(gl_context != NULL);
-  BLI_assert(gpu_context != NULL);
+  /* Keep one thread for the UI. Each context uses driver memory, so their number is capped. */
+  const int threads_len = BLI_system_thread_count() - 1;
+  return max_ii(1, min_ii(threads_len, DRW_DEFERRED_SHADER_WORKERS_MAX));
+}
 
-  const bool use_main_context_workaround = GPU_use_main_context_workaround();
-  if (use_main_context_workaround) {
-    BLI_assert(gl_context == DST.gl_context);
-    GPU_context_main_lock();
-  }
+static void drw_deferred_shader_worker_compile(DRWShaderCompilerWorker *worker)
+{
+  DRWShaderCompiler *comp = worker->comp;
 
-  WM_opengl_context_activate(gl_context);
-  GPU_context_active_set(gpu_context);
+  WM_opengl_context_activate(worker->gl_context);
+  GPU_context_active_set(worker->gpu_context);
 
   while (true) {
     BLI_spin_lock(&comp->list_lock);
 
-    if (*stop != 0) {
+    if (*comp->stop != 0) {
       /* We don't want user to be able to cancel the compilation
        * but wm can kill the task if we are closing blender. */
       BLI_spin_unlock(&comp->list_lock);
@@ -132,41 +138,86 @@ static void drw_deferred_shader_compilation_exec(
 
     /* Pop tail because it will be less likely to lock the main thread
      * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()). */
-    comp->mat_compiling = BLI_poptail(&comp->queue);
-    if (comp->mat_compiling == NULL) {
+    worker->mat_compiling = BLI_poptail(&comp->queue);
+    if (worker->mat_compiling == NULL) {
       /* No more Shader to compile. */
       BLI_spin_unlock(&comp->list_lock);
       break;
     }
 
-    comp->shaders_done++;
-    int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
-
-    BLI_mutex_lock(&comp->compilation_lock);
+    BLI_mutex_lock(&worker->compilation_lock);
     BLI_spin_unlock(&comp->list_lock);
 
     /* Do the compilation. */
-    GPU_material_compile(comp->mat_compiling->mat);
-
-    *progress = (float)comp->shaders_done / (float)total;
-    *do_update = true;
+    GPU_material_compile(worker->mat_compiling->mat);
 
     GPU_flush();
-    BLI_mutex_unlock(&comp->compilation_lock);
+    BLI_mutex_unlock(&worker->compilation_lock);
 
     BLI_spin_lock(&comp->list_lock);
-    if (GPU_material_status(comp->mat_compiling->mat) == GPU_MAT_QUEUED) {
-      BLI_addtail(&comp->queue_conclude, comp->mat_compiling);
+    comp->shaders_done++;
+    const int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
+    *comp->progress = (float)comp->shaders_done / (float)total;
+    *comp->do_update = true;
+
+    if (GPU_material_status(worker->mat_compiling->mat) == GPU_MAT_QUEUED) {
+      BLI_addtail(&comp->queue_conclude, worker->mat_compiling);
     }
     else {
-      drw_deferred_shader_free(comp->mat_compiling);
+      drw_deferred_shader_free(worker->mat_compiling);
     }
-    comp->mat_compiling = NULL;
+    worker->mat_compiling = NULL;
     BLI_spin_unlock(&comp->list_lock);
   }
 
   GPU_context_active_set(NULL);
-  WM_opengl_context_release(gl_context);
+  WM_opengl_context_release(worker->gl_context);
+}
+
+static void *drw_deferred_shader_worker_thread(void *worker)
+{
+  drw_deferred_shader_worker_compile((DRWShaderCompilerWorker *)worker);
+  return NULL;
+}
+
+static void drw_deferred_shader_compilation_exec(
+    void *custom_data,
+    /* Cannot be const, this function implements wm_jobs_start_callback.
+     * NOLINTNEXTLINE: readability-non-const-parameter. */
+    short *stop,
+    short *do_update,
+    float *progress)
+{
+  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
+
+  BLI_assert(comp->workers_len > 0);
+
+  comp->stop = stop;
+  comp->do_update = do_update;
+  comp->progress = progress;
+
+  const bool use_main_context_workaround = GPU_use_main_context_workaround();
+  if (use_main_context_workaround) {
+    BLI_assert(comp->workers_len == 1);
+    BLI_assert(comp->workers[0].gl_context == DST.gl_context);
+    GPU_context_main_lock();
+  }
+
+  /* The job thread runs the first worker, the others get their own thread. */
+  ListBase threads;
+  if (comp->workers_len > 1) {
+    BLI_threadpool_init(&threads, drw_deferred_shader_worker_thread, comp->workers_len - 1);
+    for (int i = 1; i < comp->workers_len; i++) {
+      BLI_threadpool_insert(&threads, &comp->workers[i]);
+    }
+  }
+
+  drw_deferred_shader_worker_compile(&comp->workers[0]);
+
+  if (comp->workers_len > 1) {
+    BLI_threadpool_end(&threads);
+  }
+
   if (use_main_context_workaround) {
     GPU_context_main_unlock();
   }
@@ -190,14 +241,19 @@ static void drw_deferred_shader_compilation_free(void *custom_data)
   }
 
   BLI_spin_end(&comp->list_lock);
-  BLI_mutex_end(&comp->compilation_lock);
+  for (int i = 0; i < DRW_DEFERRED_SHADER_WORKERS_MAX; i++) {
+    BLI_mutex_end(&comp->workers[i].compilation_lock);
+  }
 
   if (comp->own_context) {
-    /* Only destroy if the job owns the context. */
-    WM_opengl_context_activate(comp->gl_context);
-    GPU_context_active_set(comp->gpu_context);
-    GPU_context_discard(comp->gpu_context);
-    WM_opengl_context_dispose(comp->gl_context);
+    /* Only destroy if the job owns the contexts. */
+    for (int i = 0; i < comp->workers_len; i++) {
+      DRWShaderCompilerWorker *worker = &comp->workers[i];
+      WM_opengl_context_activate(worker->gl_context);
+      GPU_context_active_set(worker->gpu_context);
+      GPU_context_discard(worker->gpu_context);
+      WM_opengl_context_dispose(worker->gl_context);
+    }
 
     wm_window_reset_drawable();
   }
@@ -240,16 +296,22 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 
   DRWShaderCompiler *comp = MEM_callocN(sizeof(DRWShaderCompiler), "DRWShaderCompiler");
   BLI_spin_init(&comp->list_lock);
-  BLI_mutex_init(&comp->compilation_lock);
+  for (int i = 0; i < DRW_DEFERRED_SHADER_WORKERS_MAX; i++) {
+    comp->workers[i].comp = comp;
+    BLI_mutex_init(&comp->workers[i].compilation_lock);
+  }
 
   if (old_comp) {
     BLI_spin_lock(&old_comp->list_lock);
     BLI_movelisttolist(&comp->queue, &old_comp->queue);
     BLI_spin_unlock(&old_comp->list_lock);
-    /* Do not recreate context, just pass ownership. */
-    if (old_comp->gl_context) {
-      comp->gl_context = old_comp->gl_context;
-      comp->gpu_context = old_comp->gpu_context;
+    /* Do not recreate contexts, just pass ownership. */
+    if (old_comp->workers_len > 0) {
+      for (int i = 0; i < old_comp->workers_len; i++) {
+        comp->workers[i].gl_context = old_comp->workers[i].gl_context;
+        comp->workers[i].gpu_context = old_comp->workers[i].gpu_context;
+      }
+      comp->workers_len = old_comp->workers_len;
       old_comp->own_context = false;
       comp->own_context = job_own_context;
     }
@@ -257,16 +319,20 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 
   BLI_addtail(&comp->queue, dsh);
 
-  /* Create only one context. */
-  if (comp->gl_context == NULL) {
+  /* Create the contexts only once. */
+  if (comp->workers_len == 0) {
     if (use_main_context) {
-      comp->gl_context = DST.gl_context;
-      comp->gpu_context = DST.gpu_context;
+      comp->workers[0].gl_context = DST.gl_context;
+      comp->workers[0].gpu_context = DST.gpu_context;
+      comp->workers_len = 1;
     }
     else {
-      comp->gl_context = WM_opengl_context_create();
-      comp->gpu_context = GPU_context_create(NULL);
-      GPU_context_active_set(NULL);
+      comp->workers_len = drw_deferred_shader_workers_len();
+      for (int i = 0; i < comp->workers_len; i++) {
+        comp->workers[i].gl_context = WM_opengl_context_create();
+        comp->workers[i].gpu_context = GPU_context_create(NULL);
+        GPU_context_active_set(NULL);
+      }
 
       WM_opengl_context_activate(DST.gl_context);
       GPU_context_active_set(DST.gpu_context);
@@ -308,9 +374,12 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
         }
 
         /* Wait for compilation to finish */
-        if ((comp->mat_compiling != NULL) && (comp->mat_compiling->mat == mat)) {
-          BLI_mutex_lock(&comp->compilation_lock);
-          BLI_mutex_unlock(&comp->compilation_lock);
+        for (int i = 0; i < comp->workers_len; i++) {
+          DRWShaderCompilerWorker *worker = &comp->workers[i];
+          if ((worker->mat_compiling != NULL) && (worker->mat_compiling->mat == mat)) {
+            BLI_mutex_lock(&worker->compilation_lock);
+            BLI_mutex_unlock(&worker->compilation_lock);
+          }
         }
 
         BLI_spin_unlock(&comp->list_lock);
@@ -43,7 +43,8 @@ uniform usamplerBuffer hairStrandSegBuffer; /* R16UI */
 
 /* -- Subdivision stage -- */
 /**
- * We use a transform feedback to preprocess the strands and add more subdivision to it.
+ * We use a compute shader (or transform feedback when not supported) to preprocess the strands
+ * and add more subdivision to it.
  * For the moment these are simple smooth interpolation but one could hope to see the full
  * children particle modifiers being evaluated at this stage.
  *
@@ -51,6 +52,21 @@ uniform usamplerBuffer hairStrandSegBuffer; /* R16UI */
  */
 
 #ifdef HAIR_PHASE_SUBDIV
+#  ifdef GPU_COMPUTE_SHADER
+/* Index of the first refined point of the dispatch, updates are split in multiple dispatches. */
+uniform int hairRefineOffset = 0;
+
+int hair_get_refine_id(void)
+{
+  return hairRefineOffset + int(gl_GlobalInvocationID.x);
+}
+#  else
+int hair_get_refine_id(void)
+{
+  return gl_VertexID;
+}
+#  endif
+
 int hair_get_base_id(float local_time, int strand_segments, out float interp_time)
 {
   float time_per_strand_seg = 1.0 / float(strand_segments);
@@ -64,9 +80,10 @@ int hair_get_base_id(float local_time, int strand_segments, out float interp_tim
 void hair_get_interp_attrs(
     out vec4 data0, out vec4 data1, out vec4 data2, out vec4 data3, out float interp_time)
 {
-  float local_time = float(gl_VertexID % hairStrandsRes) / float(hairStrandsRes - 1);
+  int refine_id = hair_get_refine_id();
+  float local_time = float(refine_id % hairStrandsRes) / float(hairStrandsRes - 1);
 
-  int hair_id = gl_VertexID / hairStrandsRes;
+  int hair_id = refine_id / hairStrandsRes;
   int strand_offset = int(texelFetch(hairStrandBuffer, hair_id).x);
   int strand_segments = int(texelFetch(hairStrandSegBuffer, hair_id).x);
 
@@ -88,6 +105,47 @@ void hair_get_interp_attrs(
     data3 = data2 * 2.0 - data1;
   }
 }
+
+vec4 get_weights_cardinal(float t)
+{
+  float t2 = t * t;
+  float t3 = t2 * t;
+#if defined(CARDINAL)
+  float fc = 0.71;
+#else /* defined(CATMULL_ROM) */
+  float fc = 0.5;
+#endif
+
+  vec4 weights;
+  /* GLSL Optimized version of key_curve_position_weights() */
+  float fct = t * fc;
+  float fct2 = t2 * fc;
+  float fct3 = t3 * fc;
+  weights.x = (fct2 * 2.0 - fct3) - fct;
+  weights.y = (t3 * 2.0 - fct3) + (-t2 * 3.0 + fct2) + 1.0;
+  weights.z = (-t3 * 2.0 + fct3) + (t2 * 3.0 - (2.0 * fct2)) + fct;
+  weights.w = fct3 - fct2;
+  return weights;
+}
+
+/* TODO(fclem): This one is buggy, find why. (it's not the optimization!!) */
+vec4 get_weights_bspline(float t)
+{
+  float t2 = t * t;
+  float t3 = t2 * t;
+
+  vec4 weights;
+  /* GLSL Optimized version of key_curve_position_weights() */
+  weights.xz = vec2(-0.16666666, -0.5) * t3 + (0.5 * t2 + 0.5 * vec2(-t, t) + 0.16666666);
+  weights.y = (0.5 * t3 - t2 + 0.66666666);
+  weights.w = (0.16666666 * t3);
+  return weights;
+}
+
+vec4 interp_data(vec4 v0, vec4 v1, vec4 v2, vec4 v3, vec4 w)
+{
+  return v0 * w.x + v1 * w.y + v2 * w.z + v3 * w.w;
+}
 #endif
 
 /* -- Drawing stage -- */
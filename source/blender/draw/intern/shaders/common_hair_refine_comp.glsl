@@ -0,0 +1,28 @@
+
+/* To be compiled with common_hair_lib.glsl */
+
+layout(local_size_x = 64) in;
+
+/* Total number of refined points of the dispatches. */
+uniform int hairRefineLen;
+
+layout(std430, binding = 0) writeonly buffer hairPointOutputBuffer
+{
+  vec4 posTime[];
+}
+out_vertbuf;
+
+void main(void)
+{
+  int refine_id = hair_get_refine_id();
+  if (refine_id >= hairRefineLen) {
+    return;
+  }
+
+  float interp_time;
+  vec4 data0, data1, data2, data3;
+  hair_get_interp_attrs(data0, data1, data2, data3, interp_time);
+
+  vec4 weights = get_weights_cardinal(interp_time);
+  out_vertbuf.posTime[refine_id] = interp_data(data0, data1, data2, data3, weights);
+}
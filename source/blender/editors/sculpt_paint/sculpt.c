@@ -784,13 +784,26 @@ static void sculpt_vertex_neighbors_get_faces(SculptSession *ss,
   iter->capacity = SCULPT_VERTEX_NEIGHBOR_FIXED_CAPACITY;
   iter->neighbors = iter->neighbors_fixed;
 
-  for (int i = 0; i < ss->pmap[index].count; i++) {
-    const MPoly *p = &ss->mpoly[vert_map->indices[i]];
-    uint f_adj_v[2];
-    if (poly_get_adj_loops_from_vert(p, ss->mloop, index, f_adj_v) != -1) {
-      for (int j = 0; j < ARRAY_SIZE(f_adj_v); j += 1) {
-        if (f_adj_v[j] != index) {
-          sculpt_vertex_neighbor_add(iter, f_adj_v[j]);
+  if (ss->vert_neighbors) {
+    /* Use the cached adjacency, its neighbors are already unique. */
+    const int start = ss->vert_neighbors_offset[index];
+    const int len = ss->vert_neighbors_offset[index + 1] - start;
+    if (len > iter->capacity) {
+      iter->capacity = len + SCULPT_VERTEX_NEIGHBOR_FIXED_CAPACITY;
+      iter->neighbors = MEM_mallocN(iter->capacity * sizeof(int), "neighbor array");
+    }
+    memcpy(iter->neighbors, &ss->vert_neighbors[start], sizeof(int) * len);
+    iter->size = len;
+  }
+  else {
+    for (int i = 0; i < ss->pmap[index].count; i++) {
+      const MPoly *p = &ss->mpoly[vert_map->indices[i]];
+      uint f_adj_v[2];
+      if (poly_get_adj_loops_from_vert(p, ss->mloop, index, f_adj_v) != -1) {
+        for (int j = 0; j < ARRAY_SIZE(f_adj_v); j += 1) {
+          if (f_adj_v[j] != index) {
+            sculpt_vertex_neighbor_add(iter, f_adj_v[j]);
+          }
         }
       }
     }
@@ -2448,12 +2461,48 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   float rgba[4];
   float point[3];
 
-  sub_v3_v3v3(point, brush_point, cache->plane_offset);
+  /* Hardness. */
+  float final_len = len;
+  const float hardness = cache->paint_brush.hardness;
+  float p = len / cache->radius;
+  if (p < hardness) {
+    final_len = 0.0f;
+  }
+  else if (hardness == 1.0f) {
+    final_len = cache->radius;
+  }
+  else {
+    p = (p - hardness) / (1.0f - hardness);
+    final_len = p * cache->radius;
+  }
+
+  /* Falloff curve. */
+  float factor = BKE_brush_curve_strength(br, final_len, cache->radius);
+  factor *= frontface(br, cache->view_normal, vno, fno);
+
+  /* Paint mask. */
+  factor *= 1.0f - mask;
+
+  /* Evaluate the cheap factors first, most vertices in the brush bounds end up outside of the
+   * falloff or masked and don't need texture sampling. */
+  if (factor == 0.0f) {
+    return 0.0f;
+  }
 
+  /* Auto-masking. */
+  factor *= SCULPT_automasking_factor_get(cache->automasking, ss, vertex_index);
+  if (factor == 0.0f) {
+    return 0.0f;
+  }
+
+  /* Brush texture. */
   if (!mtex->tex) {
-    avg = 1.0f;
+    return factor;
   }
-  else if (mtex->brush_map_mode == MTEX_MAP_MODE_3D) {
+
+  sub_v3_v3v3(point, brush_point, cache->plane_offset);
+
+  if (mtex->brush_map_mode == MTEX_MAP_MODE_3D) {
     /* Get strength by feeding the vertex location directly into a texture. */
     avg = BKE_brush_sample_tex_3d(scene, br, point, rgba, 0, ss->tex_pool);
   }
@@ -2500,32 +2549,7 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
-  /* Hardness. */
-  float final_len = len;
-  const float hardness = cache->paint_brush.hardness;
-  float p = len / cache->radius;
-  if (p < hardness) {
-    final_len = 0.0f;
-  }
-  else if (hardness == 1.0f) {
-    final_len = cache->radius;
-  }
-  else {
-    p = (p - hardness) / (1.0f - hardness);
-    final_len = p * cache->radius;
-  }
-
-  /* Falloff curve. */
-  avg *= BKE_brush_curve_strength(br, final_len, cache->radius);
-  avg *= frontface(br, cache->view_normal, vno, fno);
-
-  /* Paint mask. */
-  avg *= 1.0f - mask;
-
-  /* Auto-masking. */
-  avg *= SCULPT_automasking_factor_get(cache->automasking, ss, vertex_index);
-
-  return avg;
+  return avg * factor;
 }
 
 /* Test AABB against sphere. */
@@ -7957,6 +7981,7 @@ static void sculpt_stroke_done(const bContext *C, struct PaintStroke *UNUSED(str
     SCULPT_cache_free(ss->cache);
     ss->cache = NULL;
 
+    SCULPT_undo_free_unmodified_nodes(ob);
     SCULPT_undo_push_end();
 
     if (brush->sculpt_tool == SCULPT_TOOL_MASK) {
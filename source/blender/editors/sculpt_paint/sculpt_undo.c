@@ -23,6 +23,7 @@
  */
 
 #include <stddef.h>
+#include <string.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -1402,6 +1403,74 @@ void SCULPT_undo_push_begin(Object *ob, const char *name)
   BKE_undosys_step_push_init_with_type(ustack, C, name, BKE_UNDOSYS_TYPE_SCULPT);
 }
 
+static bool sculpt_undo_node_is_unmodified(SculptSession *ss, SculptUndoNode *unode)
+{
+  PBVHVertexIter vd;
+
+  BKE_pbvh_vertex_iter_begin(ss->pbvh, unode->node, vd, PBVH_ITER_ALL)
+  {
+    if (unode->type == SCULPT_UNDO_COORDS) {
+      /* No need for float comparison here (memory is exactly equal or not). */
+      if (memcmp(unode->co[vd.i], vd.co, sizeof(float[3])) != 0) {
+        return false;
+      }
+    }
+    else if (vd.mask == NULL || unode->mask[vd.i] != *vd.mask) {
+      return false;
+    }
+  }
+  BKE_pbvh_vertex_iter_end;
+
+  return true;
+}
+
+/**
+ * Brushes push undo nodes for every PBVH node overlapping their bounds, many of which end up
+ * untouched (outside of the falloff or masked). Drop those at the end of the stroke so the undo
+ * memory of a step scales with the part of the mesh that was actually modified.
+ */
+void SCULPT_undo_free_unmodified_nodes(Object *ob)
+{
+  UndoSculpt *usculpt = sculpt_undo_get_nodes();
+  SculptSession *ss = ob->sculpt;
+
+  if (usculpt == NULL || ss->pbvh == NULL || BKE_pbvh_type(ss->pbvh) != PBVH_FACES) {
+    return;
+  }
+
+  /* Always keep the first node, restoring the pivot relies on it. */
+  SculptUndoNode *unode = usculpt->nodes.first;
+  while (unode && unode->next) {
+    SculptUndoNode *unode_next = unode->next;
+
+    if (ELEM(unode_next->type, SCULPT_UNDO_COORDS, SCULPT_UNDO_MASK) && unode_next->node &&
+        STREQ(unode_next->idname, ob->id.name) &&
+        sculpt_undo_node_is_unmodified(ss, unode_next)) {
+      BLI_remlink(&usculpt->nodes, unode_next);
+      usculpt->undo_size -= MEM_allocN_len(unode_next->index);
+      if (unode_next->co) {
+        usculpt->undo_size -= MEM_allocN_len(unode_next->co);
+      }
+      if (unode_next->no) {
+        usculpt->undo_size -= MEM_allocN_len(unode_next->no);
+      }
+      if (unode_next->orig_co) {
+        usculpt->undo_size -= MEM_allocN_len(unode_next->orig_co);
+      }
+      if (unode_next->mask) {
+        usculpt->undo_size -= MEM_allocN_len(unode_next->mask);
+      }
+
+      ListBase lb = {unode_next, unode_next};
+      unode_next->next = unode_next->prev = NULL;
+      sculpt_undo_free_list(&lb);
+    }
+    else {
+      unode = unode_next;
+    }
+  }
+}
+
 void SCULPT_undo_push_end(void)
 {
   SCULPT_undo_push_end_ex(false);
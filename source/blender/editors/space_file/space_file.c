@@ -948,9 +948,10 @@ void ED_spacetype_file(void)
 
 void ED_file_init(void)
 {
-  ED_file_read_bookmarks();
-
   if (G.background == false) {
+    /* Scanning the system volumes can be slow (network mounts for e.g.),
+     * bookmarks are only used by the file browser. */
+    ED_file_read_bookmarks();
     filelist_init_icons();
   }
 
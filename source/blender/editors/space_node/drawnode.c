@@ -3374,6 +3374,13 @@ static void node_geometry_buts_points_to_volume(uiLayout *layout,
   uiItemR(layout, ptr, "input_type_radius", DEFAULT_FLAGS, IFACE_("Radius"), ICON_NONE);
 }
 
+static void node_geometry_buts_attribute_proximity(uiLayout *layout,
+                                                   bContext *UNUSED(C),
+                                                   PointerRNA *ptr)
+{
+  uiItemR(layout, ptr, "target_geometry_element", DEFAULT_FLAGS, "", ICON_NONE);
+}
+
 static void node_geometry_set_butfunc(bNodeType *ntype)
 {
   switch (ntype->type) {
@@ -3434,6 +3441,9 @@ static void node_geometry_set_butfunc(bNodeType *ntype)
     case GEO_NODE_POINTS_TO_VOLUME:
       ntype->draw_buttons = node_geometry_buts_points_to_volume;
       break;
+    case GEO_NODE_ATTRIBUTE_PROXIMITY:
+      ntype->draw_buttons = node_geometry_buts_attribute_proximity;
+      break;
   }
 }
 
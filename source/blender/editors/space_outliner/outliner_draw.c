@@ -40,6 +40,8 @@
 #include "BLI_string_utils.h"
 #include "BLI_utildefines.h"
 
+#include "BLF_api.h"
+
 #include "BLT_translation.h"
 
 #include "BKE_armature.h"
@@ -3522,7 +3524,9 @@ static void outliner_draw_tree(bContext *C,
   startx = mode_column_offset + UI_UNIT_X / 2 - (U.pixelsize + 1) / 2;
   outliner_draw_hierarchy_lines(space_outliner, &space_outliner->tree, startx, &starty);
 
-  /* Items themselves. */
+  /* Items themselves, their names are drawn all at once. */
+  BLF_batch_draw_begin();
+
   starty = (int)region->v2d.tot.ymax - UI_UNIT_Y - OL_Y_OFFSET;
   startx = mode_column_offset;
   LISTBASE_FOREACH (TreeElement *, te, &space_outliner->tree) {
@@ -3540,6 +3544,8 @@ static void outliner_draw_tree(bContext *C,
                                te_edit);
   }
 
+  BLF_batch_draw_end();
+
   if (restrict_column_width > 0.0f) {
     /* reset scissor */
     GPU_scissor(UNPACK4(scissor));
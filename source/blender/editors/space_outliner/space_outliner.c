@@ -158,6 +158,10 @@ static void outliner_main_region_listener(const wmRegionListenerParams *params)
     case NC_OBJECT:
       switch (wmn->data) {
         case ND_TRANSFORM:
+          /* The tree doesn't depend on transforms, don't rebuild it for every step of a transform
+           * (only values of the Data API view need to be redrawn). */
+          ED_region_tag_redraw_no_rebuild(region);
+          break;
         case ND_BONE_ACTIVE:
         case ND_BONE_SELECT:
         case ND_DRAW:
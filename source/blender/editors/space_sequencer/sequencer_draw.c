@@ -1528,8 +1528,8 @@ static void *sequencer_OCIO_transform_ibuf(const bContext *C,
   void *cache_handle = NULL;
   bool force_fallback = false;
   *r_glsl_used = false;
+  /* Dither is applied by the GLSL display transform as well. */
   force_fallback |= (ED_draw_imbuf_method(ibuf) != IMAGE_DRAW_METHOD_GLSL);
-  force_fallback |= (ibuf->dither != 0.0f);
 
   /* Default */
   *r_format = GPU_RGBA8;
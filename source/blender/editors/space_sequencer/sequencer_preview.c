@@ -25,6 +25,7 @@
 #include "DNA_sound_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_context.h"
@@ -46,6 +47,10 @@ typedef struct PreviewJob {
   Scene *scene;
   int total;
   int processed;
+  /* Of the running job, shared by its tasks. */
+  short *stop;
+  short *do_update;
+  float *progress;
 } PreviewJob;
 
 typedef struct PreviewJobAudio {
@@ -66,58 +71,73 @@ static void free_preview_job(void *data)
   MEM_freeN(pj);
 }
 
-/* Only this runs inside thread. */
-static void preview_startjob(void *data, short *stop, short *do_update, float *progress)
+static void preview_clear_remaining(PreviewJob *pj)
 {
-  PreviewJob *pj = data;
-  PreviewJobAudio *previewjb;
-
   BLI_mutex_lock(pj->mutex);
-  previewjb = pj->previews.first;
+  LISTBASE_FOREACH (PreviewJobAudio *, previewjb, &pj->previews) {
+    bSound *sound = previewjb->sound;
+
+    /* Make sure we cleanup the loading flag! */
+    BLI_spin_lock(sound->spinlock);
+    sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
+    BLI_spin_unlock(sound->spinlock);
+  }
+  BLI_freelistN(&pj->previews);
+  pj->total = 0;
+  pj->processed = 0;
   BLI_mutex_unlock(pj->mutex);
+}
 
-  while (previewjb) {
-    PreviewJobAudio *preview_next;
-    bSound *sound = previewjb->sound;
+/* Each task reads waveforms until the list is empty, so sounds which are added while the job
+ * runs are read as well. */
+static void preview_task_func(TaskPool *__restrict pool, void *UNUSED(taskdata))
+{
+  PreviewJob *pj = BLI_task_pool_user_data(pool);
+
+  while (true) {
+    BLI_mutex_lock(pj->mutex);
+    PreviewJobAudio *previewjb = BLI_pophead(&pj->previews);
+    BLI_mutex_unlock(pj->mutex);
 
-    BKE_sound_read_waveform(previewjb->bmain, sound, stop);
-
-    if (*stop || G.is_break) {
-      BLI_mutex_lock(pj->mutex);
-      previewjb = previewjb->next;
-      BLI_mutex_unlock(pj->mutex);
-      while (previewjb) {
-        sound = previewjb->sound;
-
-        /* Make sure we cleanup the loading flag! */
-        BLI_spin_lock(sound->spinlock);
-        sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
-        BLI_spin_unlock(sound->spinlock);
-
-        BLI_mutex_lock(pj->mutex);
-        previewjb = previewjb->next;
-        BLI_mutex_unlock(pj->mutex);
-      }
-
-      BLI_mutex_lock(pj->mutex);
-      BLI_freelistN(&pj->previews);
-      pj->total = 0;
-      pj->processed = 0;
-      BLI_mutex_unlock(pj->mutex);
+    if (previewjb == NULL) {
+      break;
+    }
+
+    BKE_sound_read_waveform(previewjb->bmain, previewjb->sound, pj->stop);
+    MEM_freeN(previewjb);
+
+    if (*pj->stop || G.is_break) {
+      preview_clear_remaining(pj);
       break;
     }
 
     BLI_mutex_lock(pj->mutex);
-    preview_next = previewjb->next;
-    BLI_freelinkN(&pj->previews, previewjb);
-    previewjb = preview_next;
     pj->processed++;
-    *progress = (pj->total > 0) ? (float)pj->processed / (float)pj->total : 1.0f;
-    *do_update = true;
+    *pj->progress = (pj->total > 0) ? (float)pj->processed / (float)pj->total : 1.0f;
+    *pj->do_update = true;
     BLI_mutex_unlock(pj->mutex);
   }
 }
 
+/* Only this runs inside thread. */
+static void preview_startjob(void *data, short *stop, short *do_update, float *progress)
+{
+  PreviewJob *pj = data;
+  /* Decoding is mostly bound by the CPU, read multiple sounds at the same time. */
+  const int tot_thread = BLI_task_scheduler_num_threads();
+
+  pj->stop = stop;
+  pj->do_update = do_update;
+  pj->progress = progress;
+
+  TaskPool *task_pool = BLI_task_pool_create(pj, TASK_PRIORITY_LOW);
+  for (int i = 0; i < tot_thread; i++) {
+    BLI_task_pool_push(task_pool, preview_task_func, NULL, false, NULL);
+  }
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+}
+
 static void preview_endjob(void *data)
 {
   PreviewJob *pj = data;
@@ -39,6 +39,9 @@ typedef struct TransDataGenericSlideVert {
   float co_orig_3d[3];
 } TransDataGenericSlideVert;
 
+/** Minimum number of elements in a container before applying a mode is threaded. */
+#define TRANSDATA_THREAD_LIMIT 1024
+
 /* transform_mode.c */
 int transform_mode_really_used(struct bContext *C, int mode);
 bool transdata_check_local_center(TransInfo *t, short around);
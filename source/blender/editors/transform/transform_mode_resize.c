@@ -24,6 +24,7 @@
 #include <stdlib.h>
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_unit.h"
@@ -75,6 +76,24 @@ static void ApplySnapResize(TransInfo *t, float vec[3])
   }
 }
 
+struct TransDataArgs_Resize {
+  TransInfo *t;
+  TransDataContainer *tc;
+  float (*mat)[3];
+};
+
+static void transdata_elem_resize_fn(void *__restrict iter_data_v,
+                                     const int iter,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct TransDataArgs_Resize *data = iter_data_v;
+  TransData *td = &data->tc->data[iter];
+  if (td->flag & TD_SKIP) {
+    return;
+  }
+  ElementResize(data->t, data->tc, td, data->mat);
+}
+
 static void applyResize(TransInfo *t, const int UNUSED(mval[2]))
 {
   float mat[3][3];
@@ -122,6 +141,19 @@ static void applyResize(TransInfo *t, const int UNUSED(mval[2]))
   copy_m3_m3(t->mat, mat); /* used in gizmo */
 
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    /* Grease pencil strokes update #TransInfo.values_final in #ElementResize. */
+    if (tc->data_len >= TRANSDATA_THREAD_LIMIT && !(t->options & CTX_GPENCIL_STROKES)) {
+      struct TransDataArgs_Resize data = {
+          .t = t,
+          .tc = tc,
+          .mat = mat,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      BLI_task_parallel_range(0, tc->data_len, &data, transdata_elem_resize_fn, &settings);
+      continue;
+    }
+
     TransData *td = tc->data;
     for (i = 0; i < tc->data_len; i++, td++) {
       if (td->flag & TD_SKIP) {
@@ -28,8 +28,15 @@
 
 #include "BKE_global.h"
 
+#include "BLI_task.hh"
+
 namespace Freestyle {
 
+using blender::IndexRange;
+
+/* Faces and edges are processed independently, in chunks of this size. */
+#define FEDGE_X_DETECTOR_GRAIN_SIZE 1024
+
 void FEdgeXDetector::processShapes(WingedEdge &we)
 {
   bool progressBarDisplay = false;
@@ -131,11 +138,13 @@ void FEdgeXDetector::preProcessShape(WXShape *iWShape)
 #endif
 
   vector<WFace *> &wfaces = iWShape->GetFaceList();
-  vector<WFace *>::iterator f, fend;
   // view dependent stuff
-  for (f = wfaces.begin(), fend = wfaces.end(); f != fend; ++f) {
-    preProcessFace((WXFace *)(*f));
-  }
+  blender::parallel_for(
+      IndexRange(wfaces.size()), FEDGE_X_DETECTOR_GRAIN_SIZE, [&](IndexRange range) {
+        for (const int64_t i : range) {
+          preProcessFace((WXFace *)wfaces[i]);
+        }
+      });
 
   if (_computeRidgesAndValleys || _computeSuggestiveContours) {
     vector<WVertex *> &wvertices = iWShape->getVertexList();
@@ -266,17 +275,21 @@ void FEdgeXDetector::processSilhouetteShape(WXShape *iWShape)
 {
   // Make a first pass on every polygons in order to compute all their silhouette relative values:
   vector<WFace *> &wfaces = iWShape->GetFaceList();
-  vector<WFace *>::iterator f, fend;
-  for (f = wfaces.begin(), fend = wfaces.end(); f != fend; ++f) {
-    ProcessSilhouetteFace((WXFace *)(*f));
-  }
+  blender::parallel_for(
+      IndexRange(wfaces.size()), FEDGE_X_DETECTOR_GRAIN_SIZE, [&](IndexRange range) {
+        for (const int64_t i : range) {
+          ProcessSilhouetteFace((WXFace *)wfaces[i]);
+        }
+      });
 
   // Make a pass on the edges to detect the silhouette edges that are not smooth
-  vector<WEdge *>::iterator we, weend;
   vector<WEdge *> &wedges = iWShape->getEdgeList();
-  for (we = wedges.begin(), weend = wedges.end(); we != weend; ++we) {
-    ProcessSilhouetteEdge((WXEdge *)(*we));
-  }
+  blender::parallel_for(
+      IndexRange(wedges.size()), FEDGE_X_DETECTOR_GRAIN_SIZE, [&](IndexRange range) {
+        for (const int64_t i : range) {
+          ProcessSilhouetteEdge((WXEdge *)wedges[i]);
+        }
+      });
 }
 
 void FEdgeXDetector::ProcessSilhouetteFace(WXFace *iFace)
@@ -385,11 +398,13 @@ void FEdgeXDetector::processCreaseShape(WXShape *iWShape)
   }
 
   // Make a pass on the edges to detect the CREASE
-  vector<WEdge *>::iterator we, weend;
   vector<WEdge *> &wedges = iWShape->getEdgeList();
-  for (we = wedges.begin(), weend = wedges.end(); we != weend; ++we) {
-    ProcessCreaseEdge((WXEdge *)(*we));
-  }
+  blender::parallel_for(
+      IndexRange(wedges.size()), FEDGE_X_DETECTOR_GRAIN_SIZE, [&](IndexRange range) {
+        for (const int64_t i : range) {
+          ProcessCreaseEdge((WXEdge *)wedges[i]);
+        }
+      });
 }
 
 void FEdgeXDetector::ProcessCreaseEdge(WXEdge *iEdge)
@@ -126,6 +126,7 @@ namespace multi_function_types {
 using fn::CPPType;
 using fn::GMutableSpan;
 using fn::GSpan;
+using fn::MFBufferPool;
 using fn::MFContext;
 using fn::MFContextBuilder;
 using fn::MFDataType;
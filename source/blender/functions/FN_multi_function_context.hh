@@ -19,24 +19,80 @@
 /** \file
  * \ingroup fn
  *
- * An #MFContext is passed along with every call to a multi-function. Right now it does nothing,
- * but it can be used for the following purposes:
+ * An #MFContext is passed along with every call to a multi-function. It can be used for the
+ * following purposes:
  * - Pass debug information up and down the function call stack.
  * - Pass reusable memory buffers to sub-functions to increase performance.
  * - Pass cached data to called functions.
  */
 
-#include "BLI_utildefines.h"
+#include <mutex>
+
+#include "MEM_guardedalloc.h"
 
 #include "BLI_map.hh"
+#include "BLI_utildefines.h"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
 
 namespace blender::fn {
 
 class MFContext;
 
+/**
+ * Keeps memory buffers that are not used anymore, so that they can be reused by later function
+ * evaluations instead of being allocated again. Buffers are grouped by their size in bytes and
+ * their alignment, so buffers of different types with the same size can be reused as well.
+ *
+ * The pool can be used from multiple threads at the same time. All buffers are freed when the
+ * pool is destructed.
+ */
+class MFBufferPool : NonCopyable, NonMovable {
+ private:
+  std::mutex mutex_;
+  Map<std::pair<int64_t, int64_t>, Vector<void *>> buffers_;
+
+ public:
+  MFBufferPool() = default;
+
+  ~MFBufferPool()
+  {
+    for (Span<void *> buffers : buffers_.values()) {
+      for (void *buffer : buffers) {
+        MEM_freeN(buffer);
+      }
+    }
+  }
+
+  /** Returns an unused buffer with the given size and alignment, or allocates a new one. */
+  void *allocate(const int64_t size, const int64_t alignment)
+  {
+    {
+      std::lock_guard lock{mutex_};
+      Vector<void *> *buffers = buffers_.lookup_ptr({size, alignment});
+      if (buffers != nullptr && !buffers->is_empty()) {
+        return buffers->pop_last();
+      }
+    }
+    return MEM_mallocN_aligned(static_cast<size_t>(size), static_cast<size_t>(alignment), AT);
+  }
+
+  /**
+   * Give buffers back to the pool. They have to be allocated with the given size and alignment
+   * and values in them have to be destructed already.
+   */
+  void deallocate(Span<void *> buffers, const int64_t size, const int64_t alignment)
+  {
+    std::lock_guard lock{mutex_};
+    buffers_.lookup_or_add_default({size, alignment}).extend(buffers);
+  }
+};
+
 class MFContextBuilder {
  private:
   Map<std::string, const void *> global_contexts_;
+  MFBufferPool *buffer_pool_ = nullptr;
+  MFBufferPool own_buffer_pool_;
 
   friend MFContext;
 
@@ -45,6 +101,15 @@ class MFContextBuilder {
   {
     global_contexts_.add_new(std::move(name), static_cast<const void *>(context));
   }
+
+  /**
+   * By default, every context builder has its own buffer pool. Passing in a pool that lives longer
+   * allows reusing buffers across multiple evaluations.
+   */
+  void set_buffer_pool(MFBufferPool &buffer_pool)
+  {
+    buffer_pool_ = &buffer_pool;
+  }
 };
 
 class MFContext {
@@ -62,6 +127,11 @@ class MFContext {
     /* TODO: Implement type checking. */
     return static_cast<const T *>(context);
   }
+
+  MFBufferPool &buffer_pool() const
+  {
+    return (builder_.buffer_pool_ == nullptr) ? builder_.own_buffer_pool_ : *builder_.buffer_pool_;
+  }
 };
 
 }  // namespace blender::fn
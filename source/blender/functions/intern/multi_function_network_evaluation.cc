@@ -28,16 +28,22 @@
  * - Avoids data copies in many cases.
  * - Every node is executed at most once.
  * - Can compute sub-functions on a single element, when the result is the same for all elements.
+ * - Large masks are split into chunks that are evaluated in parallel. The temporary buffers of a
+ *   chunk are small enough to stay in the CPU cache.
+ *
+ * - Temporary buffers are reused once their value is not needed anymore, which avoids most
+ *   allocations when the network is deep.
  *
  * Possible improvements:
- * - Cache and reuse buffers.
  * - Use "deepest depth first" heuristic to decide which order the inputs of a node should be
  *   computed. This reduces the number of required temporary buffers when they are reused.
  */
 
 #include "FN_multi_function_network_evaluation.hh"
 
+#include "BLI_map.hh"
 #include "BLI_stack.hh"
+#include "BLI_task.hh"
 
 namespace blender::fn {
 
@@ -56,9 +62,16 @@ class MFNetworkEvaluationStorage {
   IndexMask mask_;
   Array<Value *> value_per_output_id_;
   int64_t min_array_size_;
+  /**
+   * Buffers of full arrays that are not used anymore. They are grouped by their element size and
+   * alignment, so that they can be reused by other sockets of compatible types. They are given
+   * back to the buffer pool of the context when the evaluation is done.
+   */
+  Map<std::pair<int64_t, int64_t>, Vector<void *>> unused_buffers_;
+  MFBufferPool &buffer_pool_;
 
  public:
-  MFNetworkEvaluationStorage(IndexMask mask, int socket_id_amount);
+  MFNetworkEvaluationStorage(IndexMask mask, int socket_id_amount, MFBufferPool &buffer_pool);
   ~MFNetworkEvaluationStorage();
 
   /* Add the values that have been provided by the caller of the multi-function network. */
@@ -97,6 +110,10 @@ class MFNetworkEvaluationStorage {
   bool socket_is_computed(const MFOutputSocket &socket);
   bool is_same_value_for_every_index(const MFOutputSocket &socket);
   bool socket_has_buffer_for_output(const MFOutputSocket &socket);
+
+ private:
+  void *allocate_full_buffer(const CPPType &type);
+  void free_full_buffer(const CPPType &type, void *buffer);
 };
 
 MFNetworkEvaluator::MFNetworkEvaluator(Vector<const MFOutputSocket *> inputs,
@@ -135,14 +152,99 @@ MFNetworkEvaluator::MFNetworkEvaluator(Vector<const MFOutputSocket *> inputs,
   }
 }
 
+/**
+ * Masks with more indices than this are split into chunks. Smaller chunks have less memory
+ * traffic, but more overhead per node.
+ */
+static constexpr int64_t chunk_size = 4096;
+
 void MFNetworkEvaluator::call(IndexMask mask, MFParams params, MFContext context) const
 {
   if (mask.size() == 0) {
     return;
   }
+  if (mask.size() > chunk_size && this->can_evaluate_in_chunks()) {
+    this->evaluate_in_chunks(mask, params, context);
+    return;
+  }
+  this->evaluate_mask(mask, params, context);
+}
+
+/**
+ * Vector parameters can't be offset to the start of a chunk, so only networks with single
+ * parameters are split into chunks.
+ */
+bool MFNetworkEvaluator::can_evaluate_in_chunks() const
+{
+  for (const int param_index : this->param_indices()) {
+    if (this->param_type(param_index).data_type().is_vector()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+BLI_NOINLINE void MFNetworkEvaluator::evaluate_in_chunks(IndexMask mask,
+                                                         MFParams params,
+                                                         MFContext context) const
+{
+  const int64_t chunks_num = (mask.size() + chunk_size - 1) / chunk_size;
+  parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks_range) {
+    Vector<int64_t> chunk_indices;
+    for (const int64_t chunk_index : chunks_range) {
+      const int64_t start = chunk_index * chunk_size;
+      const Span<int64_t> indices = mask.indices().slice(
+          start, std::min(chunk_size, mask.size() - start));
+
+      /* Evaluate the chunk as if its first index was zero, so that temporary buffers only have to
+       * be as large as the chunk. */
+      const int64_t offset = indices.first();
+      const int64_t chunk_array_size = indices.last() - offset + 1;
+      IndexMask chunk_mask;
+      if (chunk_array_size == indices.size()) {
+        chunk_mask = IndexRange(chunk_array_size);
+      }
+      else {
+        chunk_indices.clear();
+        for (const int64_t i : indices) {
+          chunk_indices.append(i - offset);
+        }
+        chunk_mask = chunk_indices.as_span();
+      }
+
+      MFParamsBuilder chunk_params(*this, chunk_array_size);
+      for (const int param_index : this->param_indices()) {
+        switch (this->param_type(param_index).category()) {
+          case MFParamType::SingleInput:
+            chunk_params.add_readonly_single_input(
+                params.readonly_single_input(param_index).slice(offset, chunk_array_size));
+            break;
+          case MFParamType::SingleOutput:
+            chunk_params.add_uninitialized_single_output(
+                params.uninitialized_single_output(param_index).slice(offset, chunk_array_size));
+            break;
+          case MFParamType::SingleMutable:
+            chunk_params.add_single_mutable(
+                params.single_mutable(param_index).slice(offset, chunk_array_size));
+            break;
+          case MFParamType::VectorInput:
+          case MFParamType::VectorOutput:
+          case MFParamType::VectorMutable:
+            BLI_assert(false);
+            break;
+        }
+      }
+      this->evaluate_mask(chunk_mask, chunk_params, context);
+    }
+  });
+}
 
+BLI_NOINLINE void MFNetworkEvaluator::evaluate_mask(IndexMask mask,
+                                                    MFParams params,
+                                                    MFContext context) const
+{
   const MFNetwork &network = outputs_[0]->node().network();
-  Storage storage(mask, network.socket_id_amount());
+  Storage storage(mask, network.socket_id_amount(), context.buffer_pool());
 
   Vector<const MFInputSocket *> outputs_to_initialize_in_the_end;
 
@@ -506,10 +608,13 @@ struct OwnVectorValue : public Value {
 /** \name Storage methods
  * \{ */
 
-MFNetworkEvaluationStorage::MFNetworkEvaluationStorage(IndexMask mask, int socket_id_amount)
+MFNetworkEvaluationStorage::MFNetworkEvaluationStorage(IndexMask mask,
+                                                       int socket_id_amount,
+                                                       MFBufferPool &buffer_pool)
     : mask_(mask),
       value_per_output_id_(socket_id_amount, nullptr),
-      min_array_size_(mask.min_array_size())
+      min_array_size_(mask.min_array_size()),
+      buffer_pool_(buffer_pool)
 {
 }
 
@@ -528,7 +633,7 @@ MFNetworkEvaluationStorage::~MFNetworkEvaluationStorage()
       }
       else {
         type.destruct_indices(span.data(), mask_);
-        MEM_freeN(span.data());
+        this->free_full_buffer(type, span.data());
       }
     }
     else if (any_value->type == ValueType::OwnVector) {
@@ -536,6 +641,26 @@ MFNetworkEvaluationStorage::~MFNetworkEvaluationStorage()
       delete value->vector_array;
     }
   }
+  for (auto item : unused_buffers_.items()) {
+    const int64_t element_size = item.key.first;
+    const int64_t alignment = item.key.second;
+    buffer_pool_.deallocate(item.value, min_array_size_ * element_size, alignment);
+  }
+}
+
+void *MFNetworkEvaluationStorage::allocate_full_buffer(const CPPType &type)
+{
+  Vector<void *> *buffers = unused_buffers_.lookup_ptr({type.size(), type.alignment()});
+  if (buffers != nullptr && !buffers->is_empty()) {
+    return buffers->pop_last();
+  }
+  return buffer_pool_.allocate(min_array_size_ * type.size(), type.alignment());
+}
+
+/** The values in the buffer have to be destructed already. */
+void MFNetworkEvaluationStorage::free_full_buffer(const CPPType &type, void *buffer)
+{
+  unused_buffers_.lookup_or_add_default({type.size(), type.alignment()}).append(buffer);
 }
 
 IndexMask MFNetworkEvaluationStorage::mask() const
@@ -638,7 +763,7 @@ void MFNetworkEvaluationStorage::finish_input_socket(const MFInputSocket &socket
         }
         else {
           type.destruct_indices(span.data(), mask_);
-          MEM_freeN(span.data());
+          this->free_full_buffer(type, span.data());
         }
         value_per_output_id_[origin.id()] = nullptr;
       }
@@ -702,7 +827,7 @@ GMutableSpan MFNetworkEvaluationStorage::get_single_output__full(const MFOutputS
   Value *any_value = value_per_output_id_[socket.id()];
   if (any_value == nullptr) {
     const CPPType &type = socket.data_type().single_type();
-    void *buffer = MEM_mallocN_aligned(min_array_size_ * type.size(), type.alignment(), AT);
+    void *buffer = this->allocate_full_buffer(type);
     GMutableSpan span(type, buffer, min_array_size_);
 
     auto *value = allocator_.construct<OwnSingleValue>(span, socket.targets().size(), false);
@@ -802,7 +927,7 @@ GMutableSpan MFNetworkEvaluationStorage::get_mutable_single__full(const MFInputS
   }
 
   GVSpan virtual_span = this->get_single_input__full(input);
-  void *new_buffer = MEM_mallocN_aligned(min_array_size_ * type.size(), type.alignment(), AT);
+  void *new_buffer = this->allocate_full_buffer(type);
   GMutableSpan new_array_ref(type, new_buffer, min_array_size_);
   virtual_span.materialize_to_uninitialized(mask_, new_array_ref.data());
 
@@ -300,10 +300,6 @@ static Array<MFOutputSocket *> compute_constant_sockets_and_add_folded_nodes(
   return add_constant_folded_sockets(network_fn, params, resources, network);
 }
 
-class MyClass {
-  MFDummyNode node;
-};
-
 /**
  * Find function nodes that always output the same value and replace those with constant nodes.
  */
@@ -505,4 +501,30 @@ void common_subnetwork_elimination(MFNetwork &network)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Combined Optimization
+ *
+ * \{ */
+
+/**
+ * Runs all passes in an order that makes them benefit from each other:
+ * - Duplicate sub-networks are eliminated first, so that constant folding evaluates every
+ *   constant sub-network only once.
+ * - Constant folding replaces every constant sub-network that is used by non-constant nodes with
+ *   a single constant node.
+ * - Constant nodes with the same value are deduplicated. That can make more non-constant nodes
+ *   equal, so they are deduplicated as well.
+ * - Finally, all nodes whose outputs are not used anymore are removed. This includes the folded
+ *   sub-networks and the branches that were replaced by equal ones.
+ */
+void optimize(MFNetwork &network, ResourceCollector &resources)
+{
+  common_subnetwork_elimination(network);
+  constant_folding(network, resources);
+  common_subnetwork_elimination(network);
+  dead_node_removal(network);
+}
+
+/** \} */
+
 }  // namespace blender::fn::mf_network_optimization
@@ -0,0 +1,119 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "FN_multi_function_builder.hh"
+#include "FN_multi_function_network.hh"
+#include "FN_multi_function_network_evaluation.hh"
+#include "FN_multi_function_network_optimization.hh"
+
+namespace blender::fn::tests {
+namespace {
+
+static void evaluate_network(MFOutputSocket &input_socket,
+                             MFInputSocket &output_socket,
+                             Span<int> values,
+                             MutableSpan<int> r_results)
+{
+  MFNetworkEvaluator network_fn{{&input_socket}, {&output_socket}};
+  MFParamsBuilder params(network_fn, values.size());
+  params.add_readonly_single_input(values);
+  params.add_uninitialized_single_output(r_results);
+  MFContextBuilder context;
+  network_fn.call(IndexRange(values.size()), params, context);
+}
+
+TEST(multi_function_network_optimization, ConstantFolding)
+{
+  CustomMF_Constant<int> constant_fn{3};
+  CustomMF_SI_SO<int, int> add_10_fn("add 10", [](int value) { return value + 10; });
+  CustomMF_SI_SI_SO<int, int, int> multiply_fn("multiply", [](int a, int b) { return a * b; });
+
+  MFNetwork network;
+
+  /* (3 + 10) * (3 + 10) is constant, the input is multiplied with it. */
+  MFNode &constant_node = network.add_function(constant_fn);
+  MFNode &add_node = network.add_function(add_10_fn);
+  MFNode &square_node = network.add_function(multiply_fn);
+  MFNode &multiply_node = network.add_function(multiply_fn);
+  MFOutputSocket &input_socket = network.add_input("Input", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<int>());
+  network.add_link(constant_node.output(0), add_node.input(0));
+  network.add_link(add_node.output(0), square_node.input(0));
+  network.add_link(add_node.output(0), square_node.input(1));
+  network.add_link(square_node.output(0), multiply_node.input(0));
+  network.add_link(input_socket, multiply_node.input(1));
+  network.add_link(multiply_node.output(0), output_socket);
+
+  ResourceCollector resources;
+  mf_network_optimization::optimize(network, resources);
+
+  /* Only the folded constant and the multiplication with the input remain. */
+  EXPECT_EQ(network.function_nodes().size(), 2);
+  EXPECT_EQ(output_socket.origin()->node().inputs().size(), 2);
+
+  Array<int> values = {0, 1, 2};
+  Array<int> results(values.size(), 0);
+  evaluate_network(input_socket, output_socket, values, results);
+
+  EXPECT_EQ(results[0], 0);
+  EXPECT_EQ(results[1], 169);
+  EXPECT_EQ(results[2], 338);
+}
+
+TEST(multi_function_network_optimization, CommonSubnetworkElimination)
+{
+  CustomMF_SI_SO<int, int> add_10_fn("add 10", [](int value) { return value + 10; });
+  CustomMF_SI_SI_SO<int, int, int> multiply_fn("multiply", [](int a, int b) { return a * b; });
+
+  MFNetwork network;
+
+  /* Both inputs of the multiplication are computed the same way. */
+  MFNode &add_node1 = network.add_function(add_10_fn);
+  MFNode &add_node2 = network.add_function(add_10_fn);
+  MFNode &multiply_node = network.add_function(multiply_fn);
+  MFOutputSocket &input_socket = network.add_input("Input", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<int>());
+  network.add_link(input_socket, add_node1.input(0));
+  network.add_link(input_socket, add_node2.input(0));
+  network.add_link(add_node1.output(0), multiply_node.input(0));
+  network.add_link(add_node2.output(0), multiply_node.input(1));
+  network.add_link(multiply_node.output(0), output_socket);
+
+  ResourceCollector resources;
+  mf_network_optimization::optimize(network, resources);
+
+  EXPECT_EQ(network.function_nodes().size(), 2);
+  EXPECT_EQ(multiply_node.input(0).origin(), multiply_node.input(1).origin());
+
+  Array<int> values = {0, 1, 2};
+  Array<int> results(values.size(), 0);
+  evaluate_network(input_socket, output_socket, values, results);
+
+  EXPECT_EQ(results[0], 100);
+  EXPECT_EQ(results[1], 121);
+  EXPECT_EQ(results[2], 144);
+}
+
+TEST(multi_function_network_optimization, DeadNodeRemoval)
+{
+  CustomMF_SI_SO<int, int> add_10_fn("add 10", [](int value) { return value + 10; });
+
+  MFNetwork network;
+
+  MFNode &used_node = network.add_function(add_10_fn);
+  MFNode &unused_node = network.add_function(add_10_fn);
+  MFOutputSocket &input_socket = network.add_input("Input", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<int>());
+  network.add_link(input_socket, used_node.input(0));
+  network.add_link(used_node.output(0), output_socket);
+  network.add_link(used_node.output(0), unused_node.input(0));
+
+  mf_network_optimization::dead_node_removal(network);
+
+  EXPECT_EQ(network.function_nodes().size(), 1);
+  EXPECT_EQ(network.function_nodes()[0], &used_node);
+}
+
+}  // namespace
+}  // namespace blender::fn::tests
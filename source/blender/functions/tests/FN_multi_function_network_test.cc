@@ -2,6 +2,8 @@
 
 #include "testing/testing.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_network.hh"
 #include "FN_multi_function_network_evaluation.hh"
@@ -65,6 +67,59 @@ TEST(multi_function_network, Test1)
   }
 }
 
+TEST(multi_function_network, LargeMask)
+{
+  /* Large masks are evaluated in chunks. */
+  CustomMF_SI_SO<int, int> add_10_fn("add 10", [](int value) { return value + 10; });
+  CustomMF_SI_SI_SO<int, int, int> add_fn("add", [](int a, int b) { return a + b; });
+
+  MFNetwork network;
+
+  MFNode &node1 = network.add_function(add_10_fn);
+  MFNode &node2 = network.add_function(add_fn);
+  MFOutputSocket &input_a = network.add_input("A", MFDataType::ForSingle<int>());
+  MFOutputSocket &input_b = network.add_input("B", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<int>());
+  network.add_link(input_a, node1.input(0));
+  network.add_link(node1.output(0), node2.input(0));
+  network.add_link(input_b, node2.input(1));
+  network.add_link(node2.output(0), output_socket);
+
+  MFNetworkEvaluator network_fn{{&input_a, &input_b}, {&output_socket}};
+
+  const int size = 100000;
+  Array<int> values(size);
+  for (const int i : values.index_range()) {
+    values[i] = i;
+  }
+  const int single_value = 5;
+
+  /* Only every third index, except for a contiguous block in the middle. */
+  Vector<int64_t> indices;
+  for (int64_t i = 0; i < size; i++) {
+    if (i % 3 == 0 || (i > 20000 && i < 40000)) {
+      indices.append(i);
+    }
+  }
+
+  Array<int> results(size, -1);
+  MFParamsBuilder params(network_fn, size);
+  params.add_readonly_single_input(values.as_span());
+  params.add_readonly_single_input(&single_value);
+  params.add_uninitialized_single_output(results.as_mutable_span());
+  MFContextBuilder context;
+  network_fn.call(indices.as_span(), params, context);
+
+  for (int64_t i = 0; i < size; i++) {
+    if (i % 3 == 0 || (i > 20000 && i < 40000)) {
+      EXPECT_EQ(results[i], i + 15);
+    }
+    else {
+      EXPECT_EQ(results[i], -1);
+    }
+  }
+}
+
 class ConcatVectorsFunction : public MultiFunction {
  public:
   ConcatVectorsFunction()
@@ -153,6 +208,58 @@ class CreateRangeFunction : public MultiFunction {
   }
 };
 
+TEST(multi_function_network, LongChain)
+{
+  /* Temporary buffers of earlier nodes are reused by later nodes. */
+  CustomMF_SI_SO<int, int> add_1_fn("add 1", [](int value) { return value + 1; });
+  CustomMF_SI_SO<int, float> to_float_fn("to float", [](int value) { return float(value); });
+  CustomMF_SI_SI_SO<float, int, float> add_fn("add", [](float a, int b) { return a + b; });
+
+  MFNetwork network;
+
+  MFOutputSocket &input_socket = network.add_input("Input", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<float>());
+
+  MFOutputSocket *int_socket = &input_socket;
+  MFOutputSocket *float_socket = nullptr;
+  for (int i = 0; i < 50; i++) {
+    MFNode &add_1_node = network.add_function(add_1_fn);
+    network.add_link(*int_socket, add_1_node.input(0));
+    int_socket = &add_1_node.output(0);
+
+    MFNode &to_float_node = network.add_function(to_float_fn);
+    network.add_link(*int_socket, to_float_node.input(0));
+    if (float_socket == nullptr) {
+      float_socket = &to_float_node.output(0);
+    }
+    else {
+      MFNode &add_node = network.add_function(add_fn);
+      network.add_link(*float_socket, add_node.input(0));
+      network.add_link(*int_socket, add_node.input(1));
+      float_socket = &add_node.output(0);
+    }
+  }
+  network.add_link(*float_socket, output_socket);
+
+  MFNetworkEvaluator network_fn{{&input_socket}, {&output_socket}};
+
+  Array<int> values = {0, 10, 20, 30};
+  Array<float> results(values.size(), -1.0f);
+
+  MFParamsBuilder params(network_fn, values.size());
+  params.add_readonly_single_input(values.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+  network_fn.call({0, 1, 3}, params, context);
+
+  /* The sum of `value + i` for i from 1 to 50. */
+  EXPECT_FLOAT_EQ(results[0], 1275.0f);
+  EXPECT_FLOAT_EQ(results[1], 1775.0f);
+  EXPECT_FLOAT_EQ(results[2], -1.0f);
+  EXPECT_FLOAT_EQ(results[3], 2775.0f);
+}
+
 TEST(multi_function_network, Test2)
 {
   CustomMF_SI_SO<int, int> add_3_fn("add 3", [](int value) { return value + 3; });
@@ -251,5 +358,46 @@ TEST(multi_function_network, Test2)
   }
 }
 
+TEST(multi_function_network, SharedBufferPool)
+{
+  CustomMF_SI_SO<int, int> add_10_fn("add 10", [](int value) { return value + 10; });
+  CustomMF_SI_SI_SO<int, int, int> multiply_fn("multiply", [](int a, int b) { return a * b; });
+
+  MFNetwork network;
+  MFNode &add_node = network.add_function(add_10_fn);
+  MFNode &multiply_node = network.add_function(multiply_fn);
+  MFOutputSocket &input_socket = network.add_input("Input", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<int>());
+  network.add_link(input_socket, add_node.input(0));
+  network.add_link(add_node.output(0), multiply_node.input(0));
+  network.add_link(add_node.output(0), multiply_node.input(1));
+  network.add_link(multiply_node.output(0), output_socket);
+
+  MFNetworkEvaluator network_fn{{&input_socket}, {&output_socket}};
+
+  MFBufferPool pool;
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+  for (int i = 0; i < 2; i++) {
+    {
+      Array<int> values = {1, 2, 3};
+      Array<int> results(values.size(), 0);
+
+      MFParamsBuilder params(network_fn, values.size());
+      params.add_readonly_single_input(values.as_span());
+      params.add_uninitialized_single_output(results.as_mutable_span());
+
+      MFContextBuilder context;
+      context.set_buffer_pool(pool);
+      network_fn.call(IndexRange(3), params, context);
+
+      EXPECT_EQ(results[0], 121);
+      EXPECT_EQ(results[1], 144);
+      EXPECT_EQ(results[2], 169);
+    }
+    /* The temporary buffer of the first evaluation is kept in the pool and reused afterwards. */
+    EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use + 1);
+  }
+}
+
 }  // namespace
 }  // namespace blender::fn::tests
@@ -249,6 +249,58 @@ TEST(multi_function, CustomMF_SI_SI_SO)
   EXPECT_EQ(outputs[3], 90);
 }
 
+TEST(multi_function, CustomMF_SI_SI_SO_Devirtualized)
+{
+  CustomMF_SI_SI_SO<int, int, int> fn("add", [](int a, int b) { return a + b; });
+
+  Array<int> values_a = {1, 2, 3, 4};
+  Array<int> values_b = {10, 20, 30, 40};
+  int value_a = 5;
+  int value_b = 50;
+  MFContextBuilder context;
+
+  {
+    /* All inputs are single values. */
+    Array<int> outputs(4, -1);
+    MFParamsBuilder params(fn, outputs.size());
+    params.add_readonly_single_input(&value_a);
+    params.add_readonly_single_input(&value_b);
+    params.add_uninitialized_single_output(outputs.as_mutable_span());
+    fn.call({0, 2, 3}, params, context);
+    EXPECT_EQ(outputs[0], 55);
+    EXPECT_EQ(outputs[1], -1);
+    EXPECT_EQ(outputs[2], 55);
+    EXPECT_EQ(outputs[3], 55);
+  }
+  {
+    /* All inputs are arrays. */
+    Array<int> outputs(4, -1);
+    MFParamsBuilder params(fn, outputs.size());
+    params.add_readonly_single_input(values_a.as_span());
+    params.add_readonly_single_input(values_b.as_span());
+    params.add_uninitialized_single_output(outputs.as_mutable_span());
+    fn.call(IndexRange(4), params, context);
+    EXPECT_EQ(outputs[0], 11);
+    EXPECT_EQ(outputs[1], 22);
+    EXPECT_EQ(outputs[2], 33);
+    EXPECT_EQ(outputs[3], 44);
+  }
+  {
+    /* Mixed inputs use the generic code path. */
+    Array<const int *> pointers_b = {&values_b[3], &values_b[2], &values_b[1], &values_b[0]};
+    Array<int> outputs(4, -1);
+    MFParamsBuilder params(fn, outputs.size());
+    params.add_readonly_single_input(&value_a);
+    params.add_readonly_single_input(GVSpan(VSpan<int>(pointers_b.as_span())));
+    params.add_uninitialized_single_output(outputs.as_mutable_span());
+    fn.call({1, 3}, params, context);
+    EXPECT_EQ(outputs[0], -1);
+    EXPECT_EQ(outputs[1], 35);
+    EXPECT_EQ(outputs[2], -1);
+    EXPECT_EQ(outputs[3], 15);
+  }
+}
+
 TEST(multi_function, CustomMF_SI_SI_SI_SO)
 {
   CustomMF_SI_SI_SI_SO<int, std::string, bool, uint> fn{
@@ -383,5 +435,25 @@ TEST(multi_function, CustomMF_Convert)
   EXPECT_EQ(outputs[2], 9);
 }
 
+TEST(multi_function, BufferPool)
+{
+  MFBufferPool pool;
+  void *buffer1 = pool.allocate(64, 8);
+  void *buffer2 = pool.allocate(64, 8);
+  EXPECT_NE(buffer1, buffer2);
+
+  pool.deallocate({buffer1}, 64, 8);
+  /* Buffers with a different size or alignment are not reused. */
+  void *buffer3 = pool.allocate(32, 8);
+  void *buffer4 = pool.allocate(64, 16);
+  EXPECT_NE(buffer3, buffer1);
+  EXPECT_NE(buffer4, buffer1);
+  EXPECT_EQ(pool.allocate(64, 8), buffer1);
+
+  pool.deallocate({buffer1, buffer2}, 64, 8);
+  pool.deallocate({buffer3}, 32, 8);
+  pool.deallocate({buffer4}, 64, 16);
+}
+
 }  // namespace
 }  // namespace blender::fn::tests
@@ -0,0 +1,140 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+
+#include "FN_cpp_type.hh"
+#include "FN_multi_function_builder.hh"
+#include "FN_multi_function_network.hh"
+#include "FN_multi_function_network_evaluation.hh"
+
+#include "PIL_time_utildefines.h"
+
+/* Standard workloads for the functions framework, to compare their performance before and after
+ * a change. */
+
+#define ELEMENTS_NUM 1000000
+
+namespace blender::fn::tests {
+
+TEST(functions_performance, CPPTypeMoveFloat)
+{
+  const CPPType &type = CPPType::get<float>();
+  Array<float> src(ELEMENTS_NUM, 1.0f);
+  Array<float> dst(ELEMENTS_NUM, 0.0f);
+
+  TIMEIT_START(cpp_type_move_float);
+  for (int repeat = 0; repeat < 100; repeat++) {
+    type.move_to_initialized_n(src.data(), dst.data(), ELEMENTS_NUM);
+  }
+  TIMEIT_END(cpp_type_move_float);
+  EXPECT_EQ(dst[ELEMENTS_NUM - 1], 1.0f);
+}
+
+TEST(functions_performance, CPPTypeMoveIndicesFloat)
+{
+  const CPPType &type = CPPType::get<float>();
+  Array<float> src(ELEMENTS_NUM, 1.0f);
+  Array<float> dst(ELEMENTS_NUM, 0.0f);
+  Vector<int64_t> indices;
+  for (int64_t i = 0; i < ELEMENTS_NUM; i += 2) {
+    indices.append(i);
+  }
+
+  TIMEIT_START(cpp_type_move_indices_float);
+  for (int repeat = 0; repeat < 100; repeat++) {
+    type.move_to_initialized_indices(src.data(), dst.data(), indices.as_span());
+  }
+  TIMEIT_END(cpp_type_move_indices_float);
+  EXPECT_EQ(dst[0], 1.0f);
+  EXPECT_EQ(dst[1], 0.0f);
+}
+
+TEST(functions_performance, CPPTypeMoveString)
+{
+  const CPPType &type = CPPType::get<std::string>();
+  Array<std::string> src(ELEMENTS_NUM, "a string that does not fit in the inline buffer");
+  Array<std::string> dst(ELEMENTS_NUM);
+
+  TIMEIT_START(cpp_type_move_string);
+  for (int repeat = 0; repeat < 10; repeat++) {
+    type.move_to_initialized_n(src.data(), dst.data(), ELEMENTS_NUM);
+    type.move_to_initialized_n(dst.data(), src.data(), ELEMENTS_NUM);
+  }
+  TIMEIT_END(cpp_type_move_string);
+  EXPECT_EQ(src[0], "a string that does not fit in the inline buffer");
+}
+
+TEST(functions_performance, MultiFunctionNetworkEvaluate)
+{
+  /* A chain of cheap functions, so the overhead of the evaluator dominates. */
+  CustomMF_SI_SO<float, float> add_fn("add 1", [](float value) { return value + 1.0f; });
+  CustomMF_SI_SI_SO<float, float, float> multiply_fn("multiply",
+                                                     [](float a, float b) { return a * b; });
+
+  MFNetwork network;
+  MFOutputSocket &input_socket = network.add_input("Input", MFDataType::ForSingle<float>());
+  MFOutputSocket *previous = &input_socket;
+  for (int i = 0; i < 10; i++) {
+    MFNode &add_node = network.add_function(add_fn);
+    MFNode &multiply_node = network.add_function(multiply_fn);
+    network.add_link(*previous, add_node.input(0));
+    network.add_link(add_node.output(0), multiply_node.input(0));
+    network.add_link(*previous, multiply_node.input(1));
+    previous = &multiply_node.output(0);
+  }
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<float>());
+  network.add_link(*previous, output_socket);
+
+  MFNetworkEvaluator network_fn{{&input_socket}, {&output_socket}};
+
+  Array<float> values(ELEMENTS_NUM, 0.0f);
+  Array<float> results(ELEMENTS_NUM, 0.0f);
+
+  TIMEIT_START(multi_function_network_evaluate);
+  for (int repeat = 0; repeat < 10; repeat++) {
+    MFParamsBuilder params(network_fn, ELEMENTS_NUM);
+    params.add_readonly_single_input(values.as_span());
+    params.add_uninitialized_single_output(results.as_mutable_span());
+    MFContextBuilder context;
+    network_fn.call(IndexRange(ELEMENTS_NUM), params, context);
+  }
+  TIMEIT_END(multi_function_network_evaluate);
+  EXPECT_EQ(results[0], 0.0f);
+}
+
+TEST(functions_performance, MultiFunctionNetworkEvaluateSingleValue)
+{
+  /* Single values are only computed once, whatever the size of the mask. */
+  CustomMF_SI_SO<float, float> add_fn("add 1", [](float value) { return value + 1.0f; });
+
+  MFNetwork network;
+  MFOutputSocket &input_socket = network.add_input("Input", MFDataType::ForSingle<float>());
+  MFOutputSocket *previous = &input_socket;
+  for (int i = 0; i < 20; i++) {
+    MFNode &add_node = network.add_function(add_fn);
+    network.add_link(*previous, add_node.input(0));
+    previous = &add_node.output(0);
+  }
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<float>());
+  network.add_link(*previous, output_socket);
+
+  MFNetworkEvaluator network_fn{{&input_socket}, {&output_socket}};
+
+  const float value = 0.0f;
+  Array<float> results(ELEMENTS_NUM, 0.0f);
+
+  TIMEIT_START(multi_function_network_evaluate_single_value);
+  for (int repeat = 0; repeat < 10; repeat++) {
+    MFParamsBuilder params(network_fn, ELEMENTS_NUM);
+    params.add_readonly_single_input(&value);
+    params.add_uninitialized_single_output(results.as_mutable_span());
+    MFContextBuilder context;
+    network_fn.call(IndexRange(ELEMENTS_NUM), params, context);
+  }
+  TIMEIT_END(multi_function_network_evaluate_single_value);
+  EXPECT_EQ(results[ELEMENTS_NUM - 1], 20.0f);
+}
+
+}  // namespace blender::fn::tests
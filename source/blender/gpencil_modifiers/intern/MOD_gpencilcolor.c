@@ -236,7 +236,8 @@ GpencilModifierTypeInfo modifierType_Gpencil_Color = {
     /* structName */ "ColorGpencilModifierData",
     /* structSize */ sizeof(ColorGpencilModifierData),
     /* type */ eGpencilModifierTypeType_Gpencil,
-    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode,
+    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode |
+        eGpencilModifierTypeFlag_ThreadSafeDeform,
 
     /* copyData */ copyData,
 
@@ -357,7 +357,8 @@ GpencilModifierTypeInfo modifierType_Gpencil_Noise = {
     /* structName */ "NoiseGpencilModifierData",
     /* structSize */ sizeof(NoiseGpencilModifierData),
     /* type */ eGpencilModifierTypeType_Gpencil,
-    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode,
+    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode |
+        eGpencilModifierTypeFlag_ThreadSafeDeform,
 
     /* copyData */ copyData,
 
@@ -228,7 +228,8 @@ GpencilModifierTypeInfo modifierType_Gpencil_Smooth = {
     /* structName */ "SmoothGpencilModifierData",
     /* structSize */ sizeof(SmoothGpencilModifierData),
     /* type */ eGpencilModifierTypeType_Gpencil,
-    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode,
+    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode |
+        eGpencilModifierTypeFlag_ThreadSafeDeform,
 
     /* copyData */ copyData,
 
@@ -221,7 +221,8 @@ GpencilModifierTypeInfo modifierType_Gpencil_Thick = {
     /* structName */ "ThickGpencilModifierData",
     /* structSize */ sizeof(ThickGpencilModifierData),
     /* type */ eGpencilModifierTypeType_Gpencil,
-    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode,
+    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode |
+        eGpencilModifierTypeFlag_ThreadSafeDeform,
 
     /* copyData */ copyData,
 
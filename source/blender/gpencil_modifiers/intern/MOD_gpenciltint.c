@@ -383,7 +383,8 @@ GpencilModifierTypeInfo modifierType_Gpencil_Tint = {
     /* structName */ "TintGpencilModifierData",
     /* structSize */ sizeof(TintGpencilModifierData),
     /* type */ eGpencilModifierTypeType_Gpencil,
-    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode,
+    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode |
+        eGpencilModifierTypeFlag_ThreadSafeDeform,
 
     /* copyData */ copyData,
 
@@ -0,0 +1,57 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup gpu
+ *
+ * GPU timer queries. The results of a pool can only be read once the GPU is done with the
+ * commands issued between the queries. Reading them right away stalls until then, so reading
+ * the results of the previous frame is preferable.
+ */
+
+#pragma once
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque type hiding blender::gpu::QueryPool. */
+typedef struct GPUQueryPool GPUQueryPool;
+
+GPUQueryPool *GPU_query_pool_timer_create(void);
+void GPU_query_pool_free(GPUQueryPool *pool);
+
+/** Start issuing queries from the first index again. */
+void GPU_query_pool_reset(GPUQueryPool *pool);
+
+/** Queries cannot be nested. Indices are given in the order of the calls to begin. */
+void GPU_query_begin(GPUQueryPool *pool);
+void GPU_query_end(GPUQueryPool *pool);
+
+/**
+ * Fill \a r_values with the time elapsed in nanoseconds for each query issued since the last
+ * reset. \a values_len must be the number of issued queries.
+ */
+void GPU_query_pool_time_result_get(GPUQueryPool *pool, uint64_t *r_values, int values_len);
+
+#ifdef __cplusplus
+}
+#endif
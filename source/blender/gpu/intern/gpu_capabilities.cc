@@ -112,6 +112,16 @@ bool GPU_shader_image_load_store_support(void)
   return GCaps.shader_image_load_store_support;
 }
 
+bool GPU_compute_shader_support(void)
+{
+  return GCaps.compute_shader_support;
+}
+
+bool GPU_shader_storage_buffer_objects_support(void)
+{
+  return GCaps.shader_storage_buffer_objects_support;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
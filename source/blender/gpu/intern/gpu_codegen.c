@@ -921,6 +921,7 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
     pass->geometrycode = geometrycode;
     pass->defines = (defines) ? BLI_strdup(defines) : NULL;
     pass->compiled = false;
+    BLI_mutex_init(&pass->compile_lock);
 
     BLI_spin_lock(&pass_cache_spin);
     if (pass_hash != NULL) {
@@ -1025,6 +1026,7 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
 bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
   bool success = true;
+  BLI_mutex_lock(&pass->compile_lock);
   if (!pass->compiled) {
     GPUShader *shader = GPU_shader_create(
         pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
@@ -1042,6 +1044,7 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
     pass->shader = shader;
     pass->compiled = true;
   }
+  BLI_mutex_unlock(&pass->compile_lock);
 
   return success;
 }
@@ -1062,6 +1065,7 @@ static void gpu_pass_free(GPUPass *pass)
   MEM_SAFE_FREE(pass->geometrycode);
   MEM_SAFE_FREE(pass->vertexcode);
   MEM_SAFE_FREE(pass->defines);
+  BLI_mutex_end(&pass->compile_lock);
   MEM_freeN(pass);
 }
 
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include "BLI_threads.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -44,6 +46,8 @@ typedef struct GPUPass {
   uint refcount; /* Orphaned GPUPasses gets freed by the garbage collector. */
   uint32_t hash; /* Identity hash generated from all GLSL code. */
   bool compiled; /* Did we already tried to compile the attached GPUShader. */
+  /* Passes are shared between materials that can be compiled on different threads. */
+  ThreadMutex compile_lock;
 } GPUPass;
 
 /* Pass */
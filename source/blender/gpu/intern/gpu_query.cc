@@ -21,8 +21,57 @@
  * \ingroup gpu
  */
 
+#include "gpu_backend.hh"
 #include "gpu_query.hh"
 
+#include "GPU_query.h"
+
 using namespace blender::gpu;
 
-/* TODO(fclem): Make the associated C-API to use inside DRW profiler. */
+/* Syntactic sugar. */
+static inline GPUQueryPool *wrap(QueryPool *pool)
+{
+  return reinterpret_cast<GPUQueryPool *>(pool);
+}
+static inline QueryPool *unwrap(GPUQueryPool *pool)
+{
+  return reinterpret_cast<QueryPool *>(pool);
+}
+
+/* -------------------------------------------------------------------- */
+/** \name C-API
+ * \{ */
+
+GPUQueryPool *GPU_query_pool_timer_create(void)
+{
+  QueryPool *pool = GPUBackend::get()->querypool_alloc();
+  pool->init(GPU_QUERY_TIME_ELAPSED);
+  return wrap(pool);
+}
+
+void GPU_query_pool_free(GPUQueryPool *pool)
+{
+  delete unwrap(pool);
+}
+
+void GPU_query_pool_reset(GPUQueryPool *pool)
+{
+  unwrap(pool)->reset();
+}
+
+void GPU_query_begin(GPUQueryPool *pool)
+{
+  unwrap(pool)->begin_query();
+}
+
+void GPU_query_end(GPUQueryPool *pool)
+{
+  unwrap(pool)->end_query();
+}
+
+void GPU_query_pool_time_result_get(GPUQueryPool *pool, uint64_t *r_values, int values_len)
+{
+  unwrap(pool)->get_time_result(blender::MutableSpan<uint64_t>(r_values, values_len));
+}
+
+/** \} */
@@ -29,6 +29,7 @@ namespace blender::gpu {
 
 typedef enum GPUQueryType {
   GPU_QUERY_OCCLUSION = 0,
+  GPU_QUERY_TIME_ELAPSED = 1,
 } GPUQueryType;
 
 class QueryPool {
@@ -41,6 +42,12 @@ class QueryPool {
    */
   virtual void init(GPUQueryType type) = 0;
 
+  /**
+   * Start issuing queries from the first index again, reusing the query objects. The results of
+   * the previously issued queries are not available anymore.
+   */
+  virtual void reset(void) = 0;
+
   /**
    * Will start and end the query at this index inside the pool.
    * The pool will resize automatically.
@@ -54,6 +61,12 @@ class QueryPool {
    * drawn.
    */
   virtual void get_occlusion_result(MutableSpan<uint32_t> r_values) = 0;
+
+  /**
+   * Same as #get_occlusion_result for #GPU_QUERY_TIME_ELAPSED pools.
+   * Result for each query is the GPU time elapsed between its begin and end, in nanoseconds.
+   */
+  virtual void get_time_result(MutableSpan<uint64_t> r_values) = 0;
 };
 
 }  // namespace blender::gpu
@@ -355,6 +355,38 @@ GPUShader *GPU_shader_create_ex(const char *vertcode,
   return wrap(shader);
 }
 
+/* Compute shaders are only available when #GPU_compute_shader_support() is true. */
+GPUShader *GPU_shader_create_compute(const char *computecode,
+                                     const char *libcode,
+                                     const char *defines,
+                                     const char *shname)
+{
+  BLI_assert(computecode != nullptr);
+  BLI_assert(GPU_compute_shader_support());
+
+  Shader *shader = GPUBackend::get()->shader_alloc(shname);
+
+  Vector<const char *> sources;
+  standard_defines(sources);
+  sources.append("#define GPU_COMPUTE_SHADER\n");
+  if (defines) {
+    sources.append(defines);
+  }
+  if (libcode) {
+    sources.append(libcode);
+  }
+  sources.append(computecode);
+
+  shader->compute_shader_from_glsl(sources);
+
+  if (!shader->finalize()) {
+    delete shader;
+    return nullptr;
+  };
+
+  return wrap(shader);
+}
+
 void GPU_shader_free(GPUShader *shader)
 {
   delete unwrap(shader);
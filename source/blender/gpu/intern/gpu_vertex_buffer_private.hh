@@ -96,6 +96,7 @@ class VertBuf {
   }
 
   virtual void update_sub(uint start, uint len, void *data) = 0;
+  virtual void bind_as_ssbo(uint binding) = 0;
 
  protected:
   virtual void acquire_data(void) = 0;
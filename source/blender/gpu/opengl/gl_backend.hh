@@ -71,6 +71,12 @@ class GLBackend : public GPUBackend {
     GLTexture::samplers_update();
   };
 
+  void compute_dispatch(int groups_x_len, int groups_y_len, int groups_z_len) override
+  {
+    GLContext::state_manager_active_get()->apply_state();
+    glDispatchCompute(groups_x_len, groups_y_len, groups_z_len);
+  }
+
   Context *context_alloc(void *ghost_window) override
   {
     return new GLContext(ghost_window, shared_orphan_list_);
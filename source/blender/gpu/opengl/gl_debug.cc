@@ -299,6 +299,7 @@ static const char *to_str_prefix(GLenum type)
     case GL_FRAGMENT_SHADER:
     case GL_GEOMETRY_SHADER:
     case GL_VERTEX_SHADER:
+    case GL_COMPUTE_SHADER:
     case GL_SHADER:
     case GL_PROGRAM:
       return "SHD-";
@@ -327,6 +328,8 @@ static const char *to_str_suffix(GLenum type)
       return "-Geom";
     case GL_VERTEX_SHADER:
       return "-Vert";
+    case GL_COMPUTE_SHADER:
+      return "-Comp";
     default:
       return "";
   }
@@ -338,7 +341,7 @@ void object_label(GLenum type, GLuint object, const char *name)
     char label[64];
     SNPRINTF(label, "%s%s%s", to_str_prefix(type), name, to_str_suffix(type));
     /* Small convenience for caller. */
-    if (ELEM(type, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER, GL_VERTEX_SHADER)) {
+    if (ELEM(type, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER, GL_VERTEX_SHADER, GL_COMPUTE_SHADER)) {
       type = GL_SHADER;
     }
     if (ELEM(type, GL_UNIFORM_BUFFER)) {
@@ -23,6 +23,9 @@
  * Mimics old style opengl immediate mode drawing.
  */
 
+#include "BLI_math_base.h"
+#include "BLI_utildefines.h"
+
 #include "BKE_global.h"
 
 #include "gpu_context_private.hh"
@@ -48,14 +51,21 @@ GLImmediate::GLImmediate()
   glBindVertexArray(vao_id_); /* Necessary for glObjectLabel. */
 
   buffer.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glGenBuffers(1, &buffer.vbo_id);
-  glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, buffer.buffer_size, nullptr, GL_DYNAMIC_DRAW);
-
   buffer_strict.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glGenBuffers(1, &buffer_strict.vbo_id);
-  glBindBuffer(GL_ARRAY_BUFFER, buffer_strict.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, buffer_strict.buffer_size, nullptr, GL_DYNAMIC_DRAW);
+
+  if (GLContext::buffer_storage_support) {
+    buffer_storage_create(buffer);
+    buffer_storage_create(buffer_strict);
+  }
+  else {
+    glGenBuffers(1, &buffer.vbo_id);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo_id);
+    glBufferData(GL_ARRAY_BUFFER, buffer.buffer_size, nullptr, GL_DYNAMIC_DRAW);
+
+    glGenBuffers(1, &buffer_strict.vbo_id);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer_strict.vbo_id);
+    glBufferData(GL_ARRAY_BUFFER, buffer_strict.buffer_size, nullptr, GL_DYNAMIC_DRAW);
+  }
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
@@ -69,8 +79,14 @@ GLImmediate::~GLImmediate()
 {
   glDeleteVertexArrays(1, &vao_id_);
 
-  glDeleteBuffers(1, &buffer.vbo_id);
-  glDeleteBuffers(1, &buffer_strict.vbo_id);
+  if (GLContext::buffer_storage_support) {
+    buffer_storage_free(buffer);
+    buffer_storage_free(buffer_strict);
+  }
+  else {
+    glDeleteBuffers(1, &buffer.vbo_id);
+    glDeleteBuffers(1, &buffer_strict.vbo_id);
+  }
 }
 
 /** \} */
@@ -88,6 +104,10 @@ uchar *GLImmediate::begin()
 
   GL_CHECK_RESOURCES("Immediate");
 
+  if (GLContext::buffer_storage_support) {
+    return begin_persistent(bytes_needed);
+  }
+
   glBindBuffer(GL_ARRAY_BUFFER, vbo_id());
 
   bool recreate_buffer = false;
@@ -147,9 +167,14 @@ void GLImmediate::end()
       /* unused buffer bytes are available to the next immBegin */
     }
     /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
-    glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    if (!GLContext::buffer_storage_support) {
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    }
+  }
+  /* The persistent mapping is coherent, writes are visible to the GPU without unmapping. */
+  if (!GLContext::buffer_storage_support) {
+    glUnmapBuffer(GL_ARRAY_BUFFER);
   }
-  glUnmapBuffer(GL_ARRAY_BUFFER);
 
   if (vertex_len > 0) {
     GLContext::get()->state_manager->apply_state();
@@ -181,4 +206,131 @@ void GLImmediate::end()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Persistently mapped ring buffer
+ *
+ * When buffer storage is available, the buffers are mapped once and written as rings. This
+ * avoids the map / unmap round-trip and the buffer orphaning of every draw call.
+ * The ring is split in segments and a fence is inserted when the writing leaves a segment.
+ * A segment is only written again after its fence signaled, so the GPU never reads data that
+ * is being overwritten.
+ * \{ */
+
+void GLImmediate::buffer_storage_create(Buffer &buf)
+{
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  glGenBuffers(1, &buf.vbo_id);
+  glBindBuffer(GL_ARRAY_BUFFER, buf.vbo_id);
+  glBufferStorage(GL_ARRAY_BUFFER, buf.buffer_size, nullptr, flags);
+  buf.mapped_data = (uchar *)glMapBufferRange(GL_ARRAY_BUFFER, 0, buf.buffer_size, flags);
+  BLI_assert(buf.mapped_data != nullptr);
+
+  buf.buffer_offset = 0;
+  buf.segment_first_unfenced = 0;
+  buf.segment_last = 0;
+}
+
+void GLImmediate::buffer_storage_free(Buffer &buf)
+{
+  for (GLsync &fence : buf.segment_fences) {
+    if (fence != nullptr) {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, buf.vbo_id);
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  /* Pending draw calls keep the storage alive until they are done. */
+  glDeleteBuffers(1, &buf.vbo_id);
+  buf.vbo_id = 0;
+  buf.mapped_data = nullptr;
+}
+
+static void segment_fence_wait(GLsync &fence)
+{
+  if (fence == nullptr) {
+    return;
+  }
+  /* Flush on the first wait in case the fence was not submitted yet. */
+  GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+  while (true) {
+    /* One second timeout. */
+    const GLenum result = glClientWaitSync(fence, flags, 1000000000);
+    if (ELEM(result, GL_ALREADY_SIGNALED, GL_CONDITION_SATISFIED, GL_WAIT_FAILED)) {
+      break;
+    }
+    flags = 0;
+  }
+  glDeleteSync(fence);
+  fence = nullptr;
+}
+
+/**
+ * Fence the segments that were written since the last insertion if the new range starts in
+ * another segment, and wait until the segments covered by the new range are not in use anymore.
+ */
+void GLImmediate::buffer_segments_sync(Buffer &buf, size_t offset, size_t bytes_needed)
+{
+  const size_t segment_size = buf.buffer_size / IMM_BUFFER_SEGMENTS_LEN;
+  const size_t range_last = offset + max_zz(bytes_needed, 1) - 1;
+  const int segment_first = min_ii((int)(offset / segment_size), IMM_BUFFER_SEGMENTS_LEN - 1);
+  const int segment_last = min_ii((int)(range_last / segment_size), IMM_BUFFER_SEGMENTS_LEN - 1);
+
+  if (segment_first != buf.segment_last) {
+    /* All draw calls reading the previous segments have been issued. */
+    for (int i = buf.segment_first_unfenced; i <= buf.segment_last; i++) {
+      BLI_assert(buf.segment_fences[i] == nullptr);
+      buf.segment_fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    buf.segment_first_unfenced = segment_first;
+  }
+  for (int i = segment_first; i <= segment_last; i++) {
+    segment_fence_wait(buf.segment_fences[i]);
+  }
+  buf.segment_last = segment_last;
+}
+
+uchar *GLImmediate::begin_persistent(size_t bytes_needed)
+{
+  Buffer &buf = active_buffer();
+
+  size_t buffer_size_new = buf.buffer_size;
+  if (bytes_needed > buf.buffer_size) {
+    /* expand the internal buffer */
+    buffer_size_new = bytes_needed;
+  }
+  else if (bytes_needed < DEFAULT_INTERNAL_BUFFER_SIZE &&
+           buf.buffer_size > DEFAULT_INTERNAL_BUFFER_SIZE) {
+    /* shrink the internal buffer */
+    buffer_size_new = DEFAULT_INTERNAL_BUFFER_SIZE;
+  }
+
+  if (buffer_size_new != buf.buffer_size) {
+    /* Immutable storage can't be resized, replace the whole buffer. */
+    buffer_storage_free(buf);
+    buf.buffer_size = buffer_size_new;
+    buffer_storage_create(buf);
+  }
+  else {
+    glBindBuffer(GL_ARRAY_BUFFER, buf.vbo_id);
+  }
+
+  /* ensure vertex data is aligned */
+  const uint pre_padding = padding(buf.buffer_offset, vertex_format.stride);
+  size_t offset = buf.buffer_offset + pre_padding;
+  if (offset + bytes_needed > buf.buffer_size) {
+    /* Wrap around to the start of the ring. */
+    offset = 0;
+  }
+
+  buffer_segments_sync(buf, offset, bytes_needed);
+
+  buf.buffer_offset = offset;
+  bytes_mapped_ = bytes_needed;
+  return buf.mapped_data + offset;
+}
+
+/** \} */
+
 }  // namespace blender::gpu
@@ -35,19 +35,31 @@ namespace blender::gpu {
 
 /* size of internal buffer */
 #define DEFAULT_INTERNAL_BUFFER_SIZE (4 * 1024 * 1024)
+/* Number of fenced segments of a persistently mapped buffer. */
+#define IMM_BUFFER_SEGMENTS_LEN 4
 
 class GLImmediate : public Immediate {
  private:
   /* Use two buffers for strict and unstrict vertex count to
    * avoid some huge driver slowdown (see T70922).
    * Use accessor functions to get / modify. */
-  struct {
+  struct Buffer {
     /** Opengl Handle for this buffer. */
     GLuint vbo_id = 0;
     /** Offset of the mapped data in data. */
     size_t buffer_offset = 0;
     /** Size of the whole buffer in bytes. */
     size_t buffer_size = 0;
+    /**
+     * Persistent mapping of the whole buffer. Only used when buffer storage is supported, the
+     * buffer is then used as a ring and never unmapped during drawing.
+     */
+    uchar *mapped_data = nullptr;
+    /** Fences protecting each segment of the ring from being overwritten while still in use. */
+    GLsync segment_fences[IMM_BUFFER_SEGMENTS_LEN] = {nullptr};
+    /** Segments written since the last fence insertion. */
+    int segment_first_unfenced = 0;
+    int segment_last = 0;
   } buffer, buffer_strict;
   /** Size in bytes of the mapped region. */
   size_t bytes_mapped_ = 0;
@@ -62,6 +74,17 @@ class GLImmediate : public Immediate {
   void end(void) override;
 
  private:
+  static void buffer_storage_create(Buffer &buf);
+  static void buffer_storage_free(Buffer &buf);
+  static void buffer_segments_sync(Buffer &buf, size_t offset, size_t bytes_needed);
+
+  uchar *begin_persistent(size_t bytes_needed);
+
+  Buffer &active_buffer(void)
+  {
+    return strict_vertex_len ? buffer_strict : buffer;
+  };
+
   GLuint &vbo_id(void)
   {
     return strict_vertex_len ? buffer_strict.vbo_id : buffer.vbo_id;
@@ -41,12 +41,11 @@ void GLQueryPool::init(GPUQueryType type)
   query_issued_ = 0;
 }
 
-#if 0 /* TODO to avoid realloc of permanent query pool. */
-void GLQueryPool::reset(GPUQueryType type)
+void GLQueryPool::reset()
 {
-  initialized_ = false;
+  BLI_assert(initialized_);
+  query_issued_ = 0;
 }
-#endif
 
 void GLQueryPool::begin_query()
 {
@@ -75,4 +74,15 @@ void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+void GLQueryPool::get_time_result(MutableSpan<uint64_t> r_values)
+{
+  BLI_assert(type_ == GPU_QUERY_TIME_ELAPSED);
+  BLI_assert(r_values.size() == query_issued_);
+
+  for (int i = 0; i < query_issued_; i++) {
+    /* Note: This is a sync point. */
+    glGetQueryObjectui64v(query_ids_[i], GL_QUERY_RESULT, &r_values[i]);
+  }
+}
+
 }  // namespace blender::gpu
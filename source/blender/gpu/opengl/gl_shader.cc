@@ -21,11 +21,15 @@
  * \ingroup gpu
  */
 
-#include "BKE_global.h"
-
+#include "BLI_fileops.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
+#include "BKE_appdir.h"
+#include "BKE_global.h"
+
 #include "GPU_platform.h"
 
 #include "gl_backend.hh"
@@ -63,6 +67,7 @@ GLShader::~GLShader()
   glDeleteShader(vert_shader_);
   glDeleteShader(geom_shader_);
   glDeleteShader(frag_shader_);
+  glDeleteShader(compute_shader_);
   glDeleteProgram(shader_program_);
 }
 
@@ -111,6 +116,27 @@ char *GLShader::glsl_patch_get()
   return patch;
 }
 
+/* Compute shaders need GLSL 4.30, which also has shader storage buffers. */
+char *GLShader::glsl_patch_compute_get()
+{
+  /** Used for shader patching. Init once. */
+  static char patch[512] = "\0";
+  if (patch[0] != '\0') {
+    return patch;
+  }
+
+  size_t slen = 0;
+  /* Version need to go first. */
+  STR_CONCAT(patch, slen, "#version 430\n");
+
+  /* Derivative sign can change depending on implementation. */
+  STR_CONCATF(patch, slen, "#define DFDX_SIGN %1.1f\n", GLContext::derivative_signs[0]);
+  STR_CONCATF(patch, slen, "#define DFDY_SIGN %1.1f\n", GLContext::derivative_signs[1]);
+
+  BLI_assert(slen < sizeof(patch));
+  return patch;
+}
+
 /* Create, compile and attach the shader stage to the shader program. */
 GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
 {
@@ -121,7 +147,7 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   }
 
   /* Patch the shader code using the first source slot. */
-  sources[0] = glsl_patch_get();
+  sources[0] = (gl_stage == GL_COMPUTE_SHADER) ? glsl_patch_compute_get() : glsl_patch_get();
 
   glShaderSource(shader, sources.size(), sources.data(), nullptr);
   glCompileShader(shader);
@@ -142,6 +168,9 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
         case GL_FRAGMENT_SHADER:
           this->print_log(sources, log, "FragShader", !status);
           break;
+        case GL_COMPUTE_SHADER:
+          this->print_log(sources, log, "ComputeShader", !status);
+          break;
       }
     }
   }
@@ -157,27 +186,99 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   return shader;
 }
 
+/* Keep the stage sources for #finalize, skipping the patch slot. */
+void GLShader::stage_source_store(std::string &r_source, Span<const char *> sources)
+{
+  for (const char *source : sources.drop_front(1)) {
+    r_source += source;
+  }
+}
+
+bool GLShader::stages_create_from_stored_sources()
+{
+  /* The first slot is replaced by the patch in #create_shader_stage. */
+  const char *sources_array[2] = {nullptr, nullptr};
+  MutableSpan<const char *> sources(sources_array, 2);
+  if (!vert_source_.empty()) {
+    sources[1] = vert_source_.c_str();
+    vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
+  }
+  if (!geom_source_.empty()) {
+    sources[1] = geom_source_.c_str();
+    geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
+  }
+  if (!frag_source_.empty()) {
+    sources[1] = frag_source_.c_str();
+    frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
+  }
+  if (!compute_source_.empty()) {
+    sources[1] = compute_source_.c_str();
+    compute_shader_ = this->create_shader_stage(GL_COMPUTE_SHADER, sources);
+  }
+  return !compilation_failed_;
+}
+
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
+  if (GLContext::program_binary_support) {
+    this->stage_source_store(vert_source_, sources);
+    return;
+  }
   vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
 }
 
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
+  if (GLContext::program_binary_support) {
+    this->stage_source_store(geom_source_, sources);
+    return;
+  }
   geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
 }
 
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
+  if (GLContext::program_binary_support) {
+    this->stage_source_store(frag_source_, sources);
+    return;
+  }
   frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
 }
 
+void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
+{
+  if (GLContext::program_binary_support) {
+    this->stage_source_store(compute_source_, sources);
+    return;
+  }
+  compute_shader_ = this->create_shader_stage(GL_COMPUTE_SHADER, sources);
+}
+
 bool GLShader::finalize()
 {
+  const bool use_cache = this->program_cache_use();
+  char cache_key[33];
+  if (use_cache) {
+    this->program_cache_key_get(cache_key);
+    if (this->program_cache_load(cache_key)) {
+      vert_source_ = geom_source_ = frag_source_ = compute_source_ = std::string();
+      interface = new GLShaderInterface(shader_program_);
+      return true;
+    }
+  }
+
+  if (GLContext::program_binary_support) {
+    this->stages_create_from_stored_sources();
+    vert_source_ = geom_source_ = frag_source_ = compute_source_ = std::string();
+  }
+
   if (compilation_failed_) {
     return false;
   }
 
+  if (use_cache) {
+    glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
   glLinkProgram(shader_program_);
 
   GLint status;
@@ -190,6 +291,10 @@ bool GLShader::finalize()
     return false;
   }
 
+  if (use_cache) {
+    this->program_cache_save(cache_key);
+  }
+
   interface = new GLShaderInterface(shader_program_);
 
   return true;
@@ -197,6 +302,114 @@ bool GLShader::finalize()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program binary cache
+ *
+ * Linked programs are stored in the user data-files folder, keyed by the hash of their sources
+ * and of the driver identification. The next run loads them with `glProgramBinary` instead of
+ * compiling and linking the stages. A binary rejected by the driver (after a driver update for
+ * instance) is compiled again and overwritten.
+ * \{ */
+
+static char program_cache_dir[FILE_MAX] = "";
+
+void GLShader::program_cache_init()
+{
+  if (!GLContext::program_binary_support) {
+    return;
+  }
+  const char *dir = BKE_appdir_folder_id_create(BLENDER_USER_DATAFILES, "shader_cache");
+  if (dir == nullptr) {
+    GLContext::program_binary_support = false;
+    return;
+  }
+  BLI_strncpy(program_cache_dir, dir, sizeof(program_cache_dir));
+}
+
+bool GLShader::program_cache_use() const
+{
+  /* Transform feedback varyings are program state set before linking, don't cache them. */
+  return GLContext::program_binary_support && (transform_feedback_type_ == GPU_SHADER_TFB_NONE);
+}
+
+void GLShader::program_cache_key_get(char r_key[33])
+{
+  std::string key;
+  key += (const char *)glGetString(GL_VENDOR);
+  key += (const char *)glGetString(GL_RENDERER);
+  key += (const char *)glGetString(GL_VERSION);
+  key += glsl_patch_get();
+  /* Separate the stages so moving code between them changes the key. */
+  key += "\n#vert\n" + vert_source_;
+  key += "\n#geom\n" + geom_source_;
+  key += "\n#frag\n" + frag_source_;
+  if (!compute_source_.empty()) {
+    key += glsl_patch_compute_get();
+    key += "\n#comp\n" + compute_source_;
+  }
+
+  uchar digest[16];
+  BLI_hash_md5_buffer(key.c_str(), key.size(), digest);
+  BLI_hash_md5_to_hexdigest(digest, r_key);
+}
+
+bool GLShader::program_cache_load(const char *key)
+{
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), program_cache_dir, key);
+
+  size_t data_len;
+  uchar *data = (uchar *)BLI_file_read_binary_as_mem(filepath, 0, &data_len);
+  if (data == nullptr) {
+    return false;
+  }
+
+  GLint status = GL_FALSE;
+  if (data_len > sizeof(GLenum)) {
+    GLenum format;
+    memcpy(&format, data, sizeof(format));
+    glProgramBinary(
+        shader_program_, format, data + sizeof(format), (GLsizei)(data_len - sizeof(format)));
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+  }
+  MEM_freeN(data);
+
+  return status == GL_TRUE;
+}
+
+void GLShader::program_cache_save(const char *key)
+{
+  GLint binary_len = 0;
+  glGetProgramiv(shader_program_, GL_PROGRAM_BINARY_LENGTH, &binary_len);
+  if (binary_len <= 0) {
+    return;
+  }
+
+  /* The binary format comes first, followed by the binary itself. */
+  uchar *data = (uchar *)MEM_mallocN(sizeof(GLenum) + binary_len, __func__);
+  GLenum format;
+  glGetProgramBinary(shader_program_, binary_len, &binary_len, &format, data + sizeof(format));
+  memcpy(data, &format, sizeof(format));
+  const size_t data_len = sizeof(format) + binary_len;
+
+  /* Write to a temporary file first, so a partial binary is never read. */
+  char filepath[FILE_MAX], filepath_tmp[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), program_cache_dir, key);
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.%p.tmp", filepath, (void *)this);
+
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file != nullptr) {
+    const bool written = (fwrite(data, 1, data_len, file) == data_len);
+    fclose(file);
+    if (!written || BLI_rename(filepath_tmp, filepath) != 0) {
+      BLI_delete(filepath_tmp, false, false);
+    }
+  }
+  MEM_freeN(data);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Binding
  * \{ */
@@ -29,6 +29,8 @@
 
 #include "gpu_shader_private.hh"
 
+#include <string>
+
 namespace blender {
 namespace gpu {
 
@@ -43,8 +45,17 @@ class GLShader : public Shader {
   GLuint vert_shader_ = 0;
   GLuint geom_shader_ = 0;
   GLuint frag_shader_ = 0;
+  GLuint compute_shader_ = 0;
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
+  /**
+   * Stage sources (without the patch slot) kept until #finalize when the program binary cache is
+   * used. Compilation is then only done if no cached binary matches.
+   */
+  std::string vert_source_;
+  std::string geom_source_;
+  std::string frag_source_;
+  std::string compute_source_;
 
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
@@ -56,6 +67,7 @@ class GLShader : public Shader {
   void vertex_shader_from_glsl(MutableSpan<const char *> sources) override;
   void geometry_shader_from_glsl(MutableSpan<const char *> sources) override;
   void fragment_shader_from_glsl(MutableSpan<const char *> sources) override;
+  void compute_shader_from_glsl(MutableSpan<const char *> sources) override;
   bool finalize(void) override;
 
   void transform_feedback_names_set(Span<const char *> name_list,
@@ -74,10 +86,20 @@ class GLShader : public Shader {
   /* DEPRECATED: Kept only because of BGL API. */
   int program_handle_get(void) const override;
 
+  static void program_cache_init(void);
+
  private:
   char *glsl_patch_get(void);
+  char *glsl_patch_compute_get(void);
 
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  void stage_source_store(std::string &r_source, Span<const char *> sources);
+  bool stages_create_from_stored_sources(void);
+
+  bool program_cache_use(void) const;
+  void program_cache_key_get(char r_key[33]);
+  bool program_cache_load(const char *key);
+  void program_cache_save(const char *key);
 
   MEM_CXX_CLASS_ALLOC_FUNCS("GLShader");
 };
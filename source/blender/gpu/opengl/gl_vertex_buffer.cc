@@ -111,4 +111,12 @@ void GLVertBuf::update_sub(uint start, uint len, void *data)
   glBufferSubData(GL_ARRAY_BUFFER, start, len, data);
 }
 
+void GLVertBuf::bind_as_ssbo(uint binding)
+{
+  /* Make sure the buffer exists and its data is uploaded. */
+  this->bind();
+  BLI_assert(vbo_id_ != 0);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, vbo_id_);
+}
+
 }  // namespace blender::gpu
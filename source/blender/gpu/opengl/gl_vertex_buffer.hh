@@ -46,6 +46,7 @@ class GLVertBuf : public VertBuf {
   void bind(void);
 
   void update_sub(uint start, uint len, void *data) override;
+  void bind_as_ssbo(uint binding) override;
 
  protected:
   void acquire_data(void) override;
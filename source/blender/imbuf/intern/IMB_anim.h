@@ -80,6 +80,9 @@
 
 #define MAXNUMSTREAMS 50
 
+/* Number of frames kept from the decoding done to reach a seek target. */
+#define ANIM_GOP_CACHE_SIZE 8
+
 struct IDProperty;
 struct _AviMovie;
 struct anim_index;
@@ -136,6 +139,12 @@ struct anim {
   int64_t last_pts;
   int64_t next_pts;
   AVPacket next_packet;
+
+  /* Frames preceding the last target of a backwards seek, with their PTS range. */
+  struct ImBuf *gop_cache[ANIM_GOP_CACHE_SIZE];
+  int64_t gop_cache_pts[ANIM_GOP_CACHE_SIZE];
+  int64_t gop_cache_pts_end[ANIM_GOP_CACHE_SIZE];
+  int gop_cache_next;
 #endif
 
   char index_dir[768];
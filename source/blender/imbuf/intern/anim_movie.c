@@ -55,6 +55,7 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "MEM_guardedalloc.h"
@@ -573,6 +574,21 @@ static int startffmpeg(struct anim *anim)
 
   pCodecCtx->workaround_bugs = 1;
 
+  /* Decoding on a single thread is far from real time for high resolution footage. */
+  if (pCodec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
+    pCodecCtx->thread_count = 0;
+  }
+  else {
+    pCodecCtx->thread_count = BLI_system_thread_count();
+  }
+
+  if (pCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
+    pCodecCtx->thread_type = FF_THREAD_FRAME;
+  }
+  else if (pCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
+    pCodecCtx->thread_type = FF_THREAD_SLICE;
+  }
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
     avformat_close_input(&pFormatCtx);
     return -1;
@@ -749,13 +765,12 @@ static int startffmpeg(struct anim *anim)
 /* postprocess the image in anim->pFrame and do color conversion
  * and deinterlacing stuff.
  *
- * Output is anim->last_frame
+ * Output is ibuf
  */
 
-static void ffmpeg_postprocess(struct anim *anim)
+static void ffmpeg_postprocess(struct anim *anim, ImBuf *ibuf)
 {
   AVFrame *input = anim->pFrame;
-  ImBuf *ibuf = anim->last_frame;
   int filter_y = 0;
 
   if (!anim->pFrameComplete) {
@@ -965,7 +980,75 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
   return (rval >= 0);
 }
 
-static void ffmpeg_decode_video_frame_scan(struct anim *anim, int64_t pts_to_search)
+static ImBuf *ffmpeg_frame_ibuf_alloc(struct anim *anim)
+{
+  /* Certain versions of FFmpeg have a bug in libswscale which ends up in crash
+   * when destination buffer is not properly aligned. For example, this happens
+   * in FFmpeg 4.3.1. It got fixed later on, but for compatibility reasons is
+   * still best to avoid crash.
+   *
+   * This is achieved by using own allocation call rather than relying on
+   * IMB_allocImBuf() to do so since the IMB_allocImBuf() is not guaranteed
+   * to perform aligned allocation.
+   *
+   * In theory this could give better performance, since SIMD operations on
+   * aligned data are usually faster.
+   *
+   * Note that even though sometimes vertical flip is required it does not
+   * affect on alignment of data passed to sws_scale because if the X dimension
+   * is not 32 byte aligned special intermediate buffer is allocated.
+   *
+   * The issue was reported to FFmpeg under ticket #8747 in the FFmpeg tracker
+   * and is fixed in the newer versions than 4.3.1. */
+  ImBuf *ibuf = IMB_allocImBuf(anim->x, anim->y, 32, 0);
+  ibuf->rect = MEM_mallocN_aligned((size_t)4 * anim->x * anim->y, 32, "ffmpeg ibuf");
+  ibuf->mall |= IB_rect;
+
+  ibuf->rect_colorspace = colormanage_colorspace_get_named(anim->colorspace);
+
+  return ibuf;
+}
+
+/* Keep a converted copy of anim->pFrame, starting at anim->next_pts.
+ * Return the slot, its end is filled in once the following frame is decoded. */
+static int ffmpeg_gop_cache_add(struct anim *anim)
+{
+  const int slot = anim->gop_cache_next;
+  anim->gop_cache_next = (slot + 1) % ANIM_GOP_CACHE_SIZE;
+
+  IMB_freeImBuf(anim->gop_cache[slot]);
+  anim->gop_cache[slot] = ffmpeg_frame_ibuf_alloc(anim);
+  anim->gop_cache_pts[slot] = anim->next_pts;
+  anim->gop_cache_pts_end[slot] = anim->next_pts;
+
+  ffmpeg_postprocess(anim, anim->gop_cache[slot]);
+
+  return slot;
+}
+
+static ImBuf *ffmpeg_gop_cache_lookup(struct anim *anim, int64_t pts_to_search)
+{
+  for (int i = 0; i < ANIM_GOP_CACHE_SIZE; i++) {
+    if (anim->gop_cache[i] && anim->gop_cache_pts[i] <= pts_to_search &&
+        anim->gop_cache_pts_end[i] > pts_to_search) {
+      return anim->gop_cache[i];
+    }
+  }
+  return NULL;
+}
+
+static void ffmpeg_gop_cache_free(struct anim *anim)
+{
+  for (int i = 0; i < ANIM_GOP_CACHE_SIZE; i++) {
+    IMB_freeImBuf(anim->gop_cache[i]);
+    anim->gop_cache[i] = NULL;
+  }
+}
+
+/* Frames decoded on the way with PTS of at least keep_from_pts are stored in GOP cache. */
+static void ffmpeg_decode_video_frame_scan(struct anim *anim,
+                                           int64_t pts_to_search,
+                                           int64_t keep_from_pts)
 {
   /* there seem to exist *very* silly GOP lengths out in the wild... */
   int count = 1000;
@@ -982,9 +1065,19 @@ static void ffmpeg_decode_video_frame_scan(struct anim *anim, int64_t pts_to_sea
            "  WHILE: pts=%" PRId64 " in search of %" PRId64 "\n",
            (int64_t)anim->next_pts,
            (int64_t)pts_to_search);
+
+    int gop_cache_slot = -1;
+    if (anim->pFrameComplete && anim->next_pts >= keep_from_pts) {
+      gop_cache_slot = ffmpeg_gop_cache_add(anim);
+    }
+
     if (!ffmpeg_decode_video_frame(anim)) {
       break;
     }
+
+    if (gop_cache_slot != -1) {
+      anim->gop_cache_pts_end[gop_cache_slot] = anim->next_pts;
+    }
     count--;
   }
   if (count == 0) {
@@ -1106,11 +1199,19 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
     return anim->last_frame;
   }
 
+  /* Decoder state is not changed, so curposition stays where the decoder is. */
+  ImBuf *gop_cache_ibuf = ffmpeg_gop_cache_lookup(anim, pts_to_search);
+  if (gop_cache_ibuf) {
+    av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: frame decoded before backwards seek\n");
+    IMB_refImBuf(gop_cache_ibuf);
+    return gop_cache_ibuf;
+  }
+
   if (position > anim->curposition + 1 && anim->preseek && !tc_index &&
       position - (anim->curposition + 1) < anim->preseek) {
     av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: within preseek interval (no index)\n");
 
-    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+    ffmpeg_decode_video_frame_scan(anim, pts_to_search, INT64_MAX);
   }
   else if (tc_index && IMB_indexer_can_scan(tc_index, old_frame_index, new_frame_index)) {
     av_log(anim->pFormatCtx,
@@ -1118,7 +1219,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
            "FETCH: within preseek interval "
            "(index tells us)\n");
 
-    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+    ffmpeg_decode_video_frame_scan(anim, pts_to_search, INT64_MAX);
   }
   else if (position != anim->curposition + 1) {
     long long pos;
@@ -1190,7 +1291,16 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
     /* memset(anim->pFrame, ...) ?? */
 
     if (ret >= 0) {
-      ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+      /* When stepping backwards, the frames before the target are likely requested next. */
+      int64_t keep_from_pts = INT64_MAX;
+      if (position < anim->curposition) {
+        keep_from_pts = pts_to_search -
+                        (int64_t)(ANIM_GOP_CACHE_SIZE / pts_time_base / frame_rate + 0.5);
+        if (keep_from_pts < 0) {
+          keep_from_pts = 0;
+        }
+      }
+      ffmpeg_decode_video_frame_scan(anim, pts_to_search, keep_from_pts);
     }
   }
   else if (position == 0 && anim->curposition == -1) {
@@ -1202,32 +1312,9 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
   }
 
   IMB_freeImBuf(anim->last_frame);
+  anim->last_frame = ffmpeg_frame_ibuf_alloc(anim);
 
-  /* Certain versions of FFmpeg have a bug in libswscale which ends up in crash
-   * when destination buffer is not properly aligned. For example, this happens
-   * in FFmpeg 4.3.1. It got fixed later on, but for compatibility reasons is
-   * still best to avoid crash.
-   *
-   * This is achieved by using own allocation call rather than relying on
-   * IMB_allocImBuf() to do so since the IMB_allocImBuf() is not guaranteed
-   * to perform aligned allocation.
-   *
-   * In theory this could give better performance, since SIMD operations on
-   * aligned data are usually faster.
-   *
-   * Note that even though sometimes vertical flip is required it does not
-   * affect on alignment of data passed to sws_scale because if the X dimension
-   * is not 32 byte aligned special intermediate buffer is allocated.
-   *
-   * The issue was reported to FFmpeg under ticket #8747 in the FFmpeg tracker
-   * and is fixed in the newer versions than 4.3.1. */
-  anim->last_frame = IMB_allocImBuf(anim->x, anim->y, 32, 0);
-  anim->last_frame->rect = MEM_mallocN_aligned((size_t)4 * anim->x * anim->y, 32, "ffmpeg ibuf");
-  anim->last_frame->mall |= IB_rect;
-
-  anim->last_frame->rect_colorspace = colormanage_colorspace_get_named(anim->colorspace);
-
-  ffmpeg_postprocess(anim);
+  ffmpeg_postprocess(anim, anim->last_frame);
 
   anim->last_pts = anim->next_pts;
 
@@ -1270,6 +1357,7 @@ static void free_anim_ffmpeg(struct anim *anim)
 
     sws_freeContext(anim->img_convert_ctx);
     IMB_freeImBuf(anim->last_frame);
+    ffmpeg_gop_cache_free(anim);
     if (anim->next_packet.stream_index != -1) {
       av_free_packet(&anim->next_packet);
     }
@@ -1426,10 +1514,8 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim,
 #endif
 #ifdef WITH_FFMPEG
     case ANIM_FFMPEG:
+      /* Sets curposition itself, to where the decoder is. */
       ibuf = ffmpeg_fetchibuf(anim, position, tc);
-      if (ibuf) {
-        anim->curposition = position;
-      }
       filter_y = 0; /* done internally */
       break;
 #endif
@@ -1439,7 +1525,7 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim,
     if (filter_y) {
       IMB_filtery(ibuf);
     }
-    BLI_snprintf(ibuf->name, sizeof(ibuf->name), "%s.%04d", anim->name, anim->curposition + 1);
+    BLI_snprintf(ibuf->name, sizeof(ibuf->name), "%s.%04d", anim->name, position + 1);
   }
   return ibuf;
 }
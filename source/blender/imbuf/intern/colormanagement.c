@@ -80,6 +80,8 @@ static ListBase global_colorspaces = {NULL, NULL};
 static ListBase global_displays = {NULL, NULL};
 static ListBase global_views = {NULL, NULL};
 static ListBase global_looks = {NULL, NULL};
+/* Cached processors for transforms between two named color spaces. */
+static ListBase global_colorspace_transforms = {NULL, NULL};
 
 static int global_tot_colorspace = 0;
 static int global_tot_display = 0;
@@ -104,8 +106,17 @@ typedef struct ColormanageProcessor {
   OCIO_ConstProcessorRcPtr *processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+  /* Processor is owned by global_colorspace_transforms. */
+  bool is_cached_processor;
 } ColormanageProcessor;
 
+typedef struct ColorSpaceTransform {
+  struct ColorSpaceTransform *next, *prev;
+  char from_colorspace[MAX_COLORSPACE_NAME];
+  char to_colorspace[MAX_COLORSPACE_NAME];
+  OCIO_ConstProcessorRcPtr *processor;
+} ColorSpaceTransform;
+
 static struct global_glsl_state {
   /* Actual processor used for GLSL baked LUTs. */
   /* UI colorspace here refers to the display linear color space,
@@ -655,6 +666,14 @@ static void colormanage_free_config(void)
   BLI_freelistN(&global_looks);
   global_tot_looks = 0;
 
+  /* free cached transform processors */
+  LISTBASE_FOREACH (ColorSpaceTransform *, transform, &global_colorspace_transforms) {
+    if (transform->processor) {
+      OCIO_processorRelease(transform->processor);
+    }
+  }
+  BLI_freelistN(&global_colorspace_transforms);
+
   OCIO_exit();
 }
 
@@ -956,6 +975,36 @@ static OCIO_ConstProcessorRcPtr *create_colorspace_transform_processor(const cha
   return processor;
 }
 
+/* Same as #create_colorspace_transform_processor, but the processor is created only once and
+ * owned by the cache. Creating OCIO processors is expensive compared to applying them to small
+ * buffers, such as sequencer strips or for image saving. */
+static OCIO_ConstProcessorRcPtr *colorspace_transform_processor_get(const char *from_colorspace,
+                                                                    const char *to_colorspace)
+{
+  ColorSpaceTransform *transform;
+
+  BLI_mutex_lock(&processor_lock);
+
+  for (transform = global_colorspace_transforms.first; transform; transform = transform->next) {
+    if (STREQ(transform->from_colorspace, from_colorspace) &&
+        STREQ(transform->to_colorspace, to_colorspace)) {
+      break;
+    }
+  }
+
+  if (transform == NULL) {
+    transform = MEM_callocN(sizeof(ColorSpaceTransform), "ColorSpaceTransform");
+    BLI_strncpy(transform->from_colorspace, from_colorspace, sizeof(transform->from_colorspace));
+    BLI_strncpy(transform->to_colorspace, to_colorspace, sizeof(transform->to_colorspace));
+    transform->processor = create_colorspace_transform_processor(from_colorspace, to_colorspace);
+    BLI_addtail(&global_colorspace_transforms, transform);
+  }
+
+  BLI_mutex_unlock(&processor_lock);
+
+  return transform->processor;
+}
+
 static OCIO_ConstProcessorRcPtr *colorspace_to_scene_linear_processor(ColorSpace *colorspace)
 {
   if (colorspace->to_scene_linear == NULL) {
@@ -3860,7 +3909,8 @@ ColormanageProcessor *IMB_colormanagement_colorspace_processor_new(const char *f
   color_space = colormanage_colorspace_get_named(to_colorspace);
   cm_processor->is_data_result = color_space->is_data;
 
-  cm_processor->processor = create_colorspace_transform_processor(from_colorspace, to_colorspace);
+  cm_processor->processor = colorspace_transform_processor_get(from_colorspace, to_colorspace);
+  cm_processor->is_cached_processor = true;
 
   return cm_processor;
 }
@@ -3970,15 +4020,20 @@ void IMB_colormanagement_processor_apply_byte(
    * but for now it's not so important.
    */
   BLI_assert(channels == 4);
-  float pixel[4];
+
+  /* Apply processor to a row at once, which is much faster than going pixel by pixel. */
+  float *row = MEM_mallocN(sizeof(float[4]) * width, "colormanagement byte row");
   for (int y = 0; y < height; y++) {
+    unsigned char *row_byte = buffer + channels * ((size_t)y) * width;
     for (int x = 0; x < width; x++) {
-      size_t offset = channels * (((size_t)y) * width + x);
-      rgba_uchar_to_float(pixel, buffer + offset);
-      IMB_colormanagement_processor_apply_v4(cm_processor, pixel);
-      rgba_float_to_uchar(buffer + offset, pixel);
+      rgba_uchar_to_float(row + 4 * x, row_byte + channels * x);
+    }
+    IMB_colormanagement_processor_apply(cm_processor, row, width, 1, 4, false);
+    for (int x = 0; x < width; x++) {
+      rgba_float_to_uchar(row_byte + channels * x, row + 4 * x);
     }
   }
+  MEM_freeN(row);
 }
 
 void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
@@ -3986,7 +4041,7 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_free(cm_processor->curve_mapping);
   }
-  if (cm_processor->processor) {
+  if (cm_processor->processor && !cm_processor->is_cached_processor) {
     OCIO_processorRelease(cm_processor->processor);
   }
 
@@ -67,6 +67,8 @@ struct CDStreamConfig {
   float weight;
   float time;
   bool use_vertex_interpolation;
+  /* The mesh already has the polygons, loops and UVs of the sample, they are not read again. */
+  bool use_existing_topology;
   Alembic::AbcGeom::index_t index;
   Alembic::AbcGeom::index_t ceil_index;
 
@@ -89,6 +91,7 @@ struct CDStreamConfig {
         add_customdata_cb(NULL),
         weight(0.0f),
         time(0.0f),
+        use_existing_topology(false),
         index(0),
         ceil_index(0),
         modifier_error_message(NULL)
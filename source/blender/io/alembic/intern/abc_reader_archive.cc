@@ -27,6 +27,7 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 
 #ifdef WIN32
 #  include "utfconv.h"
@@ -82,16 +83,32 @@ ArchiveReader::ArchiveReader(struct Main *bmain, const char *filename)
   BLI_strncpy(abs_filename, filename, FILE_MAX);
   BLI_path_abs(abs_filename, BKE_main_blendfile_path(bmain));
 
+  /* Ogawa serializes reads that share a stream. Modifiers of different objects using the same
+   * archive are evaluated in parallel, so give every thread its own stream. */
+  const int num_streams = BLI_system_thread_count();
+
 #ifdef WIN32
   UTF16_ENCODE(abs_filename);
   std::wstring wstr(abs_filename_16);
-  m_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
-  UTF16_UN_ENCODE(abs_filename);
+#endif
+
+  for (int i = 0; i < num_streams; i++) {
+    std::unique_ptr<std::ifstream> infile = std::make_unique<std::ifstream>();
+#ifdef WIN32
+    infile->open(wstr.c_str(), std::ios::in | std::ios::binary);
 #else
-  m_infile.open(abs_filename, std::ios::in | std::ios::binary);
+    infile->open(abs_filename, std::ios::in | std::ios::binary);
 #endif
+    if (i > 0 && !infile->is_open()) {
+      break;
+    }
+    m_streams.push_back(infile.get());
+    m_infiles.push_back(std::move(infile));
+  }
 
-  m_streams.push_back(&m_infile);
+#ifdef WIN32
+  UTF16_UN_ENCODE(abs_filename);
+#endif
 
   m_archive = open_archive(abs_filename, m_streams);
 }
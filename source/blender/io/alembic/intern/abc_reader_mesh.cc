@@ -442,7 +442,9 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   }
 
   if ((settings->read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
-    read_mpolys(config, abc_mesh_data);
+    if (!config.use_existing_topology) {
+      read_mpolys(config, abc_mesh_data);
+    }
     process_normals(config, schema.getNormalsParam(), selector);
   }
 
@@ -692,6 +694,15 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
+  /* When only positions are animated, the existing mesh has the polygons and loops of every
+   * sample. Rebuilding them and their edges dominates the time spent on dense meshes. */
+  if (new_mesh == nullptr && (settings.read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
+    const Alembic::AbcGeom::IV2fGeomParam &uvs = m_schema.getUVsParam();
+    config.use_existing_topology = m_schema.getTopologyVariance() !=
+                                       Alembic::AbcGeom::kHeterogenousTopology &&
+                                   (!uvs.valid() || uvs.isConstant());
+  }
+
   read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
 
   if (new_mesh) {
@@ -1001,11 +1001,13 @@ void ArmatureImporter::make_shape_keys(bContext *C)
 
 COLLADAFW::UniqueId *ArmatureImporter::get_geometry_uid(const COLLADAFW::UniqueId &controller_uid)
 {
-  if (geom_uid_by_controller_uid.find(controller_uid) == geom_uid_by_controller_uid.end()) {
+  std::map<COLLADAFW::UniqueId, COLLADAFW::UniqueId>::iterator iter =
+      geom_uid_by_controller_uid.find(controller_uid);
+  if (iter == geom_uid_by_controller_uid.end()) {
     return nullptr;
   }
 
-  return &geom_uid_by_controller_uid[controller_uid];
+  return &iter->second;
 }
 
 Object *ArmatureImporter::get_armature_for_joint(COLLADAFW::Node *node)
@@ -1019,11 +1021,10 @@ Object *ArmatureImporter::get_armature_for_joint(COLLADAFW::Node *node)
     }
   }
 
-  std::map<COLLADAFW::UniqueId, Object *>::iterator arm;
-  for (arm = unskinned_armature_map.begin(); arm != unskinned_armature_map.end(); arm++) {
-    if (arm->first == node->getUniqueId()) {
-      return arm->second;
-    }
+  std::map<COLLADAFW::UniqueId, Object *>::iterator arm = unskinned_armature_map.find(
+      node->getUniqueId());
+  if (arm != unskinned_armature_map.end()) {
+    return arm->second;
   }
   return nullptr;
 }
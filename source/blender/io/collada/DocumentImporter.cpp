@@ -624,11 +624,11 @@ std::vector<Object *> *DocumentImporter::write_node(COLLADAFW::Node *node,
         std::pair<std::multimap<COLLADAFW::UniqueId, Object *>::iterator,
                   std::multimap<COLLADAFW::UniqueId, Object *>::iterator>
             pair_iter = object_map.equal_range(node_id);
+        COLLADAFW::Node *source_node = node_map[node_id];
         for (std::multimap<COLLADAFW::UniqueId, Object *>::iterator it2 = pair_iter.first;
              it2 != pair_iter.second;
              it2++) {
           Object *source_ob = (Object *)it2->second;
-          COLLADAFW::Node *source_node = node_map[node_id];
           ob = create_instance_node(source_ob, source_node, node, sce, is_library_node);
           objects_done->push_back(ob);
           if (parent_node == nullptr) {
@@ -792,6 +792,7 @@ bool DocumentImporter::writeMaterial(const COLLADAFW::Material *cmat)
 
   this->uid_effect_map[cmat->getInstantiatedEffect()] = ma;
   this->uid_material_map[cmat->getUniqueId()] = ma;
+  this->effect_material_uid_map[cmat->getInstantiatedEffect()] = cmat->getUniqueId();
 
   return true;
 }
@@ -831,18 +832,17 @@ bool DocumentImporter::writeEffect(const COLLADAFW::Effect *effect)
 
   const COLLADAFW::UniqueId &uid = effect->getUniqueId();
 
-  if (uid_effect_map.find(uid) == uid_effect_map.end()) {
+  std::map<COLLADAFW::UniqueId, Material *>::iterator effect_iter = uid_effect_map.find(uid);
+  if (effect_iter == uid_effect_map.end()) {
     fprintf(stderr, "Couldn't find a material by UID.\n");
     return true;
   }
 
-  Material *ma = uid_effect_map[uid];
-  std::map<COLLADAFW::UniqueId, Material *>::iterator iter;
-  for (iter = uid_material_map.begin(); iter != uid_material_map.end(); iter++) {
-    if (iter->second == ma) {
-      this->FW_object_map[iter->first] = effect;
-      break;
-    }
+  Material *ma = effect_iter->second;
+  std::map<COLLADAFW::UniqueId, COLLADAFW::UniqueId>::iterator material_iter =
+      effect_material_uid_map.find(uid);
+  if (material_iter != effect_material_uid_map.end()) {
+    this->FW_object_map[material_iter->second] = effect;
   }
   COLLADAFW::CommonEffectPointerArray common_efs = effect->getCommonEffects();
   if (common_efs.getCount() < 1) {
@@ -152,6 +152,9 @@ class DocumentImporter : COLLADAFW::IWriter {
   UidImageMap uid_image_map;
   std::map<COLLADAFW::UniqueId, Material *> uid_material_map;
   std::map<COLLADAFW::UniqueId, Material *> uid_effect_map;
+  /* Effect UID to the UID of the last material instantiating it, avoids searching
+   * uid_material_map for the material of every effect. */
+  std::map<COLLADAFW::UniqueId, COLLADAFW::UniqueId> effect_material_uid_map;
   std::map<COLLADAFW::UniqueId, Camera *> uid_camera_map;
   std::map<COLLADAFW::UniqueId, Light *> uid_light_map;
   std::map<Material *, TexIndexTextureArrayMap> material_texture_mapping_map;
@@ -887,24 +887,27 @@ bool MeshImporter::is_flat_face(unsigned int *nind, COLLADAFW::MeshVertexData &n
 
 Object *MeshImporter::get_object_by_geom_uid(const COLLADAFW::UniqueId &geom_uid)
 {
-  if (uid_object_map.find(geom_uid) != uid_object_map.end()) {
-    return uid_object_map[geom_uid];
+  std::map<COLLADAFW::UniqueId, Object *>::iterator iter = uid_object_map.find(geom_uid);
+  if (iter != uid_object_map.end()) {
+    return iter->second;
   }
   return nullptr;
 }
 
 Mesh *MeshImporter::get_mesh_by_geom_uid(const COLLADAFW::UniqueId &geom_uid)
 {
-  if (uid_mesh_map.find(geom_uid) != uid_mesh_map.end()) {
-    return uid_mesh_map[geom_uid];
+  std::map<COLLADAFW::UniqueId, Mesh *>::iterator iter = uid_mesh_map.find(geom_uid);
+  if (iter != uid_mesh_map.end()) {
+    return iter->second;
   }
   return nullptr;
 }
 
 std::string *MeshImporter::get_geometry_name(const std::string &mesh_name)
 {
-  if (this->mesh_geom_map.find(mesh_name) != this->mesh_geom_map.end()) {
-    return &this->mesh_geom_map[mesh_name];
+  std::map<std::string, std::string>::iterator iter = this->mesh_geom_map.find(mesh_name);
+  if (iter != this->mesh_geom_map.end()) {
+    return &iter->second;
   }
   return nullptr;
 }
@@ -1053,7 +1056,8 @@ void MeshImporter::assign_material_to_geom(
   const COLLADAFW::UniqueId &ma_uid = cmaterial.getReferencedMaterial();
 
   /* do we know this material? */
-  if (uid_material_map.find(ma_uid) == uid_material_map.end()) {
+  std::map<COLLADAFW::UniqueId, Material *>::iterator ma_iter = uid_material_map.find(ma_uid);
+  if (ma_iter == uid_material_map.end()) {
 
     fprintf(stderr, "Cannot find material by UID.\n");
     return;
@@ -1063,7 +1067,7 @@ void MeshImporter::assign_material_to_geom(
   materials_mapped_to_geom.insert(
       std::pair<COLLADAFW::UniqueId, COLLADAFW::UniqueId>(*geom_uid, ma_uid));
 
-  Material *ma = uid_material_map[ma_uid];
+  Material *ma = ma_iter->second;
 
   /* Attention! This temporarily assigns material to object on purpose!
    * See note above. */
@@ -1074,9 +1078,10 @@ void MeshImporter::assign_material_to_geom(
   COLLADAFW::MaterialId mat_id = cmaterial.getMaterialId();
 
   /* assign material indices to mesh faces */
-  if (mat_prim_map.find(mat_id) != mat_prim_map.end()) {
+  MaterialIdPrimitiveArrayMap::iterator prims_iter = mat_prim_map.find(mat_id);
+  if (prims_iter != mat_prim_map.end()) {
 
-    std::vector<Primitive> &prims = mat_prim_map[mat_id];
+    std::vector<Primitive> &prims = prims_iter->second;
 
     std::vector<Primitive>::iterator it;
 
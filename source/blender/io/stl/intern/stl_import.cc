@@ -0,0 +1,329 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup stl
+ *
+ * STL importer. Binary files are memory-mapped and their triangles are read in parallel. Vertices
+ * are merged by partitioning the face corners into buckets by the hash of their position, so that
+ * every bucket can be deduplicated by its own task.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#ifndef WIN32
+#  include <unistd.h> /* For close. */
+#else
+#  include <io.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+
+#include "BKE_context.h"
+#include "BKE_customdata.h"
+#include "BKE_global.h"
+#include "BKE_collection.h"
+#include "BKE_layer.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLI_array.hh"
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
+#include "BLI_float3.hh"
+#include "BLI_map.hh"
+#include "BLI_mmap.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_layer_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "IO_stl.h"
+
+namespace blender::io::stl {
+
+static constexpr size_t binary_header_size = 80 + sizeof(uint32_t);
+/* Normal, three positions and the attribute byte count. */
+static constexpr size_t binary_triangle_size = 12 * sizeof(float) + sizeof(uint16_t);
+
+/* Positions of all triangle corners, three per triangle. */
+using CornerPositions = Array<float3>;
+
+static bool read_binary(BLI_mmap_file *mmap_file, const size_t file_size, CornerPositions &r_corners)
+{
+  const char *data = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file));
+  uint32_t tris_num;
+  memcpy(&tris_num, data + 80, sizeof(tris_num));
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint32(&tris_num);
+  }
+  if (binary_header_size + size_t(tris_num) * binary_triangle_size > file_size) {
+    return false;
+  }
+
+  r_corners = CornerPositions(int64_t(tris_num) * 3);
+  parallel_for(IndexRange(tris_num), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      /* The positions follow the face normal, and are not aligned in the file. */
+      const char *tri = data + binary_header_size + size_t(i) * binary_triangle_size +
+                        3 * sizeof(float);
+      memcpy(&r_corners[i * 3], tri, sizeof(float[3][3]));
+    }
+  });
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_float_array(reinterpret_cast<float *>(r_corners.data()),
+                                  int(r_corners.size() * 3));
+  }
+  return true;
+}
+
+static bool read_ascii(const char *filepath, CornerPositions &r_corners)
+{
+  size_t text_size;
+  char *text = static_cast<char *>(BLI_file_read_text_as_mem(filepath, 1, &text_size));
+  if (text == nullptr) {
+    return false;
+  }
+  text[text_size] = '\0';
+
+  Vector<float3> corners;
+  const char *str = text;
+  while ((str = strstr(str, "vertex")) != nullptr) {
+    char *end;
+    str += strlen("vertex");
+    float3 co;
+    co.x = strtof(str, &end);
+    co.y = strtof(end, &end);
+    co.z = strtof(end, &end);
+    corners.append(co);
+    str = end;
+  }
+  MEM_freeN(text);
+
+  /* Ignore the corners of an incomplete last triangle. */
+  r_corners = CornerPositions(corners.size() - corners.size() % 3);
+  r_corners.as_mutable_span().copy_from(corners.as_span().take_front(r_corners.size()));
+  return true;
+}
+
+static bool read_corners(const char *filepath, CornerPositions &r_corners)
+{
+  const size_t file_size = BLI_file_size(filepath);
+  if (file_size == size_t(-1)) {
+    return false;
+  }
+
+  /* ASCII files start with "solid", but so do some binary files. The size of a binary file is
+   * fully determined by its triangle count, which is a more reliable test. */
+  if (file_size >= binary_header_size) {
+    const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+    if (file == -1) {
+      return false;
+    }
+    BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+    bool is_binary = false;
+    bool ok = false;
+    if (mmap_file != nullptr) {
+      uint32_t tris_num;
+      if (BLI_mmap_read(mmap_file, &tris_num, 80, sizeof(tris_num))) {
+        if (ENDIAN_ORDER == B_ENDIAN) {
+          BLI_endian_switch_uint32(&tris_num);
+        }
+        is_binary = binary_header_size + size_t(tris_num) * binary_triangle_size == file_size;
+      }
+      if (is_binary) {
+        ok = read_binary(mmap_file, file_size, r_corners);
+      }
+      BLI_mmap_free(mmap_file);
+    }
+    close(file);
+    if (is_binary) {
+      return ok;
+    }
+  }
+
+  return read_ascii(filepath, r_corners);
+}
+
+/**
+ * Fill \a r_corner_verts with the merged vertex index of every corner, and return the
+ * positions of the merged vertices.
+ */
+static Array<float3> merge_vertices(Span<float3> corners, MutableSpan<int> r_corner_verts)
+{
+  constexpr int64_t buckets_num = 64;
+
+  /* Turn negative zeros into positive ones, they compare equal but do not hash equal. */
+  auto position_key = [](float3 co) { return float3(co.x + 0.0f, co.y + 0.0f, co.z + 0.0f); };
+
+  Array<Vector<int>> bucket_corners(buckets_num);
+  for (const int64_t i : corners.index_range()) {
+    const uint64_t hash = position_key(corners[i]).hash();
+    bucket_corners[(hash >> 16) % buckets_num].append(int(i));
+  }
+
+  /* Deduplicate every bucket separately, the vertex indices are local to the bucket first. */
+  Array<Vector<float3>> bucket_verts(buckets_num);
+  parallel_for(IndexRange(buckets_num), 1, [&](IndexRange range) {
+    for (const int64_t bucket : range) {
+      Map<float3, int> vert_indices;
+      vert_indices.reserve(bucket_corners[bucket].size() / 4);
+      for (const int corner : bucket_corners[bucket]) {
+        const float3 co = position_key(corners[corner]);
+        r_corner_verts[corner] = vert_indices.lookup_or_add_cb(co, [&]() {
+          bucket_verts[bucket].append(co);
+          return int(bucket_verts[bucket].size() - 1);
+        });
+      }
+    }
+  });
+
+  Array<int> bucket_offsets(buckets_num + 1);
+  bucket_offsets[0] = 0;
+  for (const int64_t bucket : IndexRange(buckets_num)) {
+    bucket_offsets[bucket + 1] = bucket_offsets[bucket] + int(bucket_verts[bucket].size());
+  }
+
+  Array<float3> verts(bucket_offsets.last());
+  parallel_for(IndexRange(buckets_num), 1, [&](IndexRange range) {
+    for (const int64_t bucket : range) {
+      const int offset = bucket_offsets[bucket];
+      verts.as_mutable_span()
+          .slice(offset, bucket_verts[bucket].size())
+          .copy_from(bucket_verts[bucket]);
+      for (const int corner : bucket_corners[bucket]) {
+        r_corner_verts[corner] += offset;
+      }
+    }
+  });
+  return verts;
+}
+
+static void mesh_fill(Mesh *mesh, Span<float3> verts, Span<int> corner_verts)
+{
+  /* Merging can collapse triangles, those are skipped. */
+  const int64_t tris_num = corner_verts.size() / 3;
+  auto tri_is_valid = [&](const int64_t tri) {
+    const int v1 = corner_verts[tri * 3];
+    const int v2 = corner_verts[tri * 3 + 1];
+    const int v3 = corner_verts[tri * 3 + 2];
+    return v1 != v2 && v2 != v3 && v3 != v1;
+  };
+  Vector<int> valid_tris;
+  valid_tris.reserve(tris_num);
+  for (const int64_t tri : IndexRange(tris_num)) {
+    if (tri_is_valid(tri)) {
+      valid_tris.append(int(tri));
+    }
+  }
+
+  mesh->totvert = int(verts.size());
+  mesh->totloop = int(valid_tris.size() * 3);
+  mesh->totpoly = int(valid_tris.size());
+  CustomData_add_layer(&mesh->vdata, CD_MVERT, CD_CALLOC, nullptr, mesh->totvert);
+  CustomData_add_layer(&mesh->ldata, CD_MLOOP, CD_CALLOC, nullptr, mesh->totloop);
+  CustomData_add_layer(&mesh->pdata, CD_MPOLY, CD_CALLOC, nullptr, mesh->totpoly);
+  BKE_mesh_update_customdata_pointers(mesh, false);
+
+  MVert *mvert = mesh->mvert;
+  parallel_for(verts.index_range(), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      copy_v3_v3(mvert[i].co, verts[i]);
+    }
+  });
+
+  MLoop *mloop = mesh->mloop;
+  MPoly *mpoly = mesh->mpoly;
+  parallel_for(valid_tris.index_range(), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      const int tri = valid_tris[i];
+      mpoly[i].loopstart = int(i * 3);
+      mpoly[i].totloop = 3;
+      for (const int corner : IndexRange(3)) {
+        mloop[i * 3 + corner].v = uint(corner_verts[tri * 3 + corner]);
+      }
+    }
+  });
+
+  BKE_mesh_calc_edges(mesh, false, false);
+}
+
+static bool import_file(bContext *C, const char *filepath, const STLImportParams &params)
+{
+  CornerPositions corners;
+  if (!read_corners(filepath, corners)) {
+    fprintf(stderr, "STL import: could not read '%s'\n", filepath);
+    return false;
+  }
+
+  Array<int> corner_verts(corners.size());
+  Array<float3> verts;
+  if (params.use_merge_vertices) {
+    verts = merge_vertices(corners, corner_verts);
+    /* The corner positions are not needed anymore. */
+    corners = CornerPositions();
+  }
+  else {
+    for (const int64_t i : corner_verts.index_range()) {
+      corner_verts[i] = int(i);
+    }
+    verts = std::move(corners);
+  }
+
+  Main *bmain = CTX_data_main(C);
+  ViewLayer *view_layer = CTX_data_view_layer(C);
+
+  char name[MAX_ID_NAME - 2];
+  BLI_strncpy(name, BLI_path_basename(filepath), sizeof(name));
+  BLI_path_extension_replace(name, sizeof(name), "");
+
+  Object *ob = BKE_object_add_only_object(bmain, OB_MESH, name);
+  Mesh *mesh = static_cast<Mesh *>(BKE_object_obdata_add_from_type(bmain, OB_MESH, name));
+  ob->data = mesh;
+  mesh_fill(mesh, verts, corner_verts);
+
+  LayerCollection *layer_collection = BKE_layer_collection_get_active(view_layer);
+  BKE_collection_object_add(bmain, layer_collection->collection, ob);
+  Base *base = BKE_view_layer_base_find(view_layer, ob);
+  BKE_view_layer_base_deselect_all(view_layer);
+  BKE_view_layer_base_select_and_set_active(view_layer, base);
+
+  DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION);
+  DEG_relations_tag_update(bmain);
+  return true;
+}
+
+}  // namespace blender::io::stl
+
+bool STL_import(bContext *C, const char *filepath, const STLImportParams *params)
+{
+  return blender::io::stl::import_file(C, filepath, *params);
+}
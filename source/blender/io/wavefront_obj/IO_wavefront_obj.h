@@ -0,0 +1,46 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct bContext;
+
+struct OBJExportParams {
+  bool export_selected_objects;
+  bool export_uv;
+  bool export_normals;
+  /** Convert from Blender's Z-up space to the Y-up space most OBJ readers expect. */
+  bool use_y_up;
+};
+
+/* Export the evaluated meshes of the visible objects in the scene to a Wavefront OBJ file.
+ * Returns false when the file could not be written. */
+bool OBJ_export(struct bContext *C, const char *filepath, const struct OBJExportParams *params);
+
+#ifdef __cplusplus
+}
+#endif
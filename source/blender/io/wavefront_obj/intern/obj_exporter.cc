@@ -0,0 +1,285 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup obj
+ *
+ * Wavefront OBJ exporter. The lines of every element array are formatted in parallel in chunks,
+ * and the chunks are then written to the file in order.
+ */
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+
+#include "BKE_blender_version.h"
+#include "BKE_context.h"
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
+#include "BLI_task.hh"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_query.h"
+
+#include "DNA_layer_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "IO_wavefront_obj.h"
+
+namespace blender::io::obj {
+
+/* Number of elements formatted by one task. */
+static constexpr int64_t chunk_size = 16384;
+/* Number of formatted chunks kept in memory before they are written, this bounds the memory used
+ * by the text buffers for very large meshes. */
+static constexpr int64_t chunks_per_batch = 64;
+
+class FormatBuffer {
+ private:
+  std::string text_;
+
+ public:
+  void clear()
+  {
+    text_.clear();
+  }
+
+  const std::string &text() const
+  {
+    return text_;
+  }
+
+  void append(const char *format, ...) ATTR_PRINTF_FORMAT(2, 3)
+  {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    const int len = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (len > 0) {
+      text_.append(line, std::min<size_t>(len, sizeof(line) - 1));
+    }
+  }
+};
+
+/**
+ * Call \a format_fn for every element index in `[0, elements_num)` from multiple threads, and
+ * write the resulting text to \a file in the order of the elements.
+ */
+template<typename FormatFn>
+static void write_elements_parallel(FILE *file,
+                                    const int64_t elements_num,
+                                    const FormatFn &format_fn)
+{
+  const int64_t chunks_num = (elements_num + chunk_size - 1) / chunk_size;
+  Array<FormatBuffer> buffers(std::min(chunks_num, chunks_per_batch));
+
+  for (int64_t batch_start = 0; batch_start < chunks_num; batch_start += chunks_per_batch) {
+    const int64_t batch_size = std::min(chunks_per_batch, chunks_num - batch_start);
+    parallel_for(IndexRange(batch_size), 1, [&](IndexRange range) {
+      for (const int64_t i : range) {
+        FormatBuffer &buffer = buffers[i];
+        buffer.clear();
+        const int64_t first = (batch_start + i) * chunk_size;
+        const int64_t last = std::min(first + chunk_size, elements_num);
+        for (int64_t element = first; element < last; element++) {
+          format_fn(buffer, element);
+        }
+      }
+    });
+    for (const int64_t i : IndexRange(batch_size)) {
+      const std::string &text = buffers[i].text();
+      fwrite(text.data(), 1, text.size(), file);
+    }
+  }
+}
+
+class OBJWriter {
+ private:
+  FILE *file_;
+  const OBJExportParams &params_;
+  /* OBJ indices are one-based and global to the file. */
+  int64_t vertex_offset_ = 1;
+  int64_t uv_offset_ = 1;
+  int64_t normal_offset_ = 1;
+
+ public:
+  OBJWriter(FILE *file, const OBJExportParams &params) : file_(file), params_(params)
+  {
+  }
+
+  void write_header()
+  {
+    fprintf(file_, "# Blender %s\n# www.blender.org\n", BKE_blender_version_string());
+  }
+
+  void write_mesh_object(const Object *object, const Mesh *mesh)
+  {
+    float world_mat[4][4];
+    if (params_.use_y_up) {
+      const float axis_mat[4][4] = {{1, 0, 0, 0}, {0, 0, -1, 0}, {0, 1, 0, 0}, {0, 0, 0, 1}};
+      mul_m4_m4m4(world_mat, axis_mat, object->obmat);
+    }
+    else {
+      copy_m4_m4(world_mat, object->obmat);
+    }
+    float normal_mat[3][3];
+    copy_m3_m4(normal_mat, world_mat);
+    invert_m3(normal_mat);
+    transpose_m3(normal_mat);
+    /* Mirroring transforms flip the winding order of the faces. */
+    const bool flip_winding = is_negative_m4(world_mat);
+
+    const MVert *mvert = mesh->mvert;
+    const MLoop *mloop = mesh->mloop;
+    const MPoly *mpoly = mesh->mpoly;
+
+    fprintf(file_, "o %s\n", object->id.name + 2);
+
+    write_elements_parallel(file_, mesh->totvert, [&](FormatBuffer &buffer, const int64_t i) {
+      float co[3];
+      mul_v3_m4v3(co, world_mat, mvert[i].co);
+      buffer.append("v %.6f %.6f %.6f\n", co[0], co[1], co[2]);
+    });
+
+    const MLoopUV *mloopuv = params_.export_uv ? static_cast<const MLoopUV *>(
+                                                     CustomData_get_layer(&mesh->ldata,
+                                                                          CD_MLOOPUV)) :
+                                                 nullptr;
+    if (mloopuv != nullptr) {
+      write_elements_parallel(file_, mesh->totloop, [&](FormatBuffer &buffer, const int64_t i) {
+        buffer.append("vt %.6f %.6f\n", mloopuv[i].uv[0], mloopuv[i].uv[1]);
+      });
+    }
+
+    /* Normals are written per face corner, like the USD exporter does. */
+    if (params_.export_normals) {
+      const float(*lnors)[3] = static_cast<const float(*)[3]>(
+          CustomData_get_layer(&mesh->ldata, CD_NORMAL));
+      write_elements_parallel(file_, mesh->totpoly, [&](FormatBuffer &buffer, const int64_t i) {
+        const MPoly &poly = mpoly[i];
+        float poly_no[3];
+        if (lnors == nullptr && !(poly.flag & ME_SMOOTH)) {
+          BKE_mesh_calc_poly_normal(&poly, &mloop[poly.loopstart], mvert, poly_no);
+        }
+        for (int loop_index = poly.loopstart; loop_index < poly.loopstart + poly.totloop;
+             loop_index++) {
+          float no[3];
+          if (lnors != nullptr) {
+            copy_v3_v3(no, lnors[loop_index]);
+          }
+          else if (poly.flag & ME_SMOOTH) {
+            normal_short_to_float_v3(no, mvert[mloop[loop_index].v].no);
+          }
+          else {
+            copy_v3_v3(no, poly_no);
+          }
+          mul_m3_v3(normal_mat, no);
+          normalize_v3(no);
+          buffer.append("vn %.4f %.4f %.4f\n", no[0], no[1], no[2]);
+        }
+      });
+    }
+
+    write_elements_parallel(file_, mesh->totpoly, [&](FormatBuffer &buffer, const int64_t i) {
+      const MPoly &poly = mpoly[i];
+      buffer.append("f");
+      for (int corner = 0; corner < poly.totloop; corner++) {
+        const int loop_index = poly.loopstart +
+                               (flip_winding ? poly.totloop - 1 - corner : corner);
+        const int64_t v = vertex_offset_ + mloop[loop_index].v;
+        const int64_t vt = uv_offset_ + loop_index;
+        const int64_t vn = normal_offset_ + loop_index;
+        if (mloopuv != nullptr && params_.export_normals) {
+          buffer.append(" %lld/%lld/%lld", (long long)v, (long long)vt, (long long)vn);
+        }
+        else if (mloopuv != nullptr) {
+          buffer.append(" %lld/%lld", (long long)v, (long long)vt);
+        }
+        else if (params_.export_normals) {
+          buffer.append(" %lld//%lld", (long long)v, (long long)vn);
+        }
+        else {
+          buffer.append(" %lld", (long long)v);
+        }
+      }
+      buffer.append("\n");
+    });
+
+    vertex_offset_ += mesh->totvert;
+    if (mloopuv != nullptr) {
+      uv_offset_ += mesh->totloop;
+    }
+    if (params_.export_normals) {
+      normal_offset_ += mesh->totloop;
+    }
+  }
+};
+
+static bool export_file(Depsgraph *depsgraph, const char *filepath, const OBJExportParams &params)
+{
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    fprintf(stderr, "OBJ export: could not open '%s' for writing\n", filepath);
+    return false;
+  }
+
+  OBJWriter writer(file, params);
+  writer.write_header();
+
+  DEG_OBJECT_ITER_BEGIN (depsgraph,
+                         object,
+                         DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                             DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET | DEG_ITER_OBJECT_FLAG_VISIBLE |
+                             DEG_ITER_OBJECT_FLAG_DUPLI) {
+    if (object->type != OB_MESH) {
+      continue;
+    }
+    if (params.export_selected_objects && !(object->base_flag & BASE_SELECTED)) {
+      continue;
+    }
+    const Mesh *mesh = BKE_object_get_evaluated_mesh(object);
+    if (mesh == nullptr || mesh->totvert == 0) {
+      continue;
+    }
+    writer.write_mesh_object(object, mesh);
+  }
+  DEG_OBJECT_ITER_END;
+
+  const bool ok = !ferror(file);
+  fclose(file);
+  return ok;
+}
+
+}  // namespace blender::io::obj
+
+bool OBJ_export(bContext *C, const char *filepath, const OBJExportParams *params)
+{
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+  return blender::io::obj::export_file(depsgraph, filepath, *params);
+}
@@ -633,6 +633,14 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Index of the keyframe at the end of the segment that was found when the curve was evaluated
+   * last time. It is checked first by the next evaluation, which mostly happens nearby.
+   * Only a hint for the search, it is not thread safe and may be out of date.
+   */
+  int eval_segment_index;
+  char _pad1[4];
 } FCurve;
 
 /* user-editable flags/settings */
@@ -182,6 +182,9 @@ typedef struct LightCache {
   /* All lightprobes data contained in the cache. */
   LightProbeCache *cube_data;
   LightGridCache *grid_data;
+  /** Hash of the scene content seen by each cubemap when it was baked. Used to only rebake the
+   * cubemaps affected by a change. */
+  unsigned int *cube_hash;
 } LightCache;
 
 /* Bump the version number for lightcache data structure changes. */
@@ -189,6 +189,13 @@ typedef struct Object_Runtime {
   /** Runtime evaluated curve-specific data, not stored in the file. */
   struct CurveCache *curve_cache;
 
+  /**
+   * Mesh after the last constructive modifier of the stack, kept across evaluations so that
+   * changes to the deform modifiers following it don't evaluate the whole stack again.
+   * Is not freed with the other evaluated data, see #BKE_object_modifier_stack_cache_free.
+   */
+  struct ModifierStackCache *modifier_stack_cache;
+
   unsigned short local_collections_bits;
   short _pad2[3];
 } Object_Runtime;
@@ -863,6 +863,16 @@ bool RNA_struct_is_a(const StructRNA *type, const StructRNA *srna)
   return false;
 }
 
+static PropertyRNA *rna_struct_find_property_listbase(ListBase *lb, const char *identifier)
+{
+  LISTBASE_FOREACH (PropertyRNA *, prop, lb) {
+    if (!(prop->flag_internal & PROP_INTERN_BUILTIN) && STREQ(prop->identifier, identifier)) {
+      return prop;
+    }
+  }
+  return NULL;
+}
+
 PropertyRNA *RNA_struct_find_property(PointerRNA *ptr, const char *identifier)
 {
   if (identifier[0] == '[' && identifier[1] == '"') { /* "  (dummy comment to avoid confusing some
@@ -876,12 +886,19 @@ PropertyRNA *RNA_struct_find_property(PointerRNA *ptr, const char *identifier)
     }
   }
   else {
-    /* most common case */
-    PropertyRNA *iterprop = RNA_struct_iterator_property(ptr->type);
-    PointerRNA propptr;
-
-    if (RNA_property_collection_lookup_string(ptr, iterprop, identifier, &propptr)) {
-      return propptr.data;
+    /* most common case, look up the properties hash directly instead of going through the
+     * "rna_properties" collection, same as #rna_builtin_properties_lookup_string. */
+    for (StructRNA *srna = ptr->type; srna; srna = srna->base) {
+      PropertyRNA *prop;
+      if (srna->cont.prophash) {
+        prop = BLI_ghash_lookup(srna->cont.prophash, identifier);
+      }
+      else {
+        prop = rna_struct_find_property_listbase(&srna->cont.properties, identifier);
+      }
+      if (prop) {
+        return prop;
+      }
     }
   }
 
@@ -4541,6 +4558,17 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        /* Items holding nothing but the property are copied at once. */
+        if (out.stride == size) {
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
@@ -807,6 +807,11 @@ void RNA_struct_free(BlenderRNA *brna, StructRNA *srna)
   }
 #  endif
 
+  if (srna->cont.prophash) {
+    BLI_ghash_free(srna->cont.prophash, NULL, NULL);
+    srna->cont.prophash = NULL;
+  }
+
   for (prop = srna->cont.properties.first; prop; prop = nextprop) {
     nextprop = prop->next;
 
@@ -1041,6 +1046,18 @@ StructRNA *RNA_def_struct_ptr(BlenderRNA *brna, const char *identifier, StructRN
     }
   }
 
+#ifdef RNA_RUNTIME
+  if (!DefRNA.preprocess) {
+    /* Registered types get a property hash as well, see #RNA_init. */
+    srna->cont.prophash = BLI_ghash_str_new("RNA_def_struct_ptr gh");
+    LISTBASE_FOREACH (PropertyRNA *, prop_iter, &srna->cont.properties) {
+      if (!(prop_iter->flag_internal & PROP_INTERN_BUILTIN)) {
+        BLI_ghash_insert(srna->cont.prophash, (void *)prop_iter->identifier, prop_iter);
+      }
+    }
+  }
+#endif
+
   return srna;
 }
 
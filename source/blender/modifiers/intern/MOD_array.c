@@ -28,6 +28,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -353,12 +354,36 @@ static void mesh_merge_transform(Mesh *result,
   }
 }
 
+typedef struct ArrayChunkTransformData {
+  MVert *mvert;
+  const float (*offset)[4];
+  bool use_recalc_normals;
+} ArrayChunkTransformData;
+
+static void array_chunk_transform_fn(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ArrayChunkTransformData *data = userdata;
+  MVert *mv = &data->mvert[i];
+  mul_m4_v3(data->offset, mv->co);
+
+  /* We have to correct normals too, if we do not tag them as dirty! */
+  if (!data->use_recalc_normals) {
+    float no[3];
+    normal_short_to_float_v3(no, mv->no);
+    mul_mat3_m4_v3(data->offset, no);
+    normalize_v3(no);
+    normal_float_to_short_v3(mv->no, no);
+  }
+}
+
 static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
                                    const ModifierEvalContext *ctx,
                                    Mesh *mesh)
 {
   const MVert *src_mvert;
-  MVert *mv, *mv_prev, *result_dm_verts;
+  MVert *result_dm_verts;
 
   MEdge *me;
   MLoop *ml;
@@ -569,6 +594,10 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
   first_chunk_start = 0;
   first_chunk_nverts = chunk_nverts;
 
+  TaskParallelSettings transform_settings;
+  BLI_parallel_range_settings_defaults(&transform_settings);
+  transform_settings.min_iter_per_thread = 1024;
+
   unit_m4(current_offset);
   for (c = 1; c < count; c++) {
     /* copy customdata to new geometry */
@@ -577,25 +606,17 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
     CustomData_copy_data(&mesh->ldata, &result->ldata, 0, c * chunk_nloops, chunk_nloops);
     CustomData_copy_data(&mesh->pdata, &result->pdata, 0, c * chunk_npolys, chunk_npolys);
 
-    mv_prev = result_dm_verts;
-    mv = mv_prev + c * chunk_nverts;
-
     /* recalculate cumulative offset here */
     mul_m4_m4m4(current_offset, current_offset, offset);
 
     /* apply offset to all new verts */
-    for (i = 0; i < chunk_nverts; i++, mv++, mv_prev++) {
-      mul_m4_v3(current_offset, mv->co);
-
-      /* We have to correct normals too, if we do not tag them as dirty! */
-      if (!use_recalc_normals) {
-        float no[3];
-        normal_short_to_float_v3(no, mv->no);
-        mul_mat3_m4_v3(current_offset, no);
-        normalize_v3(no);
-        normal_float_to_short_v3(mv->no, no);
-      }
-    }
+    ArrayChunkTransformData transform_data = {
+        .mvert = result_dm_verts + c * chunk_nverts,
+        .offset = (const float(*)[4])current_offset,
+        .use_recalc_normals = use_recalc_normals,
+    };
+    BLI_task_parallel_range(
+        0, chunk_nverts, &transform_data, array_chunk_transform_fn, &transform_settings);
 
     /* adjust edge vertex indices */
     me = result->medge + c * chunk_nedges;
@@ -23,14 +23,21 @@
 
 #include <cstring>
 #include <iostream>
+#include <mutex>
 #include <string>
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_disjoint_set.hh"
 #include "BLI_float3.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_mm2a.h"
 #include "BLI_listbase.h"
 #include "BLI_set.hh"
+#include "BLI_stack.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_timeit.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -50,6 +57,7 @@
 #include "BKE_lib_query.h"
 #include "BKE_mesh.h"
 #include "BKE_modifier.h"
+#include "BKE_node.h"
 #include "BKE_pointcloud.h"
 #include "BKE_screen.h"
 #include "BKE_simulation.h"
@@ -75,11 +83,13 @@
 #include "NOD_node_tree_multi_function.hh"
 #include "NOD_type_callbacks.hh"
 
+using blender::DisjointSet;
 using blender::float3;
 using blender::IndexRange;
 using blender::Map;
 using blender::Set;
 using blender::Span;
+using blender::Stack;
 using blender::StringRef;
 using blender::Vector;
 using blender::bke::PersistentCollectionHandle;
@@ -212,16 +222,263 @@ static bool isDisabled(const struct Scene *UNUSED(scene),
   return false;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Node Output Cache
+ *
+ * Outputs of nodes that took long to compute are kept between evaluations of the modifier. They
+ * are identified by a hash of everything a node depends on: its settings, the values of its
+ * unlinked inputs, the modifier inputs and recursively the same data of all nodes it depends on.
+ * When e.g. only a node after a slow Point Distribute node changes, the points can be reused.
+ *
+ * Nodes that depend on other data-blocks (e.g. objects and collections) are never cached,
+ * because those can change without anything in the node tree or the modifier changing.
+ * \{ */
+
+static uint64_t hash_combine(const uint64_t a, const uint64_t b)
+{
+  return a ^ (b + 0x9e3779b97f4a7c15 + (a << 6) + (a >> 2));
+}
+
+/**
+ * Computes a 64 bit hash of larger amounts of data, like the attributes of a mesh, by combining
+ * two 32 bit hashes with different seeds.
+ */
+class ContentHasher {
+ private:
+  BLI_HashMurmur2A low_;
+  BLI_HashMurmur2A high_;
+
+ public:
+  ContentHasher()
+  {
+    BLI_hash_mm2a_init(&low_, 0);
+    BLI_hash_mm2a_init(&high_, 0x9747b28c);
+  }
+
+  void add(const void *data, const size_t size)
+  {
+    BLI_hash_mm2a_add(&low_, (const unsigned char *)data, size);
+    BLI_hash_mm2a_add(&high_, (const unsigned char *)data, size);
+  }
+
+  void add(const int value)
+  {
+    BLI_hash_mm2a_add_int(&low_, value);
+    BLI_hash_mm2a_add_int(&high_, value);
+  }
+
+  void add(StringRef str)
+  {
+    this->add((int)str.size());
+    this->add(str.data(), (size_t)str.size());
+  }
+
+  uint64_t finish()
+  {
+    const uint64_t low = BLI_hash_mm2a_end(&low_);
+    const uint64_t high = BLI_hash_mm2a_end(&high_);
+    return (high << 32) | low;
+  }
+};
+
+/** Returns false when the layers reference data that can't be hashed. */
+static bool hash_custom_data(ContentHasher &hasher, const CustomData &data, const int size)
+{
+  hasher.add(size);
+  hasher.add(data.totlayer);
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    hasher.add(layer.type);
+    hasher.add(layer.name);
+    if (layer.data == nullptr) {
+      continue;
+    }
+    if (layer.type == CD_MDEFORMVERT) {
+      for (const MDeformVert &dvert : Span((const MDeformVert *)layer.data, size)) {
+        hasher.add(dvert.totweight);
+        hasher.add(dvert.dw, sizeof(MDeformWeight) * (size_t)dvert.totweight);
+      }
+    }
+    else if (ELEM(layer.type, CD_MDISPS, CD_GRID_PAINT_MASK, CD_BM_ELEM_PYPTR)) {
+      return false;
+    }
+    else {
+      hasher.add(layer.data, (size_t)CustomData_sizeof(layer.type) * (size_t)size);
+    }
+  }
+  return true;
+}
+
+static void hash_attribute_names(ContentHasher &hasher, const GeometryComponent &component)
+{
+  /* The order of the names is not deterministic, so the hashes are combined with a sum. */
+  uint64_t names_hash = 0;
+  for (const std::string &name : component.attribute_names()) {
+    names_hash += blender::DefaultHash<std::string>{}(name);
+  }
+  hasher.add(&names_hash, sizeof(names_hash));
+}
+
+/**
+ * Hash the data of a geometry instead of its address. Returns nothing for geometry that can't be
+ * hashed, because it references other data or is too complex.
+ */
+static std::optional<uint64_t> hash_geometry_set(const GeometrySet &geometry_set)
+{
+  if (geometry_set.has_instances() || geometry_set.has_volume()) {
+    return {};
+  }
+  ContentHasher hasher;
+  const MeshComponent *mesh_component = geometry_set.get_component_for_read<MeshComponent>();
+  if (mesh_component != nullptr && mesh_component->has_mesh()) {
+    const Mesh &mesh = *mesh_component->get_for_read();
+    hasher.add(mesh.flag);
+    hasher.add(&mesh.smoothresh, sizeof(mesh.smoothresh));
+    hasher.add(mesh.totcol);
+    hasher.add(mesh.mat, sizeof(Material *) * (size_t)mesh.totcol);
+    if (!hash_custom_data(hasher, mesh.vdata, mesh.totvert) ||
+        !hash_custom_data(hasher, mesh.edata, mesh.totedge) ||
+        !hash_custom_data(hasher, mesh.ldata, mesh.totloop) ||
+        !hash_custom_data(hasher, mesh.pdata, mesh.totpoly)) {
+      return {};
+    }
+    hash_attribute_names(hasher, *mesh_component);
+  }
+  const PointCloudComponent *pointcloud_component =
+      geometry_set.get_component_for_read<PointCloudComponent>();
+  if (pointcloud_component != nullptr && pointcloud_component->has_pointcloud()) {
+    const PointCloud &pointcloud = *pointcloud_component->get_for_read();
+    hasher.add(pointcloud.totcol);
+    hasher.add(pointcloud.mat, sizeof(Material *) * (size_t)pointcloud.totcol);
+    if (!hash_custom_data(hasher, pointcloud.pdata, pointcloud.totpoint)) {
+      return {};
+    }
+  }
+  return hasher.finish();
+}
+
+static std::optional<uint64_t> hash_socket_value(const CPPType &type, const void *value)
+{
+  if (type.is<GeometrySet>()) {
+    return hash_geometry_set(*(const GeometrySet *)value);
+  }
+  if (type.is<PersistentObjectHandle>() || type.is<PersistentCollectionHandle>()) {
+    /* The referenced data-block can change without the handle changing. */
+    return {};
+  }
+  return type.hash(value);
+}
+
+/** Copies of the outputs of a node, in the order of its available output sockets. */
+struct CachedNodeOutputs {
+  Vector<GMutablePointer> values;
+
+  ~CachedNodeOutputs()
+  {
+    for (GMutablePointer value : values) {
+      value.destruct();
+      MEM_freeN(value.get());
+    }
+  }
+};
+
+/**
+ * Is stored in the runtime data of the modifier, so that it is kept when the depsgraph
+ * re-evaluates the copy of the modifier. Only the outputs that have been used or computed during
+ * the last evaluation are kept.
+ */
+class GeometryNodesCache : blender::NonCopyable, blender::NonMovable {
+ private:
+  std::mutex mutex_;
+  Map<uint64_t, std::unique_ptr<CachedNodeOutputs>> outputs_by_key_;
+
+ public:
+  /**
+   * Outputs stay valid until #remove_unused is called, so they can be used without holding the
+   * lock.
+   */
+  const CachedNodeOutputs *lookup(const uint64_t key)
+  {
+    std::lock_guard lock{mutex_};
+    const std::unique_ptr<CachedNodeOutputs> *outputs = outputs_by_key_.lookup_ptr(key);
+    return (outputs == nullptr) ? nullptr : outputs->get();
+  }
+
+  /** Store copies of the given values, that don't reference data owned by someone else. */
+  void add(const uint64_t key, Span<GMutablePointer> values)
+  {
+    std::unique_ptr<CachedNodeOutputs> outputs = std::make_unique<CachedNodeOutputs>();
+    for (const GMutablePointer value : values) {
+      const CPPType &type = *value.type();
+      void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+      type.copy_to_uninitialized(value.get(), buffer);
+      if (type.is<GeometrySet>()) {
+        /* The geometry might still reference the mesh that has been passed to the modifier. */
+        ((GeometrySet *)buffer)->ensure_owns_direct_data();
+      }
+      outputs->values.append({type, buffer});
+    }
+    std::lock_guard lock{mutex_};
+    /* Another thread might have computed the same outputs already. */
+    outputs_by_key_.add(key, std::move(outputs));
+  }
+
+  void remove_unused(const Set<uint64_t> &used_keys)
+  {
+    std::lock_guard lock{mutex_};
+    Vector<uint64_t> keys_to_remove;
+    for (const uint64_t key : outputs_by_key_.keys()) {
+      if (!used_keys.contains(key)) {
+        keys_to_remove.append(key);
+      }
+    }
+    for (const uint64_t key : keys_to_remove) {
+      outputs_by_key_.remove(key);
+    }
+  }
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("GeometryNodesCache")
+};
+
+/** \} */
+
+/**
+ * Evaluates a node tree by computing the nodes that the group outputs depend on. When a node has
+ * inputs that depend on different nodes, which don't share any dependencies, those branches are
+ * computed in parallel.
+ */
 class GeometryNodesEvaluator {
  private:
+  /**
+   * Protects #allocator_, #node_allocators_, #value_by_input_ and #node_timings_, which are
+   * accessed from all threads that compute nodes.
+   */
+  std::mutex mutex_;
   blender::LinearAllocator<> allocator_;
+  /** Every node execution gets its own allocator, so that nodes don't have to lock. */
+  Vector<std::unique_ptr<blender::LinearAllocator<>>> node_allocators_;
+  /** Temporary buffers of multi-functions are reused between nodes. */
+  MFBufferPool buffer_pool_;
   Map<const DInputSocket *, GMutablePointer> value_by_input_;
+  /** Only filled when timings are printed. */
+  Vector<std::pair<const DNode *, blender::timeit::Nanoseconds>> node_timings_;
+  bool record_timings_;
   Vector<const DInputSocket *> group_outputs_;
   blender::nodes::MultiFunctionByNode &mf_by_node_;
   const blender::nodes::DataTypeConversions &conversions_;
   const PersistentDataHandleMap &handle_map_;
   const Object *self_object_;
   Depsgraph *depsgraph_;
+  /** Might be null, when node outputs should not be cached. */
+  GeometryNodesCache *cache_;
+  /** Protects #cache_key_by_node_, keys are computed lazily by the threads that compute nodes. */
+  std::mutex cache_key_mutex_;
+  /** Nodes without a key can't be cached. */
+  Map<const DNode *, std::optional<uint64_t>> cache_key_by_node_;
+  /** The hashes have to be computed before the values are passed to the nodes. */
+  Map<const DOutputSocket *, std::optional<uint64_t>> group_input_hashes_;
+
+  /** Outputs of faster nodes are not cached, because copying them can take as long. */
+  static constexpr std::chrono::milliseconds min_duration_to_cache{10};
 
  public:
   GeometryNodesEvaluator(const Map<const DOutputSocket *, GMutablePointer> &group_input_data,
@@ -229,15 +486,22 @@ class GeometryNodesEvaluator {
                          blender::nodes::MultiFunctionByNode &mf_by_node,
                          const PersistentDataHandleMap &handle_map,
                          const Object *self_object,
-                         Depsgraph *depsgraph)
+                         Depsgraph *depsgraph,
+                         GeometryNodesCache *cache)
       : group_outputs_(std::move(group_outputs)),
         mf_by_node_(mf_by_node),
         conversions_(blender::nodes::get_implicit_type_conversions()),
         handle_map_(handle_map),
         self_object_(self_object),
-        depsgraph_(depsgraph)
+        depsgraph_(depsgraph),
+        cache_(cache)
   {
+    record_timings_ = (G.debug & G_DEBUG_DEPSGRAPH_TIME) != 0;
     for (auto item : group_input_data.items()) {
+      if (cache_ != nullptr) {
+        group_input_hashes_.add_new(item.key,
+                                    hash_socket_value(*item.value.type(), item.value.get()));
+      }
       this->forward_to_inputs(*item.key, item.value);
     }
   }
@@ -252,13 +516,57 @@ class GeometryNodesEvaluator {
     for (GMutablePointer value : value_by_input_.values()) {
       value.destruct();
     }
+    if (cache_ != nullptr) {
+      /* Keep the outputs of nodes that have been used directly and of the nodes they depend on. */
+      Set<uint64_t> used_keys;
+      for (const std::optional<uint64_t> &key : cache_key_by_node_.values()) {
+        if (key.has_value()) {
+          used_keys.add(*key);
+        }
+      }
+      cache_->remove_unused(used_keys);
+    }
+    if (record_timings_) {
+      this->print_node_timings();
+    }
     return results;
   }
 
  private:
+  std::optional<GMutablePointer> try_extract_input_value(const DInputSocket &socket)
+  {
+    std::lock_guard lock{mutex_};
+    return value_by_input_.pop_try(&socket);
+  }
+
+  bool input_is_computed(const DInputSocket &socket)
+  {
+    std::lock_guard lock{mutex_};
+    return value_by_input_.contains(&socket);
+  }
+
+  void add_input_value(const DInputSocket &socket, GMutablePointer value)
+  {
+    std::lock_guard lock{mutex_};
+    value_by_input_.add_new(&socket, value);
+  }
+
+  void *allocate_value(const CPPType &type)
+  {
+    std::lock_guard lock{mutex_};
+    return allocator_.allocate(type.size(), type.alignment());
+  }
+
+  blender::LinearAllocator<> &new_node_allocator()
+  {
+    std::lock_guard lock{mutex_};
+    node_allocators_.append(std::make_unique<blender::LinearAllocator<>>());
+    return *node_allocators_.last();
+  }
+
   GMutablePointer get_input_value(const DInputSocket &socket_to_compute)
   {
-    std::optional<GMutablePointer> value = value_by_input_.pop_try(&socket_to_compute);
+    std::optional<GMutablePointer> value = this->try_extract_input_value(socket_to_compute);
     if (value.has_value()) {
       /* This input has been computed before, return it directly. */
       return *value;
@@ -281,7 +589,100 @@ class GeometryNodesEvaluator {
     /* Compute the socket now. */
     const DOutputSocket &from_socket = *from_sockets[0];
     this->compute_output_and_forward(from_socket);
-    return value_by_input_.pop(&socket_to_compute);
+    value = this->try_extract_input_value(socket_to_compute);
+    BLI_assert(value.has_value());
+    return *value;
+  }
+
+  /**
+   * Add the nodes that have to be computed before the given output socket can be computed to
+   * the set. This does not include nodes that have been computed already.
+   */
+  void find_nodes_to_compute(const DOutputSocket &socket, Set<const DNode *> &r_nodes)
+  {
+    if (!socket.is_available()) {
+      /* Unavailable outputs get a default value without executing the node. */
+      return;
+    }
+    Stack<const DNode *> nodes_to_check;
+    if (r_nodes.add(&socket.node())) {
+      nodes_to_check.push(&socket.node());
+    }
+    while (!nodes_to_check.is_empty()) {
+      const DNode &node = *nodes_to_check.pop();
+      for (const DInputSocket *input_socket : node.inputs()) {
+        if (!input_socket->is_available() || this->input_is_computed(*input_socket)) {
+          continue;
+        }
+        for (const DOutputSocket *origin_socket : input_socket->linked_sockets()) {
+          if (origin_socket->is_available() && r_nodes.add(&origin_socket->node())) {
+            nodes_to_check.push(&origin_socket->node());
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Compute the values of all node inputs that are linked to other nodes. Inputs whose origins
+   * don't depend on common nodes are computed in parallel. Inputs that share dependencies are
+   * computed one after another, so that every node is still executed only once.
+   */
+  void compute_linked_inputs(const DNode &node)
+  {
+    Vector<const DInputSocket *> inputs_to_compute;
+    Vector<const DOutputSocket *> origins_to_compute;
+    for (const DInputSocket *input_socket : node.inputs()) {
+      if (!input_socket->is_available() || input_socket->linked_sockets().size() != 1) {
+        continue;
+      }
+      if (this->input_is_computed(*input_socket)) {
+        continue;
+      }
+      inputs_to_compute.append(input_socket);
+      origins_to_compute.append(input_socket->linked_sockets()[0]);
+    }
+    if (inputs_to_compute.size() < 2) {
+      /* Nothing to compute in parallel, the inputs are computed when they are extracted. */
+      return;
+    }
+
+    /* Group the origins that depend on common nodes. */
+    DisjointSet groups{inputs_to_compute.size()};
+    Map<const DNode *, int> origin_index_by_node;
+    for (const int i : origins_to_compute.index_range()) {
+      Set<const DNode *> nodes_to_compute;
+      this->find_nodes_to_compute(*origins_to_compute[i], nodes_to_compute);
+      for (const DNode *node_to_compute : nodes_to_compute) {
+        const int other_index = origin_index_by_node.lookup_or_add(node_to_compute, i);
+        if (other_index != i) {
+          groups.join(i, other_index);
+        }
+      }
+    }
+    Map<int64_t, int> group_index_by_root;
+    Vector<Vector<int>> input_groups;
+    for (const int i : inputs_to_compute.index_range()) {
+      const int group_index = group_index_by_root.lookup_or_add_cb(groups.find_root(i), [&]() {
+        input_groups.append({});
+        return input_groups.size() - 1;
+      });
+      input_groups[group_index].append(i);
+    }
+    if (input_groups.size() < 2) {
+      return;
+    }
+
+    blender::parallel_for(input_groups.index_range(), 1, [&](IndexRange range) {
+      for (const int group_index : range) {
+        for (const int i : input_groups[group_index]) {
+          /* The input might have been computed together with another input of the group. */
+          if (!this->input_is_computed(*inputs_to_compute[i])) {
+            this->compute_output_and_forward(*origins_to_compute[i]);
+          }
+        }
+      }
+    });
   }
 
   void compute_output_and_forward(const DOutputSocket &socket_to_compute)
@@ -292,14 +693,29 @@ class GeometryNodesEvaluator {
     if (!socket_to_compute.is_available()) {
       /* If the output is not available, use a default value. */
       const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket_to_compute.typeinfo());
-      void *buffer = allocator_.allocate(type.size(), type.alignment());
+      void *buffer = this->allocate_value(type);
       type.copy_to_uninitialized(type.default_value(), buffer);
       this->forward_to_inputs(socket_to_compute, {type, buffer});
       return;
     }
 
+    if (bnode.type == FN_NODE_SWITCH) {
+      this->execute_switch_node(node);
+      return;
+    }
+
+    std::optional<uint64_t> cache_key;
+    if (cache_ != nullptr) {
+      cache_key = this->node_cache_key(node);
+      if (cache_key.has_value() && this->try_forward_cached_outputs(node, *cache_key)) {
+        return;
+      }
+    }
+
     /* Prepare inputs required to execute the node. */
-    GValueMap<StringRef> node_inputs_map{allocator_};
+    this->compute_linked_inputs(node);
+    blender::LinearAllocator<> &node_allocator = this->new_node_allocator();
+    GValueMap<StringRef> node_inputs_map{node_allocator};
     for (const DInputSocket *input_socket : node.inputs()) {
       if (input_socket->is_available()) {
         GMutablePointer value = this->get_input_value(*input_socket);
@@ -308,21 +724,160 @@ class GeometryNodesEvaluator {
     }
 
     /* Execute the node. */
-    GValueMap<StringRef> node_outputs_map{allocator_};
+    GValueMap<StringRef> node_outputs_map{node_allocator};
     GeoNodeExecParams params{
         bnode, node_inputs_map, node_outputs_map, handle_map_, self_object_, depsgraph_};
-    this->execute_node(node, params);
+    blender::timeit::Nanoseconds duration{0};
+    if (record_timings_ || cache_key.has_value()) {
+      const blender::timeit::TimePoint start = blender::timeit::Clock::now();
+      this->execute_node(node, params, node_allocator);
+      duration = blender::timeit::Clock::now() - start;
+      if (record_timings_) {
+        std::lock_guard lock{mutex_};
+        node_timings_.append({&node, duration});
+      }
+    }
+    else {
+      this->execute_node(node, params, node_allocator);
+    }
+
+    Vector<const DOutputSocket *> output_sockets;
+    Vector<GMutablePointer> output_values;
+    for (const DOutputSocket *output_socket : node.outputs()) {
+      if (output_socket->is_available()) {
+        output_sockets.append(output_socket);
+        output_values.append(node_outputs_map.extract(output_socket->identifier()));
+      }
+    }
+    if (cache_key.has_value() && duration >= min_duration_to_cache &&
+        values_are_cacheable(output_values)) {
+      cache_->add(*cache_key, output_values);
+    }
 
     /* Forward computed outputs to linked input sockets. */
+    for (const int i : output_sockets.index_range()) {
+      this->forward_to_inputs(*output_sockets[i], output_values[i]);
+    }
+  }
+
+  static bool values_are_cacheable(Span<GMutablePointer> values)
+  {
+    for (const GMutablePointer value : values) {
+      /* Instances reference objects and collections. */
+      if (value.type()->is<GeometrySet>() && value.get<GeometrySet>()->has_instances()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool try_forward_cached_outputs(const DNode &node, const uint64_t cache_key)
+  {
+    const CachedNodeOutputs *cached_outputs = cache_->lookup(cache_key);
+    if (cached_outputs == nullptr) {
+      return false;
+    }
+    int value_index = 0;
     for (const DOutputSocket *output_socket : node.outputs()) {
       if (output_socket->is_available()) {
-        GMutablePointer value = node_outputs_map.extract(output_socket->identifier());
-        this->forward_to_inputs(*output_socket, value);
+        const GMutablePointer cached_value = cached_outputs->values[value_index];
+        const CPPType &type = *cached_value.type();
+        void *buffer = this->allocate_value(type);
+        type.copy_to_uninitialized(cached_value.get(), buffer);
+        this->forward_to_inputs(*output_socket, {type, buffer});
+        value_index++;
       }
     }
+    return true;
+  }
+
+  /**
+   * Returns a hash of everything the outputs of the node depend on, or nothing when the node can't
+   * be cached.
+   */
+  std::optional<uint64_t> node_cache_key(const DNode &node)
+  {
+    std::lock_guard lock{cache_key_mutex_};
+    return this->node_cache_key_locked(node);
+  }
+
+  std::optional<uint64_t> node_cache_key_locked(const DNode &node)
+  {
+    const std::optional<uint64_t> *cached_key = cache_key_by_node_.lookup_ptr(&node);
+    if (cached_key != nullptr) {
+      return *cached_key;
+    }
+    const std::optional<uint64_t> key = this->compute_node_cache_key(node);
+    cache_key_by_node_.add_new(&node, key);
+    return key;
+  }
+
+  std::optional<uint64_t> compute_node_cache_key(const DNode &node)
+  {
+    const bNode &bnode = *node.bnode();
+    if (bnode.id != nullptr) {
+      return {};
+    }
+    uint64_t key = blender::DefaultHash<StringRef>{}(bnode.idname);
+    key = hash_combine(key, blender::DefaultHash<short>{}(bnode.custom1));
+    key = hash_combine(key, blender::DefaultHash<short>{}(bnode.custom2));
+    key = hash_combine(key, blender::DefaultHash<float>{}(bnode.custom3));
+    key = hash_combine(key, blender::DefaultHash<float>{}(bnode.custom4));
+    if (bnode.storage != nullptr) {
+      ContentHasher hasher;
+      hasher.add(bnode.storage, MEM_allocN_len(bnode.storage));
+      key = hash_combine(key, hasher.finish());
+    }
+    for (const DInputSocket *input_socket : node.inputs()) {
+      if (!input_socket->is_available()) {
+        continue;
+      }
+      const std::optional<uint64_t> input_key = this->input_cache_key(*input_socket);
+      if (!input_key.has_value()) {
+        return {};
+      }
+      key = hash_combine(key, *input_key);
+    }
+    return key;
+  }
+
+  std::optional<uint64_t> input_cache_key(const DInputSocket &socket)
+  {
+    Span<const DOutputSocket *> from_sockets = socket.linked_sockets();
+    if (from_sockets.size() == 0) {
+      const bNodeSocket *bsocket = (socket.linked_group_inputs().size() == 0) ?
+                                       socket.bsocket() :
+                                       socket.linked_group_inputs()[0]->bsocket();
+      if (ELEM(bsocket->type, SOCK_OBJECT, SOCK_COLLECTION)) {
+        return {};
+      }
+      GMutablePointer value = this->get_unlinked_input_value(socket);
+      const std::optional<uint64_t> hash = hash_socket_value(*value.type(), value.get());
+      value.destruct();
+      return hash;
+    }
+
+    const DOutputSocket &from_socket = *from_sockets[0];
+    const std::optional<uint64_t> *group_input_hash = group_input_hashes_.lookup_ptr(
+        &from_socket);
+    if (group_input_hash != nullptr) {
+      return *group_input_hash;
+    }
+    if (!from_socket.is_available()) {
+      /* Unavailable outputs always have the default value. */
+      return blender::DefaultHash<StringRef>{}(from_socket.idname());
+    }
+    const std::optional<uint64_t> from_node_key = this->node_cache_key_locked(
+        from_socket.node());
+    if (!from_node_key.has_value()) {
+      return {};
+    }
+    return hash_combine(*from_node_key, (uint64_t)from_socket.index());
   }
 
-  void execute_node(const DNode &node, GeoNodeExecParams params)
+  void execute_node(const DNode &node,
+                    GeoNodeExecParams params,
+                    blender::LinearAllocator<> &node_allocator)
   {
     const bNode &bnode = params.node();
 
@@ -335,7 +890,7 @@ class GeometryNodesEvaluator {
     /* Use the multi-function implementation if it exists. */
     const MultiFunction *multi_function = mf_by_node_.lookup_default(&node, nullptr);
     if (multi_function != nullptr) {
-      this->execute_multi_function_node(node, params, *multi_function);
+      this->execute_multi_function_node(node, params, *multi_function, node_allocator);
       return;
     }
 
@@ -345,9 +900,11 @@ class GeometryNodesEvaluator {
 
   void execute_multi_function_node(const DNode &node,
                                    GeoNodeExecParams params,
-                                   const MultiFunction &fn)
+                                   const MultiFunction &fn,
+                                   blender::LinearAllocator<> &node_allocator)
   {
     MFContextBuilder fn_context;
+    fn_context.set_buffer_pool(buffer_pool_);
     MFParamsBuilder fn_params{fn, 1};
     Vector<GMutablePointer> input_data;
     for (const DInputSocket *dsocket : node.inputs()) {
@@ -361,7 +918,7 @@ class GeometryNodesEvaluator {
     for (const DOutputSocket *dsocket : node.outputs()) {
       if (dsocket->is_available()) {
         const CPPType &type = *blender::nodes::socket_cpp_type_get(*dsocket->typeinfo());
-        void *buffer = allocator_.allocate(type.size(), type.alignment());
+        void *buffer = node_allocator.allocate(type.size(), type.alignment());
         fn_params.add_uninitialized_single_output(GMutableSpan(type, buffer, 1));
         output_data.append(GMutablePointer(type, buffer));
       }
@@ -381,6 +938,51 @@ class GeometryNodesEvaluator {
     }
   }
 
+  /**
+   * Only the input that is selected by the switch node is computed, the other branch is not
+   * evaluated at all. This is why this node can't use the generic code path, which computes all
+   * inputs before executing a node.
+   */
+  void execute_switch_node(const DNode &node)
+  {
+    Vector<const DInputSocket *> available_inputs;
+    for (const DInputSocket *input_socket : node.inputs()) {
+      if (input_socket->is_available()) {
+        available_inputs.append(input_socket);
+      }
+    }
+    /* The switch input, followed by the false and true inputs of the selected type. */
+    BLI_assert(available_inputs.size() == 3);
+
+    GMutablePointer switch_value = this->get_input_value(*available_inputs[0]);
+    const bool use_true_input = *switch_value.get<bool>();
+    switch_value.destruct();
+
+    const DInputSocket &selected_input = *available_inputs[use_true_input ? 2 : 1];
+    GMutablePointer value = this->get_input_value(selected_input);
+
+    for (const DOutputSocket *output_socket : node.outputs()) {
+      if (output_socket->is_available()) {
+        this->forward_to_inputs(*output_socket, value);
+        return;
+      }
+    }
+    value.destruct();
+  }
+
+  /** Print how long every node took to execute, the slowest nodes first. */
+  void print_node_timings()
+  {
+    std::sort(node_timings_.begin(), node_timings_.end(), [](const auto &a, const auto &b) {
+      return a.second > b.second;
+    });
+    for (const auto &item : node_timings_) {
+      std::cout << "Geometry Nodes: " << item.first->name() << ": ";
+      blender::timeit::print_duration(item.second);
+      std::cout << "\n";
+    }
+  }
+
   void execute_unknown_node(const DNode &node, GeoNodeExecParams params)
   {
     for (const DOutputSocket *socket : node.outputs()) {
@@ -404,14 +1006,14 @@ class GeometryNodesEvaluator {
         to_sockets_same_type.append(to_socket);
       }
       else {
-        void *buffer = allocator_.allocate(to_type.size(), to_type.alignment());
+        void *buffer = this->allocate_value(to_type);
         if (conversions_.is_convertible(from_type, to_type)) {
           conversions_.convert(from_type, to_type, value_to_forward.get(), buffer);
         }
         else {
           to_type.copy_to_uninitialized(to_type.default_value(), buffer);
         }
-        value_by_input_.add_new(to_socket, GMutablePointer{to_type, buffer});
+        this->add_input_value(*to_socket, GMutablePointer{to_type, buffer});
       }
     }
 
@@ -422,7 +1024,7 @@ class GeometryNodesEvaluator {
     else if (to_sockets_same_type.size() == 1) {
       /* This value is only used on one input socket, no need to copy it. */
       const DInputSocket *to_socket = to_sockets_same_type[0];
-      value_by_input_.add_new(to_socket, value_to_forward);
+      this->add_input_value(*to_socket, value_to_forward);
     }
     else {
       /* Multiple inputs use the value, make a copy for every input except for one. */
@@ -430,12 +1032,13 @@ class GeometryNodesEvaluator {
       Span<const DInputSocket *> other_to_sockets = to_sockets_same_type.as_span().drop_front(1);
       const CPPType &type = *value_to_forward.type();
 
-      value_by_input_.add_new(first_to_socket, value_to_forward);
       for (const DInputSocket *to_socket : other_to_sockets) {
-        void *buffer = allocator_.allocate(type.size(), type.alignment());
+        void *buffer = this->allocate_value(type);
         type.copy_to_uninitialized(value_to_forward.get(), buffer);
-        value_by_input_.add_new(to_socket, GMutablePointer{type, buffer});
+        this->add_input_value(*to_socket, GMutablePointer{type, buffer});
       }
+      /* Add the original value last, because other threads may extract and move it. */
+      this->add_input_value(*first_to_socket, value_to_forward);
     }
   }
 
@@ -449,7 +1052,7 @@ class GeometryNodesEvaluator {
       bsocket = socket.linked_group_inputs()[0]->bsocket();
     }
     const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket.typeinfo());
-    void *buffer = allocator_.allocate(type.size(), type.alignment());
+    void *buffer = this->allocate_value(type);
 
     if (bsocket->type == SOCK_OBJECT) {
       Object *object = ((bNodeSocketValueObject *)bsocket->default_value)->value;
@@ -929,8 +1532,18 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   Vector<const DInputSocket *> group_outputs;
   group_outputs.append(&socket_to_compute);
 
-  GeometryNodesEvaluator evaluator{
-      group_inputs, group_outputs, mf_by_node, handle_map, ctx->object, ctx->depsgraph};
+  if (nmd->modifier.runtime == nullptr) {
+    nmd->modifier.runtime = new GeometryNodesCache();
+  }
+  GeometryNodesCache *cache = static_cast<GeometryNodesCache *>(nmd->modifier.runtime);
+
+  GeometryNodesEvaluator evaluator{group_inputs,
+                                   group_outputs,
+                                   mf_by_node,
+                                   handle_map,
+                                   ctx->object,
+                                   ctx->depsgraph,
+                                   cache};
   Vector<GMutablePointer> results = evaluator.execute();
   BLI_assert(results.size() == 1);
   GMutablePointer result = results[0];
@@ -1172,6 +1785,11 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
   }
 }
 
+static void freeRuntimeData(void *runtime_data)
+{
+  delete static_cast<GeometryNodesCache *>(runtime_data);
+}
+
 static void freeData(ModifierData *md)
 {
   NodesModifierData *nmd = reinterpret_cast<NodesModifierData *>(md);
@@ -1179,6 +1797,8 @@ static void freeData(ModifierData *md)
     IDP_FreeProperty_ex(nmd->settings.properties, false);
     nmd->settings.properties = nullptr;
   }
+  freeRuntimeData(md->runtime);
+  md->runtime = nullptr;
 }
 
 static void requiredDataMask(Object *UNUSED(ob),
@@ -1222,7 +1842,7 @@ ModifierTypeInfo modifierType_Nodes = {
     /* dependsOnNormals */ nullptr,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ nullptr,
-    /* freeRuntimeData */ nullptr,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ blendWrite,
     /* blendRead */ blendRead,
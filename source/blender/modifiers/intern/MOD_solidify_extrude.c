@@ -22,6 +22,7 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "DNA_mesh_types.h"
@@ -56,6 +57,63 @@ BLI_INLINE void madd_v3v3short_fl(float r[3], const short a[3], const float f)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Even Thickness Offset
+ * \{ */
+
+typedef struct SolidifyOffsetData {
+  /** The first vertex to offset, in the original or the new shell. */
+  MVert *mvert;
+  /** Index of the original vertex for each vertex to offset, NULL when they are aligned. */
+  const uint *new_vert_arr;
+  const float (*vert_nors)[3];
+  const float *vert_angles;
+  const float *vert_accum;
+  float ofs;
+} SolidifyOffsetData;
+
+static void solidify_offset_even_fn(void *__restrict userdata,
+                                    const int iter,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SolidifyOffsetData *data = userdata;
+  const uint i_orig = (uint)iter;
+  const uint i_other = data->new_vert_arr ? data->new_vert_arr[i_orig] : i_orig;
+  if (data->vert_accum[i_other]) { /* zero if unselected */
+    madd_v3_v3fl(data->mvert[i_orig].co,
+                 data->vert_nors[i_other],
+                 data->ofs * (data->vert_angles[i_other] / data->vert_accum[i_other]));
+  }
+}
+
+/**
+ * Offset the vertices of one side of the shell along the accumulated vertex normals,
+ * each vertex only reads its own original vertex so they can be offset in parallel.
+ */
+static void solidify_offset_even(MVert *mvert,
+                                 const uint verts_len,
+                                 const uint *new_vert_arr,
+                                 const float (*vert_nors)[3],
+                                 const float *vert_angles,
+                                 const float *vert_accum,
+                                 const float ofs)
+{
+  SolidifyOffsetData data = {
+      .mvert = mvert,
+      .new_vert_arr = new_vert_arr,
+      .vert_nors = vert_nors,
+      .vert_angles = vert_angles,
+      .vert_accum = vert_accum,
+      .ofs = ofs,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, (int)verts_len, &data, solidify_offset_even_fn, &settings);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name High Quality Normal Calculation Function
  * \{ */
@@ -945,34 +1003,34 @@ Mesh *MOD_solidify_extrude_modifyMesh(ModifierData *md, const ModifierEvalContex
 #undef INVALID_PAIR
 
     if (ofs_new != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
       INIT_VERT_ARRAY_OFFSETS(false);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i_other = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (vert_accum[i_other]) { /* zero if unselected */
-          madd_v3_v3fl(
-              mv->co, vert_nors[i_other], ofs_new * (vert_angles[i_other] / vert_accum[i_other]));
-        }
-      }
+      solidify_offset_even(mv,
+                           i_end,
+                           do_shell_align ? NULL : new_vert_arr,
+                           (const float(*)[3])vert_nors,
+                           vert_angles,
+                           vert_accum,
+                           ofs_new);
     }
 
     if (ofs_orig != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
       /* same as above but swapped, intentional use of 'ofs_new' */
       INIT_VERT_ARRAY_OFFSETS(true);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i_other = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (vert_accum[i_other]) { /* zero if unselected */
-          madd_v3_v3fl(
-              mv->co, vert_nors[i_other], ofs_orig * (vert_angles[i_other] / vert_accum[i_other]));
-        }
-      }
+      solidify_offset_even(mv,
+                           i_end,
+                           do_shell_align ? NULL : new_vert_arr,
+                           (const float(*)[3])vert_nors,
+                           vert_angles,
+                           vert_accum,
+                           ofs_orig);
     }
 
     MEM_freeN(vert_angles);
@@ -182,17 +182,25 @@ void weightvg_do_mask(const ModifierEvalContext *ctx,
 
     MOD_init_texture(&t_map, ctx);
 
+    /* Only evaluate the texture for the affected vertices. */
+    if (indices) {
+      float(*tex_co_affected)[3] = MEM_malloc_arrayN(num, sizeof(*tex_co_affected), __func__);
+      for (i = 0; i < num; i++) {
+        copy_v3_v3(tex_co_affected[i], tex_co[indices[i]]);
+      }
+      MEM_freeN(tex_co);
+      tex_co = tex_co_affected;
+    }
+
+    const bool do_color_manage = tex_use_channel != MOD_WVG_MASK_TEX_USE_INT;
+    TexResult *tex_results = MEM_malloc_arrayN(num, sizeof(*tex_results), __func__);
+    BKE_texture_get_values(scene, texture, tex_co, num, tex_results, do_color_manage);
+
     /* For each weight (vertex), make the mix between org and new weights. */
     for (i = 0; i < num; i++) {
-      int idx = indices ? indices[i] : i;
-      TexResult texres;
+      const TexResult texres = tex_results[i];
       float hsv[3]; /* For HSV color space. */
-      bool do_color_manage;
-
-      do_color_manage = tex_use_channel != MOD_WVG_MASK_TEX_USE_INT;
 
-      texres.nor = NULL;
-      BKE_texture_get_value(scene, texture, tex_co[idx], &texres, do_color_manage);
       /* Get the good channel value... */
       switch (tex_use_channel) {
         case MOD_WVG_MASK_TEX_USE_INT:
@@ -228,6 +236,7 @@ void weightvg_do_mask(const ModifierEvalContext *ctx,
       }
     }
 
+    MEM_freeN(tex_results);
     MEM_freeN(tex_co);
   }
   else if ((ref_didx = BKE_object_defgroup_name_index(ob, defgrp_name)) != -1) {
@@ -49,6 +49,7 @@ void register_node_type_geo_point_rotate(void);
 void register_node_type_geo_align_rotation_to_vector(void);
 void register_node_type_geo_sample_texture(void);
 void register_node_type_geo_points_to_volume(void);
+void register_node_type_geo_attribute_proximity(void);
 
 #ifdef __cplusplus
 }
@@ -22,6 +22,7 @@
 #include "BLI_array.hh"
 #include "BLI_math_base_safe.h"
 #include "BLI_rand.hh"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 #include "DNA_pointcloud_types.h"
@@ -183,6 +184,9 @@ static void do_math_operation(Span<float> span_input,
   UNUSED_VARS_NDEBUG(success);
 }
 
+/* Number of elements that are processed at once. */
+static constexpr int64_t chunk_size = 4096;
+
 static void attribute_math_calc(GeometryComponent &component, const GeoNodeExecParams &params)
 {
   const bNode &node = params.node();
@@ -208,39 +212,54 @@ static void attribute_math_calc(GeometryComponent &component, const GeoNodeExecP
     return;
   }
 
-  /* Note that passing the data with `get_span<float>()` works
-   * because the attributes were accessed with #CD_PROP_FLOAT. */
+  ReadAttributePtr attribute_b;
   if (operation_use_input_b(operation)) {
-    ReadAttributePtr attribute_b = params.get_input_attribute(
-        "B", component, result_domain, result_type, nullptr);
+    attribute_b = params.get_input_attribute("B", component, result_domain, result_type, nullptr);
     if (!attribute_b) {
       return;
     }
-    if (operation_use_input_c(operation)) {
-      ReadAttributePtr attribute_c = params.get_input_attribute(
-          "C", component, result_domain, result_type, nullptr);
-      if (!attribute_c) {
-        return;
-      }
-      do_math_operation(attribute_a->get_span<float>(),
-                        attribute_b->get_span<float>(),
-                        attribute_c->get_span<float>(),
-                        attribute_result->get_span_for_write_only<float>(),
-                        operation);
-    }
-    else {
-      do_math_operation(attribute_a->get_span<float>(),
-                        attribute_b->get_span<float>(),
-                        attribute_result->get_span_for_write_only<float>(),
-                        operation);
-    }
   }
-  else {
-    do_math_operation(attribute_a->get_span<float>(),
-                      attribute_result->get_span_for_write_only<float>(),
-                      operation);
+  ReadAttributePtr attribute_c;
+  if (operation_use_input_c(operation)) {
+    attribute_c = params.get_input_attribute("C", component, result_domain, result_type, nullptr);
+    if (!attribute_c) {
+      return;
+    }
   }
 
+  /* The inputs are processed in chunks, so that inputs which are not stored in an array (single
+   * values, converted or interpolated attributes) don't need temporary arrays for all elements.
+   * Note that passing the data as float spans works because the attributes were accessed with
+   * #CD_PROP_FLOAT. */
+  MutableSpan<float> result_span = attribute_result->get_span_for_write_only<float>();
+  const int64_t chunks_num = (result_span.size() + chunk_size - 1) / chunk_size;
+  parallel_for(IndexRange(chunks_num), 1, [&](IndexRange chunks) {
+    Array<float> buffer_a(chunk_size);
+    Array<float> buffer_b(attribute_b ? chunk_size : 0);
+    Array<float> buffer_c(attribute_c ? chunk_size : 0);
+    for (const int64_t chunk : chunks) {
+      const int64_t start = chunk * chunk_size;
+      const IndexRange range(start, std::min(chunk_size, result_span.size() - start));
+      Span<float> span_a = attribute_a->get_span_for_range(range, buffer_a.data());
+      if (attribute_c) {
+        do_math_operation(span_a,
+                          attribute_b->get_span_for_range(range, buffer_b.data()),
+                          attribute_c->get_span_for_range(range, buffer_c.data()),
+                          result_span.slice(range.start(), range.size()),
+                          operation);
+      }
+      else if (attribute_b) {
+        do_math_operation(span_a,
+                          attribute_b->get_span_for_range(range, buffer_b.data()),
+                          result_span.slice(range.start(), range.size()),
+                          operation);
+      }
+      else {
+        do_math_operation(span_a, result_span.slice(range.start(), range.size()), operation);
+      }
+    }
+  });
+
   attribute_result.apply_span_and_save();
 }
 
@@ -0,0 +1,236 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "BLI_kdopbvh.h"
+#include "BLI_task.hh"
+
+#include "BKE_bvhutils.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "node_geometry_util.hh"
+
+static bNodeSocketTemplate geo_node_attribute_proximity_in[] = {
+    {SOCK_GEOMETRY, N_("Geometry")},
+    {SOCK_GEOMETRY, N_("Target")},
+    {SOCK_STRING, N_("Distance")},
+    {SOCK_STRING, N_("Location")},
+    {-1, ""},
+};
+
+static bNodeSocketTemplate geo_node_attribute_proximity_out[] = {
+    {SOCK_GEOMETRY, N_("Geometry")},
+    {-1, ""},
+};
+
+static void geo_node_attribute_proximity_init(bNodeTree *UNUSED(ntree), bNode *node)
+{
+  NodeGeometryAttributeProximity *node_storage = (NodeGeometryAttributeProximity *)MEM_callocN(
+      sizeof(NodeGeometryAttributeProximity), __func__);
+
+  node_storage->target_geometry_element =
+      GEO_NODE_ATTRIBUTE_PROXIMITY_TARGET_GEOMETRY_ELEMENT_FACES;
+  node->storage = node_storage;
+
+  bNodeSocket *distance_socket = nodeFindSocket(node, SOCK_IN, "Distance");
+  STRNCPY(((bNodeSocketValueString *)distance_socket->default_value)->value, "distance");
+  bNodeSocket *location_socket = nodeFindSocket(node, SOCK_IN, "Location");
+  STRNCPY(((bNodeSocketValueString *)location_socket->default_value)->value, "location");
+}
+
+namespace blender::nodes {
+
+/**
+ * Find the nearest point on the target for every position and keep it when it is closer than
+ * the one that has been found already, so that multiple targets can be combined.
+ */
+static void proximity_calc(Span<float3> positions,
+                           BVHTree *tree,
+                           BVHTree_NearestPointCallback callback,
+                           void *callback_data,
+                           MutableSpan<float> r_distances_sq,
+                           MutableSpan<float3> r_locations)
+{
+  parallel_for(positions.index_range(), 512, [&](IndexRange range) {
+    BVHTreeNearest nearest;
+    nearest.index = -1;
+    nearest.dist_sq = FLT_MAX;
+    for (const int i : range) {
+      /* Neighboring points are usually close to each other, so the distance to the previous
+       * result is a good upper bound that lets the search skip most of the tree. */
+      if (nearest.index != -1) {
+        nearest.dist_sq = float3::distance_squared(positions[i], nearest.co);
+      }
+      BLI_bvhtree_find_nearest(tree, positions[i], &nearest, callback, callback_data);
+      if (nearest.dist_sq < r_distances_sq[i]) {
+        r_distances_sq[i] = nearest.dist_sq;
+        r_locations[i] = nearest.co;
+      }
+    }
+  });
+}
+
+static void proximity_calc_mesh(Span<float3> positions,
+                                const Mesh &mesh,
+                                const GeometryNodeAttributeProximityTargetGeometryElement element,
+                                MutableSpan<float> r_distances_sq,
+                                MutableSpan<float3> r_locations)
+{
+  BVHCacheType bvh_type = BVHTREE_FROM_LOOPTRI;
+  switch (element) {
+    case GEO_NODE_ATTRIBUTE_PROXIMITY_TARGET_GEOMETRY_ELEMENT_POINTS:
+      bvh_type = BVHTREE_FROM_VERTS;
+      break;
+    case GEO_NODE_ATTRIBUTE_PROXIMITY_TARGET_GEOMETRY_ELEMENT_EDGES:
+      bvh_type = BVHTREE_FROM_EDGES;
+      break;
+    case GEO_NODE_ATTRIBUTE_PROXIMITY_TARGET_GEOMETRY_ELEMENT_FACES:
+      bvh_type = BVHTREE_FROM_LOOPTRI;
+      break;
+  }
+
+  /* The tree is stored in the BVH cache of the mesh, so it is reused when the target mesh is not
+   * changed between evaluations. */
+  BVHTreeFromMesh tree_data;
+  BKE_bvhtree_from_mesh_get(&tree_data, const_cast<Mesh *>(&mesh), bvh_type, 2);
+  if (tree_data.tree != nullptr) {
+    proximity_calc(positions,
+                   tree_data.tree,
+                   tree_data.nearest_callback,
+                   &tree_data,
+                   r_distances_sq,
+                   r_locations);
+  }
+  free_bvhtree_from_mesh(&tree_data);
+}
+
+static void proximity_calc_pointcloud(Span<float3> positions,
+                                      const PointCloud &pointcloud,
+                                      MutableSpan<float> r_distances_sq,
+                                      MutableSpan<float3> r_locations)
+{
+  if (pointcloud.totpoint == 0) {
+    return;
+  }
+  BVHTree *tree = BLI_bvhtree_new(pointcloud.totpoint, 0.0f, 2, 6);
+  for (const int i : IndexRange(pointcloud.totpoint)) {
+    BLI_bvhtree_insert(tree, i, pointcloud.co[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  /* Without a callback the nearest point on the bounds of a leaf is used, which is the point
+   * itself because the bounds have no extent. */
+  proximity_calc(positions, tree, nullptr, nullptr, r_distances_sq, r_locations);
+
+  BLI_bvhtree_free(tree);
+}
+
+static void attribute_calc_proximity(GeometryComponent &component,
+                                     const GeometrySet &geometry_set_target,
+                                     GeoNodeExecParams &params)
+{
+  const std::string distance_attribute_name = params.get_input<std::string>("Distance");
+  OutputAttributePtr distance_attribute = component.attribute_try_get_for_output(
+      distance_attribute_name, ATTR_DOMAIN_POINT, CD_PROP_FLOAT);
+
+  const std::string location_attribute_name = params.get_input<std::string>("Location");
+  OutputAttributePtr location_attribute = component.attribute_try_get_for_output(
+      location_attribute_name, ATTR_DOMAIN_POINT, CD_PROP_FLOAT3);
+
+  if (!distance_attribute && !location_attribute) {
+    return;
+  }
+
+  ReadAttributePtr position_attribute = component.attribute_try_get_for_read("position");
+  if (!position_attribute) {
+    return;
+  }
+  BLI_assert(position_attribute->custom_data_type() == CD_PROP_FLOAT3);
+  Span<float3> positions = position_attribute->get_span<float3>();
+
+  const NodeGeometryAttributeProximity &node_storage =
+      *(const NodeGeometryAttributeProximity *)params.node().storage;
+  const GeometryNodeAttributeProximityTargetGeometryElement element =
+      (GeometryNodeAttributeProximityTargetGeometryElement)node_storage.target_geometry_element;
+
+  Array<float> distances_sq(positions.size(), FLT_MAX);
+  Array<float3> locations(positions.size(), float3(0.0f));
+
+  if (geometry_set_target.has_mesh()) {
+    proximity_calc_mesh(
+        positions, *geometry_set_target.get_mesh_for_read(), element, distances_sq, locations);
+  }
+  /* Point clouds only have points, they are ignored when the distance to edges or faces is
+   * computed. */
+  if (geometry_set_target.has_pointcloud() &&
+      element == GEO_NODE_ATTRIBUTE_PROXIMITY_TARGET_GEOMETRY_ELEMENT_POINTS) {
+    proximity_calc_pointcloud(
+        positions, *geometry_set_target.get_pointcloud_for_read(), distances_sq, locations);
+  }
+
+  if (distance_attribute) {
+    MutableSpan<float> distances = distance_attribute->get_span_for_write_only<float>();
+    parallel_for(distances.index_range(), 2048, [&](IndexRange range) {
+      for (const int i : range) {
+        /* Points that didn't find any target get a distance of zero. */
+        distances[i] = (distances_sq[i] == FLT_MAX) ? 0.0f : std::sqrt(distances_sq[i]);
+      }
+    });
+    distance_attribute.apply_span_and_save();
+  }
+  if (location_attribute) {
+    MutableSpan<float3> location_span = location_attribute->get_span_for_write_only<float3>();
+    location_span.copy_from(locations);
+    location_attribute.apply_span_and_save();
+  }
+}
+
+static void geo_node_attribute_proximity_exec(GeoNodeExecParams params)
+{
+  GeometrySet geometry_set = params.extract_input<GeometrySet>("Geometry");
+  GeometrySet geometry_set_target = params.extract_input<GeometrySet>("Target");
+
+  if (geometry_set.has<MeshComponent>()) {
+    attribute_calc_proximity(
+        geometry_set.get_component_for_write<MeshComponent>(), geometry_set_target, params);
+  }
+  if (geometry_set.has<PointCloudComponent>()) {
+    attribute_calc_proximity(
+        geometry_set.get_component_for_write<PointCloudComponent>(), geometry_set_target, params);
+  }
+
+  params.set_output("Geometry", geometry_set);
+}
+
+}  // namespace blender::nodes
+
+void register_node_type_geo_attribute_proximity()
+{
+  static bNodeType ntype;
+
+  geo_node_type_base(
+      &ntype, GEO_NODE_ATTRIBUTE_PROXIMITY, "Attribute Proximity", NODE_CLASS_ATTRIBUTE, 0);
+  node_type_socket_templates(
+      &ntype, geo_node_attribute_proximity_in, geo_node_attribute_proximity_out);
+  node_type_init(&ntype, geo_node_attribute_proximity_init);
+  node_type_storage(&ntype,
+                    "NodeGeometryAttributeProximity",
+                    node_free_standard_storage,
+                    node_copy_standard_storage);
+  ntype.geometry_node_execute = blender::nodes::geo_node_attribute_proximity_exec;
+  nodeRegisterType(&ntype);
+}
@@ -62,13 +62,24 @@ static void execute_on_component(GeometryComponent &component, const GeoNodeExec
   Float3ReadAttribute mapping_attribute = component.attribute_get_for_read<float3>(
       mapping_name, ATTR_DOMAIN_POINT, {0, 0, 0});
 
-  MutableSpan<Color4f> colors = attribute_out->get_span<Color4f>();
-  for (const int i : IndexRange(mapping_attribute.size())) {
-    TexResult texture_result = {0};
-    const float3 position = mapping_attribute[i];
+  const int size = mapping_attribute.size();
+  Array<float3> remapped_positions(size);
+  for (const int i : IndexRange(size)) {
     /* For legacy reasons we have to map [0, 1] to [-1, 1] to support uv mappings. */
-    const float3 remapped_position = position * 2.0f - float3(1.0f);
-    BKE_texture_get_value(nullptr, texture, remapped_position, &texture_result, false);
+    remapped_positions[i] = mapping_attribute[i] * 2.0f - float3(1.0f);
+  }
+
+  Array<TexResult> texture_results(size);
+  BKE_texture_get_values(nullptr,
+                         texture,
+                         reinterpret_cast<const float(*)[3]>(remapped_positions.data()),
+                         size,
+                         texture_results.data(),
+                         false);
+
+  MutableSpan<Color4f> colors = attribute_out->get_span<Color4f>();
+  for (const int i : IndexRange(size)) {
+    const TexResult &texture_result = texture_results[i];
     colors[i] = {texture_result.tr, texture_result.tg, texture_result.tb, texture_result.ta};
   }
   attribute_out.apply_span_and_save();
@@ -229,13 +229,22 @@ static void join_components(Span<const PointCloudComponent *> src_components, Ge
 
 static void join_components(Span<const InstancesComponent *> src_components, GeometrySet &result)
 {
+  int tot_instances = 0;
+  for (const InstancesComponent *component : src_components) {
+    tot_instances += component->instances_amount();
+  }
+
+  /* The instances are only referenced, the instanced objects and collections are not realized. */
   InstancesComponent &dst_component = result.get_component_for_write<InstancesComponent>();
+  dst_component.reserve(tot_instances);
   for (const InstancesComponent *component : src_components) {
     const int size = component->instances_amount();
     Span<InstancedData> instanced_data = component->instanced_data();
     Span<float4x4> transforms = component->transforms();
+    Span<int> ids = component->ids();
     for (const int i : IndexRange(size)) {
-      dst_component.add_instance(instanced_data[i], transforms[i]);
+      /* Keep the ids, so that e.g. random values in shaders don't change when joining. */
+      dst_component.add_instance(instanced_data[i], transforms[i], ids[i]);
     }
   }
 }
@@ -14,12 +14,16 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include <array>
+
 #include "BLI_float3.hh"
 #include "BLI_hash.h"
-#include "BLI_kdtree.h"
 #include "BLI_math_vector.h"
+#include "BLI_map.hh"
 #include "BLI_rand.hh"
+#include "BLI_sort.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "DNA_mesh_types.h"
@@ -88,14 +92,13 @@ static void sample_mesh_surface(const Mesh &mesh,
 {
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
 
-  for (const int looptri_index : looptris.index_range()) {
+  /* Every triangle has its own random number generator, which decides how many points are added
+   * to it first. The same decision is made again, when the points are generated. */
+  auto compute_point_amount = [&](const int looptri_index, RandomNumberGenerator &looptri_rng) {
     const MLoopTri &looptri = looptris[looptri_index];
     const int v0_index = mesh.mloop[looptri.tri[0]].v;
     const int v1_index = mesh.mloop[looptri.tri[1]].v;
     const int v2_index = mesh.mloop[looptri.tri[2]].v;
-    const float3 v0_pos = mesh.mvert[v0_index].co;
-    const float3 v1_pos = mesh.mvert[v1_index].co;
-    const float3 v2_pos = mesh.mvert[v2_index].co;
 
     float looptri_density_factor = 1.0f;
     if (density_factors != nullptr) {
@@ -104,37 +107,93 @@ static void sample_mesh_surface(const Mesh &mesh,
       const float v2_density_factor = std::max(0.0f, (*density_factors)[v2_index]);
       looptri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
     }
-    const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
-
-    const int looptri_seed = BLI_hash_int(looptri_index + seed);
-    RandomNumberGenerator looptri_rng(looptri_seed);
+    const float area = area_tri_v3(
+        mesh.mvert[v0_index].co, mesh.mvert[v1_index].co, mesh.mvert[v2_index].co);
 
     const float points_amount_fl = area * base_density * looptri_density_factor;
     const float add_point_probability = fractf(points_amount_fl);
     const bool add_point = add_point_probability > looptri_rng.get_float();
-    const int point_amount = (int)points_amount_fl + (int)add_point;
-
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_looptri_indices.append(looptri_index);
+    return (int)points_amount_fl + (int)add_point;
+  };
+
+  /* Count the points first, so that every triangle can write its points in parallel. */
+  Array<int> point_offsets(looptris.size() + 1);
+  parallel_for(looptris.index_range(), 1024, [&](IndexRange range) {
+    for (const int looptri_index : range) {
+      RandomNumberGenerator looptri_rng(BLI_hash_int(looptri_index + seed));
+      point_offsets[looptri_index] = compute_point_amount(looptri_index, looptri_rng);
     }
+  });
+  int total_points = 0;
+  for (const int looptri_index : looptris.index_range()) {
+    const int point_amount = point_offsets[looptri_index];
+    point_offsets[looptri_index] = total_points;
+    total_points += point_amount;
   }
+  point_offsets.last() = total_points;
+
+  r_positions.resize(total_points);
+  r_bary_coords.resize(total_points);
+  r_looptri_indices.resize(total_points);
+
+  parallel_for(looptris.index_range(), 1024, [&](IndexRange range) {
+    for (const int looptri_index : range) {
+      RandomNumberGenerator looptri_rng(BLI_hash_int(looptri_index + seed));
+      compute_point_amount(looptri_index, looptri_rng);
+
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 v0_pos = mesh.mvert[mesh.mloop[looptri.tri[0]].v].co;
+      const float3 v1_pos = mesh.mvert[mesh.mloop[looptri.tri[1]].v].co;
+      const float3 v2_pos = mesh.mvert[mesh.mloop[looptri.tri[2]].v].co;
+
+      for (const int i :
+           IndexRange(point_offsets[looptri_index],
+                      point_offsets[looptri_index + 1] - point_offsets[looptri_index])) {
+        const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
+        float3 point_pos;
+        interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
+        r_positions[i] = point_pos;
+        r_bary_coords[i] = bary_coord;
+        r_looptri_indices[i] = looptri_index;
+      }
+    }
+  });
+}
+
+/* Grid cell coordinates are wrapped to this many bits, so that any minimum distance can be used.
+ * Cells that get the same key are processed like a single cell, which is still correct. */
+static constexpr int grid_coord_bits = 20;
+static constexpr uint64_t grid_coord_mask = (1 << grid_coord_bits) - 1;
+
+/**
+ * The highest bits of the key contain the parity of the cell coordinates, so that the cells of
+ * every elimination pass are next to each other when sorted by key. Wrapping the coordinates does
+ * not change their parity.
+ */
+static uint64_t grid_cell_key(const int x, const int y, const int z)
+{
+  const uint64_t pass = (uint64_t)((x & 1) | ((y & 1) << 1) | ((z & 1) << 2));
+  return (pass << (3 * grid_coord_bits)) |
+         (((uint64_t)x & grid_coord_mask) << (2 * grid_coord_bits)) |
+         (((uint64_t)y & grid_coord_mask) << grid_coord_bits) | ((uint64_t)z & grid_coord_mask);
 }
 
-BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
+static int grid_cell_key_pass(const uint64_t key)
 {
-  KDTree_3d *kdtree = BLI_kdtree_3d_new(positions.size());
-  for (const int i : positions.index_range()) {
-    BLI_kdtree_3d_insert(kdtree, i, positions[i]);
-  }
-  BLI_kdtree_3d_balance(kdtree);
-  return kdtree;
+  return (int)(key >> (3 * grid_coord_bits));
 }
 
+/**
+ * Eliminate points so that no two remaining points are closer than the minimum distance. The
+ * points are visited in a fixed order, a point is kept when no point that has been kept before is
+ * too close to it.
+ *
+ * The points are sorted into the cells of a grid whose cell size is the minimum distance, so only
+ * the points in neighboring cells have to be checked. The cells are visited in eight passes, one
+ * for every combination of even and odd cell coordinates. Cells of the same pass are never
+ * neighbors, so they are processed in parallel. The order in which the points are visited only
+ * depends on their positions, so the result does not depend on the number of threads.
+ */
 BLI_NOINLINE static void update_elimination_mask_for_close_points(
     Span<float3> positions, const float minimum_distance, MutableSpan<bool> elimination_mask)
 {
@@ -142,32 +201,106 @@ BLI_NOINLINE static void update_elimination_mask_for_close_points(
     return;
   }
 
-  KDTree_3d *kdtree = build_kdtree(positions);
-
-  for (const int i : positions.index_range()) {
-    if (elimination_mask[i]) {
+  const float cell_size_inv = 1.0f / minimum_distance;
+  const float minimum_distance_sq = minimum_distance * minimum_distance;
+
+  /* Sort the points by cell, the points in a cell are sorted by index. */
+  Array<std::pair<uint64_t, int>> sorted_points(positions.size());
+  parallel_for(positions.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const float3 position = positions[i] * cell_size_inv;
+      const uint64_t key = grid_cell_key(
+          (int)floorf(position.x), (int)floorf(position.y), (int)floorf(position.z));
+      sorted_points[i] = {key, i};
+    }
+  });
+  parallel_sort(sorted_points.begin(), sorted_points.end());
+
+  /* Find the range of sorted points in every cell and the range of cells in every pass. */
+  Vector<IndexRange> cells;
+  Map<uint64_t, int> cell_index_by_key;
+  std::array<int, 9> pass_offsets;
+  int pass = 0;
+  pass_offsets[0] = 0;
+  int cell_start = 0;
+  for (const int i : sorted_points.index_range()) {
+    const uint64_t key = sorted_points[i].first;
+    if (i + 1 < sorted_points.size() && sorted_points[i + 1].first == key) {
       continue;
     }
+    while (pass < grid_cell_key_pass(key)) {
+      pass++;
+      pass_offsets[pass] = cells.size();
+    }
+    cell_index_by_key.add_new(key, cells.size());
+    cells.append(IndexRange(cell_start, i + 1 - cell_start));
+    cell_start = i + 1;
+  }
+  while (pass < 8) {
+    pass++;
+    pass_offsets[pass] = cells.size();
+  }
 
-    struct CallbackData {
-      int index;
-      MutableSpan<bool> elimination_mask;
-    } callback_data = {i, elimination_mask};
-
-    BLI_kdtree_3d_range_search_cb(
-        kdtree,
-        positions[i],
-        minimum_distance,
-        [](void *user_data, int index, const float *UNUSED(co), float UNUSED(dist_sq)) {
-          CallbackData &callback_data = *static_cast<CallbackData *>(user_data);
-          if (index != callback_data.index) {
-            callback_data.elimination_mask[index] = true;
+  /* Points that have not been visited yet are not kept, so they don't eliminate other points. */
+  Array<bool> is_kept(sorted_points.size(), false);
+
+  for (const int pass_index : IndexRange(8)) {
+    const IndexRange pass_cells(pass_offsets[pass_index],
+                                pass_offsets[pass_index + 1] - pass_offsets[pass_index]);
+    parallel_for(pass_cells, 64, [&](IndexRange range) {
+      for (const int cell_index : range) {
+        const IndexRange cell = cells[cell_index];
+        const uint64_t key = sorted_points[cell.first()].first;
+        const int x = (int)((key >> (2 * grid_coord_bits)) & grid_coord_mask);
+        const int y = (int)((key >> grid_coord_bits) & grid_coord_mask);
+        const int z = (int)(key & grid_coord_mask);
+
+        /* Cells of the other passes are not modified while this pass is processed. */
+        Vector<IndexRange, 27> neighbor_cells;
+        for (int dx = -1; dx <= 1; dx++) {
+          for (int dy = -1; dy <= 1; dy++) {
+            for (int dz = -1; dz <= 1; dz++) {
+              const int neighbor_index = cell_index_by_key.lookup_default(
+                  grid_cell_key(x + dx, y + dy, z + dz), -1);
+              if (neighbor_index != -1) {
+                neighbor_cells.append(cells[neighbor_index]);
+              }
+            }
           }
-          return true;
-        },
-        &callback_data);
+        }
+
+        for (const int sorted_index : cell) {
+          const int point_index = sorted_points[sorted_index].second;
+          if (elimination_mask[point_index]) {
+            continue;
+          }
+          const float3 position = positions[point_index];
+          bool is_too_close = false;
+          for (const IndexRange neighbor_cell : neighbor_cells) {
+            for (const int other_sorted_index : neighbor_cell) {
+              if (!is_kept[other_sorted_index]) {
+                continue;
+              }
+              const float3 other_position = positions[sorted_points[other_sorted_index].second];
+              if (float3::distance_squared(position, other_position) < minimum_distance_sq) {
+                is_too_close = true;
+                break;
+              }
+            }
+            if (is_too_close) {
+              break;
+            }
+          }
+          if (is_too_close) {
+            elimination_mask[point_index] = true;
+          }
+          else {
+            is_kept[sorted_index] = true;
+          }
+        }
+      }
+    });
   }
-  BLI_kdtree_3d_free(kdtree);
 }
 
 BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
@@ -178,30 +311,33 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     MutableSpan<bool> elimination_mask)
 {
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  parallel_for(bary_coords.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const MLoopTri &looptri = looptris[looptri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const MLoopTri &looptri = looptris[looptri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const int v0_index = mesh.mloop[looptri.tri[0]].v;
-    const int v1_index = mesh.mloop[looptri.tri[1]].v;
-    const int v2_index = mesh.mloop[looptri.tri[2]].v;
+      const int v0_index = mesh.mloop[looptri.tri[0]].v;
+      const int v1_index = mesh.mloop[looptri.tri[1]].v;
+      const int v2_index = mesh.mloop[looptri.tri[2]].v;
 
-    const float v0_density_factor = std::max(0.0f, density_factors[v0_index]);
-    const float v1_density_factor = std::max(0.0f, density_factors[v1_index]);
-    const float v2_density_factor = std::max(0.0f, density_factors[v2_index]);
+      const float v0_density_factor = std::max(0.0f, density_factors[v0_index]);
+      const float v1_density_factor = std::max(0.0f, density_factors[v1_index]);
+      const float v2_density_factor = std::max(0.0f, density_factors[v2_index]);
 
-    const float probablity = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                             v2_density_factor * bary_coord.z;
+      const float probablity = v0_density_factor * bary_coord.x +
+                               v1_density_factor * bary_coord.y +
+                               v2_density_factor * bary_coord.z;
 
-    const float hash = BLI_hash_int_01(bary_coord.hash());
-    if (hash > probablity) {
-      elimination_mask[i] = true;
+      const float hash = BLI_hash_int_01(bary_coord.hash());
+      if (hash > probablity) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(Span<bool> elimination_mask,
@@ -18,7 +18,9 @@
 #  include <openvdb/openvdb.h>
 #endif
 
+#include "BLI_math_batch.hh"
 #include "BLI_math_matrix.h"
+#include "BLI_task.hh"
 
 #include "DNA_pointcloud_types.h"
 #include "DNA_volume_types.h"
@@ -86,11 +88,12 @@ static void transform_pointcloud(PointCloud *pointcloud,
     }
   }
   else {
-    float mat[4][4];
-    loc_eul_size_to_mat4(mat, translation, rotation, scale);
-    for (int i = 0; i < pointcloud->totpoint; i++) {
-      mul_m4_v3(mat, pointcloud->co[i]);
-    }
+    float4x4 mat;
+    loc_eul_size_to_mat4(mat.values, translation, rotation, scale);
+    MutableSpan<float3> positions{(float3 *)pointcloud->co, pointcloud->totpoint};
+    parallel_for(positions.index_range(), 4096, [&](IndexRange range) {
+      transform_points(mat, positions.slice(range.start(), range.size()));
+    });
   }
 }
 
@@ -5235,6 +5235,205 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * Return the item type of a contiguous buffer of scalars which values can be converted from/to
+ * in C when the buffer doesn't match the raw type of the property (a NumPy array of doubles or
+ * 64 bit integers for example), zero when the buffer has to be accessed as a sequence.
+ */
+static char foreach_buffer_format(const Py_buffer *buf)
+{
+  const char *format = buf->format ? buf->format : "B";
+  Py_ssize_t itemsize;
+
+  /* Native byte order and size. */
+  if (*format == '@') {
+    format++;
+  }
+  if (format[0] == '\0' || format[1] != '\0') {
+    return 0;
+  }
+
+  switch (format[0]) {
+    case 'b':
+    case 'B':
+    case '?':
+      itemsize = sizeof(char);
+      break;
+    case 'h':
+    case 'H':
+      itemsize = sizeof(short);
+      break;
+    case 'i':
+    case 'I':
+      itemsize = sizeof(int);
+      break;
+    case 'l':
+    case 'L':
+      itemsize = sizeof(long);
+      break;
+    case 'q':
+    case 'Q':
+      itemsize = sizeof(long long);
+      break;
+    case 'f':
+      itemsize = sizeof(float);
+      break;
+    case 'd':
+      itemsize = sizeof(double);
+      break;
+    default:
+      return 0;
+  }
+
+  return (buf->itemsize == itemsize) ? format[0] : 0;
+}
+
+static double foreach_buffer_item_get(const void *buf, const char format, const int i)
+{
+  switch (format) {
+    case 'b':
+      return ((const signed char *)buf)[i];
+    case 'B':
+      return ((const unsigned char *)buf)[i];
+    case '?':
+      return ((const bool *)buf)[i];
+    case 'h':
+      return ((const short *)buf)[i];
+    case 'H':
+      return ((const unsigned short *)buf)[i];
+    case 'i':
+      return ((const int *)buf)[i];
+    case 'I':
+      return ((const unsigned int *)buf)[i];
+    case 'l':
+      return ((const long *)buf)[i];
+    case 'L':
+      return ((const unsigned long *)buf)[i];
+    case 'q':
+      return ((const long long *)buf)[i];
+    case 'Q':
+      return ((const unsigned long long *)buf)[i];
+    case 'f':
+      return ((const float *)buf)[i];
+    case 'd':
+      return ((const double *)buf)[i];
+  }
+  BLI_assert(!"Invalid buffer format - get");
+  return 0.0;
+}
+
+static void foreach_buffer_item_set(void *buf, const char format, const int i, const double value)
+{
+  switch (format) {
+    case 'b':
+      ((signed char *)buf)[i] = (signed char)value;
+      break;
+    case 'B':
+      ((unsigned char *)buf)[i] = (unsigned char)value;
+      break;
+    case '?':
+      ((bool *)buf)[i] = value != 0.0;
+      break;
+    case 'h':
+      ((short *)buf)[i] = (short)value;
+      break;
+    case 'H':
+      ((unsigned short *)buf)[i] = (unsigned short)value;
+      break;
+    case 'i':
+      ((int *)buf)[i] = (int)value;
+      break;
+    case 'I':
+      ((unsigned int *)buf)[i] = (unsigned int)value;
+      break;
+    case 'l':
+      ((long *)buf)[i] = (long)value;
+      break;
+    case 'L':
+      ((unsigned long *)buf)[i] = (unsigned long)value;
+      break;
+    case 'q':
+      ((long long *)buf)[i] = (long long)value;
+      break;
+    case 'Q':
+      ((unsigned long long *)buf)[i] = (unsigned long long)value;
+      break;
+    case 'f':
+      ((float *)buf)[i] = (float)value;
+      break;
+    case 'd':
+      ((double *)buf)[i] = value;
+      break;
+    default:
+      BLI_assert(!"Invalid buffer format - set");
+      break;
+  }
+}
+
+/* Convert the values of a buffer with a format accepted by #foreach_buffer_format. */
+static void foreach_buffer_to_raw(
+    void *array, RawPropertyType raw_type, const void *buf, const char format, const int tot)
+{
+  for (int i = 0; i < tot; i++) {
+    const double value = foreach_buffer_item_get(buf, format, i);
+    switch (raw_type) {
+      case PROP_RAW_CHAR:
+        ((char *)array)[i] = (char)value;
+        break;
+      case PROP_RAW_SHORT:
+        ((short *)array)[i] = (short)value;
+        break;
+      case PROP_RAW_INT:
+        ((int *)array)[i] = (int)value;
+        break;
+      case PROP_RAW_BOOLEAN:
+        ((bool *)array)[i] = value != 0.0;
+        break;
+      case PROP_RAW_FLOAT:
+        ((float *)array)[i] = (float)value;
+        break;
+      case PROP_RAW_DOUBLE:
+        ((double *)array)[i] = value;
+        break;
+      case PROP_RAW_UNSET:
+        BLI_assert(!"Invalid array type - set");
+        break;
+    }
+  }
+}
+
+static void foreach_buffer_from_raw(
+    void *buf, const char format, const void *array, RawPropertyType raw_type, const int tot)
+{
+  for (int i = 0; i < tot; i++) {
+    double value = 0.0;
+    switch (raw_type) {
+      case PROP_RAW_CHAR:
+        value = ((const char *)array)[i];
+        break;
+      case PROP_RAW_SHORT:
+        value = ((const short *)array)[i];
+        break;
+      case PROP_RAW_INT:
+        value = ((const int *)array)[i];
+        break;
+      case PROP_RAW_BOOLEAN:
+        value = ((const bool *)array)[i];
+        break;
+      case PROP_RAW_FLOAT:
+        value = ((const float *)array)[i];
+        break;
+      case PROP_RAW_DOUBLE:
+        value = ((const double *)array)[i];
+        break;
+      case PROP_RAW_UNSET:
+        BLI_assert(!"Invalid array type - get");
+        break;
+    }
+    foreach_buffer_item_set(buf, format, i, value);
+  }
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5262,18 +5461,33 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
     buffer_is_compat = false;
     if (PyObject_CheckBuffer(seq)) {
       Py_buffer buf;
-      PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT);
+      if (PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT) == -1) {
+        /* Non-contiguous buffers are read as a sequence. */
+        PyErr_Clear();
+      }
+      else {
+        /* Check if the buffer matches. */
 
-      /* Check if the buffer matches. */
+        buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
-      buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
+        if (buffer_is_compat) {
+          ok = RNA_property_collection_raw_set(
+              NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+        }
+        else {
+          /* Convert the values without creating Python objects for them. */
+          const char buf_format = foreach_buffer_format(&buf);
+          if (buf_format && buf.len >= (Py_ssize_t)tot * buf.itemsize) {
+            array = PyMem_Malloc(size * tot);
+            foreach_buffer_to_raw(array, raw_type, buf.buf, buf_format, tot);
+            ok = RNA_property_collection_raw_set(
+                NULL, &self->ptr, self->prop, attr, array, raw_type, tot);
+            buffer_is_compat = true;
+          }
+        }
 
-      if (buffer_is_compat) {
-        ok = RNA_property_collection_raw_set(
-            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+        PyBuffer_Release(&buf);
       }
-
-      PyBuffer_Release(&buf);
     }
 
     /* Could not use the buffer, fallback to sequence. */
@@ -5318,18 +5532,35 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
     buffer_is_compat = false;
     if (PyObject_CheckBuffer(seq)) {
       Py_buffer buf;
-      PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT);
+      if (PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT | PyBUF_WRITABLE) == -1) {
+        /* Non-contiguous and read-only buffers are accessed as a sequence. */
+        PyErr_Clear();
+      }
+      else {
+        /* Check if the buffer matches, TODO - signed/unsigned types. */
 
-      /* Check if the buffer matches, TODO - signed/unsigned types. */
+        buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
-      buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
+        if (buffer_is_compat) {
+          ok = RNA_property_collection_raw_get(
+              NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+        }
+        else {
+          /* Convert the values without creating Python objects for them. */
+          const char buf_format = foreach_buffer_format(&buf);
+          if (buf_format && buf.len >= (Py_ssize_t)tot * buf.itemsize) {
+            array = PyMem_Malloc(size * tot);
+            ok = RNA_property_collection_raw_get(
+                NULL, &self->ptr, self->prop, attr, array, raw_type, tot);
+            if (ok) {
+              foreach_buffer_from_raw(buf.buf, buf_format, array, raw_type, tot);
+            }
+            buffer_is_compat = true;
+          }
+        }
 
-      if (buffer_is_compat) {
-        ok = RNA_property_collection_raw_get(
-            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+        PyBuffer_Release(&buf);
       }
-
-      PyBuffer_Release(&buf);
     }
 
     /* Could not use the buffer, fallback to sequence. */
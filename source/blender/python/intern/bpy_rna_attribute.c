@@ -0,0 +1,246 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * This adds direct access to the data of #Attribute, exposing the #CustomData layer through the
+ * buffer protocol so it can be wrapped by NumPy without copying.
+ */
+
+#include <Python.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "DNA_ID.h"
+#include "DNA_customdata_types.h"
+
+#include "BKE_attribute.h"
+
+#include "DEG_depsgraph.h"
+
+#include "RNA_types.h"
+
+#include "WM_api.h"
+#include "WM_types.h"
+
+#include "bpy_rna.h"
+#include "bpy_rna_attribute.h"
+
+/* -------------------------------------------------------------------- */
+/** \name Attribute Array Type
+ * \{ */
+
+typedef struct BPy_AttributeArray {
+  PyObject_HEAD
+  /** The #BPy_StructRNA of the attribute, keeps it from being freed on the Python side. */
+  BPy_StructRNA *py_attribute;
+} BPy_AttributeArray;
+
+/**
+ * Get the buffer layout of the attribute values, the number of components is the size of the
+ * second dimension, zero for attributes storing a single value per element.
+ */
+static bool attribute_array_layout(const CustomDataLayer *layer,
+                                   const char **r_format,
+                                   Py_ssize_t *r_itemsize,
+                                   Py_ssize_t *r_components)
+{
+  switch (layer->type) {
+    case CD_PROP_FLOAT:
+      *r_format = "f";
+      *r_itemsize = sizeof(float);
+      *r_components = 0;
+      return true;
+    case CD_PROP_INT32:
+      *r_format = "i";
+      *r_itemsize = sizeof(int);
+      *r_components = 0;
+      return true;
+    case CD_PROP_FLOAT3:
+      *r_format = "f";
+      *r_itemsize = sizeof(float);
+      *r_components = 3;
+      return true;
+    case CD_PROP_COLOR:
+      *r_format = "f";
+      *r_itemsize = sizeof(float);
+      *r_components = 4;
+      return true;
+    case CD_MLOOPCOL:
+      /* Stored as sRGB bytes, unlike the linear colors of the RNA API. */
+      *r_format = "B";
+      *r_itemsize = sizeof(char);
+      *r_components = 4;
+      return true;
+  }
+  return false;
+}
+
+static int bpy_attribute_array_getbuffer(BPy_AttributeArray *self, Py_buffer *view, int flags)
+{
+  PYRNA_STRUCT_CHECK_INT(self->py_attribute);
+
+  ID *id = self->py_attribute->ptr.owner_id;
+  CustomDataLayer *layer = self->py_attribute->ptr.data;
+
+  const char *format;
+  Py_ssize_t itemsize, components;
+  if (!attribute_array_layout(layer, &format, &itemsize, &components)) {
+    PyErr_SetString(PyExc_BufferError, "attribute type does not support buffer access");
+    return -1;
+  }
+  if (layer->data == NULL) {
+    /* Edit-mode data is stored in the #BMesh, not in the layer. */
+    PyErr_SetString(PyExc_BufferError, "attribute data is not available (in edit-mode?)");
+    return -1;
+  }
+  if ((flags & PyBUF_WRITABLE) && ID_IS_LINKED(id)) {
+    PyErr_SetString(PyExc_BufferError, "attribute of linked data-block is not writable");
+    return -1;
+  }
+
+  const Py_ssize_t len = BKE_id_attribute_data_length(id, layer);
+  const Py_ssize_t values_len = len * MAX2(components, 1);
+
+  /* Only writable buffers tag the data-block for an update on release. */
+  const bool readonly = (flags & PyBUF_WRITABLE) == 0;
+
+  if (PyBuffer_FillInfo(
+          view, (PyObject *)self, layer->data, values_len * itemsize, readonly, flags) == -1) {
+    return -1;
+  }
+
+  view->itemsize = itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? (char *)format : NULL;
+
+  if ((flags & PyBUF_ND) == PyBUF_ND) {
+    /* The shape, followed by the strides. */
+    Py_ssize_t *shape = MEM_mallocN(sizeof(Py_ssize_t[4]), __func__);
+    shape[0] = len;
+    shape[1] = components;
+    shape[2] = MAX2(components, 1) * itemsize;
+    shape[3] = itemsize;
+    view->ndim = components ? 2 : 1;
+    view->shape = shape;
+    if ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) {
+      view->strides = &shape[2];
+    }
+  }
+
+  return 0;
+}
+
+static void bpy_attribute_array_releasebuffer(BPy_AttributeArray *self, Py_buffer *view)
+{
+  if (view->shape) {
+    MEM_freeN(view->shape);
+  }
+
+  if (view->readonly) {
+    return;
+  }
+
+  /* The values may have been changed, update users of the data the same way as the RNA
+   * properties of the attribute do. */
+  if (pyrna_struct_validity_check(self->py_attribute) == 0) {
+    ID *id = self->py_attribute->ptr.owner_id;
+    if (id->us > 0) {
+      DEG_id_tag_update(id, 0);
+      WM_main_add_notifier(NC_GEOM | ND_DATA, id);
+    }
+  }
+}
+
+static void bpy_attribute_array_dealloc(BPy_AttributeArray *self)
+{
+  Py_DECREF(self->py_attribute);
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyBufferProcs bpy_attribute_array_as_buffer = {
+    (getbufferproc)bpy_attribute_array_getbuffer,
+    (releasebufferproc)bpy_attribute_array_releasebuffer,
+};
+
+PyDoc_STRVAR(bpy_attribute_array_doc,
+             "Buffer over the values of an attribute, see :meth:`bpy.types.Attribute.data_array`.");
+static PyTypeObject BPy_AttributeArray_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "AttributeArray",
+    .tp_basicsize = sizeof(BPy_AttributeArray),
+    .tp_dealloc = (destructor)bpy_attribute_array_dealloc,
+    .tp_as_buffer = &bpy_attribute_array_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = bpy_attribute_array_doc,
+};
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Attribute Methods
+ * \{ */
+
+PyDoc_STRVAR(bpy_rna_attribute_data_array_doc,
+             ".. method:: data_array()\n"
+             "\n"
+             "   Return an object exposing the attribute values through the buffer protocol,\n"
+             "   to be used with ``memoryview`` or ``numpy.asarray`` without copying them.\n"
+             "   Vector and color attributes are two dimensional arrays.\n"
+             "   Writable buffers (as requested by ``numpy.asarray``) update the data-block\n"
+             "   once they are released.\n"
+             "\n"
+             "   .. warning::\n"
+             "\n"
+             "      The buffer refers to the attribute data directly, it must not be used after\n"
+             "      the geometry or its attributes are changed in any other way.\n"
+             "\n"
+             "   :return: The attribute values.\n"
+             "   :rtype: object supporting the buffer protocol\n");
+static PyObject *bpy_rna_attribute_data_array(PyObject *self)
+{
+  BPy_StructRNA *pyrna = (BPy_StructRNA *)self;
+  PYRNA_STRUCT_CHECK_OBJ(pyrna);
+
+  const char *format;
+  Py_ssize_t itemsize, components;
+  if (!attribute_array_layout(pyrna->ptr.data, &format, &itemsize, &components)) {
+    PyErr_SetString(PyExc_TypeError, "data_array(): attribute type is not supported");
+    return NULL;
+  }
+
+  if (PyType_Ready(&BPy_AttributeArray_Type) < 0) {
+    return NULL;
+  }
+
+  BPy_AttributeArray *result = PyObject_New(BPy_AttributeArray, &BPy_AttributeArray_Type);
+  if (result == NULL) {
+    return NULL;
+  }
+  Py_INCREF(pyrna);
+  result->py_attribute = pyrna;
+  return (PyObject *)result;
+}
+
+PyMethodDef BPY_rna_attribute_data_array_method_def = {
+    "data_array",
+    (PyCFunction)bpy_rna_attribute_data_array,
+    METH_NOARGS,
+    bpy_rna_attribute_data_array_doc,
+};
+
+/** \} */
@@ -35,6 +35,7 @@
 
 #include "bpy_library.h"
 #include "bpy_rna.h"
+#include "bpy_rna_attribute.h"
 #include "bpy_rna_callback.h"
 #include "bpy_rna_id_collection.h"
 #include "bpy_rna_types_capi.h"
@@ -48,6 +49,17 @@
 
 #include "WM_api.h"
 
+/* -------------------------------------------------------------------- */
+/** \name Attribute
+ * \{ */
+
+static struct PyMethodDef pyrna_attribute_methods[] = {
+    {NULL, NULL, 0, NULL}, /* #BPY_rna_attribute_data_array_method_def */
+    {NULL, NULL, 0, NULL},
+};
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Blend Data
  * \{ */
@@ -203,6 +215,11 @@ static struct PyMethodDef pyrna_space_methods[] = {
 
 void BPY_rna_types_extend_capi(void)
 {
+  /* Attribute */
+  ARRAY_SET_ITEMS(pyrna_attribute_methods, BPY_rna_attribute_data_array_method_def);
+  BLI_assert(ARRAY_SIZE(pyrna_attribute_methods) == 2);
+  pyrna_struct_type_extend_capi(&RNA_Attribute, pyrna_attribute_methods, NULL);
+
   /* BlendData */
   ARRAY_SET_ITEMS(pyrna_blenddata_methods,
                   BPY_rna_id_collection_user_map_method_def,
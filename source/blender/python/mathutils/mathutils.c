@@ -275,6 +275,46 @@ int mathutils_array_parse_alloc(float **array,
   return ret;
 }
 
+/**
+ * Copy a contiguous buffer of shape `(len, array_dim)`, such as a NumPy array.
+ *
+ * \return the number of vectors, -1 when the buffer can't be used directly.
+ */
+static int mathutils_array_parse_alloc_v_buffer(float **array, int array_dim, PyObject *value)
+{
+  Py_buffer buf;
+  int size = -1;
+
+  if (PyObject_GetBuffer(value, &buf, PyBUF_ND | PyBUF_FORMAT) == -1) {
+    PyErr_Clear();
+    return -1;
+  }
+
+  const char format = PyC_StructFmt_type_from_str(buf.format ? buf.format : "B");
+  if ((buf.ndim == 2) && (buf.shape[1] == array_dim) && (buf.shape[0] <= INT_MAX) &&
+      ((format == 'f' && buf.itemsize == sizeof(float)) ||
+       (format == 'd' && buf.itemsize == sizeof(double)))) {
+    size = (int)buf.shape[0];
+    /* Like the sequence case, nothing is allocated for empty arrays. */
+    if (size != 0) {
+      const int values_len = size * array_dim;
+      float *fp = *array = PyMem_Malloc(values_len * sizeof(float));
+      if (format == 'f') {
+        memcpy(fp, buf.buf, values_len * sizeof(float));
+      }
+      else {
+        const double *dp = buf.buf;
+        for (int i = 0; i < values_len; i++) {
+          fp[i] = (float)dp[i];
+        }
+      }
+    }
+  }
+
+  PyBuffer_Release(&buf);
+  return size;
+}
+
 /* parse an array of vectors */
 int mathutils_array_parse_alloc_v(float **array,
                                   int array_dim,
@@ -285,6 +325,14 @@ int mathutils_array_parse_alloc_v(float **array,
   const int array_dim_flag = array_dim;
   int i, size;
 
+  /* Avoid creating a Python object for every value of arrays. */
+  if (PyObject_CheckBuffer(value)) {
+    size = mathutils_array_parse_alloc_v_buffer(array, array_dim & ~MU_ARRAY_FLAGS, value);
+    if (size != -1) {
+      return size;
+    }
+  }
+
   /* non list/tuple cases */
   if (!(value_fast = PySequence_Fast(value, error_prefix))) {
     /* PySequence_Fast sets the error */
@@ -317,6 +365,40 @@ int mathutils_array_parse_alloc_v(float **array,
   return size;
 }
 
+/**
+ * Create a `memoryview` of the given struct \a format and shape `(len, dim)`, or `(len)` when
+ * \a dim is zero, for functions returning large arrays of values.
+ *
+ * \param r_data: The data to fill, owned by the returned memoryview.
+ */
+PyObject *mathutils_memoryview_new(
+    void **r_data, const char *format, Py_ssize_t itemsize, Py_ssize_t len, Py_ssize_t dim)
+{
+  PyObject *py_data = PyByteArray_FromStringAndSize(NULL, len * MAX2(dim, 1) * itemsize);
+  if (py_data == NULL) {
+    return NULL;
+  }
+  *r_data = PyByteArray_AS_STRING(py_data);
+
+  PyObject *py_bytes_view = PyMemoryView_FromObject(py_data);
+  /* The memoryview keeps the data alive. */
+  Py_DECREF(py_data);
+  if (py_bytes_view == NULL) {
+    return NULL;
+  }
+
+  PyObject *py_view;
+  if (len != 0 && dim != 0) {
+    py_view = PyObject_CallMethod(py_bytes_view, "cast", "s(nn)", format, len, dim);
+  }
+  else {
+    /* A shape can't contain zero. */
+    py_view = PyObject_CallMethod(py_bytes_view, "cast", "s", format);
+  }
+  Py_DECREF(py_bytes_view);
+  return py_view;
+}
+
 /* Parse an sequence array_dim integers into array. */
 int mathutils_int_array_parse(int *array, int array_dim, PyObject *value, const char *error_prefix)
 {
@@ -166,6 +166,8 @@ int mathutils_array_parse_alloc_v(float **array,
                                   int array_dim,
                                   PyObject *value,
                                   const char *error_prefix);
+PyObject *mathutils_memoryview_new(
+    void **r_data, const char *format, Py_ssize_t itemsize, Py_ssize_t len, Py_ssize_t dim);
 int mathutils_int_array_parse(int *array,
                               int array_dim,
                               PyObject *value,
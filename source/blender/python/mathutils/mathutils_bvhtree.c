@@ -30,6 +30,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_bvhutils.h"
@@ -79,6 +80,13 @@
   "      (:class:`Vector` location, :class:`Vector` normal, int index, float distance),\n" \
   "   :rtype: :class:`list`\n"
 
+#define PYBVH_FIND_GENERIC_RETURN_BATCH_DOC \
+  "   :return: Returns a tuple of memoryviews\n" \
+  "      (float locations ``(n, 3)``, float normals ``(n, 3)``, int indices ``(n)``,\n" \
+  "      float distances ``(n)``), all values are zero and the index is -1 for queries\n" \
+  "      which found no element.\n" \
+  "   :rtype: :class:`tuple`\n"
+
 #define PYBVH_FROM_GENERIC_EPSILON_DOC \
   "   :arg epsilon: Increase the threshold for detecting overlap and raycast hits.\n" \
   "   :type epsilon: float\n"
@@ -420,6 +428,233 @@ static PyObject *py_bvhtree_find_nearest(PyBVHTree *self, PyObject *args)
   return py_bvhtree_nearest_to_py_none();
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batch Queries
+ *
+ * Run many queries in a single call, in parallel and without holding the GIL.
+ * \{ */
+
+typedef struct PyBVH_BatchData {
+  const PyBVHTree *self;
+  const float (*co)[3];
+  /* Ray-casts only. */
+  const float (*direction)[3];
+  float max_dist;
+
+  float (*r_co)[3];
+  float (*r_no)[3];
+  int *r_index;
+  float *r_dist;
+} PyBVH_BatchData;
+
+static void py_bvhtree_batch_result_set(const PyBVH_BatchData *data,
+                                        const int i,
+                                        const int index,
+                                        const float co[3],
+                                        const float no[3],
+                                        const float dist)
+{
+  if (index != -1) {
+    copy_v3_v3(data->r_co[i], co);
+    copy_v3_v3(data->r_no[i], no);
+    data->r_dist[i] = dist;
+  }
+  else {
+    zero_v3(data->r_co[i]);
+    zero_v3(data->r_no[i]);
+    data->r_dist[i] = 0.0f;
+  }
+  data->r_index[i] = index;
+}
+
+static void py_bvhtree_ray_cast_batch_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PyBVH_BatchData *data = userdata;
+  const PyBVHTree *self = data->self;
+  float direction[3];
+  BVHTreeRayHit hit;
+
+  normalize_v3_v3(direction, data->direction[i]);
+
+  hit.dist = data->max_dist;
+  hit.index = -1;
+
+  /* may fail if the mesh has no faces, in that case the ray-cast misses */
+  if (self->tree) {
+    BLI_bvhtree_ray_cast(
+        self->tree, data->co[i], direction, 0.0f, &hit, py_bvhtree_raycast_cb, (void *)self);
+  }
+
+  py_bvhtree_batch_result_set(data, i, hit.index, hit.co, hit.no, hit.dist);
+}
+
+static void py_bvhtree_find_nearest_batch_cb(void *__restrict userdata,
+                                             const int i,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PyBVH_BatchData *data = userdata;
+  const PyBVHTree *self = data->self;
+  BVHTreeNearest nearest;
+
+  nearest.index = -1;
+  nearest.dist_sq = data->max_dist * data->max_dist;
+
+  if (self->tree) {
+    BLI_bvhtree_find_nearest(
+        self->tree, data->co[i], &nearest, py_bvhtree_nearest_point_cb, (void *)self);
+  }
+
+  py_bvhtree_batch_result_set(
+      data, i, nearest.index, nearest.co, nearest.no, sqrtf(nearest.dist_sq));
+}
+
+/**
+ * Allocate the result arrays of \a data, returned as a tuple of memoryviews.
+ */
+static PyObject *py_bvhtree_batch_result_new(PyBVH_BatchData *data, const int len)
+{
+  PyObject *py_co = NULL, *py_no = NULL, *py_index = NULL, *py_dist = NULL;
+
+  if ((py_co = mathutils_memoryview_new(
+           (void **)&data->r_co, "f", (Py_ssize_t)sizeof(float), len, 3)) &&
+      (py_no = mathutils_memoryview_new(
+           (void **)&data->r_no, "f", (Py_ssize_t)sizeof(float), len, 3)) &&
+      (py_index = mathutils_memoryview_new(
+           (void **)&data->r_index, "i", (Py_ssize_t)sizeof(int), len, 0)) &&
+      (py_dist = mathutils_memoryview_new(
+           (void **)&data->r_dist, "f", (Py_ssize_t)sizeof(float), len, 0))) {
+    PyObject *ret = PyTuple_New(4);
+    PyTuple_SET_ITEMS(ret, py_co, py_no, py_index, py_dist);
+    return ret;
+  }
+
+  Py_XDECREF(py_co);
+  Py_XDECREF(py_no);
+  Py_XDECREF(py_index);
+  return NULL;
+}
+
+static void py_bvhtree_batch_run(PyBVH_BatchData *data,
+                                 const int len,
+                                 TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+
+  Py_BEGIN_ALLOW_THREADS;
+  BLI_task_parallel_range(0, len, data, func, &settings);
+  Py_END_ALLOW_THREADS;
+}
+
+PyDoc_STRVAR(py_bvhtree_ray_cast_batch_doc,
+             ".. method:: ray_cast_batch(origins, directions, distance=sys.float_info.max)\n"
+             "\n"
+             "   Cast many rays onto the mesh at once, see :meth:`ray_cast`.\n"
+             "\n"
+             "   :arg origins: Start locations of the rays in object space.\n"
+             "   :type origins: sequence of :class:`Vector` or a ``(n, 3)`` float buffer\n"
+             "   :arg directions: Directions of the rays in object space.\n"
+             "   :type directions: sequence of :class:`Vector` or a ``(n, 3)`` float buffer\n"
+                 PYBVH_FIND_GENERIC_DISTANCE_DOC PYBVH_FIND_GENERIC_RETURN_BATCH_DOC);
+static PyObject *py_bvhtree_ray_cast_batch(PyBVHTree *self, PyObject *args)
+{
+  const char *error_prefix = "ray_cast_batch";
+  PyObject *py_co, *py_direction, *ret;
+  float(*co)[3] = NULL, (*direction)[3] = NULL;
+  float max_dist = FLT_MAX;
+  int co_len, direction_len;
+
+  if (!PyArg_ParseTuple(args, "OO|f:ray_cast_batch", &py_co, &py_direction, &max_dist)) {
+    return NULL;
+  }
+
+  if ((co_len = mathutils_array_parse_alloc_v((float **)&co, 3, py_co, error_prefix)) == -1) {
+    return NULL;
+  }
+  if ((direction_len = mathutils_array_parse_alloc_v(
+           (float **)&direction, 3, py_direction, error_prefix)) == -1) {
+    ret = NULL;
+    goto finally;
+  }
+  if (co_len != direction_len) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s: expected as many directions as origins, found %d and %d",
+                 error_prefix,
+                 direction_len,
+                 co_len);
+    ret = NULL;
+    goto finally;
+  }
+
+  {
+    PyBVH_BatchData data = {
+        .self = self,
+        .co = (const float(*)[3])co,
+        .direction = (const float(*)[3])direction,
+        .max_dist = max_dist,
+    };
+
+    if ((ret = py_bvhtree_batch_result_new(&data, co_len))) {
+      py_bvhtree_batch_run(&data, co_len, py_bvhtree_ray_cast_batch_cb);
+    }
+  }
+
+finally:
+  if (co) {
+    PyMem_Free(co);
+  }
+  if (direction) {
+    PyMem_Free(direction);
+  }
+  return ret;
+}
+
+PyDoc_STRVAR(py_bvhtree_find_nearest_batch_doc,
+             ".. method:: find_nearest_batch(origins, distance=" PYBVH_MAX_DIST_STR
+             ")\n"
+             "\n"
+             "   Find the nearest element to many points at once, see :meth:`find_nearest`.\n"
+             "\n"
+             "   :arg origins: Find nearest elements to these points.\n"
+             "   :type origins: sequence of :class:`Vector` or a ``(n, 3)`` float buffer\n"
+                 PYBVH_FIND_GENERIC_DISTANCE_DOC PYBVH_FIND_GENERIC_RETURN_BATCH_DOC);
+static PyObject *py_bvhtree_find_nearest_batch(PyBVHTree *self, PyObject *args)
+{
+  const char *error_prefix = "find_nearest_batch";
+  PyObject *py_co, *ret;
+  float(*co)[3] = NULL;
+  float max_dist = max_dist_default;
+  int co_len;
+
+  if (!PyArg_ParseTuple(args, "O|f:find_nearest_batch", &py_co, &max_dist)) {
+    return NULL;
+  }
+
+  if ((co_len = mathutils_array_parse_alloc_v((float **)&co, 3, py_co, error_prefix)) == -1) {
+    return NULL;
+  }
+
+  PyBVH_BatchData data = {
+      .self = self,
+      .co = (const float(*)[3])co,
+      .max_dist = max_dist,
+  };
+
+  if ((ret = py_bvhtree_batch_result_new(&data, co_len))) {
+    py_bvhtree_batch_run(&data, co_len, py_bvhtree_find_nearest_batch_cb);
+  }
+
+  if (co) {
+    PyMem_Free(co);
+  }
+  return ret;
+}
+
+/** \} */
+
 struct PyBVH_RangeData {
   PyBVHTree *self;
   PyObject *result;
@@ -1232,6 +1467,14 @@ static PyMethodDef py_bvhtree_methods[] = {
      (PyCFunction)py_bvhtree_find_nearest_range,
      METH_VARARGS,
      py_bvhtree_find_nearest_range_doc},
+    {"ray_cast_batch",
+     (PyCFunction)py_bvhtree_ray_cast_batch,
+     METH_VARARGS,
+     py_bvhtree_ray_cast_batch_doc},
+    {"find_nearest_batch",
+     (PyCFunction)py_bvhtree_find_nearest_batch,
+     METH_VARARGS,
+     py_bvhtree_find_nearest_batch_doc},
     {"overlap", (PyCFunction)py_bvhtree_overlap, METH_O, py_bvhtree_overlap_doc},
 
     /* class methods */
@@ -26,6 +26,8 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "../generic/py_capi_utils.h"
@@ -256,6 +258,96 @@ static PyObject *py_kdtree_find(PyKDTree *self, PyObject *args, PyObject *kwargs
   return kdtree_nearest_to_py_and_check(&nearest);
 }
 
+struct PyKDTree_BatchData {
+  const KDTree_3d *tree;
+  const float (*co)[3];
+
+  float (*r_co)[3];
+  int *r_index;
+  float *r_dist;
+};
+
+static void py_kdtree_find_batch_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct PyKDTree_BatchData *data = userdata;
+  KDTreeNearest_3d nearest;
+
+  nearest.index = -1;
+
+  if (BLI_kdtree_3d_find_nearest(data->tree, data->co[i], &nearest) != -1) {
+    copy_v3_v3(data->r_co[i], nearest.co);
+    data->r_dist[i] = nearest.dist;
+  }
+  else {
+    zero_v3(data->r_co[i]);
+    data->r_dist[i] = 0.0f;
+  }
+  data->r_index[i] = nearest.index;
+}
+
+PyDoc_STRVAR(py_kdtree_find_batch_doc,
+             ".. method:: find_batch(co_seq)\n"
+             "\n"
+             "   Find the nearest point to many points at once, see :meth:`find`.\n"
+             "   The queries run in parallel and don't hold the GIL.\n"
+             "\n"
+             "   :arg co_seq: Points to search from.\n"
+             "   :type co_seq: sequence of :class:`Vector` or a ``(n, 3)`` float buffer\n"
+             "   :return: Returns a tuple of memoryviews\n"
+             "      (float locations ``(n, 3)``, int indices ``(n)``, float distances ``(n)``),\n"
+             "      all values are zero and the index is -1 when the tree is empty.\n"
+             "   :rtype: :class:`tuple`\n");
+static PyObject *py_kdtree_find_batch(PyKDTree *self, PyObject *py_co_seq)
+{
+  PyObject *py_co = NULL, *py_index = NULL, *py_dist = NULL, *ret = NULL;
+  float(*co)[3] = NULL;
+  int co_len;
+
+  if (self->count != self->count_balance) {
+    PyErr_SetString(PyExc_RuntimeError, "KDTree must be balanced before calling find_batch()");
+    return NULL;
+  }
+
+  if ((co_len = mathutils_array_parse_alloc_v(
+           (float **)&co, 3, py_co_seq, "find_batch: invalid 'co_seq' arg")) == -1) {
+    return NULL;
+  }
+
+  struct PyKDTree_BatchData data = {
+      .tree = self->obj,
+      .co = (const float(*)[3])co,
+  };
+
+  if ((py_co = mathutils_memoryview_new(
+           (void **)&data.r_co, "f", (Py_ssize_t)sizeof(float), co_len, 3)) &&
+      (py_index = mathutils_memoryview_new(
+           (void **)&data.r_index, "i", (Py_ssize_t)sizeof(int), co_len, 0)) &&
+      (py_dist = mathutils_memoryview_new(
+           (void **)&data.r_dist, "f", (Py_ssize_t)sizeof(float), co_len, 0))) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 64;
+
+    Py_BEGIN_ALLOW_THREADS;
+    BLI_task_parallel_range(0, co_len, &data, py_kdtree_find_batch_cb, &settings);
+    Py_END_ALLOW_THREADS;
+
+    ret = PyTuple_New(3);
+    PyTuple_SET_ITEMS(ret, py_co, py_index, py_dist);
+  }
+  else {
+    Py_XDECREF(py_co);
+    Py_XDECREF(py_index);
+  }
+
+  if (co) {
+    PyMem_Free(co);
+  }
+  return ret;
+}
+
 PyDoc_STRVAR(py_kdtree_find_n_doc,
              ".. method:: find_n(co, n)\n"
              "\n"
@@ -370,6 +462,7 @@ static PyMethodDef PyKDTree_methods[] = {
     {"insert", (PyCFunction)py_kdtree_insert, METH_VARARGS | METH_KEYWORDS, py_kdtree_insert_doc},
     {"balance", (PyCFunction)py_kdtree_balance, METH_NOARGS, py_kdtree_balance_doc},
     {"find", (PyCFunction)py_kdtree_find, METH_VARARGS | METH_KEYWORDS, py_kdtree_find_doc},
+    {"find_batch", (PyCFunction)py_kdtree_find_batch, METH_O, py_kdtree_find_batch_doc},
     {"find_n", (PyCFunction)py_kdtree_find_n, METH_VARARGS | METH_KEYWORDS, py_kdtree_find_n_doc},
     {"find_range",
      (PyCFunction)py_kdtree_find_range,
@@ -47,6 +47,7 @@
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
 
@@ -2315,6 +2316,117 @@ static int do_write_image_or_movie(Render *re,
   return ok;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Asynchronous Image Writing
+ *
+ * When rendering an image sequence in background mode, the result of a frame is written by a
+ * background task while the next frame is evaluated and rendered. Only one frame is written at a
+ * time, its post and write callbacks run once the file is written.
+ * \{ */
+
+typedef struct RenderWriteJob {
+  /** Copy of the result of the frame, owned by the job. */
+  RenderResult *rr;
+  /**
+   * Settings used to write the frame, the original scene is animated for the next frame in the
+   * meantime. Only the render, view and display settings are set.
+   */
+  Scene scene;
+  char name[FILE_MAX];
+  int cfra;
+  /** The reports can't be added to the render ones from the writing thread. */
+  ReportList reports;
+  double write_time;
+  bool ok;
+} RenderWriteJob;
+
+static void render_write_job_run(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  RenderWriteJob *job = taskdata;
+  const double start_time = PIL_check_seconds_timer();
+
+  job->ok = RE_WriteRenderViewsImage(&job->reports, job->rr, &job->scene, true, job->name);
+
+  job->write_time = PIL_check_seconds_timer() - start_time;
+}
+
+static RenderWriteJob *render_write_job_start(Render *re,
+                                              Main *bmain,
+                                              Scene *scene,
+                                              TaskPool *pool)
+{
+  RenderWriteJob *job = MEM_callocN(sizeof(*job), __func__);
+  char name[FILE_MAX];
+
+  RenderResult rres;
+  RE_AcquireResultImageViews(re, &rres);
+  job->rr = RE_DuplicateRenderResult(&rres);
+  RE_ReleaseResultImageViews(re, &rres);
+
+  job->scene.r = scene->r;
+  BKE_color_managed_view_settings_copy(&job->scene.view_settings, &scene->view_settings);
+  BKE_color_managed_display_settings_copy(&job->scene.display_settings,
+                                          &scene->display_settings);
+  job->cfra = scene->r.cfra;
+  BKE_image_path_from_imformat(job->name,
+                               scene->r.pic,
+                               BKE_main_blendfile_path(bmain),
+                               scene->r.cfra,
+                               &scene->r.im_format,
+                               (scene->r.scemode & R_EXTENSION) != 0,
+                               true,
+                               NULL);
+  BKE_reports_init(&job->reports, RPT_STORE);
+
+  re->i.lastframetime = PIL_check_seconds_timer() - re->i.starttime;
+  BLI_timecode_string_from_time_simple(name, sizeof(name), re->i.lastframetime);
+  printf(" Time: %s (Saving in background)\n", name);
+  fflush(stdout);
+
+  render_callback_exec_null(re, G_MAIN, BKE_CB_EVT_RENDER_STATS);
+
+  BLI_task_pool_push(pool, render_write_job_run, job, false, NULL);
+  return job;
+}
+
+/**
+ * Wait for the frame of \a job to be written and run the callbacks of that frame.
+ * \return False when writing failed.
+ */
+static bool render_write_job_finish(Render *re, Scene *scene, TaskPool *pool, RenderWriteJob *job)
+{
+  char name[FILE_MAX];
+
+  BLI_task_pool_work_and_wait(pool);
+
+  LISTBASE_FOREACH (Report *, report, &job->reports.list) {
+    BKE_report(re->reports, report->type, report->message);
+  }
+
+  BLI_timecode_string_from_time_simple(name, sizeof(name), job->write_time);
+  printf("Frame %d saved in %s\n", job->cfra, name);
+  fflush(stdout);
+
+  const bool ok = job->ok;
+  if (ok) {
+    /* Handlers read the number of the frame from the scene, which moved on already. */
+    const int cfra = scene->r.cfra;
+    scene->r.cfra = job->cfra;
+    render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_POST);
+    render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+    scene->r.cfra = cfra;
+  }
+
+  render_result_free(job->rr);
+  BKE_color_managed_view_settings_free(&job->scene.view_settings);
+  BKE_reports_clear(&job->reports);
+  MEM_freeN(job);
+
+  return ok;
+}
+
+/** \} */
+
 static void get_videos_dimensions(const Render *re,
                                   const RenderData *rd,
                                   size_t *r_width,
@@ -2373,6 +2485,11 @@ void RE_RenderAnim(Render *re,
   const bool is_movie = BKE_imtype_is_movie(rd.im_format.imtype);
   const bool is_multiview_name = ((rd.scemode & R_MULTIVIEW) != 0 &&
                                   (rd.im_format.views_format == R_IMF_VIEWS_INDIVIDUAL));
+  /* Interactive renders keep writing on the render thread, so that render handlers of a frame
+   * still run before the next frame starts. */
+  const bool use_write_async = G.background && !is_movie;
+  TaskPool *write_pool = NULL;
+  RenderWriteJob *write_job = NULL;
 
   /* do not fully call for each frame, it initializes & pops output window */
   if (!render_init_from_main(re, &rd, bmain, scene, single_layer, camera_override, 0, 1)) {
@@ -2546,7 +2663,22 @@ void RE_RenderAnim(Render *re,
 
       if (re->test_break(re->tbh) == 0) {
         if (!G.is_break) {
-          if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, NULL)) {
+          if (use_write_async) {
+            /* Only one frame is written at a time, wait for the previous one. */
+            if (write_job) {
+              if (!render_write_job_finish(re, scene, write_pool, write_job)) {
+                G.is_break = true;
+              }
+              write_job = NULL;
+            }
+            if (!G.is_break) {
+              if (write_pool == NULL) {
+                write_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+              }
+              write_job = render_write_job_start(re, bmain, scene, write_pool);
+            }
+          }
+          else if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, NULL)) {
             G.is_break = true;
           }
         }
@@ -2588,7 +2720,7 @@ void RE_RenderAnim(Render *re,
         break;
       }
 
-      if (G.is_break == false) {
+      if (G.is_break == false && !use_write_async) {
         /* keep after file save */
         render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_POST);
         render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
@@ -2596,6 +2728,14 @@ void RE_RenderAnim(Render *re,
     }
   }
 
+  /* The last frame written in the background, also when the next one was cancelled. */
+  if (write_pool) {
+    if (write_job && !render_write_job_finish(re, scene, write_pool, write_job)) {
+      G.is_break = true;
+    }
+    BLI_task_pool_free(write_pool);
+  }
+
   /* end movie */
   if (is_movie) {
     re_movie_free_all(re, mh, totvideos);
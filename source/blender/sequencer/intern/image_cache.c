@@ -57,6 +57,14 @@
 #include "prefetch.h"
 #include "strip_time.h"
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#endif
+
 /**
  * Sequencer Cache Design Notes
  * ============================
@@ -81,6 +89,11 @@
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
  *
+ * Compression: Before a frame is freed to make room, its images are compressed in place instead
+ * (LZO, lossless). Pixels stay compressed until the image is requested from the cache again.
+ * Only images that are not referenced outside of the cache can be compressed. Frames are freed
+ * once nothing is left to compress.
+ *
  *
  * Disk Cache Design Notes
  * =======================
@@ -153,6 +166,13 @@ typedef struct SeqCache {
 typedef struct SeqCacheItem {
   struct SeqCache *cache_owner;
   struct ImBuf *ibuf;
+  /* Compressed pixels of ibuf, its own buffers are freed while these are set. */
+  void *compressed_rect;
+  void *compressed_rect_float;
+  size_t compressed_rect_size;
+  size_t compressed_rect_float_size;
+  /* Compression of this item was already attempted, do not try again. */
+  bool is_compressed;
 } SeqCacheItem;
 
 typedef struct SeqCacheKey {
@@ -817,6 +837,9 @@ static void seq_cache_valfree(void *val)
 {
   SeqCacheItem *item = (SeqCacheItem *)val;
 
+  MEM_SAFE_FREE(item->compressed_rect);
+  MEM_SAFE_FREE(item->compressed_rect_float);
+
   if (item->ibuf) {
     IMB_freeImBuf(item->ibuf);
   }
@@ -847,6 +870,11 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   item = BLI_mempool_alloc(cache->items_pool);
   item->cache_owner = cache;
   item->ibuf = ibuf;
+  item->compressed_rect = NULL;
+  item->compressed_rect_float = NULL;
+  item->compressed_rect_size = 0;
+  item->compressed_rect_float_size = 0;
+  item->is_compressed = false;
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
@@ -880,11 +908,114 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   }
 }
 
+#ifdef WITH_LZO
+/* Return compressed copy of `in`, or NULL if it does not compress. */
+static void *seq_cache_compress_buffer(const void *in, size_t in_len, size_t *r_out_len)
+{
+  lzo_uint out_len = in_len + in_len / 16 + 64 + 3;
+  unsigned char *out = MEM_mallocN(out_len, "seq cache compressed buffer");
+  void *wrkmem = MEM_mallocN(LZO1X_MEM_COMPRESS, "seq cache lzo wrkmem");
+
+  int r = lzo1x_1_compress(in, (lzo_uint)in_len, out, &out_len, wrkmem);
+  MEM_freeN(wrkmem);
+
+  if (r != LZO_E_OK || out_len >= in_len) {
+    MEM_freeN(out);
+    return NULL;
+  }
+
+  *r_out_len = out_len;
+  return MEM_reallocN(out, out_len);
+}
+
+static bool seq_cache_decompress_buffer(const void *in, size_t in_len, void *out, size_t out_len)
+{
+  lzo_uint len = out_len;
+  int r = lzo1x_decompress_safe(in, (lzo_uint)in_len, out, &len, NULL);
+  return r == LZO_E_OK && len == out_len;
+}
+
+static size_t seq_cache_rect_size(ImBuf *ibuf)
+{
+  return (size_t)ibuf->x * ibuf->y * sizeof(uint);
+}
+
+static size_t seq_cache_rect_float_size(ImBuf *ibuf)
+{
+  return (size_t)ibuf->x * ibuf->y * ibuf->channels * sizeof(float);
+}
+
+/* Compress pixels of item in place, if nothing outside of cache uses its image. */
+static void seq_cache_compress_item(SeqCacheItem *item)
+{
+  if (item == NULL) {
+    return;
+  }
+
+  ImBuf *ibuf = item->ibuf;
+
+  if (item->is_compressed || ibuf == NULL || ibuf->refcounter > 0) {
+    return;
+  }
+
+  item->is_compressed = true;
+
+  if (ibuf->rect && (ibuf->mall & IB_rect)) {
+    item->compressed_rect = seq_cache_compress_buffer(
+        ibuf->rect, seq_cache_rect_size(ibuf), &item->compressed_rect_size);
+    if (item->compressed_rect) {
+      imb_freerectImBuf(ibuf);
+    }
+  }
+  if (ibuf->rect_float && (ibuf->mall & IB_rectfloat)) {
+    item->compressed_rect_float = seq_cache_compress_buffer(
+        ibuf->rect_float, seq_cache_rect_float_size(ibuf), &item->compressed_rect_float_size);
+    if (item->compressed_rect_float) {
+      imb_freerectfloatImBuf(ibuf);
+    }
+  }
+}
+
+/* Restore pixels of compressed item. Return false if item can not be used. */
+static bool seq_cache_decompress_item(SeqCacheItem *item)
+{
+  ImBuf *ibuf = item->ibuf;
+  bool ok = true;
+
+  item->is_compressed = false;
+
+  if (item->compressed_rect) {
+    ok &= imb_addrectImBuf(ibuf) &&
+          seq_cache_decompress_buffer(item->compressed_rect,
+                                      item->compressed_rect_size,
+                                      ibuf->rect,
+                                      seq_cache_rect_size(ibuf));
+    MEM_SAFE_FREE(item->compressed_rect);
+  }
+  if (item->compressed_rect_float) {
+    ok &= imb_addrectfloatImBuf(ibuf) &&
+          seq_cache_decompress_buffer(item->compressed_rect_float,
+                                      item->compressed_rect_float_size,
+                                      ibuf->rect_float,
+                                      seq_cache_rect_float_size(ibuf));
+    MEM_SAFE_FREE(item->compressed_rect_float);
+  }
+
+  return ok;
+}
+#endif
+
 static ImBuf *seq_cache_get_ex(SeqCache *cache, SeqCacheKey *key)
 {
   SeqCacheItem *item = BLI_ghash_lookup(cache->hash, key);
 
   if (item && item->ibuf) {
+#ifdef WITH_LZO
+    if (item->is_compressed && !seq_cache_decompress_item(item)) {
+      return NULL;
+    }
+#endif
+
     IMB_refImBuf(item->ibuf);
 
     return item->ibuf;
@@ -989,7 +1120,8 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
   }
 }
 
-static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
+/* With `uncompressed_only`, find frame which was not compressed yet. */
+static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene, bool uncompressed_only)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *finalkey = NULL;
@@ -1020,6 +1152,10 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       continue;
     }
 
+    if (uncompressed_only && item->is_compressed) {
+      continue;
+    }
+
     total_count++;
 
     if (lkey) {
@@ -1045,6 +1181,22 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
   return finalkey;
 }
 
+#ifdef WITH_LZO
+/* Compress all images of a frame. Base key has no link_next. */
+static void seq_cache_compress_linked(Scene *scene, SeqCacheKey *base)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  SeqCacheItem *base_item = BLI_ghash_lookup(cache->hash, base);
+
+  for (SeqCacheKey *key = base; key; key = key->link_prev) {
+    seq_cache_compress_item(BLI_ghash_lookup(cache->hash, key));
+  }
+
+  /* Base image may be referenced, mark it anyway so the frame is not chosen again. */
+  base_item->is_compressed = true;
+}
+#endif
+
 /* Find only "base" keys.
  * Sources(other types) for a frame must be freed all at once.
  */
@@ -1058,7 +1210,16 @@ bool seq_cache_recycle_item(Scene *scene)
   seq_cache_lock(scene);
 
   while (seq_cache_is_full()) {
-    SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene);
+#ifdef WITH_LZO
+    SeqCacheKey *compress_key = seq_cache_get_item_for_removal(scene, true);
+
+    if (compress_key) {
+      seq_cache_compress_linked(scene, compress_key);
+      continue;
+    }
+#endif
+
+    SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene, false);
 
     if (finalkey) {
       seq_cache_recycle_linked(scene, finalkey);
@@ -37,6 +37,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -1873,6 +1874,92 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/* Strips which only read their own image or movie file, so they can be rendered on
+ * separate threads without touching data of other strips. */
+static bool seq_render_strip_is_independent(Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence != NULL) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+typedef struct RenderStripStackData {
+  const SeqRenderData *context;
+  Sequence **seq_arr;
+  ImBuf **ibufs;
+  float timeline_frame;
+} RenderStripStackData;
+
+static void seq_render_strip_stack_task(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RenderStripStackData *data = userdata;
+  if (data->seq_arr[i] == NULL) {
+    return;
+  }
+
+  SeqRenderState state;
+  seq_render_state_init(&state);
+  data->ibufs[i] = seq_render_strip(data->context, &state, data->seq_arr[i], data->timeline_frame);
+}
+
+/**
+ * Render the strips which get blended on top of each other in parallel, storing them in
+ * \a r_ibufs. Entries stay NULL when the stack contains strips which have to be rendered
+ * in order.
+ */
+static void seq_render_strip_stack_parallel(const SeqRenderData *context,
+                                            Sequence **seq_arr,
+                                            int start,
+                                            int count,
+                                            float timeline_frame,
+                                            ImBuf **r_ibufs)
+{
+  int num_effects = 0;
+  for (int i = start; i < count; i++) {
+    if (seq_get_early_out_for_blend_mode(seq_arr[i]) != EARLY_DO_EFFECT) {
+      continue;
+    }
+    if (!seq_render_strip_is_independent(seq_arr[i])) {
+      return;
+    }
+    num_effects++;
+  }
+
+  if (num_effects < 2) {
+    return;
+  }
+
+  /* Strips which don't get blended are not rendered at all. */
+  Sequence *seq_render_arr[MAXSEQ + 1] = {NULL};
+  for (int i = start; i < count; i++) {
+    if (seq_get_early_out_for_blend_mode(seq_arr[i]) == EARLY_DO_EFFECT) {
+      seq_render_arr[i] = seq_arr[i];
+    }
+  }
+
+  RenderStripStackData data = {
+      .context = context,
+      .seq_arr = seq_render_arr,
+      .ibufs = r_ibufs,
+      .timeline_frame = timeline_frame,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(start, count, &data, seq_render_strip_stack_task, &settings);
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
@@ -1936,12 +2023,16 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+  ImBuf *ibuf_arr[MAXSEQ + 1] = {NULL};
+  seq_render_strip_stack_parallel(context, seq_arr, i, count, timeline_frame, ibuf_arr);
+
   for (; i < count; i++) {
     Sequence *seq = seq_arr[i];
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = ibuf_arr[i] ? ibuf_arr[i] :
+                                   seq_render_strip(context, state, seq, timeline_frame);
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -46,9 +47,7 @@
 #    pragma GCC diagnostic ignored "-Wtype-limits"
 #  endif
 
-#  ifdef _OPENMP
-#    define CLOTH_OPENMP_LIMIT 512
-#  endif
+#  define CLOTH_PARALLEL_LIMIT 512
 
 //#define DEBUG_TIME
 
@@ -613,6 +612,39 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
+typedef struct MulBFMatrixLFVectorData {
+  float (*to)[3];
+  lfVector *temp;
+  fmatrix3x3 *from;
+  lfVector *fLongVector;
+} MulBFMatrixLFVectorData;
+
+/* The two halves of the symmetric multiplication accumulate into separate vectors,
+ * so they can run at the same time. */
+static void mul_bfmatrix_lfvector_section_cb(void *__restrict userdata,
+                                              const int section,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MulBFMatrixLFVectorData *data = userdata;
+  fmatrix3x3 *from = data->from;
+  lfVector *fLongVector = data->fLongVector;
+
+  if (section == 0) {
+    float(*to)[3] = data->to;
+    for (unsigned int i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
+      /* This is the lower triangle of the sparse matrix,
+       * therefore multiplication occurs with transposed submatrices. */
+      muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
+    }
+  }
+  else {
+    lfVector *temp = data->temp;
+    for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
+      muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
+    }
+  }
+}
+
 /* SPARSE SYMMETRIC multiply big matrix with long vector*/
 /* STATUS: verified */
 DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
@@ -622,23 +654,19 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
 
   zero_lfvector(to, vcount);
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (unsigned int i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed submatrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
-    }
-#  pragma omp section
-    {
-      for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
-    }
-  }
+  MulBFMatrixLFVectorData data = {
+      .to = to,
+      .temp = temp,
+      .from = from,
+      .fLongVector = fLongVector,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (vcount > CLOTH_PARALLEL_LIMIT);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, 2, &data, mul_bfmatrix_lfvector_section_cb, &settings);
+
   add_lfvector_lfvector(to, to, temp, from[0].vcount);
 
   del_lfvector(temp);
@@ -90,6 +90,8 @@
 #  include "BPY_extern_run.h"
 #endif
 
+#include "PIL_time.h"
+
 #include "GHOST_C-api.h"
 #include "GHOST_Path-api.h"
 
@@ -221,9 +223,25 @@ static void sound_jack_sync_callback(Main *bmain, int mode, double time)
   }
 }
 
+/**
+ * Report the time spent since \a time_start for `--debug-startup-timing`,
+ * returns the start time of the next phase.
+ */
+static double wm_init_timing_report(const char *phase, const double time_start)
+{
+  if ((G.debug & G_DEBUG_STARTUP_TIMING) == 0) {
+    return time_start;
+  }
+  const double time_end = PIL_check_seconds_timer();
+  printf("Startup: %-26s %.4f sec\n", phase, time_end - time_start);
+  return time_end;
+}
+
 /* only called once, for startup */
 void WM_init(bContext *C, int argc, const char **argv)
 {
+  const double time_init = (G.debug & G_DEBUG_STARTUP_TIMING) ? PIL_check_seconds_timer() : 0.0;
+  double time_phase = time_init;
 
   if (!G.background) {
     wm_ghost_init(C); /* note: it assigns C to ghost! */
@@ -260,6 +278,8 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   ED_node_init_butfuncs();
 
+  time_phase = wm_init_timing_report("types registration", time_phase);
+
   BLF_init();
 
   BLT_lang_init();
@@ -287,6 +307,8 @@ void WM_init(bContext *C, int argc, const char **argv)
    * otherwise the versioning cannot find the default studio-light. */
   BKE_studiolight_init();
 
+  time_phase = wm_init_timing_report("fonts, icons & languages", time_phase);
+
   BLI_assert((G.fileflags & G_FILE_NO_UI) == 0);
 
   wm_homefile_read(C,
@@ -299,6 +321,8 @@ void WM_init(bContext *C, int argc, const char **argv)
                    WM_init_state_app_template_get(),
                    &is_factory_startup);
 
+  time_phase = wm_init_timing_report("startup file & preferences", time_phase);
+
   /* Call again to set from userpreferences... */
   BLT_lang_set(NULL);
 
@@ -327,6 +351,8 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   ED_spacemacros_init();
 
+  time_phase = wm_init_timing_report("window system & UI", time_phase);
+
   /* note: there is a bug where python needs initializing before loading the
    * startup.blend because it may contain PyDrivers. It also needs to be after
    * initializing space types and other internal data.
@@ -343,6 +369,9 @@ void WM_init(bContext *C, int argc, const char **argv)
   (void)argv; /* unused */
 #endif
 
+  /* Includes registering the enabled add-ons. */
+  time_phase = wm_init_timing_report("python & add-ons", time_phase);
+
   if (!G.background && !wm_start_with_console) {
     GHOST_toggleConsole(3);
   }
@@ -393,6 +422,9 @@ void WM_init(bContext *C, int argc, const char **argv)
       CTX_wm_window_set(C, NULL);
     }
   }
+
+  wm_init_timing_report("load handlers", time_phase);
+  wm_init_timing_report("total", time_init);
 }
 
 void WM_init_splash(bContext *C)
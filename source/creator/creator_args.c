@@ -41,10 +41,12 @@
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
 #  include "BLI_threads.h"
+#  include "BLI_trace.h"
 #  include "BLI_utildefines.h"
 
 #  include "BLO_readfile.h" /* only for BLO_has_bfile_extension */
 
+#  include "BKE_blender.h"
 #  include "BKE_blender_version.h"
 #  include "BKE_context.h"
 
@@ -591,6 +593,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-gpu-shaders");
   BLI_args_print_arg_doc(ba, "--debug-gpu-force-workarounds");
   BLI_args_print_arg_doc(ba, "--debug-wm");
+  BLI_args_print_arg_doc(ba, "--debug-startup-timing");
 #  ifdef WITH_XR_OPENXR
   BLI_args_print_arg_doc(ba, "--debug-xr");
   BLI_args_print_arg_doc(ba, "--debug-xr-time");
@@ -600,6 +603,9 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
 
   printf("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
+#  ifdef WITH_TRACING
+  BLI_args_print_arg_doc(ba, "--debug-trace");
+#  endif
   BLI_args_print_arg_doc(ba, "--disable-crash-handler");
   BLI_args_print_arg_doc(ba, "--disable-abort-handler");
 
@@ -950,6 +956,9 @@ static const char arg_handle_debug_mode_generic_set_doc_xr_time[] =
     "\n\t"
     "Enable debug messages for virtual reality frame rendering times.";
 #  endif
+static const char arg_handle_debug_mode_generic_set_doc_startup_timing[] =
+    "\n\t"
+    "Print the time spent in each phase of the startup.";
 static const char arg_handle_debug_mode_generic_set_doc_jobs[] =
     "\n\t"
     "Enable time profiling for background jobs.";
@@ -1088,6 +1097,40 @@ static int arg_handle_debug_fpe_set(int UNUSED(argc),
   return 0;
 }
 
+#  ifdef WITH_TRACING
+static void arg_handle_debug_trace_write(void *user_data)
+{
+  char *filepath = user_data;
+  BLI_trace_stop();
+  if (BLI_trace_write_chrome(filepath)) {
+    printf("Trace written to: '%s'\n", filepath);
+  }
+  else {
+    printf("\nError: failed to write trace to '%s'.\n", filepath);
+  }
+  MEM_freeN(filepath);
+}
+
+static const char arg_handle_debug_trace_set_doc[] =
+    "<filename>\n"
+    "\tRecord zones and counters of hot code paths, written to a file on exit.\n"
+    "\tThe file can be opened in Perfetto or 'chrome://tracing'.";
+static int arg_handle_debug_trace_set(int argc, const char **argv, void *UNUSED(data))
+{
+  const char *arg_id = "--debug-trace";
+  if (argc > 1) {
+    if (!BLI_trace_is_enabled()) {
+      BLI_trace_thread_name_set("Main");
+      BLI_trace_start();
+      BKE_blender_atexit_register(arg_handle_debug_trace_write, BLI_strdup(argv[1]));
+    }
+    return 1;
+  }
+  printf("\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+#  endif
+
 static const char arg_handle_app_template_doc[] =
     "<template>\n"
     "\tSet the application template (matching the directory name), use 'default' for none.";
@@ -2079,6 +2122,11 @@ void main_args_setup(bContext *C, bArgs *ba)
                (void *)G_DEBUG_HANDLERS);
   BLI_args_add(
       ba, NULL, "--debug-wm", CB_EX(arg_handle_debug_mode_generic_set, wm), (void *)G_DEBUG_WM);
+  BLI_args_add(ba,
+               NULL,
+               "--debug-startup-timing",
+               CB_EX(arg_handle_debug_mode_generic_set, startup_timing),
+               (void *)G_DEBUG_STARTUP_TIMING);
 #  ifdef WITH_XR_OPENXR
   BLI_args_add(
       ba, NULL, "--debug-xr", CB_EX(arg_handle_debug_mode_generic_set, xr), (void *)G_DEBUG_XR);
@@ -2099,6 +2147,9 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-io", CB(arg_handle_debug_mode_io), NULL);
 
   BLI_args_add(ba, NULL, "--debug-fpe", CB(arg_handle_debug_fpe_set), NULL);
+#  ifdef WITH_TRACING
+  BLI_args_add(ba, NULL, "--debug-trace", CB(arg_handle_debug_trace_set), NULL);
+#  endif
 
 #  ifdef WITH_LIBMV
   BLI_args_add(ba, NULL, "--debug-libmv", CB(arg_handle_debug_mode_libmv), NULL);
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+# Apache License, Version 2.0
+
+"""
+Run the performance tests with a Blender build and write the results as JSON,
+or compare the results of two runs, e.g. of two commits.
+
+  ./benchmark.py run --blender ./blender.bin --output results.json
+  ./benchmark.py compare base.json results.json --threshold 10
+
+Every test is run in its own Blender process, so the peak memory and the
+startup timings reported for a test are not affected by the others.
+The tests themselves are defined in `blender_tests.py`.
+"""
+
+import argparse
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+BLENDER_TESTS_SCRIPT = os.path.join(os.path.dirname(os.path.realpath(__file__)), "blender_tests.py")
+
+# Printed by `--debug-startup-timing`.
+STARTUP_TIMING_RE = re.compile(r"^Startup: (.+?)\s+([0-9.]+) sec$")
+
+
+def blender_command(blender, *args):
+    return [
+        blender,
+        "--background",
+        "--factory-startup",
+        "-noaudio",
+        "--debug-startup-timing",
+        "--python-exit-code", "1",
+        "--python", BLENDER_TESTS_SCRIPT,
+        "--",
+        *args,
+    ]
+
+
+def list_tests(blender):
+    output = subprocess.check_output(blender_command(blender, "--list"), universal_newlines=True)
+    for line in output.splitlines():
+        if line.startswith("TEST "):
+            yield line[len("TEST "):].strip()
+
+
+def parse_startup_timing(output):
+    phases = {}
+    for line in output.splitlines():
+        match = STARTUP_TIMING_RE.match(line.strip())
+        if match:
+            phases[match.group(1)] = float(match.group(2))
+    return phases
+
+
+def run_test(blender, test, repeat, verbose):
+    with tempfile.TemporaryDirectory(prefix="blender_benchmark_") as temp_dir:
+        result_file = os.path.join(temp_dir, "result.json")
+        command = blender_command(blender, "--test", test,
+                                  "--repeat", str(repeat),
+                                  "--result", result_file,
+                                  "--temp-dir", temp_dir)
+
+        time_start = time.perf_counter()
+        process = subprocess.run(command,
+                                 stdout=subprocess.PIPE,
+                                 stderr=subprocess.STDOUT,
+                                 universal_newlines=True)
+        wall_time = time.perf_counter() - time_start
+
+        if verbose:
+            print(process.stdout)
+
+        result = {
+            "status": "failed",
+            "wall_time": wall_time,
+            "startup": parse_startup_timing(process.stdout),
+        }
+        if os.path.exists(result_file):
+            with open(result_file) as f:
+                result.update(json.load(f))
+        if process.returncode != 0 and result["status"] == "ok":
+            result["status"] = "failed"
+        if result["status"] == "failed" and "error" not in result:
+            # Keep the end of the output to see what went wrong.
+            result["error"] = "\n".join(process.stdout.splitlines()[-20:])
+        return result
+
+
+def command_run(args):
+    tests = list(list_tests(args.blender))
+    if args.tests:
+        pattern = re.compile(args.tests)
+        tests = [test for test in tests if pattern.search(test)]
+
+    results = {
+        "blender": os.path.abspath(args.blender),
+        "platform": platform.platform(),
+        "date": time.strftime("%Y-%m-%d %H:%M:%S"),
+        "tests": {},
+    }
+
+    for test in tests:
+        print("Running %s..." % test, end="", flush=True)
+        result = run_test(args.blender, test, args.repeat, args.verbose)
+        results["tests"][test] = result
+        if result["status"] == "ok":
+            print(" %.4f sec" % result["time"])
+        else:
+            print(" %s" % result["status"])
+            if "error" in result:
+                print(result["error"])
+        results.setdefault("version", result.get("version"))
+        results.setdefault("build_hash", result.get("build_hash"))
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    return 0 if all(result["status"] != "failed" for result in results["tests"].values()) else 1
+
+
+def format_change(base, value):
+    if not base or value is None:
+        return "      -"
+    return "%+6.1f%%" % ((value - base) * 100.0 / base)
+
+
+def command_compare(args):
+    with open(args.base) as f:
+        base = json.load(f)
+    with open(args.result) as f:
+        result = json.load(f)
+
+    print("%-32s %12s %12s %8s %8s" % ("Test", "Base", "Result", "Time", "Memory"))
+
+    regressions = []
+    for test, test_result in sorted(result["tests"].items()):
+        base_result = base["tests"].get(test)
+        base_status = base_result["status"] if base_result else "-"
+        if base_status != "ok" or test_result["status"] != "ok":
+            print("%-32s %12s %12s" % (test, base_status, test_result["status"]))
+            continue
+
+        base_time = base_result["time"]
+        test_time = test_result["time"]
+        print("%-32s %10.4fs %10.4fs %8s %8s" % (
+            test, base_time, test_time,
+            format_change(base_time, test_time),
+            format_change(base_result.get("peak_memory"), test_result.get("peak_memory"))))
+
+        for phase, phase_time in sorted(test_result.get("phases", {}).items()):
+            base_phase_time = base_result.get("phases", {}).get(phase)
+            if base_phase_time is not None:
+                print("  %-30s %10.4fs %10.4fs %8s" % (
+                    phase, base_phase_time, phase_time, format_change(base_phase_time, phase_time)))
+
+        if args.threshold is not None and base_time > 0.0:
+            if (test_time - base_time) * 100.0 / base_time > args.threshold:
+                regressions.append(test)
+
+    if regressions:
+        print("\nSlower than the threshold of %.1f%%: %s" % (args.threshold, ", ".join(regressions)))
+        return 1
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    subparsers = parser.add_subparsers(dest="command")
+    subparsers.required = True
+
+    parser_run = subparsers.add_parser("run", help="Run the tests")
+    parser_run.add_argument("--blender", required=True, help="Blender executable to test")
+    parser_run.add_argument("--output", help="JSON file to write the results to")
+    parser_run.add_argument("--tests", help="Regular expression of the test names to run")
+    parser_run.add_argument("--repeat", type=int, default=3,
+                            help="Number of times to repeat a test, the fastest time is reported")
+    parser_run.add_argument("--verbose", action="store_true", help="Print the output of Blender")
+    parser_run.set_defaults(function=command_run)
+
+    parser_compare = subparsers.add_parser("compare", help="Compare the results of two runs")
+    parser_compare.add_argument("base", help="JSON file of the reference results")
+    parser_compare.add_argument("result", help="JSON file of the results to compare")
+    parser_compare.add_argument("--threshold", type=float,
+                                help="Fail when a test is slower by more than this percentage")
+    parser_compare.set_defaults(function=command_compare)
+
+    args = parser.parse_args()
+    sys.exit(args.function(args))
+
+
+if __name__ == "__main__":
+    main()
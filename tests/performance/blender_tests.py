@@ -0,0 +1,304 @@
+# Apache License, Version 2.0
+
+"""
+Performance tests, run inside Blender by `benchmark.py`:
+
+  blender --background --factory-startup --python blender_tests.py -- --test modifier_stack
+
+The scenes are generated, so the tests don't depend on external files. Each test sets up its
+scene outside of the timed part and reports the time of the timed part along with the time of
+its phases, the fastest of the repetitions is kept.
+"""
+
+import argparse
+import json
+import os
+import sys
+import time
+
+import bpy
+
+TESTS = {}
+
+
+def performance_test(function):
+    TESTS[function.__name__] = function
+    return function
+
+
+class Timer:
+    """Accumulate the time of named phases."""
+
+    def __init__(self):
+        self.phases = {}
+
+    def phase(self, name):
+        timer = self
+
+        class PhaseContext:
+            def __enter__(self):
+                self.time_start = time.perf_counter()
+
+            def __exit__(self, *args):
+                elapsed = time.perf_counter() - self.time_start
+                timer.phases[name] = timer.phases.get(name, 0.0) + elapsed
+
+        return PhaseContext()
+
+
+def scene_reset():
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    return bpy.context.scene
+
+
+def add_grid_object(scene, name, subdivisions, location=(0.0, 0.0, 0.0)):
+    """Add a subdivided grid without using operators, which need a 3D view context."""
+    import bmesh
+    bm = bmesh.new()
+    bmesh.ops.create_grid(bm, x_segments=subdivisions, y_segments=subdivisions, size=1.0)
+    mesh = bpy.data.meshes.new(name)
+    bm.to_mesh(mesh)
+    bm.free()
+    ob = bpy.data.objects.new(name, mesh)
+    ob.location = location
+    scene.collection.objects.link(ob)
+    return ob
+
+
+def add_object_grid(scene, count, subdivisions):
+    side = max(int(count ** 0.5), 1)
+    return [add_grid_object(scene, "Grid.%d" % i, subdivisions,
+                            location=((i % side) * 2.5, (i // side) * 2.5, 0.0))
+            for i in range(count)]
+
+
+def scene_update():
+    bpy.context.view_layer.update()
+
+
+def render(scene, engine, resolution):
+    scene.render.engine = engine
+    scene.render.resolution_x = resolution
+    scene.render.resolution_y = resolution
+    scene.render.resolution_percentage = 100
+    scene.render.filepath = ""
+    bpy.ops.render.render(write_still=False)
+
+
+def add_camera(scene, location=(0.0, 0.0, 30.0)):
+    camera = bpy.data.objects.new("Camera", bpy.data.cameras.new("Camera"))
+    camera.location = location
+    scene.collection.objects.link(camera)
+    scene.camera = camera
+    return camera
+
+
+@performance_test
+def file_load_save(timer, temp_dir):
+    scene = scene_reset()
+    add_object_grid(scene, 400, 64)
+    filepath = os.path.join(temp_dir, "file_load_save.blend")
+
+    with timer.phase("save"):
+        bpy.ops.wm.save_as_mainfile(filepath=filepath, check_existing=False, compress=False)
+    with timer.phase("load"):
+        bpy.ops.wm.open_mainfile(filepath=filepath, load_ui=False)
+    with timer.phase("save_compressed"):
+        bpy.ops.wm.save_as_mainfile(filepath=filepath, check_existing=False, compress=True)
+    with timer.phase("load_compressed"):
+        bpy.ops.wm.open_mainfile(filepath=filepath, load_ui=False)
+
+
+@performance_test
+def depsgraph_evaluation(timer, temp_dir):
+    scene = scene_reset()
+    empties = []
+    for i in range(2000):
+        ob = bpy.data.objects.new("Empty.%d" % i, None)
+        scene.collection.objects.link(ob)
+        if empties:
+            ob.parent = empties[i // 2]
+        for frame in (1, 50):
+            ob.location = (i * 0.01, frame * 0.1, 0.0)
+            ob.keyframe_insert("location", frame=frame)
+        empties.append(ob)
+
+    with timer.phase("build"):
+        scene_update()
+    with timer.phase("animation"):
+        for frame in range(1, 51):
+            scene.frame_set(frame)
+
+
+@performance_test
+def modifier_stack(timer, temp_dir):
+    scene = scene_reset()
+    ob = add_grid_object(scene, "Grid", 256)
+    subsurf = ob.modifiers.new("Subdivision", 'SUBSURF')
+    subsurf.levels = 2
+    displace = ob.modifiers.new("Displace", 'DISPLACE')
+    displace.texture = bpy.data.textures.new("Clouds", 'CLOUDS')
+    ob.modifiers.new("Solidify", 'SOLIDIFY')
+    array = ob.modifiers.new("Array", 'ARRAY')
+    array.count = 4
+
+    with timer.phase("first_evaluation"):
+        scene_update()
+    with timer.phase("reevaluation"):
+        for i in range(10):
+            displace.strength = 1.0 + i * 0.1
+            scene_update()
+
+
+@performance_test
+def geometry_nodes(timer, temp_dir):
+    scene = scene_reset()
+    ob = add_grid_object(scene, "Grid", 64)
+
+    group = bpy.data.node_groups.new("Benchmark", 'GeometryNodeTree')
+    group.inputs.new('NodeSocketGeometry', "Geometry")
+    group.outputs.new('NodeSocketGeometry', "Geometry")
+    nodes = group.nodes
+    links = group.links
+    group_input = nodes.new('NodeGroupInput')
+    group_output = nodes.new('NodeGroupOutput')
+    subdivision = nodes.new('GeometryNodeSubdivisionSurface')
+    subdivision.inputs["Level"].default_value = 3
+    distribute = nodes.new('GeometryNodePointDistribute')
+    distribute.inputs["Density Max"].default_value = 20000.0
+    join = nodes.new('GeometryNodeJoinGeometry')
+    links.new(group_input.outputs[0], subdivision.inputs["Geometry"])
+    links.new(subdivision.outputs[0], distribute.inputs["Geometry"])
+    links.new(subdivision.outputs[0], join.inputs[0])
+    links.new(distribute.outputs[0], join.inputs[1])
+    links.new(join.outputs[0], group_output.inputs[0])
+
+    modifier = ob.modifiers.new("Nodes", 'NODES')
+    modifier.node_group = group
+
+    with timer.phase("first_evaluation"):
+        scene_update()
+    with timer.phase("reevaluation"):
+        for i in range(10):
+            distribute.inputs["Seed"].default_value = i + 1
+            scene_update()
+
+
+@performance_test
+def draw_cache_extraction(timer, temp_dir):
+    # Workbench renders of dense meshes are dominated by extracting the GPU batches.
+    # Needs a GPU, fails when Blender has no GPU context in background mode.
+    scene = scene_reset()
+    add_camera(scene)
+    for ob in add_object_grid(scene, 16, 256):
+        ob.modifiers.new("Subdivision", 'SUBSURF').levels = 1
+
+    with timer.phase("evaluation"):
+        scene_update()
+    with timer.phase("render"):
+        render(scene, 'BLENDER_WORKBENCH', 64)
+
+
+@performance_test
+def cycles_sync_bvh(timer, temp_dir):
+    # A single sample at a low resolution, so the time is mostly spent syncing and building BVH.
+    scene = scene_reset()
+    add_camera(scene)
+    add_object_grid(scene, 200, 128)
+    scene.cycles.samples = 1
+    scene.cycles.device = 'CPU'
+
+    with timer.phase("evaluation"):
+        scene_update()
+    with timer.phase("render"):
+        render(scene, 'CYCLES', 32)
+
+
+@performance_test
+def compositor(timer, temp_dir):
+    # No render layer node, so only the compositor is executed when rendering.
+    scene = scene_reset()
+    image = bpy.data.images.new("Input", 2048, 2048, float_buffer=True)
+    image.generated_type = 'COLOR_GRID'
+
+    scene.use_nodes = True
+    tree = scene.node_tree
+    tree.nodes.clear()
+    image_node = tree.nodes.new('CompositorNodeImage')
+    image_node.image = image
+    blur = tree.nodes.new('CompositorNodeBlur')
+    blur.size_x = 20
+    blur.size_y = 20
+    glare = tree.nodes.new('CompositorNodeGlare')
+    composite = tree.nodes.new('CompositorNodeComposite')
+    tree.links.new(image_node.outputs["Image"], blur.inputs["Image"])
+    tree.links.new(blur.outputs["Image"], glare.inputs["Image"])
+    tree.links.new(glare.outputs["Image"], composite.inputs["Image"])
+
+    with timer.phase("render"):
+        render(scene, 'BLENDER_EEVEE', 2048)
+
+
+def peak_memory():
+    """Peak resident memory of this process in bytes, when available."""
+    try:
+        import resource
+    except ImportError:
+        return None
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Kilobytes on Linux, bytes on macOS.
+    return peak if sys.platform == "darwin" else peak * 1024
+
+
+def run_test(name, repeat, temp_dir):
+    best = None
+    for _ in range(repeat):
+        timer = Timer()
+        TESTS[name](timer, temp_dir)
+        total = sum(timer.phases.values())
+        if best is None or total < best["time"]:
+            best = {"time": total, "phases": timer.phases}
+    return best
+
+
+def main():
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--list", action="store_true", help="List the names of the tests")
+    parser.add_argument("--test", help="Name of the test to run")
+    parser.add_argument("--repeat", type=int, default=1)
+    parser.add_argument("--result", help="JSON file to write the result to")
+    parser.add_argument("--temp-dir", default=bpy.app.tempdir)
+    args = parser.parse_args(argv)
+
+    if args.list:
+        for name in TESTS:
+            print("TEST", name)
+        return
+
+    result = {
+        "version": bpy.app.version_string,
+        "build_hash": bpy.app.build_hash.decode("ascii", "replace"),
+    }
+    try:
+        result.update(run_test(args.test, max(args.repeat, 1), args.temp_dir))
+        result["status"] = "ok"
+    except Exception as ex:
+        import traceback
+        traceback.print_exc()
+        result["status"] = "failed"
+        result["error"] = str(ex)
+    result["peak_memory"] = peak_memory()
+
+    if args.result:
+        with open(args.result, "w") as f:
+            json.dump(result, f, indent=2)
+    else:
+        print(json.dumps(result, indent=2))
+
+    if result["status"] != "ok":
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()